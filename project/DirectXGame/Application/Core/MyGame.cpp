@@ -7,6 +7,7 @@
 // 管理系
 #include "ImGuiManager.h"
 #include "LightManager.h"
+#include "ModelManager.h"
 #include "ParticleManager.h"
 #include "PipelineManager.h"
 #include "PostProcessManager.h"
@@ -65,6 +66,9 @@ void MyGame::Update() {
   // ライト更新
   LightManager::GetInstance()->Update();
 
+  // 非同期読み込みが終わったモデルのGPUリソース生成
+  ModelManager::GetInstance()->Update();
+
 #ifdef USE_IMGUI
   // ポストエフェクトモード選択 ImGui
   ImGui::SetNextWindowPos(ImVec2(10.0f, 210.0f), ImGuiCond_Once);
@@ -218,6 +222,9 @@ void MyGame::Draw() {
   DX12Context::GetInstance()->PreDraw();
   SrvManager::GetInstance()->PreDraw();
 
+  // 非同期読み込みテクスチャの差し替えと転送（描画コマンドより前に積む）
+  TextureManager::GetInstance()->Update();
+
   // --- オフスクリーンレンダリングパス ---
   SceneManager::GetInstance()->DrawOffscreen();
   renderTexture_->PreDraw(commandList);
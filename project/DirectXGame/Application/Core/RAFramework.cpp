@@ -113,8 +113,7 @@ void RAFramework::Initialize() {
 
   // リソース系マネージャのためにコマンドリストを開く
   // (Texture, Model, ParticleなどはGPUにデータを送るためリストが必要)
-  DX12Context::GetInstance()->GetCommandList()->Reset(
-      DX12Context::GetInstance()->GetCommandAllocator(), nullptr);
+  DX12Context::GetInstance()->ResetCommandList();
 
   /// マネージャー類の初期化（シングルトン）
   LightManager::GetInstance()->Initialize();
@@ -52,9 +52,12 @@ void GamePlayScene::Initialize() {
 	TextureManager::GetInstance()->LoadTexture(particleCircle2Path_);
 	TextureManager::GetInstance()->LoadTexture(particleGradationLinePath_);
 
-	// モデル読み込み
-	ModelManager::GetInstance()->LoadModel("sphere", sphereModel_);
-	ModelManager::GetInstance()->LoadModel("plane", planeGltfModel_);
+	// モデル読み込み (ワーカースレッドで並列に読み込み、GPUリソースはまとめて生成する)
+	ModelManager::GetInstance()->LoadModelsAsync({
+		{ "sphere", sphereModel_ },
+		{ "plane", planeGltfModel_ },
+	});
+	ModelManager::GetInstance()->WaitForPendingLoads();
 
 	// パーティクル設定
 	ParticleManager::GetInstance()->CreateParticleGroup(particleGroupName_, particleGradationLinePath_);
@@ -123,6 +126,13 @@ void GamePlayScene::Initialize() {
 	// 環境マップとしてセット
 	Object3dCommon::GetInstance()->SetEnvironmentMap(TextureManager::GetInstance()->GetSrvIndex("skybox.dds"));
 
+	// 地形の設定 (モデルの形状をハイトフィールドにして、チャンクの四分木で描く)
+	terrain_ = std::make_unique<Terrain>();
+	TerrainQuadtree::Settings terrainSettings;
+	terrainSettings.chunkCells = 16;
+	terrain_->Initialize("terrain", terrainModel_, grassPath_, kTerrainResolution, terrainSettings);
+	terrain_->SetCamera(camera_.get());
+
 	// --- 3Dオブジェクト生成 ---
 	// マテリアル
 
@@ -218,6 +228,11 @@ void GamePlayScene::Update() {
 		skybox_->Update();
 	}
 
+	// 地形の更新 (描くチャンクの選択)
+	if (terrain_) {
+		terrain_->Update();
+	}
+
 	// パーティクルの更新
 	// 状態を反映
 	ParticleManager::GetInstance()->SetIsUpdate(isUpdateParticle_);
@@ -299,6 +314,11 @@ void GamePlayScene::Draw() {
 		}
 	}
 
+	// 地形の描画 (Object3d と同じ描画設定を使う)
+	if (terrain_ && isShowTerrain_) {
+		terrain_->Draw();
+	}
+
 	// Skyboxの描画(object3dの描画が終わった後に描画するのが基本)
 	if (skybox_ && isShowSkybox_) {
 		skybox_->Draw();
@@ -409,6 +429,7 @@ void GamePlayScene::UpdateImGui() {
 		UpdateImGui_Sprite();
 		UpdateImGui_Sound();
 		UpdateImGui_Skybox();
+		UpdateImGui_Terrain();
 	}
 		ImGui::End(); // "Settings" ウィンドウの終了
 
@@ -586,6 +607,44 @@ void GamePlayScene::UpdateImGui_Particle() {
 			if (minVal->y > maxVal->y) minVal->y = maxVal->y;
 			if (minVal->z > maxVal->z) minVal->z = maxVal->z;
 			};
+		// 寿命カーブの編集 (変更があれば LUT に焼き込み直す)
+		auto EditCurve = [](const char* label, ParticleCurve& curve, float minValue, float maxValue) {
+			if (!ImGui::TreeNode(label)) { return; }
+			bool isChanged = ImGui::Checkbox("Active", &curve.isActive);
+			for (size_t i = 0; i < curve.keys.size(); ++i) {
+				ImGui::PushID(static_cast<int>(i));
+				isChanged |= ImGui::DragFloat("Time", &curve.keys[i].time, 0.01f, 0.0f, 1.0f);
+				ImGui::SameLine();
+				isChanged |= ImGui::DragFloat("Value", &curve.keys[i].value, 0.01f, minValue, maxValue);
+				ImGui::SameLine();
+				bool isRemoved = curve.keys.size() > 1 && ImGui::Button("x");
+				ImGui::PopID();
+				if (isRemoved) { curve.keys.erase(curve.keys.begin() + i); isChanged = true; break; }
+			}
+			if (ImGui::Button("Add Key")) { curve.keys.push_back({ 1.0f, curve.keys.empty() ? 1.0f : curve.keys.back().value }); isChanged = true; }
+			if (isChanged) { curve.Bake(); }
+			float preview[kParticleCurveLutSize + 1];
+			for (uint32_t i = 0; i <= kParticleCurveLutSize; ++i) { preview[i] = curve.Sample(static_cast<float>(i) / kParticleCurveLutSize); }
+			ImGui::PlotLines("Preview", preview, kParticleCurveLutSize + 1, 0, nullptr, minValue, maxValue, ImVec2(0.0f, 60.0f));
+			ImGui::TreePop();
+			};
+		auto EditGradient = [](const char* label, ParticleGradient& gradient) {
+			if (!ImGui::TreeNode(label)) { return; }
+			bool isChanged = ImGui::Checkbox("Active", &gradient.isActive);
+			for (size_t i = 0; i < gradient.keys.size(); ++i) {
+				ImGui::PushID(static_cast<int>(i));
+				isChanged |= ImGui::DragFloat("Time", &gradient.keys[i].time, 0.01f, 0.0f, 1.0f);
+				ImGui::SameLine();
+				isChanged |= ImGui::ColorEdit4("Color", &gradient.keys[i].color.x, ImGuiColorEditFlags_NoInputs);
+				ImGui::SameLine();
+				bool isRemoved = gradient.keys.size() > 1 && ImGui::Button("x");
+				ImGui::PopID();
+				if (isRemoved) { gradient.keys.erase(gradient.keys.begin() + i); isChanged = true; break; }
+			}
+			if (ImGui::Button("Add Key")) { gradient.keys.push_back({ 1.0f, gradient.keys.empty() ? Vector4{ 1.0f, 1.0f, 1.0f, 1.0f } : gradient.keys.back().color }); isChanged = true; }
+			if (isChanged) { gradient.Bake(); }
+			ImGui::TreePop();
+			};
 
 		// 登録されている全パーティクルグループを取得して個別に設定
 		std::vector<std::string> groupNames = ParticleManager::GetInstance()->GetParticleGroupNames();
@@ -648,6 +707,10 @@ void GamePlayScene::UpdateImGui_Particle() {
 						ImGui::Checkbox("Random Color", &gs.isRandomColor);
 						if (gs.isRandomColor) { ImGui::ColorEdit4("Color Min", &gs.colorMin.x); ImGui::ColorEdit4("Color Max", &gs.colorMax.x); }
 						else { ImGui::ColorEdit4("Fixed Color", &gs.fixedColor.x); }
+						// Over Lifetime
+						EditGradient("Color Over Life", gs.colorOverLife);
+						EditCurve("Size Over Life", gs.sizeOverLife, 0.0f, 5.0f);
+						EditCurve("Velocity Damping Over Life", gs.dampingOverLife, 0.0f, 20.0f);
 						ImGui::TreePop();
 					}
 
@@ -684,12 +747,52 @@ void GamePlayScene::UpdateImGui_Particle() {
 						ImGui::TreePop();
 					}
 
+					// Sub Emitters
+					if (ImGui::TreeNode("Sub Emitters")) {
+						auto& subEmitters = emitter->subEmitters;
+						for (size_t i = 0; i < subEmitters.size(); ++i) {
+							ImGui::PushID(static_cast<int>(i));
+							SubEmitterSettings& sub = subEmitters[i];
+
+							// 発生させるグループ
+							int targetIndex = -1;
+							for (int n = 0; n < static_cast<int>(groupNames.size()); ++n) {
+								if (groupNames[n] == sub.groupName) { targetIndex = n; break; }
+							}
+							const char* preview = targetIndex >= 0 ? groupNames[targetIndex].c_str() : "(None)";
+							if (ImGui::BeginCombo("Target Group", preview)) {
+								for (int n = 0; n < static_cast<int>(groupNames.size()); ++n) {
+									if (ImGui::Selectable(groupNames[n].c_str(), n == targetIndex)) { sub.groupName = groupNames[n]; }
+								}
+								ImGui::EndCombo();
+							}
+
+							int trigger = static_cast<int>(sub.trigger);
+							if (ImGui::Combo("Trigger", &trigger, "Birth\0Death\0")) { sub.trigger = static_cast<SubEmitterTrigger>(trigger); }
+
+							int subCount = static_cast<int>(sub.count);
+							if (ImGui::DragInt("Count", &subCount, 1, 1, 100)) { sub.count = static_cast<uint32_t>(subCount); }
+
+							bool isRemoved = ImGui::Button("Remove");
+							ImGui::Separator();
+							ImGui::PopID();
+							if (isRemoved) {
+								subEmitters.erase(subEmitters.begin() + i);
+								break;
+							}
+						}
+						if (ImGui::Button("Add Sub Emitter")) {
+							subEmitters.push_back({});
+						}
+						ImGui::TreePop();
+					}
+
 					// ============================================================
 					// 形状切り替えコンボボックス
 					// ============================================================
-					const char* shapeItems[] = { "Billboard", "Ring", "Cylinder", "Plane" };
+					const char* shapeItems[] = { "Billboard", "Ring", "Cylinder", "Plane", "Trail" };
 					int shapeIndex = static_cast<int>(emitter->GetShapeType());
-					if (ImGui::Combo("Shape Type", &shapeIndex, shapeItems, 4)) {
+					if (ImGui::Combo("Shape Type", &shapeIndex, shapeItems, 5)) {
 						emitter->SetShapeType(static_cast<ParticleShapeType>(shapeIndex));
 					}
 
@@ -809,6 +912,25 @@ void GamePlayScene::UpdateImGui_Particle() {
 						}
 					}
 
+					// --- Trail Shape Settings ---
+					if (auto* ts = emitter->GetTrailShape()) {
+						if (ImGui::TreeNode("Trail Shape Settings")) {
+							int maxPoints = static_cast<int>(ts->settings.maxPoints);
+							if (ImGui::DragInt("Max Points", &maxPoints, 1, 2, static_cast<int>(kMaxTrailPoints))) {
+								ts->settings.maxPoints = static_cast<uint32_t>(maxPoints);
+							}
+							ImGui::DragFloat("Min Vertex Distance", &ts->settings.minVertexDistance, 0.01f, 0.0f, 10.0f);
+							ImGui::DragFloat("Head Width", &ts->settings.headWidth, 0.01f, 0.0f, 10.0f);
+							ImGui::DragFloat("Tail Width", &ts->settings.tailWidth, 0.01f, 0.0f, 10.0f);
+
+							ImGui::Separator();
+							ImGui::ColorEdit4("Head Color", &ts->settings.headColor.x);
+							ImGui::ColorEdit4("Tail Color", &ts->settings.tailColor.x);
+
+							ImGui::TreePop();
+						}
+					}
+
 					// ボタン類
 					std::string emitLabel = "Emit " + groupName;
 					if (ImGui::Button(emitLabel.c_str())) {
@@ -926,6 +1048,25 @@ void GamePlayScene::UpdateImGui_Skybox() {
 	}
 }
 
+void GamePlayScene::UpdateImGui_Terrain() {
+	// --- Terrain ---
+	ImGui::Separator();
+	if (ImGui::TreeNode("Terrain")) {
+		ImGui::Checkbox("showTerrain", &isShowTerrain_);
+		if (terrain_) {
+			ImGui::DragFloat("maxPixelError", &terrain_->GetMaxPixelError(), 0.1f, 0.1f, 64.0f);
+			const TerrainQuadtree::SelectionStats& stats = terrain_->GetSelectionStats();
+			ImGui::Text("chunks: %u / %u (culled %u)", stats.selectedNodes,
+				static_cast<uint32_t>(terrain_->GetQuadtree().GetNodes().size()), stats.culledNodes);
+			ImGui::Text("triangles: %u", stats.triangles);
+			// カメラ直下の地面の高さ
+			const Vector3& cameraTranslate = camera_->GetTranslate();
+			ImGui::Text("ground under camera: %.3f", terrain_->GetHeight(cameraTranslate.x, cameraTranslate.z));
+		}
+		ImGui::TreePop();
+	}
+}
+
 void GamePlayScene::UpdateImGui_HelpWindow() {
 	ImGui::SetNextWindowPos(ImVec2(10.0f, 10.0f), ImGuiCond_Once);
 	ImGui::SetNextWindowSize(ImVec2(370.0f, 190.0f), ImGuiCond_Once);
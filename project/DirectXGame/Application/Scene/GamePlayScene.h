@@ -10,6 +10,7 @@
 #include "Object3d.h"
 #include "Sprite.h"
 #include "Skybox.h"
+#include "Terrain.h"
 #include "BlendMode.h"
 #include "LevelLoader.h"
 
@@ -26,6 +27,7 @@ private:
     static inline const float kRotateSpeed = 0.02f;
     static inline const Vector3 kDefaultCameraRotate = { 0.3f, 0.0f, 0.0f };
     static inline const Vector3 kDefaultCameraTranslate = { 0.0f, 4.0f, -10.0f };
+    static inline const uint32_t kTerrainResolution = 128; // 地形のハイトフィールド1辺のセル数
 
     // ゲームカメラの更新
     void UpdateGameCamera();
@@ -48,6 +50,7 @@ private:
     void UpdateImGui_Sprite();
     void UpdateImGui_Sound();
 	void UpdateImGui_Skybox();
+	void UpdateImGui_Terrain();
     void UpdateImGui_HelpWindow();
 #endif // USE_IMGUI
 
@@ -62,6 +65,7 @@ private:
 
     // ゲームオブジェクト
 	std::unique_ptr<Skybox> skybox_;
+	std::unique_ptr<Terrain> terrain_;
     std::vector < std::unique_ptr<Object3d>> object3ds_;
     std::vector<std::unique_ptr<Sprite>> sprites_;
 
@@ -71,6 +75,7 @@ private:
     // 設定
 	bool isShowParticle_ = true;    // パーティクルの表示フラグ
 	bool isShowSkybox_ = true;      // スカイボックスの表示フラグ
+	bool isShowTerrain_ = true;     // 地形の表示フラグ
 	bool isShowMaterial_ = true;    // マテリアルを持つオブジェクトの表示フラグ
 	bool isShowSprite_ = false;     // スプライトの表示フラグ
 	bool isUpdateParticle_ = false; // パーティクルの更新フラグ
@@ -2,6 +2,7 @@
 #include "BlendMode.h"
 #include "DX12Context.h"
 #include "Input.h"
+#include "Logger.h"
 #include "MathUtils.h"
 #include "Model.h"
 #include "ModelManager.h"
@@ -11,7 +12,9 @@
 #include "SpriteCommon.h"
 #include "TextureManager.h"
 #include "Win32Window.h"
+#include <chrono>
 #include <cmath>
+#include <format>
 #include <numbers>
 
 using namespace MathUtils;
@@ -86,9 +89,13 @@ void ShootingScene::Initialize() {
   TextureManager::GetInstance()->LoadTexture(crosshairPath_);
   TextureManager::GetInstance()->LoadTexture("Particles/circle.png");
 
-  // モデル読み込み
-  ModelManager::GetInstance()->LoadModel("enemy", enemyModel_);
-  ModelManager::GetInstance()->LoadModel("bullet", "bullet.obj");
+  // モデル読み込み (ワーカースレッドで並列に読み込み、GPUリソースはまとめて生成する)
+  // 敵と弾は数が多いので圧縮頂点にする (誤差が大きい場合は自動で非圧縮に戻る)
+  ModelManager::GetInstance()->LoadModelsAsync({
+      {"enemy", enemyModel_, kVertexFormatCompactHalf},
+      {"bullet", "bullet.obj", kVertexFormatCompactHalf},
+  });
+  ModelManager::GetInstance()->WaitForPendingLoads();
 
   // 環境マップを敵モデルに適用
   Model *enemyModel = ModelManager::GetInstance()->FindModel(enemyModel_);
@@ -152,6 +159,8 @@ void ShootingScene::Initialize() {
       rs->settings.fadeEndAlpha = 1.000f;
       rs->settings.fadeRange = 0.000f;
   }
+  // リングが消えた位置から火花を散らす (サブエミッター)
+  ringEmitter.subEmitters.push_back({ "SparkGroup", SubEmitterTrigger::Death, 1 });
   ParticleManager::GetInstance()->SetEmitter(ringParticleGroupName_, ringEmitter);
 
   // 追加エフェクトグループの生成・初期化
@@ -335,32 +344,7 @@ void ShootingScene::Initialize() {
       TextureManager::GetInstance()->GetSrvIndex("skybox.dds"));
 
   // レベルデータから敵キャラを生成・配置
-  enemies_.clear();
-  if (levelData_) {
-    for (const auto &enemyData : levelData_->enemies) {
-      EnemyInfo enemy;
-      enemy.object = std::make_unique<Object3d>();
-      enemy.object->Initialize();
-
-      // 個別のモデルインスタンスを生成・ロード
-      enemy.model = std::make_unique<Model>();
-      enemy.model->Initialize("Resources/Assets/Models/enemy", enemyModel_);
-      // 初期状態として完全に消去された状態（Threshold = 1.0f）を設定
-      enemy.model->SetDissolveMaskTexture("masks/noise0.png");
-      enemy.model->SetDissolveParams(1, 1.0f, 0.05f, Vector3(1.0f, 0.4f, 0.3f));
-
-      enemy.object->SetModel(enemy.model.get());
-      enemy.object->SetTranslate(enemyData.translation);
-      enemy.object->SetRotation(enemyData.rotation);
-      enemy.object->SetCamera(camera_.get());
-      enemy.distance = enemyData.distance;
-      enemy.isActive = false;
-      enemy.isDead = false;
-      enemy.shootTimer = 0.0f;
-      enemy.spawnTimer = 0.0f;
-      enemies_.push_back(std::move(enemy));
-    }
-  }
+  CreateEnemies();
 
   // --- スプライト生成 ---
   crosshair_ = std::make_unique<Sprite>();
@@ -500,36 +484,10 @@ void ShootingScene::Update() {
       damageEffectStrength_ = 0.0f;
       projectileSpawnTimer_ = 0.0f;
       projectiles_.clear();
-      enemies_.clear();
       ammo_ = kMaxAmmo;
       isCovering_ = false;
       reloadTimer_ = 0.0f;
-      if (levelData_) {
-        for (const auto &enemyData : levelData_->enemies) {
-          EnemyInfo enemy;
-          enemy.object = std::make_unique<Object3d>();
-          enemy.object->Initialize();
-
-          // 個別のモデルインスタンスを生成・ロード
-          enemy.model = std::make_unique<Model>();
-          enemy.model->Initialize("Resources/Assets/Models/enemy", enemyModel_);
-          // 初期状態として完全に消去された状態（Threshold = 1.0f）を設定
-          enemy.model->SetDissolveMaskTexture("masks/noise0.png");
-          enemy.model->SetDissolveParams(1, 1.0f, 0.05f,
-                                         Vector3(1.0f, 0.4f, 0.3f));
-
-          enemy.object->SetModel(enemy.model.get());
-          enemy.object->SetTranslate(enemyData.translation);
-          enemy.object->SetRotation(enemyData.rotation);
-          enemy.object->SetCamera(camera_.get());
-          enemy.distance = enemyData.distance;
-          enemy.isActive = false;
-          enemy.isDead = false;
-          enemy.shootTimer = 0.0f;
-          enemy.spawnTimer = 0.0f;
-          enemies_.push_back(std::move(enemy));
-        }
-      }
+      CreateEnemies();
 
       // カメラを初期位置に戻す
       cameraProgress_ = 0.0f;
@@ -607,9 +565,6 @@ void ShootingScene::Update() {
         Vector3 forward = { sinY, 0.0f, cosY };
         Vector3 spawnPos = Add(camPos, Multiply(1.5f, forward));
         
-        if (auto* emitter = ParticleManager::GetInstance()->GetEmitter("ReloadCompleteGroup")) {
-          emitter->isPlaying = true;
-        }
         ParticleManager::GetInstance()->Emit("ReloadCompleteGroup", spawnPos, 8);
       }
     }
@@ -692,8 +647,8 @@ void ShootingScene::Update() {
 
       // 出現完了ならDissolveを無効化
       int enableDissolve = (threshold > 0.0f) ? 1 : 0;
-      enemy.model->SetDissolveParams(enableDissolve, threshold, 0.05f,
-                                     Vector3(1.0f, 0.4f, 0.3f));
+      enemy.object->SetDissolveParams(enableDissolve, threshold, 0.05f,
+                                      Vector3(1.0f, 0.4f, 0.3f));
     }
 
     // 出現完了するまでは射撃を行わない
@@ -798,9 +753,6 @@ void ShootingScene::Update() {
     Vector3 up = { 0.0f, 1.0f, 0.0f };
     Vector3 spawnPos = Add(camPos, Add(Multiply(1.5f, forward), Add(Multiply(-0.4f, right), Multiply(-0.3f, up))));
     
-    if (auto* emitter = ParticleManager::GetInstance()->GetEmitter("AmmoSparkGroup")) {
-      emitter->isPlaying = true;
-    }
     ParticleManager::GetInstance()->Emit("AmmoSparkGroup", spawnPos, 1);
 
     float x = (float)mousePos.x / Win32Window::kClientWidth * 2.0f - 1.0f;
@@ -842,9 +794,6 @@ void ShootingScene::Update() {
           }
 
           // 敵撃破時にパーティクルを放出
-          if (auto* emitter = ParticleManager::GetInstance()->GetEmitter(effectName)) {
-            emitter->isPlaying = true;
-          }
           ParticleManager::GetInstance()->Emit(effectName, enemyPos, 32);
           break; // 1回で1体倒す
         }
@@ -1053,32 +1002,7 @@ void ShootingScene::UpdateImGui_GlobalSettings() {
       damageEffectStrength_ = 0.0f;
       projectileSpawnTimer_ = 0.0f;
       projectiles_.clear();
-      enemies_.clear();
-      if (levelData_) {
-        for (const auto &enemyData : levelData_->enemies) {
-          EnemyInfo enemy;
-          enemy.object = std::make_unique<Object3d>();
-          enemy.object->Initialize();
-          
-          // 個別のモデルインスタンスを生成・ロード
-          enemy.model = std::make_unique<Model>();
-          enemy.model->Initialize("Resources/Assets/Models/enemy", enemyModel_);
-          // 初期状態として完全に消去された状態（Threshold = 1.0f）を設定
-          enemy.model->SetDissolveMaskTexture("masks/noise0.png");
-          enemy.model->SetDissolveParams(1, 1.0f, 0.05f, Vector3(1.0f, 0.4f, 0.3f));
-          
-          enemy.object->SetModel(enemy.model.get());
-          enemy.object->SetTranslate(enemyData.translation);
-          enemy.object->SetRotation(enemyData.rotation);
-          enemy.object->SetCamera(camera_.get());
-          enemy.distance = enemyData.distance;
-          enemy.isActive = false;
-          enemy.isDead = false;
-          enemy.shootTimer = 0.0f;
-          enemy.spawnTimer = 0.0f;
-          enemies_.push_back(std::move(enemy));
-        }
-      }
+      CreateEnemies();
       // カメラを初期位置に戻す
       cameraProgress_ = 0.0f;
       isMovementPaused_ = false;
@@ -1255,6 +1179,40 @@ void ShootingScene::Draw() {
   }
 }
 
+void ShootingScene::CreateEnemies() {
+  auto start = std::chrono::steady_clock::now();
+
+  enemies_.clear();
+  if (levelData_) {
+    for (const auto &enemyData : levelData_->enemies) {
+      EnemyInfo enemy;
+      enemy.object = std::make_unique<Object3d>();
+      enemy.object->Initialize();
+
+      // 共有モデルを使い、Dissolveはオブジェクトごとのマテリアルに持たせる
+      enemy.object->SetModel(enemyModel_);
+      // 初期状態として完全に消去された状態（Threshold = 1.0f）を設定
+      enemy.object->SetDissolveMaskTexture("masks/noise0.png");
+      enemy.object->SetDissolveParams(1, 1.0f, 0.05f, Vector3(1.0f, 0.4f, 0.3f));
+
+      enemy.object->SetTranslate(enemyData.translation);
+      enemy.object->SetRotation(enemyData.rotation);
+      enemy.object->SetCamera(camera_.get());
+      enemy.distance = enemyData.distance;
+      enemy.isActive = false;
+      enemy.isDead = false;
+      enemy.shootTimer = 0.0f;
+      enemy.spawnTimer = 0.0f;
+      enemies_.push_back(std::move(enemy));
+    }
+  }
+
+  Logger::Log(std::format(
+      "INFO: Created {} enemies ({:.2f} ms)\n", enemies_.size(),
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+          .count()));
+}
+
 void ShootingScene::Finalize() {
   Object3dCommon::GetInstance()->SetDefaultCamera(nullptr);
   enemies_.clear();
@@ -37,6 +37,9 @@ private:
   // シーン描画のヘルパー
   void DrawScene(Camera *camera);
 
+  // レベルデータから敵を生成する (モデルは ModelManager の1つを共有する)
+  void CreateEnemies();
+
 #ifdef USE_IMGUI
   // ImGui操作の更新
   void UpdateImGui();
@@ -60,8 +63,7 @@ private:
   std::unique_ptr<Skybox> skybox_;
 
   struct EnemyInfo {
-    std::unique_ptr<Object3d> object;
-    std::unique_ptr<Model> model; // 個別モデル
+    std::unique_ptr<Object3d> object; // モデルは共有し、Dissolveはオブジェクトごとに持つ
     Vector3 basePosition;
     float distance = 0.0f;
     bool isActive = false;
@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include "../String/StringUtility.h"
+
+#include <Windows.h>
+#else
+// Linux のツール (project/Tools) 用
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <utility>
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      fileHandle_(std::exchange(other.fileHandle_, nullptr)),
+      mappingHandle_(std::exchange(other.mappingHandle_, nullptr)) {}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    Close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    fileHandle_ = std::exchange(other.fileHandle_, nullptr);
+    mappingHandle_ = std::exchange(other.mappingHandle_, nullptr);
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string &filePath) {
+  Close();
+
+  HANDLE file = CreateFileW(StringUtility::ConvertString(filePath).c_str(),
+                            GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  fileHandle_ = file;
+
+  LARGE_INTEGER fileSize{};
+  if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+    Close();
+    return false;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr) {
+    Close();
+    return false;
+  }
+  mappingHandle_ = mapping;
+
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (view == nullptr) {
+    Close();
+    return false;
+  }
+  data_ = static_cast<const uint8_t *>(view);
+  size_ = static_cast<size_t>(fileSize.QuadPart);
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+    data_ = nullptr;
+  }
+  if (mappingHandle_) {
+    CloseHandle(static_cast<HANDLE>(mappingHandle_));
+    mappingHandle_ = nullptr;
+  }
+  if (fileHandle_) {
+    CloseHandle(static_cast<HANDLE>(fileHandle_));
+    fileHandle_ = nullptr;
+  }
+  size_ = 0;
+}
+
+#else
+
+bool MappedFile::Open(const std::string &filePath) {
+  Close();
+
+  const int file = open(filePath.c_str(), O_RDONLY);
+  if (file < 0) {
+    return false;
+  }
+  struct stat status {};
+  if (fstat(file, &status) != 0 || status.st_size == 0) {
+    close(file);
+    return false;
+  }
+
+  // マップした後はファイルを閉じてもマップは残る
+  void *view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ,
+                    MAP_PRIVATE, file, 0);
+  close(file);
+  if (view == MAP_FAILED) {
+    return false;
+  }
+  data_ = static_cast<const uint8_t *>(view);
+  size_ = static_cast<size_t>(status.st_size);
+  return true;
+}
+
+void MappedFile::Close() {
+  if (data_) {
+    munmap(const_cast<uint8_t *>(data_), size_);
+    data_ = nullptr;
+  }
+  size_ = 0;
+}
+
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// 読み取り専用のメモリマップドファイル
+// ファイル全体をアドレス空間に割り当て、コピーせずに参照する
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  // ハンドルを二重に閉じないよう、コピーは禁止してムーブのみ許可する
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&other) noexcept;
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /// <summary>
+  /// ファイルを開いてマップする (既に開いている場合は閉じてから開く)
+  /// </summary>
+  /// <param name="filePath">ファイルパス (UTF-8)</param>
+  /// <returns>true = 成功 (空のファイルは失敗扱い)</returns>
+  bool Open(const std::string &filePath);
+
+  // マップを解除してファイルを閉じる
+  void Close();
+
+  bool IsOpen() const { return data_ != nullptr; }
+  const uint8_t *GetData() const { return data_; }
+  size_t GetSize() const { return size_; }
+  std::span<const uint8_t> GetBytes() const { return {data_, size_}; }
+
+private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  void *fileHandle_ = nullptr;    // HANDLE (Windows.h をヘッダーに持ち込まないため void*)
+  void *mappingHandle_ = nullptr; // HANDLE
+};
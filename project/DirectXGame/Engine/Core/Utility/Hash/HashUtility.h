@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// ハッシュユーティリティ (FNV-1a 64bit)
+// キャッシュのキー生成用。暗号用途には使わないこと
+namespace HashUtility {
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+// バイト列をハッシュに混ぜ込む
+inline uint64_t HashBytes(const void *data, size_t size,
+                          uint64_t hash = kFnvOffsetBasis) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+// 値をハッシュに混ぜ込む
+// ※パディングを含む構造体を丸ごと渡すと不定値が混ざるので、メンバ単位で渡すこと
+template <class T>
+inline uint64_t HashValue(const T &value, uint64_t hash = kFnvOffsetBasis) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  if constexpr (std::is_same_v<T, bool>) {
+    const uint8_t byte = value ? 1 : 0;
+    return HashBytes(&byte, 1, hash);
+  } else {
+    return HashBytes(&value, sizeof(T), hash);
+  }
+}
+
+}; // namespace HashUtility
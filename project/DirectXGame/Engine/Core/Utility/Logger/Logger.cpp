@@ -1,10 +1,13 @@
 #include "../Logger/Logger.h"
 
 #include <chrono>
+#ifdef _WIN32
 #include <dxgidebug.h>
+#endif
 #include <filesystem>
 #include <format>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 namespace fs = std::filesystem;
@@ -15,6 +18,8 @@ namespace Logger {
 	static std::ofstream logStream;
     // 【ファイル書き込みに使うポインタ】Log関数で使用
 	static std::ofstream* fileStream = nullptr;
+	// 【書き込みの排他】ワーカースレッドからも呼ばれるため、1行ずつ書き込む
+	static std::mutex logMutex;
 
 	// 設定定数
 	const std::string LOG_DIR = "logs";
@@ -71,15 +76,26 @@ namespace Logger {
 			auto now = std::chrono::system_clock::now();
 			std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
 				nowSeconds = std::chrono::time_point_cast<std::chrono::seconds>(now);
+#ifdef _WIN32
 			std::chrono::zoned_time localTime{ std::chrono::current_zone(), nowSeconds };
 			std::string dateStr = std::format("{:%Y-%m-%d %H:%M:%S}", localTime);
+#else
+			// タイムゾーンのデータベースがない環境 (Linux のツール) では UTC で記録する
+			std::string dateStr = std::format("{:%Y-%m-%d %H:%M:%S} UTC", nowSeconds);
+#endif
 			Log("\n--- Logging Started: " + dateStr + " ---\n");
 		}
 	}
 
 	void Log(const std::string& message) {
-		// VS出力に出力
+		std::lock_guard<std::mutex> lock(logMutex);
+
+		// VS出力に出力 (Windows 以外のツールでは標準エラー出力)
+#ifdef _WIN32
 		OutputDebugStringA((message + "\n").c_str());
+#else
+		std::cerr << message << '\n';
+#endif
 
 		// ファイルストリームが有効ならファイルにも書き込む
 		if (fileStream && fileStream->is_open()) {
@@ -90,6 +106,8 @@ namespace Logger {
 
 	void Log(std::ostream& os, const std::string& message) {
 		os << message << std::endl;
+#ifdef _WIN32
 		OutputDebugStringA(message.c_str());
+#endif
 	}
 } // namespace Logger
\ No newline at end of file
@@ -21,6 +21,13 @@ struct Vector4 {
   float w;
 }; // 合計16バイト。float*4
 
+struct Quaternion {
+  float x;
+  float y;
+  float z;
+  float w;
+}; // 回転を表す単位クォータニオン。float*4=16バイト
+
 struct Matrix4x4 {
   float m[4][4];
 }; // 4x4行列の構造体。float*16=64バイト
@@ -0,0 +1,27 @@
+#pragma once
+#include <algorithm>
+#include <thread>
+
+// スレッドユーティリティ
+// ワーカースレッド (ModelManager / TextureStreamer) はコア数ぶん並列に動くので、
+// その中で呼ばれる処理がさらにスレッドを立てるとコア数の2乗のスレッドが生まれる
+// 1つの処理を分割する側は GetParallelThreadCount() でスレッド数を決めること
+namespace ThreadUtility {
+
+// 現在のスレッドがワーカーか (MarkWorkerThread で立てる)
+inline thread_local bool isWorkerThread = false;
+
+// ワーカースレッドの先頭で呼ぶ
+inline void MarkWorkerThread() { isWorkerThread = true; }
+
+inline bool IsWorkerThread() { return isWorkerThread; }
+
+// 1つの処理を分割するスレッド数 (ワーカー上では1、それ以外はコア数)
+inline unsigned int GetParallelThreadCount() {
+  if (isWorkerThread) {
+    return 1;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}; // namespace ThreadUtility
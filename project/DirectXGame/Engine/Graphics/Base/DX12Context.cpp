@@ -1,4 +1,5 @@
 #include <cassert>
+#include <cstring>
 #include <filesystem>
 #include <format>
 #include <thread>
@@ -76,6 +77,9 @@ void DX12Context::Initialize() {
   // DCXコンパイラの生成
   CreateDXCCompiler();
 
+  // 転送用のリングバッファの生成
+  CreateStagingRing();
+
   // 生成直後に一度閉じる
   // これにより「最初は Closed 状態」というルールが確定する
   HRESULT hr;
@@ -90,6 +94,17 @@ void DX12Context::Initialize() {
 void DX12Context::Finalize() {
     // まずGPUの処理完了を待つ
     WaitForGpu();
+    // 0. 遅延解放待ちのリソースはもう参照されていないので全て解放
+    {
+        std::lock_guard<std::mutex> lock(pendingReleaseMutex_);
+        pendingReleases_.clear();
+    }
+    // 転送用のリングバッファ
+    if (stagingResource_ && stagingData_) {
+        stagingResource_->Unmap(0, nullptr);
+        stagingData_ = nullptr;
+    }
+    stagingResource_.Reset();
     // 1. コマンドリスト関連
     commandList_.Reset();
     commandAllocator_.Reset();
@@ -206,6 +221,7 @@ void DX12Context::PostDraw() {
   // コマンドリストを閉じる (Open -> Closed)
   HRESULT hr = commandList_->Close();
   assert(SUCCEEDED(hr));
+  isCommandListOpen_ = false;
 
   // コマンドを実行させる (Closed -> Executing)
   ID3D12CommandList *commandLists[] = { commandList_.Get() };
@@ -215,6 +231,8 @@ void DX12Context::PostDraw() {
   fenceValue_++;
   hr = commandQueue_->Signal(fence_.Get(), fenceValue_);
   assert(SUCCEEDED(hr));
+  // このフレームで切り出した転送用の領域は、このフェンスで再利用できる
+  stagingRing_.Close(fenceValue_);
 
   // Fenceの値が指定したSignal値にたどり着いているか確認する
   if (fence_->GetCompletedValue() < fenceValue_) {
@@ -225,6 +243,9 @@ void DX12Context::PostDraw() {
       WaitForSingleObject(fenceEvent_, INFINITE);
   }
 
+  // GPUが完了したので、前フレームまでに遅延解放を依頼されたリソースを解放
+  ProcessDeferredReleases();
+
   // FPS固定用の更新（これはどこでも良い）
   UpdateFixFPS();
 
@@ -255,6 +276,9 @@ void DX12Context::WaitForGpu() {
     // フェンス値を更新してシグナルを送る
     fenceValue_++;
     commandQueue_->Signal(fence_.Get(), fenceValue_);
+    // 開いたままのコマンドリストが使う転送範囲に、まだ実行していないコマンドのフェンス値を付けないようにする
+    assert(!isCommandListOpen_);
+    stagingRing_.Close(fenceValue_);
 
     // フェンス値が到達するまで待つ
     if (fence_->GetCompletedValue() < fenceValue_) {
@@ -263,6 +287,15 @@ void DX12Context::WaitForGpu() {
     }
 }
 
+void DX12Context::DeferredRelease(ComPtr<ID3D12Resource> resource) {
+    if (!resource) {
+        return;
+    }
+    // 現在記録中のコマンドは次の PostDraw で fenceValue_ + 1 をシグナルする
+    std::lock_guard<std::mutex> lock(pendingReleaseMutex_);
+    pendingReleases_.push_back({ std::move(resource), fenceValue_ + 1 });
+}
+
 #pragma endregion publicメンバ関数
 
 #pragma region privateメンバ関数
@@ -592,6 +625,19 @@ void DX12Context::CreateDXCCompiler() {
   assert(SUCCEEDED(hr));
 }
 
+// フェンスが到達した遅延解放リソースを解放する
+void DX12Context::ProcessDeferredReleases() {
+  const uint64_t completedValue = fence_->GetCompletedValue();
+
+  // 転送用のリングバッファも同じフェンスで再利用する
+  stagingRing_.Retire(completedValue);
+
+  std::lock_guard<std::mutex> lock(pendingReleaseMutex_);
+  std::erase_if(pendingReleases_, [completedValue](const PendingRelease &pending) {
+    return pending.fenceValue <= completedValue;
+  });
+}
+
 #pragma region 60FPS固定用
 
 void DX12Context::InitializeFixFPS() {
@@ -646,6 +692,9 @@ void DX12Context::ExecuteInitialCommandAndSync() {
 
   WaitForGpu();
 
+  // 完了したので、転送用の領域と遅延解放のリソースを返す
+  ProcessDeferredReleases();
+
   // 次のフレーム用のコマンドリストを準備
   hr = commandAllocator_->Reset();
   assert(SUCCEEDED(hr));
@@ -853,9 +902,10 @@ D3D12_GPU_DESCRIPTOR_HANDLE DX12Context::GetGPUDescriptorHandle(
 #pragma endregion ハンドルのゲッター
 
 // テクスチャデータの転送
-ComPtr<ID3D12Resource>
-DX12Context::UploadTextureData(ComPtr<ID3D12Resource> texture,
-                               const DirectX::ScratchImage &mipImages) {
+void DX12Context::UploadTextureData(ComPtr<ID3D12Resource> texture,
+                                    const DirectX::ScratchImage &mipImages) {
+
+  assert(isCommandListOpen_);
 
   std::vector<D3D12_SUBRESOURCE_DATA> subresources;
   DirectX::PrepareUpload(device_.Get(), mipImages.GetImages(),
@@ -863,12 +913,17 @@ DX12Context::UploadTextureData(ComPtr<ID3D12Resource> texture,
                          subresources);
   uint64_t intermediateSize =
       GetRequiredIntermediateSize(texture.Get(), 0, UINT(subresources.size()));
-  ComPtr<ID3D12Resource> intermediateResource =
-      CreateBufferResource(intermediateSize);
 
-  UpdateSubresources(commandList_.Get(), texture.Get(),
-                     intermediateResource.Get(), 0, 0,
-                     UINT(subresources.size()), subresources.data());
+  // 転送元の領域を切り出し、オフセットを指定して書き込む
+  uint64_t intermediateOffset = 0;
+  uint8_t *mappedData = nullptr;
+  ID3D12Resource *intermediateResource =
+      AllocateStaging(intermediateSize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT,
+                      intermediateOffset, mappedData);
+
+  UpdateSubresources(commandList_.Get(), texture.Get(), intermediateResource,
+                     intermediateOffset, 0, UINT(subresources.size()),
+                     subresources.data());
 
   // Textureへの転送後は利用できるよう、D3D12_RESOURCE_STATE_COPY_DESTからD3D12_RESOURCE_STATE_GENERIC_READへResourceStateを変更する
   D3D12_RESOURCE_BARRIER barrier{};
@@ -879,7 +934,80 @@ DX12Context::UploadTextureData(ComPtr<ID3D12Resource> texture,
   barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
   barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_GENERIC_READ;
   commandList_->ResourceBarrier(1, &barrier);
-  return intermediateResource;
+}
+
+ComPtr<ID3D12Resource>
+DX12Context::CreateStaticBufferResource(const void *data, size_t sizeInBytes,
+                                        D3D12_RESOURCE_STATES stateAfter) {
+  assert(isCommandListOpen_);
+  assert(sizeInBytes > 0 && "CreateStaticBufferResource called with size 0");
+
+  // VRAM上にバッファを作る (転送先なので COPY_DEST で作る)
+  D3D12_HEAP_PROPERTIES heapProperties{};
+  heapProperties.Type = D3D12_HEAP_TYPE_DEFAULT;
+  D3D12_RESOURCE_DESC resourceDesc{};
+  resourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+  resourceDesc.Width = sizeInBytes;
+  resourceDesc.Height = 1;
+  resourceDesc.DepthOrArraySize = 1;
+  resourceDesc.MipLevels = 1;
+  resourceDesc.SampleDesc.Count = 1;
+  resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+  ComPtr<ID3D12Resource> resource = nullptr;
+  HRESULT hr = device_->CreateCommittedResource(
+      &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+      D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&resource));
+  assert(SUCCEEDED(hr));
+
+  // 転送用の領域へ書き込み、コピーを積む
+  uint64_t stagingOffset = 0;
+  uint8_t *mappedData = nullptr;
+  ID3D12Resource *stagingResource =
+      AllocateStaging(sizeInBytes, 16, stagingOffset, mappedData);
+  std::memcpy(mappedData, data, sizeInBytes);
+  commandList_->CopyBufferRegion(resource.Get(), 0, stagingResource,
+                                 stagingOffset, sizeInBytes);
+
+  // 転送後は指定された状態で使う
+  D3D12_RESOURCE_BARRIER barrier{};
+  barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+  barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+  barrier.Transition.pResource = resource.Get();
+  barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+  barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+  barrier.Transition.StateAfter = stateAfter;
+  commandList_->ResourceBarrier(1, &barrier);
+  return resource;
+}
+
+void DX12Context::CreateStagingRing() {
+  stagingResource_ = CreateBufferResource(kStagingRingSize);
+  HRESULT hr = stagingResource_->Map(0, nullptr,
+                                     reinterpret_cast<void **>(&stagingData_));
+  assert(SUCCEEDED(hr));
+  stagingRing_.Initialize(kStagingRingSize);
+}
+
+ID3D12Resource *DX12Context::AllocateStaging(uint64_t sizeInBytes,
+                                             uint64_t alignment,
+                                             uint64_t &offset,
+                                             uint8_t *&mappedData) {
+  if (stagingRing_.Allocate(sizeInBytes, alignment, offset)) {
+    mappedData = stagingData_ + offset;
+    return stagingResource_.Get();
+  }
+
+  // リングより大きい、またはGPUが使用中の範囲で埋まっている場合は一時的なバッファを作る
+  Log(std::format("INFO: Staging ring fallback ({} bytes, {} bytes in use)\n",
+                  sizeInBytes, stagingRing_.GetUsedSize()));
+  ComPtr<ID3D12Resource> resource = CreateBufferResource(sizeInBytes);
+  HRESULT hr = resource->Map(0, nullptr, reinterpret_cast<void **>(&mappedData));
+  assert(SUCCEEDED(hr));
+  offset = 0;
+  ID3D12Resource *result = resource.Get();
+  DeferredRelease(std::move(resource)); // このフレームの完了後に解放 (解放時にアンマップされる)
+  return result;
 }
 
 #pragma endregion privateヘルパー関数
@@ -5,9 +5,12 @@
 #include <d3d12.h>
 #include <dxcapi.h>
 #include <dxgi1_6.h>
+#include <mutex>
+#include <vector>
 #include <wrl.h>
 
 #include "externals/DirectXTex/DirectXTex.h"
+#include "UploadRingAllocator.h"
 
 // DirectX基盤
 class DX12Context {
@@ -73,6 +76,21 @@ private: // メンバ変数
   uint64_t fenceValue_ = 0;     // GPUが次に書き込むフェンス値(CPUで保持)
   HANDLE fenceEvent_ = nullptr; // フェンスの待機イベント
 
+  // 遅延解放待ちのリソース (fenceValue に到達したら解放する)
+  struct PendingRelease {
+    ComPtr<ID3D12Resource> resource;
+    uint64_t fenceValue;
+  };
+  std::vector<PendingRelease> pendingReleases_;
+  std::mutex pendingReleaseMutex_; // ワーカースレッドからも積まれるため保護する
+
+  // 転送用のリングバッファ (1つのアップロードヒープを常にマップしておき、転送ごとに切り出す)
+  // 切り出した範囲は、そのコマンドのフェンスが完了したら再利用する
+  static const uint64_t kStagingRingSize = 64 * 1024 * 1024;
+  ComPtr<ID3D12Resource> stagingResource_ = nullptr;
+  uint8_t *stagingData_ = nullptr;
+  UploadRingAllocator stagingRing_;
+
   // ビューポート矩形
   D3D12_VIEWPORT viewport_ = {};
 
@@ -153,8 +171,20 @@ public: // メンバ関数
 
   void WaitForGpu();
 
+  // GPUが完了したフェンス値の取得
+  uint64_t GetCompletedFenceValue() const { return fence_->GetCompletedValue(); }
+  // 現在記録中のコマンドが完了したときに到達するフェンス値 (次の PostDraw / ExecuteInitialCommandAndSync でシグナルされる)
+  uint64_t GetNextFenceValue() const { return fenceValue_ + 1; }
+
 #pragma endregion
 
+  /// <summary>
+  /// GPUが参照している可能性のあるリソースを、現在のフレームの完了後に解放する
+  /// (WaitForGpu で全体を止めずに古いバッファを手放すために使う)
+  /// </summary>
+  /// <param name="resource">解放するリソース</param>
+  void DeferredRelease(ComPtr<ID3D12Resource> resource);
+
 #pragma endregion publicメンバ関数
 
 private: // メンバ関数
@@ -182,6 +212,14 @@ private: // メンバ関数
   void InitializeScissorRect();
   // DXCコンパイラの生成
   void CreateDXCCompiler();
+  // フェンスが到達した遅延解放リソースを解放する
+  void ProcessDeferredReleases();
+  // 転送用のリングバッファの生成
+  void CreateStagingRing();
+  // 転送用の領域を切り出す (リングに入らなければ一時的なアップロード用バッファを作る)
+  // 転送元のリソースと、その中のオフセット・書き込み先を返す
+  ID3D12Resource *AllocateStaging(uint64_t sizeInBytes, uint64_t alignment,
+                                  uint64_t &offset, uint8_t *&mappedData);
   // ImGuiの初期化
   // void InitializeImGui();
 
@@ -232,15 +270,25 @@ public: // ヘルパー関数
   CreateTextureResource(const DirectX::TexMetadata &metadata);
 
   /// <summary>
-  /// テクスチャデータの転送
+  /// テクスチャデータの転送 (コマンドリストが開いていること)
+  /// 転送用のリングバッファから切り出して積む。入らない場合は一時的なアップロード用バッファを作り、完了後に解放する
   /// </summary>
-  /// <param name="texture">テクスチャリソース</param>
+  /// <param name="texture">テクスチャリソース (COPY_DEST 状態)</param>
   /// <param name="mipImages">テクスチャデータ</param>
-  /// <returns>転送に使用したアップロード用バッファリソース</returns>
-  [[nodiscard]] // 戻り値を破棄しない
+  void UploadTextureData(ComPtr<ID3D12Resource> texture,
+                         const DirectX::ScratchImage &mipImages);
+
+  /// <summary>
+  /// 書き換えないバッファを VRAM (DefaultHeap) に作り、転送用のリングバッファ経由で中身を転送する
+  /// (コマンドリストが開いていること。CPUから毎フレーム書き換えるバッファには CreateBufferResource を使う)
+  /// </summary>
+  /// <param name="data">転送するデータ</param>
+  /// <param name="sizeInBytes">バッファのサイズ</param>
+  /// <param name="stateAfter">転送後の状態 (頂点なら VERTEX_AND_CONSTANT_BUFFER など)</param>
+  /// <returns>生成したバッファリソース</returns>
   ComPtr<ID3D12Resource>
-  UploadTextureData(ComPtr<ID3D12Resource> texture,
-                    const DirectX::ScratchImage &mipImages);
+  CreateStaticBufferResource(const void *data, size_t sizeInBytes,
+                             D3D12_RESOURCE_STATES stateAfter);
 
   /// <summary>
   /// デスクリプタヒープを生成する
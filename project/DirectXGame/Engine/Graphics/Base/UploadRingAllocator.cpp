@@ -0,0 +1,52 @@
+#include "UploadRingAllocator.h"
+
+#include <cassert>
+
+void UploadRingAllocator::Initialize(uint64_t capacity) {
+    capacity_ = capacity;
+    head_ = 0;
+    tail_ = 0;
+    pendingFences_.clear();
+}
+
+bool UploadRingAllocator::Allocate(uint64_t sizeInBytes, uint64_t alignment, uint64_t& offset) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+    if (sizeInBytes == 0 || sizeInBytes > capacity_) {
+        return false;
+    }
+
+    // リング上の位置をアラインメントに合わせ、末尾に入らなければ先頭 (0) へ折り返す
+    // (折り返した場合、飛ばした末尾は次の Retire までそのまま使用中として扱う)
+    const uint64_t position = head_ % capacity_;
+    uint64_t alignedPosition = (position + alignment - 1) & ~(alignment - 1);
+    if (alignedPosition + sizeInBytes > capacity_) {
+        alignedPosition = capacity_;
+    }
+    const uint64_t begin = head_ + (alignedPosition - position);
+    const uint64_t end = begin + sizeInBytes;
+
+    // GPU が使用中の範囲 (tail_ から) に追いつくなら切り出せない
+    if (end - tail_ > capacity_) {
+        return false;
+    }
+    head_ = end;
+    offset = begin % capacity_;
+    return true;
+}
+
+void UploadRingAllocator::Close(uint64_t fenceValue) {
+    // 何も切り出していなければ記録しない
+    const uint64_t lastHead = pendingFences_.empty() ? tail_ : pendingFences_.back().head;
+    if (head_ == lastHead) {
+        return;
+    }
+    assert(pendingFences_.empty() || pendingFences_.back().fenceValue <= fenceValue);
+    pendingFences_.push_back({fenceValue, head_});
+}
+
+void UploadRingAllocator::Retire(uint64_t completedFenceValue) {
+    while (!pendingFences_.empty() && pendingFences_.front().fenceValue <= completedFenceValue) {
+        tail_ = pendingFences_.front().head;
+        pendingFences_.pop_front();
+    }
+}
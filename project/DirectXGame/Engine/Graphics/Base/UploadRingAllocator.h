@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+// ============================================================
+// UploadRingAllocator — 転送用バッファ (アップロードヒープ) をリングとして切り出す
+//   ・Allocate は先頭から順に切り出し、末尾に入らなければ先頭へ折り返す
+//   ・Close で、前回の Close 以降に切り出した範囲へ、そのコマンドが完了するフェンス値を付ける
+//   ・Retire で、完了したフェンス値までの範囲を古い順に返す
+// オフセットの計算だけを行い、GPU のリソースは持たない (D3D12 なしで確かめられる)
+// ============================================================
+class UploadRingAllocator {
+public:
+    /// <summary>
+    /// 初期化 (切り出し中の範囲はすべて破棄する)
+    /// </summary>
+    /// <param name="capacity">リングの大きさ (バイト)</param>
+    void Initialize(uint64_t capacity);
+
+    /// <summary>
+    /// 範囲を切り出す
+    /// </summary>
+    /// <param name="sizeInBytes">大きさ</param>
+    /// <param name="alignment">オフセットのアラインメント (2の累乗)</param>
+    /// <param name="offset">切り出した範囲の先頭 (リングの先頭からのバイト数)</param>
+    /// <returns>false = リングより大きい、または GPU が使用中の範囲で埋まっている</returns>
+    bool Allocate(uint64_t sizeInBytes, uint64_t alignment, uint64_t& offset);
+
+    // 前回の Close 以降に切り出した範囲を、fenceValue のシグナルで解放できるようにする
+    void Close(uint64_t fenceValue);
+
+    // GPU が完了したフェンス値までの範囲を解放する
+    void Retire(uint64_t completedFenceValue);
+
+    // ゲッター
+    uint64_t GetCapacity() const { return capacity_; }
+    // 使用中のバイト数 (折り返しで飛ばした末尾も含む)
+    uint64_t GetUsedSize() const { return head_ - tail_; }
+    // 解放待ちのフェンスの数
+    size_t GetPendingFenceCount() const { return pendingFences_.size(); }
+
+private:
+    // Close した時点の先頭の位置と、その範囲が解放できるフェンス値
+    struct PendingFence {
+        uint64_t fenceValue;
+        uint64_t head;
+    };
+
+private:
+    uint64_t capacity_ = 0;
+    // 先頭 (次に切り出す位置) と末尾 (GPU が使用中の最古の位置)
+    // どちらも折り返さずに増え続ける通し番号で、リング上の位置は capacity_ で割った余り
+    uint64_t head_ = 0;
+    uint64_t tail_ = 0;
+    std::deque<PendingFence> pendingFences_;
+};
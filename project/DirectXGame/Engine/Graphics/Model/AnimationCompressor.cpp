@@ -0,0 +1,275 @@
+#include "AnimationCompressor.h"
+#include "AnimationSampler.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <format>
+
+namespace {
+
+Vector3 Lerp(const Vector3& a, const Vector3& b, float t) {
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+}
+
+float Distance(const Vector3& a, const Vector3& b) {
+    const float x = a.x - b.x, y = a.y - b.y, z = a.z - b.z;
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+float MaxDifference(const Vector3& a, const Vector3& b) {
+    return std::max({std::fabs(a.x - b.x), std::fabs(a.y - b.y), std::fabs(a.z - b.z)});
+}
+
+// 2つの回転の間の角度 (q と -q は同じ回転として扱う)
+// 小さい角度で acos(内積) は桁落ちするので、弦の長さ |a - b| = 2 sin(θ/4) から求める
+float Angle(const Quaternion& a, const Quaternion& b) {
+    const float sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f ? -1.0f : 1.0f;
+    const float x = a.x - b.x * sign, y = a.y - b.y * sign, z = a.z - b.z * sign, w = a.w - b.w * sign;
+    return 4.0f * std::asin(std::min(std::sqrt(x * x + y * y + z * z + w * w) * 0.5f, 1.0f));
+}
+
+// key と key + 1 の間の補間係数
+float Factor(float time0, float time1, float time) {
+    return time1 > time0 ? std::clamp((time - time0) / (time1 - time0), 0.0f, 1.0f) : 0.0f;
+}
+
+// 前後に残したキーの補間で許容誤差に収まるキーを捨てる
+template <class T, class Interpolate, class Error>
+std::vector<Keyframe<T>> ReduceKeys(const std::vector<Keyframe<T>>& keys, float tolerance, Interpolate interpolate,
+                                    Error error) {
+    std::vector<Keyframe<T>> result;
+    if (keys.empty()) {
+        return result;
+    }
+    result.push_back(keys[0]);
+    size_t anchor = 0;
+    for (size_t end = 2; end < keys.size(); ++end) {
+        // anchor と end の間のキーを全部捨てられるか
+        bool canSkip = true;
+        for (size_t k = anchor + 1; k < end && canSkip; ++k) {
+            const float t = Factor(keys[anchor].time, keys[end].time, keys[k].time);
+            canSkip = error(interpolate(keys[anchor].value, keys[end].value, t), keys[k].value) <= tolerance;
+        }
+        if (!canSkip) {
+            anchor = end - 1;
+            result.push_back(keys[anchor]);
+        }
+    }
+    if (keys.size() > 1) {
+        result.push_back(keys.back());
+    }
+    // 2キーしか残らず両者が同じ値なら、定数として1キーにする
+    if (result.size() == 2 && error(result[0].value, result[1].value) <= tolerance) {
+        result.pop_back();
+    }
+    return result;
+}
+
+uint16_t QuantizeUnit(float value) {
+    return static_cast<uint16_t>(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+
+uint16_t QuantizeTime(float time, float duration) {
+    return duration > 0.0f ? QuantizeUnit(time / duration) : 0;
+}
+
+// キーの値の範囲 (最小値と幅)
+void ComputeRange(const std::vector<Keyframe<Vector3>>& keys, Vector3& min, Vector3& extent) {
+    min = keys[0].value;
+    Vector3 max = keys[0].value;
+    for (const Keyframe<Vector3>& key : keys) {
+        min = {std::min(min.x, key.value.x), std::min(min.y, key.value.y), std::min(min.z, key.value.z)};
+        max = {std::max(max.x, key.value.x), std::max(max.y, key.value.y), std::max(max.z, key.value.z)};
+    }
+    extent = {max.x - min.x, max.y - min.y, max.z - min.z};
+}
+
+void EncodeVector3(const Vector3& value, const Vector3& min, const Vector3& extent, uint16_t* out) {
+    out[0] = extent.x > 0.0f ? QuantizeUnit((value.x - min.x) / extent.x) : 0;
+    out[1] = extent.y > 0.0f ? QuantizeUnit((value.y - min.y) / extent.y) : 0;
+    out[2] = extent.z > 0.0f ? QuantizeUnit((value.z - min.z) / extent.z) : 0;
+}
+
+void EncodeQuaternion(const Quaternion& rotate, uint16_t* out) {
+    float components[4] = {rotate.x, rotate.y, rotate.z, rotate.w};
+    const float length = std::sqrt(components[0] * components[0] + components[1] * components[1] +
+                                   components[2] * components[2] + components[3] * components[3]);
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < 4; ++i) {
+        if (std::fabs(components[i]) > std::fabs(components[largest])) {
+            largest = i;
+        }
+    }
+    // 省いた成分を正にそろえる (q と -q は同じ回転)
+    const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    uint64_t bits = static_cast<uint64_t>(largest) << 46;
+    for (uint32_t i = 0, shift = 30; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        const float normalized = (components[i] * sign / length + 0.70710678f) / 1.41421356f;
+        const uint64_t quantized = static_cast<uint64_t>(std::clamp(normalized, 0.0f, 1.0f) * 32767.0f + 0.5f);
+        bits |= quantized << shift;
+        shift -= 15;
+    }
+    out[0] = static_cast<uint16_t>(bits >> 32);
+    out[1] = static_cast<uint16_t>(bits >> 16);
+    out[2] = static_cast<uint16_t>(bits);
+}
+
+// 元のキーを補間した値 (誤差の計測用)
+template <class T, class Interpolate>
+T SampleSource(const std::vector<Keyframe<T>>& keys, float time, Interpolate interpolate) {
+    const auto it = std::upper_bound(keys.begin(), keys.end(), time,
+                                     [](float t, const Keyframe<T>& keyframe) { return t < keyframe.time; });
+    if (it == keys.begin()) {
+        return keys.front().value;
+    }
+    if (it == keys.end()) {
+        return keys.back().value;
+    }
+    const Keyframe<T>& previous = *(it - 1);
+    return interpolate(previous.value, it->value, Factor(previous.time, it->time, time));
+}
+
+// 圧縮したキーを補間した値 (誤差の計測用)
+template <class Decode, class Interpolate>
+auto SampleCompressed(const CompressedAnimationClip& clip, const CompressedNodeAnimation& track, uint32_t component,
+                      float time, Decode decode, Interpolate interpolate) {
+    const uint16_t* times = &clip.keyTimes[track.keyOffsets[component]];
+    const uint16_t* values = &clip.keyValues[track.keyOffsets[component] * 3];
+    const uint32_t count = track.keyCounts[component];
+    const float quantizedTime = clip.duration > 0.0f ? time / clip.duration * 65535.0f : 0.0f;
+    const uint32_t next = static_cast<uint32_t>(
+        std::upper_bound(times, times + count, quantizedTime, [](float t, uint16_t keyTime) { return t < keyTime; }) -
+        times);
+    if (next == 0) {
+        return decode(values);
+    }
+    if (next == count) {
+        return decode(values + (count - 1) * 3);
+    }
+    return interpolate(decode(values + (next - 1) * 3), decode(values + next * 3),
+                       Factor(times[next - 1], times[next], quantizedTime));
+}
+
+// 元のキーの時刻と、その中間の時刻で誤差を測る
+template <class T, class Decode, class Interpolate, class Error>
+float MeasureError(const std::vector<Keyframe<T>>& keys, const CompressedAnimationClip& clip,
+                   const CompressedNodeAnimation& track, uint32_t component, Decode decode, Interpolate interpolate,
+                   Error error) {
+    float maxError = 0.0f;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        const float times[2] = {keys[i].time, i + 1 < keys.size() ? (keys[i].time + keys[i + 1].time) * 0.5f : keys[i].time};
+        for (float time : times) {
+            const T expected = SampleSource(keys, time, interpolate);
+            const T actual = SampleCompressed(clip, track, component, time, decode, interpolate);
+            maxError = std::max(maxError, error(actual, expected));
+        }
+    }
+    return maxError;
+}
+
+} // namespace
+
+namespace AnimationCompressor {
+
+CompressedAnimationClip Compress(const AnimationClip& clip, const Settings& settings, Stats* stats) {
+    CompressedAnimationClip result;
+    result.name = clip.name;
+    result.duration = clip.duration;
+    result.tracks.reserve(clip.tracks.size());
+
+    const auto slerp = [](const Quaternion& a, const Quaternion& b, float t) { return Animation::Slerp(a, b, t); };
+    for (const NodeAnimation& source : clip.tracks) {
+        assert(!source.translate.empty() && !source.rotate.empty() && !source.scale.empty());
+        const std::vector<Keyframe<Vector3>> translate = ReduceKeys(source.translate, settings.translateTolerance, Lerp, Distance);
+        const std::vector<Keyframe<Quaternion>> rotate = ReduceKeys(source.rotate, settings.rotateTolerance, slerp, Angle);
+        const std::vector<Keyframe<Vector3>> scale = ReduceKeys(source.scale, settings.scaleTolerance, Lerp, MaxDifference);
+
+        CompressedNodeAnimation track;
+        track.nodeIndex = source.nodeIndex;
+        ComputeRange(translate, track.translateMin, track.translateExtent);
+        ComputeRange(scale, track.scaleMin, track.scaleExtent);
+
+        // translate, rotate, scale の順にキーを並べる
+        track.keyOffsets[0] = static_cast<uint32_t>(result.keyTimes.size());
+        track.keyCounts[0] = static_cast<uint32_t>(translate.size());
+        for (const Keyframe<Vector3>& key : translate) {
+            result.keyTimes.push_back(QuantizeTime(key.time, clip.duration));
+            result.keyValues.resize(result.keyValues.size() + 3);
+            EncodeVector3(key.value, track.translateMin, track.translateExtent, &result.keyValues[result.keyValues.size() - 3]);
+        }
+        track.keyOffsets[1] = static_cast<uint32_t>(result.keyTimes.size());
+        track.keyCounts[1] = static_cast<uint32_t>(rotate.size());
+        for (const Keyframe<Quaternion>& key : rotate) {
+            result.keyTimes.push_back(QuantizeTime(key.time, clip.duration));
+            result.keyValues.resize(result.keyValues.size() + 3);
+            EncodeQuaternion(key.value, &result.keyValues[result.keyValues.size() - 3]);
+        }
+        track.keyOffsets[2] = static_cast<uint32_t>(result.keyTimes.size());
+        track.keyCounts[2] = static_cast<uint32_t>(scale.size());
+        for (const Keyframe<Vector3>& key : scale) {
+            result.keyTimes.push_back(QuantizeTime(key.time, clip.duration));
+            result.keyValues.resize(result.keyValues.size() + 3);
+            EncodeVector3(key.value, track.scaleMin, track.scaleExtent, &result.keyValues[result.keyValues.size() - 3]);
+        }
+        result.tracks.push_back(track);
+    }
+
+    if (stats) {
+        *stats = {};
+        stats->sourceBytes = clip.tracks.size() * sizeof(NodeAnimation);
+        for (size_t i = 0; i < clip.tracks.size(); ++i) {
+            const NodeAnimation& source = clip.tracks[i];
+            const CompressedNodeAnimation& track = result.tracks[i];
+            stats->sourceKeyCount += source.translate.size() + source.rotate.size() + source.scale.size();
+            stats->sourceBytes += (source.translate.size() + source.scale.size()) * sizeof(Keyframe<Vector3>) +
+                                  source.rotate.size() * sizeof(Keyframe<Quaternion>);
+
+            const auto decodeTranslate = [&track](const uint16_t* value) {
+                return DecodeVector3(value, track.translateMin, track.translateExtent);
+            };
+            const auto decodeScale = [&track](const uint16_t* value) {
+                return DecodeVector3(value, track.scaleMin, track.scaleExtent);
+            };
+            const auto decodeRotate = [](const uint16_t* value) { return DecodeQuaternion(value); };
+            stats->maxTranslateError = std::max(
+                stats->maxTranslateError, MeasureError(source.translate, result, track, 0, decodeTranslate, Lerp, Distance));
+            stats->maxRotateError = std::max(
+                stats->maxRotateError, MeasureError(source.rotate, result, track, 1, decodeRotate, slerp, Angle));
+            stats->maxScaleError = std::max(
+                stats->maxScaleError, MeasureError(source.scale, result, track, 2, decodeScale, Lerp, MaxDifference));
+        }
+        stats->keyCount = result.keyTimes.size();
+        stats->compressedBytes = result.tracks.size() * sizeof(CompressedNodeAnimation) +
+                                 (result.keyTimes.size() + result.keyValues.size()) * sizeof(uint16_t);
+    }
+    return result;
+}
+
+void CompressAnimations(ModelData& modelData, const std::string& name) {
+    modelData.compressedAnimations.clear();
+    modelData.compressedAnimations.reserve(modelData.animations.size());
+    const Settings settings;
+    for (const AnimationClip& clip : modelData.animations) {
+        const auto startTime = std::chrono::steady_clock::now();
+        Stats stats;
+        modelData.compressedAnimations.push_back(Compress(clip, settings, &stats));
+        const double milliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+        Logger::Log(std::format("INFO: Animation compressed: {} \"{}\" (keys {} -> {}, {} -> {} bytes, ratio {:.1f}x, "
+                                "max error translate {:.4g} rotate {:.4g} rad scale {:.4g}, {:.3f} ms)\n",
+                                name, clip.name, stats.sourceKeyCount, stats.keyCount, stats.sourceBytes,
+                                stats.compressedBytes,
+                                stats.compressedBytes > 0 ? static_cast<double>(stats.sourceBytes) / stats.compressedBytes : 0.0,
+                                stats.maxTranslateError, stats.maxRotateError, stats.maxScaleError, milliseconds));
+    }
+    // 実行時は圧縮したものだけを使うので、元のキーは捨てる
+    modelData.animations.clear();
+    modelData.animations.shrink_to_fit();
+}
+
+} // namespace AnimationCompressor
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+// ============================================================
+// AnimationCompressor — アニメーションクリップのキーを間引いて量子化する (D3D12 を使わないのでワーカースレッドから呼べる)
+//   ・前後のキーの補間で許容誤差内に収まるキーは捨てる (変化の無い要素は1キーになる)
+//   ・回転は最大成分を省いた残り3成分 (smallest-three) を 15bit ずつ、省いた成分の番号と合わせて48bitにする
+//   ・平行移動とスケールはトラックごとの範囲 (最小値と幅) に対する16bit にする
+//   ・時刻はクリップの長さを 65535 等分した16bit にする
+// 展開は AnimationSampler が補間に使う2キーだけ行うので、展開済みのクリップを持つ必要は無い
+// ============================================================
+namespace AnimationCompressor {
+
+// キーを間引くときの許容誤差
+struct Settings {
+    float translateTolerance = 0.001f; // 距離
+    float rotateTolerance = 0.001f;    // 角度 (ラジアン)
+    float scaleTolerance = 0.001f;     // 倍率の差
+};
+
+// 圧縮の結果 (誤差は元のキーの時刻とキーの中間の時刻で、展開した値と元の値を比べたもの)
+struct Stats {
+    size_t sourceKeyCount = 0;
+    size_t keyCount = 0;
+    size_t sourceBytes = 0;
+    size_t compressedBytes = 0;
+    float maxTranslateError = 0.0f;
+    float maxRotateError = 0.0f; // ラジアン
+    float maxScaleError = 0.0f;
+};
+
+/// <summary>
+/// クリップを圧縮する
+/// </summary>
+/// <param name="clip">元のクリップ (各要素に最低1キーあること)</param>
+/// <param name="settings">許容誤差</param>
+/// <param name="stats">結果の書き込み先 (nullptr 可。誤差の計測は stats を渡したときだけ行う)</param>
+/// <returns>圧縮したクリップ</returns>
+CompressedAnimationClip Compress(const AnimationClip& clip, const Settings& settings, Stats* stats = nullptr);
+
+/// <summary>
+/// modelData.animations をすべて圧縮して compressedAnimations に移し、元のキーは捨てる
+/// クリップごとの圧縮率と最大誤差をログに出す
+/// </summary>
+void CompressAnimations(ModelData& modelData, const std::string& name);
+
+// 16bit の範囲内の値を展開する
+inline Vector3 DecodeVector3(const uint16_t* value, const Vector3& min, const Vector3& extent) {
+    const float scale = 1.0f / 65535.0f;
+    return {min.x + extent.x * (value[0] * scale), min.y + extent.y * (value[1] * scale),
+            min.z + extent.z * (value[2] * scale)};
+}
+
+// smallest-three の48bit (上位2bit が省いた成分の番号、残りが 15bit ずつの3成分) を展開する
+inline Quaternion DecodeQuaternion(const uint16_t* value) {
+    const uint64_t bits = (static_cast<uint64_t>(value[0]) << 32) | (static_cast<uint64_t>(value[1]) << 16) | value[2];
+    const uint32_t largest = static_cast<uint32_t>(bits >> 46) & 3;
+    // 省いた成分が最大なので、残りの成分は ±1/√2 に収まる
+    const float scale = 1.41421356f / 32767.0f;
+    const float offset = -0.70710678f;
+    float components[4];
+    float sumSq = 0.0f;
+    for (uint32_t i = 0, shift = 30; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        components[i] = static_cast<float>((bits >> shift) & 0x7fff) * scale + offset;
+        sumSq += components[i] * components[i];
+        shift -= 15;
+    }
+    components[largest] = std::sqrt(sumSq < 1.0f ? 1.0f - sumSq : 0.0f);
+    return {components[0], components[1], components[2], components[3]};
+}
+
+} // namespace AnimationCompressor
@@ -0,0 +1,284 @@
+#include "AnimationSampler.h"
+#include "AnimationCompressor.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// 補間の始点のキー番号を求める (keyTime(i) <= time < keyTime(i + 1)。範囲外は端のキー)
+template <class KeyTime> uint32_t FindKey(uint32_t keyCount, KeyTime keyTime, float time, uint32_t& cursor) {
+    const uint32_t lastKey = keyCount - 1;
+    uint32_t key = std::min(cursor, lastKey);
+    if (key < lastKey && keyTime(key) <= time && time < keyTime(key + 1)) {
+        // 前回と同じ区間
+    } else if (key + 1 < lastKey && keyTime(key + 1) <= time && time < keyTime(key + 2)) {
+        // 順方向の再生では次の区間に進むだけ
+        ++key;
+    } else {
+        // 時間が戻ったか大きく飛んだので二分探索する (time < keyTime(i) となる最初の i を求める)
+        uint32_t low = 0;
+        uint32_t high = keyCount;
+        while (low < high) {
+            const uint32_t middle = (low + high) / 2;
+            if (time < keyTime(middle)) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        key = low == 0 ? 0 : std::min(low - 1, lastKey);
+    }
+    cursor = key;
+    return key;
+}
+
+template <class T> uint32_t FindKey(const std::vector<Keyframe<T>>& keys, float time, uint32_t& cursor) {
+    return FindKey(static_cast<uint32_t>(keys.size()), [&keys](uint32_t i) { return keys[i].time; }, time, cursor);
+}
+
+// 時刻 time0 ～ time1 の間の補間係数
+float Factor(float time0, float time1, float time) {
+    const float span = time1 - time0;
+    return span > 0.0f ? std::clamp((time - time0) / span, 0.0f, 1.0f) : 0.0f;
+}
+
+// key と key + 1 の間の補間係数
+template <class T> float KeyFactor(const std::vector<Keyframe<T>>& keys, uint32_t key, float time) {
+    if (key + 1 >= keys.size()) {
+        return 0.0f;
+    }
+    return Factor(keys[key].time, keys[key + 1].time, time);
+}
+
+Vector3 SampleVector3(const std::vector<Keyframe<Vector3>>& keys, float time, uint32_t& cursor) {
+    const uint32_t key = FindKey(keys, time, cursor);
+    const float t = KeyFactor(keys, key, time);
+    if (t == 0.0f) {
+        return keys[key].value;
+    }
+    const Vector3& a = keys[key].value;
+    const Vector3& b = keys[key + 1].value;
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+}
+
+Quaternion SampleQuaternion(const std::vector<Keyframe<Quaternion>>& keys, float time, uint32_t& cursor) {
+    const uint32_t key = FindKey(keys, time, cursor);
+    const float t = KeyFactor(keys, key, time);
+    if (t == 0.0f) {
+        return keys[key].value;
+    }
+    return Animation::Slerp(keys[key].value, keys[key + 1].value, t);
+}
+
+// 圧縮したトラックの1要素のキー (component は translate, rotate, scale の順に 0, 1, 2)
+struct CompressedKeys {
+    const uint16_t* times;
+    const uint16_t* values;
+    uint32_t count;
+
+    CompressedKeys(const CompressedAnimationClip& clip, const CompressedNodeAnimation& track, uint32_t component)
+        : times(&clip.keyTimes[track.keyOffsets[component]]), values(&clip.keyValues[track.keyOffsets[component] * 3]),
+          count(track.keyCounts[component]) {}
+
+    // 補間する2キーの番号と係数を求める (時刻は 16bit の単位のまま比べる)
+    uint32_t Find(float quantizedTime, uint32_t& cursor, float& t) const {
+        const uint32_t key = FindKey(count, [this](uint32_t i) { return static_cast<float>(times[i]); }, quantizedTime, cursor);
+        t = key + 1 < count ? Factor(times[key], times[key + 1], quantizedTime) : 0.0f;
+        return key;
+    }
+};
+
+Vector3 SampleCompressedVector3(const CompressedKeys& keys, const Vector3& min, const Vector3& extent,
+                                float quantizedTime, uint32_t& cursor) {
+    float t;
+    const uint32_t key = keys.Find(quantizedTime, cursor, t);
+    const Vector3 a = AnimationCompressor::DecodeVector3(keys.values + key * 3, min, extent);
+    if (t == 0.0f) {
+        return a;
+    }
+    const Vector3 b = AnimationCompressor::DecodeVector3(keys.values + (key + 1) * 3, min, extent);
+    return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+}
+
+Quaternion SampleCompressedQuaternion(const CompressedKeys& keys, float quantizedTime, uint32_t& cursor) {
+    float t;
+    const uint32_t key = keys.Find(quantizedTime, cursor, t);
+    const Quaternion a = AnimationCompressor::DecodeQuaternion(keys.values + key * 3);
+    if (t == 0.0f) {
+        return a;
+    }
+    return Animation::Slerp(a, AnimationCompressor::DecodeQuaternion(keys.values + (key + 1) * 3), t);
+}
+
+} // namespace
+
+void AnimationSampler::Initialize(const AnimationClip* clip) {
+    clip_ = clip;
+    compressedClip_ = nullptr;
+    cursors_.assign(clip ? clip->tracks.size() * 3 : 0, 0);
+}
+
+void AnimationSampler::Initialize(const CompressedAnimationClip* clip) {
+    clip_ = nullptr;
+    compressedClip_ = clip;
+    cursors_.assign(clip ? clip->tracks.size() * 3 : 0, 0);
+}
+
+void AnimationSampler::Clear() {
+    clip_ = nullptr;
+    compressedClip_ = nullptr;
+    cursors_.clear();
+}
+
+float AnimationSampler::GetDuration() const {
+    if (clip_) {
+        return clip_->duration;
+    }
+    return compressedClip_ ? compressedClip_->duration : 0.0f;
+}
+
+void AnimationSampler::Sample(float time, std::span<Matrix4x4> localMatrices) {
+    if (compressedClip_) {
+        SampleCompressed(time, localMatrices);
+        return;
+    }
+    if (!clip_) {
+        return;
+    }
+    for (size_t i = 0; i < clip_->tracks.size(); ++i) {
+        const NodeAnimation& track = clip_->tracks[i];
+        assert(track.nodeIndex < localMatrices.size());
+        // キーはインポート時に各要素最低1つ入れてある
+        const Vector3 translate = SampleVector3(track.translate, time, cursors_[i * 3 + 0]);
+        const Quaternion rotate = SampleQuaternion(track.rotate, time, cursors_[i * 3 + 1]);
+        const Vector3 scale = SampleVector3(track.scale, time, cursors_[i * 3 + 2]);
+        localMatrices[track.nodeIndex] = Animation::MakeTransformMatrix(scale, rotate, translate);
+    }
+}
+
+void AnimationSampler::SampleCompressed(float time, std::span<Matrix4x4> localMatrices) {
+    const CompressedAnimationClip& clip = *compressedClip_;
+    // キーの時刻は duration を 65535 等分した単位なので、問い合わせの時刻を同じ単位にそろえる
+    const float quantizedTime = clip.duration > 0.0f ? time / clip.duration * 65535.0f : 0.0f;
+    for (size_t i = 0; i < clip.tracks.size(); ++i) {
+        const CompressedNodeAnimation& track = clip.tracks[i];
+        assert(track.nodeIndex < localMatrices.size());
+        const Vector3 translate = SampleCompressedVector3(CompressedKeys(clip, track, 0), track.translateMin,
+                                                          track.translateExtent, quantizedTime, cursors_[i * 3 + 0]);
+        const Quaternion rotate = SampleCompressedQuaternion(CompressedKeys(clip, track, 1), quantizedTime, cursors_[i * 3 + 1]);
+        const Vector3 scale = SampleCompressedVector3(CompressedKeys(clip, track, 2), track.scaleMin, track.scaleExtent,
+                                                      quantizedTime, cursors_[i * 3 + 2]);
+        localMatrices[track.nodeIndex] = Animation::MakeTransformMatrix(scale, rotate, translate);
+    }
+}
+
+namespace Animation {
+
+Matrix4x4 MakeTransformMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
+    const float x = rotate.x, y = rotate.y, z = rotate.z, w = rotate.w;
+    Matrix4x4 result;
+    // 列ベクトル規約の回転行列を転置したもの
+    result.m[0][0] = (1.0f - 2.0f * (y * y + z * z)) * scale.x;
+    result.m[0][1] = (2.0f * (x * y + w * z)) * scale.x;
+    result.m[0][2] = (2.0f * (x * z - w * y)) * scale.x;
+    result.m[0][3] = 0.0f;
+    result.m[1][0] = (2.0f * (x * y - w * z)) * scale.y;
+    result.m[1][1] = (1.0f - 2.0f * (x * x + z * z)) * scale.y;
+    result.m[1][2] = (2.0f * (y * z + w * x)) * scale.y;
+    result.m[1][3] = 0.0f;
+    result.m[2][0] = (2.0f * (x * z + w * y)) * scale.z;
+    result.m[2][1] = (2.0f * (y * z - w * x)) * scale.z;
+    result.m[2][2] = (1.0f - 2.0f * (x * x + y * y)) * scale.z;
+    result.m[2][3] = 0.0f;
+    result.m[3][0] = translate.x;
+    result.m[3][1] = translate.y;
+    result.m[3][2] = translate.z;
+    result.m[3][3] = 1.0f;
+    return result;
+}
+
+void DecomposeTransformMatrix(const Matrix4x4& matrix, Vector3& scale, Quaternion& rotate, Vector3& translate) {
+    translate = {matrix.m[3][0], matrix.m[3][1], matrix.m[3][2]};
+
+    float rows[3][3];
+    float scales[3];
+    for (int i = 0; i < 3; ++i) {
+        scales[i] = std::sqrt(matrix.m[i][0] * matrix.m[i][0] + matrix.m[i][1] * matrix.m[i][1] +
+                              matrix.m[i][2] * matrix.m[i][2]);
+        const float inverse = scales[i] > 0.0f ? 1.0f / scales[i] : 0.0f;
+        for (int j = 0; j < 3; ++j) {
+            rows[i][j] = matrix.m[i][j] * inverse;
+        }
+    }
+    // 鏡映が含まれる場合は X のスケールを負にして、回転は右手系に保つ
+    const float determinant = rows[0][0] * (rows[1][1] * rows[2][2] - rows[1][2] * rows[2][1]) -
+                              rows[0][1] * (rows[1][0] * rows[2][2] - rows[1][2] * rows[2][0]) +
+                              rows[0][2] * (rows[1][0] * rows[2][1] - rows[1][1] * rows[2][0]);
+    if (determinant < 0.0f) {
+        scales[0] = -scales[0];
+        for (int j = 0; j < 3; ++j) {
+            rows[0][j] = -rows[0][j];
+        }
+    }
+    scale = {scales[0], scales[1], scales[2]};
+
+    // MakeTransformMatrix の回転部分の逆 (対角の最大成分から求めて桁落ちを避ける)
+    const float trace = rows[0][0] + rows[1][1] + rows[2][2];
+    if (trace > 0.0f) {
+        const float s = std::sqrt(trace + 1.0f) * 2.0f;
+        rotate = {(rows[1][2] - rows[2][1]) / s, (rows[2][0] - rows[0][2]) / s, (rows[0][1] - rows[1][0]) / s, 0.25f * s};
+    } else if (rows[0][0] > rows[1][1] && rows[0][0] > rows[2][2]) {
+        const float s = std::sqrt(1.0f + rows[0][0] - rows[1][1] - rows[2][2]) * 2.0f;
+        rotate = {0.25f * s, (rows[0][1] + rows[1][0]) / s, (rows[2][0] + rows[0][2]) / s, (rows[1][2] - rows[2][1]) / s};
+    } else if (rows[1][1] > rows[2][2]) {
+        const float s = std::sqrt(1.0f + rows[1][1] - rows[0][0] - rows[2][2]) * 2.0f;
+        rotate = {(rows[0][1] + rows[1][0]) / s, 0.25f * s, (rows[1][2] + rows[2][1]) / s, (rows[2][0] - rows[0][2]) / s};
+    } else {
+        const float s = std::sqrt(1.0f + rows[2][2] - rows[0][0] - rows[1][1]) * 2.0f;
+        rotate = {(rows[2][0] + rows[0][2]) / s, (rows[1][2] + rows[2][1]) / s, 0.25f * s, (rows[0][1] - rows[1][0]) / s};
+    }
+}
+
+void FillMissingKeys(NodeAnimation& track, const Matrix4x4& localMatrix) {
+    Vector3 scale;
+    Quaternion rotate;
+    Vector3 translate;
+    DecomposeTransformMatrix(localMatrix, scale, rotate, translate);
+    if (track.translate.empty()) {
+        track.translate.push_back({0.0f, translate});
+    }
+    if (track.rotate.empty()) {
+        track.rotate.push_back({0.0f, rotate});
+    }
+    if (track.scale.empty()) {
+        track.scale.push_back({0.0f, scale});
+    }
+}
+
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t) {
+    float dot = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
+    // 遠回りしないよう、逆向きなら片方を反転する (q と -q は同じ回転)
+    Quaternion end = q1;
+    if (dot < 0.0f) {
+        dot = -dot;
+        end = {-q1.x, -q1.y, -q1.z, -q1.w};
+    }
+
+    float scale0 = 1.0f - t;
+    float scale1 = t;
+    // ほぼ同じ向きなら線形補間で十分 (sin の割り算が不安定になるのを避ける)
+    if (dot < 0.9995f) {
+        const float theta = std::acos(dot);
+        const float inverseSin = 1.0f / std::sin(theta);
+        scale0 = std::sin((1.0f - t) * theta) * inverseSin;
+        scale1 = std::sin(t * theta) * inverseSin;
+    }
+    Quaternion result = {q0.x * scale0 + end.x * scale1, q0.y * scale0 + end.y * scale1, q0.z * scale0 + end.z * scale1,
+                         q0.w * scale0 + end.w * scale1};
+    const float length = std::sqrt(result.x * result.x + result.y * result.y + result.z * result.z + result.w * result.w);
+    return {result.x / length, result.y / length, result.z / length, result.w / length};
+}
+
+} // namespace Animation
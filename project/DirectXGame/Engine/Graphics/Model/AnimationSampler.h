@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ============================================================
+// AnimationSampler — アニメーションクリップから指定時刻の姿勢 (ノードのローカル行列) を求める
+//   ・トラックの要素ごとに前回のキー番号を覚えておき、順方向の再生では次のキーを見るだけで済む (O(1))
+//   ・時間が戻ったときや大きく飛んだときだけ二分探索する
+//   ・キー番号はインスタンスごとの状態なので、同じクリップを再生するオブジェクトごとに1つ持つ
+//   ・圧縮したクリップ (AnimationCompressor) は補間に使う2キーだけをその場で展開する
+// ============================================================
+class AnimationSampler {
+public:
+    /// <summary>
+    /// 再生するクリップを設定する (キー番号は先頭に戻る)
+    /// </summary>
+    /// <param name="clip">クリップ (サンプラーより長く生存すること)</param>
+    void Initialize(const AnimationClip* clip);
+    void Initialize(const CompressedAnimationClip* clip);
+
+    // クリップの設定を解除する
+    void Clear();
+
+    /// <summary>
+    /// 指定時刻の姿勢をローカル行列に書き込む (トラックの無いノードは書き換えない)
+    /// </summary>
+    /// <param name="time">時刻 (秒。0 ～ duration に収めておくこと)</param>
+    /// <param name="localMatrices">ノードごとのローカル行列 (NodeHierarchy と同じ並び)</param>
+    void Sample(float time, std::span<Matrix4x4> localMatrices);
+
+    // クリップが設定されているか
+    bool HasClip() const { return clip_ || compressedClip_; }
+    // クリップの長さ (秒)
+    float GetDuration() const;
+
+private:
+    // 圧縮したクリップの姿勢を求める
+    void SampleCompressed(float time, std::span<Matrix4x4> localMatrices);
+
+    const AnimationClip* clip_ = nullptr;
+    const CompressedAnimationClip* compressedClip_ = nullptr;
+    // トラックごとの前回のキー番号 (translate, rotate, scale の順に3つずつ)
+    std::vector<uint32_t> cursors_;
+};
+
+namespace Animation {
+
+// スケール・回転・平行移動から行列を作る (行ベクトル規約: v * S * R * T)
+Matrix4x4 MakeTransformMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate);
+
+// 行列をスケール・回転・平行移動に分ける (せん断の無い行列であること)
+void DecomposeTransformMatrix(const Matrix4x4& matrix, Vector3& scale, Quaternion& rotate, Vector3& translate);
+
+// キーの無い要素にローカル行列の値のキーを1つ補う (サンプラーで分岐しないため)
+void FillMissingKeys(NodeAnimation& track, const Matrix4x4& localMatrix);
+
+// 球面線形補間 (最短の向きで補間する)
+Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+} // namespace Animation
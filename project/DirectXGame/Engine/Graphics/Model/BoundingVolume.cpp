@@ -0,0 +1,232 @@
+#include "BoundingVolume.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+Vector3 GetPosition(const VertexData& vertex) { return {vertex.position.x, vertex.position.y, vertex.position.z}; }
+
+float DistanceSq(const Vector3& a, const Vector3& b) {
+    const float x = a.x - b.x, y = a.y - b.y, z = a.z - b.z;
+    return x * x + y * y + z * z;
+}
+
+void Expand(AABB& aabb, const Vector3& position) {
+    aabb.min = {std::min(aabb.min.x, position.x), std::min(aabb.min.y, position.y), std::min(aabb.min.z, position.z)};
+    aabb.max = {std::max(aabb.max.x, position.x), std::max(aabb.max.y, position.y), std::max(aabb.max.z, position.z)};
+}
+
+// 範囲に含める頂点を順に渡す (indices が空なら全頂点)
+template <class Function>
+void ForEachPosition(std::span<const VertexData> vertices, std::span<const uint32_t> indices, Function function) {
+    if (indices.empty()) {
+        for (const VertexData& vertex : vertices) {
+            function(GetPosition(vertex));
+        }
+    } else {
+        for (uint32_t index : indices) {
+            function(GetPosition(vertices[index]));
+        }
+    }
+}
+
+// Ritter 法: 最も離れていそうな2点を直径とする球から始め、外にある頂点を含むように広げる
+Sphere ComputeRitterSphere(std::span<const VertexData> vertices, std::span<const uint32_t> indices,
+                           const Vector3& start) {
+    Vector3 farthest = start;
+    float farthestSq = -1.0f;
+    ForEachPosition(vertices, indices, [&](const Vector3& position) {
+        const float distanceSq = DistanceSq(position, start);
+        if (distanceSq > farthestSq) {
+            farthestSq = distanceSq;
+            farthest = position;
+        }
+    });
+    Vector3 opposite = farthest;
+    farthestSq = -1.0f;
+    ForEachPosition(vertices, indices, [&](const Vector3& position) {
+        const float distanceSq = DistanceSq(position, farthest);
+        if (distanceSq > farthestSq) {
+            farthestSq = distanceSq;
+            opposite = position;
+        }
+    });
+
+    Sphere sphere = {{(farthest.x + opposite.x) * 0.5f, (farthest.y + opposite.y) * 0.5f, (farthest.z + opposite.z) * 0.5f},
+                     std::sqrt(farthestSq) * 0.5f};
+    ForEachPosition(vertices, indices, [&](const Vector3& position) {
+        const float distanceSq = DistanceSq(position, sphere.center);
+        if (distanceSq <= sphere.radius * sphere.radius) {
+            return;
+        }
+        // 反対側の端を動かさずに、頂点に届くまで広げる
+        const float distance = std::sqrt(distanceSq);
+        const float radius = (sphere.radius + distance) * 0.5f;
+        const float t = (radius - sphere.radius) / distance;
+        sphere.center = {sphere.center.x + (position.x - sphere.center.x) * t,
+                         sphere.center.y + (position.y - sphere.center.y) * t,
+                         sphere.center.z + (position.z - sphere.center.z) * t};
+        sphere.radius = radius;
+    });
+    return sphere;
+}
+
+// center から最も遠い頂点までの距離 (丸め誤差で頂点が球からはみ出さないよう、半径はこれ以上にする)
+float ComputeMaxDistance(std::span<const VertexData> vertices, std::span<const uint32_t> indices,
+                         const Vector3& center) {
+    float radiusSq = 0.0f;
+    ForEachPosition(vertices, indices,
+                    [&](const Vector3& position) { radiusSq = std::max(radiusSq, DistanceSq(position, center)); });
+    return std::sqrt(radiusSq);
+}
+
+} // namespace
+
+namespace BoundingVolume {
+
+Bounds Compute(std::span<const VertexData> vertices, std::span<const uint32_t> indices) {
+    Bounds bounds;
+    if (vertices.empty()) {
+        return bounds;
+    }
+    bounds.aabb = MakeEmptyAABB();
+    ForEachPosition(vertices, indices, [&](const Vector3& position) { Expand(bounds.aabb, position); });
+    if (IsEmpty(bounds.aabb)) {
+        return {};
+    }
+
+    // Ritter 法の球と AABB の中心からの球の小さい方
+    const Sphere aabbSphere = {ComputeSphere(bounds.aabb).center, 0.0f};
+    const Sphere candidates[2] = {
+        ComputeRitterSphere(vertices, indices, aabbSphere.center),
+        aabbSphere,
+    };
+    bounds.sphere.radius = std::numeric_limits<float>::infinity();
+    for (const Sphere& candidate : candidates) {
+        const float radius = std::max(candidate.radius, ComputeMaxDistance(vertices, indices, candidate.center));
+        if (radius < bounds.sphere.radius) {
+            bounds.sphere = {candidate.center, radius};
+        }
+    }
+    return bounds;
+}
+
+void ComputeModelBounds(ModelData& modelData) {
+    modelData.bounds = Compute(modelData.vertices);
+    for (SubMesh& subMesh : modelData.subMeshes) {
+        if (subMesh.indexCount == 0) {
+            subMesh.bounds = {};
+            continue;
+        }
+        subMesh.bounds = Compute(modelData.vertices, std::span<const uint32_t>(modelData.indices).subspan(
+                                                         subMesh.indexOffset, subMesh.indexCount));
+    }
+
+    // ジョイントごとに、重みを持つ頂点の範囲 (姿勢を変えたときはパレットで変換して合わせる)
+    for (Joint& joint : modelData.joints) {
+        joint.bounds = MakeEmptyAABB();
+    }
+    for (size_t v = 0; v < modelData.influences.size(); ++v) {
+        const VertexInfluence& influence = modelData.influences[v];
+        for (int k = 0; k < 4; ++k) {
+            if (influence.weights[k] > 0.0f) {
+                Expand(modelData.joints[influence.jointIndices[k]].bounds, GetPosition(modelData.vertices[v]));
+            }
+        }
+    }
+}
+
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& matrix) {
+    // 各軸の寄与の小さい方と大きい方を足す (8頂点を変換するのと同じ結果)
+    const float minimum[3] = {aabb.min.x, aabb.min.y, aabb.min.z};
+    const float maximum[3] = {aabb.max.x, aabb.max.y, aabb.max.z};
+    float resultMin[3] = {matrix.m[3][0], matrix.m[3][1], matrix.m[3][2]};
+    float resultMax[3] = {matrix.m[3][0], matrix.m[3][1], matrix.m[3][2]};
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            const float a = matrix.m[i][j] * minimum[i];
+            const float b = matrix.m[i][j] * maximum[i];
+            resultMin[j] += std::min(a, b);
+            resultMax[j] += std::max(a, b);
+        }
+    }
+    return {{resultMin[0], resultMin[1], resultMin[2]}, {resultMax[0], resultMax[1], resultMax[2]}};
+}
+
+// 最大特異値 = M M^T の最大固有値の平方根
+// 行の長さの最大値はせん断があると小さく見積もるので、対称行列の固有値を解析的に求める
+float ComputeMaxScale(const Matrix4x4& matrix) {
+    double a[3][3];
+    double frobeniusSq = 0.0;
+    double maxRowSq = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            a[i][j] = 0.0;
+            for (int k = 0; k < 3; ++k) {
+                a[i][j] += static_cast<double>(matrix.m[i][k]) * matrix.m[j][k];
+            }
+        }
+        frobeniusSq += a[i][i];
+        maxRowSq = std::max(maxRowSq, a[i][i]);
+    }
+
+    double maxEigenvalue = 0.0;
+    const double p1 = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+    if (p1 == 0.0) {
+        // 行が直交している (回転と軸ごとの拡大だけ)
+        maxEigenvalue = std::max({a[0][0], a[1][1], a[2][2]});
+    } else {
+        const double q = (a[0][0] + a[1][1] + a[2][2]) / 3.0;
+        const double p2 = (a[0][0] - q) * (a[0][0] - q) + (a[1][1] - q) * (a[1][1] - q) + (a[2][2] - q) * (a[2][2] - q) +
+                          2.0 * p1;
+        const double p = std::sqrt(p2 / 6.0);
+        double b[3][3];
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                b[i][j] = (a[i][j] - (i == j ? q : 0.0)) / p;
+            }
+        }
+        const double r = 0.5 * (b[0][0] * (b[1][1] * b[2][2] - b[1][2] * b[2][1]) -
+                                b[0][1] * (b[1][0] * b[2][2] - b[1][2] * b[2][0]) +
+                                b[0][2] * (b[1][0] * b[2][1] - b[1][1] * b[2][0]));
+        const double phi = r <= -1.0 ? std::acos(-1.0) / 3.0 : (r >= 1.0 ? 0.0 : std::acos(r) / 3.0);
+        maxEigenvalue = q + 2.0 * p * std::cos(phi);
+    }
+
+    // 丸め誤差で小さくならないよう少し広げる。行の長さ (下限) とフロベニウスノルム (上限) の間に収める
+    const double scaleSq = std::clamp(maxEigenvalue * (1.0 + 1e-6), maxRowSq, frobeniusSq);
+    return static_cast<float>(std::sqrt(scaleSq));
+}
+
+Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& matrix) {
+    const Vector3& c = sphere.center;
+    const Vector3 center = {c.x * matrix.m[0][0] + c.y * matrix.m[1][0] + c.z * matrix.m[2][0] + matrix.m[3][0],
+                            c.x * matrix.m[0][1] + c.y * matrix.m[1][1] + c.z * matrix.m[2][1] + matrix.m[3][1],
+                            c.x * matrix.m[0][2] + c.y * matrix.m[1][2] + c.z * matrix.m[2][2] + matrix.m[3][2]};
+    return {center, sphere.radius * ComputeMaxScale(matrix)};
+}
+
+Sphere ComputeSphere(const AABB& aabb) {
+    const Vector3 center = {(aabb.min.x + aabb.max.x) * 0.5f, (aabb.min.y + aabb.max.y) * 0.5f,
+                            (aabb.min.z + aabb.max.z) * 0.5f};
+    return {center, std::sqrt(DistanceSq(aabb.max, center))};
+}
+
+AABB MakeEmptyAABB() {
+    const float infinity = std::numeric_limits<float>::infinity();
+    return {{infinity, infinity, infinity}, {-infinity, -infinity, -infinity}};
+}
+
+bool IsEmpty(const AABB& aabb) { return aabb.min.x > aabb.max.x || aabb.min.y > aabb.max.y || aabb.min.z > aabb.max.z; }
+
+void Merge(AABB& aabb, const AABB& other) {
+    if (IsEmpty(other)) {
+        return;
+    }
+    Expand(aabb, other.min);
+    Expand(aabb, other.max);
+}
+
+} // namespace BoundingVolume
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <cstdint>
+#include <span>
+
+// ============================================================
+// BoundingVolume — 頂点を囲む AABB と球を求める (D3D12 を使わないのでワーカースレッドから呼べる)
+//   ・球は Ritter 法と AABB の中心からの球のうち小さい方 (最後に全頂点で半径を確かめるので必ず全頂点を含む)
+//   ・モデル全体・サブメッシュ・スキンのジョイントごとの範囲は読み込み時に1回だけ求め、CookedMesh に保存する
+//   ・ワールド空間の範囲は行列で変換して求める (AABB は変換後の AABB、球は最大の拡大率で半径を広げる)
+// ============================================================
+namespace BoundingVolume {
+
+/// <summary>
+/// 頂点の範囲を求める
+/// </summary>
+/// <param name="vertices">頂点</param>
+/// <param name="indices">範囲に含める頂点の番号 (空なら全頂点)</param>
+/// <returns>範囲 (頂点が無ければ大きさ0)</returns>
+Bounds Compute(std::span<const VertexData> vertices, std::span<const uint32_t> indices = {});
+
+// モデル全体・サブメッシュ・ジョイントの範囲を求めて modelData に書き込む
+void ComputeModelBounds(ModelData& modelData);
+
+// 行列で変換した AABB を囲む AABB (行ベクトル規約)
+AABB TransformAABB(const AABB& aabb, const Matrix4x4& matrix);
+
+// 行列 (左上3x3) が長さを何倍まで伸ばすか (どの向きの長さもこの倍率以下になる)
+float ComputeMaxScale(const Matrix4x4& matrix);
+
+// 行列で変換した球を囲む球 (半径は最大の拡大率で広げる。せん断を含む行列でも球を囲む)
+Sphere TransformSphere(const Sphere& sphere, const Matrix4x4& matrix);
+
+// AABB を囲む球
+Sphere ComputeSphere(const AABB& aabb);
+
+// 空の AABB (Merge で最初の範囲がそのまま入る)
+AABB MakeEmptyAABB();
+
+// min > max の AABB (含む頂点が無い)
+bool IsEmpty(const AABB& aabb);
+
+// aabb を other まで広げる
+void Merge(AABB& aabb, const AABB& other);
+
+} // namespace BoundingVolume
@@ -0,0 +1,95 @@
+#include "ClusterCuller.h"
+
+#include <cmath>
+
+namespace {
+
+float Dot(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+// 平面の法線を単位ベクトルにする (距離の比較に半径をそのまま使えるようにする)
+Vector4 NormalizePlane(const Vector4& plane) {
+    const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+    if (length == 0.0f) {
+        return plane;
+    }
+    return {plane.x / length, plane.y / length, plane.z / length, plane.w / length};
+}
+
+// 包む球が視錐台のどれかの平面の完全に外側にあるか
+bool IsOutsideFrustum(const ClusterCuller::Frustum& frustum, const Vector3& center, float radius) {
+    for (const Vector4& plane : frustum.planes) {
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 法線の円錐がカメラから見てすべて裏を向いているか
+// 球のどの点から見ても、視線と円錐のどの法線とのなす角も 90° 未満になる条件
+bool IsBackfacing(const Meshlet& meshlet, const Vector3& cameraPosition) {
+    if (meshlet.coneCutoff >= 1.0f) {
+        return false;
+    }
+    const Vector3 toCenter = {meshlet.center.x - cameraPosition.x, meshlet.center.y - cameraPosition.y,
+                              meshlet.center.z - cameraPosition.z};
+    const float distance = std::sqrt(Dot(toCenter, toCenter));
+    return Dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * distance + meshlet.radius;
+}
+
+} // namespace
+
+namespace ClusterCuller {
+
+Frustum ExtractFrustum(const Matrix4x4& worldViewProjection) {
+    // 行ベクトル規約 (clip = p * M) なので、行列の列が clip の各成分になる
+    const Matrix4x4& m = worldViewProjection;
+    auto column = [&m](int j) { return Vector4{m.m[0][j], m.m[1][j], m.m[2][j], m.m[3][j]}; };
+    const Vector4 x = column(0);
+    const Vector4 y = column(1);
+    const Vector4 z = column(2);
+    const Vector4 w = column(3);
+
+    Frustum frustum;
+    frustum.planes[0] = NormalizePlane({w.x + x.x, w.y + x.y, w.z + x.z, w.w + x.w}); // 左   (-w <= x)
+    frustum.planes[1] = NormalizePlane({w.x - x.x, w.y - x.y, w.z - x.z, w.w - x.w}); // 右   (x <= w)
+    frustum.planes[2] = NormalizePlane({w.x + y.x, w.y + y.y, w.z + y.z, w.w + y.w}); // 下   (-w <= y)
+    frustum.planes[3] = NormalizePlane({w.x - y.x, w.y - y.y, w.z - y.z, w.w - y.w}); // 上   (y <= w)
+    frustum.planes[4] = NormalizePlane(z);                                            // 手前 (0 <= z)
+    frustum.planes[5] = NormalizePlane({w.x - z.x, w.y - z.y, w.z - z.z, w.w - z.w}); // 奥   (z <= w)
+    return frustum;
+}
+
+CullStats Cull(const MeshletData& meshletData, const Frustum& frustum, const Vector3& cameraPosition,
+               bool cullBackfaces, std::vector<uint32_t>& indices, std::vector<uint32_t>& groupIndexOffsets) {
+    CullStats stats;
+    indices.clear();
+    groupIndexOffsets.clear();
+    for (size_t group = 0; group + 1 < meshletData.groupOffsets.size(); ++group) {
+        groupIndexOffsets.push_back(static_cast<uint32_t>(indices.size()));
+        for (uint32_t m = meshletData.groupOffsets[group]; m < meshletData.groupOffsets[group + 1]; ++m) {
+            const Meshlet& meshlet = meshletData.meshlets[m];
+            if (IsOutsideFrustum(frustum, meshlet.center, meshlet.radius)) {
+                ++stats.frustumCulledMeshlets;
+                continue;
+            }
+            if (cullBackfaces && IsBackfacing(meshlet, cameraPosition)) {
+                ++stats.backfaceCulledMeshlets;
+                continue;
+            }
+
+            // メッシュレット内の頂点番号を元の頂点番号に戻して詰める
+            ++stats.visibleMeshlets;
+            stats.visibleTriangles += meshlet.triangleCount;
+            const uint32_t* meshletVertices = &meshletData.vertices[meshlet.vertexOffset];
+            const uint8_t* triangles = &meshletData.triangles[meshlet.triangleOffset];
+            for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i) {
+                indices.push_back(meshletVertices[triangles[i]]);
+            }
+        }
+    }
+    groupIndexOffsets.push_back(static_cast<uint32_t>(indices.size()));
+    return stats;
+}
+
+} // namespace ClusterCuller
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "MeshletBuilder.h"
+
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// ClusterCuller — メッシュレット単位のCPUカリング
+//   ・視錐台: メッシュレットを包む球が視錐台の外にあれば捨てる
+//   ・裏面  : 法線の円錐がカメラから見てすべて裏を向いていれば捨てる
+// 残ったメッシュレットの三角形を、元の頂点番号のインデックスリストに詰めて出力する
+// 判定はすべてモデル空間で行う (平面と点の内外はアフィン変換で変わらない)
+// ============================================================
+namespace ClusterCuller {
+
+// 視錐台の6平面 (dot(normal, p) + distance >= 0 が内側。normal は単位ベクトル)
+struct Frustum {
+    Vector4 planes[6];
+};
+
+// カリングの結果
+struct CullStats {
+    uint32_t visibleMeshlets = 0;
+    uint32_t frustumCulledMeshlets = 0;
+    uint32_t backfaceCulledMeshlets = 0;
+    uint32_t visibleTriangles = 0;
+};
+
+/// <summary>
+/// ワールドビュー射影行列からモデル空間の視錐台を取り出す (D3D の深度範囲 0～1)
+/// </summary>
+Frustum ExtractFrustum(const Matrix4x4& worldViewProjection);
+
+/// <summary>
+/// 見えるメッシュレットの三角形をインデックスリストに詰める
+/// </summary>
+/// <param name="meshletData">メッシュレット</param>
+/// <param name="frustum">モデル空間の視錐台</param>
+/// <param name="cameraPosition">モデル空間のカメラ位置</param>
+/// <param name="cullBackfaces">true = 裏面カリングも行う (ラスタライザで裏面を捨てている場合のみ)</param>
+/// <param name="indices">出力先 (元の頂点番号。中身は置き換える)</param>
+/// <param name="groupIndexOffsets">グループ (サブメッシュ) ごとの indices 内の開始位置の出力先 (最後に総数)</param>
+/// <returns>カリングの結果</returns>
+CullStats Cull(const MeshletData& meshletData, const Frustum& frustum, const Vector3& cameraPosition,
+               bool cullBackfaces, std::vector<uint32_t>& indices, std::vector<uint32_t>& groupIndexOffsets);
+
+} // namespace ClusterCuller
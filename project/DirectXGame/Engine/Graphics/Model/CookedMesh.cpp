@@ -0,0 +1,383 @@
+#include "CookedMesh.h"
+#include "Hash/HashUtility.h"
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace HashUtility;
+
+namespace {
+
+// "CMSH"
+constexpr uint32_t kMagic = 0x48534D43;
+
+// キャッシュの置き場所 (実行時のカレントディレクトリから)
+const char* const kCacheDirectory = "Resources/Cache/Models";
+
+// 各ブロックの境界
+constexpr uint64_t kBlockAlignment = 16;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t vertexStride; // sizeof(VertexData) (頂点レイアウトの変更を検出する)
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t nodeCount;
+    uint32_t nodeNameCount;
+    uint32_t lodCount;
+    uint32_t subMeshCount;
+    uint32_t materialCount;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+    uint64_t lodOffset;
+    uint64_t subMeshOffset;
+    uint64_t materialOffset;
+    uint64_t nodeOffset;
+    uint64_t nodeNameOffset;
+    uint64_t stringOffset;
+    uint64_t stringSize;
+    uint32_t texturePathOffset; // 文字列テーブル内のオフセット
+    uint32_t texturePathLength;
+    Bounds bounds; // 全頂点の範囲
+};
+
+struct LodRecord {
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    float error;
+    uint32_t subMeshOffset;
+    uint32_t subMeshCount;
+    uint32_t reserved[3];
+};
+
+struct SubMeshRecord {
+    uint32_t materialIndex;
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    uint32_t reserved;
+    Bounds bounds;
+};
+
+struct MaterialRecord {
+    uint32_t texturePathOffset; // 文字列テーブル内のオフセット
+    uint32_t texturePathLength;
+};
+
+struct NodeRecord {
+    Matrix4x4 localMatrix;
+    int32_t parent;  // 親のノード番号 (-1 = 親なし)
+    uint32_t nameId; // NodeNameRecord の番号
+    uint32_t reserved[2];
+};
+
+struct NodeNameRecord {
+    uint32_t nameOffset; // 文字列テーブル内のオフセット
+    uint32_t nameLength;
+};
+
+uint64_t AlignUp(uint64_t value) { return (value + kBlockAlignment - 1) & ~(kBlockAlignment - 1); }
+
+// 文字列テーブルに追加し、オフセットを返す
+uint32_t AppendString(std::vector<char>& table, const std::string& str) {
+    const uint32_t offset = static_cast<uint32_t>(table.size());
+    table.insert(table.end(), str.begin(), str.end());
+    return offset;
+}
+
+// ノード階層を書き出し用に変換する (配列の並びはそのまま)
+void WriteNodes(const NodeHierarchy& hierarchy, std::vector<NodeRecord>& nodes, std::vector<NodeNameRecord>& names,
+                std::vector<char>& strings) {
+    for (uint32_t i = 0; i < hierarchy.GetNodeCount(); ++i) {
+        nodes.push_back({hierarchy.localMatrices[i], hierarchy.parents[i], hierarchy.nameIds[i], {}});
+    }
+    for (const std::string& name : hierarchy.names) {
+        names.push_back({AppendString(strings, name), static_cast<uint32_t>(name.size())});
+    }
+}
+
+// ノード階層を読み込む (親が前にない・名前が範囲外など、壊れたデータでは false)
+bool ReadNodes(std::span<const NodeRecord> nodes, std::span<const NodeNameRecord> names, std::span<const char> strings,
+               NodeHierarchy& hierarchy) {
+    hierarchy = {};
+    for (const NodeNameRecord& name : names) {
+        if (uint64_t{name.nameOffset} + name.nameLength > strings.size()) {
+            return false;
+        }
+        hierarchy.names.emplace_back(strings.data() + name.nameOffset, name.nameLength);
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const NodeRecord& node = nodes[i];
+        if (node.parent < -1 || node.parent >= static_cast<int32_t>(i) || node.nameId >= names.size()) {
+            return false;
+        }
+        hierarchy.localMatrices.push_back(node.localMatrix);
+        hierarchy.parents.push_back(node.parent);
+        hierarchy.nameIds.push_back(node.nameId);
+    }
+    return true;
+}
+
+// 範囲が有限で、min <= max かつ半径が負でないか
+bool IsValidBounds(const Bounds& bounds) {
+    const float values[] = {bounds.aabb.min.x, bounds.aabb.min.y, bounds.aabb.min.z, bounds.aabb.max.x,
+                            bounds.aabb.max.y, bounds.aabb.max.z, bounds.sphere.center.x, bounds.sphere.center.y,
+                            bounds.sphere.center.z, bounds.sphere.radius};
+    for (float value : values) {
+        if (!std::isfinite(value)) {
+            return false;
+        }
+    }
+    return bounds.aabb.min.x <= bounds.aabb.max.x && bounds.aabb.min.y <= bounds.aabb.max.y &&
+           bounds.aabb.min.z <= bounds.aabb.max.z && bounds.sphere.radius >= 0.0f;
+}
+
+// OBJ が mtllib で参照する MTL の内容をハッシュに加える
+// (MTL だけを書き換えた場合もキーが変わり、テクスチャの変更がキャッシュに反映される)
+uint64_t HashMaterialLibraries(const std::string& sourcePath, std::span<const uint8_t> source, uint64_t hash) {
+    const std::filesystem::path path(sourcePath);
+    if (path.extension() != ".obj") {
+        return hash;
+    }
+    const std::string_view text(reinterpret_cast<const char*>(source.data()), source.size());
+    size_t lineBegin = 0;
+    while (lineBegin < text.size()) {
+        size_t lineEnd = text.find('\n', lineBegin);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        std::string_view line = text.substr(lineBegin, lineEnd - lineBegin);
+        lineBegin = lineEnd + 1;
+
+        const size_t first = line.find_first_not_of(" \t");
+        if (first == std::string_view::npos || line.substr(first, 6) != "mtllib" || line.size() <= first + 6 ||
+            (line[first + 6] != ' ' && line[first + 6] != '\t')) {
+            continue;
+        }
+        line = line.substr(first + 6);
+        const size_t nameBegin = line.find_first_not_of(" \t");
+        const size_t nameEnd = line.find_last_not_of(" \t\r");
+        if (nameBegin == std::string_view::npos) {
+            continue;
+        }
+        const std::string_view name = line.substr(nameBegin, nameEnd - nameBegin + 1);
+        hash = HashBytes(name.data(), name.size(), hash);
+
+        // 見つからない MTL は名前だけをハッシュする
+        MappedFile library;
+        if (library.Open((path.parent_path() / std::filesystem::path(name)).string())) {
+            hash = HashBytes(library.GetData(), library.GetSize(), hash);
+        }
+    }
+    return hash;
+}
+
+} // namespace
+
+namespace CookedMesh {
+
+uint64_t ComputeKey(const std::string& sourcePath, uint32_t importFlags) {
+    // 元ファイルはコピーせずにマップしてハッシュする
+    MappedFile source;
+    if (!source.Open(sourcePath)) {
+        return 0;
+    }
+
+    uint64_t hash = HashValue(kVersion);
+    hash = HashValue(importFlags, hash);
+    hash = HashValue(static_cast<uint32_t>(sizeof(VertexData)), hash);
+    hash = HashBytes(sourcePath.data(), sourcePath.size(), hash);
+    hash = HashBytes(source.GetData(), source.GetSize(), hash);
+    hash = HashMaterialLibraries(sourcePath, source.GetBytes(), hash);
+    return hash != 0 ? hash : 1; // 0 は「キーなし」として予約
+}
+
+std::string GetCachePath(uint64_t key) { return std::format("{}/{:016x}.mesh", kCacheDirectory, key); }
+
+bool Save(const std::string& cachePath, uint64_t key, const ModelData& modelData) {
+    std::vector<NodeRecord> nodes;
+    std::vector<NodeNameRecord> nodeNames;
+    std::vector<char> strings;
+    WriteNodes(modelData.nodes, nodes, nodeNames, strings);
+    const uint32_t texturePathOffset = AppendString(strings, modelData.material.textureFilePath);
+    std::vector<LodRecord> lods;
+    for (const MeshLod& lod : modelData.lods) {
+        lods.push_back({lod.indexOffset, lod.indexCount, lod.error, lod.subMeshOffset, lod.subMeshCount, {}});
+    }
+    std::vector<SubMeshRecord> subMeshes;
+    for (const SubMesh& subMesh : modelData.subMeshes) {
+        subMeshes.push_back({subMesh.materialIndex, subMesh.indexOffset, subMesh.indexCount, 0, subMesh.bounds});
+    }
+    std::vector<MaterialRecord> materials;
+    for (const MaterialData& material : modelData.materials) {
+        materials.push_back({AppendString(strings, material.textureFilePath),
+                             static_cast<uint32_t>(material.textureFilePath.size())});
+    }
+
+    FileHeader header{};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.key = key;
+    header.vertexStride = sizeof(VertexData);
+    header.vertexCount = static_cast<uint32_t>(modelData.vertices.size());
+    header.indexCount = static_cast<uint32_t>(modelData.indices.size());
+    header.nodeCount = static_cast<uint32_t>(nodes.size());
+    header.nodeNameCount = static_cast<uint32_t>(nodeNames.size());
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    header.subMeshCount = static_cast<uint32_t>(subMeshes.size());
+    header.materialCount = static_cast<uint32_t>(materials.size());
+    header.vertexOffset = AlignUp(sizeof(FileHeader));
+    header.indexOffset = AlignUp(header.vertexOffset + sizeof(VertexData) * modelData.vertices.size());
+    header.lodOffset = AlignUp(header.indexOffset + sizeof(uint32_t) * modelData.indices.size());
+    header.subMeshOffset = AlignUp(header.lodOffset + sizeof(LodRecord) * lods.size());
+    header.materialOffset = AlignUp(header.subMeshOffset + sizeof(SubMeshRecord) * subMeshes.size());
+    header.nodeOffset = AlignUp(header.materialOffset + sizeof(MaterialRecord) * materials.size());
+    header.nodeNameOffset = AlignUp(header.nodeOffset + sizeof(NodeRecord) * nodes.size());
+    header.stringOffset = AlignUp(header.nodeNameOffset + sizeof(NodeNameRecord) * nodeNames.size());
+    header.stringSize = strings.size();
+    header.texturePathOffset = texturePathOffset;
+    header.texturePathLength = static_cast<uint32_t>(modelData.material.textureFilePath.size());
+    header.bounds = modelData.bounds;
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+
+    // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+    // (同じモデルを複数のスレッドが同時に書き出しても互いの一時ファイルを壊さないよう、名前にスレッドを含める)
+    const std::string tempPath =
+        std::format("{}.{:x}.tmp", cachePath, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        auto writeBlock = [&file](uint64_t offset, const void* data, size_t size) {
+            static const char kZeros[kBlockAlignment] = {};
+            const uint64_t position = static_cast<uint64_t>(file.tellp());
+            file.write(kZeros, static_cast<std::streamsize>(offset - position));
+            file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        };
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeBlock(header.vertexOffset, modelData.vertices.data(), sizeof(VertexData) * modelData.vertices.size());
+        writeBlock(header.indexOffset, modelData.indices.data(), sizeof(uint32_t) * modelData.indices.size());
+        writeBlock(header.lodOffset, lods.data(), sizeof(LodRecord) * lods.size());
+        writeBlock(header.subMeshOffset, subMeshes.data(), sizeof(SubMeshRecord) * subMeshes.size());
+        writeBlock(header.materialOffset, materials.data(), sizeof(MaterialRecord) * materials.size());
+        writeBlock(header.nodeOffset, nodes.data(), sizeof(NodeRecord) * nodes.size());
+        writeBlock(header.nodeNameOffset, nodeNames.data(), sizeof(NodeNameRecord) * nodeNames.size());
+        writeBlock(header.stringOffset, strings.data(), strings.size());
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool Load(const std::string& cachePath, uint64_t key, CookedModel& cooked) {
+    MappedFile file;
+    if (!file.Open(cachePath) || file.GetSize() < sizeof(FileHeader)) {
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, file.GetData(), sizeof(header));
+    if (header.magic != kMagic || header.version != kVersion || header.key != key || header.vertexStride != sizeof(VertexData)) {
+        return false;
+    }
+
+    // 各ブロックがファイル内に収まっているか確認する
+    const uint64_t fileSize = file.GetSize();
+    auto isInside = [fileSize](uint64_t offset, uint64_t size) {
+        return offset % kBlockAlignment == 0 && offset <= fileSize && size <= fileSize - offset;
+    };
+    if (!isInside(header.vertexOffset, sizeof(VertexData) * uint64_t{header.vertexCount}) ||
+        !isInside(header.indexOffset, sizeof(uint32_t) * uint64_t{header.indexCount}) ||
+        !isInside(header.lodOffset, sizeof(LodRecord) * uint64_t{header.lodCount}) ||
+        !isInside(header.subMeshOffset, sizeof(SubMeshRecord) * uint64_t{header.subMeshCount}) ||
+        !isInside(header.materialOffset, sizeof(MaterialRecord) * uint64_t{header.materialCount}) ||
+        !isInside(header.nodeOffset, sizeof(NodeRecord) * uint64_t{header.nodeCount}) ||
+        !isInside(header.nodeNameOffset, sizeof(NodeNameRecord) * uint64_t{header.nodeNameCount}) ||
+        !isInside(header.stringOffset, header.stringSize) ||
+        uint64_t{header.texturePathOffset} + header.texturePathLength > header.stringSize) {
+        return false;
+    }
+
+    const uint8_t* base = file.GetData();
+    std::span<const LodRecord> lods(reinterpret_cast<const LodRecord*>(base + header.lodOffset), header.lodCount);
+    std::span<const SubMeshRecord> subMeshes(reinterpret_cast<const SubMeshRecord*>(base + header.subMeshOffset),
+                                             header.subMeshCount);
+    std::span<const MaterialRecord> materials(reinterpret_cast<const MaterialRecord*>(base + header.materialOffset),
+                                              header.materialCount);
+    std::span<const NodeRecord> nodes(reinterpret_cast<const NodeRecord*>(base + header.nodeOffset), header.nodeCount);
+    std::span<const NodeNameRecord> nodeNames(reinterpret_cast<const NodeNameRecord*>(base + header.nodeNameOffset),
+                                              header.nodeNameCount);
+    std::span<const char> strings(reinterpret_cast<const char*>(base + header.stringOffset), header.stringSize);
+
+    if (!ReadNodes(nodes, nodeNames, strings, cooked.nodes)) {
+        return false;
+    }
+    cooked.materials.clear();
+    for (const MaterialRecord& material : materials) {
+        if (uint64_t{material.texturePathOffset} + material.texturePathLength > header.stringSize) {
+            return false;
+        }
+        cooked.materials.push_back({std::string(strings.data() + material.texturePathOffset, material.texturePathLength), 0});
+    }
+    cooked.subMeshes.clear();
+    for (const SubMeshRecord& subMesh : subMeshes) {
+        if (subMesh.indexCount % 3 != 0 || subMesh.materialIndex >= header.materialCount ||
+            uint64_t{subMesh.indexOffset} + subMesh.indexCount > header.indexCount || !IsValidBounds(subMesh.bounds)) {
+            return false;
+        }
+        cooked.subMeshes.push_back({subMesh.materialIndex, subMesh.indexOffset, subMesh.indexCount, subMesh.bounds});
+    }
+    cooked.lods.clear();
+    for (const LodRecord& lod : lods) {
+        if (lod.indexCount % 3 != 0 || uint64_t{lod.indexOffset} + lod.indexCount > header.indexCount ||
+            uint64_t{lod.subMeshOffset} + lod.subMeshCount > header.subMeshCount) {
+            return false;
+        }
+        // サブメッシュは LOD の範囲に収まっていること
+        for (uint32_t i = 0; i < lod.subMeshCount; ++i) {
+            const SubMeshRecord& subMesh = subMeshes[lod.subMeshOffset + i];
+            if (subMesh.indexOffset < lod.indexOffset ||
+                uint64_t{subMesh.indexOffset} + subMesh.indexCount > uint64_t{lod.indexOffset} + lod.indexCount) {
+                return false;
+            }
+        }
+        cooked.lods.push_back({lod.indexOffset, lod.indexCount, lod.error, lod.subMeshOffset, lod.subMeshCount});
+    }
+    cooked.material.textureFilePath.assign(strings.data() + header.texturePathOffset, header.texturePathLength);
+    if (!IsValidBounds(header.bounds)) {
+        return false;
+    }
+    cooked.bounds = header.bounds;
+
+    // 範囲外の頂点を指すインデックスは GPU の読み出しを壊すので、ファイルごと弾いて作り直させる
+    const uint32_t* indices = reinterpret_cast<const uint32_t*>(base + header.indexOffset);
+    for (uint32_t i = 0; i < header.indexCount; ++i) {
+        if (indices[i] >= header.vertexCount) {
+            return false;
+        }
+    }
+    cooked.vertices = {reinterpret_cast<const VertexData*>(base + header.vertexOffset), header.vertexCount};
+    cooked.indices = {indices, header.indexCount};
+    cooked.file = std::move(file);
+    return true;
+}
+
+} // namespace CookedMesh
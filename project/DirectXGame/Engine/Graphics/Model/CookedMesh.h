@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+#include "File/MappedFile.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// ============================================================
+// CookedMesh — インポート済みモデルのバイナリキャッシュ
+// 初回に assimp で読み込んだ結果を書き出し、2回目以降はマップしたファイルから直接読む
+//
+// ファイルレイアウト (オフセットはすべてファイル先頭から、各ブロックは16バイト境界)
+//   FileHeader                モデル全体の範囲 (AABB と球) を含む
+//   VertexData[vertexCount]   頂点 (X反転済み。そのまま頂点バッファにコピーできる)
+//   uint32_t[indexCount]      インデックス (全LODを連結したもの)
+//   LodRecord[lodCount]       LODごとのインデックスとサブメッシュの範囲
+//   SubMeshRecord[subMeshCount] サブメッシュ (全LOD分。範囲を含む)
+//   MaterialRecord[materialCount] サブメッシュのマテリアル
+//   NodeRecord[nodeCount]     ノード階層 (親が子より前に並ぶ順。親はノード番号で持つ)
+//   NodeNameRecord[nodeNameCount] ノード名 (同じ名前は1つにまとめたもの)
+//   char[stringSize]          文字列テーブル (ノード名、テクスチャパス)
+// ============================================================
+namespace CookedMesh {
+
+// フォーマットや書き出す内容を変えたら上げる (古いキャッシュは読み込み時に弾かれ、作り直される)
+// 2: MeshOptimizer で最適化した頂点・インデックスを保存
+// 3: MeshSimplifier で作ったLODを保存
+// 4: サブメッシュとマテリアルを保存
+// 5: ノード階層を親番号の配列で保存
+// 6: スキン・アニメーションを持つモデルは保存しない (5 以前のキャッシュにはそれらが欠けている)
+// 7: モデル全体とサブメッシュの範囲 (AABB と球) を保存
+// 8: 法線だけが違う頂点をまとめて LOD を作るようにした
+static const uint32_t kVersion = 8;
+
+// 読み込んだモデル (頂点・インデックスはマップしたファイルを直接指す)
+struct CookedModel {
+    MappedFile file;
+    std::span<const VertexData> vertices;
+    std::span<const uint32_t> indices;
+    std::vector<MeshLod> lods;
+    std::vector<SubMesh> subMeshes;
+    std::vector<MaterialData> materials;
+    MaterialData material;
+    NodeHierarchy nodes;
+    Bounds bounds;
+};
+
+/// <summary>
+/// キャッシュのキーを求める (元ファイルと OBJ が参照する MTL の内容・パス・インポート設定・フォーマットのバージョン)
+/// </summary>
+/// <param name="sourcePath">元のモデルファイルのパス</param>
+/// <param name="importFlags">assimp のインポートフラグ</param>
+/// <returns>キー (元ファイルが読めない場合は 0)</returns>
+uint64_t ComputeKey(const std::string& sourcePath, uint32_t importFlags);
+
+// キーに対応するキャッシュファイルのパス
+std::string GetCachePath(uint64_t key);
+
+/// <summary>
+/// モデルデータをキャッシュファイルに書き出す (一時ファイルに書いてから置き換える)
+/// </summary>
+/// <returns>true = 成功</returns>
+bool Save(const std::string& cachePath, uint64_t key, const ModelData& modelData);
+
+/// <summary>
+/// キャッシュファイルをマップして読み込む
+/// キーやバージョンが一致しない、または壊れている (範囲外を指すインデックスを含む) 場合は失敗する
+/// </summary>
+/// <returns>true = 成功</returns>
+bool Load(const std::string& cachePath, uint64_t key, CookedModel& cooked);
+
+} // namespace CookedMesh
@@ -0,0 +1,752 @@
+#include "GltfLoader.h"
+#include "AnimationSampler.h"
+#include "MeshOptimizer.h"
+#include "NodeTransform.h"
+#include "Skinning.h"
+#include "File/MappedFile.h"
+#include "Logger.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <externals/nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <format>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace MathGenerators;
+
+namespace {
+
+using Json = nlohmann::json;
+
+// GLB のヘッダーとチャンクの種類
+constexpr uint32_t kGlbMagic = 0x46546C67;     // "glTF"
+constexpr uint32_t kGlbVersion = 2;
+constexpr uint32_t kGlbChunkJson = 0x4E4F534A; // "JSON"
+constexpr uint32_t kGlbChunkBin = 0x004E4942;  // "BIN\0"
+
+// アクセサーの要素の型
+constexpr uint32_t kComponentByte = 5120;
+constexpr uint32_t kComponentUnsignedByte = 5121;
+constexpr uint32_t kComponentShort = 5122;
+constexpr uint32_t kComponentUnsignedShort = 5123;
+constexpr uint32_t kComponentUnsignedInt = 5125;
+constexpr uint32_t kComponentFloat = 5126;
+
+// プリミティブの描画モード (三角形リストのみ対応)
+constexpr uint32_t kModeTriangles = 4;
+
+// アクセサーが指すバッファ上の範囲 (マップしたファイルを直接指す。コピーはしない)
+struct AccessorView {
+    const uint8_t* data = nullptr; // 最初の要素の先頭
+    uint32_t count = 0;            // 要素数
+    uint32_t stride = 0;           // 要素の間隔 (バイト)
+    uint32_t componentType = 0;    // kComponent*
+    uint32_t componentCount = 0;   // 1要素あたりの成分数 (SCALAR = 1, VEC3 = 3, MAT4 = 16 など)
+    bool normalized = false;       // 整数を 0～1 (符号付きは -1～1) の実数として読む
+
+    const uint8_t* GetElement(uint32_t index) const { return data + static_cast<size_t>(index) * stride; }
+};
+
+// 読み込み中のファイル
+struct Document {
+    std::string directoryPath;
+    Json json;
+    std::vector<MappedFile> externalFiles;          // 外部の .bin (buffers が指すので最後まで開いておく)
+    std::vector<std::span<const uint8_t>> buffers;  // buffers[i] の中身
+    std::vector<int32_t> nodeIndices;               // glTF のノード番号 -> NodeHierarchy の番号 (シーンに無いノードは -1)
+    std::string error;                              // 空でなければ失敗
+};
+
+// 失敗の理由を残して false を返す
+bool Fail(Document& document, std::string message) {
+    document.error = std::move(message);
+    return false;
+}
+
+// 無ければ空の配列
+const Json& GetArray(const Json& object, const char* key) {
+    static const Json kEmpty = Json::array();
+    auto it = object.find(key);
+    return it != object.end() && it->is_array() ? *it : kEmpty;
+}
+
+uint32_t GetComponentSize(uint32_t componentType) {
+    switch (componentType) {
+    case kComponentByte:
+    case kComponentUnsignedByte:
+        return 1;
+    case kComponentShort:
+    case kComponentUnsignedShort:
+        return 2;
+    case kComponentUnsignedInt:
+    case kComponentFloat:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+uint32_t GetComponentCount(std::string_view type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    if (type == "MAT4") return 16;
+    return 0;
+}
+
+// URI の %XX を戻す (ファイル名の空白などが %20 で書かれている)
+std::string DecodeUri(std::string_view uri) {
+    std::string result;
+    result.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i) {
+        if (uri[i] == '%' && i + 2 < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(uri[i + 2]))) {
+            result.push_back(static_cast<char>(std::stoi(std::string(uri.substr(i + 1, 2)), nullptr, 16)));
+            i += 2;
+        } else {
+            result.push_back(uri[i]);
+        }
+    }
+    return result;
+}
+
+// GLB のヘッダーとチャンクを読む (JSON は解析して document に入れ、BIN チャンクの範囲を返す)
+bool ReadGlb(Document& document, std::span<const uint8_t> bytes, std::span<const uint8_t>& binChunk) {
+    uint32_t header[3] = {};
+    if (bytes.size() < sizeof(header)) {
+        return Fail(document, "GLB header is truncated");
+    }
+    std::memcpy(header, bytes.data(), sizeof(header));
+    if (header[0] != kGlbMagic || header[1] != kGlbVersion || header[2] > bytes.size()) {
+        return Fail(document, "invalid GLB header");
+    }
+
+    bool hasJson = false;
+    size_t offset = sizeof(header);
+    while (offset + 8 <= header[2]) {
+        uint32_t chunk[2] = {}; // 長さ, 種類
+        std::memcpy(chunk, bytes.data() + offset, sizeof(chunk));
+        offset += sizeof(chunk);
+        if (chunk[0] > header[2] - offset) {
+            return Fail(document, "GLB chunk is truncated");
+        }
+        const std::span<const uint8_t> data = bytes.subspan(offset, chunk[0]);
+        if (chunk[1] == kGlbChunkJson && !hasJson) {
+            document.json = Json::parse(data.begin(), data.end());
+            hasJson = true;
+        } else if (chunk[1] == kGlbChunkBin && binChunk.empty()) {
+            binChunk = data;
+        }
+        offset += chunk[0];
+    }
+    return hasJson ? true : Fail(document, "GLB has no JSON chunk");
+}
+
+// buffers をマップしたファイルの範囲に解決する
+bool ResolveBuffers(Document& document, std::span<const uint8_t> binChunk) {
+    const Json& buffers = GetArray(document.json, "buffers");
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        const Json& buffer = buffers[i];
+        const size_t byteLength = buffer.at("byteLength").get<size_t>();
+        if (!buffer.contains("uri")) {
+            // GLB の BIN チャンク (uri を持たないのは先頭のバッファのみ)
+            if (i != 0 || binChunk.size() < byteLength) {
+                return Fail(document, "buffer without uri does not match the GLB BIN chunk");
+            }
+            document.buffers.push_back(binChunk.first(byteLength));
+            continue;
+        }
+
+        const std::string uri = buffer.at("uri").get<std::string>();
+        if (uri.starts_with("data:")) {
+            return Fail(document, "data URI buffers are not supported");
+        }
+        MappedFile file;
+        const std::string path = document.directoryPath + "/" + DecodeUri(uri);
+        if (!file.Open(path) || file.GetSize() < byteLength) {
+            return Fail(document, "cannot open buffer " + path);
+        }
+        document.buffers.push_back(file.GetBytes().first(byteLength));
+        document.externalFiles.push_back(std::move(file));
+    }
+    return true;
+}
+
+// アクセサーをバッファ上の範囲として取り出す (範囲外を指すものは失敗)
+bool GetAccessor(Document& document, uint32_t accessorIndex, AccessorView& view) {
+    const Json& accessors = GetArray(document.json, "accessors");
+    if (accessorIndex >= accessors.size()) {
+        return Fail(document, std::format("accessor {} does not exist", accessorIndex));
+    }
+    const Json& accessor = accessors[accessorIndex];
+    if (accessor.contains("sparse") || !accessor.contains("bufferView")) {
+        return Fail(document, std::format("accessor {} is sparse or has no buffer view", accessorIndex));
+    }
+
+    view.componentType = accessor.at("componentType").get<uint32_t>();
+    view.componentCount = GetComponentCount(accessor.at("type").get<std::string>());
+    view.count = accessor.at("count").get<uint32_t>();
+    view.normalized = accessor.value("normalized", false);
+    const uint32_t elementSize = GetComponentSize(view.componentType) * view.componentCount;
+    if (elementSize == 0) {
+        return Fail(document, std::format("accessor {} has an unknown type", accessorIndex));
+    }
+
+    const Json& bufferView = GetArray(document.json, "bufferViews").at(accessor.at("bufferView").get<size_t>());
+    const size_t bufferIndex = bufferView.at("buffer").get<size_t>();
+    if (bufferIndex >= document.buffers.size()) {
+        return Fail(document, std::format("accessor {} refers to a missing buffer", accessorIndex));
+    }
+    const std::span<const uint8_t> buffer = document.buffers[bufferIndex];
+    const size_t viewOffset = bufferView.value("byteOffset", size_t(0));
+    const size_t viewLength = bufferView.at("byteLength").get<size_t>();
+    const size_t accessorOffset = accessor.value("byteOffset", size_t(0));
+    view.stride = bufferView.value("byteStride", elementSize);
+
+    // 最後の要素の終わりまでがバッファビューとバッファに収まっていること
+    const size_t lastEnd =
+        view.count == 0 ? 0 : accessorOffset + static_cast<size_t>(view.stride) * (view.count - 1) + elementSize;
+    if (view.stride < elementSize || viewOffset + viewLength > buffer.size() || lastEnd > viewLength) {
+        return Fail(document, std::format("accessor {} is out of range", accessorIndex));
+    }
+    view.data = buffer.data() + viewOffset + accessorOffset;
+    return true;
+}
+
+// 成分の型と数を確かめてアクセサーを取り出す
+bool GetFloatAccessor(Document& document, uint32_t accessorIndex, uint32_t componentCount, bool allowNormalized,
+                      AccessorView& view) {
+    if (!GetAccessor(document, accessorIndex, view)) {
+        return false;
+    }
+    const bool isFloat = view.componentType == kComponentFloat;
+    const bool isNormalized = allowNormalized && view.normalized &&
+                              (view.componentType == kComponentUnsignedByte || view.componentType == kComponentUnsignedShort);
+    if (view.componentCount != componentCount || (!isFloat && !isNormalized)) {
+        return Fail(document, std::format("accessor {} must be {} floats", accessorIndex, componentCount));
+    }
+    return true;
+}
+
+// 成分を実数で読む (float か、正規化した符号無し整数)
+void ReadFloats(const AccessorView& view, uint32_t index, float* output) {
+    const uint8_t* element = view.GetElement(index);
+    if (view.componentType == kComponentFloat) {
+        std::memcpy(output, element, sizeof(float) * view.componentCount);
+        return;
+    }
+    for (uint32_t c = 0; c < view.componentCount; ++c) {
+        if (view.componentType == kComponentUnsignedByte) {
+            output[c] = element[c] / 255.0f;
+        } else {
+            uint16_t value;
+            std::memcpy(&value, element + c * sizeof(uint16_t), sizeof(value));
+            output[c] = value / 65535.0f;
+        }
+    }
+}
+
+// 整数の成分を読む (ジョイント番号とインデックス用)
+uint32_t ReadUint(const AccessorView& view, uint32_t index, uint32_t component) {
+    const uint8_t* element = view.GetElement(index);
+    switch (view.componentType) {
+    case kComponentUnsignedByte:
+        return element[component];
+    case kComponentUnsignedShort: {
+        uint16_t value;
+        std::memcpy(&value, element + component * sizeof(uint16_t), sizeof(value));
+        return value;
+    }
+    default: {
+        uint32_t value;
+        std::memcpy(&value, element + component * sizeof(uint32_t), sizeof(value));
+        return value;
+    }
+    }
+}
+
+// 三角形のインデックスを巻き順を反転して追加する (assimp の FlipWindingOrder と同じく 0 番と 2 番を入れ替える)
+template <class T>
+bool AppendTriangles(const AccessorView& view, uint32_t baseVertex, uint32_t vertexCount, uint32_t* output) {
+    const uint8_t* data = view.data;
+    for (uint32_t i = 0; i < view.count; i += 3) {
+        T corner[3];
+        std::memcpy(corner, data + static_cast<size_t>(i) * sizeof(T), sizeof(corner));
+        if (corner[0] >= vertexCount || corner[1] >= vertexCount || corner[2] >= vertexCount) {
+            return false;
+        }
+        *output++ = baseVertex + corner[2];
+        *output++ = baseVertex + corner[1];
+        *output++ = baseVertex + corner[0];
+    }
+    return true;
+}
+
+// ノードのローカル行列 (glTF の列優先の行列をそのまま行優先に読むと、行ベクトル規約の行列になる)
+Matrix4x4 ReadNodeMatrix(const Json& node) {
+    if (node.contains("matrix")) {
+        const Json& values = node.at("matrix");
+        Matrix4x4 result;
+        for (int i = 0; i < 16; ++i) {
+            result.m[i / 4][i % 4] = values.at(i).get<float>();
+        }
+        return result;
+    }
+    Vector3 scale = {1.0f, 1.0f, 1.0f};
+    Quaternion rotate = {0.0f, 0.0f, 0.0f, 1.0f};
+    Vector3 translate = {0.0f, 0.0f, 0.0f};
+    if (node.contains("scale")) {
+        const Json& s = node.at("scale");
+        scale = {s.at(0).get<float>(), s.at(1).get<float>(), s.at(2).get<float>()};
+    }
+    if (node.contains("rotation")) {
+        const Json& r = node.at("rotation");
+        rotate = {r.at(0).get<float>(), r.at(1).get<float>(), r.at(2).get<float>(), r.at(3).get<float>()};
+    }
+    if (node.contains("translation")) {
+        const Json& t = node.at("translation");
+        translate = {t.at(0).get<float>(), t.at(1).get<float>(), t.at(2).get<float>()};
+    }
+    return Animation::MakeTransformMatrix(scale, rotate, translate);
+}
+
+// assimp と同じく、名前の無いノードは "nodes_<番号>" と呼ぶ
+std::string GetNodeName(const Json& node, size_t index) {
+    const std::string name = node.value("name", std::string());
+    return name.empty() ? std::format("nodes_{}", index) : name;
+}
+
+// シーンのノードを親が子より前に並ぶ順で追加する (ルートが複数なら "ROOT" の子にする)
+bool ReadNodes(Document& document, NodeHierarchy& nodes) {
+    const Json& scenes = GetArray(document.json, "scenes");
+    const Json& gltfNodes = GetArray(document.json, "nodes");
+    const size_t sceneIndex = document.json.value("scene", size_t(0));
+    if (sceneIndex >= scenes.size()) {
+        return Fail(document, "file has no scene");
+    }
+    const Json& roots = GetArray(scenes[sceneIndex], "nodes");
+
+    struct PendingNode {
+        size_t node;
+        int32_t parent;
+    };
+    std::vector<PendingNode> stack;
+    if (roots.size() == 1) {
+        stack.push_back({roots[0].get<size_t>(), -1});
+    } else {
+        const int32_t root = static_cast<int32_t>(NodeTransform::AddNode(nodes, "ROOT", MakeIdentity4x4(), -1));
+        for (size_t i = roots.size(); i > 0; --i) {
+            stack.push_back({roots[i - 1].get<size_t>(), root});
+        }
+    }
+
+    document.nodeIndices.assign(gltfNodes.size(), -1);
+    while (!stack.empty()) {
+        const PendingNode pending = stack.back();
+        stack.pop_back();
+        if (pending.node >= gltfNodes.size() || document.nodeIndices[pending.node] >= 0) {
+            return Fail(document, std::format("node {} is missing or has more than one parent", pending.node));
+        }
+
+        const Json& node = gltfNodes[pending.node];
+        const uint32_t index =
+            NodeTransform::AddNode(nodes, GetNodeName(node, pending.node), ReadNodeMatrix(node), pending.parent);
+        document.nodeIndices[pending.node] = static_cast<int32_t>(index);
+
+        // 最初の子から順に取り出されるよう、逆順に積む
+        const Json& children = GetArray(node, "children");
+        for (size_t i = children.size(); i > 0; --i) {
+            stack.push_back({children[i - 1].get<size_t>(), static_cast<int32_t>(index)});
+        }
+    }
+    return true;
+}
+
+// baseColorTexture のパス (無い場合と、ファイルを指さない埋め込み画像は空)
+std::string GetTexturePath(const Document& document, const Json& material) {
+    auto pbr = material.find("pbrMetallicRoughness");
+    if (pbr == material.end() || !pbr->contains("baseColorTexture")) {
+        return {};
+    }
+    const Json& texture = GetArray(document.json, "textures").at(pbr->at("baseColorTexture").at("index").get<size_t>());
+    if (!texture.contains("source")) {
+        return {};
+    }
+    const Json& image = GetArray(document.json, "images").at(texture.at("source").get<size_t>());
+    const std::string uri = image.value("uri", std::string());
+    if (uri.empty() || uri.starts_with("data:")) {
+        Logger::Log("WARNING: GltfLoader does not support embedded images; using no texture\n");
+        return {};
+    }
+    return document.directoryPath + "/" + DecodeUri(uri);
+}
+
+// スキンのジョイントを ModelData::joints に追加し、スキン内の番号 -> joints の番号を返す
+// (同じ名前のジョイントはメッシュをまたいで1つにまとめる。シーンに無いノードは -1)
+bool ReadSkinJoints(Document& document, const Json& skin, ModelData& modelData,
+                    std::unordered_map<std::string, uint32_t>& jointIndices, std::vector<int32_t>& skinJoints) {
+    const Json& joints = GetArray(skin, "joints");
+    AccessorView inverseBindMatrices;
+    if (skin.contains("inverseBindMatrices")) {
+        if (!GetFloatAccessor(document, skin.at("inverseBindMatrices").get<uint32_t>(), 16, false, inverseBindMatrices)) {
+            return false;
+        }
+        if (inverseBindMatrices.count < joints.size()) {
+            return Fail(document, "skin has fewer inverse bind matrices than joints");
+        }
+    }
+
+    skinJoints.assign(joints.size(), -1);
+    for (size_t j = 0; j < joints.size(); ++j) {
+        const size_t gltfNode = joints[j].get<size_t>();
+        const int32_t nodeIndex = gltfNode < document.nodeIndices.size() ? document.nodeIndices[gltfNode] : -1;
+        if (nodeIndex < 0) {
+            Logger::Log(std::format("WARNING: Joint node {} is not in the scene\n", gltfNode));
+            continue;
+        }
+        const std::string& name = modelData.nodes.names[modelData.nodes.nameIds[nodeIndex]];
+        auto [it, inserted] = jointIndices.try_emplace(name, static_cast<uint32_t>(modelData.joints.size()));
+        if (inserted) {
+            Matrix4x4 inverseBindMatrix = MakeIdentity4x4();
+            if (inverseBindMatrices.data) {
+                ReadFloats(inverseBindMatrices, static_cast<uint32_t>(j), &inverseBindMatrix.m[0][0]);
+            }
+            modelData.joints.push_back({static_cast<uint32_t>(nodeIndex), inverseBindMatrix});
+        }
+        skinJoints[j] = static_cast<int32_t>(it->second);
+    }
+    return true;
+}
+
+// 頂点に JOINTS_n / WEIGHTS_n の影響を追加する
+bool ReadInfluences(Document& document, const Json& attributes, uint32_t baseVertex, uint32_t vertexCount,
+                    std::span<const int32_t> skinJoints, std::vector<VertexInfluence>& influences) {
+    for (uint32_t set = 0;; ++set) {
+        const std::string jointsKey = std::format("JOINTS_{}", set);
+        const std::string weightsKey = std::format("WEIGHTS_{}", set);
+        if (!attributes.contains(jointsKey) || !attributes.contains(weightsKey)) {
+            return true;
+        }
+        AccessorView joints;
+        AccessorView weights;
+        if (!GetAccessor(document, attributes.at(jointsKey).get<uint32_t>(), joints) ||
+            !GetFloatAccessor(document, attributes.at(weightsKey).get<uint32_t>(), 4, true, weights)) {
+            return false;
+        }
+        if (joints.componentCount != 4 || joints.count < vertexCount || weights.count < vertexCount ||
+            (joints.componentType != kComponentUnsignedByte && joints.componentType != kComponentUnsignedShort)) {
+            return Fail(document, "invalid skin attributes");
+        }
+
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            float weight[4];
+            ReadFloats(weights, v, weight);
+            for (uint32_t k = 0; k < 4; ++k) {
+                const uint32_t joint = ReadUint(joints, v, k);
+                if (weight[k] > 0.0f && joint < skinJoints.size() && skinJoints[joint] >= 0) {
+                    Skinning::AddInfluence(influences[baseVertex + v], static_cast<uint32_t>(skinJoints[joint]), weight[k]);
+                }
+            }
+        }
+    }
+}
+
+// メッシュ・マテリアル・スキンを読む (ノードは読み込み済みであること)
+bool ReadMeshes(Document& document, ModelData& modelData) {
+    // --- マテリアル ---
+    // assimp と同じく、glTF のマテリアルの後ろにテクスチャ無しの既定のマテリアルを置き、テクスチャが同じものは1つにまとめる
+    const Json& materials = GetArray(document.json, "materials");
+    std::vector<uint32_t> materialSlots(materials.size() + 1, 0);
+    std::unordered_map<std::string, uint32_t> textureMaterials;
+    modelData.materials.clear();
+    for (size_t i = 0; i <= materials.size(); ++i) {
+        const std::string texturePath = i < materials.size() ? GetTexturePath(document, materials[i]) : std::string();
+        auto [it, inserted] = textureMaterials.try_emplace(texturePath, static_cast<uint32_t>(modelData.materials.size()));
+        if (inserted) {
+            modelData.materials.push_back({texturePath, 0});
+        }
+        materialSlots[i] = it->second;
+    }
+    // 代表のマテリアルは、最初にテクスチャを持っているもの
+    modelData.material = {};
+    for (const MaterialData& material : modelData.materials) {
+        if (!material.textureFilePath.empty()) {
+            modelData.material.textureFilePath = material.textureFilePath;
+            break;
+        }
+    }
+
+    // --- メッシュごとのスキン (スキン付きのノードから使われているメッシュのみ) ---
+    const Json& meshes = GetArray(document.json, "meshes");
+    const Json& gltfNodes = GetArray(document.json, "nodes");
+    std::vector<int32_t> meshSkins(meshes.size(), -1);
+    bool hasBones = false;
+    for (size_t n = 0; n < gltfNodes.size(); ++n) {
+        const Json& node = gltfNodes[n];
+        if (document.nodeIndices[n] < 0 || !node.contains("mesh") || !node.contains("skin")) {
+            continue;
+        }
+        const size_t mesh = node.at("mesh").get<size_t>();
+        if (mesh < meshes.size() && meshSkins[mesh] < 0) {
+            meshSkins[mesh] = node.at("skin").get<int32_t>();
+            hasBones = true;
+        }
+    }
+    const Json& skins = GetArray(document.json, "skins");
+    std::vector<std::vector<int32_t>> skinJoints(skins.size());
+    std::vector<bool> isSkinRead(skins.size(), false);
+    std::unordered_map<std::string, uint32_t> jointIndices;
+
+    // --- 頂点数とインデックス数を先に数え、1回の確保で書き込む ---
+    size_t vertexTotal = 0;
+    size_t indexTotal = 0;
+    for (const Json& mesh : meshes) {
+        for (const Json& primitive : GetArray(mesh, "primitives")) {
+            const Json& attributes = primitive.at("attributes");
+            if (primitive.value("mode", kModeTriangles) != kModeTriangles || !attributes.contains("POSITION")) {
+                return Fail(document, "only triangle list primitives are supported");
+            }
+            const size_t vertexCount =
+                GetArray(document.json, "accessors").at(attributes.at("POSITION").get<size_t>()).at("count").get<size_t>();
+            vertexTotal += vertexCount;
+            indexTotal += primitive.contains("indices")
+                              ? GetArray(document.json, "accessors").at(primitive.at("indices").get<size_t>()).at("count").get<size_t>()
+                              : vertexCount;
+        }
+    }
+    if (vertexTotal == 0 || indexTotal == 0 || vertexTotal > UINT32_MAX) {
+        return Fail(document, "file has no triangles");
+    }
+    modelData.vertices.resize(vertexTotal);
+    modelData.indices.resize(indexTotal);
+    modelData.influences.clear();
+    modelData.joints.clear();
+    if (hasBones) {
+        modelData.influences.resize(vertexTotal);
+    }
+    std::vector<uint32_t> triangleMaterials;
+    triangleMaterials.reserve(indexTotal / 3);
+
+    // --- メッシュの解析 (メッシュ・プリミティブの順に頂点を連結する) ---
+    uint32_t baseVertex = 0;
+    uint32_t* indexOutput = modelData.indices.data();
+    for (size_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+        for (const Json& primitive : GetArray(meshes[meshIndex], "primitives")) {
+            const Json& attributes = primitive.at("attributes");
+            if (!attributes.contains("NORMAL") || !attributes.contains("TEXCOORD_0")) {
+                return Fail(document, "primitives without normals or texture coordinates are not supported");
+            }
+            AccessorView positions;
+            AccessorView normals;
+            AccessorView texcoords;
+            if (!GetFloatAccessor(document, attributes.at("POSITION").get<uint32_t>(), 3, false, positions) ||
+                !GetFloatAccessor(document, attributes.at("NORMAL").get<uint32_t>(), 3, false, normals) ||
+                !GetFloatAccessor(document, attributes.at("TEXCOORD_0").get<uint32_t>(), 2, false, texcoords)) {
+                return false;
+            }
+            const uint32_t vertexCount = positions.count;
+            if (normals.count != vertexCount || texcoords.count != vertexCount) {
+                return Fail(document, "attribute counts do not match");
+            }
+
+            // --- 頂点データ (マップしたバッファから直接読み、assimp 経由と同じく X を反転する) ---
+            VertexData* vertexOutput = modelData.vertices.data() + baseVertex;
+            for (uint32_t v = 0; v < vertexCount; ++v) {
+                Vector3 position;
+                Vector3 normal;
+                Vector2 texcoord;
+                std::memcpy(&position, positions.GetElement(v), sizeof(position));
+                std::memcpy(&normal, normals.GetElement(v), sizeof(normal));
+                std::memcpy(&texcoord, texcoords.GetElement(v), sizeof(texcoord));
+                vertexOutput[v] = {{-position.x, position.y, position.z, 1.0f}, texcoord, {-normal.x, normal.y, normal.z}};
+            }
+
+            // --- スキン ---
+            const int32_t skin = meshSkins[meshIndex];
+            if (skin >= 0) {
+                if (static_cast<size_t>(skin) >= skins.size()) {
+                    return Fail(document, std::format("skin {} does not exist", skin));
+                }
+                if (!isSkinRead[skin]) {
+                    if (!ReadSkinJoints(document, skins[skin], modelData, jointIndices, skinJoints[skin])) {
+                        return false;
+                    }
+                    isSkinRead[skin] = true;
+                }
+                if (!ReadInfluences(document, attributes, baseVertex, vertexCount, skinJoints[skin], modelData.influences)) {
+                    return false;
+                }
+            }
+
+            // --- インデックス (インデックスの無いプリミティブは頂点の並び順) ---
+            uint32_t indexCount = vertexCount;
+            if (primitive.contains("indices")) {
+                AccessorView indices;
+                if (!GetAccessor(document, primitive.at("indices").get<uint32_t>(), indices)) {
+                    return false;
+                }
+                indexCount = indices.count;
+                bool isValid = indices.componentCount == 1 && indexCount % 3 == 0;
+                if (isValid) {
+                    switch (indices.componentType) {
+                    case kComponentUnsignedByte:
+                        isValid = AppendTriangles<uint8_t>(indices, baseVertex, vertexCount, indexOutput);
+                        break;
+                    case kComponentUnsignedShort:
+                        isValid = AppendTriangles<uint16_t>(indices, baseVertex, vertexCount, indexOutput);
+                        break;
+                    case kComponentUnsignedInt:
+                        isValid = AppendTriangles<uint32_t>(indices, baseVertex, vertexCount, indexOutput);
+                        break;
+                    default:
+                        isValid = false;
+                        break;
+                    }
+                }
+                if (!isValid) {
+                    return Fail(document, "invalid index accessor");
+                }
+            } else {
+                if (indexCount % 3 != 0) {
+                    return Fail(document, "vertex count is not a multiple of 3");
+                }
+                for (uint32_t i = 0; i < indexCount; i += 3) {
+                    indexOutput[i] = baseVertex + i + 2;
+                    indexOutput[i + 1] = baseVertex + i + 1;
+                    indexOutput[i + 2] = baseVertex + i;
+                }
+            }
+            indexOutput += indexCount;
+
+            const size_t material = std::min(primitive.value("material", materials.size()), materials.size());
+            triangleMaterials.insert(triangleMaterials.end(), indexCount / 3, materialSlots[material]);
+            baseVertex += vertexCount;
+        }
+    }
+
+    // --- 三角形をマテリアルごとにまとめる ---
+    modelData.subMeshes = MeshOptimizer::GroupTriangles(modelData.indices, triangleMaterials, modelData.materials.size());
+
+    // --- 重みの正規化 (スキンの無いメッシュの頂点は、ルートノードに固定する) ---
+    if (hasBones) {
+        Skinning::NormalizeInfluences(modelData.influences, modelData.joints);
+    }
+    return true;
+}
+
+// アニメーションを読む (時間は秒、キーの無い要素はノードのローカル行列で補う)
+bool ReadAnimations(Document& document, ModelData& modelData) {
+    modelData.animations.clear();
+    for (const Json& animation : GetArray(document.json, "animations")) {
+        AnimationClip clip;
+        clip.name = animation.value("name", std::string());
+        const Json& samplers = GetArray(animation, "samplers");
+
+        // ノードごとに1トラック (チャンネルが最初に現れた順)
+        std::unordered_map<uint32_t, size_t> trackIndices;
+        for (const Json& channel : GetArray(animation, "channels")) {
+            const Json& target = channel.at("target");
+            const size_t gltfNode = target.value("node", document.nodeIndices.size());
+            const std::string path = target.at("path").get<std::string>();
+            if (gltfNode >= document.nodeIndices.size() || document.nodeIndices[gltfNode] < 0 || path == "weights") {
+                continue;
+            }
+            const uint32_t nodeIndex = static_cast<uint32_t>(document.nodeIndices[gltfNode]);
+            const Json& sampler = samplers.at(channel.at("sampler").get<size_t>());
+            const uint32_t componentCount = path == "rotation" ? 4 : 3;
+
+            AccessorView times;
+            AccessorView values;
+            if (!GetFloatAccessor(document, sampler.at("input").get<uint32_t>(), 1, false, times) ||
+                !GetFloatAccessor(document, sampler.at("output").get<uint32_t>(), componentCount, false, values)) {
+                return false;
+            }
+            // CUBICSPLINE は (入力接線, 値, 出力接線) の3つで1キーなので、値だけを使う
+            const bool isCubic = sampler.value("interpolation", std::string("LINEAR")) == "CUBICSPLINE";
+            const uint32_t valueStep = isCubic ? 3 : 1;
+            if (values.count < static_cast<size_t>(times.count) * valueStep) {
+                return Fail(document, "animation sampler has fewer values than keys");
+            }
+
+            auto [it, inserted] = trackIndices.try_emplace(nodeIndex, clip.tracks.size());
+            if (inserted) {
+                clip.tracks.emplace_back().nodeIndex = nodeIndex;
+            }
+            NodeAnimation& track = clip.tracks[it->second];
+            for (uint32_t k = 0; k < times.count; ++k) {
+                float time;
+                float value[4];
+                ReadFloats(times, k, &time);
+                ReadFloats(values, k * valueStep + (isCubic ? 1 : 0), value);
+                clip.duration = std::max(clip.duration, time);
+                if (path == "translation") {
+                    track.translate.push_back({time, {value[0], value[1], value[2]}});
+                } else if (path == "rotation") {
+                    track.rotate.push_back({time, {value[0], value[1], value[2], value[3]}});
+                } else if (path == "scale") {
+                    track.scale.push_back({time, {value[0], value[1], value[2]}});
+                }
+            }
+        }
+
+        // キーの無い要素はノードのローカル行列の値で1つ補う (サンプラーで分岐しないため)
+        for (NodeAnimation& track : clip.tracks) {
+            Animation::FillMissingKeys(track, modelData.nodes.localMatrices[track.nodeIndex]);
+        }
+        modelData.animations.push_back(std::move(clip));
+    }
+    return true;
+}
+
+} // namespace
+
+namespace GltfLoader {
+
+bool Load(const std::string& directoryPath, const std::string& fileName, ModelData& modelData) {
+    const std::string fullPath = directoryPath + "/" + fileName;
+
+    MappedFile file;
+    if (!file.Open(fullPath)) {
+        Logger::Log("WARNING: GltfLoader failed to open: " + fullPath + "\n");
+        return false;
+    }
+
+    Document document;
+    document.directoryPath = directoryPath;
+    bool isLoaded = false;
+    try {
+        // .glb はヘッダーとチャンク、.gltf は JSON のみ (バッファは外部ファイル)
+        std::span<const uint8_t> binChunk;
+        const std::span<const uint8_t> bytes = file.GetBytes();
+        uint32_t magic = 0;
+        std::memcpy(&magic, bytes.data(), std::min(bytes.size(), sizeof(magic)));
+        if (magic == kGlbMagic) {
+            isLoaded = ReadGlb(document, bytes, binChunk);
+        } else {
+            document.json = Json::parse(bytes.begin(), bytes.end());
+            isLoaded = true;
+        }
+
+        modelData.nodes = {};
+        isLoaded = isLoaded && ResolveBuffers(document, binChunk) && ReadNodes(document, modelData.nodes) &&
+                   ReadMeshes(document, modelData) && ReadAnimations(document, modelData);
+    } catch (const Json::exception& exception) {
+        document.error = exception.what();
+        isLoaded = false;
+    }
+
+    if (!isLoaded) {
+        Logger::Log(std::format("WARNING: GltfLoader cannot read {}: {}\n", fullPath, document.error));
+        return false;
+    }
+    return true;
+}
+
+} // namespace GltfLoader
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <string>
+
+// ============================================================
+// GltfLoader — glTF 2.0 (.glb / .gltf + .bin) 専用のリーダー
+// ファイルをマップし、アクセサーをバッファ上のビュー (先頭・ストライド・個数) として直接読む
+// 中間の配列 (assimp の aiMesh) を作らず、マップしたバイト列から ModelData へ1回で書き込む
+//
+// 出力は assimp 経由 (Model::LoadModelFile) と同じにする
+//   ・位置と法線のXを反転 (UV は glTF と DirectX で向きが同じなのでそのまま)
+//   ・三角形の巻き順を反転 (aiProcess_FlipWindingOrder)
+//   ・頂点はプリミティブごとにそのまま並べる (重複頂点はまとめない)
+//   ・マテリアルは baseColorTexture をテクスチャとし、同じテクスチャのものは1つにまとめる
+//     (マテリアルの無いプリミティブはテクスチャ無しの既定マテリアル)
+//   ・ノードはシーンのルートが1つならそれをルートに、複数なら "ROOT" の子にする (名前の無いノードは "nodes_<番号>")
+//   ・スキンのジョイントは逆バインド行列付きで ModelData::joints に、アニメーションは秒単位のキーで読む
+//
+// 対応しない内容 (三角形以外のプリミティブ・float 以外の位置/法線/UV・疎なアクセサー・data URI のバッファ) を
+// 含む場合は失敗するので assimp で読み直すこと
+// GLB に埋め込まれた画像はテクスチャ無しとして扱う (assimp 経由でも読めるファイルにならない)
+// ============================================================
+namespace GltfLoader {
+
+/// <summary>
+/// glTF / GLB ファイルを読み込む
+/// </summary>
+/// <param name="directoryPath">モデルファイルのディレクトリパス</param>
+/// <param name="fileName">モデルファイル名</param>
+/// <param name="modelData">読み込み先</param>
+/// <returns>true = 成功</returns>
+bool Load(const std::string& directoryPath, const std::string& fileName, ModelData& modelData);
+
+} // namespace GltfLoader
@@ -0,0 +1,108 @@
+#include "MeshImporter.h"
+#include "AnimationCompressor.h"
+#include "BoundingVolume.h"
+#include "GltfLoader.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "ObjLoader.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+
+namespace MeshImporter {
+
+namespace {
+
+// 小文字にした拡張子 (".obj" など)
+std::string GetLowerExtension(const std::string& filename) {
+    std::string extension = std::filesystem::path(filename).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension;
+}
+
+// 専用のリーダーで読む (対応していない形式・内容なら None を返すので fallbackLoader で読み直す)
+Reader LoadWithNativeReader(const std::string& directoryPath, const std::string& filename, ModelData& modelData) {
+    const std::string extension = GetLowerExtension(filename);
+    if (extension == ".obj") {
+        return ObjLoader::Load(directoryPath, filename, modelData) ? Reader::Obj : Reader::None;
+    }
+    if (extension == ".glb" || extension == ".gltf") {
+        return GltfLoader::Load(directoryPath, filename, modelData) ? Reader::Gltf : Reader::None;
+    }
+    return Reader::None;
+}
+
+} // namespace
+
+const char* GetReaderName(Reader reader) {
+    switch (reader) {
+    case Reader::Cache:
+        return "cache";
+    case Reader::Obj:
+        return "obj";
+    case Reader::Gltf:
+        return "gltf";
+    case Reader::Assimp:
+        return "assimp";
+    default:
+        return "none";
+    }
+}
+
+MeshSource Load(const std::string& directoryPath, const std::string& filename, const Settings& settings) {
+    MeshSource source;
+    source.fullPath = directoryPath + "/" + filename;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // 変換済みのキャッシュがあれば、ファイルを変換せずにマップしたファイルから読む
+    // (useCache = false ならキーを「キーなし」の 0 にして、読み込みも書き出しもしない)
+    const uint64_t cacheKey = settings.useCache ? CookedMesh::ComputeKey(source.fullPath, settings.importFlags) : 0;
+    const std::string cachePath = CookedMesh::GetCachePath(cacheKey);
+    source.isCached = cacheKey != 0 && CookedMesh::Load(cachePath, cacheKey, source.cooked);
+
+    if (source.isCached) {
+        source.reader = Reader::Cache;
+    } else {
+        // モデル読み込み
+        // OBJ・glTF は専用のリーダーで読み、対応していない内容なら fallbackLoader で読み直す
+        source.reader = LoadWithNativeReader(directoryPath, filename, source.modelData);
+        if (source.reader == Reader::None) {
+            if (settings.fallbackLoader) {
+                source.modelData = {};
+                settings.fallbackLoader(directoryPath, filename, source.modelData);
+                source.reader = Reader::Assimp;
+            } else {
+                Logger::Log("WARNING: No reader for model: " + source.fullPath + "\n");
+            }
+        }
+
+        // 頂点キャッシュ・オーバードロー・頂点フェッチ向けに並べ替える (結果はキャッシュに残る)
+        MeshOptimizer::Optimize(source.modelData, source.fullPath);
+
+        // 遠くで使う簡略化したLODを作り、インデックスの後ろに連結する
+        MeshSimplifier::BuildLodChain(source.modelData, source.fullPath);
+
+        // アニメーションのキーを間引いて量子化する (実行時は圧縮したものだけを持つ)
+        AnimationCompressor::CompressAnimations(source.modelData, source.fullPath);
+
+        // モデル全体・サブメッシュ・ジョイントの範囲を求める (キャッシュに残る)
+        BoundingVolume::ComputeModelBounds(source.modelData);
+
+        // 次回以降のためにキャッシュを書き出す
+        // (スキンとアニメーションはキャッシュに入らないので、それらを持つモデルは毎回ファイルから読む)
+        const bool isAnimated = !source.modelData.joints.empty() || !source.modelData.compressedAnimations.empty();
+        if (cacheKey != 0 && !isAnimated && !CookedMesh::Save(cachePath, cacheKey, source.modelData)) {
+            Logger::Log("WARNING: Failed to write cooked mesh: " + cachePath + "\n");
+        }
+    }
+
+    source.loadMilliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return source;
+}
+
+} // namespace MeshImporter
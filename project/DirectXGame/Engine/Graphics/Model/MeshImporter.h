@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CookedMesh.h"
+#include "Types/ModelTypes.h"
+
+#include <cstdint>
+#include <string>
+
+// ============================================================
+// MeshImporter — モデルファイルから GPU リソースを作る前のメッシュを読み込む (D3D12 を使わないのでワーカースレッドから呼べる)
+//   ・変換済みキャッシュがあれば、マップしたファイルをそのまま使う
+//   ・なければ OBJ・glTF は専用のリーダーで読み、読めない内容は fallbackLoader (ゲームでは assimp) で読む
+//   ・読んだメッシュは並べ替え・LOD作成・アニメーション圧縮・範囲の計算をしてキャッシュに書き出す
+// ============================================================
+namespace MeshImporter {
+
+// メッシュを読んだ方法
+enum class Reader {
+    None,   // 読めなかった (空のメッシュ)
+    Cache,  // 変換済みキャッシュ
+    Obj,    // ObjLoader
+    Gltf,   // GltfLoader
+    Assimp, // fallbackLoader
+};
+
+// ログに出す名前 ("cache" / "obj" / "gltf" / "assimp")
+const char* GetReaderName(Reader reader);
+
+// 専用のリーダーで読めなかったときに使うローダー
+using FallbackLoader = void (*)(const std::string& directoryPath, const std::string& filename, ModelData& modelData);
+
+struct Settings {
+    uint32_t importFlags = 0;               // キャッシュのキーに含める読み込み設定
+    FallbackLoader fallbackLoader = nullptr; // nullptr なら専用のリーダーで読めないファイルは空のメッシュになる
+    bool useCache = true;                   // false ならキャッシュを読み書きせず、毎回ファイルから変換する (計測用)
+};
+
+// GPUリソースを作る前のメッシュの読み込み結果
+struct MeshSource {
+    std::string fullPath;           // 読み込んだファイルのパス
+    bool isCached = false;          // true = 変換済みキャッシュから読んだ
+    Reader reader = Reader::None;   // 読んだ方法
+    ModelData modelData;            // ファイルから変換した場合のデータ
+    CookedMesh::CookedModel cooked; // キャッシュから読んだ場合のデータ (マップしたファイルを指す)
+    double loadMilliseconds = 0.0;  // 読み込みにかかった時間
+};
+
+MeshSource Load(const std::string& directoryPath, const std::string& filename, const Settings& settings);
+
+} // namespace MeshImporter
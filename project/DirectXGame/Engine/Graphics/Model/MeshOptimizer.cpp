@@ -0,0 +1,459 @@
+#include "MeshOptimizer.h"
+#include "Hash/HashUtility.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <unordered_map>
+
+namespace {
+
+// --- Forsyth のパラメータ (元論文の推奨値) ---
+constexpr int kCacheSize = 32;
+constexpr float kCacheDecayPower = 1.5f;
+constexpr float kLastTriangleScore = 0.75f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+// 価数のスコアを表で持つ上限 (これ以上は同じ値とみなす)
+constexpr uint32_t kMaxValence = 32;
+
+// スコアの表 (キャッシュ位置・残り価数ごと)
+struct ScoreTable {
+    std::array<float, kCacheSize> cache{};
+    std::array<float, kMaxValence + 1> valence{};
+
+    ScoreTable() {
+        for (int i = 0; i < kCacheSize; ++i) {
+            if (i < 3) {
+                // 直前の三角形の頂点は、どれを使っても同じ
+                cache[i] = kLastTriangleScore;
+            } else {
+                const float scaler = 1.0f / static_cast<float>(kCacheSize - 3);
+                cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        valence[0] = 0.0f;
+        for (uint32_t i = 1; i <= kMaxValence; ++i) {
+            valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+        }
+    }
+};
+
+const ScoreTable& GetScoreTable() {
+    static const ScoreTable table;
+    return table;
+}
+
+// 頂点のスコア (残りの三角形が無い頂点は選ばれないよう負にする)
+float VertexScore(int cachePosition, uint32_t remaining) {
+    if (remaining == 0) {
+        return -1.0f;
+    }
+    const ScoreTable& table = GetScoreTable();
+    float score = table.valence[std::min(remaining, kMaxValence)];
+    if (cachePosition >= 0) {
+        score += table.cache[cachePosition];
+    }
+    return score;
+}
+
+// 重複判定用の頂点キー (VertexData・VertexInfluence にパディングは無いのでバイト列で比較できる)
+// マテリアルやジョイントの影響が違う頂点はまとめない (サブメッシュ同士で頂点を共有しないため)
+struct VertexKey {
+    VertexData vertex;
+    VertexInfluence influence;
+    uint32_t material;
+    bool operator==(const VertexKey& other) const {
+        return material == other.material && std::memcmp(&vertex, &other.vertex, sizeof(VertexData)) == 0 &&
+               std::memcmp(&influence, &other.influence, sizeof(VertexInfluence)) == 0;
+    }
+};
+static_assert(sizeof(VertexData) == sizeof(float) * 9, "VertexData must not have padding");
+static_assert(sizeof(VertexInfluence) == sizeof(uint32_t) * 8, "VertexInfluence must not have padding");
+
+struct VertexKeyHash {
+    size_t operator()(const VertexKey& key) const {
+        const uint64_t hash = HashUtility::HashBytes(&key.vertex, sizeof(VertexData), HashUtility::HashValue(key.material));
+        return static_cast<size_t>(HashUtility::HashBytes(&key.influence, sizeof(VertexInfluence), hash));
+    }
+};
+
+// サブメッシュの範囲ごとに三角形を並べ替える (サブメッシュが無い場合は全体を1つの範囲とする)
+template <class Function>
+void ForEachSubMeshRange(std::vector<uint32_t>& indices, std::span<const SubMesh> subMeshes, Function function) {
+    if (subMeshes.empty()) {
+        function(indices);
+        return;
+    }
+    std::vector<uint32_t> range;
+    for (const SubMesh& subMesh : subMeshes) {
+        const auto begin = indices.begin() + subMesh.indexOffset;
+        range.assign(begin, begin + subMesh.indexCount);
+        function(range);
+        std::copy(range.begin(), range.end(), begin);
+    }
+}
+
+} // namespace
+
+namespace MeshOptimizer {
+
+CacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize) {
+    CacheStats stats;
+    if (indices.size() < 3 || vertexCount == 0 || cacheSize == 0) {
+        return stats;
+    }
+
+    // 各頂点がキャッシュに入った時刻 (FIFO なので、時刻の差でキャッシュ内かどうかが分かる)
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    uint32_t misses = 0;
+    for (uint32_t index : indices) {
+        if (time - timestamps[index] > cacheSize) {
+            timestamps[index] = time++;
+            ++misses;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+    return stats;
+}
+
+std::vector<SubMesh> GroupTriangles(std::vector<uint32_t>& indices, std::span<const uint32_t> triangleMaterials,
+                                    size_t materialCount) {
+    const size_t triangleCount = indices.size() / 3;
+    assert(triangleMaterials.size() == triangleCount);
+
+    // マテリアルごとの三角形数から開始位置を求め、元の順のまま振り分ける
+    std::vector<uint32_t> offsets(materialCount + 1, 0);
+    for (uint32_t material : triangleMaterials) {
+        assert(material < materialCount);
+        ++offsets[material + 1];
+    }
+    for (size_t m = 0; m < materialCount; ++m) {
+        offsets[m + 1] += offsets[m];
+    }
+
+    std::vector<SubMesh> subMeshes;
+    for (size_t m = 0; m < materialCount; ++m) {
+        if (offsets[m + 1] > offsets[m]) {
+            subMeshes.push_back({static_cast<uint32_t>(m), offsets[m] * 3, (offsets[m + 1] - offsets[m]) * 3, {}});
+        }
+    }
+
+    std::vector<uint32_t> sorted(indices.size());
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const uint32_t destination = offsets[triangleMaterials[t]]++;
+        std::copy_n(indices.begin() + t * 3, 3, sorted.begin() + destination * 3);
+    }
+    indices = std::move(sorted);
+    return subMeshes;
+}
+
+std::vector<uint32_t> MapVerticesToMaterials(const ModelData& modelData) {
+    std::vector<uint32_t> materials(modelData.vertices.size(), 0);
+    for (const SubMesh& subMesh : modelData.subMeshes) {
+        for (uint32_t i = 0; i < subMesh.indexCount; ++i) {
+            materials[modelData.indices[subMesh.indexOffset + i]] = subMesh.materialIndex;
+        }
+    }
+    return materials;
+}
+
+void WeldVertices(ModelData& modelData) {
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertexMap;
+    vertexMap.reserve(modelData.vertices.size());
+    const std::vector<uint32_t> vertexMaterials = MapVerticesToMaterials(modelData);
+
+    const bool isSkinned = !modelData.influences.empty();
+    std::vector<uint32_t> remap(modelData.vertices.size());
+    std::vector<VertexData> vertices;
+    std::vector<VertexInfluence> influences;
+    vertices.reserve(modelData.vertices.size());
+    for (size_t i = 0; i < modelData.vertices.size(); ++i) {
+        const VertexInfluence influence = isSkinned ? modelData.influences[i] : VertexInfluence{};
+        auto [it, inserted] = vertexMap.try_emplace(VertexKey{modelData.vertices[i], influence, vertexMaterials[i]},
+                                                    static_cast<uint32_t>(vertices.size()));
+        if (inserted) {
+            vertices.push_back(modelData.vertices[i]);
+            if (isSkinned) {
+                influences.push_back(influence);
+            }
+        }
+        remap[i] = it->second;
+    }
+
+    for (uint32_t& index : modelData.indices) {
+        index = remap[index];
+    }
+    modelData.vertices = std::move(vertices);
+    modelData.influences = std::move(influences);
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // --- 頂点ごとの隣接三角形リストを作る ---
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) {
+        ++remaining[index];
+    }
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remaining[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    // --- 初期スコア ---
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScores[v] = VertexScore(-1, remaining[v]);
+    }
+    std::vector<bool> emitted(triangleCount, false);
+    size_t bestTriangle = 0;
+    float bestInitialScore = -1.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+        if (score > bestInitialScore) {
+            bestInitialScore = score;
+            bestTriangle = t;
+        }
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    // LRU キャッシュ (先頭が最新)。追い出された頂点のスコア更新のため3つ余分に持つ
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> nextCache;
+    cache.reserve(kCacheSize + 3);
+    nextCache.reserve(kCacheSize + 3);
+    size_t scanCursor = 0; // 候補が無いときに、未出力の三角形を探す位置
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        // --- 最良の三角形を出力する ---
+        const size_t t = bestTriangle;
+        emitted[t] = true;
+        const uint32_t* triangle = &indices[t * 3];
+        result.insert(result.end(), triangle, triangle + 3);
+
+        for (int k = 0; k < 3; ++k) {
+            // 隣接リストから出力した三角形を取り除く
+            const uint32_t v = triangle[k];
+            uint32_t* begin = &adjacency[adjacencyOffsets[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* found = std::find(begin, end, static_cast<uint32_t>(t));
+            std::swap(*found, *(end - 1));
+            --remaining[v];
+        }
+
+        // --- キャッシュを更新する ---
+        nextCache.assign(triangle, triangle + 3);
+        for (uint32_t v : cache) {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                nextCache.push_back(v);
+            }
+        }
+        std::swap(cache, nextCache);
+
+        // --- キャッシュ内 (と追い出された) 頂点と、その三角形のスコアを更新する ---
+        float bestScore = -1.0f;
+        bool hasBest = false;
+        for (size_t i = 0; i < cache.size(); ++i) {
+            const uint32_t v = cache[i];
+            cachePositions[v] = i < static_cast<size_t>(kCacheSize) ? static_cast<int>(i) : -1;
+            vertexScores[v] = VertexScore(cachePositions[v], remaining[v]);
+        }
+        for (size_t i = 0; i < cache.size(); ++i) {
+            const uint32_t v = cache[i];
+            for (uint32_t a = 0; a < remaining[v]; ++a) {
+                const uint32_t adjacent = adjacency[adjacencyOffsets[v] + a];
+                const float score = vertexScores[indices[adjacent * 3]] + vertexScores[indices[adjacent * 3 + 1]] +
+                                    vertexScores[indices[adjacent * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = adjacent;
+                    hasBest = true;
+                }
+            }
+        }
+        if (cache.size() > static_cast<size_t>(kCacheSize)) {
+            cache.resize(kCacheSize);
+        }
+
+        // --- キャッシュ内に候補が無ければ、未出力の三角形から選ぶ ---
+        if (!hasBest && emittedCount + 1 < triangleCount) {
+            while (emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            bestTriangle = scanCursor;
+        }
+    }
+
+    indices = std::move(result);
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, std::span<const SubMesh> subMeshes) {
+    ForEachSubMeshRange(indices, subMeshes,
+                        [vertexCount](std::vector<uint32_t>& range) { OptimizeVertexCache(range, vertexCount); });
+}
+
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2) {
+        return;
+    }
+
+    // --- キャッシュが冷えた位置 (3頂点ともミス) でクラスタに区切る ---
+    // ここで区切っても、頂点キャッシュの効率はほとんど落ちない
+    std::vector<size_t> clusterStarts;
+    {
+        std::vector<uint32_t> timestamps(vertices.size(), 0);
+        uint32_t time = kStatsCacheSize + 1;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            uint32_t misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                if (time - timestamps[v] > kStatsCacheSize) {
+                    timestamps[v] = time++;
+                    ++misses;
+                }
+            }
+            if (t == 0 || misses == 3) {
+                clusterStarts.push_back(t);
+            }
+        }
+    }
+    if (clusterStarts.size() < 2) {
+        return;
+    }
+
+    // --- 各クラスタの面積で重み付けした中心と法線 ---
+    struct Cluster {
+        size_t start = 0;
+        size_t count = 0;
+        float sortKey = 0.0f;
+    };
+    std::vector<Cluster> clusters(clusterStarts.size());
+    std::vector<std::array<float, 7>> sums(clusterStarts.size()); // 面積, 中心xyz, 法線xyz
+    float meshCenter[3] = {};
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterStarts.size(); ++c) {
+        clusters[c].start = clusterStarts[c];
+        clusters[c].count = (c + 1 < clusterStarts.size() ? clusterStarts[c + 1] : triangleCount) - clusterStarts[c];
+
+        std::array<float, 7>& sum = sums[c];
+        sum.fill(0.0f);
+        for (size_t t = clusters[c].start; t < clusters[c].start + clusters[c].count; ++t) {
+            const VertexData& a = vertices[indices[t * 3]];
+            const VertexData& b = vertices[indices[t * 3 + 1]];
+            const VertexData& d = vertices[indices[t * 3 + 2]];
+            const float e1[3] = {b.position.x - a.position.x, b.position.y - a.position.y, b.position.z - a.position.z};
+            const float e2[3] = {d.position.x - a.position.x, d.position.y - a.position.y, d.position.z - a.position.z};
+            const float cross[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            const float area = 0.5f * std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+            sum[0] += area;
+            sum[1] += area * (a.position.x + b.position.x + d.position.x) / 3.0f;
+            sum[2] += area * (a.position.y + b.position.y + d.position.y) / 3.0f;
+            sum[3] += area * (a.position.z + b.position.z + d.position.z) / 3.0f;
+            // 向きは巻き順の規約に依存しないよう、頂点法線の平均から取る
+            sum[4] += area * (a.normal.x + b.normal.x + d.normal.x);
+            sum[5] += area * (a.normal.y + b.normal.y + d.normal.y);
+            sum[6] += area * (a.normal.z + b.normal.z + d.normal.z);
+        }
+        meshArea += sum[0];
+        meshCenter[0] += sum[1];
+        meshCenter[1] += sum[2];
+        meshCenter[2] += sum[3];
+    }
+    if (meshArea <= 0.0f) {
+        return;
+    }
+    for (float& value : meshCenter) {
+        value /= meshArea;
+    }
+
+    // 外側を向いているクラスタほど先に描く (後ろのクラスタが深度テストで弾かれやすくなる)
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        const std::array<float, 7>& sum = sums[c];
+        if (sum[0] <= 0.0f) {
+            continue;
+        }
+        const float offset[3] = {sum[1] / sum[0] - meshCenter[0], sum[2] / sum[0] - meshCenter[1], sum[3] / sum[0] - meshCenter[2]};
+        const float normalLength = std::sqrt(sum[4] * sum[4] + sum[5] * sum[5] + sum[6] * sum[6]);
+        if (normalLength > 0.0f) {
+            clusters[c].sortKey = (offset[0] * sum[4] + offset[1] * sum[5] + offset[2] * sum[6]) / normalLength;
+        }
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (const Cluster& cluster : clusters) {
+        result.insert(result.end(), indices.begin() + cluster.start * 3, indices.begin() + (cluster.start + cluster.count) * 3);
+    }
+    indices = std::move(result);
+}
+
+void OptimizeVertexFetch(ModelData& modelData) {
+    const uint32_t kUnused = UINT32_MAX;
+    const bool isSkinned = !modelData.influences.empty();
+    std::vector<uint32_t> remap(modelData.vertices.size(), kUnused);
+    std::vector<VertexData> vertices;
+    std::vector<VertexInfluence> influences;
+    vertices.reserve(modelData.vertices.size());
+
+    for (uint32_t& index : modelData.indices) {
+        if (remap[index] == kUnused) {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(modelData.vertices[index]);
+            if (isSkinned) {
+                influences.push_back(modelData.influences[index]);
+            }
+        }
+        index = remap[index];
+    }
+    modelData.vertices = std::move(vertices);
+    modelData.influences = std::move(influences);
+}
+
+void Optimize(ModelData& modelData, const std::string& name) {
+    if (modelData.indices.size() < 3) {
+        return;
+    }
+
+    const size_t sourceVertexCount = modelData.vertices.size();
+    const CacheStats before = AnalyzeVertexCache(modelData.indices, modelData.vertices.size());
+
+    WeldVertices(modelData);
+    OptimizeVertexCache(modelData.indices, modelData.vertices.size(), modelData.subMeshes);
+    const CacheStats afterCache = AnalyzeVertexCache(modelData.indices, modelData.vertices.size());
+    ForEachSubMeshRange(modelData.indices, modelData.subMeshes,
+                        [&modelData](std::vector<uint32_t>& range) { OptimizeOverdraw(range, modelData.vertices); });
+    OptimizeVertexFetch(modelData);
+    const CacheStats after = AnalyzeVertexCache(modelData.indices, modelData.vertices.size());
+
+    Logger::Log(std::format("INFO: Mesh optimized: {} (vertices {} -> {}, ACMR {:.3f} -> {:.3f} ({:.3f} before overdraw), ATVR {:.3f} -> {:.3f})\n",
+                            name, sourceVertexCount, modelData.vertices.size(), before.acmr, after.acmr,
+                            afterCache.acmr, before.atvr, after.atvr));
+}
+
+} // namespace MeshOptimizer
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// ============================================================
+// MeshOptimizer — インポート時のメッシュ最適化 (D3D12 を使わないのでワーカースレッドから呼べる)
+//   1. 重複頂点の結合 (全要素がビット単位で一致するもの)
+//   2. 頂点キャッシュ向けの三角形の並べ替え (Forsyth)
+//   3. オーバードロー向けのクラスタの並べ替え (Tipsy 方式: 外側を向いたクラスタを先に描く)
+//   4. 頂点フェッチ向けの頂点の並べ替え (インデックスで最初に参照される順)
+// サブメッシュがある場合、三角形の並べ替えはサブメッシュの範囲ごとに行い、頂点の結合もサブメッシュをまたがない
+// 結果は CookedMesh に保存されるので、最適化はキャッシュが無い初回だけ走る
+// ============================================================
+namespace MeshOptimizer {
+
+// 頂点キャッシュのシミュレーション結果
+struct CacheStats {
+    float acmr = 0.0f; // 三角形あたりの頂点シェーダー実行回数 (0.5 ～ 3.0、小さいほど良い)
+    float atvr = 0.0f; // 頂点あたりの頂点シェーダー実行回数 (1.0 が理想)
+};
+
+// 統計に使う FIFO キャッシュのサイズ (一般的なGPUの目安)
+static const uint32_t kStatsCacheSize = 16;
+
+/// <summary>
+/// FIFO キャッシュで頂点シェーダーの実行回数を見積もる
+/// </summary>
+CacheStats AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount,
+                              uint32_t cacheSize = kStatsCacheSize);
+
+/// <summary>
+/// 三角形をマテリアルの番号順に並べ (同じマテリアルの中では元の順)、サブメッシュの表を作る
+/// </summary>
+/// <param name="indices">三角形リスト (並べ替える)</param>
+/// <param name="triangleMaterials">三角形ごとのマテリアル番号</param>
+/// <param name="materialCount">マテリアル数</param>
+/// <returns>サブメッシュ (indices の先頭からの範囲。三角形の無いマテリアルは含まない)</returns>
+std::vector<SubMesh> GroupTriangles(std::vector<uint32_t>& indices, std::span<const uint32_t> triangleMaterials,
+                                    size_t materialCount);
+
+// 頂点ごとのマテリアル番号 (サブメッシュから求める。参照されない頂点は 0)
+std::vector<uint32_t> MapVerticesToMaterials(const ModelData& modelData);
+
+// 重複した頂点を1つにまとめ、インデックスを付け直す (別のサブメッシュの頂点・影響するジョイントが違う頂点とはまとめない)
+void WeldVertices(ModelData& modelData);
+
+// 頂点キャッシュのヒット率が上がるよう三角形を並べ替える
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+// サブメッシュの範囲ごとに頂点キャッシュ向けに並べ替える (範囲の外へ三角形を動かさない)
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, std::span<const SubMesh> subMeshes);
+
+// 頂点キャッシュ向けの並びを保ったまま、外側を向いたクラスタから描くよう並べ替える
+void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices);
+
+// インデックスで最初に参照される順に頂点を並べ替える (参照されない頂点は削除。influences も同じ順にする)
+void OptimizeVertexFetch(ModelData& modelData);
+
+/// <summary>
+/// 上記をすべて適用し、前後の ACMR/ATVR をログに出す
+/// LODを作る前に呼ぶこと (indices 全体を LOD0 として並べ替えるため)
+/// </summary>
+/// <param name="modelData">最適化するモデルデータ</param>
+/// <param name="name">ログに出す名前</param>
+void Optimize(ModelData& modelData, const std::string& name);
+
+} // namespace MeshOptimizer
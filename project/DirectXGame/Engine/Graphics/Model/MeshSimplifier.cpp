@@ -0,0 +1,651 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "Hash/HashUtility.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <utility>
+#include <unordered_map>
+
+namespace {
+
+// 境界の辺に沿った平面の重み (大きいほど境界の形が保たれる)
+constexpr double kBorderWeight = 10.0;
+// UVシームの辺に沿った平面の重み
+constexpr double kSeamWeight = 1.0;
+
+// 開いた辺が無い・複数ある場合の印
+constexpr uint32_t kNone = UINT32_MAX;
+constexpr uint32_t kMultiple = UINT32_MAX - 1;
+
+// LOD1 以降の目標 (LOD0 に対するインデックス数の割合と、メッシュの大きさに対する誤差の上限)
+struct LodTarget {
+    float indexRatio;
+    float relativeError;
+};
+constexpr LodTarget kLodTargets[MeshSimplifier::kMaxLodCount - 1] = {
+    {0.5f, 0.01f},
+    {0.25f, 0.03f},
+    {0.125f, 0.08f},
+};
+// 1つ前のLODよりこの割合までしか減らせなかったら、それ以上のLODは作らない
+constexpr float kMinLodReduction = 0.85f;
+
+enum VertexKind : uint8_t {
+    kManifold, // 内部の頂点 (どの隣接頂点にも縮約できる)
+    kBorder,   // 境界の頂点 (境界の辺に沿ってのみ縮約できる)
+    kSeam,     // UVシームの頂点 (シームの辺に沿って、対の頂点と一緒に縮約する)
+    kLocked,   // 接続が複雑なので動かさない頂点
+};
+
+Vector3 GetPosition(const VertexData& vertex) { return {vertex.position.x, vertex.position.y, vertex.position.z}; }
+Vector3 Sub(const Vector3& a, const Vector3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+Vector3 Cross(const Vector3& a, const Vector3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+float Dot(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+// 点から平面群までの二乗距離の和を表す二次形式 (桁落ちを避けるため double で持つ)
+struct Quadric {
+    double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+    double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+    double c = 0.0;
+    double weight = 0.0;
+
+    // 平面 dot(n, p) + d = 0 (n は単位ベクトル) を重み付きで加える
+    void AddPlane(const Vector3& n, float d, double w) {
+        a00 += w * n.x * n.x;
+        a11 += w * n.y * n.y;
+        a22 += w * n.z * n.z;
+        a01 += w * n.x * n.y;
+        a02 += w * n.x * n.z;
+        a12 += w * n.y * n.z;
+        b0 += w * n.x * d;
+        b1 += w * n.y * d;
+        b2 += w * n.z * d;
+        c += w * d * d;
+        weight += w;
+    }
+
+    void Add(const Quadric& other) {
+        a00 += other.a00;
+        a11 += other.a11;
+        a22 += other.a22;
+        a01 += other.a01;
+        a02 += other.a02;
+        a12 += other.a12;
+        b0 += other.b0;
+        b1 += other.b1;
+        b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+    }
+
+    // 点から平面までの二乗距離の重み付き平均
+    double Evaluate(const Vector3& p) const {
+        if (weight <= 0.0) {
+            return 0.0;
+        }
+        const double x = p.x, y = p.y, z = p.z;
+        const double q = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                         2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        return std::max(q, 0.0) / weight;
+    }
+};
+
+// 位置の重複判定用キー
+struct PositionKey {
+    float position[3];
+    bool operator==(const PositionKey& other) const {
+        return std::memcmp(position, other.position, sizeof(position)) == 0;
+    }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& key) const {
+        uint32_t bits[3];
+        std::memcpy(bits, key.position, sizeof(bits));
+        return (static_cast<size_t>(bits[0]) * 73856093u) ^ (static_cast<size_t>(bits[1]) * 19349663u) ^
+               (static_cast<size_t>(bits[2]) * 83492791u);
+    }
+};
+
+// 同じ位置の頂点を、代表頂点 (remap) と循環リスト (wedge) にまとめる
+void BuildPositionRemap(std::span<const VertexData> vertices, std::vector<uint32_t>& remap, std::vector<uint32_t>& wedge) {
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> positionMap;
+    positionMap.reserve(vertices.size());
+    remap.resize(vertices.size());
+    wedge.resize(vertices.size());
+    for (uint32_t v = 0; v < vertices.size(); ++v) {
+        // -0 と +0 を同じ位置として扱う
+        const PositionKey key{{vertices[v].position.x + 0.0f, vertices[v].position.y + 0.0f, vertices[v].position.z + 0.0f}};
+        auto [it, inserted] = positionMap.try_emplace(key, v);
+        remap[v] = it->second;
+        if (inserted) {
+            wedge[v] = v;
+        } else {
+            // 代表頂点の次に差し込む
+            wedge[v] = wedge[it->second];
+            wedge[it->second] = v;
+        }
+    }
+}
+
+// 頂点から出る辺と、位置に接する三角形の一覧
+struct Adjacency {
+    std::vector<uint32_t> edgeOffsets;     // 頂点ごとの開始位置 (頂点数+1)
+    std::vector<uint32_t> edgeTargets;     // 辺の終点
+    std::vector<uint32_t> triangleOffsets; // 代表頂点ごとの開始位置 (頂点数+1)
+    std::vector<uint32_t> triangles;       // 三角形番号
+
+    bool HasEdge(uint32_t a, uint32_t b) const {
+        for (uint32_t i = edgeOffsets[a]; i < edgeOffsets[a + 1]; ++i) {
+            if (edgeTargets[i] == b) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+void BuildAdjacency(std::span<const uint32_t> indices, const std::vector<uint32_t>& remap, Adjacency& adjacency) {
+    const size_t vertexCount = remap.size();
+    adjacency.edgeOffsets.assign(vertexCount + 1, 0);
+    adjacency.triangleOffsets.assign(vertexCount + 1, 0);
+    for (uint32_t index : indices) {
+        ++adjacency.edgeOffsets[index + 1];
+        ++adjacency.triangleOffsets[remap[index] + 1];
+    }
+    for (size_t v = 0; v < vertexCount; ++v) {
+        adjacency.edgeOffsets[v + 1] += adjacency.edgeOffsets[v];
+        adjacency.triangleOffsets[v + 1] += adjacency.triangleOffsets[v];
+    }
+
+    adjacency.edgeTargets.resize(indices.size());
+    adjacency.triangles.resize(indices.size());
+    std::vector<uint32_t> edgeFill(adjacency.edgeOffsets.begin(), adjacency.edgeOffsets.end() - 1);
+    std::vector<uint32_t> triangleFill(adjacency.triangleOffsets.begin(), adjacency.triangleOffsets.end() - 1);
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t a = indices[t * 3 + k];
+            const uint32_t b = indices[t * 3 + (k + 1) % 3];
+            adjacency.edgeTargets[edgeFill[a]++] = b;
+            adjacency.triangles[triangleFill[remap[a]]++] = static_cast<uint32_t>(t);
+        }
+    }
+}
+
+// 同じ位置のどれかの頂点同士に a→b の辺があるか
+bool HasPositionalEdge(const Adjacency& adjacency, const std::vector<uint32_t>& remap, const std::vector<uint32_t>& wedge,
+                       uint32_t a, uint32_t b) {
+    uint32_t w = a;
+    do {
+        for (uint32_t i = adjacency.edgeOffsets[w]; i < adjacency.edgeOffsets[w + 1]; ++i) {
+            if (remap[adjacency.edgeTargets[i]] == remap[b]) {
+                return true;
+            }
+        }
+        w = wedge[w];
+    } while (w != a);
+    return false;
+}
+
+// 縮約の可否を決めるための頂点の分類
+struct Classification {
+    std::vector<VertexKind> kinds;
+    std::vector<uint32_t> openIn;      // 逆向きの辺が無い、入ってくる辺の始点
+    std::vector<uint32_t> openOut;     // 逆向きの辺が無い、出ていく辺の終点
+    std::vector<uint32_t> seamPartner; // シームの対になる頂点
+};
+
+bool IsSingle(uint32_t value) { return value < kMultiple; }
+
+void ClassifyVertices(const Adjacency& adjacency, const std::vector<uint32_t>& remap, const std::vector<uint32_t>& wedge,
+                      Classification& result) {
+    const size_t vertexCount = remap.size();
+    result.kinds.assign(vertexCount, kLocked);
+    result.openIn.assign(vertexCount, kNone);
+    result.openOut.assign(vertexCount, kNone);
+    result.seamPartner.assign(vertexCount, kNone);
+
+    for (uint32_t a = 0; a < vertexCount; ++a) {
+        for (uint32_t i = adjacency.edgeOffsets[a]; i < adjacency.edgeOffsets[a + 1]; ++i) {
+            const uint32_t b = adjacency.edgeTargets[i];
+            if (!adjacency.HasEdge(b, a)) {
+                result.openOut[a] = result.openOut[a] == kNone ? b : kMultiple;
+                result.openIn[b] = result.openIn[b] == kNone ? a : kMultiple;
+            }
+        }
+    }
+
+    auto isLive = [&adjacency](uint32_t v) { return adjacency.edgeOffsets[v + 1] > adjacency.edgeOffsets[v]; };
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        if (!isLive(v)) {
+            continue;
+        }
+
+        // 同じ位置で使われている頂点を数える
+        uint32_t wedgeCount = 0;
+        uint32_t partner = kNone;
+        uint32_t w = v;
+        do {
+            if (isLive(w)) {
+                ++wedgeCount;
+                if (w != v) {
+                    partner = w;
+                }
+            }
+            w = wedge[w];
+        } while (w != v);
+
+        const uint32_t in = result.openIn[v];
+        const uint32_t out = result.openOut[v];
+        if (wedgeCount == 1) {
+            if (in == kNone && out == kNone) {
+                result.kinds[v] = kManifold;
+            } else if (IsSingle(in) && IsSingle(out) && !HasPositionalEdge(adjacency, remap, wedge, v, in) &&
+                       !HasPositionalEdge(adjacency, remap, wedge, out, v)) {
+                // 反対側に面が無い本当の境界 (シームの端点は反対側があるので動かさない)
+                result.kinds[v] = kBorder;
+            }
+        } else if (wedgeCount == 2 && IsSingle(in) && IsSingle(out) && IsSingle(result.openIn[partner]) &&
+                   IsSingle(result.openOut[partner]) && remap[out] == remap[result.openIn[partner]] &&
+                   remap[in] == remap[result.openOut[partner]]) {
+            // 両側の頂点が同じ位置の辺を逆向きに持っている = 1本のシーム
+            result.kinds[v] = kSeam;
+            result.seamPartner[v] = partner;
+        }
+    }
+}
+
+// v0 を v1 の位置へ縮約できるか (位相だけを見る)
+bool CanCollapse(const Classification& classification, uint32_t v0, uint32_t v1) {
+    const VertexKind kind = classification.kinds[v0];
+    if (kind == kManifold) {
+        return true;
+    }
+    if (kind == kBorder || kind == kSeam) {
+        // 同じ種類の頂点へ、境界 (シーム) の辺に沿ってのみ縮約する
+        return classification.kinds[v1] == kind &&
+               (classification.openOut[v0] == v1 || classification.openIn[v0] == v1);
+    }
+    return false;
+}
+
+// 位置 r0 を position へ動かしたときに、向きが反転する三角形があるか
+bool HasFlippedTriangle(std::span<const uint32_t> indices, std::span<const VertexData> vertices,
+                        const std::vector<uint32_t>& remap, const Adjacency& adjacency, uint32_t r0, uint32_t r1,
+                        const Vector3& position) {
+    for (uint32_t i = adjacency.triangleOffsets[r0]; i < adjacency.triangleOffsets[r0 + 1]; ++i) {
+        const uint32_t* triangle = &indices[adjacency.triangles[i] * 3];
+        Vector3 corners[3];
+        Vector3 moved[3];
+        bool isCollapsed = false;
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t r = remap[triangle[k]];
+            // 縮約する辺を含む三角形は消えるので調べなくてよい
+            isCollapsed = isCollapsed || r == r1;
+            corners[k] = GetPosition(vertices[triangle[k]]);
+            moved[k] = r == r0 ? position : corners[k];
+        }
+        if (isCollapsed) {
+            continue;
+        }
+        const Vector3 before = Cross(Sub(corners[1], corners[0]), Sub(corners[2], corners[0]));
+        const Vector3 after = Cross(Sub(moved[1], moved[0]), Sub(moved[2], moved[0]));
+        if (Dot(before, after) <= 0.0f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 面と、境界・シームの辺の二次誤差を位置ごとに集める
+void FillQuadrics(std::span<const uint32_t> indices, std::span<const VertexData> vertices, const std::vector<uint32_t>& remap,
+                  const std::vector<uint32_t>& wedge, const Adjacency& adjacency, std::vector<Quadric>& quadrics) {
+    quadrics.assign(vertices.size(), Quadric{});
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        const uint32_t* triangle = &indices[t * 3];
+        const Vector3 p[3] = {GetPosition(vertices[triangle[0]]), GetPosition(vertices[triangle[1]]),
+                              GetPosition(vertices[triangle[2]])};
+        const Vector3 cross = Cross(Sub(p[1], p[0]), Sub(p[2], p[0]));
+        const float length = std::sqrt(Dot(cross, cross));
+        if (length == 0.0f) {
+            continue;
+        }
+        const Vector3 normal = {cross.x / length, cross.y / length, cross.z / length};
+        const double area = 0.5 * length;
+        for (int k = 0; k < 3; ++k) {
+            quadrics[remap[triangle[k]]].AddPlane(normal, -Dot(normal, p[0]), area);
+        }
+
+        // 逆向きの辺が無い辺には、辺を通り面に垂直な平面を加えて形を保つ
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t a = triangle[k];
+            const uint32_t b = triangle[(k + 1) % 3];
+            if (adjacency.HasEdge(b, a)) {
+                continue;
+            }
+            const bool isBorder = !HasPositionalEdge(adjacency, remap, wedge, b, a);
+            const Vector3 edge = Sub(p[(k + 1) % 3], p[k]);
+            const Vector3 planeCross = Cross(edge, normal);
+            const float planeLength = std::sqrt(Dot(planeCross, planeCross));
+            if (planeLength == 0.0f) {
+                continue;
+            }
+            const Vector3 planeNormal = {planeCross.x / planeLength, planeCross.y / planeLength, planeCross.z / planeLength};
+            const double weight = Dot(edge, edge) * (isBorder ? kBorderWeight : kSeamWeight);
+            quadrics[remap[a]].AddPlane(planeNormal, -Dot(planeNormal, p[k]), weight);
+            quadrics[remap[b]].AddPlane(planeNormal, -Dot(planeNormal, p[k]), weight);
+        }
+    }
+}
+
+// 縮約の候補
+struct Collapse {
+    uint32_t from;
+    uint32_t to;
+    float error;
+};
+
+// 法線だけが違う頂点をまとめるためのキー (位置・UV・マテリアル・スキンの影響が同じもの)
+struct WeldKey {
+    float values[5];
+    uint32_t material;
+    VertexInfluence influence;
+    bool operator==(const WeldKey& other) const { return std::memcmp(this, &other, sizeof(WeldKey)) == 0; }
+};
+
+struct WeldKeyHash {
+    size_t operator()(const WeldKey& key) const { return static_cast<size_t>(HashUtility::HashBytes(&key, sizeof(key))); }
+};
+
+// 法線だけが違う頂点の組 (フラットシェーディングで面ごとに分かれた頂点など)
+struct NormalGroups {
+    std::vector<uint32_t> representative; // 組の代表頂点
+    std::vector<uint32_t> next;           // 組の中の次の頂点 (循環リスト)
+};
+
+NormalGroups BuildNormalGroups(const ModelData& modelData, const std::vector<uint32_t>& vertexMaterials) {
+    const size_t vertexCount = modelData.vertices.size();
+    const bool isSkinned = !modelData.influences.empty();
+    std::unordered_map<WeldKey, uint32_t, WeldKeyHash> groupMap;
+    groupMap.reserve(vertexCount);
+
+    NormalGroups groups;
+    groups.representative.resize(vertexCount);
+    groups.next.resize(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        const VertexData& vertex = modelData.vertices[v];
+        WeldKey key{};
+        // -0 と +0 を同じ値として扱う
+        const float values[5] = {vertex.position.x + 0.0f, vertex.position.y + 0.0f, vertex.position.z + 0.0f,
+                                 vertex.texcoord.x + 0.0f, vertex.texcoord.y + 0.0f};
+        std::memcpy(key.values, values, sizeof(values));
+        key.material = vertexMaterials[v];
+        key.influence = isSkinned ? modelData.influences[v] : VertexInfluence{};
+
+        auto [it, inserted] = groupMap.try_emplace(key, v);
+        groups.representative[v] = it->second;
+        if (inserted) {
+            groups.next[v] = v;
+        } else {
+            groups.next[v] = groups.next[it->second];
+            groups.next[it->second] = v;
+        }
+    }
+    return groups;
+}
+
+// 三角形の各頂点を、組の中で法線が面の向きに最も近い頂点に置き換える (フラットシェーディングの見た目を保つ)
+void RestoreNormals(std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices, const NormalGroups& groups) {
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        uint32_t* triangle = &indices[t * 3];
+        const Vector3 p0 = GetPosition(vertices[triangle[0]]);
+        const Vector3 faceNormal =
+            Cross(Sub(GetPosition(vertices[triangle[1]]), p0), Sub(GetPosition(vertices[triangle[2]]), p0));
+        if (Dot(faceNormal, faceNormal) == 0.0f) {
+            continue;
+        }
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t first = triangle[k];
+            uint32_t best = first;
+            float bestDot = Dot(vertices[first].normal, faceNormal);
+            for (uint32_t v = groups.next[first]; v != first; v = groups.next[v]) {
+                const float dot = Dot(vertices[v].normal, faceNormal);
+                if (dot > bestDot) {
+                    best = v;
+                    bestDot = dot;
+                }
+            }
+            triangle[k] = best;
+        }
+    }
+}
+
+} // namespace
+
+namespace MeshSimplifier {
+
+std::vector<uint32_t> Simplify(std::span<const uint32_t> indices, std::span<const VertexData> vertices,
+                               size_t targetIndexCount, float targetError, float* resultError) {
+    std::vector<uint32_t> remap;
+    std::vector<uint32_t> wedge;
+    BuildPositionRemap(vertices, remap, wedge);
+
+    // 位置が重なって潰れている三角形は最初に取り除く
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (size_t t = 0; t < indices.size() / 3; ++t) {
+        const uint32_t r0 = remap[indices[t * 3]];
+        const uint32_t r1 = remap[indices[t * 3 + 1]];
+        const uint32_t r2 = remap[indices[t * 3 + 2]];
+        if (r0 != r1 && r1 != r2 && r2 != r0) {
+            result.insert(result.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+        }
+    }
+
+    float maxError = 0.0f;
+    Adjacency adjacency;
+    Classification classification;
+    std::vector<Quadric> quadrics;
+    BuildAdjacency(result, remap, adjacency);
+    FillQuadrics(result, vertices, remap, wedge, adjacency, quadrics);
+
+    std::vector<Collapse> candidates;
+    std::vector<uint32_t> collapseTarget(vertices.size());
+    std::vector<uint8_t> locked(vertices.size());
+    while (result.size() > targetIndexCount) {
+        BuildAdjacency(result, remap, adjacency);
+        ClassifyVertices(adjacency, remap, wedge, classification);
+
+        // --- 縮約の候補と誤差 ---
+        candidates.clear();
+        for (size_t i = 0; i < result.size(); ++i) {
+            const uint32_t a = result[i];
+            const uint32_t b = result[i - i % 3 + (i % 3 + 1) % 3];
+            // 内部の辺は両側の三角形に現れるので、片方からだけ取る
+            if (a > b && adjacency.HasEdge(b, a)) {
+                continue;
+            }
+            for (const auto& [from, to] : {std::pair{a, b}, std::pair{b, a}}) {
+                if (!CanCollapse(classification, from, to)) {
+                    continue;
+                }
+                const float error = static_cast<float>(
+                    std::sqrt(quadrics[remap[from]].Evaluate(GetPosition(vertices[to]))));
+                if (error <= targetError) {
+                    candidates.push_back({from, to, error});
+                }
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+        // --- 誤差の小さい順に、互いに影響しない縮約だけを選ぶ ---
+        for (uint32_t v = 0; v < vertices.size(); ++v) {
+            collapseTarget[v] = v;
+        }
+        std::fill(locked.begin(), locked.end(), uint8_t{0});
+        // 1回の縮約でおよそ2つの三角形が消える
+        const size_t triangleGoal = (result.size() - targetIndexCount) / 3;
+        size_t removedTriangles = 0;
+        size_t collapseCount = 0;
+        for (const Collapse& collapse : candidates) {
+            if (removedTriangles >= triangleGoal) {
+                break;
+            }
+            const uint32_t r0 = remap[collapse.from];
+            const uint32_t r1 = remap[collapse.to];
+            if (locked[r0] || locked[r1]) {
+                continue;
+            }
+            if (HasFlippedTriangle(result, vertices, remap, adjacency, r0, r1, GetPosition(vertices[collapse.to]))) {
+                continue;
+            }
+
+            collapseTarget[collapse.from] = collapse.to;
+            if (classification.kinds[collapse.from] == kSeam) {
+                // 対の頂点も、シームの反対側の同じ位置へ縮約する
+                const uint32_t partner = classification.seamPartner[collapse.from];
+                const uint32_t partnerTarget = classification.openOut[collapse.from] == collapse.to
+                                                   ? classification.openIn[partner]
+                                                   : classification.openOut[partner];
+                collapseTarget[partner] = partnerTarget;
+            }
+
+            // 周りの三角形が同じパスで別の縮約に変えられないよう、1リング全体をロックする
+            for (uint32_t i = adjacency.triangleOffsets[r0]; i < adjacency.triangleOffsets[r0 + 1]; ++i) {
+                const uint32_t* triangle = &result[adjacency.triangles[i] * 3];
+                for (int k = 0; k < 3; ++k) {
+                    locked[remap[triangle[k]]] = 1;
+                }
+            }
+            locked[r1] = 1;
+
+            quadrics[r1].Add(quadrics[r0]);
+            maxError = std::max(maxError, collapse.error);
+            removedTriangles += classification.kinds[collapse.from] == kBorder ? 1 : 2;
+            ++collapseCount;
+        }
+        if (collapseCount == 0) {
+            break;
+        }
+
+        // --- インデックスを付け替え、潰れた三角形を取り除く ---
+        size_t writeCursor = 0;
+        for (size_t t = 0; t < result.size() / 3; ++t) {
+            const uint32_t a = collapseTarget[result[t * 3]];
+            const uint32_t b = collapseTarget[result[t * 3 + 1]];
+            const uint32_t c = collapseTarget[result[t * 3 + 2]];
+            if (remap[a] != remap[b] && remap[b] != remap[c] && remap[c] != remap[a]) {
+                result[writeCursor++] = a;
+                result[writeCursor++] = b;
+                result[writeCursor++] = c;
+            }
+        }
+        result.resize(writeCursor);
+    }
+
+    if (resultError) {
+        *resultError = maxError;
+    }
+    return result;
+}
+
+float ComputeMeshScale(std::span<const VertexData> vertices) {
+    if (vertices.empty()) {
+        return 0.0f;
+    }
+    Vector3 minPosition = GetPosition(vertices[0]);
+    Vector3 maxPosition = minPosition;
+    for (const VertexData& vertex : vertices) {
+        minPosition = {std::min(minPosition.x, vertex.position.x), std::min(minPosition.y, vertex.position.y),
+                       std::min(minPosition.z, vertex.position.z)};
+        maxPosition = {std::max(maxPosition.x, vertex.position.x), std::max(maxPosition.y, vertex.position.y),
+                       std::max(maxPosition.z, vertex.position.z)};
+    }
+    const Vector3 extent = Sub(maxPosition, minPosition);
+    return 0.5f * std::sqrt(Dot(extent, extent));
+}
+
+void BuildLodChain(ModelData& modelData, const std::string& name) {
+    modelData.lods.clear();
+    if (modelData.indices.size() < 3) {
+        return;
+    }
+    const uint32_t lod0IndexCount = static_cast<uint32_t>(modelData.indices.size());
+    modelData.lods.push_back({0, lod0IndexCount, 0.0f, 0, static_cast<uint32_t>(modelData.subMeshes.size())});
+    // サブメッシュ同士は頂点を共有せず、縮約も同じサブメッシュの頂点へ行うので、簡略化後も頂点からマテリアルが分かる
+    const std::vector<uint32_t> vertexMaterials = MeshOptimizer::MapVerticesToMaterials(modelData);
+    std::vector<uint32_t> triangleMaterials;
+
+    // 法線だけが違う頂点は、簡略化の間は代表頂点1つにまとめる
+    // (フラットシェーディングのメッシュは同じ位置に面の数だけ頂点があり、そのままでは全頂点が縮約できない頂点として固定される)
+    const NormalGroups normalGroups = BuildNormalGroups(modelData, vertexMaterials);
+
+    // 各LODは1つ前のLODから作る (三角形が半分ずつ減るので、LOD0 から作るより速い)
+    // 誤差は前のLODの誤差に足していくので、LOD0 からの誤差の上限になる
+    std::vector<uint32_t> previous(modelData.indices.size());
+    for (size_t i = 0; i < previous.size(); ++i) {
+        previous[i] = normalGroups.representative[modelData.indices[i]];
+    }
+    const float scale = ComputeMeshScale(modelData.vertices);
+    for (const LodTarget& target : kLodTargets) {
+        const MeshLod previousLod = modelData.lods.back();
+        const auto startTime = std::chrono::steady_clock::now();
+        const size_t targetIndexCount = static_cast<size_t>(lod0IndexCount * target.indexRatio) / 3 * 3;
+        const float errorLimit = std::max(target.relativeError * scale - previousLod.error, 0.0f);
+        float error = 0.0f;
+        std::vector<uint32_t> welded = Simplify(previous, modelData.vertices, targetIndexCount, errorLimit, &error);
+        error += previousLod.error;
+        const double milliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        const uint32_t previousIndexCount = previousLod.indexCount;
+        if (welded.empty() || welded.size() > previousIndexCount * kMinLodReduction) {
+            Logger::Log(std::format("INFO: Mesh LOD{} skipped: {} (only {} -> {} triangles within error {:.2f}%, {:.2f} ms)\n",
+                                    modelData.lods.size(), name, previousIndexCount / 3, welded.size() / 3,
+                                    target.relativeError * 100.0f, milliseconds));
+            break;
+        }
+        std::vector<uint32_t> indices = welded;
+        RestoreNormals(indices, modelData.vertices, normalGroups);
+
+        // LODごとにマテリアルでまとめ直し、頂点キャッシュ向けに並べ替える (頂点の並びは LOD0 のまま)
+        std::vector<SubMesh> subMeshes;
+        if (!modelData.subMeshes.empty()) {
+            triangleMaterials.resize(indices.size() / 3);
+            for (size_t t = 0; t < triangleMaterials.size(); ++t) {
+                triangleMaterials[t] = vertexMaterials[indices[t * 3]];
+            }
+            subMeshes = MeshOptimizer::GroupTriangles(indices, triangleMaterials, modelData.materials.size());
+        }
+        MeshOptimizer::OptimizeVertexCache(indices, modelData.vertices.size(), subMeshes);
+
+        const MeshLod lod = {static_cast<uint32_t>(modelData.indices.size()), static_cast<uint32_t>(indices.size()), error,
+                             static_cast<uint32_t>(modelData.subMeshes.size()), static_cast<uint32_t>(subMeshes.size())};
+        for (SubMesh& subMesh : subMeshes) {
+            subMesh.indexOffset += lod.indexOffset;
+            modelData.subMeshes.push_back(subMesh);
+        }
+        modelData.indices.insert(modelData.indices.end(), indices.begin(), indices.end());
+        modelData.lods.push_back(lod);
+        previous = std::move(welded);
+
+        Logger::Log(std::format("INFO: Mesh LOD{}: {} (triangles {} -> {} ({:.0f}%), error {:.4g} ({:.3f}% of size), "
+                                "{:.2f} ms, {:.0f} ktri/s)\n",
+                                modelData.lods.size() - 1, name, lod0IndexCount / 3, lod.indexCount / 3,
+                                100.0 * lod.indexCount / lod0IndexCount, error, scale > 0.0f ? 100.0f * error / scale : 0.0f,
+                                milliseconds, milliseconds > 0.0 ? previousIndexCount / 3 / milliseconds : 0.0));
+    }
+}
+
+} // namespace MeshSimplifier
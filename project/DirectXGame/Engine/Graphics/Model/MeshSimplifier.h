@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// ============================================================
+// MeshSimplifier — 二次誤差 (QEM) による辺の縮約でLODを作る (D3D12 を使わないのでワーカースレッドから呼べる)
+//   ・頂点は元の頂点の位置に縮約する (新しい頂点を作らないので、全LODで頂点バッファを共有できる)
+//   ・メッシュの境界とUVシーム (同じ位置で属性が違う頂点) は、その辺に沿った縮約しか許さない
+//     サブメッシュの境界も頂点が分かれているのでシームとして扱われ、マテリアルの境目の形が保たれる
+//   ・BuildLodChain では法線だけが違う頂点 (フラットシェーディングなど) をシームとして扱わず1つにまとめて縮約し、
+//     結果の三角形には、同じ位置の頂点のうち法線が面の向きに最も近いものを選び直す
+//   ・面の向きが反転する縮約は行わない
+// 結果は CookedMesh に保存されるので、LODの生成はキャッシュが無い初回だけ走る
+// ============================================================
+namespace MeshSimplifier {
+
+// LOD0 を含めたLODの最大数
+static const uint32_t kMaxLodCount = 4;
+
+/// <summary>
+/// 目標のインデックス数まで簡略化する
+/// 誤差が targetError を超える縮約が必要になった時点で止まるので、目標より多く残ることがある
+/// </summary>
+/// <param name="indices">元のインデックス (三角形リスト)</param>
+/// <param name="vertices">頂点 (結果のインデックスもこの頂点を参照する)</param>
+/// <param name="targetIndexCount">目標のインデックス数</param>
+/// <param name="targetError">許容する誤差 (モデル空間の距離)</param>
+/// <param name="resultError">実際の誤差の書き込み先 (nullptr 可)</param>
+/// <returns>簡略化したインデックス</returns>
+std::vector<uint32_t> Simplify(std::span<const uint32_t> indices, std::span<const VertexData> vertices,
+                               size_t targetIndexCount, float targetError, float* resultError = nullptr);
+
+// 頂点の広がり (AABB の対角線の半分)。誤差の上限はこれに対する割合で決める
+float ComputeMeshScale(std::span<const VertexData> vertices);
+
+/// <summary>
+/// LOD1 以降を作って indices の後ろに連結し、lods に範囲を書き込む
+/// サブメッシュがある場合は、LODごとにマテリアルでまとめ直したサブメッシュを subMeshes の後ろに追加する
+/// 各LODの三角形数・誤差・かかった時間をログに出す
+/// </summary>
+/// <param name="modelData">LOD0 だけを持つモデルデータ</param>
+/// <param name="name">ログに出す名前</param>
+void BuildLodChain(ModelData& modelData, const std::string& name);
+
+} // namespace MeshSimplifier
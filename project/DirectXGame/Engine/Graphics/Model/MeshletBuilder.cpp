@@ -0,0 +1,277 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+// メッシュレットにまだ入っていない頂点の印
+constexpr uint8_t kNotInMeshlet = 0xFF;
+// 法線の開きが大きすぎる (軸との内積の最小値がこれ以下) 場合は、裏面カリングの対象にしない
+constexpr float kMinConeDot = 0.1f;
+
+Vector3 GetPosition(const VertexData& vertex) { return {vertex.position.x, vertex.position.y, vertex.position.z}; }
+Vector3 Sub(const Vector3& a, const Vector3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+Vector3 Cross(const Vector3& a, const Vector3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+float Dot(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+// 位置だけで頂点を区別するキー (法線・UVの違いで分かれた頂点をつなげて隣接を求める)
+struct PositionKey {
+    float position[3];
+    bool operator==(const PositionKey& other) const {
+        return std::memcmp(position, other.position, sizeof(position)) == 0;
+    }
+};
+
+struct PositionKeyHash {
+    size_t operator()(const PositionKey& key) const {
+        uint32_t bits[3];
+        std::memcpy(bits, key.position, sizeof(bits));
+        return (static_cast<size_t>(bits[0]) * 73856093u) ^ (static_cast<size_t>(bits[1]) * 19349663u) ^
+               (static_cast<size_t>(bits[2]) * 83492791u);
+    }
+};
+
+// 同じ位置の頂点を最初に現れた頂点の番号にまとめる
+std::vector<uint32_t> BuildPositionRemap(std::span<const VertexData> vertices) {
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> positionMap;
+    positionMap.reserve(vertices.size());
+    std::vector<uint32_t> remap(vertices.size());
+    for (uint32_t v = 0; v < vertices.size(); ++v) {
+        // -0 と +0 を同じ位置として扱う
+        const PositionKey key{{vertices[v].position.x + 0.0f, vertices[v].position.y + 0.0f, vertices[v].position.z + 0.0f}};
+        remap[v] = positionMap.try_emplace(key, v).first->second;
+    }
+    return remap;
+}
+
+// 完成したメッシュレットの包む球と法線の円錐を求める
+void ComputeBounds(Meshlet& meshlet, const MeshletData& data, std::span<const VertexData> vertices) {
+    // --- 球: AABB の中心から最も遠い頂点まで ---
+    const uint32_t* meshletVertices = &data.vertices[meshlet.vertexOffset];
+    Vector3 minPosition = GetPosition(vertices[meshletVertices[0]]);
+    Vector3 maxPosition = minPosition;
+    for (uint32_t i = 1; i < meshlet.vertexCount; ++i) {
+        const Vector3 position = GetPosition(vertices[meshletVertices[i]]);
+        minPosition = {std::min(minPosition.x, position.x), std::min(minPosition.y, position.y),
+                       std::min(minPosition.z, position.z)};
+        maxPosition = {std::max(maxPosition.x, position.x), std::max(maxPosition.y, position.y),
+                       std::max(maxPosition.z, position.z)};
+    }
+    meshlet.center = {(minPosition.x + maxPosition.x) * 0.5f, (minPosition.y + maxPosition.y) * 0.5f,
+                      (minPosition.z + maxPosition.z) * 0.5f};
+    float radiusSq = 0.0f;
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+        const Vector3 offset = Sub(GetPosition(vertices[meshletVertices[i]]), meshlet.center);
+        radiusSq = std::max(radiusSq, Dot(offset, offset));
+    }
+    meshlet.radius = std::sqrt(radiusSq);
+
+    // --- 円錐: 面法線の平均を軸にし、軸から最も離れた法線で開きを決める ---
+    // 面法線は巻き順から求める (表面は時計回りなので cross(b - a, c - a) が表向き)
+    Vector3 normals[MeshletBuilder::kMaxTriangles];
+    uint32_t normalCount = 0;
+    Vector3 normalSum = {0.0f, 0.0f, 0.0f};
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+        const uint8_t* triangle = &data.triangles[meshlet.triangleOffset + t * 3];
+        const Vector3 a = GetPosition(vertices[meshletVertices[triangle[0]]]);
+        const Vector3 b = GetPosition(vertices[meshletVertices[triangle[1]]]);
+        const Vector3 c = GetPosition(vertices[meshletVertices[triangle[2]]]);
+        const Vector3 cross = Cross(Sub(b, a), Sub(c, a));
+        const float length = std::sqrt(Dot(cross, cross));
+        if (length == 0.0f) {
+            continue;
+        }
+        const Vector3 normal = {cross.x / length, cross.y / length, cross.z / length};
+        normals[normalCount++] = normal;
+        normalSum = {normalSum.x + normal.x, normalSum.y + normal.y, normalSum.z + normal.z};
+    }
+
+    meshlet.coneAxis = {0.0f, 0.0f, 0.0f};
+    meshlet.coneCutoff = 1.0f;
+    const float axisLength = std::sqrt(Dot(normalSum, normalSum));
+    if (normalCount == 0 || axisLength == 0.0f) {
+        return;
+    }
+    meshlet.coneAxis = {normalSum.x / axisLength, normalSum.y / axisLength, normalSum.z / axisLength};
+    float minDot = 1.0f;
+    for (uint32_t i = 0; i < normalCount; ++i) {
+        minDot = std::min(minDot, Dot(meshlet.coneAxis, normals[i]));
+    }
+    if (minDot > kMinConeDot) {
+        // 視線と軸のなす角が 90° - 半角 より小さければ、すべての面が裏を向いている
+        meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+} // namespace
+
+namespace MeshletBuilder {
+
+MeshletData Build(std::span<const uint32_t> indices, std::span<const VertexData> vertices, uint32_t maxVertices,
+                  uint32_t maxTriangles) {
+    assert(maxVertices >= 3 && maxVertices <= kMaxVertices);
+    assert(maxTriangles >= 1 && maxTriangles <= kMaxTriangles);
+
+    MeshletData data;
+    data.groupOffsets = {0, 0};
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return data;
+    }
+
+    // --- 位置ごとの隣接三角形リスト ---
+    // フラットシェーディングのメッシュは三角形ごとに頂点が別なので、頂点番号ではなく位置でつなぐ
+    const std::vector<uint32_t> remap = BuildPositionRemap(vertices);
+    std::vector<uint32_t> adjacencyOffsets(vertices.size() + 1, 0);
+    for (uint32_t index : indices) {
+        ++adjacencyOffsets[remap[index] + 1];
+    }
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[remap[indices[t * 3 + k]]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    // --- 三角形の中心 ---
+    std::vector<Vector3> centroids(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const Vector3 a = GetPosition(vertices[indices[t * 3]]);
+        const Vector3 b = GetPosition(vertices[indices[t * 3 + 1]]);
+        const Vector3 c = GetPosition(vertices[indices[t * 3 + 2]]);
+        centroids[t] = {(a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f};
+    }
+
+    std::vector<uint8_t> localIndices(vertices.size(), kNotInMeshlet);
+    std::vector<bool> emitted(triangleCount, false);
+    // 候補に入れたメッシュレットの番号 (同じ三角形を2回入れないため)
+    std::vector<uint32_t> candidateStamps(triangleCount, UINT32_MAX);
+    std::vector<uint32_t> candidates;
+    size_t emittedCount = 0;
+    size_t scanCursor = 0; // 新しいメッシュレットの起点を探す位置 (入力の順に空間的なまとまりがある前提)
+
+    while (emittedCount < triangleCount) {
+        while (emitted[scanCursor]) {
+            ++scanCursor;
+        }
+
+        const uint32_t meshletIndex = static_cast<uint32_t>(data.meshlets.size());
+        Meshlet meshlet;
+        meshlet.vertexOffset = static_cast<uint32_t>(data.vertices.size());
+        meshlet.triangleOffset = static_cast<uint32_t>(data.triangles.size());
+        Vector3 centroidSum = {0.0f, 0.0f, 0.0f};
+        candidates.clear();
+
+        size_t next = scanCursor;
+        while (true) {
+            // --- 三角形を追加する ---
+            emitted[next] = true;
+            ++emittedCount;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices[next * 3 + k];
+                if (localIndices[v] == kNotInMeshlet) {
+                    localIndices[v] = static_cast<uint8_t>(meshlet.vertexCount++);
+                    data.vertices.push_back(v);
+                }
+                data.triangles.push_back(localIndices[v]);
+            }
+            ++meshlet.triangleCount;
+            centroidSum = {centroidSum.x + centroids[next].x, centroidSum.y + centroids[next].y,
+                           centroidSum.z + centroids[next].z};
+            if (meshlet.triangleCount == maxTriangles) {
+                break;
+            }
+
+            // --- 追加した三角形の頂点に隣接する三角形を候補にする ---
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = remap[indices[next * 3 + k]];
+                for (uint32_t i = adjacencyOffsets[v]; i < adjacencyOffsets[v + 1]; ++i) {
+                    const uint32_t adjacent = adjacency[i];
+                    if (!emitted[adjacent] && candidateStamps[adjacent] != meshletIndex) {
+                        candidateStamps[adjacent] = meshletIndex;
+                        candidates.push_back(adjacent);
+                    }
+                }
+            }
+
+            // --- 新しい頂点が少なく、メッシュレットの中心に近い候補を選ぶ ---
+            // 頂点数は増える一方なので、入らなくなった候補はこのメッシュレットでは二度と使えない
+            const float inverseCount = 1.0f / static_cast<float>(meshlet.triangleCount);
+            const Vector3 center = {centroidSum.x * inverseCount, centroidSum.y * inverseCount,
+                                    centroidSum.z * inverseCount};
+            size_t best = triangleCount;
+            uint32_t bestNewVertices = 4;
+            float bestDistanceSq = std::numeric_limits<float>::max();
+            for (size_t i = 0; i < candidates.size();) {
+                const uint32_t t = candidates[i];
+                uint32_t newVertices = 0;
+                for (int k = 0; k < 3; ++k) {
+                    newVertices += localIndices[indices[t * 3 + k]] == kNotInMeshlet ? 1 : 0;
+                }
+                if (emitted[t] || meshlet.vertexCount + newVertices > maxVertices) {
+                    candidates[i] = candidates.back();
+                    candidates.pop_back();
+                    continue;
+                }
+                const Vector3 offset = Sub(centroids[t], center);
+                const float distanceSq = Dot(offset, offset);
+                if (newVertices < bestNewVertices || (newVertices == bestNewVertices && distanceSq < bestDistanceSq)) {
+                    best = t;
+                    bestNewVertices = newVertices;
+                    bestDistanceSq = distanceSq;
+                }
+                ++i;
+            }
+            if (best == triangleCount) {
+                break;
+            }
+            next = best;
+        }
+
+        // 次のメッシュレットのために頂点の印を戻す
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+            localIndices[data.vertices[meshlet.vertexOffset + i]] = kNotInMeshlet;
+        }
+        ComputeBounds(meshlet, data, vertices);
+        data.meshlets.push_back(meshlet);
+    }
+    data.groupOffsets[1] = static_cast<uint32_t>(data.meshlets.size());
+    return data;
+}
+
+MeshletData Build(std::span<const uint32_t> indices, std::span<const VertexData> vertices,
+                  std::span<const SubMesh> subMeshes) {
+    MeshletData data;
+    data.groupOffsets.push_back(0);
+    for (const SubMesh& subMesh : subMeshes) {
+        const MeshletData group = Build(indices.subspan(subMesh.indexOffset, subMesh.indexCount), vertices);
+
+        // 配列の開始位置をずらして後ろにつなげる
+        const uint32_t vertexBase = static_cast<uint32_t>(data.vertices.size());
+        const uint32_t triangleBase = static_cast<uint32_t>(data.triangles.size());
+        for (Meshlet meshlet : group.meshlets) {
+            meshlet.vertexOffset += vertexBase;
+            meshlet.triangleOffset += triangleBase;
+            data.meshlets.push_back(meshlet);
+        }
+        data.vertices.insert(data.vertices.end(), group.vertices.begin(), group.vertices.end());
+        data.triangles.insert(data.triangles.end(), group.triangles.begin(), group.triangles.end());
+        data.groupOffsets.push_back(static_cast<uint32_t>(data.meshlets.size()));
+    }
+    return data;
+}
+
+} // namespace MeshletBuilder
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ============================================================
+// MeshletBuilder — メッシュを小さなクラスタ (メッシュレット) に分ける (D3D12 を使わないのでワーカースレッドから呼べる)
+//   ・1つのメッシュレットは最大 64 頂点 / 124 三角形
+//   ・位置を共有する三角形を、新しい頂点が少なく中心に近い順に集めるので、まとまった形になる
+//   ・メッシュレットごとに包む球と法線の円錐を持ち、ClusterCuller で視錐台・裏面カリングに使う
+// ============================================================
+
+// メッシュレット1つ分
+struct Meshlet {
+    uint32_t vertexOffset = 0;   // MeshletData::vertices 内の開始位置
+    uint32_t triangleOffset = 0; // MeshletData::triangles 内の開始位置 (3つで1三角形)
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+
+    // 頂点を包む球 (モデル空間)
+    Vector3 center = {0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;
+
+    // 面法線の円錐 (coneCutoff = sin(円錐の半角)。1 の場合は裏面カリングしない)
+    Vector3 coneAxis = {0.0f, 0.0f, 0.0f};
+    float coneCutoff = 1.0f;
+};
+
+// メッシュ全体のメッシュレット
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices; // メッシュレット内の頂点番号 → 元の頂点番号
+    std::vector<uint8_t> triangles; // メッシュレット内の頂点番号 (3つで1三角形)
+    // グループ (サブメッシュ) ごとのメッシュレットの範囲 (groupOffsets[i] ～ groupOffsets[i + 1])
+    std::vector<uint32_t> groupOffsets;
+};
+
+namespace MeshletBuilder {
+
+// メッシュレットの上限 (メッシュシェーダーの出力上限の目安に合わせる)
+static const uint32_t kMaxVertices = 64;
+static const uint32_t kMaxTriangles = 124;
+
+/// <summary>
+/// 三角形リストをメッシュレットに分ける
+/// </summary>
+/// <param name="indices">三角形リスト</param>
+/// <param name="vertices">頂点 (包む球と法線の円錐の計算に使う)</param>
+/// <param name="maxVertices">1メッシュレットの最大頂点数 (kMaxVertices 以下)</param>
+/// <param name="maxTriangles">1メッシュレットの最大三角形数 (kMaxTriangles 以下)</param>
+/// <returns>メッシュレット</returns>
+MeshletData Build(std::span<const uint32_t> indices, std::span<const VertexData> vertices,
+                  uint32_t maxVertices = kMaxVertices, uint32_t maxTriangles = kMaxTriangles);
+
+/// <summary>
+/// サブメッシュごとにメッシュレットに分ける (1つのメッシュレットが複数のサブメッシュにまたがらない)
+/// </summary>
+/// <param name="indices">インデックス (サブメッシュの範囲はこの先頭から)</param>
+/// <param name="vertices">頂点</param>
+/// <param name="subMeshes">分けるサブメッシュ (この順にグループになる)</param>
+/// <returns>メッシュレット</returns>
+MeshletData Build(std::span<const uint32_t> indices, std::span<const VertexData> vertices,
+                  std::span<const SubMesh> subMeshes);
+
+} // namespace MeshletBuilder
@@ -1,6 +1,15 @@
 #define NOMINMAX
 
 #include "Model.h"
+#include "PrimitiveMesh.h"
+#include "CookedMesh.h"
+#include "MeshImporter.h"
+#include "MeshOptimizer.h"
+#include "NodeTransform.h"
+#include "AnimationSampler.h"
+#include "BoundingVolume.h"
+#include "Skinning.h"
+#include "VertexQuantization.h"
 #include "Base/DX12Context.h"
 #include "Texture/TextureManager.h"
 
@@ -9,450 +18,316 @@
 #include "Logger.h"
 
 #include <assert.h>
+#include <chrono>
+#include <format>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <numbers>
 #include <algorithm>
+#include <unordered_map>
 
 using namespace Microsoft::WRL;
 using namespace MathUtils;
 using namespace MathGenerators;
 
+namespace {
+// assimp のインポート設定 (変換済みキャッシュのキーにも含める)
+// 現在成功している設定（左手系・時計回り・UV反転）を維持
+const uint32_t kImportFlags = aiProcess_FlipWindingOrder | // 時計回りに変換
+                              aiProcess_FlipUVs |          // UV反転
+                              //aiProcess_MakeLeftHanded | // 左手系に変換
+                              aiProcess_Triangulate;       // 三角形化
+
+// assimp の行列を変換する (列ベクトル形式を行ベクトル形式に転置。Assimpは列優先、DirectXは行優先のため)
+Matrix4x4 ToMatrix(const aiMatrix4x4 &source) {
+  aiMatrix4x4 transposed = source;
+  transposed.Transpose();
+  Matrix4x4 result;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      result.m[i][j] = transposed[i][j];
+    }
+  }
+  return result;
+}
+
+} // namespace
+
 void Model::Initialize(const std::string &directoryPath,
                        const std::string &filename) {
-  // モデル読み込み
-  LoadModelFile(directoryPath, filename);
+  MeshSource source = LoadMeshSource(directoryPath, filename);
+  Logger::Log(std::format("INFO: Model mesh {} loaded in {:.3f} ms ({})\n",
+                          source.fullPath, source.loadMilliseconds,
+                          MeshImporter::GetReaderName(source.reader)));
+  Initialize(std::move(source));
+}
 
-  // 頂点データを作成する
-  CreateVertexResource();
+Model::MeshSource Model::LoadMeshSource(const std::string &directoryPath,
+                                        const std::string &filename) {
+  // 読めない内容は assimp で読み直す
+  MeshImporter::Settings settings;
+  settings.importFlags = kImportFlags;
+  settings.fallbackLoader = &Model::LoadModelFile;
+  return MeshImporter::Load(directoryPath, filename, settings);
+}
 
-  // インデックスバッファ作成
-  CreateIndexResource();
+void Model::Initialize(MeshSource &&source) {
+  primitiveMeshKey_ = 0;
+  if (source.isCached) {
+    modelData_.vertices.clear();
+    modelData_.indices.clear();
+    modelData_.influences.clear();
+    modelData_.joints.clear();
+    modelData_.animations.clear();
+    modelData_.compressedAnimations.clear();
+    modelData_.material = std::move(source.cooked.material);
+    modelData_.nodes = std::move(source.cooked.nodes);
+    modelData_.bounds = source.cooked.bounds;
+
+    // 頂点・インデックスはマップしたファイルからGPUバッファへ直接コピーする
+    CreateVertexResource(source.cooked.vertices);
+    CreateIndexResource(source.cooked.indices);
+    if (!source.cooked.lods.empty()) {
+      lods_ = std::move(source.cooked.lods);
+    }
+    subMeshes_ = std::move(source.cooked.subMeshes);
+    materials_ = std::move(source.cooked.materials);
+    BuildMeshlets(source.fullPath, source.cooked.indices, source.cooked.vertices);
+    LogMemoryReport(source.fullPath, source.cooked.vertices);
+  } else {
+    modelData_ = std::move(source.modelData);
+
+    // 頂点データを作成する
+    CreateVertexResource(modelData_.vertices);
+
+    // インデックスバッファ作成
+    CreateIndexResource(modelData_.indices);
+    if (!modelData_.lods.empty()) {
+      lods_ = modelData_.lods;
+    }
+    subMeshes_ = modelData_.subMeshes;
+    materials_ = modelData_.materials;
+    BuildMeshlets(source.fullPath, modelData_.indices, modelData_.vertices);
+    LogMemoryReport(source.fullPath, modelData_.vertices);
+  }
 
   // マテリアルバッファの作成
   CreateMaterialResource();
 
-  // .objの参照しているテクスチャファイル読み込み、インデックスを代入
-  TextureManager::GetInstance()->LoadTexture(
-      modelData_.material.textureFilePath);
+  // サブメッシュのテクスチャ読み込み
+  LoadMaterialTextures();
 
-  modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(
+  // .objの参照しているテクスチャファイル読み込み、インデックスを代入
+  // (非同期で読み込む。ゲーム中に読み込まれても描画スレッドとGPUを待たせない)
+  modelData_.material.textureIndex = TextureManager::GetInstance()->RequestTexture(
       modelData_.material.textureFilePath);
 }
 
 void Model::CreateRing(const std::string& textureFilePath, float innerRadius, float outerRadius, uint32_t division) {
-    // 既存リソースがある場合はGPUの完了を待ち、アンマップして安全に破棄できるようにする
-    if (vertexResource_ || indexResource_ || materialResource_) {
-        DX12Context::GetInstance()->WaitForGpu();
-        if (vertexResource_ && vertexData_) {
-            vertexResource_->Unmap(0, nullptr);
-            vertexData_ = nullptr;
-        }
-        if (materialResource_ && materialData_) {
-            materialResource_->Unmap(0, nullptr);
-            materialData_ = nullptr;
-        }
-    }
-
-    // データをクリアしておく
-    modelData_.vertices.clear();
-    modelData_.indices.clear();
-
-    // ============================================================
-    // 【ガード処理】不正な値をシャットアウト
-    // ============================================================
-    uint32_t safeDivision = std::max(3u, division);
-    if (safeDivision > 256) safeDivision = 256; // 念のため上限もガード
-
-    float safeInnerRadius = std::max(0.0f, innerRadius);
-    // ============================================================
-
-    const float radianPerDivide = 2.0f * std::numbers::pi_v<float> / float(safeDivision);
-
-    // 頂点データの生成
-    for (uint32_t i = 0; i <= safeDivision; ++i) {
-        float angle = i * radianPerDivide;
-        float s = std::sin(angle);
-        float c = std::cos(angle);
-        float u = float(i) / float(safeDivision);
-
-        // 外側の頂点
-        VertexData outerVertex;
-        outerVertex.position = { -s * outerRadius, c * outerRadius, 0.0f, 1.0f };
-        outerVertex.normal = { 0.0f, 0.0f, -1.0f };
-        outerVertex.texcoord = { u, 0.0f };
-        modelData_.vertices.push_back(outerVertex);
-
-        // 内側の頂点
-        VertexData innerVertex;
-        innerVertex.position = { -s * safeInnerRadius, c * safeInnerRadius, 0.0f, 1.0f };
-        innerVertex.normal = { 0.0f, 0.0f, -1.0f };
-        innerVertex.texcoord = { u, 1.0f };
-        modelData_.vertices.push_back(innerVertex);
-    }
-
-    // インデックスデータの生成
-    for (uint32_t i = 0; i < safeDivision; ++i) {
-        uint32_t base = i * 2;
-        // 頂点レイアウト: [Outer0, Inner0, Outer1, Inner1, ...]
-        // 三角形1
-        modelData_.indices.push_back(base);     // Outer i
-        modelData_.indices.push_back(base + 2); // Outer i+1
-        modelData_.indices.push_back(base + 1); // Inner i
-        // 三角形2
-        modelData_.indices.push_back(base + 1); // Inner i
-        modelData_.indices.push_back(base + 2); // Outer i+1
-        modelData_.indices.push_back(base + 3); // Inner i+1
-    }
-
-    // マテリアル設定
-    modelData_.material.textureFilePath = textureFilePath;
-    modelData_.rootNode.localMatrix = MakeIdentity4x4();
-    modelData_.rootNode.name = "Ring";
-
-    // リソースの作成
-    CreateVertexResource();
-    CreateIndexResource();
-    CreateMaterialResource();
-
-    // テクスチャ読み込み
-    TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
-    modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(modelData_.material.textureFilePath);
+    // 全周・外径一定のリングとして生成する
+    RingSettings settings;
+    settings.innerRadius = innerRadius;
+    settings.startOuterRadius = outerRadius;
+    settings.midOuterRadius = outerRadius;
+    settings.endOuterRadius = outerRadius;
+    settings.startAngle = 0.0f;
+    settings.endAngle = 360.0f;
+    settings.division = division;
+    CreateRing(textureFilePath, settings);
 }
 
 void Model::CreateRing(const std::string& textureFilePath, const RingSettings& settings) {
-    // 既存リソースがある場合はGPUの完了を待ち、アンマップして安全に破棄できるようにする
-    if (vertexResource_ || indexResource_ || materialResource_) {
-        DX12Context::GetInstance()->WaitForGpu();
-        if (vertexResource_ && vertexData_) {
-            vertexResource_->Unmap(0, nullptr);
-            vertexData_ = nullptr;
-        }
-        if (materialResource_ && materialData_) {
-            materialResource_->Unmap(0, nullptr);
-            materialData_ = nullptr;
-        }
-    }
-
-    // データをクリアしておく
-    modelData_.vertices.clear();
-    modelData_.indices.clear();
-
-    // ============================================================
-    // 【ガード処理】不正な値をシャットアウト
-    // ============================================================
-    uint32_t safeDivision = std::max(3u, settings.division);
-    if (safeDivision > 256) safeDivision = 256; // 念のため上限もガード
-
-    float safeInnerRadius = std::max(0.0f, settings.innerRadius);
-    // ============================================================
-
-    float startRad = settings.startAngle * std::numbers::pi_v<float> / 180.0f;
-    float endRad = settings.endAngle * std::numbers::pi_v<float> / 180.0f;
-    float angleRange = endRad - startRad;
-
-    float rStart = settings.startOuterRadius;
-    float rMid = settings.midOuterRadius;
-    float rEnd = settings.endOuterRadius;
-
-    // 二次スプライン（放物線補間）係数の算出
-    float aCoeff = 2.0f * rStart - 4.0f * rMid + 2.0f * rEnd;
-    float bCoeff = -3.0f * rStart + 4.0f * rMid - rEnd;
-    float cCoeff = rStart;
-
-    // 頂点データの生成
-    for (uint32_t i = 0; i <= safeDivision; ++i) {
-        float t = float(i) / float(safeDivision);
-        float angle = startRad + t * angleRange;
-        float s = std::sin(angle);
-        float c = std::cos(angle);
-
-        // スプライン曲線による外径の計算
-        float outerRadius = aCoeff * t * t + bCoeff * t + cCoeff;
-
-        // 外側の頂点
-        VertexData outerVertex;
-        outerVertex.position = { -s * outerRadius, c * outerRadius, 0.0f, 1.0f };
-        outerVertex.normal = { 0.0f, 0.0f, -1.0f };
-        if (settings.isUvSwap) {
-            outerVertex.texcoord = { 0.0f, t };
-        } else {
-            outerVertex.texcoord = { t, 0.0f };
-        }
-        modelData_.vertices.push_back(outerVertex);
-
-        // 内側の頂点
-        VertexData innerVertex;
-        innerVertex.position = { -s * safeInnerRadius, c * safeInnerRadius, 0.0f, 1.0f };
-        innerVertex.normal = { 0.0f, 0.0f, -1.0f };
-        if (settings.isUvSwap) {
-            innerVertex.texcoord = { 1.0f, t };
-        } else {
-            innerVertex.texcoord = { t, 1.0f };
-        }
-        modelData_.vertices.push_back(innerVertex);
-    }
-
-    // インデックスデータの生成
-    for (uint32_t i = 0; i < safeDivision; ++i) {
-        uint32_t base = i * 2;
-        // 三角形1
-        modelData_.indices.push_back(base);     // Outer i
-        modelData_.indices.push_back(base + 2); // Outer i+1
-        modelData_.indices.push_back(base + 1); // Inner i
-        // 三角形2
-        modelData_.indices.push_back(base + 1); // Inner i
-        modelData_.indices.push_back(base + 2); // Outer i+1
-        modelData_.indices.push_back(base + 3); // Inner i+1
-    }
-
-    // マテリアル設定
-    modelData_.material.textureFilePath = textureFilePath;
-    modelData_.rootNode.localMatrix = MakeIdentity4x4();
-    modelData_.rootNode.name = "Ring";
-
-    // リソースの作成
-    CreateVertexResource();
-    CreateIndexResource();
-    CreateMaterialResource();
-
-    // テクスチャ読み込み
-    TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
-    modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(modelData_.material.textureFilePath);
+    CreatePrimitive(textureFilePath, "Ring", PrimitiveMesh::HashRing(settings), PrimitiveMesh::MakeRingBuilder(settings));
 }
 
 void Model::CreateCylinder(const std::string& textureFilePath, const CylinderSettings& settings) {
-    // 既存リソースがある場合はGPUの完了を待ち、アンマップして安全に破棄できるようにする
-    if (vertexResource_ || indexResource_ || materialResource_) {
-        DX12Context::GetInstance()->WaitForGpu();
-        if (vertexResource_ && vertexData_) {
-            vertexResource_->Unmap(0, nullptr);
-            vertexData_ = nullptr;
-        }
-        if (materialResource_ && materialData_) {
-            materialResource_->Unmap(0, nullptr);
-            materialData_ = nullptr;
-        }
-    }
-
-    // データをクリアしておく
-    modelData_.vertices.clear();
-    modelData_.indices.clear();
-
-    // ============================================================
-    // 【安全ガード処理】関数の先頭で不正な値をシャットアウト
-    // ============================================================
-    uint32_t safeDivision = std::max(3u, settings.division);
-    if (safeDivision > 256) safeDivision = 256;
-
-    uint32_t safeVerticalDivision = std::max(1u, settings.verticalDivision);
-    if (safeVerticalDivision > 256) safeVerticalDivision = 256;
-	// ============================================================
-
-    float startRad = settings.startAngle * std::numbers::pi_v<float> / 180.0f;
-    float endRad = settings.endAngle * std::numbers::pi_v<float> / 180.0f;
-    float angleRange = endRad - startRad;
-
-    // 頂点の生成 (縦方向 yIndex: 0 から verticalDivision)
-    for (uint32_t yIndex = 0; yIndex <= safeVerticalDivision; ++yIndex) {
-        float vNorm = float(yIndex) / float(safeVerticalDivision);
-        float h = (1.0f - vNorm) * settings.height; // yIndex=0 が上(高さ height), yIndex=verticalDivision が下(高さ 0)
-
-        // 上底から下底にかけての半径を線形補間 (楕円対応)
-        Vector2 radius = {
-            settings.topRadius.x * (1.0f - vNorm) + settings.bottomRadius.x * vNorm,
-            settings.topRadius.y * (1.0f - vNorm) + settings.bottomRadius.y * vNorm
-        };
-
-        // 円周方向の頂点生成 (xIndex: 0 から division)
-        for (uint32_t xIndex = 0; xIndex <= safeDivision; ++xIndex) {
-            float uNorm = float(xIndex) / float(safeDivision);
-            float angle = startRad + uNorm * angleRange;
-            float s = std::sin(angle);
-            float c = std::cos(angle);
-
-            // 頂点の位置 (X, Y, Z)
-            VertexData vertex;
-            vertex.position = { -s * radius.x, h, c * radius.y, 1.0f };
-
-            // 法線：Y軸の高さは無視し、X, Z方向の外側を向く法線
-            vertex.normal = { -s, 0.0f, c };
-            float normalLen = std::sqrt(vertex.normal.x * vertex.normal.x + vertex.normal.z * vertex.normal.z);
-            if (normalLen > 0.0f) {
-                vertex.normal.x /= normalLen;
-                vertex.normal.z /= normalLen;
-            }
+    CreatePrimitive(textureFilePath, "Cylinder", PrimitiveMesh::HashCylinder(settings),
+                    PrimitiveMesh::MakeCylinderBuilder(settings));
+}
 
-            // UV座標
-            float u = uNorm;
-            float v = vNorm;
-            if (settings.flipV) {
-                v = 1.0f - v;
-            }
-            if (settings.isUvSwap) {
-                std::swap(u, v);
-            }
-            vertex.texcoord = { u, v };
+void Model::CreatePlane(const std::string &textureFilePath, const PlaneSettings& settings) {
+    CreatePrimitive(textureFilePath, "Plane", PrimitiveMesh::HashPlane(settings), PrimitiveMesh::MakePlaneBuilder(settings));
 
-            modelData_.vertices.push_back(vertex);
-        }
+    // マテリアルの初期色を設定
+    if (materialData_) {
+        materialData_->color = settings.color;
     }
+}
 
-    // インデックスデータの生成
-    for (uint32_t y = 0; y < safeVerticalDivision; ++y) {
-        for (uint32_t x = 0; x < safeDivision; ++x) {
-            uint32_t topLeft = y * (safeDivision + 1) + x;
-            uint32_t topRight = topLeft + 1;
-            uint32_t bottomLeft = (y + 1) * (safeDivision + 1) + x;
-            uint32_t bottomRight = bottomLeft + 1;
-
-            // 三角形1
-            modelData_.indices.push_back(topLeft);
-            modelData_.indices.push_back(topRight);
-            modelData_.indices.push_back(bottomLeft);
-
-            // 三角形2
-            modelData_.indices.push_back(bottomLeft);
-            modelData_.indices.push_back(topRight);
-            modelData_.indices.push_back(bottomRight);
-        }
+void Model::CreatePrimitive(const std::string& textureFilePath, const char* nodeName, uint64_t meshKey,
+                            const ShapeMeshBuilder& builder) {
+    // 形状が前回と同じなら頂点・インデックスは作り直さない (毎フレーム同じ設定で呼ばれても生成とGPUリソースの作り直しが起きない)
+    if (meshKey != primitiveMeshKey_ || !vertexResource_) {
+        // 既存リソースはGPUが参照中の可能性があるので、フレーム完了後に解放する (GPU待ちはしない)
+        ReleaseResourcesDeferred();
+
+        // 頂点・インデックスの生成 (大きさは先に決まるので1回の確保で書き込む)
+        modelData_.vertices.resize(builder.size.vertexCount);
+        modelData_.indices.resize(builder.size.indexCount);
+        builder.write(modelData_.vertices, modelData_.indices);
+
+        modelData_.nodes = {};
+        NodeTransform::AddNode(modelData_.nodes, nodeName, MakeIdentity4x4(), -1);
+
+        // リソースの作成
+        modelData_.bounds = BoundingVolume::Compute(modelData_.vertices);
+        CreateVertexResource(modelData_.vertices);
+        CreateIndexResource(modelData_.indices);
+        CreateMaterialResource();
+        primitiveMeshKey_ = meshKey;
     }
 
-    // マテリアル設定
+    // マテリアル設定・テクスチャ読み込み (読み込み済みならキャッシュから返る)
     modelData_.material.textureFilePath = textureFilePath;
-    modelData_.rootNode.localMatrix = MakeIdentity4x4();
-    modelData_.rootNode.name = "Cylinder";
-
-    // リソースの作成
-    CreateVertexResource();
-    CreateIndexResource();
-    CreateMaterialResource();
-
-    // テクスチャ読み込み
-    TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
-    modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(modelData_.material.textureFilePath);
+    modelData_.material.textureIndex = TextureManager::GetInstance()->RequestTexture(modelData_.material.textureFilePath);
 }
 
-void Model::CreatePlane(const std::string &textureFilePath, const PlaneSettings& settings) {
-    modelData_.vertices.clear();
-    modelData_.indices.clear();
-
-    uint32_t divX = settings.divisionX > 0 ? settings.divisionX : 1;
-    uint32_t divY = settings.divisionY > 0 ? settings.divisionY : 1;
-
-    float stepX = settings.size.x / static_cast<float>(divX);
-    float stepY = settings.size.y / static_cast<float>(divY);
-
-    float startX = -settings.size.x * 0.5f;
-    float startY = -settings.size.y * 0.5f;
+void Model::ReleaseResourcesDeferred() {
+  DX12Context *dxContext = DX12Context::GetInstance();
+  if (vertexResource_ && vertexData_) {
+    vertexResource_->Unmap(0, nullptr);
+    vertexData_ = nullptr;
+  }
+  if (materialResource_ && materialData_) {
+    materialResource_->Unmap(0, nullptr);
+    materialData_ = nullptr;
+  }
+  dxContext->DeferredRelease(std::move(vertexResource_));
+  dxContext->DeferredRelease(std::move(indexResource_));
+  dxContext->DeferredRelease(std::move(materialResource_));
+}
 
-    // 頂点生成
-    for (uint32_t y = 0; y <= divY; ++y) {
-        float posY = startY + static_cast<float>(y) * stepY;
-        float v = static_cast<float>(y) / static_cast<float>(divY);
-        if (settings.flipV) {
-            v = 1.0f - v;
-        }
+// 描画処理
+void Model::Draw(uint32_t lodIndex, const DrawOverride *drawOverride) {
+  const MeshLod &lod =
+      lods_[std::min(lodIndex, static_cast<uint32_t>(lods_.size()) - 1)];
 
-        for (uint32_t x = 0; x <= divX; ++x) {
-            float posX = startX + static_cast<float>(x) * stepX;
-            float u = static_cast<float>(x) / static_cast<float>(divX);
+  // IBV(インデックスバッファビュー)の設定
+  DX12Context::GetInstance()->GetCommandList()->IASetIndexBuffer(
+      &indexBufferView_);
+  SetDrawResources(drawOverride);
 
-            VertexData vertex;
-            vertex.position = { posX, posY, 0.0f, 1.0f };
-            vertex.normal = { 0.0f, 0.0f, -1.0f };
-            
-            float finalU = u;
-            float finalV = v;
-            if (settings.isUvSwap) {
-                std::swap(finalU, finalV);
-            }
-            vertex.texcoord = { finalU, finalV };
+  if (lod.subMeshCount == 0) {
+    DrawRange(modelData_.material, lod.indexCount, lod.indexOffset);
+    return;
+  }
+  // サブメッシュはマテリアルごとにまとめてあるので、テクスチャの切り替えはサブメッシュの数だけ
+  for (uint32_t i = 0; i < lod.subMeshCount; ++i) {
+    const SubMesh &subMesh = subMeshes_[lod.subMeshOffset + i];
+    DrawRange(materials_[subMesh.materialIndex], subMesh.indexCount,
+              subMesh.indexOffset);
+  }
+}
 
-            modelData_.vertices.push_back(vertex);
-        }
+void Model::DrawIndices(const D3D12_INDEX_BUFFER_VIEW &indexBufferView,
+                        std::span<const uint32_t> groupIndexOffsets,
+                        const DrawOverride *drawOverride) {
+  DX12Context::GetInstance()->GetCommandList()->IASetIndexBuffer(
+      &indexBufferView);
+  SetDrawResources(drawOverride);
+
+  const MeshLod &lod0 = lods_[0];
+  for (size_t i = 0; i + 1 < groupIndexOffsets.size(); ++i) {
+    const uint32_t indexCount = groupIndexOffsets[i + 1] - groupIndexOffsets[i];
+    if (indexCount == 0) {
+      continue;
     }
+    const MaterialData &material =
+        lod0.subMeshCount == 0
+            ? modelData_.material
+            : materials_[subMeshes_[lod0.subMeshOffset + i].materialIndex];
+    DrawRange(material, indexCount, groupIndexOffsets[i]);
+  }
+}
 
-    // インデックス生成
-    for (uint32_t y = 0; y < divY; ++y) {
-        for (uint32_t x = 0; x < divX; ++x) {
-            uint32_t topLeft = y * (divX + 1) + x;
-            uint32_t topRight = topLeft + 1;
-            uint32_t bottomLeft = (y + 1) * (divX + 1) + x;
-            uint32_t bottomRight = bottomLeft + 1;
-
-            // 三角形1
-            modelData_.indices.push_back(topLeft);
-            modelData_.indices.push_back(topRight);
-            modelData_.indices.push_back(bottomLeft);
-
-            // 三角形2
-            modelData_.indices.push_back(bottomLeft);
-            modelData_.indices.push_back(topRight);
-            modelData_.indices.push_back(bottomRight);
-        }
+void Model::SetDrawResources(const DrawOverride *drawOverride) {
+  // インスタンスごとのものがあればそちらを使う
+  D3D12_GPU_VIRTUAL_ADDRESS materialAddress =
+      materialResource_->GetGPUVirtualAddress();
+  const std::string *dissolveMaskFilePath = &dissolveMaskFilePath_;
+  const D3D12_VERTEX_BUFFER_VIEW *vertexBufferView = &vertexBufferView_;
+  if (drawOverride) {
+    if (drawOverride->materialAddress != 0) {
+      materialAddress = drawOverride->materialAddress;
     }
-
-    modelData_.material.textureFilePath = textureFilePath;
-    modelData_.rootNode.localMatrix = MakeIdentity4x4();
-    modelData_.rootNode.name = "Plane";
-
-    CreateVertexResource();
-    CreateIndexResource();
-    CreateMaterialResource();
-
-    // マテリアルの初期色を設定
-    if (materialData_) {
-        materialData_->color = settings.color;
+    if (drawOverride->dissolveMaskFilePath) {
+      dissolveMaskFilePath = drawOverride->dissolveMaskFilePath;
     }
+    if (drawOverride->vertexBufferView) {
+      vertexBufferView = drawOverride->vertexBufferView;
+    }
+  }
 
-    TextureManager::GetInstance()->LoadTexture(modelData_.material.textureFilePath);
-    modelData_.material.textureIndex = TextureManager::GetInstance()->GetSrvIndex(modelData_.material.textureFilePath);
-}
-
-// 描画処理
-void Model::Draw() {
   // VertexBufferの設定
   DX12Context::GetInstance()->GetCommandList()->IASetVertexBuffers(
-      0, 1, &vertexBufferView_);
-  // IBV(インデックスバッファビュー)の設定
-  DX12Context::GetInstance()->GetCommandList()->IASetIndexBuffer(
-      &indexBufferView_);
+      0, 1, vertexBufferView);
   // マテリアルCBVの設定
   DX12Context::GetInstance()
       ->GetCommandList()
-      ->SetGraphicsRootConstantBufferView(
-          0, materialResource_->GetGPUVirtualAddress());
-  // SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である。
-  DX12Context::GetInstance()->GetCommandList()->SetGraphicsRootDescriptorTable(
-      2, TextureManager::GetInstance()->GetSrvHandleGPU(
-             modelData_.material.textureFilePath));
+      ->SetGraphicsRootConstantBufferView(0, materialAddress);
 
   // Dissolve用のマスクテクスチャを設定。8はrootParameter[8]である。
   DX12Context::GetInstance()->GetCommandList()->SetGraphicsRootDescriptorTable(
       8, TextureManager::GetInstance()->GetSrvHandleGPU(
-             dissolveMaskFilePath_));
+             *dissolveMaskFilePath));
+}
+
+void Model::DrawRange(const MaterialData &material, uint32_t indexCount,
+                      uint32_t indexOffset) {
+  // SRVのDescriptorTableの先頭を設定。2はrootParameter[2]である。
+  DX12Context::GetInstance()->GetCommandList()->SetGraphicsRootDescriptorTable(
+      2, TextureManager::GetInstance()->GetSrvHandleGPU(
+             material.textureFilePath));
 
   // 描画コマンド
   // 引数: (インデックス数, インスタンス数, インデックス開始位置, 頂点オフセット, インスタンスオフセット)
   DX12Context::GetInstance()->GetCommandList()->DrawIndexedInstanced(
-      UINT(modelData_.indices.size()), 1, 0, 0, 0);
+      indexCount, 1, indexOffset, 0, 0);
+}
+
+void Model::LoadMaterialTextures() {
+  for (MaterialData &material : materials_) {
+    if (material.textureFilePath.empty()) {
+      material.textureFilePath = kDefaultTextureFilePath;
+    }
+    material.textureIndex =
+        TextureManager::GetInstance()->RequestTexture(material.textureFilePath);
+  }
+  // 代表のマテリアルにテクスチャが無ければ、最初のサブメッシュのものを使う
+  if (modelData_.material.textureFilePath.empty() && !materials_.empty()) {
+    modelData_.material.textureFilePath = materials_[0].textureFilePath;
+  }
+}
+
+int32_t Model::FindAnimation(const std::string &name) const {
+  for (size_t i = 0; i < modelData_.compressedAnimations.size(); ++i) {
+    if (modelData_.compressedAnimations[i].name == name) {
+      return static_cast<int32_t>(i);
+    }
+  }
+  return -1;
+}
+
+uint32_t Model::SelectLod(float pixelsPerUnit) const {
+  // LODの誤差は番号の順に大きくなるので、許容を超える手前までを使う
+  uint32_t lodIndex = 0;
+  for (uint32_t i = 1; i < lods_.size(); ++i) {
+    if (lods_[i].error * pixelsPerUnit > kLodPixelError) {
+      break;
+    }
+    lodIndex = i;
+  }
+  return lodIndex;
 }
 
 // .objファイルの読み取り
 void Model::LoadModelFile(const std::string &directoryPath,
-                          const std::string &fileName) {
+                          const std::string &fileName, ModelData &modelData) {
     Assimp::Importer importer;
     std::string fullPath = directoryPath + "/" + fileName;
 
-    // 現在成功している設定（左手系・時計回り・UV反転）を維持
-    const aiScene* scene = importer.ReadFile(fullPath.c_str(),
-        aiProcess_FlipWindingOrder | // 時計回りに変換
-        aiProcess_FlipUVs |          // UV反転
-        //aiProcess_MakeLeftHanded |   // 左手系に変換
-        aiProcess_Triangulate        // 三角形化
-    );
+    const aiScene* scene = importer.ReadFile(fullPath.c_str(), kImportFlags);
 
     // シーンの読み込みチェック
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
@@ -462,8 +337,50 @@ void Model::LoadModelFile(const std::string &directoryPath,
     }
 
     // データをクリアしておく
-    modelData_.vertices.clear();
-    modelData_.indices.clear();
+    modelData.vertices.clear();
+    modelData.indices.clear();
+    modelData.materials.clear();
+
+    // --- マテリアルの解析 ---
+    // テクスチャが同じマテリアルは1つにまとめる (サブメッシュの数 = 描画時のテクスチャの切り替え回数)
+    std::vector<uint32_t> materialSlots(scene->mNumMaterials, 0);
+    std::unordered_map<std::string, uint32_t> textureMaterials;
+    for (uint32_t i = 0; i < scene->mNumMaterials; ++i) {
+        aiMaterial* material = scene->mMaterials[i];
+        std::string textureFilePath;
+        if (material->GetTextureCount(aiTextureType_DIFFUSE) != 0) {
+            aiString texturePath;
+            material->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath);
+            textureFilePath = directoryPath + "/" + texturePath.C_Str();
+        }
+        auto [it, inserted] = textureMaterials.try_emplace(textureFilePath, static_cast<uint32_t>(modelData.materials.size()));
+        if (inserted) {
+            modelData.materials.push_back({textureFilePath, 0});
+        }
+        materialSlots[i] = it->second;
+    }
+    // 代表のマテリアルは、最初にテクスチャを持っているもの
+    modelData.material = {};
+    for (const MaterialData& material : modelData.materials) {
+        if (!material.textureFilePath.empty()) {
+            modelData.material.textureFilePath = material.textureFilePath;
+            break;
+        }
+    }
+    std::vector<uint32_t> triangleMaterials;
+
+    // --- ノードの解析 (ボーンとアニメーションはノード名で対応付けるので先に読む) ---
+    modelData.nodes = {};
+    ReadNodes(scene->mRootNode, modelData.nodes);
+
+    // ボーンを持つメッシュが1つでもあれば、全頂点にジョイントの影響を持たせる
+    modelData.influences.clear();
+    modelData.joints.clear();
+    bool hasBones = false;
+    for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
+        hasBones = hasBones || scene->mMeshes[meshIndex]->HasBones();
+    }
+    std::unordered_map<std::string, uint32_t> jointIndices;
 
     // --- メッシュの解析（複数メッシュ対応） ---
     for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
@@ -474,7 +391,7 @@ void Model::LoadModelFile(const std::string &directoryPath,
 
         // 重要：現在の頂点数を保持しておく（これがインデックスのオフセットになる）
         // 1つ目のメッシュなら0、2つ目なら1つ目の頂点数がここに入る
-        uint32_t indexOffset = static_cast<uint32_t>(modelData_.vertices.size());
+        uint32_t indexOffset = static_cast<uint32_t>(modelData.vertices.size());
 
         // --- 頂点データの追加 ---
         for (uint32_t i = 0; i < mesh->mNumVertices; ++i) {
@@ -490,7 +407,28 @@ void Model::LoadModelFile(const std::string &directoryPath,
             vertex.position.x *= -1.0f;
             vertex.normal.x *= -1.0f;
 
-            modelData_.vertices.push_back(vertex);
+            modelData.vertices.push_back(vertex);
+        }
+
+        // --- ボーンの解析 (同じ名前のボーンはメッシュをまたいで1つのジョイントにする) ---
+        if (hasBones) {
+            modelData.influences.resize(modelData.vertices.size());
+        }
+        for (uint32_t boneIndex = 0; boneIndex < mesh->mNumBones; ++boneIndex) {
+            aiBone* bone = mesh->mBones[boneIndex];
+            const int32_t nodeIndex = NodeTransform::FindNode(modelData.nodes, bone->mName.C_Str());
+            if (nodeIndex < 0) {
+                Logger::Log(std::format("WARNING: Bone {} has no node in {}\n", bone->mName.C_Str(), fullPath));
+                continue;
+            }
+            auto [it, inserted] = jointIndices.try_emplace(bone->mName.C_Str(), static_cast<uint32_t>(modelData.joints.size()));
+            if (inserted) {
+                modelData.joints.push_back({static_cast<uint32_t>(nodeIndex), ToMatrix(bone->mOffsetMatrix)});
+            }
+            for (uint32_t weightIndex = 0; weightIndex < bone->mNumWeights; ++weightIndex) {
+                const aiVertexWeight& weight = bone->mWeights[weightIndex];
+                Skinning::AddInfluence(modelData.influences[indexOffset + weight.mVertexId], it->second, weight.mWeight);
+            }
         }
 
         // --- インデックスデータの追加 ---
@@ -499,56 +437,104 @@ void Model::LoadModelFile(const std::string &directoryPath,
             assert(face.mNumIndices == 3);
 
             // インデックスにオフセットを足して、全体の通し番号にする
-            modelData_.indices.push_back(face.mIndices[0] + indexOffset);
-            modelData_.indices.push_back(face.mIndices[1] + indexOffset);
-            modelData_.indices.push_back(face.mIndices[2] + indexOffset);
+            modelData.indices.push_back(face.mIndices[0] + indexOffset);
+            modelData.indices.push_back(face.mIndices[1] + indexOffset);
+            modelData.indices.push_back(face.mIndices[2] + indexOffset);
+            triangleMaterials.push_back(materialSlots[mesh->mMaterialIndex]);
         }
     }
 
-    // --- マテリアルの解析 ---
-    // ※現在の構造（Modelクラスにテクスチャが1つ）だと、複数のテクスチャを持つモデルは正しく表現できない
-    // そのため、とりあえず「最初にテクスチャを持っているメッシュのマテリアル」を採用する
-    for (uint32_t i = 0; i < scene->mNumMaterials; ++i) {
-        aiMaterial* material = scene->mMaterials[i];
-        if (material->GetTextureCount(aiTextureType_DIFFUSE) != 0) {
-            aiString textureFilePath;
-            material->GetTexture(aiTextureType_DIFFUSE, 0, &textureFilePath);
-            modelData_.material.textureFilePath = directoryPath + "/" + textureFilePath.C_Str();
-            // ひとつ見つかったら終了（現在の仕様の限界）
-            break;
-        }
+    // --- 三角形をマテリアルごとにまとめる (メッシュごとに頂点が分かれているので、サブメッシュ同士で頂点を共有しない) ---
+    modelData.subMeshes = MeshOptimizer::GroupTriangles(modelData.indices, triangleMaterials, modelData.materials.size());
+
+    // --- 重みの正規化 (ボーンの無いメッシュの頂点は、ルートノードに固定する) ---
+    if (hasBones) {
+        Skinning::NormalizeInfluences(modelData.influences, modelData.joints);
     }
 
-    // --- ノードの解析 ---
-    modelData_.rootNode = ReadNode(scene->mRootNode);
+    // --- アニメーションの解析 ---
+    ReadAnimations(scene, modelData);
 
     // データが空でないか最終チェック
-    assert(!modelData_.vertices.empty() && "Vertex data is empty");
-    assert(!modelData_.indices.empty() && "Index data is empty");
+    assert(!modelData.vertices.empty() && "Vertex data is empty");
+    assert(!modelData.indices.empty() && "Index data is empty");
 }
 
-Node Model::ReadNode(aiNode* node) {
-    Node result;
-    aiMatrix4x4 aiLocalMatrix = node->mTransformation; // nodeのMatrixを取得
-    aiLocalMatrix.Transpose(); // 列ベクトル形式を行ベクトル形式に転置（Assimpは列優先、DirectXは行優先のため）
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-            result.localMatrix.m[i][j] = aiLocalMatrix[i][j];
+void Model::ReadNodes(aiNode* rootNode, NodeHierarchy& nodes) {
+    // 深さ優先の前順で並べる (親が子より前に来る)。再帰せずに明示的なスタックでたどる
+    struct PendingNode {
+        aiNode* node;
+        int32_t parent;
+    };
+    std::vector<PendingNode> stack = {{rootNode, -1}};
+    while (!stack.empty()) {
+        const PendingNode pending = stack.back();
+        stack.pop_back();
+
+        const uint32_t index = NodeTransform::AddNode(nodes, pending.node->mName.C_Str(),
+                                                      ToMatrix(pending.node->mTransformation), pending.parent);
+
+        // 最初の子から順に取り出されるよう、逆順に積む
+        for (uint32_t childIndex = pending.node->mNumChildren; childIndex > 0; --childIndex) {
+            stack.push_back({pending.node->mChildren[childIndex - 1], static_cast<int32_t>(index)});
         }
     }
+}
+
+void Model::ReadAnimations(const aiScene* scene, ModelData& modelData) {
+    modelData.animations.clear();
+    for (uint32_t animationIndex = 0; animationIndex < scene->mNumAnimations; ++animationIndex) {
+        const aiAnimation* source = scene->mAnimations[animationIndex];
+        // 時間はティック単位なので秒に直す (ティックレートが無いファイルは 25 とみなす)
+        const double ticksPerSecond = source->mTicksPerSecond != 0.0 ? source->mTicksPerSecond : 25.0;
+
+        AnimationClip clip;
+        clip.name = source->mName.C_Str();
+        clip.duration = static_cast<float>(source->mDuration / ticksPerSecond);
+        for (uint32_t channelIndex = 0; channelIndex < source->mNumChannels; ++channelIndex) {
+            const aiNodeAnim* channel = source->mChannels[channelIndex];
+            const int32_t nodeIndex = NodeTransform::FindNode(modelData.nodes, channel->mNodeName.C_Str());
+            if (nodeIndex < 0) {
+                continue;
+            }
+
+            NodeAnimation track;
+            track.nodeIndex = static_cast<uint32_t>(nodeIndex);
+            for (uint32_t i = 0; i < channel->mNumPositionKeys; ++i) {
+                const aiVectorKey& key = channel->mPositionKeys[i];
+                track.translate.push_back({static_cast<float>(key.mTime / ticksPerSecond), {key.mValue.x, key.mValue.y, key.mValue.z}});
+            }
+            for (uint32_t i = 0; i < channel->mNumRotationKeys; ++i) {
+                const aiQuatKey& key = channel->mRotationKeys[i];
+                track.rotate.push_back({static_cast<float>(key.mTime / ticksPerSecond), {key.mValue.x, key.mValue.y, key.mValue.z, key.mValue.w}});
+            }
+            for (uint32_t i = 0; i < channel->mNumScalingKeys; ++i) {
+                const aiVectorKey& key = channel->mScalingKeys[i];
+                track.scale.push_back({static_cast<float>(key.mTime / ticksPerSecond), {key.mValue.x, key.mValue.y, key.mValue.z}});
+            }
 
-    result.name = node->mName.C_Str(); // Node名を取得
-    result.children.resize(node->mNumChildren); // 子供の数だけ確保
-    for (uint32_t childIndex = 0; childIndex < node->mNumChildren; ++childIndex) {
-        // 再帰的に読んで階層構造を作っていく
-        result.children[childIndex] = ReadNode(node->mChildren[childIndex]);
+            // キーの無い要素はノードのローカル行列の値で1つ補う (サンプラーで分岐しないため)
+            Animation::FillMissingKeys(track, modelData.nodes.localMatrices[nodeIndex]);
+            clip.tracks.push_back(std::move(track));
+        }
+        modelData.animations.push_back(std::move(clip));
     }
-    return result;
 }
 
-void Model::CreateIndexResource() {
-  // リソースのサイズ（インデックス数 * uint32_tのサイズ）
-  size_t sizeInBytes = sizeof(uint32_t) * modelData_.indices.size();
+void Model::CreateIndexResource(std::span<const uint32_t> indices) {
+  // 頂点数が 65536 以下なら16bitインデックスにする (CreateVertexResource の後に呼ぶこと)
+  const bool is16Bit = vertexCount_ <= 0x10000;
+  const size_t indexSize = is16Bit ? sizeof(uint16_t) : sizeof(uint32_t);
+
+  // リソースのサイズ（インデックス数 * インデックス1つのサイズ）
+  size_t sizeInBytes = indexSize * indices.size();
+  indexCount_ = static_cast<uint32_t>(indices.size());
+  // LODの範囲は呼び出し側で上書きする (既定は全体を LOD0 とする)
+  lods_.assign(1, MeshLod{0, indexCount_, 0.0f});
+  subMeshes_.clear();
+  materials_.clear();
+  // メッシュレットは元のインデックスを指しているので作り直すまで使わない
+  meshlets_ = {};
 
   // リソース作成
   indexResource_ =
@@ -557,50 +543,123 @@ void Model::CreateIndexResource() {
   // インデックスバッファビューの作成
   indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
   indexBufferView_.SizeInBytes = UINT(sizeInBytes);
-  indexBufferView_.Format = DXGI_FORMAT_R32_UINT; // uint32_tを使用
+  indexBufferView_.Format = is16Bit ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
 
   // データの書き込み
-  uint32_t *mappedIndex = nullptr;
-  indexResource_->Map(0, nullptr, reinterpret_cast<void **>(&mappedIndex));
-  std::memcpy(mappedIndex, modelData_.indices.data(), sizeInBytes);
+  void *mappedIndex = nullptr;
+  indexResource_->Map(0, nullptr, &mappedIndex);
+  if (is16Bit) {
+    uint16_t *mappedIndex16 = static_cast<uint16_t *>(mappedIndex);
+    for (size_t i = 0; i < indices.size(); ++i) {
+      mappedIndex16[i] = static_cast<uint16_t>(indices[i]);
+    }
+  } else {
+    std::memcpy(mappedIndex, indices.data(), sizeInBytes);
+  }
   indexResource_->Unmap(0, nullptr);
 }
 
 // 頂点バッファの作成
-void Model::CreateVertexResource() {
+void Model::CreateVertexResource(std::span<const VertexData> vertices) {
+  // 希望の形式で誤差が許容範囲に収まるかを確かめて、実際の形式を決める
+  vertexFormat_ =
+      VertexQuantization::ChooseVertexFormat(vertices, requestedVertexFormat_);
+  vertexCount_ = static_cast<uint32_t>(vertices.size());
+  const size_t stride = VertexQuantization::GetVertexStride(vertexFormat_);
 
 #pragma region リソースとバッファビューの作成
   // リソースとバッファビューの作成
 
   // VertexResourceを作る
   vertexResource_ = DX12Context::GetInstance()->CreateBufferResource(
-      sizeof(VertexData) * modelData_.vertices.size());
+      stride * vertices.size());
 
   // VertexBufferViewを作成する
   // リソースの先頭アドレスから使う
   vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
-  // 使用するリソースのサイズは頂点6つ分のサイズ
-  vertexBufferView_.SizeInBytes =
-      UINT(sizeof(VertexData) * modelData_.vertices.size());
+  // 使用するリソースのサイズは頂点数分のサイズ
+  vertexBufferView_.SizeInBytes = UINT(stride * vertices.size());
   // １頂点当たりのサイズ
-  vertexBufferView_.StrideInBytes = sizeof(VertexData);
+  vertexBufferView_.StrideInBytes = UINT(stride);
 
 #pragma endregion ここまで
 
 #pragma region VertexDataの設定
   // VertexDataの設定
 
-  // 書き込むためのアドレスを取得
-  vertexResource_->Map(
-      0, nullptr,
-      reinterpret_cast<void **>(&vertexData_)); // 書き込むためのアドレスを取得
-  std::memcpy(vertexData_, modelData_.vertices.data(),
-              sizeof(VertexData) *
-                  modelData_.vertices.size()); // 頂点データをリソースにコピー
+  if (vertexFormat_ == kVertexFormatFull) {
+    // 書き込むためのアドレスを取得
+    vertexResource_->Map(
+        0, nullptr,
+        reinterpret_cast<void **>(&vertexData_)); // 書き込むためのアドレスを取得
+    std::memcpy(vertexData_, vertices.data(),
+                sizeof(VertexData) *
+                    vertices.size()); // 頂点データをリソースにコピー
+  } else {
+    // 圧縮形式はアップロードバッファへ直接変換しながら書き込む
+    void *mappedVertex = nullptr;
+    vertexResource_->Map(0, nullptr, &mappedVertex);
+    VertexQuantization::EncodeVertices(vertices, vertexFormat_, mappedVertex);
+    vertexResource_->Unmap(0, nullptr);
+    vertexData_ = nullptr;
+  }
 
 #pragma endregion ここまで
 }
 
+void Model::LogMemoryReport(const std::string &name,
+                            std::span<const VertexData> vertices) const {
+  static const char *const kFormatNames[kCountOfVertexFormat] = {
+      "full", "compact", "compact-half"};
+
+  const size_t vertexBytes = vertexBufferView_.SizeInBytes;
+  const size_t indexBytes = indexBufferView_.SizeInBytes;
+  // 非圧縮 (36バイト頂点・32bitインデックス) の場合のサイズ
+  const size_t fullBytes =
+      sizeof(VertexData) * vertexCount_ + sizeof(uint32_t) * indexCount_;
+  const VertexQuantization::QuantizationError error =
+      VertexQuantization::MeasureError(vertices, vertexFormat_);
+
+  Logger::Log(std::format(
+      "INFO: Model memory: {} [{}] vertices {} x {}B, indices {} x {}B "
+      "({} LODs, {} submeshes) = "
+      "{:.1f} KB ({:.0f}% of {:.1f} KB), error pos {:.2e} uv {:.2e} normal "
+      "{:.2e} rad\n",
+      name, kFormatNames[vertexFormat_], vertexCount_,
+      vertexBufferView_.StrideInBytes, indexCount_,
+      indexBufferView_.Format == DXGI_FORMAT_R16_UINT ? 2 : 4, lods_.size(),
+      subMeshes_.size(),
+      (vertexBytes + indexBytes) / 1024.0,
+      fullBytes > 0 ? 100.0 * (vertexBytes + indexBytes) / fullBytes : 100.0,
+      fullBytes / 1024.0, error.position, error.texcoord, error.normalAngle));
+}
+
+void Model::BuildMeshlets(const std::string &name,
+                          std::span<const uint32_t> indices,
+                          std::span<const VertexData> vertices) {
+  // CreateIndexResource と LOD・サブメッシュの設定の後に呼ぶこと (LOD0 の範囲だけを分ける)
+  const MeshLod &lod0 = lods_[0];
+  if (lod0.indexCount / 3 < kMeshletMinTriangles) {
+    return;
+  }
+  const auto startTime = std::chrono::steady_clock::now();
+  // メッシュレットがマテリアルをまたがないよう、サブメッシュごとに分ける
+  std::vector<SubMesh> groups(
+      subMeshes_.begin() + lod0.subMeshOffset,
+      subMeshes_.begin() + lod0.subMeshOffset + lod0.subMeshCount);
+  if (groups.empty()) {
+    groups.push_back({0, lod0.indexOffset, lod0.indexCount});
+  }
+  meshlets_ = MeshletBuilder::Build(indices, vertices, groups);
+  Logger::Log(std::format(
+      "INFO: Model meshlets: {} {} triangles -> {} meshlets ({} groups) in "
+      "{:.3f} ms\n",
+      name, lod0.indexCount / 3, meshlets_.meshlets.size(), groups.size(),
+      std::chrono::duration<double, std::milli>(
+          std::chrono::steady_clock::now() - startTime)
+          .count()));
+}
+
 // マテリアルバッファの作成
 void Model::CreateMaterialResource() {
 
@@ -640,7 +699,7 @@ void Model::CreateMaterialResource() {
 
 void Model::SetDissolveMaskTexture(const std::string &filePath) {
   dissolveMaskFilePath_ = filePath;
-  TextureManager::GetInstance()->LoadTexture(dissolveMaskFilePath_);
+  TextureManager::GetInstance()->RequestTexture(dissolveMaskFilePath_);
 }
 
 void Model::SetDissolveParams(int32_t enable, float threshold, float edgeRange, const Vector3 &edgeColor) {
@@ -2,10 +2,15 @@
 
 #include "Types/ModelTypes.h"
 #include "Types/ParticleTypes.h"
+#include "MeshImporter.h"
+#include "MeshletBuilder.h"
+#include "PrimitiveMesh.h"
 
 #include <d3d12.h>
 #include <wrl/client.h>
+#include <span>
 #include <string>
+#include <vector>
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -28,13 +33,28 @@ private: // メンバ変数
   // インデックスデータ用リソース
   ComPtr<ID3D12Resource> indexResource_ = nullptr;
   D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+  // 描画インデックス数 (全LODの合計。キャッシュから読んだ場合は modelData_.indices は空)
+  uint32_t indexCount_ = 0;
+  // LODごとの描画範囲 (LODが無いモデルでも LOD0 の1つは必ずある)
+  std::vector<MeshLod> lods_;
+  // サブメッシュ (全LOD分) とそのマテリアル。空の場合は LOD 全体を modelData_.material で描く
+  std::vector<SubMesh> subMeshes_;
+  std::vector<MaterialData> materials_;
 
   // バッファリソース
   ComPtr<ID3D12Resource> vertexResource_ = nullptr;
   // バッファリソース内の使い道を捕捉するバッファビュー
   D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
-  // バッファリソース内のデータを表すポインタ
+  // バッファリソース内のデータを表すポインタ (圧縮形式の場合は書き込み後にアンマップするので nullptr)
   VertexData *vertexData_ = nullptr;
+  // 頂点数
+  uint32_t vertexCount_ = 0;
+  // 希望する頂点バッファの形式 (初期化前に設定する)
+  VertexFormat requestedVertexFormat_ = kVertexFormatFull;
+  // 実際に使っている頂点バッファの形式 (誤差が大きい場合は希望より大きい形式になる)
+  VertexFormat vertexFormat_ = kVertexFormatFull;
+  // LOD0 のメッシュレット (大きいモデルのみ。Object3d がクラスタカリングに使う)
+  MeshletData meshlets_;
 
   // マテリアルデータ
 
@@ -46,11 +66,33 @@ private: // メンバ変数
   // Dissolveマスク用テクスチャパス
   std::string dissolveMaskFilePath_ = "masks/noise0.png";
 
+  // 現在の頂点・インデックスを生成したプリミティブ設定のハッシュ (ファイルから読んだモデルは 0)
+  uint64_t primitiveMeshKey_ = 0;
+
+public: // 定数
+  // LODの誤差を画面上でこのピクセル数まで許容する
+  static constexpr float kLodPixelError = 1.0f;
+  // テクスチャを持たないマテリアルに使うテクスチャ
+  static constexpr const char *kDefaultTextureFilePath = "white.png";
+  // LOD0 の三角形がこの数以上のモデルはメッシュレットを作る (小さいモデルはカリングの手間の方が大きい)
+  static constexpr uint32_t kMeshletMinTriangles = 512;
+
+public: // 型
+  // GPUリソースを作る前のメッシュの読み込み結果
+  using MeshSource = MeshImporter::MeshSource;
+
 public: // メンバ関数
   // 初期化(テクスチャロードでコマンドリスト積んでいるので注意)
   void Initialize(const std::string &directoryPath,
                   const std::string &filename);
 
+  // メッシュの読み込みのみ行う (D3D12を使わないので、ワーカースレッドから呼び出せる)
+  static MeshSource LoadMeshSource(const std::string &directoryPath,
+                                   const std::string &filename);
+
+  // 読み込み済みのメッシュから初期化する (GPUリソースを作るので描画スレッドで呼ぶこと)
+  void Initialize(MeshSource &&source);
+
   // リングプリミティブの生成
   void CreateRing(const std::string &textureFilePath, float innerRadius, float outerRadius, uint32_t division);
   void CreateRing(const std::string &textureFilePath, const RingSettings& settings);
@@ -61,13 +103,51 @@ public: // メンバ関数
   // 平面プリミティブの生成
   void CreatePlane(const std::string &textureFilePath, const PlaneSettings& settings);
 
-  // 描画処理
-  void Draw();
+  // 描画時にモデルのものの代わりに使うもの (Object3d がインスタンスごとに持つ)
+  // インデックス・テクスチャはモデルのものを共有し、定数バッファ・Dissolveマスク・頂点だけを差し替える
+  struct DrawOverride {
+    D3D12_GPU_VIRTUAL_ADDRESS materialAddress = 0; // Material の定数バッファ (0 ならモデルのもの)
+    const std::string *dissolveMaskFilePath = nullptr; // nullptr ならモデルのもの
+    const D3D12_VERTEX_BUFFER_VIEW *vertexBufferView = nullptr; // スキニング後の頂点など (nullptr ならモデルのもの)
+  };
+
+  // 描画処理 (lodIndex は SelectLod で選んだもの。サブメッシュごとにテクスチャを切り替えて描く)
+  void Draw(uint32_t lodIndex = 0, const DrawOverride *drawOverride = nullptr);
+
+  /// <summary>
+  /// 別のインデックスバッファで LOD0 を描画する (クラスタカリング後のインデックスなど。頂点番号はこのモデルのもの)
+  /// </summary>
+  /// <param name="indexBufferView">インデックスバッファ</param>
+  /// <param name="groupIndexOffsets">LOD0 のサブメッシュごとの開始位置 (最後に総数。サブメッシュが無い場合は全体で1つ)</param>
+  /// <param name="drawOverride">インスタンスごとに差し替えるもの (nullptr ならモデルのもの)</param>
+  void DrawIndices(const D3D12_INDEX_BUFFER_VIEW &indexBufferView,
+                   std::span<const uint32_t> groupIndexOffsets,
+                   const DrawOverride *drawOverride = nullptr);
+
+  /// <summary>
+  /// 画面上の誤差が kLodPixelError 以下に収まる、最も粗いLODを選ぶ
+  /// </summary>
+  /// <param name="pixelsPerUnit">モデル空間の長さ1が画面上で何ピクセルになるか</param>
+  /// <returns>LOD番号</returns>
+  uint32_t SelectLod(float pixelsPerUnit) const;
 
   // getter
 
-  // RootNodeを取得するGetter
-  const Node& GetRootNode() const { return modelData_.rootNode; }
+  // ノード階層を取得するGetter (0 番がルート)
+  const NodeHierarchy& GetNodes() const { return modelData_.nodes; }
+
+  // スキン (頂点ごとのジョイントの影響) を持つか
+  bool IsSkinned() const { return !modelData_.joints.empty(); }
+  // スキニング前の頂点 (スキンを持つモデルはキャッシュを通らないので、必ず CPU 側に残っている)
+  std::span<const VertexData> GetBindPoseVertices() const { return modelData_.vertices; }
+  std::span<const VertexInfluence> GetInfluences() const { return modelData_.influences; }
+  std::span<const Joint> GetJoints() const { return modelData_.joints; }
+
+  // アニメーションの取得 (読み込み時に AnimationCompressor で圧縮したもの)
+  uint32_t GetAnimationCount() const { return static_cast<uint32_t>(modelData_.compressedAnimations.size()); }
+  const CompressedAnimationClip &GetAnimation(uint32_t index) const { return modelData_.compressedAnimations[index]; }
+  // 名前からアニメーションを探す (見つからなければ -1)
+  int32_t FindAnimation(const std::string &name) const;
 
   // 色の取得
   const Vector4 &GetColor() const { return materialData_->color; }
@@ -82,10 +162,25 @@ public: // メンバ関数
     return materialData_->environmentCoefficient;
   }
 
+  // マテリアルの定数の取得 (インスタンスごとのマテリアルの初期値に使う)
+  const Material &GetMaterialData() const { return *materialData_; }
+
   // バッファビューの取得
   const D3D12_VERTEX_BUFFER_VIEW &GetVertexBufferView() const { return vertexBufferView_; }
   const D3D12_INDEX_BUFFER_VIEW &GetIndexBufferView() const { return indexBufferView_; }
-  uint32_t GetIndexCount() const { return static_cast<uint32_t>(modelData_.indices.size()); }
+  // サブメッシュの取得 (LODごとの範囲は MeshLod::subMeshOffset / subMeshCount)
+  uint32_t GetSubMeshCount() const { return static_cast<uint32_t>(subMeshes_.size()); }
+  const SubMesh &GetSubMesh(uint32_t index) const { return subMeshes_[index]; }
+  const MaterialData &GetMaterial(uint32_t index) const { return materials_[index]; }
+  // LOD0 のインデックス数 (LOD1 以降は LOD0 の後ろに並んでいる)
+  uint32_t GetIndexCount() const { return lods_.empty() ? 0 : lods_[0].indexCount; }
+  uint32_t GetLodCount() const { return static_cast<uint32_t>(lods_.size()); }
+  const MeshLod &GetLod(uint32_t lodIndex) const { return lods_[lodIndex]; }
+  // 頂点の範囲 (モデル空間。スキンを持つモデルはバインドポーズのもの。サブメッシュごとの範囲は GetSubMesh で取る)
+  const Bounds &GetBounds() const { return modelData_.bounds; }
+  bool HasMeshlets() const { return !meshlets_.meshlets.empty(); }
+  const MeshletData &GetMeshlets() const { return meshlets_; }
+  VertexFormat GetVertexFormat() const { return vertexFormat_; }
   const std::string& GetTextureFilePath() const { return modelData_.material.textureFilePath; }
 
 #ifdef USE_IMGUI
@@ -96,6 +191,9 @@ public: // メンバ関数
 
   // setter
 
+  // 頂点バッファの形式を設定する (初期化より前に呼ぶこと。圧縮形式は Object3d の描画でのみ使える)
+  void SetVertexFormat(VertexFormat format) { requestedVertexFormat_ = format; }
+
   // 色の設定
   void SetColor(const Vector4 &color) { materialData_->color = color; }
 
@@ -122,18 +220,45 @@ public: // メンバ関数
 
 private: // メンバ関数
   // .objファイルの読み取り
-  void LoadModelFile(const std::string &directoryPath,
-                   const std::string &fileName);
+  static void LoadModelFile(const std::string &directoryPath,
+                            const std::string &fileName, ModelData &modelData);
 
-  // assimpのノードを変換
-  Node ReadNode(aiNode* node);
+  // assimpのノード階層を親が子より前に並ぶ配列に変換
+  static void ReadNodes(aiNode* rootNode, NodeHierarchy& nodes);
+
+  // assimpのアニメーションを変換 (ReadNodes の後に呼ぶ)
+  static void ReadAnimations(const aiScene* scene, ModelData& modelData);
 
   // インデックスバッファ作成用関数
-  void CreateIndexResource();
+  void CreateIndexResource(std::span<const uint32_t> indices);
 
   // 頂点データの作成
-  void CreateVertexResource();
+  void CreateVertexResource(std::span<const VertexData> vertices);
 
   // マテリアルバッファの作成
   void CreateMaterialResource();
+
+  // LOD0 のメッシュレットをサブメッシュごとに作る (三角形が kMeshletMinTriangles 未満なら作らない)
+  void BuildMeshlets(const std::string &name, std::span<const uint32_t> indices,
+                     std::span<const VertexData> vertices);
+
+  // サブメッシュのテクスチャを読み込む (テクスチャの無いマテリアルは kDefaultTextureFilePath)
+  void LoadMaterialTextures();
+
+  // 頂点・マテリアル・Dissolveマスクを設定する (インデックスバッファとテクスチャは呼び出し側で設定する)
+  void SetDrawResources(const DrawOverride *drawOverride);
+
+  // テクスチャを設定して範囲を描画する
+  void DrawRange(const MaterialData &material, uint32_t indexCount, uint32_t indexOffset);
+
+  // GPUメモリの使用量と圧縮誤差をログに出す
+  void LogMemoryReport(const std::string &name,
+                       std::span<const VertexData> vertices) const;
+
+  // 既存のGPUリソースをフェンス完了後に解放する (再生成時用)
+  void ReleaseResourcesDeferred();
+
+  // プリミティブの生成 (meshKey が前回と同じなら頂点・インデックス・マテリアルはそのまま使い、テクスチャだけ差し替える)
+  void CreatePrimitive(const std::string &textureFilePath, const char *nodeName, uint64_t meshKey,
+                       const ShapeMeshBuilder &builder);
 };
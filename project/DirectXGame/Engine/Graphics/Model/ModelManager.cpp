@@ -3,7 +3,9 @@
 
 #include "../../Core/Utility/Logger/Logger.h"
 #include "../../Core/Utility/String/StringUtility.h"
+#include "../../Core/Utility/Thread/ThreadUtility.h"
 
+#include <algorithm>
 #include <cassert>
 #include <filesystem>
 #include <format>
@@ -34,6 +36,12 @@ ModelManager::ModelManager(Token) {
     // コンストラクタ
 }
 
+ModelManager::~ModelManager() {
+  // 未処理の読み込みは破棄する (ハンドルは broken_promise になる)
+  StopWorkers();
+  pendingLoads_.clear();
+}
+
 // 終了
 void ModelManager::Finalize() {
   instance_.reset();
@@ -49,8 +57,8 @@ Model *ModelManager::FindModel(const std::string &filePath) {
   return nullptr;
 }
 
-void ModelManager::LoadModel(const std::string &directoryPath,
-                             const std::string &filePath) {
+std::string ModelManager::ResolveDirectoryPath(const std::string &directoryPath,
+                                              const std::string &filePath) {
     std::string fullDirectoryPath = directoryPath;
 
     // directoryPath 自体が "Resources/" を含んでいない場合のみ、ベースパスを付与する
@@ -64,6 +72,13 @@ void ModelManager::LoadModel(const std::string &directoryPath,
         Logger::Log("ERROR: Model file not found at: " + fullDirectoryPath + "/" + filePath);
         assert(false && "Model file not found!");
     }
+    return fullDirectoryPath;
+}
+
+void ModelManager::LoadModel(const std::string &directoryPath,
+                             const std::string &filePath,
+                             VertexFormat vertexFormat) {
+  std::string fullDirectoryPath = ResolveDirectoryPath(directoryPath, filePath);
 
   // --- 読み込み済みモデルを検索し、存在すれば早期return ---
   if (models_.contains(filePath)) {
@@ -71,10 +86,29 @@ void ModelManager::LoadModel(const std::string &directoryPath,
     return;
   }
 
+  // 非同期で読み込み中なら、それを待って使う (二重に読み込まない)
+  auto pending = std::find_if(pendingLoads_.begin(), pendingLoads_.end(),
+                              [&](const PendingLoad &load) { return load.filePath == filePath; });
+  if (pending != pendingLoads_.end()) {
+    // 形式は先に依頼した方で決まる (同じモデルを別の形式で使うことはできない)
+    if (pending->vertexFormat != vertexFormat) {
+      Log(std::format("WARNING: Model {} is already loading with vertex format {}, requested {}\n",
+                      filePath, static_cast<int>(pending->vertexFormat), static_cast<int>(vertexFormat)));
+      assert(false && "Model is already loading with a different vertex format!");
+    }
+    FinishLoad(*pending);
+    pendingLoads_.erase(pending);
+    if (models_.contains(filePath)) {
+      return;
+    }
+    // 非同期の読み込みに失敗した場合は、ここで読み直す
+  }
+
   // --- モデルの生成とファイル読み込み、初期化 ---
   // unique_ptrでModelのインスタンスを生成
   std::unique_ptr<Model> model = std::make_unique<Model>();
 
+  model->SetVertexFormat(vertexFormat);
   model->Initialize(fullDirectoryPath, filePath);
   Log("INFO: Loaded model at path: " + fullDirectoryPath + "/" + filePath + "\n");
 
@@ -83,6 +117,194 @@ void ModelManager::LoadModel(const std::string &directoryPath,
   models_.insert(std::make_pair(filePath, std::move(model)));
 }
 
+std::vector<ModelManager::ModelHandle>
+ModelManager::LoadModelsAsync(const std::vector<LoadRequest> &requests) {
+  std::vector<ModelHandle> handles;
+  handles.reserve(requests.size());
+
+  StartWorkers();
+
+  for (const LoadRequest &request : requests) {
+    // 読み込み済みなら、すぐに使えるハンドルを返す
+    if (Model *model = FindModel(request.filePath)) {
+      std::promise<Model *> ready;
+      ready.set_value(model);
+      handles.push_back(ready.get_future().share());
+      continue;
+    }
+
+    // 読み込み中なら、同じハンドルを返す
+    auto pending = std::find_if(pendingLoads_.begin(), pendingLoads_.end(),
+                                [&](const PendingLoad &load) { return load.filePath == request.filePath; });
+    if (pending != pendingLoads_.end()) {
+      if (pending->vertexFormat != request.vertexFormat) {
+        Log(std::format("WARNING: Model {} is already loading with vertex format {}, requested {}\n",
+                        request.filePath, static_cast<int>(pending->vertexFormat),
+                        static_cast<int>(request.vertexFormat)));
+        assert(false && "Model is already loading with a different vertex format!");
+      }
+      handles.push_back(pending->handle);
+      continue;
+    }
+
+    std::string fullDirectoryPath = ResolveDirectoryPath(request.directoryPath, request.filePath);
+
+    // ワーカースレッドで行うのはファイル読み込みとメッシュ変換のみ (D3D12 は触らない)
+    std::packaged_task<Model::MeshSource()> job(
+        [fullDirectoryPath, filePath = request.filePath]() {
+          return Model::LoadMeshSource(fullDirectoryPath, filePath);
+        });
+
+    PendingLoad load;
+    load.filePath = request.filePath;
+    load.vertexFormat = request.vertexFormat;
+    load.source = job.get_future();
+    load.handle = load.promise.get_future().share();
+    load.requestTime = std::chrono::steady_clock::now();
+    handles.push_back(load.handle);
+    pendingLoads_.push_back(std::move(load));
+
+    {
+      std::lock_guard<std::mutex> lock(jobMutex_);
+      jobs_.push_back(std::move(job));
+    }
+    jobCondition_.notify_one();
+  }
+
+  return handles;
+}
+
+void ModelManager::Update() { FinishLoads(false); }
+
+void ModelManager::WaitForPendingLoads() { FinishLoads(true); }
+
+void ModelManager::FinishLoads(bool wait) {
+  if (pendingLoads_.empty()) {
+    return;
+  }
+
+  auto batchStart = std::chrono::steady_clock::now();
+  size_t finishedCount = 0;
+
+  // 読み込みが終わったものから順に、まとめてGPUリソースを生成する
+  for (auto it = pendingLoads_.begin(); it != pendingLoads_.end();) {
+    bool isReady = wait || it->source.wait_for(std::chrono::seconds(0)) ==
+                               std::future_status::ready;
+    if (!isReady) {
+      ++it;
+      continue;
+    }
+    FinishLoad(*it);
+    it = pendingLoads_.erase(it);
+    ++finishedCount;
+  }
+
+  if (finishedCount > 0) {
+    double batchMilliseconds = std::chrono::duration<double, std::milli>(
+                                   std::chrono::steady_clock::now() - batchStart)
+                                   .count();
+    Log(std::format("INFO: Model batch finished: {} models, gpu {:.2f} ms, {} pending, {} workers\n",
+                    finishedCount, batchMilliseconds, pendingLoads_.size(), workers_.size()));
+  }
+}
+
+void ModelManager::FinishLoad(PendingLoad &pending) {
+  // ワーカーで投げられた例外はここで受け取り、ハンドルに渡す
+  // (FinishLoads を抜けると、残りの読み込みが pendingLoads_ に取り残されるため)
+  Model::MeshSource source;
+  try {
+    source = pending.source.get();
+  } catch (const std::exception &e) {
+    Log(std::format("ERROR: Failed to load model {}: {}\n", pending.filePath, e.what()));
+    pending.promise.set_exception(std::current_exception());
+    return;
+  } catch (...) {
+    Log(std::format("ERROR: Failed to load model {}: unknown exception\n", pending.filePath));
+    pending.promise.set_exception(std::current_exception());
+    return;
+  }
+
+  // 待っている間に同期読み込みで登録されていれば、そちらを使う
+  if (Model *model = FindModel(pending.filePath)) {
+    pending.promise.set_value(model);
+    return;
+  }
+
+  auto gpuStart = std::chrono::steady_clock::now();
+
+  std::string fullPath = source.fullPath;
+  double parseMilliseconds = source.loadMilliseconds;
+  MeshImporter::Reader reader = source.reader;
+
+  std::unique_ptr<Model> model = std::make_unique<Model>();
+  model->SetVertexFormat(pending.vertexFormat);
+  model->Initialize(std::move(source));
+
+  auto now = std::chrono::steady_clock::now();
+  double gpuMilliseconds = std::chrono::duration<double, std::milli>(now - gpuStart).count();
+  double totalMilliseconds = std::chrono::duration<double, std::milli>(now - pending.requestTime).count();
+  Log(std::format("INFO: Loaded model at path: {} (parse {:.2f} ms [{}], gpu {:.2f} ms, total {:.2f} ms)\n",
+                  fullPath, parseMilliseconds, MeshImporter::GetReaderName(reader),
+                  gpuMilliseconds, totalMilliseconds));
+
+  Model *result = model.get();
+  models_.insert(std::make_pair(pending.filePath, std::move(model)));
+  pending.promise.set_value(result);
+}
+
+void ModelManager::StartWorkers() {
+  if (!workers_.empty()) {
+    return;
+  }
+
+  // 描画スレッドの分を1つ残す (取得できない環境では0が返る)
+  unsigned int hardwareCount = std::thread::hardware_concurrency();
+  unsigned int workerCount = hardwareCount > 1 ? hardwareCount - 1 : 1;
+  isStopping_ = false;
+  workers_.reserve(workerCount);
+  for (unsigned int i = 0; i < workerCount; ++i) {
+    workers_.emplace_back(&ModelManager::WorkerMain, this);
+  }
+}
+
+void ModelManager::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    isStopping_ = true;
+    // 未着手の依頼は破棄する
+    jobs_.clear();
+  }
+  jobCondition_.notify_all();
+
+  for (std::thread &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+void ModelManager::WorkerMain() {
+  // 読み込み中の処理 (ObjLoader など) がさらにスレッドを立てないようにする
+  ThreadUtility::MarkWorkerThread();
+
+  while (true) {
+    std::packaged_task<Model::MeshSource()> job;
+    {
+      std::unique_lock<std::mutex> lock(jobMutex_);
+      jobCondition_.wait(lock, [this] { return isStopping_ || !jobs_.empty(); });
+      if (isStopping_) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+
+    // 例外は future 経由で描画スレッドに伝わる
+    job();
+  }
+}
+
 void ModelManager::CreateRing(const std::string& name, const std::string& textureFilePath, float innerRadius, float outerRadius, uint32_t division) {
     // すでに存在すれば早期リターン
     if (models_.contains(name)) {
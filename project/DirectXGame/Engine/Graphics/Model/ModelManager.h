@@ -1,11 +1,17 @@
 #pragma once
 
+#include "Model.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <map>
-#include <string>
 #include <memory>
-
-// 前方宣言
-class Model;
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 // モデルマネージャー
 class ModelManager {
@@ -17,12 +23,43 @@ public:
     Token() {}
   };
 
+  // 非同期読み込みの依頼
+  struct LoadRequest {
+    std::string directoryPath; // モデルファイルのディレクトリパス
+    std::string filePath;      // モデルファイルのパス
+    VertexFormat vertexFormat = kVertexFormatFull; // 頂点バッファの形式
+  };
+
+  // 非同期読み込みの結果 (GPUリソースの生成まで終わると Model* が取れる。読み込みに失敗した場合 get() は例外を投げる)
+  using ModelHandle = std::shared_future<Model *>;
+
+private: // 内部構造体
+  // 読み込み中のモデル
+  struct PendingLoad {
+    std::string filePath;                     // モデルの登録名
+    VertexFormat vertexFormat = kVertexFormatFull;
+    std::future<Model::MeshSource> source;    // ワーカーでの読み込み結果
+    std::promise<Model *> promise;            // 呼び出し側に返すハンドルの元
+    ModelHandle handle;
+    std::chrono::steady_clock::time_point requestTime;
+  };
+
 private: // namespace省略のためのusing宣言
   static std::unique_ptr<ModelManager> instance_;
 
   // モデルデータ
   std::map<std::string, std::unique_ptr<Model>> models_;
 
+  // 読み込み中のモデル (GPUリソースの生成待ち)
+  std::vector<PendingLoad> pendingLoads_;
+
+  // ワーカースレッド (メッシュの読み込み・変換のみを行う)
+  std::vector<std::thread> workers_;
+  std::deque<std::packaged_task<Model::MeshSource()>> jobs_;
+  std::mutex jobMutex_;
+  std::condition_variable jobCondition_;
+  bool isStopping_ = false;
+
   public: // シングルトンインスタンス取得
     static ModelManager* GetInstance();
     static void Destroy();
@@ -48,7 +85,27 @@ public: // メンバ関数
   /// </summary>
   /// <param name="directoryPath">モデルファイルのディレクトリパス</param>
   /// <param name="filePath">モデルファイルのパス</param>
-  void LoadModel(const std::string &directoryPath, const std::string &filePath);
+  /// <param name="vertexFormat">頂点バッファの形式 (圧縮形式は Object3d の描画でのみ使える)</param>
+  void LoadModel(const std::string &directoryPath, const std::string &filePath,
+                 VertexFormat vertexFormat = kVertexFormatFull);
+
+  /// <summary>
+  /// モデルファイルの非同期一括読み込み
+  /// メッシュの読み込み・変換はワーカースレッドで並列に行い、
+  /// GPUリソースの生成は Update / WaitForPendingLoads でまとめて行う
+  /// </summary>
+  /// <param name="requests">読み込むモデルの一覧</param>
+  /// <returns>requests と同じ順番のハンドル</returns>
+  std::vector<ModelHandle> LoadModelsAsync(const std::vector<LoadRequest> &requests);
+
+  // 毎フレームの更新 (読み込みが終わったモデルのGPUリソースを生成する)
+  void Update();
+
+  // 読み込み中のモデルがすべて使えるようになるまで待つ
+  void WaitForPendingLoads();
+
+  // 読み込み中のモデル数
+  size_t GetPendingLoadCount() const { return pendingLoads_.size(); }
 
   /// <summary>
   /// Ringプリミティブの生成
@@ -60,9 +117,24 @@ public: // メンバ関数
   /// <param name="division">分割数</param>
   void CreateRing(const std::string& name, const std::string& textureFilePath, float innerRadius = 0.5f, float outerRadius = 1.0f, uint32_t division = 32);
 
+  // "Resources/" から始まるディレクトリパスに変換し、ファイルの存在を確認する
+  static std::string ResolveDirectoryPath(const std::string &directoryPath,
+                                          const std::string &filePath);
+
 private: // メンバ関数
+  // 読み込みが終わったモデルのGPUリソースをまとめて生成する (wait = true なら全件待つ)
+  void FinishLoads(bool wait);
+  // 1件分のGPUリソースを生成し、モデルを登録する
+  void FinishLoad(PendingLoad &pending);
+
+  // ワーカースレッドの起動・停止
+  void StartWorkers();
+  void StopWorkers();
+  // ワーカースレッドのメインループ
+  void WorkerMain();
+
   // デストラクタ(隠蔽)
-  ~ModelManager() = default;
+  ~ModelManager();
   // コピーコンストラクタの封印
   ModelManager(const ModelManager &) = delete;
   // コピー代入演算子の封印
@@ -0,0 +1,91 @@
+#include "NodeTransform.h"
+
+#include <cassert>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define NODE_TRANSFORM_USE_SSE
+#endif
+
+namespace NodeTransform {
+
+uint32_t AddNode(NodeHierarchy& nodes, const std::string& name, const Matrix4x4& localMatrix, int32_t parent) {
+    const uint32_t index = nodes.GetNodeCount();
+    assert(parent < static_cast<int32_t>(index) && "parent must be added before its children");
+
+    // 名前を共有する (ノード数は多くても数百なので線形探索で足りる)
+    uint32_t nameId = static_cast<uint32_t>(nodes.names.size());
+    for (uint32_t i = 0; i < nodes.names.size(); ++i) {
+        if (nodes.names[i] == name) {
+            nameId = i;
+            break;
+        }
+    }
+    if (nameId == nodes.names.size()) {
+        nodes.names.push_back(name);
+    }
+
+    nodes.localMatrices.push_back(localMatrix);
+    nodes.parents.push_back(parent);
+    nodes.nameIds.push_back(nameId);
+    return index;
+}
+
+int32_t FindNode(const NodeHierarchy& nodes, std::string_view name) {
+    for (uint32_t nameId = 0; nameId < nodes.names.size(); ++nameId) {
+        if (nodes.names[nameId] != name) {
+            continue;
+        }
+        for (uint32_t i = 0; i < nodes.nameIds.size(); ++i) {
+            if (nodes.nameIds[i] == nameId) {
+                return static_cast<int32_t>(i);
+            }
+        }
+    }
+    return -1;
+}
+
+Matrix4x4 Multiply(const Matrix4x4& a, const Matrix4x4& b) {
+    Matrix4x4 result;
+#ifdef NODE_TRANSFORM_USE_SSE
+    // 結果の i 行目 = a[i][0] * b の0行目 + ... + a[i][3] * b の3行目
+    const __m128 b0 = _mm_loadu_ps(b.m[0]);
+    const __m128 b1 = _mm_loadu_ps(b.m[1]);
+    const __m128 b2 = _mm_loadu_ps(b.m[2]);
+    const __m128 b3 = _mm_loadu_ps(b.m[3]);
+    for (int i = 0; i < 4; ++i) {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a.m[i][0]), b0);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][1]), b1));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][2]), b2));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][3]), b3));
+        _mm_storeu_ps(result.m[i], row);
+    }
+#else
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] +
+                             a.m[i][3] * b.m[3][j];
+        }
+    }
+#endif
+    return result;
+}
+
+void ComputeWorldMatrices(std::span<const int32_t> parents, std::span<const Matrix4x4> localMatrices,
+                          const Matrix4x4& baseMatrix, std::span<Matrix4x4> worldMatrices) {
+    assert(localMatrices.size() >= parents.size() && worldMatrices.size() >= parents.size());
+    // 親は必ず前にあるので、親のワールド行列は計算済み
+    for (size_t i = 0; i < parents.size(); ++i) {
+        const int32_t parent = parents[i];
+        assert(parent < static_cast<int32_t>(i));
+        const Matrix4x4& parentMatrix = parent < 0 ? baseMatrix : worldMatrices[parent];
+        worldMatrices[i] = Multiply(localMatrices[i], parentMatrix);
+    }
+}
+
+void ComputeWorldMatrices(const NodeHierarchy& nodes, const Matrix4x4& baseMatrix,
+                          std::span<Matrix4x4> worldMatrices) {
+    ComputeWorldMatrices(nodes.parents, nodes.localMatrices, baseMatrix, worldMatrices);
+}
+
+} // namespace NodeTransform
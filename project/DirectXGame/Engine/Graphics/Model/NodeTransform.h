@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+// ============================================================
+// NodeTransform — 平坦化したノード階層の構築とワールド行列の計算 (D3D12 を使わないのでワーカースレッドから呼べる)
+//   ・ノードは親が子より前に並ぶ順で追加する (親番号 < 自分の番号)
+//   ・ワールド行列は先頭から1回なめるだけで求まる (再帰もヒープ確保も無い)
+//   ・行列の積は SSE で4要素ずつ計算する
+// ============================================================
+namespace NodeTransform {
+
+/// <summary>
+/// ノードを末尾に追加する (名前は既にあれば同じ番号を使う)
+/// </summary>
+/// <param name="nodes">追加先</param>
+/// <param name="name">ノード名</param>
+/// <param name="localMatrix">親から見た変換</param>
+/// <param name="parent">親のノード番号 (-1 = 親なし。追加済みのノードであること)</param>
+/// <returns>追加したノードの番号</returns>
+uint32_t AddNode(NodeHierarchy& nodes, const std::string& name, const Matrix4x4& localMatrix, int32_t parent);
+
+/// <summary>
+/// 名前からノードを探す (同じ名前が複数ある場合は最初のもの)
+/// </summary>
+/// <returns>ノード番号 (見つからなければ -1)</returns>
+int32_t FindNode(const NodeHierarchy& nodes, std::string_view name);
+
+/// <summary>
+/// 親の並びに従ってワールド行列を求める (行ベクトル規約: world = local * parentWorld)
+/// </summary>
+/// <param name="parents">親のノード番号 (親番号 < 自分の番号)</param>
+/// <param name="localMatrices">ノードごとのローカル行列 (アニメーションで書き換えたものでもよい)</param>
+/// <param name="baseMatrix">親の無いノードにかける行列 (オブジェクトのワールド行列など)</param>
+/// <param name="worldMatrices">出力先 (ノード数以上)</param>
+void ComputeWorldMatrices(std::span<const int32_t> parents, std::span<const Matrix4x4> localMatrices,
+                          const Matrix4x4& baseMatrix, std::span<Matrix4x4> worldMatrices);
+
+// 階層のローカル行列をそのまま使う
+void ComputeWorldMatrices(const NodeHierarchy& nodes, const Matrix4x4& baseMatrix,
+                          std::span<Matrix4x4> worldMatrices);
+
+// 4x4行列の積 (a * b)
+Matrix4x4 Multiply(const Matrix4x4& a, const Matrix4x4& b);
+
+} // namespace NodeTransform
@@ -0,0 +1,461 @@
+#include "ObjLoader.h"
+#include "MeshOptimizer.h"
+#include "NodeTransform.h"
+#include "File/MappedFile.h"
+#include "Logger.h"
+#include "Math/Matrix/MatrixGenerators.h"
+#include "Thread/ThreadUtility.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace MathGenerators;
+
+namespace {
+
+// 1チャンクあたりの最小サイズ (これより小さいファイルはスレッドを分けない)
+constexpr size_t kMinChunkSize = 16 * 1024;
+
+// 頂点の重複判定キーに詰める各インデックスのビット数
+constexpr uint32_t kCornerKeyBits = 21;
+constexpr uint32_t kMaxCornerIndex = (1u << kCornerKeyBits) - 1;
+
+// Corner::relativeMask のビット
+constexpr uint8_t kRelativePosition = 1 << 0;
+constexpr uint8_t kRelativeTexcoord = 1 << 1;
+constexpr uint8_t kRelativeNormal = 1 << 2;
+
+// 面の頂点 (v/vt/vn)
+// 絶対指定は 1 始まりのまま、相対指定 (負数) はチャンク内の 0 始まりの位置に直して保持する
+struct Corner {
+    int32_t position = 0;
+    int32_t texcoord = 0;
+    int32_t normal = 0;
+    uint8_t relativeMask = 0;
+};
+
+// usemtl で切り替えたマテリアル (corners のこの位置から後に適用する)
+struct MaterialRun {
+    size_t cornerOffset = 0;
+    std::string name;
+};
+
+// 1チャンク分の解析結果
+struct ChunkResult {
+    std::vector<Vector3> positions;
+    std::vector<Vector2> texcoords;
+    std::vector<Vector3> normals;
+    std::vector<Corner> corners;           // 3つで1三角形 (巻き順反転済み)
+    std::vector<MaterialRun> materialRuns; // 最初の usemtl より前の三角形は前のチャンクのマテリアルを引き継ぐ
+    std::string materialLibrary;           // 最初に見つかった mtllib
+    std::string error;                     // 空でなければ失敗
+};
+
+// MTL のマテリアル
+struct ObjMaterial {
+    std::string name;
+    std::string texture; // map_Kd (無ければ空)
+};
+
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+const char* SkipSpaces(const char* p, const char* end) {
+    while (p < end && IsSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+// キーワード (mtllib など) の後ろの残りを、前後の空白を除いて取り出す
+std::string ReadRest(const char* p, const char* lineEnd) {
+    p = SkipSpaces(p, lineEnd);
+    const char* nameEnd = lineEnd;
+    while (nameEnd > p && IsSpace(nameEnd[-1])) {
+        --nameEnd;
+    }
+    return std::string(p, nameEnd);
+}
+
+const char* FindLineEnd(const char* p, const char* end) {
+    const void* newline = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return newline ? static_cast<const char*>(newline) : end;
+}
+
+// 空白を読み飛ばして float を1つ読む
+bool ParseFloat(const char*& p, const char* end, float& value) {
+    p = SkipSpaces(p, end);
+    if (p < end && *p == '+') {
+        ++p; // from_chars は先頭の '+' を受け付けない
+    }
+    auto [next, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+    p = next;
+    return true;
+}
+
+bool ParseInt(const char*& p, const char* end, int32_t& value) {
+    auto [next, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+    p = next;
+    return true;
+}
+
+// 面の1頂点 (v/vt/vn) を読む。UV と法線が無い形式には対応しない
+bool ParseCorner(const char*& p, const char* end, const ChunkResult& chunk, Corner& corner) {
+    int32_t indices[3] = {};
+    for (int i = 0; i < 3; ++i) {
+        if (i > 0) {
+            if (p >= end || *p != '/') {
+                return false;
+            }
+            ++p;
+        }
+        if (!ParseInt(p, end, indices[i]) || indices[i] == 0) {
+            return false;
+        }
+    }
+
+    // 相対指定はこのチャンクの要素数を基準に解決しておく (前のチャンクを指す場合は負になる)
+    const int32_t counts[3] = {
+        static_cast<int32_t>(chunk.positions.size()),
+        static_cast<int32_t>(chunk.texcoords.size()),
+        static_cast<int32_t>(chunk.normals.size()),
+    };
+    int32_t* outputs[3] = {&corner.position, &corner.texcoord, &corner.normal};
+    const uint8_t masks[3] = {kRelativePosition, kRelativeTexcoord, kRelativeNormal};
+    corner.relativeMask = 0;
+    for (int i = 0; i < 3; ++i) {
+        if (indices[i] < 0) {
+            *outputs[i] = counts[i] + indices[i];
+            corner.relativeMask |= masks[i];
+        } else {
+            *outputs[i] = indices[i];
+        }
+    }
+    return true;
+}
+
+// [begin, end) を解析する (begin は行頭、end は行末の直後であること)
+void ParseChunk(const char* begin, const char* end, ChunkResult& chunk) {
+    std::vector<Corner> polygon;
+
+    for (const char* line = begin; line < end;) {
+        const char* lineEnd = FindLineEnd(line, end);
+        const char* p = SkipSpaces(line, lineEnd);
+        const char* next = lineEnd < end ? lineEnd + 1 : end;
+
+        if (lineEnd - p >= 2 && p[0] == 'v' && IsSpace(p[1])) {
+            Vector3 position{};
+            p += 2;
+            if (!ParseFloat(p, lineEnd, position.x) || !ParseFloat(p, lineEnd, position.y) ||
+                !ParseFloat(p, lineEnd, position.z)) {
+                chunk.error = "invalid vertex position";
+                return;
+            }
+            chunk.positions.push_back(position);
+        } else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 't' && IsSpace(p[2])) {
+            // 3つ目 (w) があっても無視する
+            Vector2 texcoord{};
+            p += 3;
+            if (!ParseFloat(p, lineEnd, texcoord.x) || !ParseFloat(p, lineEnd, texcoord.y)) {
+                chunk.error = "invalid texcoord";
+                return;
+            }
+            chunk.texcoords.push_back(texcoord);
+        } else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 'n' && IsSpace(p[2])) {
+            Vector3 normal{};
+            p += 3;
+            if (!ParseFloat(p, lineEnd, normal.x) || !ParseFloat(p, lineEnd, normal.y) ||
+                !ParseFloat(p, lineEnd, normal.z)) {
+                chunk.error = "invalid normal";
+                return;
+            }
+            chunk.normals.push_back(normal);
+        } else if (lineEnd - p >= 2 && p[0] == 'f' && IsSpace(p[1])) {
+            polygon.clear();
+            p += 2;
+            while (true) {
+                p = SkipSpaces(p, lineEnd);
+                if (p >= lineEnd) {
+                    break;
+                }
+                Corner corner;
+                if (!ParseCorner(p, lineEnd, chunk, corner)) {
+                    chunk.error = "unsupported face format (v/vt/vn is required)";
+                    return;
+                }
+                polygon.push_back(corner);
+            }
+            if (polygon.size() < 3) {
+                chunk.error = "face with less than 3 vertices";
+                return;
+            }
+            // 扇形に三角形化し、巻き順を反転して格納する
+            for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                chunk.corners.push_back(polygon[i + 1]);
+                chunk.corners.push_back(polygon[i]);
+                chunk.corners.push_back(polygon[0]);
+            }
+        } else if (lineEnd - p > 7 && std::string_view(p, 6) == "usemtl" && IsSpace(p[6])) {
+            chunk.materialRuns.push_back({chunk.corners.size(), ReadRest(p + 6, lineEnd)});
+        } else if (chunk.materialLibrary.empty() && lineEnd - p > 7 &&
+                   std::string_view(p, 6) == "mtllib" && IsSpace(p[6])) {
+            chunk.materialLibrary = ReadRest(p + 6, lineEnd);
+        }
+        // o / g / s / コメントなどは描画結果に影響しないので無視する
+
+        line = next;
+    }
+}
+
+// ファイルを行境界で分割する
+std::vector<std::pair<const char*, const char*>> SplitChunks(const char* begin, const char* end) {
+    const size_t size = static_cast<size_t>(end - begin);
+    // ModelManager のワーカー上では分割しない (ワーカー自体がコア数ぶん並列に読み込んでいる)
+    const unsigned int threadCount = ThreadUtility::GetParallelThreadCount();
+    const size_t chunkCount = std::clamp<size_t>(size / kMinChunkSize, 1, threadCount);
+
+    std::vector<std::pair<const char*, const char*>> chunks;
+    chunks.reserve(chunkCount);
+    const char* chunkBegin = begin;
+    for (size_t i = 1; i <= chunkCount && chunkBegin < end; ++i) {
+        const char* chunkEnd = end;
+        if (i < chunkCount) {
+            // 目安の位置から次の改行の直後まで進める
+            const char* lineEnd = FindLineEnd(begin + size * i / chunkCount, end);
+            chunkEnd = lineEnd < end ? lineEnd + 1 : end;
+            chunkEnd = std::max(chunkEnd, chunkBegin);
+        }
+        if (chunkEnd > chunkBegin) {
+            chunks.emplace_back(chunkBegin, chunkEnd);
+        }
+        chunkBegin = chunkEnd;
+    }
+    return chunks;
+}
+
+// MTL のマテリアルを、ファイル内の順に読む
+std::vector<ObjMaterial> LoadMaterialLibrary(const std::string& mtlPath) {
+    std::vector<ObjMaterial> materials;
+    MappedFile file;
+    if (!file.Open(mtlPath)) {
+        return materials;
+    }
+    const char* begin = reinterpret_cast<const char*>(file.GetData());
+    const char* end = begin + file.GetSize();
+    for (const char* line = begin; line < end;) {
+        const char* lineEnd = FindLineEnd(line, end);
+        const char* p = SkipSpaces(line, lineEnd);
+        if (lineEnd - p > 7 && std::string_view(p, 6) == "newmtl" && IsSpace(p[6])) {
+            materials.push_back({ReadRest(p + 6, lineEnd), {}});
+        } else if (!materials.empty() && lineEnd - p > 7 && std::string_view(p, 6) == "map_Kd" && IsSpace(p[6])) {
+            // オプション (-s 1 1 1 など) が付いている場合があるので、最後の要素をファイル名とする
+            const char* nameEnd = lineEnd;
+            while (nameEnd > p && IsSpace(nameEnd[-1])) {
+                --nameEnd;
+            }
+            const char* nameBegin = nameEnd;
+            while (nameBegin > p && !IsSpace(nameBegin[-1])) {
+                --nameBegin;
+            }
+            materials.back().texture.assign(nameBegin, nameEnd);
+        }
+        line = lineEnd < end ? lineEnd + 1 : end;
+    }
+    return materials;
+}
+
+// チャンク内の位置を全体の 0 始まりのインデックスに直す
+bool ResolveIndex(int32_t index, bool isRelative, size_t chunkBase, size_t totalCount, uint32_t& result) {
+    const int64_t resolved = isRelative ? static_cast<int64_t>(chunkBase) + index : static_cast<int64_t>(index) - 1;
+    if (resolved < 0 || resolved >= static_cast<int64_t>(totalCount)) {
+        return false;
+    }
+    result = static_cast<uint32_t>(resolved);
+    return true;
+}
+
+} // namespace
+
+namespace ObjLoader {
+
+bool Load(const std::string& directoryPath, const std::string& fileName, ModelData& modelData) {
+    const std::string fullPath = directoryPath + "/" + fileName;
+
+    MappedFile file;
+    if (!file.Open(fullPath)) {
+        Logger::Log("WARNING: ObjLoader failed to open: " + fullPath + "\n");
+        return false;
+    }
+    const char* begin = reinterpret_cast<const char*>(file.GetData());
+    const char* end = begin + file.GetSize();
+
+    // --- チャンクごとに並列で解析する ---
+    const auto ranges = SplitChunks(begin, end);
+    std::vector<ChunkResult> chunks(ranges.size());
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(ranges.size() - 1);
+        for (size_t i = 1; i < ranges.size(); ++i) {
+            threads.emplace_back(ParseChunk, ranges[i].first, ranges[i].second, std::ref(chunks[i]));
+        }
+        // 先頭のチャンクは呼び出し元のスレッドで解析する
+        ParseChunk(ranges[0].first, ranges[0].second, chunks[0]);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // --- 各チャンクの要素をつなげる ---
+    size_t positionCount = 0;
+    size_t texcoordCount = 0;
+    size_t normalCount = 0;
+    size_t cornerCount = 0;
+    for (const ChunkResult& chunk : chunks) {
+        if (!chunk.error.empty()) {
+            Logger::Log(std::format("WARNING: ObjLoader cannot read {}: {}\n", fullPath, chunk.error));
+            return false;
+        }
+        positionCount += chunk.positions.size();
+        texcoordCount += chunk.texcoords.size();
+        normalCount += chunk.normals.size();
+        cornerCount += chunk.corners.size();
+    }
+    if (cornerCount == 0) {
+        Logger::Log("WARNING: ObjLoader found no faces in: " + fullPath + "\n");
+        return false;
+    }
+    if (positionCount > kMaxCornerIndex || texcoordCount > kMaxCornerIndex || normalCount > kMaxCornerIndex) {
+        Logger::Log("WARNING: ObjLoader does not support this many vertices: " + fullPath + "\n");
+        return false;
+    }
+
+    // --- マテリアル ---
+    // テクスチャが同じマテリアルは同じ番号にまとめる (MTL に無い名前や usemtl の無い面はテクスチャ無し)
+    std::vector<ObjMaterial> library;
+    for (const ChunkResult& chunk : chunks) {
+        if (!chunk.materialLibrary.empty()) {
+            library = LoadMaterialLibrary(directoryPath + "/" + chunk.materialLibrary);
+            break;
+        }
+    }
+    modelData.material = {};
+    modelData.materials.clear();
+    for (const ObjMaterial& material : library) {
+        if (!material.texture.empty()) {
+            modelData.material.textureFilePath = directoryPath + "/" + material.texture;
+            break;
+        }
+    }
+    std::unordered_map<std::string, uint32_t> textureMaterials;
+    auto findMaterial = [&](const std::string& name) {
+        std::string texturePath;
+        for (const ObjMaterial& material : library) {
+            if (material.name == name) {
+                texturePath = material.texture.empty() ? std::string() : directoryPath + "/" + material.texture;
+                break;
+            }
+        }
+        auto [it, inserted] = textureMaterials.try_emplace(texturePath, static_cast<uint32_t>(modelData.materials.size()));
+        if (inserted) {
+            modelData.materials.push_back({texturePath, 0});
+        }
+        return it->second;
+    };
+
+    std::vector<Vector3> positions;
+    std::vector<Vector2> texcoords;
+    std::vector<Vector3> normals;
+    positions.reserve(positionCount);
+    texcoords.reserve(texcoordCount);
+    normals.reserve(normalCount);
+
+    modelData.vertices.clear();
+    modelData.indices.clear();
+    modelData.indices.reserve(cornerCount);
+    modelData.vertices.reserve(std::min(cornerCount, positionCount * 2));
+    std::vector<uint32_t> triangleMaterials;
+    triangleMaterials.reserve(cornerCount / 3);
+
+    // 位置/UV/法線の組み合わせ -> 出力頂点のインデックス (サブメッシュ同士で頂点を共有しないよう、マテリアルごとに持つ)
+    std::vector<std::unordered_map<uint64_t, uint32_t>> vertexMaps;
+    // usemtl より前の面はテクスチャ無しのマテリアルにする (使われない場合は作らない)
+    uint32_t currentMaterial = UINT32_MAX;
+
+    for (const ChunkResult& chunk : chunks) {
+        const size_t positionBase = positions.size();
+        const size_t texcoordBase = texcoords.size();
+        const size_t normalBase = normals.size();
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+
+        size_t runCursor = 0;
+        for (size_t c = 0; c < chunk.corners.size(); ++c) {
+            const Corner& corner = chunk.corners[c];
+            if (c % 3 == 0) {
+                while (runCursor < chunk.materialRuns.size() && chunk.materialRuns[runCursor].cornerOffset <= c) {
+                    currentMaterial = findMaterial(chunk.materialRuns[runCursor++].name);
+                }
+                if (currentMaterial == UINT32_MAX) {
+                    currentMaterial = findMaterial({});
+                }
+                triangleMaterials.push_back(currentMaterial);
+                if (vertexMaps.size() <= currentMaterial) {
+                    vertexMaps.resize(currentMaterial + 1);
+                }
+            }
+
+            // 前方参照は無い前提 (参照先はこの時点までに追加済み)
+            uint32_t position = 0;
+            uint32_t texcoord = 0;
+            uint32_t normal = 0;
+            if (!ResolveIndex(corner.position, corner.relativeMask & kRelativePosition, positionBase, positions.size(), position) ||
+                !ResolveIndex(corner.texcoord, corner.relativeMask & kRelativeTexcoord, texcoordBase, texcoords.size(), texcoord) ||
+                !ResolveIndex(corner.normal, corner.relativeMask & kRelativeNormal, normalBase, normals.size(), normal)) {
+                Logger::Log("WARNING: ObjLoader found an out of range index in: " + fullPath + "\n");
+                return false;
+            }
+
+            const uint64_t key = static_cast<uint64_t>(position) |
+                                 (static_cast<uint64_t>(texcoord) << kCornerKeyBits) |
+                                 (static_cast<uint64_t>(normal) << (kCornerKeyBits * 2));
+            auto [it, inserted] =
+                vertexMaps[currentMaterial].try_emplace(key, static_cast<uint32_t>(modelData.vertices.size()));
+            if (inserted) {
+                // assimp 経由と同じく X を反転し、V を反転する
+                VertexData vertex;
+                vertex.position = {-positions[position].x, positions[position].y, positions[position].z, 1.0f};
+                vertex.texcoord = {texcoords[texcoord].x, 1.0f - texcoords[texcoord].y};
+                vertex.normal = {-normals[normal].x, normals[normal].y, normals[normal].z};
+                modelData.vertices.push_back(vertex);
+            }
+            modelData.indices.push_back(it->second);
+        }
+        // チャンクの最後の面より後の usemtl は次のチャンクに引き継ぐ
+        while (runCursor < chunk.materialRuns.size()) {
+            currentMaterial = findMaterial(chunk.materialRuns[runCursor++].name);
+        }
+    }
+
+    // --- 三角形をマテリアルごとにまとめる ---
+    modelData.subMeshes = MeshOptimizer::GroupTriangles(modelData.indices, triangleMaterials, modelData.materials.size());
+
+    // --- ノード (OBJ は階層を持たないので、単位行列のルートのみ) ---
+    modelData.nodes = {};
+    NodeTransform::AddNode(modelData.nodes, fileName, MakeIdentity4x4(), -1);
+
+    return true;
+}
+
+} // namespace ObjLoader
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <string>
+
+// ============================================================
+// ObjLoader — Wavefront OBJ/MTL 専用の高速リーダー
+// ファイルをマップし、行単位で区切ったチャンクを複数スレッドで並列に解析する
+// (ModelManager のワーカーなど ThreadUtility::MarkWorkerThread したスレッドから呼ぶと、分割せず1スレッドで解析する)
+// 位置/UV/法線の組み合わせが同じ頂点は1つにまとめ、インデックス付きの ModelData を作る
+//
+// 出力は assimp 経由 (Model::LoadModelFile) と同じ座標系に揃える
+//   ・位置と法線のXを反転
+//   ・UVのVを反転 (aiProcess_FlipUVs)
+//   ・三角形の巻き順を反転 (aiProcess_FlipWindingOrder)
+//   ・多角形は扇形に三角形化 (aiProcess_Triangulate)
+//   ・usemtl ごとにサブメッシュに分け、テクスチャ (map_Kd) が同じマテリアルは1つにまとめる
+//   ・代表のマテリアル (ModelData::material) は MTL で最初に map_Kd を持つマテリアル
+// ============================================================
+namespace ObjLoader {
+
+/// <summary>
+/// OBJ ファイルを読み込む
+/// UV や法線を持たない面など、対応していない内容を含む場合は失敗するので assimp で読み直すこと
+/// </summary>
+/// <param name="directoryPath">モデルファイルのディレクトリパス</param>
+/// <param name="fileName">モデルファイル名</param>
+/// <param name="modelData">読み込み先</param>
+/// <returns>true = 成功</returns>
+bool Load(const std::string& directoryPath, const std::string& fileName, ModelData& modelData);
+
+} // namespace ObjLoader
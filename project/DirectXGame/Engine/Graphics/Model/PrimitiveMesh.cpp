@@ -0,0 +1,317 @@
+#define NOMINMAX
+
+#include "PrimitiveMesh.h"
+#include "Hash/HashUtility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+using namespace HashUtility;
+
+namespace {
+
+// 形状の種類ごとにハッシュの初期値を変え、異なる形状同士の衝突を避ける
+enum class PrimitiveKind : uint8_t {
+    Ring = 1,
+    Cylinder = 2,
+    Plane = 3,
+};
+
+uint64_t BeginHash(PrimitiveKind kind) {
+    return HashValue(kind);
+}
+
+// 一定の角度ずつ回る sin/cos (加法定理で1分割ぶんずつ進める)
+// 誤差がたまらないよう double で計算する (256 分割でも float の丸め誤差より十分小さい)
+class SinCosStepper {
+public:
+    SinCosStepper(float startRadian, float stepRadian)
+        : sin_(std::sin(double(startRadian))), cos_(std::cos(double(startRadian))),
+          stepSin_(std::sin(double(stepRadian))), stepCos_(std::cos(double(stepRadian))) {}
+
+    float Sin() const { return static_cast<float>(sin_); }
+    float Cos() const { return static_cast<float>(cos_); }
+
+    // 次の角度へ進める
+    void Next() {
+        const double s = sin_ * stepCos_ + cos_ * stepSin_;
+        cos_ = cos_ * stepCos_ - sin_ * stepSin_;
+        sin_ = s;
+    }
+
+private:
+    double sin_;
+    double cos_;
+    double stepSin_;
+    double stepCos_;
+};
+
+// 分割数のガード (不正な値をシャットアウト)
+uint32_t ClampDivision(uint32_t division, uint32_t minDivision) {
+    return std::min(std::max(minDivision, division), 256u);
+}
+
+// 格子 (columns x rows の四角形) のインデックスを書き込む
+void WriteGridIndices(uint32_t columns, uint32_t rows, std::span<uint32_t> indices) {
+    uint32_t* out = indices.data();
+    for (uint32_t y = 0; y < rows; ++y) {
+        for (uint32_t x = 0; x < columns; ++x) {
+            const uint32_t topLeft = y * (columns + 1) + x;
+            const uint32_t topRight = topLeft + 1;
+            const uint32_t bottomLeft = (y + 1) * (columns + 1) + x;
+            const uint32_t bottomRight = bottomLeft + 1;
+
+            // 三角形1
+            *out++ = topLeft;
+            *out++ = topRight;
+            *out++ = bottomLeft;
+
+            // 三角形2
+            *out++ = bottomLeft;
+            *out++ = topRight;
+            *out++ = bottomRight;
+        }
+    }
+}
+
+// 分割数から大きさを求める (Get*Size と Build* の両方で使う)
+PrimitiveMeshSize MakeGridSize(uint32_t columns, uint32_t rows) {
+    return {(columns + 1) * (rows + 1), columns * rows * 6};
+}
+
+} // namespace
+
+namespace PrimitiveMesh {
+
+PrimitiveMeshSize GetRingSize(const RingSettings& settings) {
+    const uint32_t division = ClampDivision(settings.division, 3);
+    return {(division + 1) * 2, division * 6};
+}
+
+PrimitiveMeshSize GetCylinderSize(const CylinderSettings& settings) {
+    return MakeGridSize(ClampDivision(settings.division, 3), ClampDivision(settings.verticalDivision, 1));
+}
+
+PrimitiveMeshSize GetPlaneSize(const PlaneSettings& settings) {
+    return MakeGridSize(std::max(1u, settings.divisionX), std::max(1u, settings.divisionY));
+}
+
+void WriteRing(const RingSettings& settings, std::span<VertexData> vertices, std::span<uint32_t> indices) {
+    const uint32_t division = ClampDivision(settings.division, 3);
+    assert(vertices.size() == (division + 1) * 2 && indices.size() == division * 6);
+    const float innerRadius = std::max(0.0f, settings.innerRadius);
+
+    const float startRad = settings.startAngle * std::numbers::pi_v<float> / 180.0f;
+    const float endRad = settings.endAngle * std::numbers::pi_v<float> / 180.0f;
+    const float angleRange = endRad - startRad;
+
+    // 二次スプライン（放物線補間）係数の算出
+    const float rStart = settings.startOuterRadius;
+    const float rMid = settings.midOuterRadius;
+    const float rEnd = settings.endOuterRadius;
+    const float aCoeff = 2.0f * rStart - 4.0f * rMid + 2.0f * rEnd;
+    const float bCoeff = -3.0f * rStart + 4.0f * rMid - rEnd;
+    const float cCoeff = rStart;
+
+    // 頂点データの生成 (頂点レイアウト: [Outer0, Inner0, Outer1, Inner1, ...])
+    SinCosStepper angle(startRad, angleRange / float(division));
+    VertexData* out = vertices.data();
+    for (uint32_t i = 0; i <= division; ++i, angle.Next()) {
+        const float t = float(i) / float(division);
+        const float s = angle.Sin();
+        const float c = angle.Cos();
+
+        // スプライン曲線による外径の計算
+        const float outerRadius = aCoeff * t * t + bCoeff * t + cCoeff;
+
+        // 外側の頂点
+        VertexData outerVertex;
+        outerVertex.position = {-s * outerRadius, c * outerRadius, 0.0f, 1.0f};
+        outerVertex.normal = {0.0f, 0.0f, -1.0f};
+        outerVertex.texcoord = settings.isUvSwap ? Vector2{0.0f, t} : Vector2{t, 0.0f};
+        *out++ = outerVertex;
+
+        // 内側の頂点
+        VertexData innerVertex;
+        innerVertex.position = {-s * innerRadius, c * innerRadius, 0.0f, 1.0f};
+        innerVertex.normal = {0.0f, 0.0f, -1.0f};
+        innerVertex.texcoord = settings.isUvSwap ? Vector2{1.0f, t} : Vector2{t, 1.0f};
+        *out++ = innerVertex;
+    }
+
+    // インデックスデータの生成
+    uint32_t* index = indices.data();
+    for (uint32_t i = 0; i < division; ++i) {
+        const uint32_t base = i * 2;
+        // 三角形1
+        *index++ = base;     // Outer i
+        *index++ = base + 2; // Outer i+1
+        *index++ = base + 1; // Inner i
+        // 三角形2
+        *index++ = base + 1; // Inner i
+        *index++ = base + 2; // Outer i+1
+        *index++ = base + 3; // Inner i+1
+    }
+}
+
+void WriteCylinder(const CylinderSettings& settings, std::span<VertexData> vertices, std::span<uint32_t> indices) {
+    const uint32_t division = ClampDivision(settings.division, 3);
+    const uint32_t verticalDivision = ClampDivision(settings.verticalDivision, 1);
+    assert(vertices.size() == (division + 1) * (verticalDivision + 1) && indices.size() == division * verticalDivision * 6);
+
+    const float startRad = settings.startAngle * std::numbers::pi_v<float> / 180.0f;
+    const float endRad = settings.endAngle * std::numbers::pi_v<float> / 180.0f;
+    const float angleRange = endRad - startRad;
+
+    // 円周方向の sin/cos はどの段も同じなので、1周ぶんだけ求めておく
+    std::vector<Vector2> sinCos(division + 1);
+    SinCosStepper angle(startRad, angleRange / float(division));
+    for (uint32_t xIndex = 0; xIndex <= division; ++xIndex, angle.Next()) {
+        sinCos[xIndex] = {angle.Sin(), angle.Cos()};
+    }
+
+    // 頂点の生成 (縦方向 yIndex: 0 から verticalDivision)
+    VertexData* out = vertices.data();
+    for (uint32_t yIndex = 0; yIndex <= verticalDivision; ++yIndex) {
+        const float vNorm = float(yIndex) / float(verticalDivision);
+        const float h = (1.0f - vNorm) * settings.height; // yIndex=0 が上(高さ height), yIndex=verticalDivision が下(高さ 0)
+        const float v = settings.flipV ? 1.0f - vNorm : vNorm;
+
+        // 上底から下底にかけての半径を線形補間 (楕円対応)
+        const Vector2 radius = {settings.topRadius.x * (1.0f - vNorm) + settings.bottomRadius.x * vNorm,
+                                settings.topRadius.y * (1.0f - vNorm) + settings.bottomRadius.y * vNorm};
+
+        // 円周方向の頂点生成 (xIndex: 0 から division)
+        for (uint32_t xIndex = 0; xIndex <= division; ++xIndex) {
+            const float uNorm = float(xIndex) / float(division);
+            const float s = sinCos[xIndex].x;
+            const float c = sinCos[xIndex].y;
+
+            // 法線：Y軸の高さは無視し、X, Z方向の外側を向く法線 (sin/cos から作るので長さは1)
+            VertexData vertex;
+            vertex.position = {-s * radius.x, h, c * radius.y, 1.0f};
+            vertex.normal = {-s, 0.0f, c};
+            vertex.texcoord = settings.isUvSwap ? Vector2{v, uNorm} : Vector2{uNorm, v};
+            *out++ = vertex;
+        }
+    }
+
+    // インデックスデータの生成
+    WriteGridIndices(division, verticalDivision, indices);
+}
+
+void WritePlane(const PlaneSettings& settings, std::span<VertexData> vertices, std::span<uint32_t> indices) {
+    const uint32_t divX = std::max(1u, settings.divisionX);
+    const uint32_t divY = std::max(1u, settings.divisionY);
+    assert(vertices.size() == (divX + 1) * (divY + 1) && indices.size() == divX * divY * 6);
+
+    const float stepX = settings.size.x / static_cast<float>(divX);
+    const float stepY = settings.size.y / static_cast<float>(divY);
+
+    const float startX = -settings.size.x * 0.5f;
+    const float startY = -settings.size.y * 0.5f;
+
+    // 頂点生成
+    VertexData* out = vertices.data();
+    for (uint32_t y = 0; y <= divY; ++y) {
+        const float posY = startY + static_cast<float>(y) * stepY;
+        float v = static_cast<float>(y) / static_cast<float>(divY);
+        if (settings.flipV) {
+            v = 1.0f - v;
+        }
+
+        for (uint32_t x = 0; x <= divX; ++x) {
+            const float posX = startX + static_cast<float>(x) * stepX;
+            const float u = static_cast<float>(x) / static_cast<float>(divX);
+
+            VertexData vertex;
+            vertex.position = {posX, posY, 0.0f, 1.0f};
+            vertex.normal = {0.0f, 0.0f, -1.0f};
+            vertex.texcoord = settings.isUvSwap ? Vector2{v, u} : Vector2{u, v};
+            *out++ = vertex;
+        }
+    }
+
+    // インデックス生成
+    WriteGridIndices(divX, divY, indices);
+}
+
+void BuildRing(const RingSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices) {
+    const PrimitiveMeshSize size = GetRingSize(settings);
+    vertices.resize(size.vertexCount);
+    indices.resize(size.indexCount);
+    WriteRing(settings, vertices, indices);
+}
+
+void BuildCylinder(const CylinderSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices) {
+    const PrimitiveMeshSize size = GetCylinderSize(settings);
+    vertices.resize(size.vertexCount);
+    indices.resize(size.indexCount);
+    WriteCylinder(settings, vertices, indices);
+}
+
+void BuildPlane(const PlaneSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices) {
+    const PrimitiveMeshSize size = GetPlaneSize(settings);
+    vertices.resize(size.vertexCount);
+    indices.resize(size.indexCount);
+    WritePlane(settings, vertices, indices);
+}
+
+ShapeMeshBuilder MakeRingBuilder(const RingSettings& settings) {
+    return {GetRingSize(settings), [settings](std::span<VertexData> vertices, std::span<uint32_t> indices) {
+                WriteRing(settings, vertices, indices);
+            }};
+}
+
+ShapeMeshBuilder MakeCylinderBuilder(const CylinderSettings& settings) {
+    return {GetCylinderSize(settings), [settings](std::span<VertexData> vertices, std::span<uint32_t> indices) {
+                WriteCylinder(settings, vertices, indices);
+            }};
+}
+
+ShapeMeshBuilder MakePlaneBuilder(const PlaneSettings& settings) {
+    return {GetPlaneSize(settings), [settings](std::span<VertexData> vertices, std::span<uint32_t> indices) {
+                WritePlane(settings, vertices, indices);
+            }};
+}
+
+uint64_t HashRing(const RingSettings& settings) {
+    uint64_t hash = BeginHash(PrimitiveKind::Ring);
+    hash = HashValue(settings.innerRadius, hash);
+    hash = HashValue(settings.startOuterRadius, hash);
+    hash = HashValue(settings.midOuterRadius, hash);
+    hash = HashValue(settings.endOuterRadius, hash);
+    hash = HashValue(settings.startAngle, hash);
+    hash = HashValue(settings.endAngle, hash);
+    hash = HashValue(settings.division, hash);
+    hash = HashValue(settings.isUvSwap, hash);
+    return hash;
+}
+
+uint64_t HashCylinder(const CylinderSettings& settings) {
+    uint64_t hash = BeginHash(PrimitiveKind::Cylinder);
+    hash = HashValue(settings.height, hash);
+    hash = HashValue(settings.topRadius, hash);
+    hash = HashValue(settings.bottomRadius, hash);
+    hash = HashValue(settings.startAngle, hash);
+    hash = HashValue(settings.endAngle, hash);
+    hash = HashValue(settings.division, hash);
+    hash = HashValue(settings.verticalDivision, hash);
+    hash = HashValue(settings.flipV, hash);
+    hash = HashValue(settings.isUvSwap, hash);
+    return hash;
+}
+
+uint64_t HashPlane(const PlaneSettings& settings) {
+    uint64_t hash = BeginHash(PrimitiveKind::Plane);
+    hash = HashValue(settings.size, hash);
+    hash = HashValue(settings.divisionX, hash);
+    hash = HashValue(settings.divisionY, hash);
+    hash = HashValue(settings.flipV, hash);
+    hash = HashValue(settings.isUvSwap, hash);
+    return hash;
+}
+
+} // namespace PrimitiveMesh
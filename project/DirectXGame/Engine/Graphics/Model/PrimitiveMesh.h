@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+#include "Types/ParticleTypes.h"
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+// 生成するメッシュの頂点数・インデックス数
+struct PrimitiveMeshSize {
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+};
+
+// 頂点・インデックスを生成する関数 (ShapeMeshCache のワーカースレッドから呼ばれる)
+// write には size ちょうどの大きさの書き込み先 (マップしたアップロードバッファ) が渡される
+struct ShapeMeshBuilder {
+    PrimitiveMeshSize size;
+    std::function<void(std::span<VertexData>, std::span<uint32_t>)> write;
+};
+
+// プリミティブ(リング/シリンダー/平面)の頂点・インデックス生成
+// D3D12に依存しないので、ワーカースレッドからも呼び出せる
+//   ・大きさは設定から先に決まるので、書き込み先を確保してから1回で書く (push_back しない)
+//   ・円周方向の sin/cos は最初の1回だけ求め、以降は1分割ぶんの回転を掛けて進める
+//   ・書き込み先は読み返さない (書き込み結合メモリのアップロードバッファへ直接書いても遅くならない)
+namespace PrimitiveMesh {
+
+// 生成されるメッシュの大きさ (分割数のガードを反映したもの)
+PrimitiveMeshSize GetRingSize(const RingSettings& settings);
+PrimitiveMeshSize GetCylinderSize(const CylinderSettings& settings);
+PrimitiveMeshSize GetPlaneSize(const PlaneSettings& settings);
+
+// 頂点・インデックスを書き込み先へ直接生成する (大きさは Get*Size と同じであること)
+void WriteRing(const RingSettings& settings, std::span<VertexData> vertices, std::span<uint32_t> indices);
+void WriteCylinder(const CylinderSettings& settings, std::span<VertexData> vertices, std::span<uint32_t> indices);
+void WritePlane(const PlaneSettings& settings, std::span<VertexData> vertices, std::span<uint32_t> indices);
+
+// リングの頂点・インデックスを生成する
+void BuildRing(const RingSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices);
+
+// シリンダーの頂点・インデックスを生成する
+void BuildCylinder(const CylinderSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices);
+
+// 平面の頂点・インデックスを生成する
+void BuildPlane(const PlaneSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices);
+
+// ShapeMeshCache に渡す生成関数 (設定はコピーして持つ)
+ShapeMeshBuilder MakeRingBuilder(const RingSettings& settings);
+ShapeMeshBuilder MakeCylinderBuilder(const CylinderSettings& settings);
+ShapeMeshBuilder MakePlaneBuilder(const PlaneSettings& settings);
+
+// 形状に影響する設定だけをハッシュ化する (色などマテリアル側の設定は含めない)
+// 同じハッシュの設定同士はメッシュを共有できる
+uint64_t HashRing(const RingSettings& settings);
+uint64_t HashCylinder(const CylinderSettings& settings);
+uint64_t HashPlane(const PlaneSettings& settings);
+
+} // namespace PrimitiveMesh
@@ -0,0 +1,131 @@
+#include "Skinning.h"
+#include "NodeTransform.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <cassert>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define SKINNING_USE_SSE
+#endif
+
+namespace {
+
+// 頂点は読み込み時に X を反転している (右手系 → 左手系) ので、
+// パレットも X 反転で挟む (S * M * S。S = diag(-1, 1, 1, 1))
+void MirrorX(Matrix4x4& matrix) {
+    for (int i = 1; i < 4; ++i) {
+        matrix.m[0][i] = -matrix.m[0][i];
+        matrix.m[i][0] = -matrix.m[i][0];
+    }
+}
+
+} // namespace
+
+namespace Skinning {
+
+void ComputePalette(std::span<const Joint> joints, std::span<const Matrix4x4> nodeMatrices,
+                    std::span<Matrix4x4> palette) {
+    assert(palette.size() >= joints.size());
+    for (size_t i = 0; i < joints.size(); ++i) {
+        assert(joints[i].nodeIndex < nodeMatrices.size());
+        palette[i] = NodeTransform::Multiply(joints[i].inverseBindMatrix, nodeMatrices[joints[i].nodeIndex]);
+        MirrorX(palette[i]);
+    }
+}
+
+void SkinVertices(std::span<const VertexData> vertices, std::span<const VertexInfluence> influences,
+                  std::span<const Matrix4x4> palette, std::span<VertexData> output) {
+    assert(influences.size() >= vertices.size() && output.size() >= vertices.size());
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        const VertexData& source = vertices[v];
+        const VertexInfluence& influence = influences[v];
+        VertexData& destination = output[v];
+
+#ifdef SKINNING_USE_SSE
+        // 4つのパレット行列を重みで混ぜる (使わない枠は重み0なので分岐しない)
+        __m128 rows[4] = {_mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps()};
+        for (int k = 0; k < 4; ++k) {
+            const __m128 weight = _mm_set1_ps(influence.weights[k]);
+            const Matrix4x4& matrix = palette[influence.jointIndices[k]];
+            for (int r = 0; r < 4; ++r) {
+                rows[r] = _mm_add_ps(rows[r], _mm_mul_ps(weight, _mm_loadu_ps(matrix.m[r])));
+            }
+        }
+
+        __m128 position = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(source.position.x), rows[0]),
+                                     _mm_mul_ps(_mm_set1_ps(source.position.y), rows[1]));
+        position = _mm_add_ps(position, _mm_mul_ps(_mm_set1_ps(source.position.z), rows[2]));
+        position = _mm_add_ps(position, rows[3]);
+        __m128 normal = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(source.normal.x), rows[0]),
+                                   _mm_mul_ps(_mm_set1_ps(source.normal.y), rows[1]));
+        normal = _mm_add_ps(normal, _mm_mul_ps(_mm_set1_ps(source.normal.z), rows[2]));
+
+        alignas(16) float positionOut[4];
+        alignas(16) float normalOut[4];
+        _mm_store_ps(positionOut, position);
+        _mm_store_ps(normalOut, normal);
+#else
+        float blended[4][4] = {};
+        for (int k = 0; k < 4; ++k) {
+            const float weight = influence.weights[k];
+            const Matrix4x4& matrix = palette[influence.jointIndices[k]];
+            for (int r = 0; r < 4; ++r) {
+                for (int c = 0; c < 4; ++c) {
+                    blended[r][c] += weight * matrix.m[r][c];
+                }
+            }
+        }
+        float positionOut[4];
+        float normalOut[4];
+        for (int c = 0; c < 4; ++c) {
+            positionOut[c] = source.position.x * blended[0][c] + source.position.y * blended[1][c] +
+                             source.position.z * blended[2][c] + blended[3][c];
+            normalOut[c] = source.normal.x * blended[0][c] + source.normal.y * blended[1][c] +
+                           source.normal.z * blended[2][c];
+        }
+#endif
+
+        destination.position = {positionOut[0], positionOut[1], positionOut[2], 1.0f};
+        destination.texcoord = source.texcoord;
+        const float lengthSq = normalOut[0] * normalOut[0] + normalOut[1] * normalOut[1] + normalOut[2] * normalOut[2];
+        const float inverseLength = lengthSq > 0.0f ? 1.0f / std::sqrt(lengthSq) : 0.0f;
+        destination.normal = {normalOut[0] * inverseLength, normalOut[1] * inverseLength, normalOut[2] * inverseLength};
+    }
+}
+
+void AddInfluence(VertexInfluence& influence, uint32_t jointIndex, float weight) {
+    int smallest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (influence.weights[i] < influence.weights[smallest]) {
+            smallest = i;
+        }
+    }
+    if (weight > influence.weights[smallest]) {
+        influence.jointIndices[smallest] = jointIndex;
+        influence.weights[smallest] = weight;
+    }
+}
+
+void NormalizeInfluences(std::vector<VertexInfluence>& influences, std::vector<Joint>& joints) {
+    uint32_t rootJoint = UINT32_MAX;
+    for (VertexInfluence& influence : influences) {
+        const float total = influence.weights[0] + influence.weights[1] + influence.weights[2] + influence.weights[3];
+        if (total > 0.0f) {
+            for (float& weight : influence.weights) {
+                weight /= total;
+            }
+            continue;
+        }
+        if (rootJoint == UINT32_MAX) {
+            rootJoint = static_cast<uint32_t>(joints.size());
+            joints.push_back({0, MathGenerators::MakeIdentity4x4()});
+        }
+        influence = {};
+        influence.jointIndices[0] = rootJoint;
+        influence.weights[0] = 1.0f;
+    }
+}
+
+} // namespace Skinning
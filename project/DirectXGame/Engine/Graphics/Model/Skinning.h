@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Types/ModelTypes.h"
+
+#include <span>
+#include <vector>
+
+// ============================================================
+// Skinning — CPU スキニング (D3D12 を使わないのでワーカースレッドから呼べる)
+//   ・パレット: ジョイントごとの「バインドポーズ → 現在の姿勢」の行列
+//   ・頂点ごとに最大4つのパレット行列を重みで混ぜ、位置と法線を変換する (SSE で4要素ずつ)
+//   ・パレットと VertexInfluence はそのまま StructuredBuffer に置ける形なので、
+//     コンピュートシェーダーに移すときも入出力は変えずに済む
+// ============================================================
+namespace Skinning {
+
+/// <summary>
+/// スキニングパレットを作る
+/// </summary>
+/// <param name="joints">ジョイント</param>
+/// <param name="nodeMatrices">ノードごとのモデル空間の行列 (現在の姿勢で NodeTransform::ComputeWorldMatrices したもの)</param>
+/// <param name="palette">出力先 (ジョイント数以上)</param>
+void ComputePalette(std::span<const Joint> joints, std::span<const Matrix4x4> nodeMatrices,
+                    std::span<Matrix4x4> palette);
+
+/// <summary>
+/// 頂点をスキニングする (法線は混ぜた行列で変換して正規化する。非一様スケールの骨は想定しない)
+/// </summary>
+/// <param name="vertices">バインドポーズの頂点</param>
+/// <param name="influences">頂点ごとのジョイントの影響 (vertices と同じ並び)</param>
+/// <param name="palette">ComputePalette で作ったパレット</param>
+/// <param name="output">出力先 (頂点数以上。UV はそのままコピーする)</param>
+void SkinVertices(std::span<const VertexData> vertices, std::span<const VertexInfluence> influences,
+                  std::span<const Matrix4x4> palette, std::span<VertexData> output);
+
+// 頂点にジョイントの影響を追加する (4つを超えたら重みの小さいものから捨てる)
+void AddInfluence(VertexInfluence& influence, uint32_t jointIndex, float weight);
+
+// 重みの合計を1にする (影響を持たない頂点は、ルートノードに固定するジョイントを joints の末尾に追加して割り当てる)
+void NormalizeInfluences(std::vector<VertexInfluence>& influences, std::vector<Joint>& joints);
+
+} // namespace Skinning
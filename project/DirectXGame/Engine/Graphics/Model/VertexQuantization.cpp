@@ -0,0 +1,243 @@
+#include "VertexQuantization.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 0 を正として扱う符号
+float SignNotZero(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+
+float DecodeSnorm16(int16_t value) { return std::max(static_cast<float>(value) / 32767.0f, -1.0f); }
+
+// 八面体の2次元座標 (-1～1) から方向を復元する (シェーダーと同じ計算)
+Vector3 DecodeOctahedralFloat(float x, float y) {
+    Vector3 normal = {x, y, 1.0f - std::abs(x) - std::abs(y)};
+    // 下半球は四隅に折り返されているので戻す
+    const float t = std::max(-normal.z, 0.0f);
+    normal.x += normal.x >= 0.0f ? -t : t;
+    normal.y += normal.y >= 0.0f ? -t : t;
+    const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+    return {normal.x / length, normal.y / length, normal.z / length};
+}
+
+float Dot(const Vector3& a, const Vector3& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+// 2つの法線のなす角 (acos は小さい角度で精度が落ちるので atan2 で求める)
+float AngleBetween(const Vector3& a, const Vector3& b) {
+    const Vector3 cross = {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    return std::atan2(std::sqrt(Dot(cross, cross)), Dot(a, b));
+}
+
+Vector3 Normalize(const Vector3& v) {
+    const float length = std::sqrt(Dot(v, v));
+    if (length == 0.0f) {
+        return {0.0f, 0.0f, 1.0f};
+    }
+    return {v.x / length, v.y / length, v.z / length};
+}
+
+void Accumulate(VertexQuantization::QuantizationError& error, const VertexData& source, const VertexData& decoded) {
+    error.position = std::max({error.position, std::abs(source.position.x - decoded.position.x),
+                               std::abs(source.position.y - decoded.position.y),
+                               std::abs(source.position.z - decoded.position.z)});
+    error.texcoord = std::max({error.texcoord, std::abs(source.texcoord.x - decoded.texcoord.x),
+                               std::abs(source.texcoord.y - decoded.texcoord.y)});
+    error.normalAngle = std::max(error.normalAngle, AngleBetween(Normalize(source.normal), decoded.normal));
+}
+
+} // namespace
+
+namespace VertexQuantization {
+
+uint16_t FloatToHalf(float value) {
+    uint32_t bits = std::bit_cast<uint32_t>(value);
+    const uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint32_t result = 0;
+    if (bits >= 0x47800000u) {
+        // 65536 以上は無限大、NaN は quiet NaN にする
+        result = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    } else if (bits < 0x38800000u) {
+        // half の非正規化数 (2^-14 未満): 仮数部が下位に揃うよう加算して丸めを FPU に任せる
+        const uint32_t denormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+        const float aligned = std::bit_cast<float>(bits) + std::bit_cast<float>(denormMagic);
+        result = std::bit_cast<uint32_t>(aligned) - denormMagic;
+    } else {
+        // 指数部を付け替え、捨てる13ビットを最近接偶数に丸める (繰り上がりで無限大になる場合も正しく扱える)
+        const uint32_t mantissaOdd = (bits >> 13) & 1u;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu;
+        bits += mantissaOdd;
+        result = bits >> 13;
+    }
+    return static_cast<uint16_t>(result | (sign >> 16));
+}
+
+float HalfToFloat(uint16_t value) {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x3FFu;
+
+    if (exponent == 0) {
+        // 0 と非正規化数 (仮数 * 2^-24)
+        const float magnitude = static_cast<float>(mantissa) * 5.9604644775390625e-8f;
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+void EncodeOctahedral(const Vector3& normal, int16_t encoded[2]) {
+    const float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (l1 == 0.0f) {
+        encoded[0] = 0;
+        encoded[1] = 0;
+        return;
+    }
+
+    // 八面体に射影し、下半球は四隅に折り返す
+    float x = normal.x / l1;
+    float y = normal.y / l1;
+    if (normal.z < 0.0f) {
+        const float foldedX = (1.0f - std::abs(y)) * SignNotZero(x);
+        const float foldedY = (1.0f - std::abs(x)) * SignNotZero(y);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    // 切り捨て・切り上げの4通りを復元して比べ、最も誤差が小さいものを選ぶ
+    const Vector3 target = Normalize(normal);
+    const float scaledX = std::clamp(x, -1.0f, 1.0f) * 32767.0f;
+    const float scaledY = std::clamp(y, -1.0f, 1.0f) * 32767.0f;
+    float bestDot = -2.0f;
+    for (float candidateX : {std::floor(scaledX), std::ceil(scaledX)}) {
+        for (float candidateY : {std::floor(scaledY), std::ceil(scaledY)}) {
+            const int16_t candidate[2] = {static_cast<int16_t>(candidateX), static_cast<int16_t>(candidateY)};
+            const float dot = Dot(DecodeOctahedral(candidate), target);
+            if (dot > bestDot) {
+                bestDot = dot;
+                encoded[0] = candidate[0];
+                encoded[1] = candidate[1];
+            }
+        }
+    }
+}
+
+Vector3 DecodeOctahedral(const int16_t encoded[2]) {
+    return DecodeOctahedralFloat(DecodeSnorm16(encoded[0]), DecodeSnorm16(encoded[1]));
+}
+
+CompactVertexData EncodeCompact(const VertexData& vertex) {
+    CompactVertexData result{};
+    result.position = {vertex.position.x, vertex.position.y, vertex.position.z};
+    EncodeOctahedral(vertex.normal, result.normal);
+    result.texcoord[0] = FloatToHalf(vertex.texcoord.x);
+    result.texcoord[1] = FloatToHalf(vertex.texcoord.y);
+    return result;
+}
+
+VertexData DecodeCompact(const CompactVertexData& vertex) {
+    VertexData result{};
+    result.position = {vertex.position.x, vertex.position.y, vertex.position.z, 1.0f};
+    result.texcoord = {HalfToFloat(vertex.texcoord[0]), HalfToFloat(vertex.texcoord[1])};
+    result.normal = DecodeOctahedral(vertex.normal);
+    return result;
+}
+
+CompactHalfVertexData EncodeCompactHalf(const VertexData& vertex) {
+    CompactHalfVertexData result{};
+    result.position[0] = FloatToHalf(vertex.position.x);
+    result.position[1] = FloatToHalf(vertex.position.y);
+    result.position[2] = FloatToHalf(vertex.position.z);
+    result.position[3] = FloatToHalf(1.0f);
+    EncodeOctahedral(vertex.normal, result.normal);
+    result.texcoord[0] = FloatToHalf(vertex.texcoord.x);
+    result.texcoord[1] = FloatToHalf(vertex.texcoord.y);
+    return result;
+}
+
+VertexData DecodeCompactHalf(const CompactHalfVertexData& vertex) {
+    VertexData result{};
+    result.position = {HalfToFloat(vertex.position[0]), HalfToFloat(vertex.position[1]),
+                       HalfToFloat(vertex.position[2]), HalfToFloat(vertex.position[3])};
+    result.texcoord = {HalfToFloat(vertex.texcoord[0]), HalfToFloat(vertex.texcoord[1])};
+    result.normal = DecodeOctahedral(vertex.normal);
+    return result;
+}
+
+size_t GetVertexStride(VertexFormat format) {
+    switch (format) {
+    case kVertexFormatCompact:
+        return sizeof(CompactVertexData);
+    case kVertexFormatCompactHalf:
+        return sizeof(CompactHalfVertexData);
+    default:
+        return sizeof(VertexData);
+    }
+}
+
+void EncodeVertices(std::span<const VertexData> vertices, VertexFormat format, void* destination) {
+    switch (format) {
+    case kVertexFormatCompact: {
+        CompactVertexData* output = static_cast<CompactVertexData*>(destination);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            output[i] = EncodeCompact(vertices[i]);
+        }
+        break;
+    }
+    case kVertexFormatCompactHalf: {
+        CompactHalfVertexData* output = static_cast<CompactHalfVertexData*>(destination);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            output[i] = EncodeCompactHalf(vertices[i]);
+        }
+        break;
+    }
+    default:
+        std::memcpy(destination, vertices.data(), vertices.size_bytes());
+        break;
+    }
+}
+
+QuantizationError MeasureError(std::span<const VertexData> vertices, VertexFormat format) {
+    QuantizationError error;
+    for (const VertexData& vertex : vertices) {
+        switch (format) {
+        case kVertexFormatCompact:
+            Accumulate(error, vertex, DecodeCompact(EncodeCompact(vertex)));
+            break;
+        case kVertexFormatCompactHalf:
+            Accumulate(error, vertex, DecodeCompactHalf(EncodeCompactHalf(vertex)));
+            break;
+        default:
+            break;
+        }
+    }
+    return error;
+}
+
+VertexFormat ChooseVertexFormat(std::span<const VertexData> vertices, VertexFormat requested) {
+    if (requested != kVertexFormatCompact && requested != kVertexFormatCompactHalf) {
+        return kVertexFormatFull;
+    }
+
+    const QuantizationError error = MeasureError(vertices, requested);
+    // 法線は形式によらず同じ符号化なので、誤差は常に保証範囲に収まる
+    assert(error.normalAngle <= kMaxNormalAngleError);
+
+    // UV はどちらの圧縮形式でも half なので、収まらなければ圧縮しない
+    if (error.texcoord > kMaxTexcoordError) {
+        return kVertexFormatFull;
+    }
+    if (requested == kVertexFormatCompactHalf && error.position > kMaxPositionError) {
+        return kVertexFormatCompact;
+    }
+    return requested;
+}
+
+} // namespace VertexQuantization
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// ============================================================
+// VertexQuantization — 頂点の圧縮と復元 (CPU側)
+//   ・half (IEEE 754 binary16) : 最近接偶数丸め。相対誤差は 2^-11 以下
+//   ・八面体エンコード法線     : snorm16x2。量子化後の4候補から誤差が最小のものを選ぶ
+// 復元はシェーダー (Object3dCompact.VS.hlsl) と同じ計算で行う
+// ============================================================
+namespace VertexQuantization {
+
+// 圧縮で許容する誤差 (これを超える場合は ChooseVertexFormat が別の形式を選ぶ)
+static const float kMaxPositionError = 1.0f / 1024.0f; // 位置 (モデル空間の単位)
+static const float kMaxTexcoordError = 1.0f / 2048.0f; // UV (1024pxのテクスチャで0.5テクセル)
+// snorm16 の八面体エンコードで保証できる法線の角度誤差 (ラジアン。実測の最大は約1.3e-4)
+static const float kMaxNormalAngleError = 2.0e-4f;
+
+// 実際に圧縮・復元して測った誤差
+struct QuantizationError {
+    float position = 0.0f;    // 最大の位置誤差
+    float texcoord = 0.0f;    // 最大のUV誤差
+    float normalAngle = 0.0f; // 最大の法線の角度誤差 (ラジアン)
+};
+
+// --- スカラー・ベクトルの変換 ---
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+void EncodeOctahedral(const Vector3& normal, int16_t encoded[2]);
+Vector3 DecodeOctahedral(const int16_t encoded[2]);
+
+// --- 頂点の変換 ---
+CompactVertexData EncodeCompact(const VertexData& vertex);
+VertexData DecodeCompact(const CompactVertexData& vertex);
+CompactHalfVertexData EncodeCompactHalf(const VertexData& vertex);
+VertexData DecodeCompactHalf(const CompactHalfVertexData& vertex);
+
+// 1頂点あたりのバイト数
+size_t GetVertexStride(VertexFormat format);
+
+/// <summary>
+/// 頂点を指定の形式に変換して書き込む
+/// </summary>
+/// <param name="vertices">元の頂点</param>
+/// <param name="format">書き込む形式</param>
+/// <param name="destination">書き込み先 (GetVertexStride(format) * vertices.size() バイト)</param>
+void EncodeVertices(std::span<const VertexData> vertices, VertexFormat format, void* destination);
+
+// 指定の形式に変換したときの誤差を測る
+QuantizationError MeasureError(std::span<const VertexData> vertices, VertexFormat format);
+
+/// <summary>
+/// 希望の形式で誤差が許容範囲に収まるか確かめ、実際に使う形式を選ぶ
+/// CompactHalf で位置の誤差が大きい場合は Compact に、UVの誤差が大きい場合は Full にする
+/// </summary>
+VertexFormat ChooseVertexFormat(std::span<const VertexData> vertices, VertexFormat requested);
+
+} // namespace VertexQuantization
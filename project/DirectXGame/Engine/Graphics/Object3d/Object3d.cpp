@@ -1,9 +1,14 @@
 #include "Object3d.h"
 #include "Base/DX12Context.h"
+#include "Base/Win32Window.h"
 #include "Camera/Camera.h"
 #include "Light/LightManager.h"
+#include "Logger.h"
+#include "Model/BoundingVolume.h"
 #include "Model/Model.h"
 #include "Model/ModelManager.h"
+#include "Model/NodeTransform.h"
+#include "Model/Skinning.h"
 #include "Object3dCommon.h"
 #include "Texture/TextureManager.h"
 
@@ -11,6 +16,9 @@
 #include "Math/Matrix/MatrixGenerators.h"
 
 #include <assert.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 using namespace Microsoft::WRL;
 using namespace MathUtils;
@@ -23,6 +31,18 @@ Object3d::~Object3d() {
             transformationMatrixResources_[i]->Unmap(0, nullptr);
             transformationMatrixData_[i] = nullptr;
         }
+        if (culledIndexResources_[i] && culledIndexData_[i]) {
+            culledIndexResources_[i]->Unmap(0, nullptr);
+            culledIndexData_[i] = nullptr;
+        }
+    }
+    if (materialResource_ && materialData_) {
+        materialResource_->Unmap(0, nullptr);
+        materialData_ = nullptr;
+    }
+    if (skinnedVertexResource_ && skinnedVertexData_) {
+        skinnedVertexResource_->Unmap(0, nullptr);
+        skinnedVertexData_ = nullptr;
     }
 }
 
@@ -35,25 +55,38 @@ void Object3d::Initialize() {
 
 // 更新処理 (全ビュー更新)
 void Object3d::Update() {
-    for (uint32_t i = 0; i < kMaxViews; ++i) {
-        Update(i, camera_);
+    // どのビューも同じカメラなので、ビュー0だけ求めて他のビューはその結果を使う
+    // (LOD選択やクラスタカリングのインデックス書き込みをビューの数だけ繰り返さない)
+    Update(0, camera_);
+    for (uint32_t i = 1; i < kMaxViews; ++i) {
+        viewSources_[i] = 0;
     }
 }
 
 // 指定したビュー用の更新
 void Object3d::Update(uint32_t viewIndex, Camera* camera) {
     assert(viewIndex < kMaxViews);
+    viewSources_[viewIndex] = viewIndex;
 
     // Transform情報からワールド行列を作る (全ビュー共通)
     Matrix4x4 worldMatrix = MakeAffineMatrix(transform_.scale, transform_.rotate,
                                              transform_.translate);
 
-    // Model側のRootNodeのTransformを反映する
-    if (model_) {
-        Matrix4x4 rootMatrix = model_->GetRootNode().localMatrix;
-        worldMatrix = rootMatrix * worldMatrix;
+    // Model側のノード階層のワールド行列を先頭から順に求め、メッシュにはルートノードのものを使う
+    // (アニメーション中は現在の姿勢で求める。スキンを持つモデルは頂点が姿勢込みなのでオブジェクトの行列のまま)
+    nodeWorldMatrices_.clear();
+    if (model_ && model_->GetNodes().GetNodeCount() > 0) {
+        const NodeHierarchy &nodes = model_->GetNodes();
+        nodeWorldMatrices_.resize(nodes.GetNodeCount());
+        NodeTransform::ComputeWorldMatrices(nodes.parents, GetPoseLocalMatrices(), worldMatrix, nodeWorldMatrices_);
+        if (!model_->IsSkinned()) {
+            worldMatrix = nodeWorldMatrices_[0];
+        }
     }
 
+    // ワールド空間の範囲 (変換が変わったときだけ求め直す)
+    UpdateWorldBounds(worldMatrix);
+
     // ワールドビュー射影行列の計算
     Matrix4x4 wvpMatrix;
     if (camera) {
@@ -63,6 +96,20 @@ void Object3d::Update(uint32_t viewIndex, Camera* camera) {
         wvpMatrix = worldMatrix;
     }
 
+    // 画面上の大きさからLODを選ぶ (カメラが無い場合は最も詳細なLOD)
+    lodIndices_[viewIndex] = 0;
+    if (model_ && camera) {
+        lodIndices_[viewIndex] = model_->SelectLod(ComputePixelsPerUnit(worldMatrix, *camera));
+    }
+
+    // LOD0 を描くときは、見えるメッシュレットだけに絞る (メッシュレットはバインドポーズのものなのでスキンを持つモデルは除く)
+    isClusterCulled_[viewIndex] = false;
+    clusterCullStats_[viewIndex] = {};
+    if (isClusterCulling_ && model_ && camera && lodIndices_[viewIndex] == 0 && model_->HasMeshlets() &&
+        !model_->IsSkinned()) {
+        UpdateClusterCulling(viewIndex, worldMatrix, wvpMatrix, *camera);
+    }
+
     // 非均一スケール対応：逆転置行列の計算
     Matrix4x4 worldInverseTranspose = Transpose(Inverse(worldMatrix));
 
@@ -75,7 +122,9 @@ void Object3d::Update(uint32_t viewIndex, Camera* camera) {
 // 描画処理
 void Object3d::Draw(uint32_t viewIndex) {
     assert(viewIndex < kMaxViews);
-    
+    // Update() で更新した場合は、どのビューもビュー0の結果で描く
+    viewIndex = viewSources_[viewIndex];
+
     // 変換行列CBVの設定
     DX12Context::GetInstance()
       ->GetCommandList()
@@ -84,13 +133,292 @@ void Object3d::Draw(uint32_t viewIndex) {
 
   // 描画コマンド
   if (model_) {
-    model_->Draw();
+    // インスタンスごとのマテリアルがあればモデルのものと差し替える
+    Model::DrawOverride drawOverride;
+    if (materialResource_) {
+        drawOverride.materialAddress = materialResource_->GetGPUVirtualAddress();
+    }
+    if (!dissolveMaskFilePath_.empty()) {
+        drawOverride.dissolveMaskFilePath = &dissolveMaskFilePath_;
+    }
+
+    // 圧縮頂点のモデルは対応するPSOに切り替える
+    VertexFormat vertexFormat = model_->GetVertexFormat();
+    if (model_->IsSkinned()) {
+        // スキンを持つモデルはスキニングした頂点 (非圧縮) で描く。まだ一度もスキニングしていなければバインドポーズで作る
+        if (skinnedModel_ != model_) {
+            UpdateSkinning();
+        }
+        drawOverride.vertexBufferView = &skinnedVertexBufferView_;
+        vertexFormat = kVertexFormatFull;
+    }
+    Object3dCommon::GetInstance()->SetVertexFormat(vertexFormat);
+    if (isClusterCulled_[viewIndex]) {
+        // すべてのメッシュレットが見えなければ描画しない
+        if (clusterCullStats_[viewIndex].visibleTriangles > 0) {
+            model_->DrawIndices(culledIndexBufferViews_[viewIndex], culledGroupOffsets_[viewIndex],
+                                &drawOverride);
+        }
+    } else {
+        model_->Draw(lodIndices_[viewIndex], &drawOverride);
+    }
   }
 }
 
+void Object3d::SetModel(Model *model) {
+    if (model != model_ && materialResource_) {
+        // インスタンスごとのマテリアルは前のモデルのものを複製しているので捨てる
+        // (描画中のフレームが参照しているかもしれないので、解放はフレームの完了後)
+        materialResource_->Unmap(0, nullptr);
+        materialData_ = nullptr;
+        DX12Context::GetInstance()->DeferredRelease(std::move(materialResource_));
+    }
+    model_ = model;
+    // 再生中のクリップは前のモデルのものなので止める
+    StopAnimation();
+    isBoundsDirty_ = true;
+}
+
 void Object3d::SetModel(const std::string &filepath) {
   // モデルを検索してセットする
-  model_ = ModelManager::GetInstance()->FindModel(filepath);
+  SetModel(ModelManager::GetInstance()->FindModel(filepath));
+}
+
+void Object3d::PlayAnimation(const std::string &name, bool loop) {
+    assert(model_ && "SetModel before playing an animation");
+    const int32_t animationIndex = model_->FindAnimation(name);
+    if (animationIndex < 0) {
+        Logger::Log("WARNING: Animation not found: " + name + "\n");
+        return;
+    }
+    animationSampler_.Initialize(&model_->GetAnimation(animationIndex));
+    animationTime_ = 0.0f;
+    isAnimationLoop_ = loop;
+}
+
+void Object3d::StopAnimation() {
+    animationSampler_.Clear();
+    animationTime_ = 0.0f;
+    poseLocalMatrices_.clear();
+    // バインドポーズに戻すため、次の描画でスキニングし直す
+    skinnedModel_ = nullptr;
+    isBoundsDirty_ = true;
+}
+
+void Object3d::UpdateAnimation(float deltaTime) {
+    if (!model_ || !animationSampler_.HasClip()) {
+        return;
+    }
+
+    // 再生位置を進める (ループしない場合は最後の姿勢で止める)
+    const float duration = animationSampler_.GetDuration();
+    animationTime_ += deltaTime;
+    if (isAnimationLoop_ && duration > 0.0f) {
+        animationTime_ = std::fmod(animationTime_, duration);
+    } else if (animationTime_ > duration) {
+        animationTime_ = duration;
+    }
+
+    // トラックの無いノードはモデルのローカル行列のまま
+    const NodeHierarchy &nodes = model_->GetNodes();
+    poseLocalMatrices_.assign(nodes.localMatrices.begin(), nodes.localMatrices.end());
+    animationSampler_.Sample(animationTime_, poseLocalMatrices_);
+
+    if (model_->IsSkinned()) {
+        UpdateSkinning();
+    }
+}
+
+std::span<const Matrix4x4> Object3d::GetPoseLocalMatrices() const {
+    if (!poseLocalMatrices_.empty()) {
+        return poseLocalMatrices_;
+    }
+    return model_->GetNodes().localMatrices;
+}
+
+void Object3d::UpdateSkinning() {
+    // モデル空間のノード行列 → パレット → 頂点の順に求め、マップしたバッファへ直接書き込む
+    // (フレームごとにGPUの完了を待っているので上書きしてよい)
+    PrepareSkinnedVertexResource();
+    const NodeHierarchy &nodes = model_->GetNodes();
+    poseModelMatrices_.resize(nodes.GetNodeCount());
+    NodeTransform::ComputeWorldMatrices(nodes.parents, GetPoseLocalMatrices(), MakeIdentity4x4(), poseModelMatrices_);
+    skinningPalette_.resize(model_->GetJoints().size());
+    Skinning::ComputePalette(model_->GetJoints(), poseModelMatrices_, skinningPalette_);
+
+    const std::span<const VertexData> vertices = model_->GetBindPoseVertices();
+    Skinning::SkinVertices(vertices, model_->GetInfluences(), skinningPalette_,
+                           std::span<VertexData>(skinnedVertexData_, vertices.size()));
+    skinnedModel_ = model_;
+
+    // 頂点の範囲は、ジョイントごとの範囲をパレットで動かしたものの和 (頂点はそれらの重み付き平均なので必ず収まる)
+    const std::span<const Joint> joints = model_->GetJoints();
+    poseBounds_ = BoundingVolume::MakeEmptyAABB();
+    for (size_t i = 0; i < joints.size(); ++i) {
+        if (!BoundingVolume::IsEmpty(joints[i].bounds)) {
+            BoundingVolume::Merge(poseBounds_, BoundingVolume::TransformAABB(joints[i].bounds, skinningPalette_[i]));
+        }
+    }
+    if (BoundingVolume::IsEmpty(poseBounds_)) {
+        poseBounds_ = model_->GetBounds().aabb;
+    }
+    isBoundsDirty_ = true;
+}
+
+void Object3d::UpdateWorldBounds(const Matrix4x4 &worldMatrix) {
+    if (!model_) {
+        worldBounds_ = {};
+        boundsModel_ = nullptr;
+        return;
+    }
+    if (!isBoundsDirty_ && boundsModel_ == model_ &&
+        std::memcmp(&boundsWorldMatrix_, &worldMatrix, sizeof(Matrix4x4)) == 0) {
+        return;
+    }
+
+    if (model_->IsSkinned() && skinnedModel_ == model_) {
+        // スキニング済みなら現在の姿勢の範囲から求める
+        worldBounds_.aabb = BoundingVolume::TransformAABB(poseBounds_, worldMatrix);
+        worldBounds_.sphere = BoundingVolume::TransformSphere(BoundingVolume::ComputeSphere(poseBounds_), worldMatrix);
+    } else {
+        const Bounds &bounds = model_->GetBounds();
+        worldBounds_.aabb = BoundingVolume::TransformAABB(bounds.aabb, worldMatrix);
+        worldBounds_.sphere = BoundingVolume::TransformSphere(bounds.sphere, worldMatrix);
+    }
+    boundsWorldMatrix_ = worldMatrix;
+    boundsModel_ = model_;
+    isBoundsDirty_ = false;
+}
+
+void Object3d::PrepareSkinnedVertexResource() {
+    const UINT sizeInBytes = static_cast<UINT>(sizeof(VertexData) * model_->GetBindPoseVertices().size());
+    if (skinnedVertexResource_ && skinnedVertexBufferView_.SizeInBytes >= sizeInBytes) {
+        return;
+    }
+
+    // モデルが変わって入らなくなった場合は、前のバッファをフレーム完了後に解放して作り直す
+    DX12Context *dxContext = DX12Context::GetInstance();
+    if (skinnedVertexResource_) {
+        skinnedVertexResource_->Unmap(0, nullptr);
+        skinnedVertexData_ = nullptr;
+        dxContext->DeferredRelease(std::move(skinnedVertexResource_));
+    }
+    skinnedVertexResource_ = dxContext->CreateBufferResource(sizeInBytes);
+    skinnedVertexResource_->Map(0, nullptr, reinterpret_cast<void **>(&skinnedVertexData_));
+    skinnedVertexBufferView_.BufferLocation = skinnedVertexResource_->GetGPUVirtualAddress();
+    skinnedVertexBufferView_.SizeInBytes = sizeInBytes;
+    skinnedVertexBufferView_.StrideInBytes = sizeof(VertexData);
+}
+
+void Object3d::SetColor(const Vector4 &color) { GetInstanceMaterial()->color = color; }
+
+void Object3d::SetEnableLighting(int32_t enableLighting) {
+    GetInstanceMaterial()->enableLighting = enableLighting;
+}
+
+void Object3d::SetEnvironmentCoefficient(float coefficient) {
+    GetInstanceMaterial()->environmentCoefficient = coefficient;
+}
+
+void Object3d::SetDissolveMaskTexture(const std::string &filePath) {
+    dissolveMaskFilePath_ = filePath;
+    TextureManager::GetInstance()->RequestTexture(dissolveMaskFilePath_);
+}
+
+void Object3d::SetDissolveParams(int32_t enable, float threshold, float edgeRange, const Vector3 &edgeColor) {
+    Material *material = GetInstanceMaterial();
+    material->enableDissolve = enable;
+    material->dissolveThreshold = threshold;
+    material->dissolveEdgeRange = edgeRange;
+    material->dissolveEdgeColor = edgeColor;
+}
+
+Material *Object3d::GetInstanceMaterial() {
+    if (materialData_) {
+        return materialData_;
+    }
+
+    // 初期値はモデルのマテリアル (環境マップ係数などモデル側の設定を引き継ぐ)
+    assert(model_ && "SetModel before changing the instance material");
+    materialResource_ = DX12Context::GetInstance()->CreateBufferResource(sizeof(Material));
+    materialResource_->Map(0, nullptr, reinterpret_cast<void **>(&materialData_));
+    *materialData_ = model_->GetMaterialData();
+    return materialData_;
+}
+
+float Object3d::ComputePixelsPerUnit(const Matrix4x4 &worldMatrix, const Camera &camera) const {
+    // ワールド行列の最大の拡大率 (球はどの向きにもこの倍率で大きくなるとみなす)
+    const float scale = BoundingVolume::ComputeMaxScale(worldMatrix);
+
+    const Sphere &boundingSphere = model_->GetBounds().sphere;
+    const Vector3 center = TransformPoint(boundingSphere.center, worldMatrix);
+    const Matrix4x4 &cameraMatrix = camera.GetWorldMatrix();
+    const Vector3 cameraPosition = {cameraMatrix.m[3][0], cameraMatrix.m[3][1], cameraMatrix.m[3][2]};
+    const float distance = Length(center - cameraPosition) - boundingSphere.radius * scale;
+    if (distance <= 0.0f) {
+        // カメラが球の中にある
+        return std::numeric_limits<float>::infinity();
+    }
+
+    // 透視投影では、距離 distance での長さ1は画面の高さの m[1][1] / (2 * distance) 倍に写る
+    const float halfScreenHeight = Win32Window::kClientHeight * 0.5f;
+    return scale * camera.GetProjectionMatrix().m[1][1] * halfScreenHeight / distance;
+}
+
+void Object3d::UpdateClusterCulling(uint32_t viewIndex, const Matrix4x4 &worldMatrix,
+                                    const Matrix4x4 &wvpMatrix, const Camera &camera) {
+    // 判定はモデル空間で行う (視錐台は WVP から、カメラ位置はワールド行列の逆で戻す)
+    const ClusterCuller::Frustum frustum = ClusterCuller::ExtractFrustum(wvpMatrix);
+    const Matrix4x4 &cameraMatrix = camera.GetWorldMatrix();
+    const Vector3 cameraPosition =
+        TransformPoint({cameraMatrix.m[3][0], cameraMatrix.m[3][1], cameraMatrix.m[3][2]}, Inverse(worldMatrix));
+
+    // 負のスケールで巻き順が反転している場合は、ラスタライザが捨てる面も反転するので裏面判定をしない
+    const Matrix4x4 &m = worldMatrix;
+    const float determinant = m.m[0][0] * (m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1]) -
+                              m.m[0][1] * (m.m[1][0] * m.m[2][2] - m.m[1][2] * m.m[2][0]) +
+                              m.m[0][2] * (m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0]);
+    const bool cullBackfaces = Object3dCommon::GetInstance()->IsBackfaceCulling() && determinant > 0.0f;
+
+    clusterCullStats_[viewIndex] =
+        ClusterCuller::Cull(model_->GetMeshlets(), frustum, cameraPosition, cullBackfaces, culledIndices_,
+                            culledGroupOffsets_[viewIndex]);
+
+    // 結果をビューのバッファに書き込む (フレームごとにGPUの完了を待っているので上書きしてよい)
+    PrepareCulledIndexResource(viewIndex);
+    if (culledIndexBufferViews_[viewIndex].Format == DXGI_FORMAT_R16_UINT) {
+        uint16_t *indices16 = static_cast<uint16_t *>(culledIndexData_[viewIndex]);
+        for (size_t i = 0; i < culledIndices_.size(); ++i) {
+            indices16[i] = static_cast<uint16_t>(culledIndices_[i]);
+        }
+    } else {
+        std::memcpy(culledIndexData_[viewIndex], culledIndices_.data(), culledIndices_.size() * sizeof(uint32_t));
+    }
+    isClusterCulled_[viewIndex] = true;
+}
+
+void Object3d::PrepareCulledIndexResource(uint32_t viewIndex) {
+    // モデルと同じインデックス形式で、LOD0 のすべての三角形が入る大きさにする
+    const DXGI_FORMAT format = model_->GetIndexBufferView().Format;
+    const size_t indexSize = format == DXGI_FORMAT_R16_UINT ? sizeof(uint16_t) : sizeof(uint32_t);
+    const UINT sizeInBytes = static_cast<UINT>(indexSize * model_->GetIndexCount());
+    D3D12_INDEX_BUFFER_VIEW &view = culledIndexBufferViews_[viewIndex];
+    if (culledIndexResources_[viewIndex] && view.Format == format && view.SizeInBytes >= sizeInBytes) {
+        return;
+    }
+
+    // モデルが変わって入らなくなった場合は、前のバッファをフレーム完了後に解放して作り直す
+    DX12Context *dxContext = DX12Context::GetInstance();
+    if (culledIndexResources_[viewIndex]) {
+        culledIndexResources_[viewIndex]->Unmap(0, nullptr);
+        culledIndexData_[viewIndex] = nullptr;
+        dxContext->DeferredRelease(std::move(culledIndexResources_[viewIndex]));
+    }
+    culledIndexResources_[viewIndex] = dxContext->CreateBufferResource(sizeInBytes);
+    culledIndexResources_[viewIndex]->Map(0, nullptr, &culledIndexData_[viewIndex]);
+    view.BufferLocation = culledIndexResources_[viewIndex]->GetGPUVirtualAddress();
+    view.SizeInBytes = sizeInBytes;
+    view.Format = format;
 }
 
 // 変換行列バッファの作成
@@ -2,9 +2,13 @@
 
 #include "Types/GraphicsTypes.h"
 #include "Types/LightTypes.h"
+#include "Model/AnimationSampler.h"
+#include "Model/ClusterCuller.h"
 
 #include <d3d12.h>
+#include <span>
 #include <string>
+#include <vector>
 #include <wrl/client.h>
 
 // 前方宣言
@@ -36,6 +40,59 @@ private: // メンバ変数
   // バッファリソース内のデータを指すポインタ
   TransformationMatrix *transformationMatrixData_[kMaxViews] = {nullptr};
 
+  // モデルのノードごとのワールド行列 (Update で求める。0 番がルート)
+  std::vector<Matrix4x4> nodeWorldMatrices_;
+
+  // アニメーション (再生位置とキー番号はインスタンスごとに持つ)
+  AnimationSampler animationSampler_;
+  float animationTime_ = 0.0f;
+  bool isAnimationLoop_ = true;
+  // 現在の姿勢のノードのローカル行列 (空ならモデルのローカル行列)
+  std::vector<Matrix4x4> poseLocalMatrices_;
+
+  // スキニング (スキンを持つモデルのみ。CPU でスキニングした頂点をインスタンスごとのバッファに書き込む)
+  std::vector<Matrix4x4> poseModelMatrices_; // 現在の姿勢のノードのモデル空間の行列
+  std::vector<Matrix4x4> skinningPalette_;
+  ComPtr<ID3D12Resource> skinnedVertexResource_;
+  VertexData *skinnedVertexData_ = nullptr;
+  D3D12_VERTEX_BUFFER_VIEW skinnedVertexBufferView_{};
+  // バッファの中身をスキニングしたモデル (別のモデルや未スキニングなら描画前にスキニングし直す)
+  const Model *skinnedModel_ = nullptr;
+  // 現在の姿勢の頂点の範囲 (モデル空間。スキニングのたびにジョイントの範囲から求める)
+  AABB poseBounds_ = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+
+  // ワールド空間の範囲 (ワールド行列・モデル・姿勢が変わったときだけ求め直す)
+  Bounds worldBounds_;
+  Matrix4x4 boundsWorldMatrix_{};
+  const Model *boundsModel_ = nullptr;
+  bool isBoundsDirty_ = true;
+
+  // ビューごとに選んだLOD番号 (Update で画面上の大きさから選ぶ)
+  uint32_t lodIndices_[kMaxViews] = {0};
+  // 各ビューの描画に使う結果のビュー番号 (Update() で全ビューを更新した場合はすべて0)
+  uint32_t viewSources_[kMaxViews] = {0, 1, 2};
+
+  // クラスタカリング (メッシュレットを持つモデルを LOD0 で描くときに、見えるメッシュレットだけを描く)
+  bool isClusterCulling_ = true;
+  // ビューごとのカリング後のインデックスバッファ (毎フレーム書き換えるのでマップしたままにする)
+  ComPtr<ID3D12Resource> culledIndexResources_[kMaxViews];
+  void *culledIndexData_[kMaxViews] = {nullptr};
+  D3D12_INDEX_BUFFER_VIEW culledIndexBufferViews_[kMaxViews]{};
+  // サブメッシュごとのカリング後のインデックスの開始位置 (最後に総数)
+  std::vector<uint32_t> culledGroupOffsets_[kMaxViews];
+  // true = このフレームはカリング後のインデックスで描く
+  bool isClusterCulled_[kMaxViews] = {false};
+  ClusterCuller::CullStats clusterCullStats_[kMaxViews]{};
+  // カリング結果の作業用 (32bit。バッファの形式に合わせて詰め直す)
+  std::vector<uint32_t> culledIndices_;
+
+  // インスタンスごとのマテリアル (最初に変更したときにモデルのマテリアルを複製して作る)
+  // 作るまではモデルのマテリアルで描くので、変更しないオブジェクトは追加のバッファを持たない
+  ComPtr<ID3D12Resource> materialResource_;
+  Material *materialData_ = nullptr;
+  // Dissolveマスク用テクスチャパス (空ならモデルのもの)
+  std::string dissolveMaskFilePath_;
+
   // Transform変数を作る
   Transform transform_ = {
       {1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
@@ -45,7 +102,7 @@ public: // メンバ関数
   // 初期化
   void Initialize();
 
-  // 更新
+  // 更新 (同じカメラで全ビューを更新する。計算はビュー0の分だけ行い、他のビューはその結果で描く)
   void Update();
   // 指定したビュー用の更新
   void Update(uint32_t viewIndex, Camera* camera);
@@ -53,10 +110,43 @@ public: // メンバ関数
   // 描画処理 (デフォルトはビュー0)
   void Draw(uint32_t viewIndex = 0);
 
+  // アニメーションを進める (1フレームに1回、Update より前に呼ぶ。スキンを持つモデルはここでスキニングする)
+  void UpdateAnimation(float deltaTime);
+
+  // アニメーションの再生 (名前はモデルのクリップ名。SetModel の後に呼ぶ)
+  void PlayAnimation(const std::string &name, bool loop = true);
+  // アニメーションの停止 (バインドポーズに戻る)
+  void StopAnimation();
+
 private: // 作成関数
   // 変換行列バッファの作成
   void CreateTransformationMatrixResource();
 
+  // モデル空間の長さ1が画面上で何ピクセルになるか (バウンディング球のカメラに最も近い点で測る)
+  float ComputePixelsPerUnit(const Matrix4x4 &worldMatrix, const Camera &camera) const;
+
+  // 見えるメッシュレットの三角形をビューのインデックスバッファに書き込む
+  void UpdateClusterCulling(uint32_t viewIndex, const Matrix4x4 &worldMatrix,
+                            const Matrix4x4 &wvpMatrix, const Camera &camera);
+
+  // カリング後のインデックスバッファをモデルの LOD0 が入る大きさにする
+  void PrepareCulledIndexResource(uint32_t viewIndex);
+
+  // 現在の姿勢のノードのローカル行列 (アニメーションしていなければモデルのもの)
+  std::span<const Matrix4x4> GetPoseLocalMatrices() const;
+
+  // 現在の姿勢で頂点をスキニングしてバッファに書き込む
+  void UpdateSkinning();
+
+  // スキニング後の頂点バッファをモデルの頂点が入る大きさにする
+  void PrepareSkinnedVertexResource();
+
+  // ワールド空間の範囲を更新する (前回と同じ行列・モデル・姿勢なら何もしない)
+  void UpdateWorldBounds(const Matrix4x4 &worldMatrix);
+
+  // インスタンスごとのマテリアルを取得する (無ければモデルのマテリアルを複製して作る)
+  Material *GetInstanceMaterial();
+
 public: // getter
   
   // 変換行列の取得
@@ -67,6 +157,23 @@ public: // getter
   const Vector3 &GetRotation() const { return transform_.rotate; }
   // スケールの取得
   const Vector3 &GetScale() const { return transform_.scale; }
+  // ノードごとのワールド行列の取得 (番号はモデルの NodeHierarchy のもの)
+  std::span<const Matrix4x4> GetNodeWorldMatrices() const { return nodeWorldMatrices_; }
+  // ワールド空間の範囲の取得 (Update で更新される)
+  const Bounds &GetWorldBounds() const { return worldBounds_; }
+  const AABB &GetWorldAABB() const { return worldBounds_.aabb; }
+  const Sphere &GetWorldSphere() const { return worldBounds_.sphere; }
+  // アニメーションの再生位置 (秒)
+  float GetAnimationTime() const { return animationTime_; }
+  bool IsAnimationPlaying() const { return animationSampler_.HasClip(); }
+  // 選ばれているLOD番号の取得
+  uint32_t GetLodIndex(uint32_t viewIndex = 0) const { return lodIndices_[viewSources_[viewIndex]]; }
+  // インスタンスごとのマテリアルを持っているか
+  bool HasInstanceMaterial() const { return materialData_ != nullptr; }
+  // クラスタカリングの結果の取得 (カリングしなかったフレームは0のまま)
+  const ClusterCuller::CullStats &GetClusterCullStats(uint32_t viewIndex = 0) const {
+    return clusterCullStats_[viewSources_[viewIndex]];
+  }
 
 #ifdef USE_IMGUI
   // モデルの取得
@@ -77,12 +184,23 @@ public: // getter
 
 public: // setter
   // モデルの設定
-  void SetModel(Model *model) { model_ = model; };
+  void SetModel(Model *model);
   void SetModel(const std::string &filepath);
 
   // カメラの設定
   void SetCamera(Camera *camera) { camera_ = camera; };
 
+  // クラスタカリングの有効/無効 (既定は有効。メッシュレットの無いモデルでは何もしない)
+  void SetClusterCulling(bool enable) { isClusterCulling_ = enable; }
+
+  // インスタンスごとのマテリアルの設定 (モデルは共有したまま、このオブジェクトだけ変える)
+  // マテリアルは SetModel で別のモデルに変えると破棄されるので、SetModel の後に呼ぶこと
+  void SetColor(const Vector4 &color);
+  void SetEnableLighting(int32_t enableLighting);
+  void SetEnvironmentCoefficient(float coefficient);
+  void SetDissolveMaskTexture(const std::string &filePath);
+  void SetDissolveParams(int32_t enable, float threshold, float edgeRange, const Vector3 &edgeColor);
+
   // 座標の設定
   void SetTranslate(const Vector3 &translate) {
     transform_.translate = translate;
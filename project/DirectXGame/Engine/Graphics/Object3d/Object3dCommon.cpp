@@ -45,6 +45,17 @@ void Object3dCommon::Initialize() {
   };
   // const UINT kNumElements = _countof(inputLayout);
 
+  // 圧縮頂点のレイアウト (位置の形式は CompactVertexData / CompactHalfVertexData で差し替える)
+  D3D12_INPUT_ELEMENT_DESC compactInputLayout[] = {
+      {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0,
+       D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+       0},
+      {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+      {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+  };
+
   // ラスタライザステート
   D3D12_RASTERIZER_DESC rasterizerDesc = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
 #ifdef _DEBUG
@@ -52,6 +63,8 @@ void Object3dCommon::Initialize() {
 #else
   rasterizerDesc.CullMode = D3D12_CULL_MODE_BACK; // 背面カリング <==== ※本来はこっち
 #endif // _DEBUG
+  // 裏面を捨てているときだけ、クラスタカリングでも裏向きのメッシュレットを捨てられる
+  isBackfaceCulling_ = rasterizerDesc.CullMode == D3D12_CULL_MODE_BACK;
 
 
   // デプスステンシルステート
@@ -71,9 +84,19 @@ void Object3dCommon::Initialize() {
           depthStencilDesc.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO; // 書き込み無効
       }
 
-      psoArray_[i] = PipelineManager::GetInstance()->CreateObject3dPSO(
+      psoArray_[kVertexFormatFull][i] = PipelineManager::GetInstance()->CreateObject3dPSO(
           inputLayout, _countof(inputLayout), rasterizerDesc, depthStencilDesc,
           blendDescs[i]);
+
+      // 圧縮頂点用 (float3 の位置はシェーダーで w = 1 になる)
+      compactInputLayout[0].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+      psoArray_[kVertexFormatCompact][i] = PipelineManager::GetInstance()->CreateObject3dPSO(
+          compactInputLayout, _countof(compactInputLayout), rasterizerDesc,
+          depthStencilDesc, blendDescs[i], kVertexFormatCompact);
+      compactInputLayout[0].Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
+      psoArray_[kVertexFormatCompactHalf][i] = PipelineManager::GetInstance()->CreateObject3dPSO(
+          compactInputLayout, _countof(compactInputLayout), rasterizerDesc,
+          depthStencilDesc, blendDescs[i], kVertexFormatCompactHalf);
   }
 }
 
@@ -88,15 +111,14 @@ void Object3dCommon::SetCommonDrawSettings(BlendState currentBlendMode) {
   // ルートシグネチャ、PSO、トポロジの設定
   DX12Context::GetInstance()->GetCommandList()->SetGraphicsRootSignature(
       PipelineManager::GetInstance()->Get3DRootSignature());
-  if (currentBlendMode >= 0 && currentBlendMode < kCountOfBlendMode) {
-    // PSOを設定
-    DX12Context::GetInstance()->GetCommandList()->SetPipelineState(
-        psoArray_[currentBlendMode].Get());
-  } else {
-    // 不正な値の場合
-    DX12Context::GetInstance()->GetCommandList()->SetPipelineState(
-        psoArray_[kBlendModeNormal].Get());
-  }
+  // 不正な値の場合は通常ブレンドにする
+  currentBlendMode_ = (currentBlendMode >= 0 && currentBlendMode < kCountOfBlendMode)
+                          ? currentBlendMode
+                          : kBlendModeNormal;
+  currentVertexFormat_ = kVertexFormatFull;
+  // PSOを設定
+  DX12Context::GetInstance()->GetCommandList()->SetPipelineState(
+      psoArray_[currentVertexFormat_][currentBlendMode_].Get());
   DX12Context::GetInstance()->GetCommandList()->IASetPrimitiveTopology(
       D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
@@ -114,3 +136,13 @@ void Object3dCommon::SetCommonDrawSettings(BlendState currentBlendMode) {
   // 4. 環境マップの設定 (RootParameter Index 7)
   SrvManager::GetInstance()->SetGraphicsRootDescriptorTable(7, environmentMapSrvIndex_);
 }
+
+void Object3dCommon::SetVertexFormat(VertexFormat vertexFormat) {
+  if (vertexFormat == currentVertexFormat_ || vertexFormat < 0 ||
+      vertexFormat >= kCountOfVertexFormat) {
+    return;
+  }
+  currentVertexFormat_ = vertexFormat;
+  DX12Context::GetInstance()->GetCommandList()->SetPipelineState(
+      psoArray_[currentVertexFormat_][currentBlendMode_].Get());
+}
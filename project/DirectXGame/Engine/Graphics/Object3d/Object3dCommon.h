@@ -6,6 +6,7 @@
 #include <memory> // std::unique_ptr用に必要
 
 #include "BlendMode/BlendMode.h"
+#include "Types/GraphicsTypes.h"
 
 // 前方宣言
 class Camera;
@@ -34,13 +35,20 @@ private: // メンバ変数
   // デフォルトカメラ
   Camera* defaultCamera_ = nullptr;
 
-  // グラフィックスパイプラインステート (ブレンドモードごとに配列で保持)
+  // グラフィックスパイプラインステート (頂点形式・ブレンドモードごとに配列で保持)
   ComPtr<ID3D12PipelineState>
-      psoArray_[BlendMode::BlendState::kCountOfBlendMode];
+      psoArray_[kCountOfVertexFormat][BlendMode::BlendState::kCountOfBlendMode];
+
+  // 現在コマンドリストに設定している頂点形式とブレンドモード
+  VertexFormat currentVertexFormat_ = kVertexFormatFull;
+  BlendMode::BlendState currentBlendMode_ = BlendMode::kBlendModeNormal;
 
   // 環境マップ
   uint32_t environmentMapSrvIndex_ = 0;
 
+  // PSOのラスタライザが裏面を捨てているか
+  bool isBackfaceCulling_ = false;
+
 public: // シングルトンインスタンス取得
     static Object3dCommon* GetInstance();
     static void Destroy();
@@ -56,11 +64,17 @@ public: // メンバ関数
 
   // 共通描画設定
   void SetCommonDrawSettings(BlendMode::BlendState currentBlendMode);
+
+  // モデルの頂点形式に合わせてPSOを切り替える (同じ形式なら何もしない)
+  void SetVertexFormat(VertexFormat vertexFormat);
   // getter
 
   // デフォルトカメラの取得
   Camera* GetDefaultCamera() const { return defaultCamera_; };
 
+  // 裏面カリングが有効か (Debug ビルドでは無効)
+  bool IsBackfaceCulling() const { return isBackfaceCulling_; }
+
   // setter
 
   // デフォルトカメラの設定(最初に設定しておく用)
@@ -98,7 +98,7 @@ PipelineManager::CreateSpritePSO(const D3D12_BLEND_DESC& blendDesc) {
 }
 
 ComPtr<ID3D12PipelineState>
-PipelineManager::CreateParticlePSO(const D3D12_BLEND_DESC& blendDesc) {
+PipelineManager::CreateParticlePSO(const D3D12_BLEND_DESC& blendDesc, bool isTrail) {
 
 	// ---------------------------------------------------------------------
 	// I. サブステートの定義 (BlendState, RasterizerState, DepthStencilState,
@@ -125,9 +125,10 @@ PipelineManager::CreateParticlePSO(const D3D12_BLEND_DESC& blendDesc) {
 		D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
 	inputElementDescs[1].InstanceDataStepRate = 0;
 
-	inputElementDescs[2].SemanticName = "NORMAL";
+	// トレイルは法線の代わりに頂点色を持つ (TrailVertexData)
+	inputElementDescs[2].SemanticName = isTrail ? "COLOR" : "NORMAL";
 	inputElementDescs[2].SemanticIndex = 0;
-	inputElementDescs[2].Format = DXGI_FORMAT_R32G32B32_FLOAT;
+	inputElementDescs[2].Format = isTrail ? DXGI_FORMAT_R32G32B32A32_FLOAT : DXGI_FORMAT_R32G32B32_FLOAT;
 	inputElementDescs[2].InputSlot = 0;
 	inputElementDescs[2].AlignedByteOffset = D3D12_APPEND_ALIGNED_ELEMENT;
 	inputElementDescs[2].InputSlotClass =
@@ -158,8 +159,8 @@ PipelineManager::CreateParticlePSO(const D3D12_BLEND_DESC& blendDesc) {
 
 	// シェーダとシグネチャ (パイプラインの核となる部分)
 	psoDesc.pRootSignature = rootSignatureParticle_.Get();
-	psoDesc.VS = { vsBlobParticle_->GetBufferPointer(),
-				  vsBlobParticle_->GetBufferSize() };
+	IDxcBlob* vsBlob = isTrail ? vsBlobParticleTrail_.Get() : vsBlobParticle_.Get();
+	psoDesc.VS = { vsBlob->GetBufferPointer(), vsBlob->GetBufferSize() };
 	psoDesc.PS = { psBlobParticle_->GetBufferPointer(),
 				  psBlobParticle_->GetBufferSize() };
 
@@ -605,15 +606,17 @@ ComPtr<ID3D12PipelineState> PipelineManager::CreateObject3dPSO(
 	uint32_t numElements,
 	const D3D12_RASTERIZER_DESC& rasterizerDesc, // Object3dCommonが決定
 	const D3D12_DEPTH_STENCIL_DESC& depthStencilDesc,
-	const D3D12_BLEND_DESC& blendDesc) {
+	const D3D12_BLEND_DESC& blendDesc,
+	VertexFormat vertexFormat) {
 	HRESULT hr;
 
 	// PSO設定の雛形を作成
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc{};
 	// ルートシグネチャを設定
 	psoDesc.pRootSignature = rootSignature3D_.Get();
-	// シェーダーを設定
-	psoDesc.VS = { vsBlob3D_->GetBufferPointer(), vsBlob3D_->GetBufferSize() };
+	// シェーダーを設定 (圧縮頂点は八面体エンコードの法線を復元するシェーダーを使う)
+	IDxcBlob* vsBlob = vertexFormat == kVertexFormatFull ? vsBlob3D_.Get() : vsBlob3DCompact_.Get();
+	psoDesc.VS = { vsBlob->GetBufferPointer(), vsBlob->GetBufferSize() };
 	psoDesc.PS = { psBlob3D_->GetBufferPointer(), psBlob3D_->GetBufferSize() };
 	// 入力レイアウトを設定
 	psoDesc.InputLayout = { inputLayout, numElements };
@@ -652,12 +655,16 @@ void PipelineManager::LoadShader() {
 	// オブジェクト用
 	vsBlob3D_ = DX12Context::GetInstance()->CompileShader(L"Object3d.VS.hlsl", L"vs_6_0");
 	assert(vsBlob3D_ != nullptr);
+	vsBlob3DCompact_ = DX12Context::GetInstance()->CompileShader(L"Object3dCompact.VS.hlsl", L"vs_6_0");
+	assert(vsBlob3DCompact_ != nullptr);
 	psBlob3D_ = DX12Context::GetInstance()->CompileShader(L"Object3d.PS.hlsl", L"ps_6_0");
 	assert(psBlob3D_ != nullptr);
 
 	// パーティクル用
 	vsBlobParticle_ = DX12Context::GetInstance()->CompileShader(L"Particle.VS.hlsl", L"vs_6_0");
 	assert(vsBlobParticle_ != nullptr);
+	vsBlobParticleTrail_ = DX12Context::GetInstance()->CompileShader(L"ParticleTrail.VS.hlsl", L"vs_6_0");
+	assert(vsBlobParticleTrail_ != nullptr);
 	psBlobParticle_ = DX12Context::GetInstance()->CompileShader(L"Particle.PS.hlsl", L"ps_6_0");
 	assert(psBlobParticle_ != nullptr);
 
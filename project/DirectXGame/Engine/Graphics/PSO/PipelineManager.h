@@ -6,6 +6,8 @@
 #include <cstdint> // uint32_t用に必要
 #include <memory> // std::unique_ptr用に必要
 
+#include "Types/GraphicsTypes.h" // VertexFormat用に必要
+
 class PipelineManager {
 public:
     // 【Passkey Idiom】
@@ -31,11 +33,13 @@ private: // メンバ変数
 
     // --- 3D描画用アセット ---
     ComPtr<IDxcBlob> vsBlob3D_;                   // Vertex Shader
+    ComPtr<IDxcBlob> vsBlob3DCompact_;            // Vertex Shader (圧縮頂点用)
     ComPtr<IDxcBlob> psBlob3D_;                   // Pixel Shader
     ComPtr<ID3D12RootSignature> rootSignature3D_; // ルートシグネチャ
 
     // --- Particle描画用アセット ---
     ComPtr<IDxcBlob> vsBlobParticle_;                   // Vertex Shader
+    ComPtr<IDxcBlob> vsBlobParticleTrail_;              // Vertex Shader (トレイルの頂点色付き頂点用)
     ComPtr<IDxcBlob> psBlobParticle_;                   // Pixel Shader
     ComPtr<ID3D12RootSignature> rootSignatureParticle_; // ルートシグネチャ
 
@@ -92,8 +96,9 @@ public: // メンバ関数
         CreateSpritePSO(const D3D12_BLEND_DESC& blendDesc);
 
     // Particle用のグラフィックスパイプラインを生成して返す関数
+    // isTrail = true の場合はトレイルの頂点 (TrailVertexData) を読むPSOを生成する
     ComPtr<ID3D12PipelineState>
-        CreateParticlePSO(const D3D12_BLEND_DESC& blendDesc);
+        CreateParticlePSO(const D3D12_BLEND_DESC& blendDesc, bool isTrail = false);
 
     // Skybox用のグラフィックスパイプラインを生成して返す関数
     ComPtr<ID3D12PipelineState> CreateSkyboxPSO();
@@ -104,7 +109,8 @@ public: // メンバ関数
         uint32_t numElements,
         const D3D12_RASTERIZER_DESC& rasterizerDesc, // Object3dCommonが決定
         const D3D12_DEPTH_STENCIL_DESC& depthStencilDesc,
-        const D3D12_BLEND_DESC& blendDesc);
+        const D3D12_BLEND_DESC& blendDesc,
+        VertexFormat vertexFormat = kVertexFormatFull); // 圧縮頂点なら法線を復元するシェーダーを使う
 
     // ポストエフェクト用のグラフィックスパイプラインを生成して返す関数 (CopyImage passthrough)
     ComPtr<ID3D12PipelineState> CreatePostProcessPSO();
@@ -0,0 +1,93 @@
+#include "ParticleCurve.h"
+
+#include <utility>
+
+namespace {
+
+float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+Vector4 Lerp(const Vector4& a, const Vector4& b, float t) { return {Lerp(a.x, b.x, t), Lerp(a.y, b.y, t), Lerp(a.z, b.z, t), Lerp(a.w, b.w, t)}; }
+
+// キーを時間順に並べ、範囲外の時間を 0～1 に収める (ImGui での編集後は順不同になりうる)
+template <typename Key> std::vector<Key> SortKeys(const std::vector<Key>& keys) {
+    std::vector<Key> sorted = keys;
+    for (Key& key : sorted) {
+        key.time = std::clamp(key.time, 0.0f, 1.0f);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Key& a, const Key& b) { return a.time < b.time; });
+    return sorted;
+}
+
+// 時間順のキー列を折れ線として評価する
+template <typename Key, typename Getter> auto EvaluateKeys(const std::vector<Key>& keys, float t, Getter get) {
+    if (t <= keys.front().time) {
+        return get(keys.front());
+    }
+    for (size_t i = 1; i < keys.size(); ++i) {
+        if (t <= keys[i].time) {
+            const Key& a = keys[i - 1];
+            const Key& b = keys[i];
+            const float span = b.time - a.time;
+            const float s = span > 0.0f ? (t - a.time) / span : 1.0f;
+            return Lerp(get(a), get(b), s);
+        }
+    }
+    return get(keys.back());
+}
+} // namespace
+
+// ============================================================
+// ParticleCurve
+// ============================================================
+
+ParticleCurve::ParticleCurve() : ParticleCurve({{0.0f, 1.0f}, {1.0f, 1.0f}}) {}
+
+ParticleCurve::ParticleCurve(std::vector<CurveKey> initialKeys) : keys(std::move(initialKeys)) { Bake(); }
+
+void ParticleCurve::Bake() {
+    if (keys.empty()) {
+        lutBase.fill(1.0f);
+        lutSlope.fill(0.0f);
+        return;
+    }
+
+    const std::vector<CurveKey> sorted = SortKeys(keys);
+    auto evaluate = [&sorted](float t) { return EvaluateKeys(sorted, t, [](const CurveKey& key) { return key.value; }); };
+
+    const float step = 1.0f / static_cast<float>(kParticleCurveLutSize);
+    float start = evaluate(0.0f);
+    for (uint32_t i = 0; i < kParticleCurveLutSize; ++i) {
+        const float end = evaluate(static_cast<float>(i + 1) * step);
+        lutBase[i] = start;
+        lutSlope[i] = end - start;
+        start = end;
+    }
+}
+
+// ============================================================
+// ParticleGradient
+// ============================================================
+
+ParticleGradient::ParticleGradient() : ParticleGradient({{0.0f, {1.0f, 1.0f, 1.0f, 1.0f}}, {1.0f, {1.0f, 1.0f, 1.0f, 0.0f}}}) {}
+
+ParticleGradient::ParticleGradient(std::vector<GradientKey> initialKeys) : keys(std::move(initialKeys)) { Bake(); }
+
+void ParticleGradient::Bake() {
+    if (keys.empty()) {
+        lutBase.fill({1.0f, 1.0f, 1.0f, 1.0f});
+        lutSlope.fill({0.0f, 0.0f, 0.0f, 0.0f});
+        return;
+    }
+
+    const std::vector<GradientKey> sorted = SortKeys(keys);
+    auto evaluate = [&sorted](float t) { return EvaluateKeys(sorted, t, [](const GradientKey& key) { return key.color; }); };
+
+    const float step = 1.0f / static_cast<float>(kParticleCurveLutSize);
+    Vector4 start = evaluate(0.0f);
+    for (uint32_t i = 0; i < kParticleCurveLutSize; ++i) {
+        const Vector4 end = evaluate(static_cast<float>(i + 1) * step);
+        lutBase[i] = start;
+        lutSlope[i] = {end.x - start.x, end.y - start.y, end.z - start.z, end.w - start.w};
+        start = end;
+    }
+}
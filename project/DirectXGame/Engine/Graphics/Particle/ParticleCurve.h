@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// 寿命に応じて変化する値 (曲線/グラデーション)
+// キーは編集時に固定長の LUT に焼き込み、更新時は LUT を引くだけにする
+// D3D12に依存しないので、GPUなしでも単体で実行・検証できる
+// ============================================================
+
+// LUT の区間数 (キーの数に関わらずサンプルのコストは一定)
+static const uint32_t kParticleCurveLutSize = 32;
+
+// 曲線のキー (time は 0 = 発生時, 1 = 寿命)
+struct CurveKey {
+    float time;
+    float value;
+};
+
+// グラデーションのキー
+struct GradientKey {
+    float time;
+    Vector4 color;
+};
+
+// 寿命に応じて変化するスカラー値 (スケール倍率、減衰率など)
+struct ParticleCurve {
+    bool isActive = false;
+    std::vector<CurveKey> keys; // 編集用のキー (Bake で LUT に反映する)
+
+    // 区間ごとの始点の値と区間内の変化量 (Sample は積和1回で求まる)
+    std::array<float, kParticleCurveLutSize> lutBase{};
+    std::array<float, kParticleCurveLutSize> lutSlope{};
+
+    // 値が常に 1 の曲線
+    ParticleCurve();
+    // 指定したキーで初期化して焼き込む
+    explicit ParticleCurve(std::vector<CurveKey> initialKeys);
+
+    // キーを LUT に焼き込む (キーを編集したら必ず呼ぶ)
+    void Bake();
+
+    // LUT から値を求める (t は寿命に対する割合)
+    float Sample(float t) const {
+        const float x = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(kParticleCurveLutSize);
+        const uint32_t index = std::min(static_cast<uint32_t>(x), kParticleCurveLutSize - 1);
+        return lutBase[index] + lutSlope[index] * (x - static_cast<float>(index));
+    }
+};
+
+// 寿命に応じて変化する色
+struct ParticleGradient {
+    bool isActive = false;
+    std::vector<GradientKey> keys; // 編集用のキー (Bake で LUT に反映する)
+
+    std::array<Vector4, kParticleCurveLutSize> lutBase{};
+    std::array<Vector4, kParticleCurveLutSize> lutSlope{};
+
+    // 白から透明へフェードするグラデーション (従来のアルファの減衰と同じ)
+    ParticleGradient();
+    // 指定したキーで初期化して焼き込む
+    explicit ParticleGradient(std::vector<GradientKey> initialKeys);
+
+    // キーを LUT に焼き込む (キーを編集したら必ず呼ぶ)
+    void Bake();
+
+    // LUT から色を求める (t は寿命に対する割合)
+    Vector4 Sample(float t) const {
+        const float x = std::clamp(t, 0.0f, 1.0f) * static_cast<float>(kParticleCurveLutSize);
+        const uint32_t index = std::min(static_cast<uint32_t>(x), kParticleCurveLutSize - 1);
+        const float frac = x - static_cast<float>(index);
+        const Vector4& base = lutBase[index];
+        const Vector4& slope = lutSlope[index];
+        return {base.x + slope.x * frac, base.y + slope.y * frac, base.z + slope.z * frac, base.w + slope.w * frac};
+    }
+};
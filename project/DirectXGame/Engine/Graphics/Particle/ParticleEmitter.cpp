@@ -1,5 +1,4 @@
 #include "ParticleEmitter.h"
-#include "ParticleManager.h"
 
 // 共通のコピー処理を行うヘルパー関数
 void CopyEmitterMembers(const ParticleEmitter& src, ParticleEmitter& dest) {
@@ -14,6 +13,7 @@ void CopyEmitterMembers(const ParticleEmitter& src, ParticleEmitter& dest) {
 	dest.generateSettings = src.generateSettings;
 	dest.fieldSettings = src.fieldSettings;
 	dest.uvAnimationSettings = src.uvAnimationSettings;
+	dest.subEmitters = src.subEmitters;
 
 	// shapeのディープコピー
 	if (src.shape) {
@@ -55,14 +55,8 @@ void ParticleEmitter::SetShapeType(ParticleShapeType type) {
 	case ParticleShapeType::Plane:
 		shape = std::make_unique<PlaneShape>();
 		break;
+	case ParticleShapeType::Trail:
+		shape = std::make_unique<TrailShape>();
+		break;
 	}
 }
-
-void ParticleEmitter::Emit(const std::string& groupName) {
-	// エミッタの設定値に従って、ParticleManager::GetInstance()->Emit を呼び出す
-	ParticleManager::GetInstance()->Emit(
-		groupName,
-		this->transform.translate, // エミッタの現在位置
-		this->count                // 設定された個数
-	);
-}
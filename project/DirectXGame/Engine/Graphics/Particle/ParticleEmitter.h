@@ -3,10 +3,12 @@
 #include "Types/GraphicsTypes.h"
 #include "Types/ParticleTypes.h"
 #include "ParticleShape.h"
+#include "ParticleCurve.h"
 
 #include <string>
 #include <numbers>
 #include <memory>
+#include <vector>
 
 struct ParticleGenerateSettings {
 	bool isRandomScale = true;
@@ -33,6 +35,11 @@ struct ParticleGenerateSettings {
 	Vector4 colorMin = { 0.0f, 0.0f, 0.0f, 1.0f };
 	Vector4 colorMax = { 1.0f, 1.0f, 1.0f, 1.0f };
 	Vector4 fixedColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	// 寿命に応じた変化 (キーの編集時に LUT へ焼き込む)
+	ParticleGradient colorOverLife;  // 色 (発生時の色に乗算。無効時はアルファを線形に減衰)
+	ParticleCurve sizeOverLife;      // スケールの倍率
+	ParticleCurve dampingOverLife{ { { 0.0f, 0.0f }, { 1.0f, 0.0f } } }; // 速度の減衰率 (1秒あたり)
 };
 
 struct ParticleFieldSettings {
@@ -85,13 +92,15 @@ public:
 	// 形状を取得 (型識別用)
 	ParticleShapeType GetShapeType() const { return shape ? shape->GetType() : ParticleShapeType::Billboard; }
 
-	// 形状を切り替える (既存の Model リソースも解放される)
+	// 形状を切り替える (以前のメッシュはキャッシュ側でフェンス完了後に解放される)
 	void SetShapeType(ParticleShapeType type);
 
 	// 型を安全にキャストして取得するヘルパー
 	RingShape* GetRingShape() { return dynamic_cast<RingShape*>(shape.get()); }
 	CylinderShape* GetCylinderShape() { return dynamic_cast<CylinderShape*>(shape.get()); }
 	PlaneShape* GetPlaneShape() { return dynamic_cast<PlaneShape*>(shape.get()); }
+	TrailShape* GetTrailShape() { return dynamic_cast<TrailShape*>(shape.get()); }
+	const TrailShape* GetTrailShape() const { return dynamic_cast<const TrailShape*>(shape.get()); }
 
 	void Emit(const std::string& groupName);
 
@@ -108,6 +117,7 @@ public:
 	ParticleGenerateSettings generateSettings; // 生成時の設定
 	ParticleFieldSettings fieldSettings;       // フィールドの設定
 	ParticleUVAnimationSettings uvAnimationSettings; // UVアニメーションの設定
+	std::vector<SubEmitterSettings> subEmitters;     // サブエミッターの設定 (発生/消滅時に別グループから発生)
 
 	// 多態性を持った形状クラスのポインタ
 	std::unique_ptr<ParticleShape> shape;
@@ -0,0 +1,33 @@
+#include "ParticleEventBuffer.h"
+
+#include <algorithm>
+#include <tuple>
+
+bool ParticleEventBuffer::Push(const ParticleEvent& event) {
+    // スロットを原子的に予約し、予約したスロットにだけ書き込む
+    const uint32_t slot = count_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= kCapacity) {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    events_[slot] = event;
+    return true;
+}
+
+void ParticleEventBuffer::Sort() {
+    const uint32_t count = std::min(count_.load(std::memory_order_acquire), kCapacity);
+    std::sort(events_.begin(), events_.begin() + count, [](const ParticleEvent& a, const ParticleEvent& b) {
+        return std::tie(a.sourceGroupId, a.trigger, a.sequence, a.subEmitterIndex) <
+               std::tie(b.sourceGroupId, b.trigger, b.sequence, b.subEmitterIndex);
+    });
+}
+
+std::span<const ParticleEvent> ParticleEventBuffer::GetEvents() const {
+    const uint32_t count = std::min(count_.load(std::memory_order_acquire), kCapacity);
+    return std::span<const ParticleEvent>(events_.data(), count);
+}
+
+void ParticleEventBuffer::Clear() {
+    count_.store(0, std::memory_order_relaxed);
+    droppedCount_.store(0, std::memory_order_relaxed);
+}
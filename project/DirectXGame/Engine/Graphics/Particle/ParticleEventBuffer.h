@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Types/ParticleTypes.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+// ============================================================
+// ParticleEventBuffer — 1フレーム分のパーティクルイベントを溜める固定長バッファ
+// Push はロックを使わないので、並列に更新しているスレッドから同時に呼び出してよい
+// 読み出し(Sort/GetEvents/Clear)は、書き込みが全て終わってから1スレッドで行うこと
+// ============================================================
+class ParticleEventBuffer {
+public:
+    // 1フレームに溜められるイベント数 (超えた分は破棄してカウントする)
+    static const uint32_t kCapacity = 1024;
+
+    /// <summary>
+    /// イベントを追加する (ロックフリー)
+    /// </summary>
+    /// <param name="event">追加するイベント</param>
+    /// <returns>true = 追加できた、false = 容量オーバーで破棄した</returns>
+    bool Push(const ParticleEvent& event);
+
+    // 溜まったイベントを決定的な順序 (発生元グループ → タイミング → 順番) に並び替える
+    // 書き込み順はスレッドのスケジュールで変わるため、処理前に必ず呼ぶ
+    // (グループごとの通し番号でキーが一意になるので、std::sort でも結果は1通りに決まる)
+    void Sort();
+
+    // 溜まったイベントを取得する
+    std::span<const ParticleEvent> GetEvents() const;
+
+    // 容量オーバーで破棄したイベント数
+    uint32_t GetDroppedCount() const { return droppedCount_.load(std::memory_order_relaxed); }
+
+    // バッファを空にする
+    void Clear();
+
+private:
+    std::array<ParticleEvent, kCapacity> events_{};
+    std::atomic<uint32_t> count_ = 0;        // 予約済みのスロット数 (容量を超えることがある)
+    std::atomic<uint32_t> droppedCount_ = 0; // 容量オーバーで破棄した数
+};
@@ -9,6 +9,9 @@
 #include "PSO/PipelineManager.h"
 #include "Texture/TextureManager.h"
 #include "Model/Model.h"
+#include "ParticleSimulation.h"
+#include "ParticleTrail.h"
+#include "ShapeMeshCache.h"
 
 #include <algorithm>
 #include <assert.h>
@@ -79,8 +82,7 @@ void ParticleManager::SetGroupTexture(const std::string& name, const std::string
 	auto it = particleGroups_.find(name);
 	if (it != particleGroups_.end()) {
 		it->second.materialData.textureFilePath = textureFilePath;
-		TextureManager::GetInstance()->LoadTexture(textureFilePath);
-		it->second.materialData.textureIndex = TextureManager::GetInstance()->GetSrvIndex(textureFilePath);
+		it->second.materialData.textureIndex = TextureManager::GetInstance()->RequestTexture(textureFilePath);
 	}
 }
 
@@ -92,11 +94,6 @@ std::string ParticleManager::GetGroupTexture(const std::string& name) const {
 	return "";
 }
 
-void ParticleManager::ReleaseIntermediateResources() {
-	// GPUがコマンド実行を完了した後、保持していたアップロードリソースをクリアする
-	intermediateResources_.clear();
-}
-
 // 終了
 void ParticleManager::Finalize() {
 	// リソースの解放
@@ -108,12 +105,27 @@ void ParticleManager::Finalize() {
 			group.instanceResource->Unmap(0, nullptr);
 			group.mappedData = nullptr;
 		}
+		if (group.trailVertexData) {
+			group.trailVertexResource->Unmap(0, nullptr);
+			group.trailVertexData = nullptr;
+		}
+		if (group.trailIndexData) {
+			group.trailIndexResource->Unmap(0, nullptr);
+			group.trailIndexData = nullptr;
+		}
 		/*if (group.materialMappedData) {
 		  group.materialResource->Unmap(0, nullptr);
 		  group.materialMappedData = nullptr;
 		}*/
 	}
 	particleGroups_.clear(); // グループのクリア
+	groupsById_.clear();
+	eventBuffers_[0].Clear();
+	eventBuffers_[1].Clear();
+
+	// 形状メッシュのキャッシュを破棄 (ワーカースレッドも停止する)
+	ShapeMeshCache::GetInstance()->Finalize();
+	ShapeMeshCache::Destroy();
 
 	// 頂点リソースの解放
 	vertexResource_.Reset();
@@ -123,6 +135,9 @@ void ParticleManager::Finalize() {
 }
 
 void ParticleManager::Initialize() {
+	// 形状メッシュのキャッシュ (再構築用ワーカースレッド) を起動
+	ShapeMeshCache::GetInstance()->Initialize();
+
 	// BlendModeごとの設定は汎用関数から取得
 	std::array<D3D12_BLEND_DESC, kCountOfBlendMode> blendDescs =
 		CreateBlendStateDescs();
@@ -130,6 +145,7 @@ void ParticleManager::Initialize() {
 	// パイプラインマネージャを使って、ブレンドモードごとのPSOを生成
 	for (size_t i = 0; i < kCountOfBlendMode; ++i) {
 		particlePsoArray_[i] = PipelineManager::GetInstance()->CreateParticlePSO(blendDescs[i]);
+		trailPsoArray_[i] = PipelineManager::GetInstance()->CreateParticlePSO(blendDescs[i], true);
 	}
 
 	// ランダムエンジンの初期化
@@ -156,110 +172,18 @@ void ParticleManager::Initialize() {
 	const UINT kVertexCount = _countof(vertices); // 4
 	const UINT sizeVB = sizeof(VertexData) * kVertexCount;
 
-	// 頂点リソースの生成
-
-	// 1. Default Heap にリソースを生成 (テクスチャと同じ構造)
-	D3D12_RESOURCE_DESC vertexResourceDesc{};
-	vertexResourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-	vertexResourceDesc.Width = sizeVB;
-	vertexResourceDesc.Height = 1;
-	vertexResourceDesc.DepthOrArraySize = 1;
-	vertexResourceDesc.MipLevels = 1;
-	// ... (その他、バッファに必要な設定)
-	vertexResourceDesc.SampleDesc.Count = 1;
-	vertexResourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-	const D3D12_HEAP_PROPERTIES defaultHeapProps =
-		CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
-
-	HRESULT hr = DX12Context::GetInstance()->GetDevice()->CreateCommittedResource(
-		&defaultHeapProps, // Default Heap!
-		D3D12_HEAP_FLAG_NONE, &vertexResourceDesc, D3D12_RESOURCE_STATE_COMMON,
-		nullptr, IID_PPV_ARGS(&vertexResource_));
-	assert(SUCCEEDED(hr));
-
-	// 2. 中間アップロードリソースを生成
-	ComPtr<ID3D12Resource> vertexUploadResource =
-		DX12Context::GetInstance()->CreateBufferResource(
-			sizeVB); // UploadHeapリソース生成はここで利用
-
-	// 3. 中間リソースに頂点データを Map & Copy
-	VertexData* mappedVertexData = nullptr;
-	vertexUploadResource->Map(0, nullptr,
-		reinterpret_cast<void**>(&mappedVertexData));
-	memcpy(mappedVertexData, vertices, sizeVB);
-	vertexUploadResource->Unmap(0, nullptr); // アンマップ
-
-	// 4. コマンドリストにコピーを積む
-	DX12Context::GetInstance()->GetCommandList()->CopyResource(
-		vertexResource_.Get(), vertexUploadResource.Get());
-
-	// 5. 状態遷移コマンドを積む
-	D3D12_RESOURCE_BARRIER vertexBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		vertexResource_.Get(), D3D12_RESOURCE_STATE_COPY_DEST,
-		D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
-
-	DX12Context::GetInstance()->GetCommandList()->ResourceBarrier(1,
-		&vertexBarrier);
-
-	// 最後に、このリソースをリストに移動して保持する
-	intermediateResources_.push_back(vertexUploadResource);
+	// 頂点リソースの生成 (書き換えないので VRAM に置き、転送用のリングバッファ経由で転送する)
+	vertexResource_ = DX12Context::GetInstance()->CreateStaticBufferResource(
+		vertices, sizeVB, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
 
 	// 頂点バッファビュー (VBV) 作成
 	vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
 	vertexBufferView_.StrideInBytes = sizeof(VertexData);
 	vertexBufferView_.SizeInBytes = sizeVB;
 
-	// リソースの生成
-
-	// 1. Default Heap にリソースを生成 (テクスチャと同じ構造)
-	D3D12_RESOURCE_DESC indexResourceDesc{};
-	indexResourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-	indexResourceDesc.Width = kIndexSize;
-	indexResourceDesc.Height = 1;
-	indexResourceDesc.DepthOrArraySize = 1;
-	indexResourceDesc.MipLevels = 1;
-	// ... (その他、バッファに必要な設定)
-	indexResourceDesc.SampleDesc.Count = 1;
-	indexResourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-
-	const D3D12_HEAP_PROPERTIES defaultIndexHeapProps =
-		CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
-
-	hr = DX12Context::GetInstance()->GetDevice()->CreateCommittedResource(
-		&defaultIndexHeapProps, // Default Heap!
-		D3D12_HEAP_FLAG_NONE, &indexResourceDesc, D3D12_RESOURCE_STATE_COMMON,
-		nullptr, IID_PPV_ARGS(&indexResource_));
-	assert(SUCCEEDED(hr));
-
-	// 2. 中間アップロードリソースを生成
-	ComPtr<ID3D12Resource> indexUploadResource =
-		DX12Context::GetInstance()->CreateBufferResource(
-			kIndexSize); // UploadHeapリソース生成はここで利用
-
-	// 3. 中間リソースに頂点データを Map & Copy
-	uint16_t* mappedIndexData = nullptr;
-	HRESULT hrMap = indexUploadResource->Map(
-		0, nullptr, reinterpret_cast<void**>(&mappedIndexData));
-	assert(SUCCEEDED(hrMap));
-
-	memcpy(mappedIndexData, indices, kIndexSize);
-	indexUploadResource->Unmap(0, nullptr); // アンマップ
-
-	// 4. コマンドリストにコピーを積む
-	DX12Context::GetInstance()->GetCommandList()->CopyResource(
-		indexResource_.Get(), indexUploadResource.Get());
-
-	// 5. 状態遷移コマンドを積む (COPY_DEST → VERTEX_AND_CONSTANT_BUFFER)
-	D3D12_RESOURCE_BARRIER indexBarrier = CD3DX12_RESOURCE_BARRIER::Transition(
-		indexResource_.Get(), //
-		D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_INDEX_BUFFER);
-
-	DX12Context::GetInstance()->GetCommandList()->ResourceBarrier(1,
-		&indexBarrier);
-
-	// 最後に、このリソースをリストに移動して保持する
-	intermediateResources_.push_back(indexUploadResource);
+	// インデックスリソースの生成
+	indexResource_ = DX12Context::GetInstance()->CreateStaticBufferResource(
+		indices, kIndexSize, D3D12_RESOURCE_STATE_INDEX_BUFFER);
 
 	// --- IBV (Index Buffer View) の設定 ---
 	indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
@@ -275,16 +199,20 @@ void ParticleManager::CreateParticleGroup(const std::string& name,
 	const std::string& textureFilePath, Model* model) {
 	// 登録済みの名前かチェックしてassert
 	assert(particleGroups_.find(name) == particleGroups_.end());
+	// パーティクルのPSOは非圧縮の頂点レイアウトのみ対応
+	assert(!model || model->GetVertexFormat() == kVertexFormatFull);
 
 	// 新たな空のパーティクルグループを作成し、コンテナに登録
 	ParticleGroup newGroup;
+	newGroup.name = name;
+	newGroup.id = static_cast<uint32_t>(groupsById_.size());
 	newGroup.defaultModel = model;
 	newGroup.model = model;
 	newGroup.materialData.textureFilePath = textureFilePath;
 
 	// マテリアルデータにテクスチャのSRVインデックスを記録
 	newGroup.materialData.textureFilePath = textureFilePath;
-	TextureManager::GetInstance()->LoadTexture(
+	newGroup.materialData.textureIndex = TextureManager::GetInstance()->RequestTexture(
 		newGroup.materialData.textureFilePath);
 
 	// 新しいパーティクルグループのインスタンシング用リソースの生成とSRVの確保/生成
@@ -343,9 +271,11 @@ void ParticleManager::CreateParticleGroup(const std::string& name,
 	newGroup.materialMappedData->fadeRange = 0.0f;
 	newGroup.materialMappedData->isUvSwap = 0;
 	newGroup.materialMappedData->isRing = 0;
+	newGroup.materialMappedData->isTrail = 0;
 
 	// グループをマップに追加
-	particleGroups_.emplace(name, std::move(newGroup));
+	auto [it, inserted] = particleGroups_.emplace(name, std::move(newGroup));
+	groupsById_.push_back(&it->second);
 }
 
 void ParticleManager::Emit(const std::string& name, const Vector3& translate,
@@ -357,13 +287,42 @@ void ParticleManager::Emit(const std::string& name, const Vector3& translate,
 		return;
 	}
 
-	ParticleGroup& group = it->second;
+	EmitToGroup(it->second, translate, count);
+}
+
+// ParticleEmitter からの発生 (ParticleEmitter.cpp を ParticleManager に依存させないため、ここで定義する)
+void ParticleEmitter::Emit(const std::string& groupName) {
+	// エミッタの設定値に従って、ParticleManager::GetInstance()->Emit を呼び出す
+	ParticleManager::GetInstance()->Emit(
+		groupName,
+		this->transform.translate, // エミッタの現在位置
+		this->count                // 設定された個数
+	);
+}
+
+void ParticleManager::EmitToGroup(ParticleGroup& group, const Vector3& translate, uint32_t count) {
+	const TrailShape* trailShape = group.emitter.GetTrailShape();
+
+	// エフェクトモードのグループは再生状態にしておかないと、空になった時点で停止扱いになる
+	// (シーン側やサブエミッターから発生させるたびに isPlaying を立てる必要をなくす)
+	if (group.emitter.isEffectMode && count > 0) {
+		group.emitter.isPlaying = true;
+	}
 
 	// 指定された個数だけパーティクルを生成
 	for (uint32_t i = 0; i < count; ++i) {
+		// 発生時のサブエミッター
+		PushSubEmitterEvents(group, SubEmitterTrigger::Birth, translate);
+
 		// MakeNewParticle で設定に基づいたランダムな初期値を持つパーティクルを生成
 		Particle newParticle = MakeNewParticle(translate, group.emitter.generateSettings);
 
+		// トレイルは履歴をプールから借り、発生位置を履歴の始点にする
+		if (trailShape && group.trailPool.GetActiveCount() < kNumMaxTrailParticle) {
+			newParticle.trailIndex = group.trailPool.Allocate();
+			ParticleTrail::PushPoint(group.trailPool.Get(newParticle.trailIndex), translate, trailShape->settings);
+		}
+
 		// グループ内のパーティクルリストに追加
 		group.particles.push_back(std::move(newParticle));
 	}
@@ -371,114 +330,16 @@ void ParticleManager::Emit(const std::string& name, const Vector3& translate,
 
 // パーティクル生成関数
 Particle ParticleManager::MakeNewParticle(const Vector3& translate, const ParticleGenerateSettings& settings) {
-
-	// 乱数分布の定義 (エンジンは引数の randomEngine を使用)
-	std::uniform_real_distribution<float> distScaleX(settings.scaleMin.x, settings.scaleMax.x);
-	std::uniform_real_distribution<float> distScaleY(settings.scaleMin.y, settings.scaleMax.y);
-	std::uniform_real_distribution<float> distScaleZ(settings.scaleMin.z, settings.scaleMax.z);
-
-	std::uniform_real_distribution<float> distRotateX(settings.rotateMin.x, settings.rotateMax.x);
-	std::uniform_real_distribution<float> distRotateY(settings.rotateMin.y, settings.rotateMax.y);
-	std::uniform_real_distribution<float> distRotateZ(settings.rotateMin.z, settings.rotateMax.z);
-
-	std::uniform_real_distribution<float> distVelocityX(settings.velocityMin.x, settings.velocityMax.x);
-	std::uniform_real_distribution<float> distVelocityY(settings.velocityMin.y, settings.velocityMax.y);
-	std::uniform_real_distribution<float> distVelocityZ(settings.velocityMin.z, settings.velocityMax.z);
-
-	std::uniform_real_distribution<float> distLifeTime(settings.lifeTimeMin, settings.lifeTimeMax);
-
-	std::uniform_real_distribution<float> distColorR(settings.colorMin.x, settings.colorMax.x);
-	std::uniform_real_distribution<float> distColorG(settings.colorMin.y, settings.colorMax.y);
-	std::uniform_real_distribution<float> distColorB(settings.colorMin.z, settings.colorMax.z);
-	std::uniform_real_distribution<float> distColorA(settings.colorMin.w, settings.colorMax.w);
-
-	// パーティクルの初期化
-	Particle particle;
-
-	// -------------------
-	// トランスフォーム
-	// -------------------
-	particle.transform.scale = settings.isRandomScale ? 
-		Vector3{ distScaleX(randomEngine_), distScaleY(randomEngine_), distScaleZ(randomEngine_) } : settings.fixedScale;
-	
-	particle.transform.rotate = settings.isRandomRotate ? 
-		Vector3{ distRotateX(randomEngine_), distRotateY(randomEngine_), distRotateZ(randomEngine_) } : settings.fixedRotate;
-
-	particle.transform.translate = translate; // オフセットなしで基準位置に発生させる
-
-	// -------------------
-	// 速度
-	// -------------------
-	particle.velocity = settings.isRandomVelocity ? 
-		Vector3{ distVelocityX(randomEngine_), distVelocityY(randomEngine_), distVelocityZ(randomEngine_) } : settings.fixedVelocity;
-
-	// -------------------
-	// 寿命と時間
-	// -------------------
-	particle.lifeTime = settings.isRandomLifeTime ? distLifeTime(randomEngine_) : settings.fixedLifeTime;
-	particle.currentTime = 0.0f;
-
-	// -------------------
-	// 色
-	// -------------------
-	particle.color = settings.isRandomColor ? 
-		Vector4{ distColorR(randomEngine_), distColorG(randomEngine_), distColorB(randomEngine_), distColorA(randomEngine_) } : settings.fixedColor;
-
-	return particle;
+	return ParticleSimulation::MakeParticle(translate, settings, randomEngine_);
 }
 
 // ---------------------------------------------------------------------------
 // Update ヘルパー: エミッターの時刻進行とパーティクル生成
 // ---------------------------------------------------------------------------
-void ParticleManager::UpdateGroupEmitter(ParticleGroup& group, const std::string& name, float deltaTime) {
-	if (group.emitter.isEffectMode) {
-		// エフェクトモードの場合（独立した別枠の「パーティクル生成システム」）
-		bool hasActiveParticles = !group.particles.empty();
-
-		if (!hasActiveParticles) {
-			// パーティクルがない（消滅した＝アニメーション完了）
-			if (group.emitter.isPlaying) {
-				// 再生中だったものが消滅した場合
-				group.emitter.isPlaying = false;
-
-				if (group.emitter.isLoop) {
-					// ループが有効なら、UV設定をリセットして最初から再再生
-					auto& uvas = group.emitter.uvAnimationSettings;
-					uvas.currentTranslate = { 0.0f, 0.0f };
-					uvas.currentRotate = 0.0f;
-					uvas.currentScale = { 1.0f, 1.0f };
-
-					// 再度発生
-					Emit(name, group.emitter.transform.translate, group.emitter.count);
-					group.emitter.isPlaying = true;
-				}
-			} else {
-				// 再生中でない（初期状態、または一度再生が終わってループ無効）
-				// isEmit がオンになった瞬間に最初の1回を再生開始する
-				if (group.emitter.isEmit) {
-					auto& uvas = group.emitter.uvAnimationSettings;
-					uvas.currentTranslate = { 0.0f, 0.0f };
-					uvas.currentRotate = 0.0f;
-					uvas.currentScale = { 1.0f, 1.0f };
-
-					Emit(name, group.emitter.transform.translate, group.emitter.count);
-					group.emitter.isPlaying = true;
-				}
-			}
-		}
-	} else {
-		// 既存の frequency に基づく自動連続生成処理
-		if (group.emitter.isEmit) {
-			group.emitter.frequencyTime += deltaTime;
-			if (group.emitter.frequency > 0.0f &&
-				group.emitter.frequency <= group.emitter.frequencyTime) {
-				Emit(name, group.emitter.transform.translate, group.emitter.count);
-				group.emitter.frequencyTime -= group.emitter.frequency;
-			}
-		} else {
-			// 自動発生が無効な場合は時刻をリセットし、再び有効になったときに一気に発生するのを防ぐ
-			group.emitter.frequencyTime = 0.0f;
-		}
+void ParticleManager::UpdateGroupEmitter(ParticleGroup& group, float deltaTime) {
+	// 発生タイミングの判定 (エフェクトモードの再生状態の管理を含む)
+	if (ParticleSimulation::UpdateEmitter(group.emitter, !group.particles.empty(), deltaTime)) {
+		EmitToGroup(group, group.emitter.transform.translate, group.emitter.count);
 	}
 }
 
@@ -489,32 +350,18 @@ void ParticleManager::UpdateGroupMaterial(ParticleGroup& group, float deltaTime)
 	if (!group.materialMappedData) return;
 
 	// --- グローバル UV アニメーション ---
-	auto& uvas = group.emitter.uvAnimationSettings;
-	if (uvas.isActive && !uvas.isIndividual) {
-		uvas.currentTranslate.x += uvas.scrollSpeed.x * deltaTime;
-		uvas.currentTranslate.y += uvas.scrollSpeed.y * deltaTime;
-		uvas.currentRotate      += uvas.rotateSpeed   * deltaTime;
-		uvas.currentScale.x     += uvas.scaleSpeed.x  * deltaTime;
-		uvas.currentScale.y     += uvas.scaleSpeed.y  * deltaTime;
-
-		group.materialMappedData->uvTransform = MakeAffineMatrix(
-			Vector3{ uvas.currentScale.x, uvas.currentScale.y, 1.0f },
-			Vector3{ 0.0f, 0.0f, uvas.currentRotate },
-			Vector3{ uvas.currentTranslate.x, uvas.currentTranslate.y, 0.0f });
-	} else {
-		group.materialMappedData->uvTransform = MakeIdentity4x4();
-	}
+	// (インスタンスデータのパックでも使うので、Upload Heap から読み戻さずに済むよう CPU 側にも保持する)
+	group.uvTransform = ParticleSimulation::UpdateGlobalUVAnimation(group.emitter.uvAnimationSettings, deltaTime);
+	group.materialMappedData->uvTransform = group.uvTransform;
 
 	// 形状に応じたマテリアル設定（isRing / isCylinder フラグ等）を委譲
+	group.shapeMesh = nullptr;
 	if (group.emitter.shape) {
 		group.emitter.shape->ApplyMaterial(group.materialMappedData);
 
-		// 必要ならモデルを内部で再構築し、キャッシュされたモデルポインタを取得
-		// (テクスチャパスが変わっていなければ再構築は走らず、前回作成したモデルが返る)
-		Model* shapeModel = group.emitter.shape->GetOrBuildModel(group.materialData.textureFilePath);
-
-		// シェイプ固有のモデルがあればそれを使い、なければデフォルトのモデル（Billboard等）を使う
-		group.model = shapeModel ? shapeModel : group.defaultModel;
+		// 必要ならメッシュを再構築し、描画に使うメッシュを取得
+		// (設定が変わっていなければ前回のメッシュが返る。再構築中も完成までは前回のメッシュが返る)
+		group.shapeMesh = group.emitter.shape->GetOrBuildMesh();
 	}
 
 	// --- 共通マテリアル処理（色やUVトランスフォーム以外の共通項目） ---
@@ -524,43 +371,6 @@ void ParticleManager::UpdateGroupMaterial(ParticleGroup& group, float deltaTime)
 // Update ヘルパー: 単一パーティクルの物理・UV 更新
 // 戻り値: true = まだ生存、false = 寿命切れ（呼び出し側が erase する）
 // ---------------------------------------------------------------------------
-bool ParticleManager::UpdateParticle(Particle& particle, const ParticleGroup& group, float deltaTime) {
-	if (isUpdate_) {
-		const auto& fs = group.emitter.fieldSettings;
-
-		// 加速フィールド
-		if (fs.isAccelerationFieldActive &&
-			IsCollision(fs.accelerationField.area, particle.transform.translate)) {
-			particle.velocity += fs.accelerationField.acceleration * deltaTime;
-		}
-		// 重力フィールド
-		if (fs.isGravityFieldActive) {
-			particle.velocity += fs.gravity * deltaTime;
-		}
-	}
-
-	// 移動
-	particle.transform.translate += particle.velocity * deltaTime;
-
-	// 個別 UV アニメーション
-	if (isUpdate_ &&
-		group.emitter.uvAnimationSettings.isActive &&
-		group.emitter.uvAnimationSettings.isIndividual) {
-		const auto& uvas = group.emitter.uvAnimationSettings;
-		particle.uvTranslate.x += uvas.scrollSpeed.x * deltaTime;
-		particle.uvTranslate.y += uvas.scrollSpeed.y * deltaTime;
-		particle.uvRotate      += uvas.rotateSpeed   * deltaTime;
-		particle.uvScale.x     += uvas.scaleSpeed.x  * deltaTime;
-		particle.uvScale.y     += uvas.scaleSpeed.y  * deltaTime;
-	}
-
-	// 時間経過
-	particle.currentTime += deltaTime;
-
-	// 寿命チェック
-	return particle.currentTime < particle.lifeTime;
-}
-
 // ---------------------------------------------------------------------------
 // Update ヘルパー: インスタンシングバッファへの書き込み
 // ---------------------------------------------------------------------------
@@ -570,62 +380,93 @@ void ParticleManager::WriteInstanceData(
 	const Matrix4x4& viewProjectionMatrix,
 	uint32_t& instanceIndex)
 {
-	auto* instanceData = static_cast<ParticleInstanceData*>(group.mappedData);
+	// トレイルは帯メッシュを動的バッファに書き込み、1インスタンスで描画する
+	if (group.emitter.GetShapeType() == ParticleShapeType::Trail) {
+		WriteTrailData(group, camera, viewProjectionMatrix, instanceIndex);
+		return;
+	}
+	group.trailIndexCount = 0;
+
+	// ビルボードは全パーティクル共通なので、ループの外で1回だけ求める
+	ParticleSimulation::InstancePackContext context;
+	context.viewProjection = viewProjectionMatrix;
+	context.globalUvTransform = group.uvTransform;
+	if (group.emitter.shape && group.emitter.shape->NeedsBillboard() && useBillboard_) {
+		context.billboard = camera.GetWorldMatrix();
+		context.billboard.m[3][0] = context.billboard.m[3][1] = context.billboard.m[3][2] = 0.0f;
+	} else {
+		context.billboard = MakeIdentity4x4();
+	}
 
-	auto it = group.particles.begin();
-	while (it != group.particles.end()) {
-		Particle& particle = *it;
+	instanceIndex += ParticleSimulation::PackInstances(
+		group.particles, group.emitter, context,
+		static_cast<ParticleInstanceData*>(group.mappedData) + instanceIndex,
+		kNumMaxParticle - std::min(instanceIndex, kNumMaxParticle));
+}
 
-		// 更新して寿命切れなら削除
-		if (!UpdateParticle(particle, group, 0.0f)) {
-			// ※ 時間はすでに Update 本体で進めているため 0 を渡すのは NG。
-			// この関数ではインスタンスデータ書き込みのみ担う（時間更新済み）
-		}
+// ---------------------------------------------------------------------------
+// トレイル用の動的頂点/インデックスバッファの生成
+// ---------------------------------------------------------------------------
+void ParticleManager::CreateTrailResource(ParticleGroup& group) {
+	// 毎フレームCPUから書き換えるので Upload Heap に置いて Map したままにする
+	// (PostDraw で毎フレームGPUの完了を待っているため、前フレームの読み取りと競合しない)
+	const UINT sizeVB = sizeof(TrailVertexData) * kNumMaxTrailVertex;
+	group.trailVertexResource = DX12Context::GetInstance()->CreateBufferResource(sizeVB);
+	HRESULT hr = group.trailVertexResource->Map(
+		0, nullptr, reinterpret_cast<void**>(&group.trailVertexData));
+	assert(SUCCEEDED(hr));
 
-		float alpha = 1.0f - (particle.currentTime / particle.lifeTime);
+	group.trailVertexBufferView.BufferLocation = group.trailVertexResource->GetGPUVirtualAddress();
+	group.trailVertexBufferView.SizeInBytes = sizeVB;
+	group.trailVertexBufferView.StrideInBytes = sizeof(TrailVertexData);
 
-		if (instanceIndex < kNumMaxParticle) {
-			// ワールド行列の計算
-			Matrix4x4 scaleM  = MakeScaleMatrix(particle.transform.scale);
-			Matrix4x4 rotateM = MakeRotateXYZMatrix(particle.transform.rotate);
+	const UINT sizeIB = sizeof(uint32_t) * kNumMaxTrailIndex;
+	group.trailIndexResource = DX12Context::GetInstance()->CreateBufferResource(sizeIB);
+	hr = group.trailIndexResource->Map(
+		0, nullptr, reinterpret_cast<void**>(&group.trailIndexData));
+	assert(SUCCEEDED(hr));
 
-			Matrix4x4 billboardM;
-			if (group.emitter.shape && group.emitter.shape->NeedsBillboard() && useBillboard_) {
-				billboardM = camera.GetWorldMatrix();
-				billboardM.m[3][0] = billboardM.m[3][1] = billboardM.m[3][2] = 0.0f;
-			} else {
-				billboardM = MakeIdentity4x4();
-			}
+	group.trailIndexBufferView.BufferLocation = group.trailIndexResource->GetGPUVirtualAddress();
+	group.trailIndexBufferView.SizeInBytes = sizeIB;
+	group.trailIndexBufferView.Format = DXGI_FORMAT_R32_UINT;
+}
 
-			Matrix4x4 worldM = Multiply(scaleM, Multiply(rotateM, billboardM));
-			worldM.m[3][0] = particle.transform.translate.x;
-			worldM.m[3][1] = particle.transform.translate.y;
-			worldM.m[3][2] = particle.transform.translate.z;
-
-			// UV 変換行列
-			Matrix4x4 uvM;
-			const auto& uvas = group.emitter.uvAnimationSettings;
-			if (uvas.isActive) {
-				if (uvas.isIndividual) {
-					uvM = MakeAffineMatrix(
-						Vector3{ particle.uvScale.x, particle.uvScale.y, 1.0f },
-						Vector3{ 0.0f, 0.0f, particle.uvRotate },
-						Vector3{ particle.uvTranslate.x, particle.uvTranslate.y, 0.0f });
-				} else {
-					uvM = group.materialMappedData->uvTransform;
-				}
-			} else {
-				uvM = MakeIdentity4x4();
-			}
+// ---------------------------------------------------------------------------
+// Update ヘルパー: トレイルの帯メッシュ書き込み
+// ---------------------------------------------------------------------------
+void ParticleManager::WriteTrailData(
+	ParticleGroup& group,
+	const Camera& camera,
+	const Matrix4x4& viewProjectionMatrix,
+	uint32_t& instanceIndex)
+{
+	group.trailIndexCount = 0;
 
-			instanceData[instanceIndex].WVP         = Multiply(worldM, viewProjectionMatrix);
-			instanceData[instanceIndex].World        = worldM;
-			instanceData[instanceIndex].color        = particle.color;
-			instanceData[instanceIndex].color.w      = alpha;
-			instanceData[instanceIndex].uvTransform  = uvM;
-			++instanceIndex;
-		}
-		++it;
+	const TrailShape* trailShape = group.emitter.GetTrailShape();
+	if (!trailShape) return;
+
+	if (!group.trailVertexResource) {
+		CreateTrailResource(group);
+	}
+
+	// 頂点はワールド座標で書き込み、色も頂点に持たせるので、インスタンスはビュー射影のみを持つ
+	auto* instanceData = static_cast<ParticleInstanceData*>(group.mappedData);
+	instanceData[0].WVP = viewProjectionMatrix;
+	instanceData[0].World = MakeIdentity4x4();
+	instanceData[0].color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	instanceData[0].uvTransform = MakeIdentity4x4();
+
+	const Matrix4x4& cameraWorld = camera.GetWorldMatrix();
+	const Vector3 cameraPosition = { cameraWorld.m[3][0], cameraWorld.m[3][1], cameraWorld.m[3][2] };
+
+	// 全パーティクルの帯を1回の走査で書き込む (頂点色はパーティクルごとの寿命のフェード/colorOverLife を反映)
+	group.trailIndexCount = ParticleSimulation::PackTrails(
+		group.particles, group.trailPool, group.emitter, cameraPosition,
+		group.trailVertexData, kNumMaxTrailVertex,
+		group.trailIndexData, kNumMaxTrailIndex);
+
+	if (group.trailIndexCount > 0) {
+		instanceIndex = 1;
 	}
 }
 
@@ -633,6 +474,12 @@ void ParticleManager::WriteInstanceData(
 // Update 本体 (スリム化済み)
 // ---------------------------------------------------------------------------
 void ParticleManager::Update(const Camera& camera, float deltaTime) {
+	// ワーカースレッドで完成した形状メッシュを回収する
+	ShapeMeshCache::GetInstance()->Update();
+
+	// 前フレームに積まれたサブエミッターのイベントを処理する
+	ProcessParticleEvents();
+
 	// ビュープロジェクション行列の算出
 	const Matrix4x4 viewProjectionMatrix =
 		Multiply(camera.GetViewMatrix(), camera.GetProjectionMatrix());
@@ -641,7 +488,7 @@ void ParticleManager::Update(const Camera& camera, float deltaTime) {
 		ParticleGroup& group = pair.second;
 
 		// 1. エミッター更新 (時刻管理／生成制御)
-		UpdateGroupEmitter(group, pair.first, deltaTime);
+		UpdateGroupEmitter(group, deltaTime);
 
 		// 2. マテリアル・UV・リング更新
 		UpdateGroupMaterial(group, deltaTime);
@@ -650,7 +497,12 @@ void ParticleManager::Update(const Camera& camera, float deltaTime) {
 		auto it = group.particles.begin();
 		while (it != group.particles.end()) {
 			Particle& particle = *it;
-			if (!UpdateParticle(particle, group, deltaTime)) {
+			if (!ParticleSimulation::UpdateParticle(particle, group.emitter, deltaTime, isUpdate_, &group.trailPool)) {
+				// 消滅時のサブエミッター (発生は次フレームの先頭でまとめて行う)
+				PushSubEmitterEvents(group, SubEmitterTrigger::Death, particle.transform.translate);
+				if (particle.trailIndex != kInvalidTrailIndex) {
+					group.trailPool.Free(particle.trailIndex);
+				}
 				it = group.particles.erase(it);
 				continue;
 			}
@@ -664,6 +516,42 @@ void ParticleManager::Update(const Camera& camera, float deltaTime) {
 	}
 }
 
+void ParticleManager::PushSubEmitterEvents(ParticleGroup& group, SubEmitterTrigger trigger, const Vector3& position) {
+	ParticleSimulation::PushSubEmitterEvents(
+		group.emitter, group.id, trigger, position, group.eventSequence, eventBuffers_[eventWriteIndex_]);
+}
+
+void ParticleManager::ProcessParticleEvents() {
+	// 処理中に発生したイベント (サブエミッターの連鎖) は次フレームに回すため、先にバッファを入れ替える
+	ParticleEventBuffer& events = eventBuffers_[eventWriteIndex_];
+	eventWriteIndex_ ^= 1;
+	// 通し番号はバッファごとに一意であればよいので、入れ替えたら0から振り直す
+	for (ParticleGroup* group : groupsById_) {
+		group->eventSequence = 0;
+	}
+
+	if (events.GetDroppedCount() > 0) {
+		Logger::Log("Warning: Sub emitter events dropped: " + std::to_string(events.GetDroppedCount()) + "\n");
+	}
+
+	// 書き込み順はスレッドに依存するので、並び替えてから発生させる
+	events.Sort();
+	for (const ParticleEvent& event : events.GetEvents()) {
+		const ParticleGroup* source = groupsById_[event.sourceGroupId];
+		if (event.subEmitterIndex >= source->emitter.subEmitters.size()) {
+			continue; // イベント発生後にサブエミッターが削除された
+		}
+		const SubEmitterSettings& subEmitter = source->emitter.subEmitters[event.subEmitterIndex];
+
+		auto it = particleGroups_.find(subEmitter.groupName);
+		if (it == particleGroups_.end()) {
+			continue;
+		}
+		EmitToGroup(it->second, event.position, subEmitter.count);
+	}
+	events.Clear();
+}
+
 void ParticleManager::Draw(BlendMode::BlendState blendMode) {
 	// 1. コマンド: ルートシグネチャを設定
 	DX12Context::GetInstance()->GetCommandList()->SetGraphicsRootSignature(
@@ -681,6 +569,7 @@ void ParticleManager::Draw(BlendMode::BlendState blendMode) {
 
 	// 5. 全てのパーティクルグループについて処理
 	// 1グループ分で1DrawCallなので、こちらは二重for文にはならない。
+	bool isTrailPso = false;
 	for (auto& pair : particleGroups_) {
 		ParticleGroup& group = pair.second;
 
@@ -689,9 +578,31 @@ void ParticleManager::Draw(BlendMode::BlendState blendMode) {
 			continue;
 		}
 
+		// トレイルは頂点レイアウトが異なるので、トレイル用のPSOに切り替える (切り替わるときだけ設定)
+		const bool isTrail = group.trailIndexCount > 0;
+		if (isTrail != isTrailPso) {
+			DX12Context::GetInstance()->GetCommandList()->SetPipelineState(
+				isTrail ? trailPsoArray_[blendMode].Get() : particlePsoArray_[blendMode].Get());
+			isTrailPso = isTrail;
+		}
+
 		// メッシュの設定
-		if (group.model) {
-			// モデル固有のメッシュを使用 (Ringなど)
+		if (group.trailIndexCount > 0) {
+			// トレイルの動的バッファを使用
+			DX12Context::GetInstance()->GetCommandList()->IASetVertexBuffers(
+				0, 1, &group.trailVertexBufferView);
+			DX12Context::GetInstance()->GetCommandList()->IASetIndexBuffer(
+				&group.trailIndexBufferView);
+		}
+		else if (group.shapeMesh) {
+			// シェイプ固有のメッシュを使用 (Ringなど)
+			DX12Context::GetInstance()->GetCommandList()->IASetVertexBuffers(
+				0, 1, &group.shapeMesh->vertexBufferView);
+			DX12Context::GetInstance()->GetCommandList()->IASetIndexBuffer(
+				&group.shapeMesh->indexBufferView);
+		}
+		else if (group.model) {
+			// 外部から渡されたモデルのメッシュを使用
 			DX12Context::GetInstance()->GetCommandList()->IASetVertexBuffers(
 				0, 1, &group.model->GetVertexBufferView());
 			DX12Context::GetInstance()->GetCommandList()->IASetIndexBuffer(
@@ -733,7 +644,9 @@ void ParticleManager::Draw(BlendMode::BlendState blendMode) {
 		// コマンド：DrawCall (インスタンシング描画)
 		// インスタンス数: group.instanceCount
 		if (group.instanceCount > 0) {
-			uint32_t indexCount = group.model ? group.model->GetIndexCount() : numIndices_;
+			uint32_t indexCount = group.trailIndexCount > 0 ? group.trailIndexCount
+				: group.shapeMesh ? group.shapeMesh->indexCount
+				: group.model ? group.model->GetIndexCount() : numIndices_;
 			DX12Context::GetInstance()->GetCommandList()->DrawIndexedInstanced(
 				indexCount,
 				group.instanceCount, 0, 0, 0);
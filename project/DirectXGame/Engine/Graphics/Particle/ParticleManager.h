@@ -4,11 +4,14 @@
 #include "Types/ModelTypes.h"
 #include "Types/ParticleTypes.h"
 #include "ParticleEmitter.h"
+#include "ParticleEventBuffer.h"
+#include "ParticleTrail.h"
 
 #include <d3d12.h>
 #include <random>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <wrl/client.h>
 
 class Camera;
@@ -34,15 +37,19 @@ private: // namespace省略のためのusing宣言
 private: // メンバ変数
     struct ParticleGroup {
         std::string name;
+        uint32_t id = 0;                         // グループID (サブエミッターのイベントで使用)
+        uint32_t eventSequence = 0;              // 書き込み中のイベントバッファに積んだ発生/消滅の通し番号
         std::list<Particle> particles;           // パーティクルのリスト
         ParticleEmitter emitter;
 
         // マテリアルや定数バッファ関連
         Model * model = nullptr;           // 現在描画に使用するモデルへのポインタ
         Model * defaultModel = nullptr;    // 外部から渡されたデフォルトモデル (null = 矩形/Billboard)
+        const ShapeMesh* shapeMesh = nullptr; // シェイプ固有のメッシュ (Ringなど。null = model を使用)
         MaterialData materialData;               // マテリアルデータ
         ComPtr<ID3D12Resource> materialResource; // CBV用リソース
         Material* materialMappedData = nullptr;  // マッピングされたポインタ
+        Matrix4x4 uvTransform{};                 // グループ共通のUV変換行列 (materialMappedData と同じ値)
         D3D12_GPU_DESCRIPTOR_HANDLE
             instanceSrvHandleGPU; // インスタンシングデータ用SRVインデックス
         ComPtr<ID3D12Resource>
@@ -50,8 +57,26 @@ private: // メンバ変数
         uint32_t instanceCount; // インスタンス数
         ParticleInstanceData* mappedData =
             nullptr; // インスタンシングデータを書き込むためのポインタ
+
+        // トレイルの位置履歴 (トレイル形状のパーティクルだけが借りる)
+        TrailHistoryPool trailPool;
+
+        // トレイル描画用の動的バッファ (Trail形状を初めて使うときに生成)
+        ComPtr<ID3D12Resource> trailVertexResource;
+        ComPtr<ID3D12Resource> trailIndexResource;
+        D3D12_VERTEX_BUFFER_VIEW trailVertexBufferView{};
+        D3D12_INDEX_BUFFER_VIEW trailIndexBufferView{};
+        TrailVertexData* trailVertexData = nullptr; // 書き込み専用 (Upload Heap)
+        uint32_t* trailIndexData = nullptr;    // 書き込み専用 (Upload Heap)
+        uint32_t trailIndexCount = 0;          // 今フレームのトレイルのインデックス数
     };
     std::unordered_map<std::string, ParticleGroup> particleGroups_{};
+    // IDからグループを引くためのテーブル (unordered_map の要素のアドレスは再ハッシュでも変わらない)
+    std::vector<ParticleGroup*> groupsById_{};
+
+    // サブエミッターのイベントバッファ (書き込み用と処理用を毎フレーム入れ替える)
+    ParticleEventBuffer eventBuffers_[2];
+    uint32_t eventWriteIndex_ = 0;
 
     // シングルトンインスタンス
     static std::unique_ptr<ParticleManager> instance_;
@@ -60,6 +85,9 @@ private: // メンバ変数
     ComPtr<ID3D12RootSignature> particleRootSignature_{};
     ComPtr<ID3D12PipelineState>
         particlePsoArray_[BlendMode::BlendState::kCountOfBlendMode]{};
+    // トレイル用 (頂点色付きの TrailVertexData を読む)
+    ComPtr<ID3D12PipelineState>
+        trailPsoArray_[BlendMode::BlendState::kCountOfBlendMode]{};
     ComPtr<ID3D12Resource> vertexResource_{};
     D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
     VertexData* vertexData_ = nullptr;
@@ -75,11 +103,15 @@ private: // メンバ変数
     bool isUpdate_ = true;
     bool useBillboard_ = true;
 
-    // Particleの最大数
-    static const uint32_t kNumMaxParticle = 100;
+    // Particleの最大数 (1グループあたり)
+    static const uint32_t kNumMaxParticle = 4096;
 
-    // 初期化中に使用したアップロードリソースを保持するリスト
-    std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> intermediateResources_;
+    // トレイルを持てるパーティクルの最大数 (1グループあたり。超えた分は履歴を借りずに描画されない)
+    static const uint32_t kNumMaxTrailParticle = 2048;
+
+    // トレイルの最大頂点数/インデックス数 (1グループあたり)
+    static const uint32_t kNumMaxTrailVertex = kNumMaxTrailParticle * kMaxTrailPoints * 2;
+    static const uint32_t kNumMaxTrailIndex = kNumMaxTrailParticle * (kMaxTrailPoints - 1) * 6;
 
 public: // シングルトンインスタンス取得
     static ParticleManager* GetInstance();
@@ -125,9 +157,6 @@ public: // メンバ関数
     void SetGroupTexture(const std::string& name, const std::string& textureFilePath);
     std::string GetGroupTexture(const std::string& name) const;
 
-    // 解放処理
-    void ReleaseIntermediateResources();
-
     // 終了処理
     void Finalize();
 
@@ -142,8 +171,20 @@ private: // メンバ関数
     friend std::default_delete<ParticleManager>;
 
     // Update 分割ヘルパー
-    void UpdateGroupEmitter(ParticleGroup& group, const std::string& name, float deltaTime);
+    // (パーティクル単位の処理は ParticleSimulation に委譲し、ここではGPUリソースとの受け渡しのみ行う)
+    void UpdateGroupEmitter(ParticleGroup& group, float deltaTime);
     void UpdateGroupMaterial(ParticleGroup& group, float deltaTime);
-    bool UpdateParticle(Particle& particle, const ParticleGroup& group, float deltaTime);
     void WriteInstanceData(ParticleGroup& group, const Camera& camera, const Matrix4x4& viewProjectionMatrix, uint32_t& instanceIndex);
+
+    // グループにパーティクルを発生させる (発生時のサブエミッターイベントも積む)
+    void EmitToGroup(ParticleGroup& group, const Vector3& translate, uint32_t count);
+    // サブエミッターのイベントを積む (該当するサブエミッターがなければ何もしない)
+    void PushSubEmitterEvents(ParticleGroup& group, SubEmitterTrigger trigger, const Vector3& position);
+    // 前フレームに積まれたイベントをまとめて処理し、サブエミッターから発生させる
+    void ProcessParticleEvents();
+
+    // トレイル用の動的頂点/インデックスバッファを生成
+    void CreateTrailResource(ParticleGroup& group);
+    // トレイルの帯メッシュを動的バッファに書き込む
+    void WriteTrailData(ParticleGroup& group, const Camera& camera, const Matrix4x4& viewProjectionMatrix, uint32_t& instanceIndex);
 };
@@ -1,5 +1,4 @@
 #include "ParticleShape.h"
-#include "Model/Model.h"
 
 // ============================================================
 // BillboardShape の実装
@@ -12,6 +11,7 @@ void BillboardShape::ApplyMaterial(Material* mat) const {
     if (!mat) return;
     mat->isRing = 0;
     mat->isCylinder = 0;
+    mat->isTrail = 0;
 
     mat->isUvSwap = 0;
     mat->fadeRange = 0.0f;
@@ -20,22 +20,16 @@ void BillboardShape::ApplyMaterial(Material* mat) const {
 // ============================================================
 // RingShape の実装
 // ============================================================
-RingShape::RingShape() = default;
-RingShape::~RingShape() = default;
-
 std::unique_ptr<ParticleShape> RingShape::clone() const {
-    // model_ (unique_ptr) はコピーできないため、設定(settings)のみを引き継いだ新しいインスタンスを生成
-    auto copy = std::make_unique<RingShape>();
-    copy->settings = this->settings;
-    // コピー直後はモデルが未作成なのでダーティフラグを立てる
-    copy->MarkDirty();
-    return copy;
+    // メッシュは共有して問題ないので、そのままコピーする
+    return std::make_unique<RingShape>(*this);
 }
 
 void RingShape::ApplyMaterial(Material* mat) const {
     if (!mat) return;
     mat->isRing = 1;
     mat->isCylinder = 0;
+    mat->isTrail = 0;
 
     mat->isUvSwap = settings.isUvSwap ? 1 : 0;
     mat->innerColor = settings.innerColor;
@@ -45,39 +39,32 @@ void RingShape::ApplyMaterial(Material* mat) const {
     mat->fadeRange = settings.fadeRange;
 }
 
-Model* RingShape::GetOrBuildModel(const std::string& texPath) {
-    // ダーティフラグが立っている、またはテクスチャパスが変わった場合のみ再構築
-    if (isDirty_ || lastTexPath_ != texPath) {
-        if (!model_) {
-            model_ = std::make_unique<Model>();
-        }
-
-        // 既存のCreateRingの処理を呼び出す
-        model_->CreateRing(texPath, settings);
-
+const ShapeMesh* RingShape::GetOrBuildMesh() {
+    // ダーティフラグが立っている場合のみ、形状設定のハッシュを計算し直す
+    // (色などマテリアルだけの変更ではハッシュが変わらないので再構築は走らない)
+    if (isDirty_) {
+        meshKey_ = PrimitiveMesh::HashRing(settings);
         isDirty_ = false;
-        lastTexPath_ = texPath;
     }
-    return model_.get();
+    if (IsMeshUpToDate()) {
+        return mesh_.get();
+    }
+
+    return AcquireMesh(PrimitiveMesh::MakeRingBuilder(settings));
 }
 
 // ============================================================
 // CylinderShape の実装
 // ============================================================
-CylinderShape::CylinderShape() = default;
-CylinderShape::~CylinderShape() = default;
-
 std::unique_ptr<ParticleShape> CylinderShape::clone() const {
-    auto copy = std::make_unique<CylinderShape>();
-    copy->settings = this->settings;
-    copy->MarkDirty();
-    return copy;
+    return std::make_unique<CylinderShape>(*this);
 }
 
 void CylinderShape::ApplyMaterial(Material* mat) const {
     if (!mat) return;
     mat->isRing = 0;
     mat->isCylinder = 1;
+    mat->isTrail = 0;
     mat->alphaReference = settings.alphaReference;
 
     mat->isUvSwap = settings.isUvSwap ? 1 : 0;
@@ -88,38 +75,30 @@ void CylinderShape::ApplyMaterial(Material* mat) const {
     mat->fadeRange = settings.fadeRange;
 }
 
-Model* CylinderShape::GetOrBuildModel(const std::string& texPath) {
-    if (isDirty_ || lastTexPath_ != texPath) {
-        if (!model_) {
-            model_ = std::make_unique<Model>();
-        }
-
-        // 既存のCreateCylinderの処理を呼び出す
-        model_->CreateCylinder(texPath, settings);
-
+const ShapeMesh* CylinderShape::GetOrBuildMesh() {
+    if (isDirty_) {
+        meshKey_ = PrimitiveMesh::HashCylinder(settings);
         isDirty_ = false;
-        lastTexPath_ = texPath;
     }
-    return model_.get();
+    if (IsMeshUpToDate()) {
+        return mesh_.get();
+    }
+
+    return AcquireMesh(PrimitiveMesh::MakeCylinderBuilder(settings));
 }
 
 // ============================================================
 // PlaneShape の実装
 // ============================================================
-PlaneShape::PlaneShape() = default;
-PlaneShape::~PlaneShape() = default;
-
 std::unique_ptr<ParticleShape> PlaneShape::clone() const {
-    auto copy = std::make_unique<PlaneShape>();
-    copy->settings = this->settings;
-    copy->MarkDirty();
-    return copy;
+    return std::make_unique<PlaneShape>(*this);
 }
 
 void PlaneShape::ApplyMaterial(Material* mat) const {
     if (!mat) return;
     mat->isRing = 0;
     mat->isCylinder = 0;
+    mat->isTrail = 0;
 
     mat->isUvSwap = settings.isUvSwap ? 1 : 0;
     mat->innerColor = settings.color;
@@ -129,16 +108,35 @@ void PlaneShape::ApplyMaterial(Material* mat) const {
     mat->fadeRange = 0.0f;
 }
 
-Model* PlaneShape::GetOrBuildModel(const std::string& texPath) {
-    if (isDirty_ || lastTexPath_ != texPath) {
-        if (!model_) {
-            model_ = std::make_unique<Model>();
-        }
-
-        model_->CreatePlane(texPath, settings);
-
+const ShapeMesh* PlaneShape::GetOrBuildMesh() {
+    if (isDirty_) {
+        meshKey_ = PrimitiveMesh::HashPlane(settings);
         isDirty_ = false;
-        lastTexPath_ = texPath;
     }
-    return model_.get();
+    if (IsMeshUpToDate()) {
+        return mesh_.get();
+    }
+
+    return AcquireMesh(PrimitiveMesh::MakePlaneBuilder(settings));
+}
+
+// ============================================================
+// TrailShape の実装
+// ============================================================
+std::unique_ptr<ParticleShape> TrailShape::clone() const {
+    return std::make_unique<TrailShape>(*this);
+}
+
+void TrailShape::ApplyMaterial(Material* mat) const {
+    if (!mat) return;
+    mat->isRing = 0;
+    mat->isCylinder = 0;
+    mat->isTrail = 1;
+
+    mat->isUvSwap = 0;
+    mat->innerColor = settings.headColor;     // headColor -> innerColor
+    mat->outerColor = settings.tailColor;     // tailColor -> outerColor
+    mat->fadeStartAlpha = 1.0f;
+    mat->fadeEndAlpha = 1.0f;
+    mat->fadeRange = 0.0f;
 }
\ No newline at end of file
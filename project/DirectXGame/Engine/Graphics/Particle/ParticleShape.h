@@ -1,10 +1,12 @@
 #pragma once
 #include "Types/GraphicsTypes.h"
 #include "Types/ParticleTypes.h"
+#include "Model/PrimitiveMesh.h"
 #include <memory>
 #include <string>
 
-class Model;
+// GPUメッシュ (ShapeMeshCache.h)。シミュレーション側からD3D12への依存を切るため前方宣言にとどめる
+struct ShapeMesh;
 
 // 形状の種類を識別するための列挙型 (ImGui コンボボックス用)
 enum class ParticleShapeType {
@@ -12,6 +14,7 @@ enum class ParticleShapeType {
     Ring = 1,
     Cylinder = 2,
     Plane = 3,
+    Trail = 4,
 };
 
 // ============================================================
@@ -27,9 +30,9 @@ public:
     // マテリアル定数バッファへの設定転送 (純粋仮想)
     virtual void ApplyMaterial(Material* mat) const = 0;
 
-    // 使用するモデルを返す。nullptr = デフォルトの矩形(Billboard)を使用
-    // 設定が変更された場合にのみ内部で再構築する（ダーティフラグ）
-    virtual Model* GetOrBuildModel(const std::string& texPath) = 0;
+    // 使用するメッシュを返す。nullptr = デフォルトの矩形(Billboard)を使用
+    // 設定が変更された場合にのみワーカースレッドで再構築し、完成するまでは前回のメッシュを返す（ダーティフラグ）
+    virtual const ShapeMesh* GetOrBuildMesh() = 0;
 
     // このシェイプがビルボード変換を必要とするか
     virtual bool NeedsBillboard() const { return false; }
@@ -41,8 +44,17 @@ public:
     void MarkDirty() { isDirty_ = true; }
 
 protected:
+    // meshKey_ に対応するメッシュをキャッシュから取得する
+    // 初回はその場で生成し、以降は非同期で生成して完成したら差し替える (定義は ShapeMeshCache.cpp)
+    const ShapeMesh* AcquireMesh(ShapeMeshBuilder builder);
+
+    // 描画中のメッシュが最新の設定に対応しているか
+    bool IsMeshUpToDate() const { return mesh_ && currentMeshKey_ == meshKey_; }
+
     bool isDirty_ = true;
-    std::string lastTexPath_;
+    uint64_t meshKey_ = 0;                  // 最新の設定のハッシュ
+    uint64_t currentMeshKey_ = 0;           // 描画中のメッシュの設定のハッシュ
+    std::shared_ptr<const ShapeMesh> mesh_; // 描画中のメッシュ (同じ設定のシェイプ同士で共有)
 };
 
 // ============================================================
@@ -52,7 +64,7 @@ class BillboardShape : public ParticleShape {
 public:
     std::unique_ptr<ParticleShape> clone() const override;
     void ApplyMaterial(Material* mat) const override;
-    Model* GetOrBuildModel(const std::string& texPath) override { return nullptr; }
+    const ShapeMesh* GetOrBuildMesh() override { return nullptr; }
     bool NeedsBillboard() const override { return true; }
     ParticleShapeType GetType() const override { return ParticleShapeType::Billboard; }
 };
@@ -62,18 +74,12 @@ public:
 // ============================================================
 class RingShape : public ParticleShape {
 public:
-    RingShape();
-    ~RingShape() override;
-
     RingSettings settings;
 
     std::unique_ptr<ParticleShape> clone() const override;
     void ApplyMaterial(Material* mat) const override;
-    Model* GetOrBuildModel(const std::string& texPath) override;
+    const ShapeMesh* GetOrBuildMesh() override;
     ParticleShapeType GetType() const override { return ParticleShapeType::Ring; }
-
-private:
-    std::unique_ptr<Model> model_;
 };
 
 // ============================================================
@@ -81,18 +87,12 @@ private:
 // ============================================================
 class CylinderShape : public ParticleShape {
 public:
-    CylinderShape();
-    ~CylinderShape() override;
-
     CylinderSettings settings;
 
     std::unique_ptr<ParticleShape> clone() const override;
     void ApplyMaterial(Material* mat) const override;
-    Model* GetOrBuildModel(const std::string& texPath) override;
+    const ShapeMesh* GetOrBuildMesh() override;
     ParticleShapeType GetType() const override { return ParticleShapeType::Cylinder; }
-
-private:
-    std::unique_ptr<Model> model_;
 };
 
 // ============================================================
@@ -100,16 +100,24 @@ private:
 // ============================================================
 class PlaneShape : public ParticleShape {
 public:
-    PlaneShape();
-    ~PlaneShape() override;
-
     PlaneSettings settings;
 
     std::unique_ptr<ParticleShape> clone() const override;
     void ApplyMaterial(Material* mat) const override;
-    Model* GetOrBuildModel(const std::string& texPath) override;
+    const ShapeMesh* GetOrBuildMesh() override;
     ParticleShapeType GetType() const override { return ParticleShapeType::Plane; }
+};
 
-private:
-    std::unique_ptr<Model> model_;
+// ============================================================
+// TrailShape — 位置履歴から生成するリボン(トレイル)
+// メッシュは ParticleManager が毎フレーム動的頂点バッファに書き込む
+// ============================================================
+class TrailShape : public ParticleShape {
+public:
+    TrailSettings settings;
+
+    std::unique_ptr<ParticleShape> clone() const override;
+    void ApplyMaterial(Material* mat) const override;
+    const ShapeMesh* GetOrBuildMesh() override { return nullptr; }
+    ParticleShapeType GetType() const override { return ParticleShapeType::Trail; }
 };
\ No newline at end of file
@@ -0,0 +1,297 @@
+#include "ParticleSimulation.h"
+#include "MathUtils.h"
+#include "MatrixGenerators.h"
+#include "ParticleTrail.h"
+
+#include <algorithm>
+
+using namespace MathUtils;
+using namespace MathGenerators;
+
+namespace ParticleSimulation {
+
+Vector4 ComputeColor(const Particle& particle, const ParticleGenerateSettings& settings) {
+    Vector4 color = particle.color;
+    if (settings.colorOverLife.isActive) {
+        const Vector4 lifeColor = settings.colorOverLife.Sample(GetLifeRatio(particle));
+        color = {color.x * lifeColor.x, color.y * lifeColor.y, color.z * lifeColor.z, color.w * lifeColor.w};
+    } else {
+        color.w = 1.0f - GetLifeRatio(particle);
+    }
+    return color;
+}
+
+Vector3 ComputeScale(const Particle& particle, const ParticleGenerateSettings& settings) {
+    Vector3 scale = particle.transform.scale;
+    if (settings.sizeOverLife.isActive) {
+        scale *= settings.sizeOverLife.Sample(GetLifeRatio(particle));
+    }
+    return scale;
+}
+
+Particle MakeParticle(const Vector3& translate, const ParticleGenerateSettings& settings, std::mt19937& randomEngine) {
+    // 乱数分布の定義 (エンジンは引数の randomEngine を使用)
+    std::uniform_real_distribution<float> distScaleX(settings.scaleMin.x, settings.scaleMax.x);
+    std::uniform_real_distribution<float> distScaleY(settings.scaleMin.y, settings.scaleMax.y);
+    std::uniform_real_distribution<float> distScaleZ(settings.scaleMin.z, settings.scaleMax.z);
+
+    std::uniform_real_distribution<float> distRotateX(settings.rotateMin.x, settings.rotateMax.x);
+    std::uniform_real_distribution<float> distRotateY(settings.rotateMin.y, settings.rotateMax.y);
+    std::uniform_real_distribution<float> distRotateZ(settings.rotateMin.z, settings.rotateMax.z);
+
+    std::uniform_real_distribution<float> distVelocityX(settings.velocityMin.x, settings.velocityMax.x);
+    std::uniform_real_distribution<float> distVelocityY(settings.velocityMin.y, settings.velocityMax.y);
+    std::uniform_real_distribution<float> distVelocityZ(settings.velocityMin.z, settings.velocityMax.z);
+
+    std::uniform_real_distribution<float> distLifeTime(settings.lifeTimeMin, settings.lifeTimeMax);
+
+    std::uniform_real_distribution<float> distColorR(settings.colorMin.x, settings.colorMax.x);
+    std::uniform_real_distribution<float> distColorG(settings.colorMin.y, settings.colorMax.y);
+    std::uniform_real_distribution<float> distColorB(settings.colorMin.z, settings.colorMax.z);
+    std::uniform_real_distribution<float> distColorA(settings.colorMin.w, settings.colorMax.w);
+
+    // パーティクルの初期化
+    Particle particle;
+
+    // -------------------
+    // トランスフォーム
+    // -------------------
+    particle.transform.scale = settings.isRandomScale ?
+        Vector3{ distScaleX(randomEngine), distScaleY(randomEngine), distScaleZ(randomEngine) } : settings.fixedScale;
+
+    particle.transform.rotate = settings.isRandomRotate ?
+        Vector3{ distRotateX(randomEngine), distRotateY(randomEngine), distRotateZ(randomEngine) } : settings.fixedRotate;
+
+    particle.transform.translate = translate; // オフセットなしで基準位置に発生させる
+
+    // -------------------
+    // 速度
+    // -------------------
+    particle.velocity = settings.isRandomVelocity ?
+        Vector3{ distVelocityX(randomEngine), distVelocityY(randomEngine), distVelocityZ(randomEngine) } : settings.fixedVelocity;
+
+    // -------------------
+    // 寿命と時間
+    // -------------------
+    particle.lifeTime = settings.isRandomLifeTime ? distLifeTime(randomEngine) : settings.fixedLifeTime;
+    particle.currentTime = 0.0f;
+
+    // -------------------
+    // 色
+    // -------------------
+    particle.color = settings.isRandomColor ?
+        Vector4{ distColorR(randomEngine), distColorG(randomEngine), distColorB(randomEngine), distColorA(randomEngine) } : settings.fixedColor;
+
+    return particle;
+}
+
+bool UpdateEmitter(ParticleEmitter& emitter, bool hasActiveParticles, float deltaTime) {
+    if (!emitter.isEffectMode) {
+        // frequency に基づく自動連続生成
+        if (!emitter.isEmit) {
+            // 自動発生が無効な場合は時刻をリセットし、再び有効になったときに一気に発生するのを防ぐ
+            emitter.frequencyTime = 0.0f;
+            return false;
+        }
+        emitter.frequencyTime += deltaTime;
+        if (emitter.frequency > 0.0f && emitter.frequency <= emitter.frequencyTime) {
+            emitter.frequencyTime -= emitter.frequency;
+            return true;
+        }
+        return false;
+    }
+
+    // エフェクトモード (単発/ループ再生)
+    // パーティクルが残っている間は再生中のまま
+    if (hasActiveParticles) {
+        return false;
+    }
+
+    bool isRestart = false;
+    if (emitter.isPlaying) {
+        // 再生中だったものが消滅した (アニメーション完了)
+        emitter.isPlaying = false;
+        // ループが有効なら最初から再生し直す
+        isRestart = emitter.isLoop;
+    } else {
+        // 再生中でない (初期状態、または一度再生が終わってループ無効)
+        // isEmit がオンになった瞬間に最初の1回を再生開始する
+        isRestart = emitter.isEmit;
+    }
+
+    if (isRestart) {
+        auto& uvas = emitter.uvAnimationSettings;
+        uvas.currentTranslate = {0.0f, 0.0f};
+        uvas.currentRotate = 0.0f;
+        uvas.currentScale = {1.0f, 1.0f};
+        emitter.isPlaying = true;
+    }
+    return isRestart;
+}
+
+void PushSubEmitterEvents(const ParticleEmitter& emitter, uint32_t sourceGroupId, SubEmitterTrigger trigger, const Vector3& position,
+                          uint32_t& sequence, ParticleEventBuffer& events) {
+    // 発生と消滅で同じ番号を共有し、1つのバッファの中で (グループ, 番号) が重ならないようにする
+    // (並び替えのキーが一意になるので、積んだスレッドの順番によらず処理順が決まる)
+    const uint32_t eventSequence = sequence++;
+
+    const std::vector<SubEmitterSettings>& subEmitters = emitter.subEmitters;
+    for (uint32_t index = 0; index < static_cast<uint32_t>(subEmitters.size()); ++index) {
+        if (subEmitters[index].trigger != trigger) {
+            continue;
+        }
+
+        ParticleEvent event{};
+        event.position = position;
+        event.sourceGroupId = sourceGroupId;
+        event.trigger = trigger;
+        event.sequence = eventSequence;
+        event.subEmitterIndex = index;
+        events.Push(event);
+    }
+}
+
+Matrix4x4 UpdateGlobalUVAnimation(ParticleUVAnimationSettings& uvas, float deltaTime) {
+    if (!uvas.isActive || uvas.isIndividual) {
+        return MakeIdentity4x4();
+    }
+
+    uvas.currentTranslate.x += uvas.scrollSpeed.x * deltaTime;
+    uvas.currentTranslate.y += uvas.scrollSpeed.y * deltaTime;
+    uvas.currentRotate += uvas.rotateSpeed * deltaTime;
+    uvas.currentScale.x += uvas.scaleSpeed.x * deltaTime;
+    uvas.currentScale.y += uvas.scaleSpeed.y * deltaTime;
+
+    return MakeAffineMatrix(
+        Vector3{uvas.currentScale.x, uvas.currentScale.y, 1.0f},
+        Vector3{0.0f, 0.0f, uvas.currentRotate},
+        Vector3{uvas.currentTranslate.x, uvas.currentTranslate.y, 0.0f});
+}
+
+bool UpdateParticle(Particle& particle, const ParticleEmitter& emitter, float deltaTime, bool isUpdate, TrailHistoryPool* trailPool) {
+    if (isUpdate) {
+        const auto& fs = emitter.fieldSettings;
+        const auto& gs = emitter.generateSettings;
+
+        // 寿命に応じた速度の減衰
+        if (gs.dampingOverLife.isActive) {
+            float damping = gs.dampingOverLife.Sample(GetLifeRatio(particle)) * deltaTime;
+            particle.velocity *= std::max(0.0f, 1.0f - damping);
+        }
+
+        // 加速フィールド
+        if (fs.isAccelerationFieldActive &&
+            IsCollision(fs.accelerationField.area, particle.transform.translate)) {
+            particle.velocity += fs.accelerationField.acceleration * deltaTime;
+        }
+        // 重力フィールド
+        if (fs.isGravityFieldActive) {
+            particle.velocity += fs.gravity * deltaTime;
+        }
+    }
+
+    // 移動
+    particle.transform.translate += particle.velocity * deltaTime;
+
+    // トレイルの位置履歴を記録 (履歴を借りていないパーティクルは記録しない)
+    if (const TrailShape* trailShape = emitter.GetTrailShape();
+        trailShape && trailPool && particle.trailIndex != kInvalidTrailIndex) {
+        ParticleTrail::PushPoint(trailPool->Get(particle.trailIndex), particle.transform.translate, trailShape->settings);
+    }
+
+    // 個別 UV アニメーション
+    if (isUpdate &&
+        emitter.uvAnimationSettings.isActive &&
+        emitter.uvAnimationSettings.isIndividual) {
+        const auto& uvas = emitter.uvAnimationSettings;
+        particle.uvTranslate.x += uvas.scrollSpeed.x * deltaTime;
+        particle.uvTranslate.y += uvas.scrollSpeed.y * deltaTime;
+        particle.uvRotate      += uvas.rotateSpeed   * deltaTime;
+        particle.uvScale.x     += uvas.scaleSpeed.x  * deltaTime;
+        particle.uvScale.y     += uvas.scaleSpeed.y  * deltaTime;
+    }
+
+    // 時間経過
+    particle.currentTime += deltaTime;
+
+    // 寿命チェック
+    return particle.currentTime < particle.lifeTime;
+}
+
+uint32_t PackInstances(const std::list<Particle>& particles, const ParticleEmitter& emitter, const InstancePackContext& context, ParticleInstanceData* instances, uint32_t maxCount) {
+    const ParticleGenerateSettings& gs = emitter.generateSettings;
+    const ParticleUVAnimationSettings& uvas = emitter.uvAnimationSettings;
+
+    uint32_t count = 0;
+    for (const Particle& particle : particles) {
+        if (count >= maxCount) {
+            break;
+        }
+
+        // 寿命に応じたスケールと色 (LUT から求める)
+        const Vector3 scale = ComputeScale(particle, gs);
+        const Vector4 color = ComputeColor(particle, gs);
+
+        // ワールド行列の計算
+        Matrix4x4 scaleM = MakeScaleMatrix(scale);
+        Matrix4x4 rotateM = MakeRotateXYZMatrix(particle.transform.rotate);
+        Matrix4x4 worldM = Multiply(scaleM, Multiply(rotateM, context.billboard));
+        worldM.m[3][0] = particle.transform.translate.x;
+        worldM.m[3][1] = particle.transform.translate.y;
+        worldM.m[3][2] = particle.transform.translate.z;
+
+        // UV 変換行列
+        Matrix4x4 uvM;
+        if (uvas.isActive && uvas.isIndividual) {
+            uvM = MakeAffineMatrix(
+                Vector3{particle.uvScale.x, particle.uvScale.y, 1.0f},
+                Vector3{0.0f, 0.0f, particle.uvRotate},
+                Vector3{particle.uvTranslate.x, particle.uvTranslate.y, 0.0f});
+        } else {
+            uvM = context.globalUvTransform;
+        }
+
+        // 書き込み専用のメモリなので、1要素ずつ順に書き込む
+        ParticleInstanceData& instance = instances[count];
+        instance.WVP = Multiply(worldM, context.viewProjection);
+        instance.World = worldM;
+        instance.color = color;
+        instance.uvTransform = uvM;
+        ++count;
+    }
+    return count;
+}
+
+uint32_t PackTrails(const std::list<Particle>& particles, const TrailHistoryPool& trailPool, const ParticleEmitter& emitter, const Vector3& cameraPosition,
+                    TrailVertexData* vertices, uint32_t maxVertexCount, uint32_t* indices, uint32_t maxIndexCount) {
+    const TrailShape* trailShape = emitter.GetTrailShape();
+    if (!trailShape) {
+        return 0;
+    }
+
+    // 全パーティクルの帯を1回の走査で書き込む
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    for (const Particle& particle : particles) {
+        if (particle.trailIndex == kInvalidTrailIndex) {
+            continue;
+        }
+        const TrailHistory& history = trailPool.Get(particle.trailIndex);
+        const uint32_t stripVertexCount = ParticleTrail::GetVertexCount(history.count);
+        const uint32_t stripIndexCount = ParticleTrail::GetIndexCount(history.count);
+        if (stripVertexCount == 0) {
+            continue;
+        }
+        if (vertexCount + stripVertexCount > maxVertexCount || indexCount + stripIndexCount > maxIndexCount) {
+            break;
+        }
+
+        vertexCount += ParticleTrail::BuildStrip(
+            history, trailShape->settings, cameraPosition, ComputeColor(particle, emitter.generateSettings),
+            vertexCount, vertices + vertexCount, indices + indexCount);
+        indexCount += stripIndexCount;
+    }
+    return indexCount;
+}
+
+} // namespace ParticleSimulation
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+#include "Types/ParticleTypes.h"
+#include "ParticleEmitter.h"
+#include "ParticleEventBuffer.h"
+#include "ParticleTrail.h"
+
+#include <cstdint>
+#include <list>
+#include <random>
+
+// パーティクルのシミュレーション (発生・フィールド・更新・インスタンスデータのパック)
+// GPUリソースを扱わないので、D3D12デバイスなしでも単体で実行・計測できる
+// GPUリソースの管理と描画は ParticleManager が担う
+namespace ParticleSimulation {
+
+// インスタンスデータのパックに必要なフレーム共通の値
+struct InstancePackContext {
+    Matrix4x4 viewProjection;    // ビュー射影行列
+    Matrix4x4 billboard;         // ビルボード行列 (平行移動成分なし。ビルボードしない場合は単位行列)
+    Matrix4x4 globalUvTransform; // グループ共通のUV変換行列 (個別UVアニメーションでない場合に使用)
+};
+
+// 寿命に対する経過時間の割合 (0～1)
+inline float GetLifeRatio(const Particle& particle) { return particle.lifeTime > 0.0f ? particle.currentTime / particle.lifeTime : 1.0f; }
+
+// 寿命に応じた描画色 (colorOverLife が無効なら寿命に合わせてアルファをフェードする)
+Vector4 ComputeColor(const Particle& particle, const ParticleGenerateSettings& settings);
+
+// 寿命に応じた描画スケール
+Vector3 ComputeScale(const Particle& particle, const ParticleGenerateSettings& settings);
+
+/// <summary>
+/// 設定に従ってパーティクルを1つ生成する
+/// </summary>
+/// <param name="translate">発生位置</param>
+/// <param name="settings">生成時の設定</param>
+/// <param name="randomEngine">乱数エンジン (同じシードなら同じ結果になる)</param>
+Particle MakeParticle(const Vector3& translate, const ParticleGenerateSettings& settings, std::mt19937& randomEngine);
+
+/// <summary>
+/// エミッターの時刻を進め、今フレームに発生させるかを判定する
+/// エフェクトモードの再生状態 (isPlaying) やUVアニメーションのリセットもここで行う
+/// </summary>
+/// <param name="emitter">エミッター</param>
+/// <param name="hasActiveParticles">グループに生存中のパーティクルがあるか</param>
+/// <param name="deltaTime">経過時間</param>
+/// <returns>true = emitter.count 個をエミッターの位置に発生させる</returns>
+bool UpdateEmitter(ParticleEmitter& emitter, bool hasActiveParticles, float deltaTime);
+
+/// <summary>
+/// 該当するサブエミッターの起動イベントを積む (該当するサブエミッターがなければ何もしない)
+/// </summary>
+/// <param name="emitter">発生元グループのエミッター</param>
+/// <param name="sourceGroupId">発生元グループのID</param>
+/// <param name="trigger">起動タイミング</param>
+/// <param name="position">発生位置</param>
+/// <param name="sequence">発生元グループの通し番号 (呼ぶたびに1進める。バッファを入れ替えるまで戻さないこと)</param>
+/// <param name="events">書き込み先のイベントバッファ</param>
+void PushSubEmitterEvents(const ParticleEmitter& emitter, uint32_t sourceGroupId, SubEmitterTrigger trigger, const Vector3& position,
+                          uint32_t& sequence, ParticleEventBuffer& events);
+
+/// <summary>
+/// グループ共通のUVアニメーションを進め、UV変換行列を返す
+/// </summary>
+Matrix4x4 UpdateGlobalUVAnimation(ParticleUVAnimationSettings& uvas, float deltaTime);
+
+/// <summary>
+/// パーティクルを1つ更新する (フィールド・減衰・移動・トレイル履歴・個別UVアニメーション)
+/// </summary>
+/// <param name="particle">パーティクル</param>
+/// <param name="emitter">所属グループのエミッター</param>
+/// <param name="deltaTime">経過時間</param>
+/// <param name="isUpdate">false の場合はフィールドとUVアニメーションを止める</param>
+/// <param name="trailPool">トレイル履歴のプール (トレイル形状でなければ nullptr でよい)</param>
+/// <returns>false = 寿命切れ (トレイル履歴の返却は呼び出し側が行う)</returns>
+bool UpdateParticle(Particle& particle, const ParticleEmitter& emitter, float deltaTime, bool isUpdate, TrailHistoryPool* trailPool = nullptr);
+
+/// <summary>
+/// パーティクルをインスタンスデータに詰める
+/// 出力先は書き込み専用 (Upload Heap) を想定し、読み戻しは行わない
+/// </summary>
+/// <param name="particles">パーティクルのリスト</param>
+/// <param name="emitter">所属グループのエミッター</param>
+/// <param name="context">フレーム共通の値</param>
+/// <param name="instances">書き込み先</param>
+/// <param name="maxCount">書き込める最大数</param>
+/// <returns>書き込んだインスタンス数</returns>
+uint32_t PackInstances(const std::list<Particle>& particles, const ParticleEmitter& emitter, const InstancePackContext& context, ParticleInstanceData* instances, uint32_t maxCount);
+
+/// <summary>
+/// トレイルを持つパーティクルの帯メッシュを詰める (頂点色はパーティクルの描画色)
+/// 出力先は書き込み専用 (Upload Heap) を想定し、読み戻しは行わない。入りきらない分は書き込まない
+/// </summary>
+/// <param name="particles">パーティクルのリスト</param>
+/// <param name="trailPool">トレイル履歴のプール</param>
+/// <param name="emitter">所属グループのエミッター (トレイル形状であること)</param>
+/// <param name="cameraPosition">カメラのワールド座標</param>
+/// <param name="vertices">頂点の書き込み先</param>
+/// <param name="maxVertexCount">書き込める最大頂点数</param>
+/// <param name="indices">インデックスの書き込み先</param>
+/// <param name="maxIndexCount">書き込める最大インデックス数</param>
+/// <returns>書き込んだインデックス数</returns>
+uint32_t PackTrails(const std::list<Particle>& particles, const TrailHistoryPool& trailPool, const ParticleEmitter& emitter, const Vector3& cameraPosition,
+                    TrailVertexData* vertices, uint32_t maxVertexCount, uint32_t* indices, uint32_t maxIndexCount);
+
+} // namespace ParticleSimulation
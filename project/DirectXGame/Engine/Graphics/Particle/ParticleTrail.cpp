@@ -0,0 +1,125 @@
+#include "ParticleTrail.h"
+#include "MathUtils.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace MathUtils;
+
+namespace ParticleTrail {
+
+const Vector3& GetPoint(const TrailHistory& history, uint32_t index) {
+    // head は次に書き込む位置なので、その1つ前が最新
+    return history.positions[(history.head + kMaxTrailPoints - 1 - index) % kMaxTrailPoints];
+}
+
+void PushPoint(TrailHistory& history, const Vector3& position, const TrailSettings& settings) {
+    const uint32_t maxPoints = std::clamp(settings.maxPoints, 2u, kMaxTrailPoints);
+
+    if (history.count >= 2) {
+        // 直前の確定点から十分に離れていなければ、先頭の点を現在位置に追従させるだけ
+        const Vector3& committed = GetPoint(history, 1);
+        const float minDistance = settings.minVertexDistance;
+        if (LengthSq(position - committed) < minDistance * minDistance) {
+            history.positions[(history.head + kMaxTrailPoints - 1) % kMaxTrailPoints] = position;
+            return;
+        }
+    }
+
+    // 新しい点を追加 (古い点はリングバッファで上書きされる)
+    history.positions[history.head] = position;
+    history.head = (history.head + 1) % kMaxTrailPoints;
+    history.count = std::min(history.count + 1, maxPoints);
+}
+
+uint32_t BuildStrip(const TrailHistory& history, const TrailSettings& settings, const Vector3& cameraPosition, const Vector4& color, uint32_t baseVertex, TrailVertexData* vertices, uint32_t* indices) {
+    const uint32_t pointCount = history.count;
+    if (pointCount < 2) {
+        return 0;
+    }
+
+    const float invLast = 1.0f / static_cast<float>(pointCount - 1);
+    Vector3 side = {0.0f, 1.0f, 0.0f};
+
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        const Vector3& point = GetPoint(history, i);
+
+        // 接線は前後の点の差分 (端点は片側差分)
+        const Vector3& prev = GetPoint(history, i == 0 ? 0 : i - 1);
+        const Vector3& next = GetPoint(history, i + 1 < pointCount ? i + 1 : i);
+        Vector3 toCamera = cameraPosition - point;
+        Vector3 newSide = Cross(next - prev, toCamera);
+
+        // 視線と接線が平行な場合は直前の向きを使い回す
+        float sideLengthSq = LengthSq(newSide);
+        if (sideLengthSq > 1.0e-12f) {
+            side = newSide * (1.0f / std::sqrt(sideLengthSq));
+        }
+
+        // 先頭(t=0)から末尾(t=1)へ幅を補間
+        float t = static_cast<float>(i) * invLast;
+        float halfWidth = 0.5f * (settings.headWidth + (settings.tailWidth - settings.headWidth) * t);
+        Vector3 offset = side * halfWidth;
+        Vector3 left = point + offset;
+        Vector3 right = point - offset;
+
+        TrailVertexData* v = vertices + i * 2;
+        v[0].position = {left.x, left.y, left.z, 1.0f};
+        v[0].texcoord = {t, 0.0f};
+        v[0].color = color;
+        v[1].position = {right.x, right.y, right.z, 1.0f};
+        v[1].texcoord = {t, 1.0f};
+        v[1].color = color;
+
+        // 1つ前の点との間に四角形(三角形2枚)を張る
+        if (i > 0) {
+            uint32_t base = baseVertex + (i - 1) * 2;
+            uint32_t* index = indices + (i - 1) * 6;
+            index[0] = base;
+            index[1] = base + 2;
+            index[2] = base + 1;
+            index[3] = base + 1;
+            index[4] = base + 2;
+            index[5] = base + 3;
+        }
+    }
+
+    return pointCount * 2;
+}
+
+} // namespace ParticleTrail
+
+// ============================================================
+// TrailHistoryPool の実装
+// ============================================================
+uint32_t TrailHistoryPool::Allocate() {
+    uint32_t index;
+    if (!freeIndices_.empty()) {
+        index = freeIndices_.back();
+        freeIndices_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(histories_.size());
+        histories_.emplace_back();
+    }
+
+    // 位置の配列は count までしか読まないので、先頭と数だけ戻せばよい
+    TrailHistory& history = histories_[index];
+    history.head = 0;
+    history.count = 0;
+    return index;
+}
+
+void TrailHistoryPool::Free(uint32_t index) {
+    assert(index < histories_.size());
+    freeIndices_.push_back(index);
+}
+
+void TrailHistoryPool::Clear() {
+    freeIndices_.clear();
+    freeIndices_.reserve(histories_.size());
+    // 小さい番号から貸し出すよう逆順に積む
+    for (uint32_t index = static_cast<uint32_t>(histories_.size()); index > 0; --index) {
+        freeIndices_.push_back(index - 1);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+#include "Types/ParticleTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+// トレイル(リボン)パーティクルのメッシュ生成
+// D3D12に依存しないので、GPUなしでも単体で実行・検証できる
+namespace ParticleTrail {
+
+/// <summary>
+/// 履歴に位置を追加する
+/// 直前の確定点から minVertexDistance 未満しか動いていない場合は先頭の点を上書きする
+/// </summary>
+/// <param name="history">位置履歴</param>
+/// <param name="position">現在位置</param>
+/// <param name="settings">トレイル設定</param>
+void PushPoint(TrailHistory& history, const Vector3& position, const TrailSettings& settings);
+
+/// <summary>
+/// 履歴の i 番目の点を取得する (0 = 最新)
+/// </summary>
+const Vector3& GetPoint(const TrailHistory& history, uint32_t index);
+
+// 履歴点の数から必要な頂点数を求める
+inline uint32_t GetVertexCount(uint32_t pointCount) {
+    return pointCount < 2 ? 0 : pointCount * 2;
+}
+
+// 履歴点の数から必要なインデックス数を求める
+inline uint32_t GetIndexCount(uint32_t pointCount) {
+    return pointCount < 2 ? 0 : (pointCount - 1) * 6;
+}
+
+/// <summary>
+/// カメラに正対する帯状メッシュを書き込む (1回の走査で頂点とインデックスを出力)
+/// 出力先は書き込み専用 (Upload Heap) を想定し、読み戻しは行わない
+/// </summary>
+/// <param name="history">位置履歴</param>
+/// <param name="settings">トレイル設定</param>
+/// <param name="cameraPosition">カメラのワールド座標</param>
+/// <param name="color">頂点色 (持ち主のパーティクルの色)</param>
+/// <param name="baseVertex">インデックスに加算する頂点オフセット</param>
+/// <param name="vertices">頂点の書き込み先 (GetVertexCount 分の空きが必要)</param>
+/// <param name="indices">インデックスの書き込み先 (GetIndexCount 分の空きが必要)</param>
+/// <returns>書き込んだ頂点数</returns>
+uint32_t BuildStrip(const TrailHistory& history, const TrailSettings& settings, const Vector3& cameraPosition, const Vector4& color, uint32_t baseVertex, TrailVertexData* vertices, uint32_t* indices);
+
+} // namespace ParticleTrail
+
+// トレイル履歴のプール (グループごとに1つ)
+// トレイル形状のパーティクルだけが番号 (Particle::trailIndex) で履歴を借りる
+// 消滅したパーティクルの履歴は空きリストに戻して使い回す
+class TrailHistoryPool {
+public:
+    // 空の履歴を借りて番号を返す
+    uint32_t Allocate();
+    // 履歴を返却する
+    void Free(uint32_t index);
+    // すべての履歴を返却する (確保済みのメモリは残す)
+    void Clear();
+
+    TrailHistory& Get(uint32_t index) { return histories_[index]; }
+    const TrailHistory& Get(uint32_t index) const { return histories_[index]; }
+
+    // 貸し出し中の履歴の数
+    uint32_t GetActiveCount() const { return static_cast<uint32_t>(histories_.size() - freeIndices_.size()); }
+
+private:
+    std::vector<TrailHistory> histories_;
+    std::vector<uint32_t> freeIndices_;
+};
@@ -0,0 +1,240 @@
+#include "ShapeMeshCache.h"
+#include "Base/DX12Context.h"
+#include "ParticleShape.h"
+
+#include <assert.h>
+#include <chrono>
+
+std::unique_ptr<ShapeMeshCache> ShapeMeshCache::instance_ = nullptr;
+
+namespace {
+
+// future が完了しているか (待機はしない)
+template <class T>
+bool IsReady(const std::future<T>& future) {
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+} // namespace
+
+// シングルトン実装
+ShapeMeshCache* ShapeMeshCache::GetInstance() {
+    if (instance_ == nullptr) {
+        instance_ = std::make_unique<ShapeMeshCache>(Token{});
+    }
+    return instance_.get();
+}
+
+void ShapeMeshCache::Destroy() {
+    instance_.reset();
+}
+
+ShapeMeshCache::ShapeMeshCache(Token) {
+    // コンストラクタ
+}
+
+void ShapeMeshCache::Initialize() {
+    // ワーカースレッドの起動
+    isStopping_ = false;
+    worker_ = std::thread(&ShapeMeshCache::WorkerMain, this);
+}
+
+void ShapeMeshCache::Finalize() {
+    // ワーカースレッドの停止 (処理中のジョブは完了させる)
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        isStopping_ = true;
+    }
+    jobCondition_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    jobs_.clear();
+
+    // メッシュの破棄 (バッファは DX12Context の遅延解放に回る)
+    pendingBuilds_.clear();
+    cancelledBuilds_.clear();
+    meshes_.clear();
+}
+
+void ShapeMeshCache::Update() {
+    ++frame_;
+
+    // 1. 完成したメッシュをキャッシュに移す / 要求されなくなったビルドは取り消す
+    for (auto it = pendingBuilds_.begin(); it != pendingBuilds_.end();) {
+        PendingBuild& pending = it->second;
+        if (IsReady(pending.future)) {
+            std::shared_ptr<ShapeMesh> mesh = pending.future.get();
+            if (mesh) {
+                meshes_[it->first] = { std::move(mesh), frame_ };
+            }
+            it = pendingBuilds_.erase(it);
+            continue;
+        }
+
+        // スライダー操作中などで途中の設定が不要になったものは、生成前なら捨てる
+        if (frame_ - pending.lastRequestFrame > 1) {
+            pending.cancelled->store(true);
+            cancelledBuilds_.push_back(std::move(pending.future));
+            it = pendingBuilds_.erase(it);
+            continue;
+        }
+        ++it;
+    }
+
+    // 2. 取り消したビルドはワーカーの処理が終わってから破棄する
+    std::erase_if(cancelledBuilds_, [](const std::future<std::shared_ptr<ShapeMesh>>& future) {
+        return IsReady(future);
+    });
+
+    // 3. どのシェイプからも参照されず、しばらく使われていないメッシュを破棄する
+    std::erase_if(meshes_, [this](const auto& pair) {
+        const CacheEntry& entry = pair.second;
+        return entry.mesh.use_count() == 1 && frame_ - entry.lastUsedFrame > kEvictFrames;
+    });
+}
+
+std::shared_ptr<const ShapeMesh> ShapeMeshCache::RequestAsync(uint64_t key, ShapeMeshBuilder builder) {
+    // 生成済みならそのまま返す
+    if (std::shared_ptr<const ShapeMesh> mesh = Find(key)) {
+        return mesh;
+    }
+
+    // 生成中なら要求フレームだけ更新して待つ
+    auto pendingIt = pendingBuilds_.find(key);
+    if (pendingIt != pendingBuilds_.end()) {
+        pendingIt->second.lastRequestFrame = frame_;
+        return nullptr;
+    }
+
+    // ワーカースレッドに生成を依頼
+    Job job;
+    job.key = key;
+    job.builder = std::move(builder);
+    job.cancelled = std::make_shared<std::atomic<bool>>(false);
+
+    PendingBuild pending;
+    pending.future = job.promise.get_future();
+    pending.cancelled = job.cancelled;
+    pending.lastRequestFrame = frame_;
+    pendingBuilds_.emplace(key, std::move(pending));
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobs_.push_back(std::move(job));
+    }
+    jobCondition_.notify_one();
+    return nullptr;
+}
+
+std::shared_ptr<const ShapeMesh> ShapeMeshCache::RequestImmediate(uint64_t key, const ShapeMeshBuilder& builder) {
+    if (std::shared_ptr<const ShapeMesh> mesh = Find(key)) {
+        return mesh;
+    }
+
+    std::shared_ptr<const ShapeMesh> mesh = CreateMesh(builder);
+    meshes_[key] = { mesh, frame_ };
+    return mesh;
+}
+
+void ShapeMeshCache::WorkerMain() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobCondition_.wait(lock, [this] { return isStopping_ || !jobs_.empty(); });
+            if (isStopping_) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        // 取り消されていれば生成せずに終わる
+        if (job.cancelled->load()) {
+            job.promise.set_value(nullptr);
+            continue;
+        }
+
+        job.promise.set_value(CreateMesh(job.builder));
+    }
+}
+
+std::shared_ptr<const ShapeMesh> ShapeMeshCache::Find(uint64_t key) {
+    auto it = meshes_.find(key);
+    if (it == meshes_.end()) {
+        return nullptr;
+    }
+    it->second.lastUsedFrame = frame_;
+    return it->second.mesh;
+}
+
+std::shared_ptr<ShapeMesh> ShapeMeshCache::CreateMesh(const ShapeMeshBuilder& builder) {
+    const PrimitiveMeshSize size = builder.size;
+    assert(size.vertexCount > 0 && size.indexCount > 0);
+
+    // 破棄時はGPUが参照中の可能性があるので、フェンス完了後に解放する
+    std::shared_ptr<ShapeMesh> mesh(new ShapeMesh(), [](ShapeMesh* target) {
+        DX12Context* dxContext = DX12Context::GetInstance();
+        dxContext->DeferredRelease(std::move(target->vertexResource));
+        dxContext->DeferredRelease(std::move(target->indexResource));
+        delete target;
+    });
+
+    // リソース生成はデバイスのみを使うので、ワーカースレッドからでも安全
+    DX12Context* dxContext = DX12Context::GetInstance();
+
+    // 大きさは設定から先に分かるので、バッファを確保してから生成関数に直接書き込ませる (一時配列とコピーを省く)
+    const size_t vertexSize = sizeof(VertexData) * size.vertexCount;
+    const size_t indexSize = sizeof(uint32_t) * size.indexCount;
+    mesh->vertexResource = dxContext->CreateBufferResource(vertexSize);
+    mesh->indexResource = dxContext->CreateBufferResource(indexSize);
+
+    void* mappedVertex = nullptr;
+    void* mappedIndex = nullptr;
+    HRESULT hr = mesh->vertexResource->Map(0, nullptr, &mappedVertex);
+    assert(SUCCEEDED(hr));
+    hr = mesh->indexResource->Map(0, nullptr, &mappedIndex);
+    assert(SUCCEEDED(hr));
+    builder.write(std::span<VertexData>(static_cast<VertexData*>(mappedVertex), size.vertexCount),
+                  std::span<uint32_t>(static_cast<uint32_t*>(mappedIndex), size.indexCount));
+    mesh->vertexResource->Unmap(0, nullptr);
+    mesh->indexResource->Unmap(0, nullptr);
+
+    // 頂点バッファ
+    mesh->vertexBufferView.BufferLocation = mesh->vertexResource->GetGPUVirtualAddress();
+    mesh->vertexBufferView.SizeInBytes = UINT(vertexSize);
+    mesh->vertexBufferView.StrideInBytes = sizeof(VertexData);
+
+    // インデックスバッファ
+    mesh->indexBufferView.BufferLocation = mesh->indexResource->GetGPUVirtualAddress();
+    mesh->indexBufferView.SizeInBytes = UINT(indexSize);
+    mesh->indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+    mesh->indexCount = size.indexCount;
+    return mesh;
+}
+
+// ============================================================
+// ParticleShape::AcquireMesh の実装
+// (キャッシュへの依存をこのファイルに閉じ込め、ParticleShape.cpp を D3D12 なしでビルドできるようにする)
+// ============================================================
+const ShapeMesh* ParticleShape::AcquireMesh(ShapeMeshBuilder builder) {
+    ShapeMeshCache* cache = ShapeMeshCache::GetInstance();
+
+    std::shared_ptr<const ShapeMesh> ready;
+    if (!mesh_) {
+        // 表示できるメッシュがまだ無いので、その場で生成する (CPU処理のみでGPU待ちは発生しない)
+        ready = cache->RequestImmediate(meshKey_, builder);
+    } else {
+        // ワーカースレッドで生成し、完成するまでは前回のメッシュを表示し続ける
+        ready = cache->RequestAsync(meshKey_, std::move(builder));
+    }
+
+    if (ready) {
+        // 古いメッシュは他に参照が無ければキャッシュ側で破棄される (フェンス完了後に解放)
+        mesh_ = std::move(ready);
+        currentMeshKey_ = meshKey_;
+    }
+    return mesh_.get();
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+#include "Model/PrimitiveMesh.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <d3d12.h>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <wrl/client.h>
+
+// パーティクル形状(リング/シリンダー/平面)のGPUメッシュ
+// 同じ形状設定を持つシェイプ同士で共有される
+struct ShapeMesh {
+    Microsoft::WRL::ComPtr<ID3D12Resource> vertexResource;
+    Microsoft::WRL::ComPtr<ID3D12Resource> indexResource;
+    D3D12_VERTEX_BUFFER_VIEW vertexBufferView{};
+    D3D12_INDEX_BUFFER_VIEW indexBufferView{};
+    uint32_t indexCount = 0;
+};
+
+// ============================================================
+// ShapeMeshCache — 設定ハッシュをキーにした形状メッシュのキャッシュ
+// 再構築はワーカースレッドで行い、完成したものを描画スレッドで差し替える
+// 不要になったバッファはフェンス完了後に解放する (WaitForGpu は使わない)
+// ============================================================
+class ShapeMeshCache {
+public:
+    // 【Passkey Idiom】
+    struct Token {
+    private:
+        friend class ShapeMeshCache;
+        Token() {}
+    };
+
+private: // 内部構造体
+    // ワーカースレッドへの生成依頼
+    struct Job {
+        uint64_t key = 0;
+        ShapeMeshBuilder builder;
+        std::promise<std::shared_ptr<ShapeMesh>> promise;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    // 生成中のメッシュ
+    struct PendingBuild {
+        std::future<std::shared_ptr<ShapeMesh>> future;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        uint64_t lastRequestFrame = 0; // 最後に要求されたフレーム
+    };
+
+    // 生成済みのメッシュ
+    struct CacheEntry {
+        std::shared_ptr<const ShapeMesh> mesh;
+        uint64_t lastUsedFrame = 0; // 最後に使われたフレーム
+    };
+
+private: // メンバ変数
+    static std::unique_ptr<ShapeMeshCache> instance_;
+
+    // 生成済みメッシュ (キー = 形状設定のハッシュ)
+    std::unordered_map<uint64_t, CacheEntry> meshes_;
+    // 生成中のメッシュ
+    std::unordered_map<uint64_t, PendingBuild> pendingBuilds_;
+    // 取り消したが、まだワーカーが処理中の可能性があるビルド
+    // (メッシュの破棄を必ず描画スレッドで行うため、完了まで future を保持する)
+    std::vector<std::future<std::shared_ptr<ShapeMesh>>> cancelledBuilds_;
+
+    // ワーカースレッド
+    std::thread worker_;
+    std::deque<Job> jobs_;
+    std::mutex jobMutex_;
+    std::condition_variable jobCondition_;
+    bool isStopping_ = false;
+
+    // フレームカウンタ (Update ごとに進む)
+    uint64_t frame_ = 0;
+
+    // 使われなくなってからこのフレーム数が経過したメッシュは破棄する
+    static const uint64_t kEvictFrames = 120;
+
+public: // シングルトンインスタンス取得
+    static ShapeMeshCache* GetInstance();
+    // インスタンス破棄用関数
+    static void Destroy();
+
+public: // メンバ関数
+    // コンストラクタ(隠蔽)
+    explicit ShapeMeshCache(Token);
+
+    // 初期化 (ワーカースレッドの起動)
+    void Initialize();
+    // 終了 (ワーカースレッドの停止とメッシュの破棄)
+    void Finalize();
+    // 毎フレームの更新 (完成したメッシュの回収と不要なメッシュの破棄)
+    void Update();
+
+    /// <summary>
+    /// メッシュを要求する (非同期)
+    /// 生成済みならそれを返し、未生成ならワーカースレッドに生成を依頼して nullptr を返す
+    /// </summary>
+    /// <param name="key">形状設定のハッシュ</param>
+    /// <param name="builder">頂点・インデックスの生成関数</param>
+    std::shared_ptr<const ShapeMesh> RequestAsync(uint64_t key, ShapeMeshBuilder builder);
+
+    /// <summary>
+    /// メッシュを要求する (同期)
+    /// 表示できるメッシュが1つもない初回用。CPUでの生成のみでGPU待ちは発生しない
+    /// </summary>
+    /// <param name="key">形状設定のハッシュ</param>
+    /// <param name="builder">頂点・インデックスの生成関数</param>
+    std::shared_ptr<const ShapeMesh> RequestImmediate(uint64_t key, const ShapeMeshBuilder& builder);
+
+    // キャッシュ済みのメッシュ数
+    size_t GetCachedMeshCount() const { return meshes_.size(); }
+
+private: // メンバ関数
+    // ワーカースレッドのメインループ
+    void WorkerMain();
+
+    // キャッシュから検索する (見つかれば使用フレームを更新)
+    std::shared_ptr<const ShapeMesh> Find(uint64_t key);
+
+    // 頂点・インデックスを生成し、Upload Heap のバッファに書き込む
+    static std::shared_ptr<ShapeMesh> CreateMesh(const ShapeMeshBuilder& builder);
+
+private: // コンストラクタ・デストラクタ・コピー禁止
+    ~ShapeMeshCache() = default;
+    ShapeMeshCache(const ShapeMeshCache&) = delete;
+    const ShapeMeshCache& operator=(const ShapeMeshCache&) = delete;
+
+    friend std::default_delete<ShapeMeshCache>;
+};
@@ -0,0 +1,194 @@
+#include "Terrain.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include "Base/DX12Context.h"
+#include "Base/Win32Window.h"
+#include "Camera/Camera.h"
+#include "Logger.h"
+#include "Model/Model.h"
+#include "Model/ModelManager.h"
+#include "Object3d/Object3dCommon.h"
+#include "Texture/TextureManager.h"
+
+#include <assert.h>
+#include <format>
+
+using namespace MathGenerators;
+
+Terrain::~Terrain() {
+    // Map済みリソースをUnmap
+    for (uint32_t i = 0; i < kMaxViews; ++i) {
+        if (transformResources_[i] && transformData_[i]) {
+            transformResources_[i]->Unmap(0, nullptr);
+            transformData_[i] = nullptr;
+        }
+    }
+    if (materialResource_ && materialData_) {
+        materialResource_->Unmap(0, nullptr);
+        materialData_ = nullptr;
+    }
+}
+
+void Terrain::Initialize(const std::string& directoryPath, const std::string& filename,
+                         const std::string& textureFilePath, uint32_t resolution,
+                         const TerrainQuadtree::Settings& settings) {
+    // 形状だけを読み込み、LOD0 の三角形を上から見たハイトフィールドにする
+    const std::string fullDirectoryPath = ModelManager::ResolveDirectoryPath(directoryPath, filename);
+    const Model::MeshSource source = Model::LoadMeshSource(fullDirectoryPath, filename);
+    std::span<const VertexData> vertices = source.isCached ? source.cooked.vertices : source.modelData.vertices;
+    std::span<const uint32_t> indices = source.isCached ? source.cooked.indices : source.modelData.indices;
+    const std::vector<MeshLod>& lods = source.isCached ? source.cooked.lods : source.modelData.lods;
+    if (!lods.empty()) {
+        indices = indices.subspan(lods[0].indexOffset, lods[0].indexCount);
+    }
+    Initialize(TerrainHeightfield::CreateFromMesh(vertices, indices, resolution), textureFilePath, settings);
+}
+
+void Terrain::Initialize(TerrainHeightfield heightfield, const std::string& textureFilePath,
+                         const TerrainQuadtree::Settings& settings) {
+    if (!quadtree_.Build(std::move(heightfield), settings)) {
+        assert(false && "Terrain heightfield does not match the chunk settings");
+        return;
+    }
+    Logger::Log(std::format("INFO: Terrain built ({} chunks, depth {}, max error {:.3f})\n",
+                            quadtree_.GetNodes().size(), quadtree_.GetDepth(), quadtree_.GetNodes()[0].error));
+
+    CreateVertexResource();
+    CreateIndexResource();
+    CreateTransformResource();
+    CreateMaterialResource();
+
+    // テクスチャ読み込み (非同期。読み込み済みならキャッシュから返る)
+    textureFilePath_ = textureFilePath;
+    TextureManager::GetInstance()->RequestTexture(textureFilePath_);
+    TextureManager::GetInstance()->RequestTexture(dissolveMaskFilePath_);
+}
+
+void Terrain::Update() {
+    // どのビューも同じカメラなので、ビュー0だけ選んで他のビューはその結果を使う
+    Update(0, camera_);
+    for (uint32_t i = 1; i < kMaxViews; ++i) {
+        viewSources_[i] = 0;
+    }
+}
+
+void Terrain::Update(uint32_t viewIndex, Camera* camera) {
+    assert(viewIndex < kMaxViews);
+    viewSources_[viewIndex] = viewIndex;
+    // 四分木の作成に失敗した場合はリソースが無い
+    if (!camera || !IsInitialized()) {
+        return;
+    }
+
+    // 頂点はワールド座標で持っているので、ワールド行列は単位行列
+    const Matrix4x4& viewProjection = camera->GetViewProjectionMatrix();
+    transformData_[viewIndex]->WVP = viewProjection;
+    transformData_[viewIndex]->World = MakeIdentity4x4();
+    transformData_[viewIndex]->WorldInverseTranspose = MakeIdentity4x4();
+
+    // 見えるチャンクを、画面上の誤差が閾値以下になる粗さで選ぶ
+    // 透視投影では、距離 d での長さ1は画面の高さの m[1][1] / (2 * d) 倍に写る
+    const Matrix4x4& cameraMatrix = camera->GetWorldMatrix();
+    TerrainQuadtree::SelectionParams params;
+    params.frustum = ClusterCuller::ExtractFrustum(viewProjection);
+    params.cameraPosition = {cameraMatrix.m[3][0], cameraMatrix.m[3][1], cameraMatrix.m[3][2]};
+    params.pixelScale = camera->GetProjectionMatrix().m[1][1] * Win32Window::kClientHeight * 0.5f;
+    params.maxPixelError = maxPixelError_;
+    selectionStats_[viewIndex] = quadtree_.Select(params, selectedNodes_[viewIndex]);
+}
+
+void Terrain::Draw(uint32_t viewIndex) {
+    assert(viewIndex < kMaxViews);
+    // Update() で更新した場合は、どのビューもビュー0の結果で描く
+    viewIndex = viewSources_[viewIndex];
+    if (!IsInitialized() || selectedNodes_[viewIndex].empty()) {
+        return;
+    }
+    auto* cmd = DX12Context::GetInstance()->GetCommandList();
+
+    // Object3d と同じルートパラメータ (0: マテリアル, 1: 変換行列, 2: テクスチャ, 8: Dissolve用マスク)
+    Object3dCommon::GetInstance()->SetVertexFormat(kVertexFormatFull);
+    cmd->IASetVertexBuffers(0, 1, &vertexBufferView_);
+    cmd->IASetIndexBuffer(&indexBufferView_);
+    cmd->SetGraphicsRootConstantBufferView(0, materialResource_->GetGPUVirtualAddress());
+    cmd->SetGraphicsRootConstantBufferView(1, transformResources_[viewIndex]->GetGPUVirtualAddress());
+    cmd->SetGraphicsRootDescriptorTable(2, TextureManager::GetInstance()->GetSrvHandleGPU(textureFilePath_));
+    cmd->SetGraphicsRootDescriptorTable(8, TextureManager::GetInstance()->GetSrvHandleGPU(dissolveMaskFilePath_));
+
+    // チャンクごとに頂点オフセットだけを変えて描く
+    const uint32_t chunkVertexCount = quadtree_.GetChunkVertexCount();
+    const uint32_t chunkIndexCount = quadtree_.GetChunkIndexCount();
+    for (uint32_t nodeIndex : selectedNodes_[viewIndex]) {
+        cmd->DrawIndexedInstanced(chunkIndexCount, 1, 0, static_cast<int32_t>(nodeIndex * chunkVertexCount), 0);
+    }
+}
+
+void Terrain::CreateVertexResource() {
+    const uint32_t chunkVertexCount = quadtree_.GetChunkVertexCount();
+    const uint32_t nodeCount = static_cast<uint32_t>(quadtree_.GetNodes().size());
+    const size_t sizeInBytes = sizeof(VertexData) * chunkVertexCount * nodeCount;
+
+    // ノードの番号順に書き出す
+    std::vector<VertexData> vertices(static_cast<size_t>(chunkVertexCount) * nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        quadtree_.WriteChunkVertices(i, std::span<VertexData>(vertices).subspan(static_cast<size_t>(i) * chunkVertexCount,
+                                                                               chunkVertexCount));
+    }
+
+    // 書き換えないので VRAM に置く (転送用のリングバッファ経由で転送する)
+    vertexResource_ = DX12Context::GetInstance()->CreateStaticBufferResource(
+        vertices.data(), sizeInBytes, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+    // VertexBufferViewを作成する
+    vertexBufferView_.BufferLocation = vertexResource_->GetGPUVirtualAddress();
+    vertexBufferView_.SizeInBytes = UINT(sizeInBytes);
+    vertexBufferView_.StrideInBytes = sizeof(VertexData);
+}
+
+void Terrain::CreateIndexResource() {
+    const uint32_t chunkIndexCount = quadtree_.GetChunkIndexCount();
+    const size_t sizeInBytes = sizeof(uint16_t) * chunkIndexCount;
+
+    // データの書き出し
+    std::vector<uint16_t> indices(chunkIndexCount);
+    quadtree_.WriteChunkIndices(indices);
+
+    // リソース作成 (頂点と同じく VRAM に置く)
+    indexResource_ = DX12Context::GetInstance()->CreateStaticBufferResource(
+        indices.data(), sizeInBytes, D3D12_RESOURCE_STATE_INDEX_BUFFER);
+
+    // インデックスバッファビューの作成 (チャンクの頂点数は 65536 未満なので16bit)
+    indexBufferView_.BufferLocation = indexResource_->GetGPUVirtualAddress();
+    indexBufferView_.SizeInBytes = UINT(sizeInBytes);
+    indexBufferView_.Format = DXGI_FORMAT_R16_UINT;
+}
+
+void Terrain::CreateTransformResource() {
+    // 変換行列リソースの作成
+    for (uint32_t i = 0; i < kMaxViews; ++i) {
+        transformResources_[i] = DX12Context::GetInstance()->CreateBufferResource(sizeof(TransformationMatrix));
+        // 書き込むためのアドレスを取得
+        transformResources_[i]->Map(0, nullptr, reinterpret_cast<void**>(&transformData_[i]));
+        // TransformationMatrixDataの設定
+        transformData_[i]->WVP = MakeIdentity4x4();
+        transformData_[i]->World = MakeIdentity4x4();
+        transformData_[i]->WorldInverseTranspose = MakeIdentity4x4();
+    }
+}
+
+void Terrain::CreateMaterialResource() {
+    // マテリアルリソースを作る (初期値は Model と同じ)
+    materialResource_ = DX12Context::GetInstance()->CreateBufferResource(sizeof(Material));
+    materialResource_->Map(0, nullptr, reinterpret_cast<void**>(&materialData_));
+    *materialData_ = {};
+    materialData_->color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+    materialData_->enableLighting = true;
+    materialData_->uvTransform = MakeIdentity4x4();
+    materialData_->shininess = 10.0f;
+    materialData_->environmentCoefficient = 0.0f;
+
+    // Dissolveパラメータの初期化
+    materialData_->enableDissolve = 0;
+    materialData_->dissolveThreshold = 0.0f;
+    materialData_->dissolveEdgeRange = 0.02f;
+    materialData_->dissolveEdgeColor = Vector3(1.0f, 0.4f, 0.3f);
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include "TerrainQuadtree.h"
+#include "Types/GraphicsTypes.h"
+
+#include <d3d12.h>
+#include <wrl/client.h>
+#include <string>
+#include <vector>
+
+class Camera;
+
+// ============================================================
+// Terrain — TerrainQuadtree のチャンクを Object3d と同じパイプラインで描く
+// 全ノードのチャンクの頂点を1つの頂点バッファに並べ、インデックスは全チャンクで共通のものを使う
+// ビューごとに描くチャンクを選び、チャンクごとに頂点オフセットを変えて描画する
+// ============================================================
+class Terrain {
+    template <class T> using ComPtr = Microsoft::WRL::ComPtr<T>;
+public:
+    static const uint32_t kMaxViews = 3; // 0: Main, 1: Left, 2: Right
+
+private:
+    // 四分木 (ハイトフィールドとチャンクの選択)
+    TerrainQuadtree quadtree_;
+    // 頂点・インデックスバッファ
+    ComPtr<ID3D12Resource> vertexResource_;
+    D3D12_VERTEX_BUFFER_VIEW vertexBufferView_{};
+    ComPtr<ID3D12Resource> indexResource_;
+    D3D12_INDEX_BUFFER_VIEW indexBufferView_{};
+    // 定数バッファ (WVP行列)
+    ComPtr<ID3D12Resource> transformResources_[kMaxViews];
+    TransformationMatrix* transformData_[kMaxViews] = {nullptr};
+    // マテリアル
+    ComPtr<ID3D12Resource> materialResource_;
+    Material* materialData_ = nullptr;
+    std::string textureFilePath_;
+    std::string dissolveMaskFilePath_ = "masks/noise0.png";
+    // ビューごとに選んだチャンク
+    std::vector<uint32_t> selectedNodes_[kMaxViews];
+    TerrainQuadtree::SelectionStats selectionStats_[kMaxViews];
+    // 各ビューの描画に使う結果のビュー番号 (Update() で全ビューを更新した場合はすべて0)
+    uint32_t viewSources_[kMaxViews] = {0, 1, 2};
+    // カメラ参照
+    Camera* camera_ = nullptr;
+    // 許容する画面上の誤差 (ピクセル)
+    float maxPixelError_ = 2.0f;
+public:
+    ~Terrain();
+    /// <summary>
+    /// モデルファイルの形状を上から見たハイトフィールドにして初期化する
+    /// </summary>
+    /// <param name="directoryPath">モデルファイルのディレクトリパス</param>
+    /// <param name="filename">モデルファイル名</param>
+    /// <param name="textureFilePath">テクスチャ (地形全体で UV 0～1)</param>
+    /// <param name="resolution">ハイトフィールド1辺のセル数 (chunkCells × 2^n)</param>
+    /// <param name="settings">チャンクの設定</param>
+    void Initialize(const std::string& directoryPath, const std::string& filename, const std::string& textureFilePath,
+                    uint32_t resolution, const TerrainQuadtree::Settings& settings = {});
+    // ハイトフィールドから初期化する
+    void Initialize(TerrainHeightfield heightfield, const std::string& textureFilePath,
+                    const TerrainQuadtree::Settings& settings = {});
+    // 全ビュー更新 (同じカメラなので選択はビュー0の分だけ行い、他のビューはその結果で描く)
+    void Update();
+    // 指定したビュー用の更新 (描くチャンクを選ぶ)
+    void Update(uint32_t viewIndex, Camera* camera);
+    // Object3dCommon の描画設定の後に呼ぶ
+    void Draw(uint32_t viewIndex = 0);
+    void SetCamera(Camera* camera) { camera_ = camera; }
+    // 地面の高さ (接地用。描画される三角形の上の高さ)
+    float GetHeight(float x, float z) const { return quadtree_.GetHeight(x, z); }
+    // ゲッター・セッター
+    float& GetMaxPixelError() { return maxPixelError_; }
+    void SetMaxPixelError(float maxPixelError) { maxPixelError_ = maxPixelError; }
+    Material* GetMaterial() { return materialData_; }
+    const TerrainQuadtree& GetQuadtree() const { return quadtree_; }
+    const TerrainQuadtree::SelectionStats& GetSelectionStats(uint32_t viewIndex = 0) const {
+        return selectionStats_[viewSources_[viewIndex]];
+    }
+    // 初期化に成功したか (失敗した場合は Update / Draw で何もしない)
+    bool IsInitialized() const { return transformData_[0] != nullptr; }
+private:
+    void CreateVertexResource();   // 全ノードのチャンクの頂点データ生成
+    void CreateIndexResource();    // 共通のインデックスデータ生成
+    void CreateTransformResource();// 定数バッファ生成
+    void CreateMaterialResource(); // マテリアル生成
+};
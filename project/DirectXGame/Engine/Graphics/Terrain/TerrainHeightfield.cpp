@@ -0,0 +1,139 @@
+#include "TerrainHeightfield.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// 三角形の内外判定の許容量 (辺上の格子点を隣り合う両方の三角形で拾うため)
+const float kBarycentricEpsilon = 1e-5f;
+
+// ワールド座標を格子の座標 (0～resolution) にする
+float ToGrid(float value, float origin, float cellSize, uint32_t resolution) {
+    return std::clamp((value - origin) / cellSize, 0.0f, static_cast<float>(resolution));
+}
+
+} // namespace
+
+float TerrainHeightfield::GetHeight(float x, float z) const {
+    if (heights.empty()) {
+        return 0.0f;
+    }
+    if (resolution == 0) {
+        return heights[0];
+    }
+    const float gridX = ToGrid(x, origin.x, cellSize.x, resolution);
+    const float gridZ = ToGrid(z, origin.y, cellSize.y, resolution);
+    const uint32_t cellX = std::min(static_cast<uint32_t>(gridX), resolution - 1);
+    const uint32_t cellZ = std::min(static_cast<uint32_t>(gridZ), resolution - 1);
+    const float u = gridX - static_cast<float>(cellX);
+    const float v = gridZ - static_cast<float>(cellZ);
+
+    // (x, z+1)-(x+1, z) の対角線のどちら側の三角形か
+    const float h01 = GetSample(cellX, cellZ + 1);
+    const float h10 = GetSample(cellX + 1, cellZ);
+    if (u + v <= 1.0f) {
+        const float h00 = GetSample(cellX, cellZ);
+        return h00 + (h10 - h00) * u + (h01 - h00) * v;
+    }
+    const float h11 = GetSample(cellX + 1, cellZ + 1);
+    return h11 + (h01 - h11) * (1.0f - u) + (h10 - h11) * (1.0f - v);
+}
+
+Vector3 TerrainHeightfield::GetNormal(uint32_t x, uint32_t z) const {
+    // 端では片側の差分になる
+    const uint32_t x0 = x > 0 ? x - 1 : x;
+    const uint32_t x1 = std::min(x + 1, resolution);
+    const uint32_t z0 = z > 0 ? z - 1 : z;
+    const uint32_t z1 = std::min(z + 1, resolution);
+    const float dx = x1 > x0 ? (GetSample(x1, z) - GetSample(x0, z)) / (static_cast<float>(x1 - x0) * cellSize.x) : 0.0f;
+    const float dz = z1 > z0 ? (GetSample(x, z1) - GetSample(x, z0)) / (static_cast<float>(z1 - z0) * cellSize.y) : 0.0f;
+
+    // 面 y = h(x, z) の法線は (-dh/dx, 1, -dh/dz)
+    const float length = std::sqrt(dx * dx + 1.0f + dz * dz);
+    return {-dx / length, 1.0f / length, -dz / length};
+}
+
+TerrainHeightfield TerrainHeightfield::CreateFromMesh(std::span<const VertexData> vertices,
+                                                      std::span<const uint32_t> indices, uint32_t resolution) {
+    TerrainHeightfield heightfield;
+    heightfield.resolution = std::max(resolution, 1u);
+    const uint32_t sampleCount = heightfield.GetSampleCount();
+    const float unset = -std::numeric_limits<float>::infinity();
+    heightfield.heights.assign(static_cast<size_t>(sampleCount) * sampleCount, unset);
+
+    // 範囲はインデックスが参照する頂点の XZ
+    float minX = std::numeric_limits<float>::infinity(), minZ = minX;
+    float maxX = -minX, maxZ = -minX;
+    for (uint32_t index : indices) {
+        const Vector4& position = vertices[index].position;
+        minX = std::min(minX, position.x);
+        maxX = std::max(maxX, position.x);
+        minZ = std::min(minZ, position.z);
+        maxZ = std::max(maxZ, position.z);
+    }
+    if (indices.empty()) {
+        heightfield.heights.assign(heightfield.heights.size(), 0.0f);
+        return heightfield;
+    }
+    heightfield.origin = {minX, minZ};
+    heightfield.cellSize = {maxX > minX ? (maxX - minX) / heightfield.resolution : 1.0f,
+                            maxZ > minZ ? (maxZ - minZ) / heightfield.resolution : 1.0f};
+
+    // 三角形ごとに、XZ の範囲にある格子点へ重心座標で高さを補間して書き込む
+    const float maxGrid = static_cast<float>(heightfield.resolution);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const Vector4& p0 = vertices[indices[i]].position;
+        const Vector4& p1 = vertices[indices[i + 1]].position;
+        const Vector4& p2 = vertices[indices[i + 2]].position;
+        const float e1x = p1.x - p0.x, e1z = p1.z - p0.z;
+        const float e2x = p2.x - p0.x, e2z = p2.z - p0.z;
+        const float determinant = e1x * e2z - e2x * e1z;
+        if (std::abs(determinant) <= std::numeric_limits<float>::epsilon() * (std::abs(e1x * e2z) + std::abs(e2x * e1z))) {
+            continue; // 上から見て面積の無い (垂直な) 面
+        }
+
+        const auto toGrid = [&](float value, float origin, float cellSize) { return (value - origin) / cellSize; };
+        const float gridMinX = toGrid(std::min({p0.x, p1.x, p2.x}), heightfield.origin.x, heightfield.cellSize.x);
+        const float gridMaxX = toGrid(std::max({p0.x, p1.x, p2.x}), heightfield.origin.x, heightfield.cellSize.x);
+        const float gridMinZ = toGrid(std::min({p0.z, p1.z, p2.z}), heightfield.origin.y, heightfield.cellSize.y);
+        const float gridMaxZ = toGrid(std::max({p0.z, p1.z, p2.z}), heightfield.origin.y, heightfield.cellSize.y);
+        const uint32_t beginX = static_cast<uint32_t>(std::clamp(std::ceil(gridMinX - 1e-4f), 0.0f, maxGrid));
+        const uint32_t endX = static_cast<uint32_t>(std::clamp(std::floor(gridMaxX + 1e-4f), 0.0f, maxGrid));
+        const uint32_t beginZ = static_cast<uint32_t>(std::clamp(std::ceil(gridMinZ - 1e-4f), 0.0f, maxGrid));
+        const uint32_t endZ = static_cast<uint32_t>(std::clamp(std::floor(gridMaxZ + 1e-4f), 0.0f, maxGrid));
+
+        for (uint32_t z = beginZ; z <= endZ; ++z) {
+            const float dz = heightfield.origin.y + heightfield.cellSize.y * z - p0.z;
+            for (uint32_t x = beginX; x <= endX; ++x) {
+                const float dx = heightfield.origin.x + heightfield.cellSize.x * x - p0.x;
+                const float l1 = (dx * e2z - e2x * dz) / determinant;
+                const float l2 = (e1x * dz - dx * e1z) / determinant;
+                if (l1 < -kBarycentricEpsilon || l2 < -kBarycentricEpsilon || l1 + l2 > 1.0f + kBarycentricEpsilon) {
+                    continue;
+                }
+                const float height = p0.y + (p1.y - p0.y) * l1 + (p2.y - p0.y) * l2;
+                float& sample = heightfield.heights[static_cast<size_t>(z) * sampleCount + x];
+                sample = std::max(sample, height);
+            }
+        }
+    }
+
+    // どの面にも含まれなかった格子点 (穴) は最も低い高さで埋める
+    float lowest = std::numeric_limits<float>::infinity();
+    for (float height : heightfield.heights) {
+        if (height != unset) {
+            lowest = std::min(lowest, height);
+        }
+    }
+    if (lowest == std::numeric_limits<float>::infinity()) {
+        lowest = 0.0f;
+    }
+    for (float& height : heightfield.heights) {
+        if (height == unset) {
+            height = lowest;
+        }
+    }
+    return heightfield;
+}
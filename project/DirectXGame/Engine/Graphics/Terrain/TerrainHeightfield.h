@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ============================================================
+// TerrainHeightfield — 等間隔の格子点に高さを持つ地形データ
+// 格子点は X・Z 方向に (resolution + 1) 個ずつ並び、Z の行ごとに heights に入る
+// D3D12 に依存しないので、ワーカースレッドやヘッドレスのテストからも使える
+//
+// 各セルは (x, z+1)-(x+1, z) の対角線で2つの三角形に分ける (TerrainQuadtree の最も細かいチャンクと同じ)
+// GetHeight はこの三角形の上の高さを返すので、描画される地面と一致する
+// ============================================================
+struct TerrainHeightfield {
+    uint32_t resolution = 0;            // 1辺のセル数
+    Vector2 origin = {0.0f, 0.0f};      // 格子点 (0, 0) のワールド座標 (x, z)
+    Vector2 cellSize = {1.0f, 1.0f};    // セルの大きさ (x, z)
+    std::vector<float> heights;         // 格子点の高さ (ワールド座標の y)
+
+    // 1辺の格子点の数
+    uint32_t GetSampleCount() const { return resolution + 1; }
+
+    // 格子点の高さ
+    float GetSample(uint32_t x, uint32_t z) const { return heights[z * (resolution + 1) + x]; }
+
+    /// <summary>
+    /// ワールド座標 (x, z) の地面の高さを求める (範囲外は端の高さ)
+    /// </summary>
+    float GetHeight(float x, float z) const;
+
+    /// <summary>
+    /// 格子点の法線を求める (隣の格子点との中心差分)
+    /// </summary>
+    Vector3 GetNormal(uint32_t x, uint32_t z) const;
+
+    /// <summary>
+    /// 上から見た三角形メッシュを格子点ごとに高さへ変換する (同じ位置に複数の面があれば最も高いもの)
+    /// 範囲はメッシュの XZ の範囲。どの面にも含まれない格子点は最も低い高さにする
+    /// </summary>
+    /// <param name="vertices">頂点</param>
+    /// <param name="indices">三角形のインデックス</param>
+    /// <param name="resolution">1辺のセル数</param>
+    static TerrainHeightfield CreateFromMesh(std::span<const VertexData> vertices, std::span<const uint32_t> indices,
+                                             uint32_t resolution);
+};
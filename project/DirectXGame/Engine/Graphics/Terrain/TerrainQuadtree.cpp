@@ -0,0 +1,286 @@
+#include "TerrainQuadtree.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+namespace {
+
+// 四分木の最大の深さ (選択のスタックの大きさを決める)
+const uint32_t kMaxDepth = 16;
+
+// 選択のスタックの1要素 (planeMask = まだ内外を調べる必要がある平面)
+struct SelectionEntry {
+    uint32_t nodeIndex;
+    uint32_t planeMask;
+};
+
+bool IsPowerOfTwo(uint32_t value) { return value != 0 && (value & (value - 1)) == 0; }
+
+// AABB が平面の外側にあれば true。平面の内側に完全に入っていれば planeMask から外す
+bool IsOutsideFrustum(const ClusterCuller::Frustum& frustum, const AABB& aabb, uint32_t& planeMask) {
+    for (uint32_t i = 0; i < 6; ++i) {
+        if ((planeMask & (1u << i)) == 0) {
+            continue;
+        }
+        const Vector4& plane = frustum.planes[i];
+        // 平面の法線の方向に最も進んだ頂点と、最も戻った頂点
+        const float farthest = plane.x * (plane.x >= 0.0f ? aabb.max.x : aabb.min.x) +
+                               plane.y * (plane.y >= 0.0f ? aabb.max.y : aabb.min.y) +
+                               plane.z * (plane.z >= 0.0f ? aabb.max.z : aabb.min.z) + plane.w;
+        if (farthest < 0.0f) {
+            return true;
+        }
+        const float nearest = plane.x * (plane.x >= 0.0f ? aabb.min.x : aabb.max.x) +
+                              plane.y * (plane.y >= 0.0f ? aabb.min.y : aabb.max.y) +
+                              plane.z * (plane.z >= 0.0f ? aabb.min.z : aabb.max.z) + plane.w;
+        if (nearest >= 0.0f) {
+            planeMask &= ~(1u << i);
+        }
+    }
+    return false;
+}
+
+float DistanceToAABB(const AABB& aabb, const Vector3& point) {
+    const float x = std::max({aabb.min.x - point.x, 0.0f, point.x - aabb.max.x});
+    const float y = std::max({aabb.min.y - point.y, 0.0f, point.y - aabb.max.y});
+    const float z = std::max({aabb.min.z - point.z, 0.0f, point.z - aabb.max.z});
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+} // namespace
+
+bool TerrainQuadtree::Build(TerrainHeightfield heightfield, const Settings& settings) {
+    nodes_.clear();
+    const uint32_t chunkCells = settings.chunkCells;
+    if (!IsPowerOfTwo(chunkCells) || chunkCells < 2 || chunkCells > 64) {
+        Logger::Log(std::format("WARNING: Terrain chunkCells must be a power of two in [2, 64] ({})\n", chunkCells));
+        return false;
+    }
+    const uint32_t resolution = heightfield.resolution;
+    if (resolution % chunkCells != 0 || !IsPowerOfTwo(resolution / chunkCells) ||
+        resolution / chunkCells > (1u << kMaxDepth) ||
+        heightfield.heights.size() != static_cast<size_t>(resolution + 1) * (resolution + 1)) {
+        Logger::Log(std::format("WARNING: Terrain resolution {} is not chunkCells ({}) x 2^n\n", resolution, chunkCells));
+        return false;
+    }
+    heightfield_ = std::move(heightfield);
+    settings_ = settings;
+    depth_ = 0;
+    while ((chunkCells << depth_) < resolution) {
+        ++depth_;
+    }
+
+    // 深さ順にノードを作る (子は親より後ろに並ぶ)
+    nodes_.reserve(((size_t(1) << (2 * (depth_ + 1))) - 1) / 3);
+    nodes_.push_back({{}, 0.0f, 0, 0, 0, 0, resolution / chunkCells});
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].level == depth_) {
+            continue;
+        }
+        const Node parent = nodes_[i];
+        const uint32_t childStep = parent.step / 2;
+        const uint32_t childCells = chunkCells * childStep;
+        nodes_[i].firstChild = static_cast<uint32_t>(nodes_.size());
+        for (uint32_t child = 0; child < 4; ++child) {
+            nodes_.push_back({{}, 0.0f, parent.level + 1, 0, parent.cellX + (child & 1) * childCells,
+                              parent.cellZ + (child >> 1) * childCells, childStep});
+        }
+    }
+
+    // 葉から順に、高さの範囲と誤差を求める
+    std::vector<Vector2> heightRanges(nodes_.size());
+    for (size_t i = nodes_.size(); i-- > 0;) {
+        Node& node = nodes_[i];
+        Vector2& range = heightRanges[i];
+        if (node.firstChild == 0) {
+            // 葉はハイトフィールドそのものなので誤差は無い
+            range = {heightfield_.GetSample(node.cellX, node.cellZ), heightfield_.GetSample(node.cellX, node.cellZ)};
+            for (uint32_t z = 0; z <= chunkCells; ++z) {
+                for (uint32_t x = 0; x <= chunkCells; ++x) {
+                    const float height = heightfield_.GetSample(node.cellX + x, node.cellZ + z);
+                    range = {std::min(range.x, height), std::max(range.y, height)};
+                }
+            }
+        } else {
+            range = heightRanges[node.firstChild];
+            for (uint32_t child = 0; child < 4; ++child) {
+                const Vector2& childRange = heightRanges[node.firstChild + child];
+                range = {std::min(range.x, childRange.x), std::max(range.y, childRange.y)};
+                node.error = std::max(node.error, nodes_[node.firstChild + child].error);
+            }
+            // 覆う範囲のすべての格子点で、チャンクの三角形との高さの差を測る
+            const uint32_t cells = chunkCells * node.step;
+            for (uint32_t z = node.cellZ; z <= node.cellZ + cells; ++z) {
+                for (uint32_t x = node.cellX; x <= node.cellX + cells; ++x) {
+                    node.error = std::max(node.error, std::abs(GetChunkHeight(node, x, z) - heightfield_.GetSample(x, z)));
+                }
+            }
+        }
+    }
+
+    // 隣のチャンクとの隙間は粗い側の誤差以下だが、隣が何段粗いかは決まっていないので、最も粗い根の誤差を使う
+    skirtDepth_ = std::max(nodes_[0].error, settings_.minSkirtDepth);
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        Node& node = nodes_[i];
+        const uint32_t cells = chunkCells * node.step;
+        node.bounds.min = {heightfield_.origin.x + heightfield_.cellSize.x * node.cellX, heightRanges[i].x - skirtDepth_,
+                           heightfield_.origin.y + heightfield_.cellSize.y * node.cellZ};
+        node.bounds.max = {heightfield_.origin.x + heightfield_.cellSize.x * (node.cellX + cells), heightRanges[i].y,
+                           heightfield_.origin.y + heightfield_.cellSize.y * (node.cellZ + cells)};
+    }
+    return true;
+}
+
+TerrainQuadtree::SelectionStats TerrainQuadtree::Select(const SelectionParams& params,
+                                                        std::vector<uint32_t>& selectedNodes) const {
+    SelectionStats stats;
+    selectedNodes.clear();
+    if (nodes_.empty()) {
+        return stats;
+    }
+    const uint32_t chunkTriangles = GetChunkIndexCount() / 3;
+
+    // 深さ優先で辿る (1段下りるごとに増えるのは高々3つ)
+    SelectionEntry stack[3 * kMaxDepth + 1];
+    uint32_t stackSize = 0;
+    stack[stackSize++] = {0, 0x3Fu};
+    while (stackSize > 0) {
+        SelectionEntry entry = stack[--stackSize];
+        const Node& node = nodes_[entry.nodeIndex];
+        ++stats.visitedNodes;
+        if (entry.planeMask != 0 && IsOutsideFrustum(params.frustum, node.bounds, entry.planeMask)) {
+            ++stats.culledNodes;
+            continue;
+        }
+
+        // 画面上の誤差 = 誤差 × pixelScale / 距離 が閾値以下なら、このノードで描く
+        const float distance = DistanceToAABB(node.bounds, params.cameraPosition);
+        if (node.firstChild == 0 || node.error * params.pixelScale <= params.maxPixelError * distance) {
+            selectedNodes.push_back(entry.nodeIndex);
+            ++stats.selectedNodes;
+            stats.triangles += chunkTriangles;
+            continue;
+        }
+        for (uint32_t child = 0; child < 4; ++child) {
+            stack[stackSize++] = {node.firstChild + child, entry.planeMask};
+        }
+    }
+    return stats;
+}
+
+uint32_t TerrainQuadtree::GetChunkVertexCount() const {
+    const uint32_t chunkCells = settings_.chunkCells;
+    return (chunkCells + 1) * (chunkCells + 1) + 4 * chunkCells;
+}
+
+uint32_t TerrainQuadtree::GetChunkIndexCount() const {
+    const uint32_t chunkCells = settings_.chunkCells;
+    return chunkCells * chunkCells * 6 + 4 * chunkCells * 6;
+}
+
+void TerrainQuadtree::WriteChunkVertices(uint32_t nodeIndex, std::span<VertexData> vertices) const {
+    const Node& node = nodes_[nodeIndex];
+    const uint32_t chunkCells = settings_.chunkCells;
+    const uint32_t rowVertices = chunkCells + 1;
+    const float inverseResolution = 1.0f / static_cast<float>(heightfield_.resolution);
+
+    // チャンクの格子点 (x, z) の頂点 (UV は地形全体で 0～1。上から見て奥が V = 0)
+    // 書き込み先はアップロードバッファなので、スカートも読み返さずに作り直す
+    const auto makeVertex = [&](uint32_t x, uint32_t z, float offsetY) {
+        const uint32_t sampleX = node.cellX + x * node.step;
+        const uint32_t sampleZ = node.cellZ + z * node.step;
+        return VertexData{{heightfield_.origin.x + heightfield_.cellSize.x * sampleX,
+                           heightfield_.GetSample(sampleX, sampleZ) + offsetY,
+                           heightfield_.origin.y + heightfield_.cellSize.y * sampleZ, 1.0f},
+                          {sampleX * inverseResolution, 1.0f - sampleZ * inverseResolution},
+                          heightfield_.GetNormal(sampleX, sampleZ)};
+    };
+
+    uint32_t index = 0;
+    for (uint32_t z = 0; z <= chunkCells; ++z) {
+        for (uint32_t x = 0; x <= chunkCells; ++x) {
+            vertices[index++] = makeVertex(x, z, 0.0f);
+        }
+    }
+
+    // スカート (外周の格子点を真下へ下ろしたもの)
+    for (uint32_t k = 0; k < 4 * chunkCells; ++k) {
+        const uint32_t ringVertex = GetRingVertex(k);
+        vertices[index++] = makeVertex(ringVertex % rowVertices, ringVertex / rowVertices, -skirtDepth_);
+    }
+}
+
+void TerrainQuadtree::WriteChunkIndices(std::span<uint16_t> indices) const {
+    const uint32_t chunkCells = settings_.chunkCells;
+    const uint32_t rowVertices = chunkCells + 1;
+    uint32_t index = 0;
+    const auto writeTriangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+        indices[index++] = static_cast<uint16_t>(a);
+        indices[index++] = static_cast<uint16_t>(b);
+        indices[index++] = static_cast<uint16_t>(c);
+    };
+
+    // 格子 (表は上。TerrainHeightfield::GetHeight と同じ対角線で分ける)
+    for (uint32_t z = 0; z < chunkCells; ++z) {
+        for (uint32_t x = 0; x < chunkCells; ++x) {
+            const uint32_t v00 = z * rowVertices + x;
+            const uint32_t v10 = v00 + 1;
+            const uint32_t v01 = v00 + rowVertices;
+            const uint32_t v11 = v01 + 1;
+            writeTriangle(v00, v01, v10);
+            writeTriangle(v10, v01, v11);
+        }
+    }
+
+    // スカート (表はチャンクの外側)
+    const uint32_t ringCount = 4 * chunkCells;
+    const uint32_t skirtBase = rowVertices * rowVertices;
+    for (uint32_t k = 0; k < ringCount; ++k) {
+        const uint32_t next = (k + 1) % ringCount;
+        const uint32_t top0 = GetRingVertex(k);
+        const uint32_t top1 = GetRingVertex(next);
+        writeTriangle(top0, top1, skirtBase + k);
+        writeTriangle(top1, skirtBase + next, skirtBase + k);
+    }
+}
+
+float TerrainQuadtree::GetChunkHeight(const Node& node, uint32_t x, uint32_t z) const {
+    const uint32_t chunkCells = settings_.chunkCells;
+    const uint32_t localX = x - node.cellX;
+    const uint32_t localZ = z - node.cellZ;
+    const uint32_t gridX = std::min(localX / node.step, chunkCells - 1);
+    const uint32_t gridZ = std::min(localZ / node.step, chunkCells - 1);
+    const float u = static_cast<float>(localX - gridX * node.step) / static_cast<float>(node.step);
+    const float v = static_cast<float>(localZ - gridZ * node.step) / static_cast<float>(node.step);
+
+    const uint32_t x0 = node.cellX + gridX * node.step, x1 = x0 + node.step;
+    const uint32_t z0 = node.cellZ + gridZ * node.step, z1 = z0 + node.step;
+    const float h01 = heightfield_.GetSample(x0, z1);
+    const float h10 = heightfield_.GetSample(x1, z0);
+    if (u + v <= 1.0f) {
+        const float h00 = heightfield_.GetSample(x0, z0);
+        return h00 + (h10 - h00) * u + (h01 - h00) * v;
+    }
+    const float h11 = heightfield_.GetSample(x1, z1);
+    return h11 + (h01 - h11) * (1.0f - u) + (h10 - h11) * (1.0f - v);
+}
+
+uint32_t TerrainQuadtree::GetRingVertex(uint32_t k) const {
+    // 手前の辺 (+X へ) → 右の辺 (+Z へ) → 奥の辺 (-X へ) → 左の辺 (-Z へ)
+    const uint32_t chunkCells = settings_.chunkCells;
+    const uint32_t rowVertices = chunkCells + 1;
+    const uint32_t side = k / chunkCells;
+    const uint32_t offset = k % chunkCells;
+    switch (side) {
+    case 0:
+        return offset;
+    case 1:
+        return offset * rowVertices + chunkCells;
+    case 2:
+        return chunkCells * rowVertices + (chunkCells - offset);
+    default:
+        return (chunkCells - offset) * rowVertices;
+    }
+}
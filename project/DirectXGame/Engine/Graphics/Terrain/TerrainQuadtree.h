@@ -0,0 +1,107 @@
+#pragma once
+
+#include "ClusterCuller.h"
+#include "TerrainHeightfield.h"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// ============================================================
+// TerrainQuadtree — 地形をチャンクの四分木に分け、描くチャンクを CPU で選ぶ
+//   ・四分木のノードがそれぞれ1つのチャンク (同じ格子数 chunkCells × chunkCells)
+//     根は地形全体を粗く、葉はハイトフィールドの解像度そのままで表す (深さが LOD の段階になる)
+//   ・ノードの誤差は、そのチャンクの三角形と元のハイトフィールドの高さの差の最大値 (子以上になるよう上へ伝える)
+//   ・チャンクの外周には下へ垂らしたスカート (根の誤差ぶんの深さ) を付け、隣と LOD が違うときの隙間を隠す
+//   ・毎フレーム、視錐台の外のノードを捨て、画面上の誤差 (ピクセル) が閾値以下になる最も粗いノードを選ぶ
+// D3D12 に依存しないので、選択の結果と速度はヘッドレスで確かめられる
+// チャンクの頂点・インデックスはワールド座標で書き出す (インデックスは全チャンク共通の16bit)
+// ============================================================
+class TerrainQuadtree {
+public:
+    // 分割の設定
+    struct Settings {
+        uint32_t chunkCells = 32;     // チャンク1辺のセル数 (2 以上 64 以下の2の累乗)
+        float minSkirtDepth = 0.1f;   // スカートの最小の深さ (ワールド座標の距離)
+    };
+
+    // 四分木のノード (= チャンク)
+    struct Node {
+        AABB bounds;                  // スカートを含む範囲 (子の範囲は親に含まれる)
+        float error = 0.0f;           // 元のハイトフィールドからの最大の誤差 (高さの差)
+        uint32_t level = 0;           // 深さ (0 = 根)
+        uint32_t firstChild = 0;      // 子4つの先頭の番号 (0 = 葉)
+        uint32_t cellX = 0;           // 覆う範囲の先頭の格子点 (ハイトフィールドの番号)
+        uint32_t cellZ = 0;
+        uint32_t step = 1;            // チャンクの格子1つぶんのハイトフィールドのセル数
+    };
+
+    // 選択の条件
+    struct SelectionParams {
+        ClusterCuller::Frustum frustum;     // ワールド空間の視錐台
+        Vector3 cameraPosition;             // ワールド空間のカメラ位置
+        float pixelScale = 1.0f;            // 距離 1 での 1 単位あたりのピクセル数 (proj.m[1][1] * 画面の高さ / 2)
+        float maxPixelError = 2.0f;         // 許容する画面上の誤差 (ピクセル)
+    };
+
+    // 選択の結果
+    struct SelectionStats {
+        uint32_t visitedNodes = 0;
+        uint32_t culledNodes = 0;
+        uint32_t selectedNodes = 0;
+        uint32_t triangles = 0;
+    };
+
+public:
+    /// <summary>
+    /// 四分木を作る
+    /// </summary>
+    /// <param name="heightfield">ハイトフィールド (resolution は chunkCells × 2^n であること)</param>
+    /// <param name="settings">分割の設定</param>
+    /// <returns>false = 設定とハイトフィールドの大きさが合わない</returns>
+    bool Build(TerrainHeightfield heightfield, const Settings& settings);
+
+    /// <summary>
+    /// 描くノードを選ぶ (選ばれたノード同士は重ならず、見える範囲を覆う)
+    /// </summary>
+    /// <param name="params">選択の条件</param>
+    /// <param name="selectedNodes">選んだノードの番号の出力先 (中身は置き換える)</param>
+    /// <returns>選択の結果</returns>
+    SelectionStats Select(const SelectionParams& params, std::vector<uint32_t>& selectedNodes) const;
+
+    // ワールド座標 (x, z) の地面の高さ (最も細かいチャンクの三角形の上の高さ)
+    float GetHeight(float x, float z) const { return heightfield_.GetHeight(x, z); }
+
+    // チャンク1つの頂点数・インデックス数 (全ノード共通)
+    uint32_t GetChunkVertexCount() const;
+    uint32_t GetChunkIndexCount() const;
+
+    /// <summary>
+    /// ノードのチャンクの頂点を書き込む (格子点 (chunkCells+1)^2 個の後にスカート 4×chunkCells 個)
+    /// </summary>
+    void WriteChunkVertices(uint32_t nodeIndex, std::span<VertexData> vertices) const;
+
+    /// <summary>
+    /// 全チャンク共通のインデックスを書き込む (頂点番号はチャンクの先頭から)
+    /// </summary>
+    void WriteChunkIndices(std::span<uint16_t> indices) const;
+
+    // ゲッター
+    const std::vector<Node>& GetNodes() const { return nodes_; }
+    const TerrainHeightfield& GetHeightfield() const { return heightfield_; }
+    const Settings& GetSettings() const { return settings_; }
+    uint32_t GetDepth() const { return depth_; }
+
+private:
+    // ノードのチャンクの三角形の上の、ハイトフィールドの格子点 (x, z) での高さ
+    float GetChunkHeight(const Node& node, uint32_t x, uint32_t z) const;
+    // 外周を反時計回り (上から見て) に回ったときの k 番目の格子点 (チャンク内の頂点番号)
+    uint32_t GetRingVertex(uint32_t k) const;
+
+private:
+    TerrainHeightfield heightfield_;
+    Settings settings_;
+    uint32_t depth_ = 0;        // 葉の深さ
+    float skirtDepth_ = 0.0f;   // スカートの深さ
+    std::vector<Node> nodes_;   // 深さ順 (兄弟は連続する)
+};
@@ -0,0 +1,1075 @@
+#include "BlockCompressor.h"
+#include "Thread/ThreadUtility.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+// インデックスの選択に使う命令セット (x64 は SSE2 を必ず持つ。AVX2 はビルド設定で有効な場合のみ)
+// DirectXGame.vcxproj は AVX2 の無い CPU でも動くよう /arch:AVX2 を付けないので、ゲームに入るのは SSE2 の経路
+// AVX2 の経路はツールを -mavx2 などでビルドした場合に使われる (どの経路も結果は同じ)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BLOCK_COMPRESSOR_AVX2
+#elif defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BLOCK_COMPRESSOR_SSE2
+#endif
+
+namespace {
+
+// 1スレッドに割り当てる最小のブロック数 (これより小さい画像はスレッドを立てない)
+const uint32_t kMinBlocksPerThread = 1024;
+
+// 最小二乗法で端点を詰め直す回数
+const int kRefineIterations = 2;
+
+// BC7 の 4bit インデックスの重み (/64)
+const int kBC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+// BC7 の 2bit インデックスの重み (/64)
+const int kBC7Weights2[4] = {0, 21, 43, 64};
+
+// ブロックの 16 ピクセル (チャンネルごとに並べ、4 / 8ピクセルずつ読めるようにする)
+struct BlockPixels {
+    alignas(32) float r[16];
+    alignas(32) float g[16];
+    alignas(32) float b[16];
+    alignas(32) float a[16];
+};
+
+// 比べるパレット (RGBA)
+struct Palette {
+    float colors[16][4];
+    int count;
+    float alphaWeight; // 0 = アルファを比べない
+};
+
+// ============================================================
+// インデックスの選択 (各ピクセルに最も近いパレットの番号と、その距離の2乗)
+// ============================================================
+void FindNearest(const BlockPixels& pixels, const Palette& palette, uint8_t indices[16], float distances[16]) {
+#if defined(BLOCK_COMPRESSOR_AVX2)
+    const __m256 alphaWeight = _mm256_set1_ps(palette.alphaWeight);
+    for (int i = 0; i < 16; i += 8) {
+        const __m256 r = _mm256_load_ps(pixels.r + i);
+        const __m256 g = _mm256_load_ps(pixels.g + i);
+        const __m256 b = _mm256_load_ps(pixels.b + i);
+        const __m256 a = _mm256_load_ps(pixels.a + i);
+        __m256 best = _mm256_set1_ps(FLT_MAX);
+        __m256 bestIndex = _mm256_setzero_ps();
+        for (int k = 0; k < palette.count; ++k) {
+            const float* color = palette.colors[k];
+            const __m256 dr = _mm256_sub_ps(r, _mm256_set1_ps(color[0]));
+            const __m256 dg = _mm256_sub_ps(g, _mm256_set1_ps(color[1]));
+            const __m256 db = _mm256_sub_ps(b, _mm256_set1_ps(color[2]));
+            const __m256 da = _mm256_sub_ps(a, _mm256_set1_ps(color[3]));
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(dr, dr), _mm256_mul_ps(dg, dg));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(db, db));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(alphaWeight, _mm256_mul_ps(da, da)));
+            const __m256 isCloser = _mm256_cmp_ps(distance, best, _CMP_LT_OQ);
+            best = _mm256_min_ps(distance, best);
+            bestIndex = _mm256_blendv_ps(bestIndex, _mm256_set1_ps(static_cast<float>(k)), isCloser);
+        }
+        alignas(32) int32_t lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_cvttps_epi32(bestIndex));
+        _mm256_storeu_ps(distances + i, best);
+        for (int lane = 0; lane < 8; ++lane) {
+            indices[i + lane] = static_cast<uint8_t>(lanes[lane]);
+        }
+    }
+#elif defined(BLOCK_COMPRESSOR_SSE2)
+    const __m128 alphaWeight = _mm_set1_ps(palette.alphaWeight);
+    for (int i = 0; i < 16; i += 4) {
+        const __m128 r = _mm_load_ps(pixels.r + i);
+        const __m128 g = _mm_load_ps(pixels.g + i);
+        const __m128 b = _mm_load_ps(pixels.b + i);
+        const __m128 a = _mm_load_ps(pixels.a + i);
+        __m128 best = _mm_set1_ps(FLT_MAX);
+        __m128i bestIndex = _mm_setzero_si128();
+        for (int k = 0; k < palette.count; ++k) {
+            const float* color = palette.colors[k];
+            const __m128 dr = _mm_sub_ps(r, _mm_set1_ps(color[0]));
+            const __m128 dg = _mm_sub_ps(g, _mm_set1_ps(color[1]));
+            const __m128 db = _mm_sub_ps(b, _mm_set1_ps(color[2]));
+            const __m128 da = _mm_sub_ps(a, _mm_set1_ps(color[3]));
+            __m128 distance = _mm_add_ps(_mm_mul_ps(dr, dr), _mm_mul_ps(dg, dg));
+            distance = _mm_add_ps(distance, _mm_mul_ps(db, db));
+            distance = _mm_add_ps(distance, _mm_mul_ps(alphaWeight, _mm_mul_ps(da, da)));
+            // SSE2 には blend がないので、比較のマスクで選ぶ
+            const __m128i isCloser = _mm_castps_si128(_mm_cmplt_ps(distance, best));
+            best = _mm_min_ps(distance, best);
+            bestIndex = _mm_or_si128(_mm_and_si128(isCloser, _mm_set1_epi32(k)), _mm_andnot_si128(isCloser, bestIndex));
+        }
+        alignas(16) int32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), bestIndex);
+        _mm_storeu_ps(distances + i, best);
+        for (int lane = 0; lane < 4; ++lane) {
+            indices[i + lane] = static_cast<uint8_t>(lanes[lane]);
+        }
+    }
+#else
+    for (int i = 0; i < 16; ++i) {
+        float best = FLT_MAX;
+        int bestIndex = 0;
+        for (int k = 0; k < palette.count; ++k) {
+            const float* color = palette.colors[k];
+            const float dr = pixels.r[i] - color[0];
+            const float dg = pixels.g[i] - color[1];
+            const float db = pixels.b[i] - color[2];
+            const float da = pixels.a[i] - color[3];
+            const float distance = dr * dr + dg * dg + db * db + palette.alphaWeight * da * da;
+            if (distance < best) {
+                best = distance;
+                bestIndex = k;
+            }
+        }
+        indices[i] = static_cast<uint8_t>(bestIndex);
+        distances[i] = best;
+    }
+#endif
+}
+
+// ============================================================
+// 主成分の軸 (重み付きの平均と共分散から、べき乗法で求める)
+// ============================================================
+void ComputePrincipalAxis(const BlockPixels& pixels, const float weights[16], int channelCount, float mean[4],
+                          float axis[4]) {
+    const float* channels[4] = {pixels.r, pixels.g, pixels.b, pixels.a};
+
+    // 16 ピクセルの連続した配列の和にして、コンパイラがベクトル化できるようにする
+    float totalWeight = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        totalWeight += weights[i];
+    }
+    for (int c = 0; c < 4; ++c) {
+        mean[c] = 0.0f;
+        axis[c] = 0.0f;
+    }
+    if (totalWeight <= 0.0f) {
+        return;
+    }
+    alignas(32) float centered[4][16] = {};
+    for (int c = 0; c < channelCount; ++c) {
+        float sum = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            sum += weights[i] * channels[c][i];
+        }
+        mean[c] = sum / totalWeight;
+        for (int i = 0; i < 16; ++i) {
+            centered[c][i] = channels[c][i] - mean[c];
+        }
+    }
+
+    float covariance[4][4] = {};
+    for (int row = 0; row < channelCount; ++row) {
+        for (int column = row; column < channelCount; ++column) {
+            float sum = 0.0f;
+            for (int i = 0; i < 16; ++i) {
+                sum += weights[i] * centered[row][i] * centered[column][i];
+            }
+            covariance[row][column] = sum;
+            covariance[column][row] = sum;
+        }
+    }
+
+    // 分散の最も大きいチャンネルの行から始める
+    int largest = 0;
+    for (int c = 1; c < channelCount; ++c) {
+        if (covariance[c][c] > covariance[largest][largest]) {
+            largest = c;
+        }
+    }
+    if (covariance[largest][largest] <= 0.0f) {
+        return; // 単色
+    }
+    float vector[4] = {};
+    for (int c = 0; c < channelCount; ++c) {
+        vector[c] = covariance[largest][c];
+    }
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[4] = {};
+        for (int row = 0; row < channelCount; ++row) {
+            for (int column = 0; column < channelCount; ++column) {
+                next[row] += covariance[row][column] * vector[column];
+            }
+        }
+        float length = 0.0f;
+        for (int c = 0; c < channelCount; ++c) {
+            length += next[c] * next[c];
+        }
+        if (length <= 0.0f) {
+            break;
+        }
+        const float inverseLength = 1.0f / std::sqrt(length);
+        for (int c = 0; c < channelCount; ++c) {
+            vector[c] = next[c] * inverseLength;
+        }
+    }
+    for (int c = 0; c < channelCount; ++c) {
+        axis[c] = vector[c];
+    }
+}
+
+// 軸に射影した範囲の両端 (重みが 0 のピクセルは含めない)
+void ComputeAxisExtents(const BlockPixels& pixels, const float weights[16], int channelCount, const float mean[4],
+                        const float axis[4], float minimum[4], float maximum[4]) {
+    const float* channels[4] = {pixels.r, pixels.g, pixels.b, pixels.a};
+    float tMin = FLT_MAX;
+    float tMax = -FLT_MAX;
+    for (int i = 0; i < 16; ++i) {
+        if (weights[i] <= 0.0f) {
+            continue;
+        }
+        float t = 0.0f;
+        for (int c = 0; c < channelCount; ++c) {
+            t += (channels[c][i] - mean[c]) * axis[c];
+        }
+        tMin = std::min(tMin, t);
+        tMax = std::max(tMax, t);
+    }
+    if (tMin > tMax) {
+        tMin = tMax = 0.0f;
+    }
+    for (int c = 0; c < 4; ++c) {
+        minimum[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+        maximum[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+    }
+}
+
+/// <summary>
+/// 選んだインデックスから、誤差が最小になる端点を最小二乗法で求める
+/// </summary>
+/// <param name="fractions">各パレットの端点0から端点1への割合</param>
+/// <returns>false = 端点が1つに決まらない (すべて同じインデックス)</returns>
+bool SolveEndpoints(const BlockPixels& pixels, const float weights[16], const uint8_t indices[16],
+                    const float* fractions, int channelCount, float endpoint0[4], float endpoint1[4]) {
+    const float* channels[4] = {pixels.r, pixels.g, pixels.b, pixels.a};
+
+    // 各ピクセルの端点1の割合 (重みが 0 のピクセルは両方の係数を 0 にする)
+    alignas(32) float alpha[16];
+    alignas(32) float beta[16];
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        beta[i] = weights[i] * fractions[indices[i]];
+        alpha[i] = weights[i] - beta[i];
+        aa += alpha[i] * alpha[i];
+        bb += beta[i] * beta[i];
+        ab += alpha[i] * beta[i];
+    }
+    const float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f) {
+        return false;
+    }
+    const float inverse = 1.0f / determinant;
+    for (int c = 0; c < channelCount; ++c) {
+        float ax = 0.0f, bx = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            ax += alpha[i] * channels[c][i];
+            bx += beta[i] * channels[c][i];
+        }
+        endpoint0[c] = std::clamp((ax * bb - bx * ab) * inverse, 0.0f, 255.0f);
+        endpoint1[c] = std::clamp((bx * aa - ax * ab) * inverse, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// ============================================================
+// BC1 (色のブロック)
+// ============================================================
+
+// 色のブロックの候補 (端点 565 と各ピクセルのインデックス)
+struct ColorCandidate {
+    uint16_t color0;
+    uint16_t color1;
+    uint8_t indices[16];
+    float error;
+};
+
+uint16_t QuantizeRgb565(const float color[4]) {
+    const int r = static_cast<int>(color[0] * (31.0f / 255.0f) + 0.5f);
+    const int g = static_cast<int>(color[1] * (63.0f / 255.0f) + 0.5f);
+    const int b = static_cast<int>(color[2] * (31.0f / 255.0f) + 0.5f);
+    return static_cast<uint16_t>((std::clamp(r, 0, 31) << 11) | (std::clamp(g, 0, 63) << 5) | std::clamp(b, 0, 31));
+}
+
+void ExpandRgb565(uint16_t packed, float color[4]) {
+    const int r = (packed >> 11) & 31;
+    const int g = (packed >> 5) & 63;
+    const int b = packed & 31;
+    color[0] = static_cast<float>((r << 3) | (r >> 2));
+    color[1] = static_cast<float>((g << 2) | (g >> 4));
+    color[2] = static_cast<float>((b << 3) | (b >> 2));
+    color[3] = 0.0f;
+}
+
+// 端点の割合 (4色: 0, 1, 1/3, 2/3。3色: 0, 1, 1/2)
+const float kColorFractions4[4] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+const float kColorFractions3[3] = {0.0f, 1.0f, 0.5f};
+
+void EvaluateColor(const BlockPixels& pixels, const float weights[16], bool isThreeColor, ColorCandidate& candidate) {
+    float endpoint0[4];
+    float endpoint1[4];
+    ExpandRgb565(candidate.color0, endpoint0);
+    ExpandRgb565(candidate.color1, endpoint1);
+
+    Palette palette{};
+    palette.count = isThreeColor ? 3 : 4;
+    const float* fractions = isThreeColor ? kColorFractions3 : kColorFractions4;
+    for (int k = 0; k < palette.count; ++k) {
+        for (int c = 0; c < 3; ++c) {
+            palette.colors[k][c] = endpoint0[c] + (endpoint1[c] - endpoint0[c]) * fractions[k];
+        }
+    }
+
+    float distances[16];
+    FindNearest(pixels, palette, candidate.indices, distances);
+    candidate.error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        candidate.error += weights[i] * distances[i];
+    }
+}
+
+void EncodeColorBlock(const BlockPixels& pixels, const float weights[16], bool isThreeColor, uint8_t* output) {
+    ColorCandidate best{};
+    best.error = FLT_MAX;
+
+    float mean[4];
+    float axis[4];
+    float endpoint0[4];
+    float endpoint1[4];
+    ComputePrincipalAxis(pixels, weights, 3, mean, axis);
+    ComputeAxisExtents(pixels, weights, 3, mean, axis, endpoint0, endpoint1);
+    if (!isThreeColor) {
+        // 4色では両端の色がほとんど使われないので、範囲の 1/16 だけ内側に寄せる
+        for (int c = 0; c < 3; ++c) {
+            const float inset = (endpoint1[c] - endpoint0[c]) / 16.0f;
+            endpoint0[c] += inset;
+            endpoint1[c] -= inset;
+        }
+    }
+
+    ColorCandidate candidate{};
+    candidate.color0 = QuantizeRgb565(endpoint0);
+    candidate.color1 = QuantizeRgb565(endpoint1);
+    EvaluateColor(pixels, weights, isThreeColor, candidate);
+    best = candidate;
+
+    const float* fractions = isThreeColor ? kColorFractions3 : kColorFractions4;
+    for (int iteration = 0; iteration < kRefineIterations; ++iteration) {
+        if (!SolveEndpoints(pixels, weights, best.indices, fractions, 3, endpoint0, endpoint1)) {
+            break;
+        }
+        candidate.color0 = QuantizeRgb565(endpoint0);
+        candidate.color1 = QuantizeRgb565(endpoint1);
+        if (candidate.color0 == best.color0 && candidate.color1 == best.color1) {
+            break;
+        }
+        EvaluateColor(pixels, weights, isThreeColor, candidate);
+        if (candidate.error >= best.error) {
+            break;
+        }
+        best = candidate;
+    }
+
+    // 4色は color0 > color1、3色は color0 <= color1 で区別されるので、端点の順番を合わせる
+    uint16_t color0 = best.color0;
+    uint16_t color1 = best.color1;
+    uint8_t indices[16];
+    std::memcpy(indices, best.indices, sizeof(indices));
+    const bool needsSwap = isThreeColor ? (color0 > color1) : (color0 < color1);
+    if (needsSwap) {
+        std::swap(color0, color1);
+        for (uint8_t& index : indices) {
+            // 0 と 1 を入れ替える (4色では 2 と 3 も、3色の 2 は中間なのでそのまま)
+            static const uint8_t kSwapped4[4] = {1, 0, 3, 2};
+            static const uint8_t kSwapped3[4] = {1, 0, 2, 3};
+            index = isThreeColor ? kSwapped3[index] : kSwapped4[index];
+        }
+    }
+    if (!isThreeColor && color0 == color1) {
+        std::fill(std::begin(indices), std::end(indices), static_cast<uint8_t>(0)); // 単色 (3色として読まれる)
+    }
+    if (isThreeColor) {
+        for (int i = 0; i < 16; ++i) {
+            if (weights[i] <= 0.0f) {
+                indices[i] = 3; // 透明
+            }
+        }
+    }
+
+    uint32_t packedIndices = 0;
+    for (int i = 0; i < 16; ++i) {
+        packedIndices |= static_cast<uint32_t>(indices[i]) << (i * 2);
+    }
+    output[0] = static_cast<uint8_t>(color0 & 0xff);
+    output[1] = static_cast<uint8_t>(color0 >> 8);
+    output[2] = static_cast<uint8_t>(color1 & 0xff);
+    output[3] = static_cast<uint8_t>(color1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        output[4 + i] = static_cast<uint8_t>(packedIndices >> (i * 8));
+    }
+}
+
+void EncodeBC1(const BlockPixels& pixels, uint8_t* output) {
+    // アルファが 128 未満のピクセルがあれば、3色 + 透明で圧縮する
+    float weights[16];
+    bool hasTransparent = false;
+    bool hasOpaque = false;
+    for (int i = 0; i < 16; ++i) {
+        weights[i] = pixels.a[i] < 128.0f ? 0.0f : 1.0f;
+        hasTransparent |= weights[i] == 0.0f;
+        hasOpaque |= weights[i] != 0.0f;
+    }
+    if (!hasOpaque) {
+        // すべて透明 (color0 <= color1 の3色モードで、インデックスはすべて 3)
+        const uint8_t transparent[8] = {0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
+        std::memcpy(output, transparent, sizeof(transparent));
+        return;
+    }
+    EncodeColorBlock(pixels, weights, hasTransparent, output);
+}
+
+// ============================================================
+// BC4 (1チャンネルのブロック。BC3 のアルファと BC5 にも使う)
+// ============================================================
+
+// 端点 (endpoint0 > endpoint1 なら8段階、それ以外は6段階 + 0 + 255) のパレット
+void BuildSingleChannelPalette(int endpoint0, int endpoint1, float palette[8]) {
+    palette[0] = static_cast<float>(endpoint0);
+    palette[1] = static_cast<float>(endpoint1);
+    if (endpoint0 > endpoint1) {
+        for (int i = 1; i <= 6; ++i) {
+            palette[i + 1] = static_cast<float>((7 - i) * endpoint0 + i * endpoint1) / 7.0f;
+        }
+    } else {
+        for (int i = 1; i <= 4; ++i) {
+            palette[i + 1] = static_cast<float>((5 - i) * endpoint0 + i * endpoint1) / 5.0f;
+        }
+        palette[6] = 0.0f;
+        palette[7] = 255.0f;
+    }
+}
+
+float SelectSingleChannelIndices(const float values[16], const float palette[8], uint8_t indices[16]) {
+    float error = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float best = FLT_MAX;
+        for (int k = 0; k < 8; ++k) {
+            const float d = values[i] - palette[k];
+            if (d * d < best) {
+                best = d * d;
+                indices[i] = static_cast<uint8_t>(k);
+            }
+        }
+        error += best;
+    }
+    return error;
+}
+
+void EncodeSingleChannelBlock(const float values[16], uint8_t* output) {
+    float minimum = 255.0f, maximum = 0.0f;
+    // 6段階では 0 と 255 がパレットにあるので、それ以外の最小と最大を端点にする
+    float innerMinimum = 255.0f, innerMaximum = 0.0f;
+    bool hasExtreme = false;
+    for (int i = 0; i < 16; ++i) {
+        minimum = std::min(minimum, values[i]);
+        maximum = std::max(maximum, values[i]);
+        if (values[i] > 0.0f && values[i] < 255.0f) {
+            innerMinimum = std::min(innerMinimum, values[i]);
+            innerMaximum = std::max(innerMaximum, values[i]);
+        } else {
+            hasExtreme = true;
+        }
+    }
+
+    int endpoint0 = static_cast<int>(maximum + 0.5f);
+    int endpoint1 = static_cast<int>(minimum + 0.5f);
+    uint8_t indices[16] = {};
+    if (endpoint0 != endpoint1) {
+        // 8段階: パレットは最小から最大まで等間隔なので、最も近い段は割り算で決まる
+        // (段 0 = 端点1、段 7 = 端点0、段 1～6 はインデックス 7～2)
+        static const uint8_t kRampToIndex[8] = {1, 7, 6, 5, 4, 3, 2, 0};
+        const float scale = 7.0f / static_cast<float>(endpoint0 - endpoint1);
+        float error = 0.0f;
+        for (int i = 0; i < 16; ++i) {
+            const float position = (values[i] - static_cast<float>(endpoint1)) * scale;
+            const int step = std::clamp(static_cast<int>(position + 0.5f), 0, 7);
+            indices[i] = kRampToIndex[step];
+            const float d = values[i] - (static_cast<float>(endpoint1) + static_cast<float>(step) / scale);
+            error += d * d;
+        }
+
+        // 0 か 255 を含むブロックだけ、6段階 (0 と 255 付き) も試す
+        if (hasExtreme && innerMinimum <= innerMaximum && error > 0.0f) {
+            const int innerEndpoint0 = static_cast<int>(innerMinimum + 0.5f);
+            const int innerEndpoint1 = static_cast<int>(innerMaximum + 0.5f);
+            float palette[8];
+            uint8_t innerIndices[16];
+            BuildSingleChannelPalette(innerEndpoint0, innerEndpoint1, palette);
+            const float innerError = SelectSingleChannelIndices(values, palette, innerIndices);
+            if (innerError < error) {
+                endpoint0 = innerEndpoint0;
+                endpoint1 = innerEndpoint1;
+                std::memcpy(indices, innerIndices, sizeof(indices));
+            }
+        }
+    }
+
+    output[0] = static_cast<uint8_t>(endpoint0);
+    output[1] = static_cast<uint8_t>(endpoint1);
+    uint64_t packedIndices = 0;
+    for (int i = 0; i < 16; ++i) {
+        packedIndices |= static_cast<uint64_t>(indices[i]) << (i * 3);
+    }
+    for (int i = 0; i < 6; ++i) {
+        output[2 + i] = static_cast<uint8_t>(packedIndices >> (i * 8));
+    }
+}
+
+// ============================================================
+// BC7 (モード6。アルファが一様でないブロックはモード5も試し、誤差の小さい方を使う)
+// ============================================================
+
+// 128bit のブロックに下位ビットから詰める
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* output) : output_(output) { std::memset(output_, 0, 16); }
+    void Write(uint32_t value, int bitCount) {
+        for (int i = 0; i < bitCount; ++i, ++position_) {
+            if (value & (1u << i)) {
+                output_[position_ >> 3] |= static_cast<uint8_t>(1u << (position_ & 7));
+            }
+        }
+    }
+
+private:
+    uint8_t* output_;
+    int position_ = 0;
+};
+
+// 端点0から端点1への割合 (4bit / 2bit インデックス)
+const float kBC7Fractions4[16] = {
+    0.0f / 64, 4.0f / 64, 9.0f / 64, 13.0f / 64, 17.0f / 64, 21.0f / 64, 26.0f / 64, 30.0f / 64,
+    34.0f / 64, 38.0f / 64, 43.0f / 64, 47.0f / 64, 51.0f / 64, 55.0f / 64, 60.0f / 64, 64.0f / 64,
+};
+const float kBC7Fractions2[4] = {0.0f / 64, 21.0f / 64, 43.0f / 64, 64.0f / 64};
+
+const float kUniformWeights[16] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+
+// BC7 の補間 (端点は 8bit に展開済み)
+int InterpolateBC7(int endpoint0, int endpoint1, int weight) {
+    return (endpoint0 * (64 - weight) + endpoint1 * weight + 32) >> 6;
+}
+
+// ---- モード6 (1サブセット、RGBA の端点 7bit + Pビット、4bit インデックス) ----
+
+struct BC7Endpoint {
+    uint8_t color[4]; // 7bit
+    uint8_t pBit;
+};
+
+// Pビット 0 / 1 のうち、端点の誤差が小さい方で量子化する
+BC7Endpoint QuantizeBC7Endpoint(const float color[4]) {
+    BC7Endpoint best{};
+    float bestError = FLT_MAX;
+    for (uint8_t pBit = 0; pBit < 2; ++pBit) {
+        BC7Endpoint endpoint{};
+        endpoint.pBit = pBit;
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c) {
+            const int quantized = std::clamp(static_cast<int>((color[c] - pBit) * 0.5f + 0.5f), 0, 127);
+            endpoint.color[c] = static_cast<uint8_t>(quantized);
+            const float d = static_cast<float>((quantized << 1) | pBit) - color[c];
+            error += d * d;
+        }
+        if (error < bestError) {
+            bestError = error;
+            best = endpoint;
+        }
+    }
+    return best;
+}
+
+struct BC7Mode6Candidate {
+    BC7Endpoint endpoints[2];
+    uint8_t indices[16];
+    float error;
+};
+
+void EvaluateBC7Mode6(const BlockPixels& pixels, BC7Mode6Candidate& candidate) {
+    Palette palette{};
+    palette.count = 16;
+    palette.alphaWeight = 1.0f;
+    for (int k = 0; k < 16; ++k) {
+        for (int c = 0; c < 4; ++c) {
+            const int e0 = (candidate.endpoints[0].color[c] << 1) | candidate.endpoints[0].pBit;
+            const int e1 = (candidate.endpoints[1].color[c] << 1) | candidate.endpoints[1].pBit;
+            palette.colors[k][c] = static_cast<float>(InterpolateBC7(e0, e1, kBC7Weights4[k]));
+        }
+    }
+
+    float distances[16];
+    FindNearest(pixels, palette, candidate.indices, distances);
+    candidate.error = 0.0f;
+    for (float distance : distances) {
+        candidate.error += distance;
+    }
+}
+
+BC7Mode6Candidate EncodeBC7Mode6(const BlockPixels& pixels) {
+    float mean[4];
+    float axis[4];
+    float endpoint0[4];
+    float endpoint1[4];
+    ComputePrincipalAxis(pixels, kUniformWeights, 4, mean, axis);
+    ComputeAxisExtents(pixels, kUniformWeights, 4, mean, axis, endpoint0, endpoint1);
+
+    BC7Mode6Candidate best{};
+    best.endpoints[0] = QuantizeBC7Endpoint(endpoint0);
+    best.endpoints[1] = QuantizeBC7Endpoint(endpoint1);
+    EvaluateBC7Mode6(pixels, best);
+
+    for (int iteration = 0; iteration < kRefineIterations && best.error > 0.0f; ++iteration) {
+        if (!SolveEndpoints(pixels, kUniformWeights, best.indices, kBC7Fractions4, 4, endpoint0, endpoint1)) {
+            break;
+        }
+        BC7Mode6Candidate candidate{};
+        candidate.endpoints[0] = QuantizeBC7Endpoint(endpoint0);
+        candidate.endpoints[1] = QuantizeBC7Endpoint(endpoint1);
+        EvaluateBC7Mode6(pixels, candidate);
+        if (candidate.error >= best.error) {
+            break;
+        }
+        best = candidate;
+    }
+    return best;
+}
+
+void WriteBC7Mode6(BC7Mode6Candidate candidate, uint8_t* output) {
+    // 先頭ピクセルのインデックスは最上位ビットを省くので 0～7 でなければならない (端点を入れ替えて反転する)
+    if (candidate.indices[0] >= 8) {
+        std::swap(candidate.endpoints[0], candidate.endpoints[1]);
+        for (uint8_t& index : candidate.indices) {
+            index = static_cast<uint8_t>(15 - index);
+        }
+    }
+
+    BitWriter writer(output);
+    writer.Write(1u << 6, 7); // モード6
+    for (int c = 0; c < 4; ++c) {
+        writer.Write(candidate.endpoints[0].color[c], 7);
+        writer.Write(candidate.endpoints[1].color[c], 7);
+    }
+    writer.Write(candidate.endpoints[0].pBit, 1);
+    writer.Write(candidate.endpoints[1].pBit, 1);
+    writer.Write(candidate.indices[0], 3);
+    for (int i = 1; i < 16; ++i) {
+        writer.Write(candidate.indices[i], 4);
+    }
+}
+
+// ---- モード5 (RGB の端点 7bit とアルファの端点 8bit を別々に持ち、それぞれ 2bit インデックス) ----
+// 透明と不透明が混ざったブロックなど、色とアルファが1本の直線に乗らない場合に使う
+
+struct BC7Mode5Candidate {
+    uint8_t colors[2][3]; // 7bit
+    uint8_t alphas[2];
+    uint8_t colorIndices[16];
+    uint8_t alphaIndices[16];
+    float colorError;
+    float alphaError;
+};
+
+uint8_t QuantizeBC7Color7(float value) {
+    return static_cast<uint8_t>(std::clamp(static_cast<int>(value * (127.0f / 255.0f) + 0.5f), 0, 127));
+}
+
+int ExpandBC7Color7(uint8_t value) { return (value << 1) | (value >> 6); }
+
+void EvaluateBC7Mode5Color(const BlockPixels& pixels, BC7Mode5Candidate& candidate) {
+    Palette palette{};
+    palette.count = 4;
+    palette.alphaWeight = 0.0f;
+    for (int k = 0; k < 4; ++k) {
+        for (int c = 0; c < 3; ++c) {
+            palette.colors[k][c] = static_cast<float>(InterpolateBC7(
+                ExpandBC7Color7(candidate.colors[0][c]), ExpandBC7Color7(candidate.colors[1][c]),
+                kBC7Weights2[k]));
+        }
+    }
+
+    float distances[16];
+    FindNearest(pixels, palette, candidate.colorIndices, distances);
+    candidate.colorError = 0.0f;
+    for (float distance : distances) {
+        candidate.colorError += distance;
+    }
+}
+
+BC7Mode5Candidate EncodeBC7Mode5(const BlockPixels& pixels) {
+    BC7Mode5Candidate best{};
+
+    // 色 (BC1 と同じく主成分の軸から始めて、最小二乗法で詰め直す)
+    float mean[4];
+    float axis[4];
+    float endpoint0[4];
+    float endpoint1[4];
+    ComputePrincipalAxis(pixels, kUniformWeights, 3, mean, axis);
+    ComputeAxisExtents(pixels, kUniformWeights, 3, mean, axis, endpoint0, endpoint1);
+    for (int c = 0; c < 3; ++c) {
+        best.colors[0][c] = QuantizeBC7Color7(endpoint0[c]);
+        best.colors[1][c] = QuantizeBC7Color7(endpoint1[c]);
+    }
+    EvaluateBC7Mode5Color(pixels, best);
+    for (int iteration = 0; iteration < kRefineIterations && best.colorError > 0.0f; ++iteration) {
+        if (!SolveEndpoints(pixels, kUniformWeights, best.colorIndices, kBC7Fractions2, 3, endpoint0, endpoint1)) {
+            break;
+        }
+        BC7Mode5Candidate candidate = best;
+        for (int c = 0; c < 3; ++c) {
+            candidate.colors[0][c] = QuantizeBC7Color7(endpoint0[c]);
+            candidate.colors[1][c] = QuantizeBC7Color7(endpoint1[c]);
+        }
+        EvaluateBC7Mode5Color(pixels, candidate);
+        if (candidate.colorError >= best.colorError) {
+            break;
+        }
+        best = candidate;
+    }
+
+    // アルファ (最小と最大を端点にする)
+    float minimum = 255.0f, maximum = 0.0f;
+    for (float alpha : pixels.a) {
+        minimum = std::min(minimum, alpha);
+        maximum = std::max(maximum, alpha);
+    }
+    best.alphas[0] = static_cast<uint8_t>(minimum + 0.5f);
+    best.alphas[1] = static_cast<uint8_t>(maximum + 0.5f);
+    float levels[4];
+    for (int k = 0; k < 4; ++k) {
+        levels[k] = static_cast<float>(
+            InterpolateBC7(best.alphas[0], best.alphas[1], kBC7Weights2[k]));
+    }
+    best.alphaError = 0.0f;
+    for (int i = 0; i < 16; ++i) {
+        float bestDistance = FLT_MAX;
+        for (int k = 0; k < 4; ++k) {
+            const float d = pixels.a[i] - levels[k];
+            if (d * d < bestDistance) {
+                bestDistance = d * d;
+                best.alphaIndices[i] = static_cast<uint8_t>(k);
+            }
+        }
+        best.alphaError += bestDistance;
+    }
+    return best;
+}
+
+void WriteBC7Mode5(BC7Mode5Candidate candidate, uint8_t* output) {
+    // 先頭ピクセルのインデックスは最上位ビットを省くので 0～1 でなければならない (色とアルファで別々に反転する)
+    if (candidate.colorIndices[0] >= 2) {
+        std::swap(candidate.colors[0], candidate.colors[1]);
+        for (uint8_t& index : candidate.colorIndices) {
+            index = static_cast<uint8_t>(3 - index);
+        }
+    }
+    if (candidate.alphaIndices[0] >= 2) {
+        std::swap(candidate.alphas[0], candidate.alphas[1]);
+        for (uint8_t& index : candidate.alphaIndices) {
+            index = static_cast<uint8_t>(3 - index);
+        }
+    }
+
+    BitWriter writer(output);
+    writer.Write(1u << 5, 6); // モード5
+    writer.Write(0, 2);       // チャンネルの入れ替えなし
+    for (int c = 0; c < 3; ++c) {
+        writer.Write(candidate.colors[0][c], 7);
+        writer.Write(candidate.colors[1][c], 7);
+    }
+    writer.Write(candidate.alphas[0], 8);
+    writer.Write(candidate.alphas[1], 8);
+    writer.Write(candidate.colorIndices[0], 1);
+    for (int i = 1; i < 16; ++i) {
+        writer.Write(candidate.colorIndices[i], 2);
+    }
+    writer.Write(candidate.alphaIndices[0], 1);
+    for (int i = 1; i < 16; ++i) {
+        writer.Write(candidate.alphaIndices[i], 2);
+    }
+}
+
+void EncodeBC7(const BlockPixels& pixels, uint8_t* output) {
+    const BC7Mode6Candidate mode6 = EncodeBC7Mode6(pixels);
+
+    bool isAlphaUniform = true;
+    for (float alpha : pixels.a) {
+        isAlphaUniform &= alpha == pixels.a[0];
+    }
+    if (!isAlphaUniform && mode6.error > 0.0f) {
+        const BC7Mode5Candidate mode5 = EncodeBC7Mode5(pixels);
+        if (mode5.colorError + mode5.alphaError < mode6.error) {
+            WriteBC7Mode5(mode5, output);
+            return;
+        }
+    }
+    WriteBC7Mode6(mode6, output);
+}
+
+// ============================================================
+// DDS のヘッダー
+// ============================================================
+struct DdsPixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask;
+    uint32_t gBitMask;
+    uint32_t bBitMask;
+    uint32_t aBitMask;
+};
+
+struct DdsHeader {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];
+    DdsPixelFormat pixelFormat;
+    uint32_t caps;
+    uint32_t caps2;
+    uint32_t caps3;
+    uint32_t caps4;
+    uint32_t reserved2;
+};
+
+struct DdsHeaderDxt10 {
+    uint32_t dxgiFormat;
+    uint32_t resourceDimension;
+    uint32_t miscFlag;
+    uint32_t arraySize;
+    uint32_t miscFlags2;
+};
+
+static_assert(sizeof(DdsHeader) == 124, "DDS_HEADER は 124 バイト");
+static_assert(sizeof(DdsHeaderDxt10) == 20, "DDS_HEADER_DXT10 は 20 バイト");
+
+const uint32_t kDdsMagic = 0x20534444; // "DDS "
+const uint32_t kDdsFourCCDx10 = 0x30315844; // "DX10"
+const uint32_t kDdsHeaderFlags = 0x1 | 0x2 | 0x4 | 0x1000; // CAPS | HEIGHT | WIDTH | PIXELFORMAT
+const uint32_t kDdsHeaderFlagPitch = 0x8;
+const uint32_t kDdsHeaderFlagLinearSize = 0x80000;
+const uint32_t kDdsHeaderFlagMipMapCount = 0x20000;
+const uint32_t kDdsPixelFormatFourCC = 0x4;
+const uint32_t kDdsCapsTexture = 0x1000;
+const uint32_t kDdsCapsComplexMipMap = 0x8 | 0x400000;
+const uint32_t kResourceDimensionTexture2D = 3;
+const uint32_t kDxgiFormatRgba8 = 28;     // DXGI_FORMAT_R8G8B8A8_UNORM
+const uint32_t kDxgiFormatRgba8Srgb = 29; // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+
+// DDS (DX10 ヘッダー付き) を書き出す (一時ファイルに書いてから置き換える)
+bool WriteDDS(const std::string& path, uint32_t dxgiFormat, bool isCompressed, uint32_t width, uint32_t height,
+              std::span<const std::vector<uint8_t>> mipLevels) {
+    if (mipLevels.empty() || width == 0 || height == 0) {
+        return false;
+    }
+
+    DdsHeader header{};
+    header.size = sizeof(DdsHeader);
+    // 圧縮したものは最上位のミップ全体、していないものは1行のバイト数
+    header.flags = kDdsHeaderFlags | (isCompressed ? kDdsHeaderFlagLinearSize : kDdsHeaderFlagPitch) |
+                   (mipLevels.size() > 1 ? kDdsHeaderFlagMipMapCount : 0);
+    header.height = height;
+    header.width = width;
+    header.pitchOrLinearSize = static_cast<uint32_t>(isCompressed ? mipLevels[0].size() : mipLevels[0].size() / height);
+    header.mipMapCount = static_cast<uint32_t>(mipLevels.size());
+    header.pixelFormat.size = sizeof(DdsPixelFormat);
+    header.pixelFormat.flags = kDdsPixelFormatFourCC;
+    header.pixelFormat.fourCC = kDdsFourCCDx10;
+    header.caps = kDdsCapsTexture | (mipLevels.size() > 1 ? kDdsCapsComplexMipMap : 0);
+
+    DdsHeaderDxt10 headerDxt10{};
+    headerDxt10.dxgiFormat = dxgiFormat;
+    headerDxt10.resourceDimension = kResourceDimensionTexture2D;
+    headerDxt10.arraySize = 1;
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+    // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&kDdsMagic), sizeof(kDdsMagic));
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(&headerDxt10), sizeof(headerDxt10));
+        for (const std::vector<uint8_t>& level : mipLevels) {
+            file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+        }
+        if (!file) {
+            file.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+namespace BlockCompressor {
+
+uint32_t GetBlockSize(Format format) { return (format == Format::BC1 || format == Format::BC4) ? 8 : 16; }
+
+size_t GetRowPitch(Format format, uint32_t width) {
+    return static_cast<size_t>(std::max(1u, (width + 3) / 4)) * GetBlockSize(format);
+}
+
+size_t GetSizeInBytes(Format format, uint32_t width, uint32_t height) {
+    return GetRowPitch(format, width) * std::max(1u, (height + 3) / 4);
+}
+
+uint32_t GetDxgiFormat(Format format, bool isSRGB) {
+    switch (format) {
+    case Format::BC1:
+        return isSRGB ? 72 : 71; // DXGI_FORMAT_BC1_UNORM(_SRGB)
+    case Format::BC3:
+        return isSRGB ? 78 : 77; // DXGI_FORMAT_BC3_UNORM(_SRGB)
+    case Format::BC4:
+        return 80; // DXGI_FORMAT_BC4_UNORM
+    case Format::BC5:
+        return 83; // DXGI_FORMAT_BC5_UNORM
+    case Format::BC7:
+        return isSRGB ? 99 : 98; // DXGI_FORMAT_BC7_UNORM(_SRGB)
+    default:
+        return 0;
+    }
+}
+
+void CompressBlock(Format format, const uint8_t rgba[64], uint8_t* output) {
+    BlockPixels pixels;
+    for (int i = 0; i < 16; ++i) {
+        pixels.r[i] = rgba[i * 4 + 0];
+        pixels.g[i] = rgba[i * 4 + 1];
+        pixels.b[i] = rgba[i * 4 + 2];
+        pixels.a[i] = rgba[i * 4 + 3];
+    }
+
+    switch (format) {
+    case Format::BC1:
+        EncodeBC1(pixels, output);
+        break;
+    case Format::BC3: {
+        static const float kOpaqueWeights[16] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+        EncodeSingleChannelBlock(pixels.a, output);
+        EncodeColorBlock(pixels, kOpaqueWeights, false, output + 8);
+        break;
+    }
+    case Format::BC4:
+        EncodeSingleChannelBlock(pixels.r, output);
+        break;
+    case Format::BC5:
+        EncodeSingleChannelBlock(pixels.r, output);
+        EncodeSingleChannelBlock(pixels.g, output + 8);
+        break;
+    case Format::BC7:
+        EncodeBC7(pixels, output);
+        break;
+    }
+}
+
+void Compress(const SourceImage& image, Format format, uint8_t* output, size_t outputRowPitch,
+              uint32_t threadCount) {
+    const uint32_t blocksX = std::max(1u, (image.width + 3) / 4);
+    const uint32_t blocksY = std::max(1u, (image.height + 3) / 4);
+    const uint32_t blockSize = GetBlockSize(format);
+    if (outputRowPitch == 0) {
+        outputRowPitch = GetRowPitch(format, image.width);
+    }
+
+    // ブロックの行を1つずつ取り合う (行ごとの処理時間の偏りをならす)
+    std::atomic<uint32_t> nextRow{0};
+    auto compressRows = [&]() {
+        uint8_t block[64];
+        for (uint32_t blockY = nextRow++; blockY < blocksY; blockY = nextRow++) {
+            uint8_t* destination = output + blockY * outputRowPitch;
+            for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+                // 画像の外は端のピクセルを繰り返す
+                for (uint32_t y = 0; y < 4; ++y) {
+                    const uint32_t sourceY = std::min(blockY * 4 + y, image.height - 1);
+                    const uint8_t* row = image.pixels + sourceY * image.rowPitch;
+                    for (uint32_t x = 0; x < 4; ++x) {
+                        const uint32_t sourceX = std::min(blockX * 4 + x, image.width - 1);
+                        std::memcpy(block + (y * 4 + x) * 4, row + sourceX * 4, 4);
+                    }
+                }
+                CompressBlock(format, block, destination + blockX * blockSize);
+            }
+        }
+    };
+
+    if (threadCount == 0) {
+        // ワーカースレッド (テクスチャの非同期読み込みなど) の上ではスレッドを立てない
+        threadCount = ThreadUtility::GetParallelThreadCount();
+    }
+    threadCount = std::min({threadCount, std::max(1u, blocksX * blocksY / kMinBlocksPerThread), blocksY});
+    if (threadCount <= 1) {
+        compressRows();
+        return;
+    }
+
+    // 呼び出し元のスレッドも1本として使う
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(compressRows);
+    }
+    compressRows();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+bool SaveDDS(const std::string& path, Format format, bool isSRGB, uint32_t width, uint32_t height,
+             std::span<const std::vector<uint8_t>> mipLevels) {
+    for (size_t level = 0; level < mipLevels.size(); ++level) {
+        const uint32_t levelWidth = std::max(1u, width >> level);
+        const uint32_t levelHeight = std::max(1u, height >> level);
+        if (mipLevels[level].size() != GetSizeInBytes(format, levelWidth, levelHeight)) {
+            return false;
+        }
+    }
+    return WriteDDS(path, GetDxgiFormat(format, isSRGB), true, width, height, mipLevels);
+}
+
+bool SaveRgba8DDS(const std::string& path, bool isSRGB, uint32_t width, uint32_t height,
+                  std::span<const std::vector<uint8_t>> mipLevels) {
+    for (size_t level = 0; level < mipLevels.size(); ++level) {
+        const size_t levelWidth = std::max(1u, width >> level);
+        const size_t levelHeight = std::max(1u, height >> level);
+        if (mipLevels[level].size() != levelWidth * levelHeight * 4) {
+            return false;
+        }
+    }
+    return WriteDDS(path, isSRGB ? kDxgiFormatRgba8Srgb : kDxgiFormatRgba8, false, width, height, mipLevels);
+}
+
+} // namespace BlockCompressor
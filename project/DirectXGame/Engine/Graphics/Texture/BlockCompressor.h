@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+// ============================================================
+// BlockCompressor — RGBA8 画像のブロック圧縮 (BC1/BC3/BC4/BC5/BC7)
+//   ・BC1/BC3 の色は主成分の軸の両端を端点にし、選んだインデックスから最小二乗法で端点を詰め直す
+//   ・BC4/BC5 は最小・最大を端点にし、8段階と6段階 (0 と 255 付き) の誤差の小さい方を選ぶ
+//   ・BC7 はモード6 (RGBA の端点 + 4bit インデックス) と、アルファが一様でないブロックだけモード5 (色とアルファを別々に) を使う
+//   ・インデックスの選択は SSE2 / AVX2 で4 / 8ピクセルずつ計算し、ブロックの行をスレッドに分ける
+//     (ゲームのビルドは SSE2 のみ。AVX2 は __AVX2__ が定義されるビルド設定の場合だけ使う)
+// Windows や DirectXTex に依存しないので、Linux のビルドファームでも DDS まで書き出せる
+// ============================================================
+namespace BlockCompressor {
+
+// 圧縮の形式
+enum class Format : uint32_t {
+    BC1, // RGB + 1bit アルファ (アルファが 128 未満のピクセルは透明になる)
+    BC3, // RGBA (アルファは BC4 と同じ方式)
+    BC4, // R のみ
+    BC5, // RG のみ (法線マップなど)
+    BC7, // RGBA (モード5 / 6 のみ)
+};
+
+// 圧縮する RGBA8 の画像 (ミップ1段)
+struct SourceImage {
+    const uint8_t* pixels = nullptr;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t rowPitch = 0; // 1行のバイト数
+};
+
+// 4x4 ブロック1つのバイト数 (BC1/BC4 = 8、それ以外 = 16)
+uint32_t GetBlockSize(Format format);
+// 圧縮後のブロック1列のバイト数
+size_t GetRowPitch(Format format, uint32_t width);
+// 圧縮後の全体のバイト数
+size_t GetSizeInBytes(Format format, uint32_t width, uint32_t height);
+// DXGI_FORMAT の値 (D3D のヘッダーに依存しないよう数値で返す。BC4/BC5 に sRGB はない)
+uint32_t GetDxgiFormat(Format format, bool isSRGB);
+
+/// <summary>
+/// 4x4 ブロック1つを圧縮する
+/// </summary>
+/// <param name="format">圧縮の形式</param>
+/// <param name="rgba">ピクセル順に 16 × RGBA</param>
+/// <param name="output">出力先 (GetBlockSize バイト)</param>
+void CompressBlock(Format format, const uint8_t rgba[64], uint8_t* output);
+
+/// <summary>
+/// 画像を圧縮する (幅・高さが4の倍数でない場合、端のブロックは端のピクセルを繰り返して埋める)
+/// </summary>
+/// <param name="image">圧縮する画像</param>
+/// <param name="format">圧縮の形式</param>
+/// <param name="output">出力先</param>
+/// <param name="outputRowPitch">出力のブロック1列のバイト数 (0 = GetRowPitch)</param>
+/// <param name="threadCount">スレッド数 (0 = 全コア。ワーカースレッドの上と小さい画像ではスレッドを立てない)</param>
+void Compress(const SourceImage& image, Format format, uint8_t* output, size_t outputRowPitch = 0,
+              uint32_t threadCount = 0);
+
+/// <summary>
+/// 圧縮済みのミップマップを DDS (DX10 ヘッダー付き) で書き出す (一時ファイルに書いてから置き換える)
+/// TextureManager (DirectXTex の LoadFromDDSFile) でそのまま読める
+/// </summary>
+/// <param name="mipLevels">各ミップの圧縮データ (大きい順。サイズは GetSizeInBytes と一致すること)</param>
+/// <returns>true = 成功</returns>
+bool SaveDDS(const std::string& path, Format format, bool isSRGB, uint32_t width, uint32_t height,
+             std::span<const std::vector<uint8_t>> mipLevels);
+
+/// <summary>
+/// 圧縮していない R8G8B8A8 のミップマップを DDS で書き出す (圧縮できない大きさの画像や、圧縮しない設定用)
+/// </summary>
+/// <param name="mipLevels">各ミップのピクセル (大きい順。行の間に詰め物なし)</param>
+/// <returns>true = 成功</returns>
+bool SaveRgba8DDS(const std::string& path, bool isSRGB, uint32_t width, uint32_t height,
+                  std::span<const std::vector<uint8_t>> mipLevels);
+
+} // namespace BlockCompressor
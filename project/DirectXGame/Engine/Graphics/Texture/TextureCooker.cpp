@@ -0,0 +1,264 @@
+#include "TextureCooker.h"
+#include "BlockCompressor.h"
+#include "File/MappedFile.h"
+#include "Hash/HashUtility.h"
+#include "String/StringUtility.h"
+#include "Thread/ThreadUtility.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <format>
+
+using namespace HashUtility;
+#ifdef _WIN32
+using namespace StringUtility;
+#endif
+
+namespace {
+
+// キャッシュの置き場所 (実行時のカレントディレクトリから)
+const char* const kCacheDirectory = "Resources/Cache/Textures";
+
+#ifdef _WIN32
+// 圧縮後の形式 (sRGB の画像は sRGB のまま)
+DXGI_FORMAT GetCompressedFormat(TextureCooker::Compression compression, bool isSRGB) {
+    switch (compression) {
+    case TextureCooker::Compression::BC1:
+        return isSRGB ? DXGI_FORMAT_BC1_UNORM_SRGB : DXGI_FORMAT_BC1_UNORM;
+    case TextureCooker::Compression::BC3:
+        return isSRGB ? DXGI_FORMAT_BC3_UNORM_SRGB : DXGI_FORMAT_BC3_UNORM;
+    case TextureCooker::Compression::BC7:
+        return isSRGB ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+    case TextureCooker::Compression::BC4:
+        return DXGI_FORMAT_BC4_UNORM;
+    case TextureCooker::Compression::BC5:
+        return DXGI_FORMAT_BC5_UNORM;
+    default:
+        return DXGI_FORMAT_UNKNOWN;
+    }
+}
+#endif
+
+// BlockCompressor の形式
+BlockCompressor::Format GetBlockCompressorFormat(TextureCooker::Compression compression) {
+    switch (compression) {
+    case TextureCooker::Compression::BC1:
+        return BlockCompressor::Format::BC1;
+    case TextureCooker::Compression::BC3:
+        return BlockCompressor::Format::BC3;
+    case TextureCooker::Compression::BC4:
+        return BlockCompressor::Format::BC4;
+    case TextureCooker::Compression::BC5:
+        return BlockCompressor::Format::BC5;
+    default:
+        return BlockCompressor::Format::BC7;
+    }
+}
+
+// sRGB の値 (0～255) から線形の値 (0～1) への変換表
+const float* GetSrgbToLinearTable() {
+    static const auto table = [] {
+        std::array<float, 256> values{};
+        for (size_t i = 0; i < values.size(); ++i) {
+            const float srgb = static_cast<float>(i) / 255.0f;
+            values[i] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+        }
+        return values;
+    }();
+    return table.data();
+}
+
+// 線形の値 (0～1) から sRGB の値 (0～255) へ
+uint8_t LinearToSrgb(float linear) {
+    linear = std::clamp(linear, 0.0f, 1.0f);
+    const float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+    return static_cast<uint8_t>(srgb * 255.0f + 0.5f);
+}
+
+// 1段小さいミップを作る (2x2 の平均。奇数の大きさの端は端のピクセルを繰り返す)
+TextureCooker::RgbaImage Downsample(const TextureCooker::RgbaImage& source) {
+    const float* toLinear = GetSrgbToLinearTable();
+    TextureCooker::RgbaImage destination;
+    destination.width = std::max(1u, source.width / 2);
+    destination.height = std::max(1u, source.height / 2);
+    destination.pixels.resize(static_cast<size_t>(destination.width) * destination.height * 4);
+    for (uint32_t y = 0; y < destination.height; ++y) {
+        const uint32_t sourceY[2] = {std::min(y * 2, source.height - 1), std::min(y * 2 + 1, source.height - 1)};
+        for (uint32_t x = 0; x < destination.width; ++x) {
+            const uint32_t sourceX[2] = {std::min(x * 2, source.width - 1), std::min(x * 2 + 1, source.width - 1)};
+            float sum[4] = {};
+            for (uint32_t sy : sourceY) {
+                for (uint32_t sx : sourceX) {
+                    const uint8_t* pixel = &source.pixels[(static_cast<size_t>(sy) * source.width + sx) * 4];
+                    sum[0] += toLinear[pixel[0]];
+                    sum[1] += toLinear[pixel[1]];
+                    sum[2] += toLinear[pixel[2]];
+                    sum[3] += pixel[3];
+                }
+            }
+            uint8_t* pixel = &destination.pixels[(static_cast<size_t>(y) * destination.width + x) * 4];
+            pixel[0] = LinearToSrgb(sum[0] * 0.25f);
+            pixel[1] = LinearToSrgb(sum[1] * 0.25f);
+            pixel[2] = LinearToSrgb(sum[2] * 0.25f);
+            pixel[3] = static_cast<uint8_t>(sum[3] * 0.25f + 0.5f);
+        }
+    }
+    return destination;
+}
+
+#ifdef _WIN32
+// R8G8B8A8 の画像を BlockCompressor で圧縮する (ミップ・配列の並びは元の画像と同じ)
+HRESULT CompressWithBlockCompressor(DirectX::ScratchImage& mipImages, TextureCooker::Compression compression) {
+    DirectX::TexMetadata metadata = mipImages.GetMetadata();
+    metadata.format = GetCompressedFormat(compression, DirectX::IsSRGB(metadata.format));
+
+    DirectX::ScratchImage compressed{};
+    const HRESULT hr = compressed.Initialize(metadata);
+    if (FAILED(hr)) {
+        return hr;
+    }
+    const BlockCompressor::Format format = GetBlockCompressorFormat(compression);
+    for (size_t i = 0; i < mipImages.GetImageCount(); ++i) {
+        const DirectX::Image& source = mipImages.GetImages()[i];
+        const DirectX::Image& destination = compressed.GetImages()[i];
+        BlockCompressor::Compress({source.pixels, static_cast<uint32_t>(source.width),
+                                   static_cast<uint32_t>(source.height), source.rowPitch},
+                                  format, destination.pixels, destination.rowPitch);
+    }
+    mipImages = std::move(compressed);
+    return S_OK;
+}
+#endif
+
+} // namespace
+
+namespace TextureCooker {
+
+uint64_t ComputeKey(const std::string& sourcePath, const Settings& settings) {
+    // 元ファイルはコピーせずにマップしてハッシュする
+    MappedFile source;
+    if (!source.Open(sourcePath)) {
+        return 0;
+    }
+
+    uint64_t hash = HashValue(kVersion);
+    hash = HashValue(static_cast<uint32_t>(settings.compression), hash);
+    hash = HashValue(settings.isQuickBC7, hash);
+    hash = HashBytes(sourcePath.data(), sourcePath.size(), hash);
+    hash = HashBytes(source.GetData(), source.GetSize(), hash);
+    return hash != 0 ? hash : 1; // 0 は「キーなし」として予約
+}
+
+std::string GetCachePath(uint64_t key) { return std::format("{}/{:016x}.dds", kCacheDirectory, key); }
+
+std::vector<RgbaImage> GenerateMipMaps(const RgbaImage& image, uint32_t mipLevels) {
+    std::vector<RgbaImage> mipImages{image};
+    while (mipImages.size() < mipLevels && (mipImages.back().width > 1 || mipImages.back().height > 1)) {
+        mipImages.push_back(Downsample(mipImages.back()));
+    }
+    return mipImages;
+}
+
+bool CookImage(const RgbaImage& image, const Settings& settings, const std::string& cachePath) {
+    if (image.width == 0 || image.height == 0 ||
+        image.pixels.size() != static_cast<size_t>(image.width) * image.height * 4) {
+        return false;
+    }
+    // BC7 の全モードの探索は DirectXTex でしかできない
+    if (settings.compression == Compression::BC7 && !settings.isQuickBC7) {
+        return false;
+    }
+
+    // 色は sRGB として扱う (ゲームの読み込み (WIC_FLAGS_FORCE_SRGB) と同じ)
+    std::vector<RgbaImage> mipImages = GenerateMipMaps(image);
+    std::vector<std::vector<uint8_t>> levels;
+    levels.reserve(mipImages.size());
+
+    // BC のテクスチャは最上位のミップの幅と高さが4の倍数でないと作れない
+    if (settings.compression == Compression::None || image.width % 4 != 0 || image.height % 4 != 0) {
+        for (RgbaImage& mipImage : mipImages) {
+            levels.push_back(std::move(mipImage.pixels));
+        }
+        return BlockCompressor::SaveRgba8DDS(cachePath, true, image.width, image.height, levels);
+    }
+
+    const BlockCompressor::Format format = GetBlockCompressorFormat(settings.compression);
+    for (const RgbaImage& mipImage : mipImages) {
+        std::vector<uint8_t>& level = levels.emplace_back(
+            BlockCompressor::GetSizeInBytes(format, mipImage.width, mipImage.height));
+        BlockCompressor::Compress({mipImage.pixels.data(), mipImage.width, mipImage.height, mipImage.width * 4u}, format,
+                                  level.data());
+    }
+    return BlockCompressor::SaveDDS(cachePath, format, true, image.width, image.height, levels);
+}
+
+#ifdef _WIN32
+
+HRESULT Compress(DirectX::ScratchImage& mipImages, const Settings& settings) {
+    const DirectX::TexMetadata& metadata = mipImages.GetMetadata();
+    if (settings.compression == Compression::None || DirectX::IsCompressed(metadata.format)) {
+        return S_OK;
+    }
+    // BC のテクスチャは最上位のミップの幅と高さが4の倍数でないと作れない
+    if (metadata.width % 4 != 0 || metadata.height % 4 != 0) {
+        return S_OK;
+    }
+
+    // R8G8B8A8 は BlockCompressor で圧縮する (BC7 の全モードの探索とそれ以外の形式は DirectXTex)
+    const bool isRgba8 = metadata.format == DXGI_FORMAT_R8G8B8A8_UNORM ||
+                         metadata.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+    if (isRgba8 && (settings.compression != Compression::BC7 || settings.isQuickBC7)) {
+        return CompressWithBlockCompressor(mipImages, settings.compression);
+    }
+
+    // ワーカースレッド (非同期読み込み) の上では DirectXTex にもスレッドを立てさせない
+    DirectX::TEX_COMPRESS_FLAGS flags =
+        ThreadUtility::IsWorkerThread() ? DirectX::TEX_COMPRESS_DEFAULT : DirectX::TEX_COMPRESS_PARALLEL;
+    if (DirectX::IsSRGB(metadata.format)) {
+        flags |= DirectX::TEX_COMPRESS_SRGB;
+    }
+
+    DirectX::ScratchImage compressed{};
+    const HRESULT hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), metadata,
+                                         GetCompressedFormat(settings.compression, DirectX::IsSRGB(metadata.format)),
+                                         flags, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+    if (SUCCEEDED(hr)) {
+        mipImages = std::move(compressed);
+    }
+    return hr;
+}
+
+bool Save(const std::string& cachePath, const DirectX::ScratchImage& mipImages) {
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(cachePath).parent_path(), ec);
+
+    // 書き込み途中のファイルを読まないよう、一時ファイルに書いてから置き換える
+    const std::string tempPath = cachePath + ".tmp";
+    const HRESULT hr = DirectX::SaveToDDSFile(mipImages.GetImages(), mipImages.GetImageCount(), mipImages.GetMetadata(),
+                                              DirectX::DDS_FLAGS_NONE, ConvertString(tempPath).c_str());
+    if (FAILED(hr)) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool Load(const std::string& cachePath, DirectX::ScratchImage& mipImages) {
+    std::error_code ec;
+    if (!std::filesystem::exists(cachePath, ec)) {
+        return false;
+    }
+    return SUCCEEDED(DirectX::LoadFromDDSFile(ConvertString(cachePath).c_str(), DirectX::DDS_FLAGS_NONE, nullptr,
+                                              mipImages));
+}
+#endif
+
+} // namespace TextureCooker
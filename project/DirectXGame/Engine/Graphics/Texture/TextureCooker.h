@@ -0,0 +1,104 @@
+#pragma once
+
+#ifdef _WIN32
+#include "externals/DirectXTex/DirectXTex.h"
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================
+// TextureCooker — テクスチャのキャッシュ (ミップマップ済み・ブロック圧縮済みの DDS)
+// 初回に元画像をデコードしてミップマップを作り、設定に応じて圧縮した結果を DDS で書き出す
+// 2回目以降は、元ファイルの内容から求めたキーのファイルがあれば、WIC もミップマップ生成も通さずに読む
+// R8G8B8A8 の画像の圧縮は BlockCompressor (DirectXTex に依存しないエンコーダー) で行う
+// CookImage は DirectXTex を使わずにミップマップ生成から書き出しまで行う (Linux のビルドファームでのクック用)
+// ============================================================
+namespace TextureCooker {
+
+// フォーマットや書き出す内容を変えたら上げる (キーが変わり、作り直される)
+static const uint32_t kVersion = 2;
+
+// ミップマップの段数 (最上位を含む。画像が小さい場合は 1x1 までの段数)
+static const uint32_t kMipLevels = 4;
+
+// ブロック圧縮の形式
+enum class Compression : uint32_t {
+    None, // 圧縮しない (R8G8B8A8 のまま)
+    BC1,  // RGB + 1bit アルファ (4bpp)
+    BC3,  // RGBA (8bpp)
+    BC7,  // RGBA 高品質 (8bpp、圧縮に時間がかかる)
+    BC4,  // R のみ (4bpp、マスクなど)
+    BC5,  // RG のみ (8bpp、法線マップなど)
+};
+
+// キャッシュの設定 (キーに含まれるので、変えると作り直される)
+struct Settings {
+    Compression compression = Compression::None;
+    bool isQuickBC7 = true; // BC7 をモード5 / 6 だけで速く圧縮する (false = DirectXTex で全モードを探索する)
+};
+
+// デコード済みの RGBA8 の画像 (色は sRGB として扱う)
+struct RgbaImage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels; // width * height * 4 バイト (行の間に詰め物なし)
+};
+
+/// <summary>
+/// キャッシュのキーを求める (元ファイルの内容・パス・設定・フォーマットのバージョン)
+/// </summary>
+/// <param name="sourcePath">元の画像ファイルのパス</param>
+/// <param name="settings">キャッシュの設定</param>
+/// <returns>キー (元ファイルが読めない場合は 0)</returns>
+uint64_t ComputeKey(const std::string& sourcePath, const Settings& settings);
+
+// キーに対応するキャッシュファイルのパス
+std::string GetCachePath(uint64_t key);
+
+/// <summary>
+/// ミップマップを作る (2x2 の平均。色は線形にしてから平均し、アルファはそのまま平均する)
+/// DirectXTex の GenerateMipMaps (TEX_FILTER_SRGB) に相当する
+/// </summary>
+/// <param name="image">最上位のミップ</param>
+/// <param name="mipLevels">段数 (1x1 までの段数より多ければ 1x1 まで)</param>
+/// <returns>各ミップ (大きい順。先頭は image の写し)</returns>
+std::vector<RgbaImage> GenerateMipMaps(const RgbaImage& image, uint32_t mipLevels = kMipLevels);
+
+/// <summary>
+/// デコード済みの画像からキャッシュファイルを作る (DirectXTex を使わない)
+/// ミップマップを作り、設定に応じて BlockCompressor で圧縮し、DDS で書き出す
+/// 幅と高さが4の倍数でない場合や圧縮しない設定では R8G8B8A8 (sRGB) のまま書き出す
+/// </summary>
+/// <param name="image">元の画像</param>
+/// <param name="settings">キャッシュの設定 (BC7 の全モードの探索は DirectXTex が要るので失敗にする)</param>
+/// <param name="cachePath">書き出し先 (GetCachePath)</param>
+/// <returns>true = 成功</returns>
+bool CookImage(const RgbaImage& image, const Settings& settings, const std::string& cachePath);
+
+#ifdef _WIN32
+
+/// <summary>
+/// ミップマップ済みの画像をブロック圧縮する
+/// 圧縮済み、または D3D12 の制限 (最上位のミップの幅と高さが4の倍数) を満たさない場合はそのまま
+/// </summary>
+/// <param name="mipImages">ミップマップ済みの画像 (圧縮した場合は置き換える)</param>
+/// <param name="settings">キャッシュの設定</param>
+/// <returns>圧縮の結果</returns>
+HRESULT Compress(DirectX::ScratchImage& mipImages, const Settings& settings);
+
+/// <summary>
+/// DDS ファイルに書き出す (一時ファイルに書いてから置き換える)
+/// </summary>
+/// <returns>true = 成功</returns>
+bool Save(const std::string& cachePath, const DirectX::ScratchImage& mipImages);
+
+/// <summary>
+/// キャッシュファイルを読み込む
+/// </summary>
+/// <returns>true = 成功 (ファイルがない・壊れている場合は false)</returns>
+bool Load(const std::string& cachePath, DirectX::ScratchImage& mipImages);
+#endif
+
+} // namespace TextureCooker
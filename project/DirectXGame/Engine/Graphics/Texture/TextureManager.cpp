@@ -4,16 +4,133 @@
 #include "Base/DX12Context.h"
 #include "Base/SrvManager.h"
 
+#include <Windows.h> // CoInitializeEx
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <mutex>
+
 using namespace Logger;
 using namespace StringUtility;
 using namespace Microsoft::WRL;
 
 std::unique_ptr<TextureManager> TextureManager::instance_ = nullptr;
 
+namespace {
+
+// デコードの結果 (読み込み時間の集計用)
+struct DecodeInfo {
+    bool isCached = false;     // キャッシュ (TextureCooker) から読んだ
+    double milliseconds = 0.0; // 読み込みにかかった時間
+};
+
+// ワーカースレッドでデコードしたテクスチャ
+struct DecodedImage : DecodedTexture {
+    DirectX::ScratchImage mipImages;
+    DecodeInfo info;
+};
+
+// 元のファイルを読み込み、ミップマップまで作る
+HRESULT LoadSourceFile(const std::string& finalPath, DirectX::ScratchImage& mipImages) {
+    HRESULT hr;
+
+    // テクスチャを読み込んでプログラムで扱えるようにする
+    DirectX::ScratchImage image{};
+    std::wstring filePathW = ConvertString(finalPath);
+    if (filePathW.ends_with(L".dds")) { // DDSファイルはWICで読み込めないため、DirectXTexのDDSローダーを使用
+        hr = DirectX::LoadFromDDSFile(filePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+    } else {
+        hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
+    }
+    if (FAILED(hr)) {
+        return hr;
+    }
+
+    // ミップマップの作成
+    if (DirectX::IsCompressed(image.GetMetadata().format)) {
+        mipImages = std::move(image); // 圧縮テクスチャはミップマップを生成せず、そのまま使用
+        return S_OK;
+    }
+    return DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(),
+                                    image.GetMetadata(), DirectX::TEX_FILTER_SRGB,
+                                    TextureCooker::kMipLevels, mipImages);
+}
+
+// ファイルを読み込み、ミップマップまで作る
+// DDS 以外はキャッシュ (TextureCooker) があればそれを読み、なければデコードしてキャッシュを書き出す
+HRESULT DecodeTextureFile(const std::string& finalPath, const TextureCooker::Settings& cookSettings,
+                          DirectX::ScratchImage& mipImages, DecodeInfo& info) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const bool isDDS = finalPath.ends_with(".dds");
+    const uint64_t cacheKey = isDDS ? 0 : TextureCooker::ComputeKey(finalPath, cookSettings);
+    const std::string cachePath = TextureCooker::GetCachePath(cacheKey);
+    info.isCached = cacheKey != 0 && TextureCooker::Load(cachePath, mipImages);
+
+    HRESULT hr = S_OK;
+    if (!info.isCached) {
+        hr = LoadSourceFile(finalPath, mipImages);
+        if (SUCCEEDED(hr) && cacheKey != 0) {
+            // 次回以降のために、圧縮してキャッシュを書き出す (圧縮に失敗したら書き出さない)
+            if (FAILED(TextureCooker::Compress(mipImages, cookSettings))) {
+                Logger::Log("WARNING: Failed to compress texture: " + finalPath + "\n");
+            } else if (!TextureCooker::Save(cachePath, mipImages)) {
+                Logger::Log("WARNING: Failed to write cooked texture: " + cachePath + "\n");
+            }
+        }
+    }
+
+    info.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return hr;
+}
+
+// 非同期読み込み用のデコーダー (WIC を使うので、ワーカースレッドごとに COM を初期化する)
+class TextureFileDecoder : public ITextureDecoder {
+public:
+    explicit TextureFileDecoder(const TextureCooker::Settings& cookSettings) : cookSettings_(cookSettings) {}
+
+    void BeginWorkerThread() override { CoInitializeEx(0, COINIT_MULTITHREADED); }
+    void EndWorkerThread() override { CoUninitialize(); }
+
+    // メインスレッドから設定を差し替える (デコード中のものは開始時の設定のまま)
+    void SetCookSettings(const TextureCooker::Settings& cookSettings) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cookSettings_ = cookSettings;
+    }
+
+    std::unique_ptr<DecodedTexture> Decode(const std::string& filePath) override {
+        // 1件のデコードの間は同じ設定を使う (キャッシュのキーと圧縮の設定を食い違わせない)
+        TextureCooker::Settings cookSettings;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cookSettings = cookSettings_;
+        }
+        auto decoded = std::make_unique<DecodedImage>();
+        if (FAILED(DecodeTextureFile(filePath, cookSettings, decoded->mipImages, decoded->info))) {
+            return nullptr;
+        }
+        decoded->sizeInBytes = decoded->mipImages.GetPixelsSize();
+        return decoded;
+    }
+
+private:
+    std::mutex mutex_;
+    TextureCooker::Settings cookSettings_;
+};
+
+} // namespace
+
 // 初期化
 void TextureManager::Initialize() {
   // SRVの数と同数
   textureDatas_.reserve(SrvManager::kMaxSRVCount);
+
+  // 非同期読み込み中に使う仮のテクスチャ (RAFramework が開いたコマンドリストに積む)
+  CreatePlaceholderTexture();
+
+  // 非同期読み込みのワーカースレッドを起動する
+  streamDecoder_ = std::make_unique<TextureFileDecoder>(cookSettings_);
+  streamer_.Initialize(streamDecoder_.get(), this);
 }
 
 // シングルトンインスタンスの取得
@@ -34,6 +151,10 @@ TextureManager::TextureManager(Token) {
 
 // 終了
 void TextureManager::Finalize() {
+    // ワーカースレッドを先に止める (デコード中のものは破棄される)
+    streamer_.Finalize();
+    streamDecoder_.reset();
+    placeholderResource_.Reset();
     textureDatas_.clear();
     instance_.reset();
 }
@@ -91,25 +212,17 @@ TextureManager::GetMetaData(const std::string &filePath) {
 void TextureManager::LoadTexture(const std::string &filePath) {
 
     std::string finalPath;
-
-    // A. まず、渡されたパスそのまま（モデルフォルダ付きパスなど）で存在するか確認
-    if (std::filesystem::exists(filePath)) {
-        finalPath = filePath;
-    } else {
-        // B. 見つからない場合、汎用テクスチャフォルダ内を探す
-        finalPath = "Resources/Textures/" + filePath;
-
-        if (!std::filesystem::exists(finalPath)) {
-            Logger::Log("ERROR: Texture not found. Tried:\n 1. " + filePath + "\n 2. " + finalPath);
-            assert(false);
-            return;
-        }
+    if (!ResolveFilePath(filePath, finalPath)) {
+        assert(false);
+        return;
     }
 
   // 読み込み済みテクスチャを検索
+  // (非同期読み込み中のものは、メタデータを使う呼び出し元のためにここで読み込みを済ませる)
   auto it = textureDatas_.find(finalPath);
+  const bool isStreaming = it != textureDatas_.end() && it->second.isStreaming;
 
-  if (it != textureDatas_.end()) {
+  if (it != textureDatas_.end() && !isStreaming) {
     return;
   }
 
@@ -120,34 +233,17 @@ void TextureManager::LoadTexture(const std::string &filePath) {
   }
 
   // テクスチャ枚数上限チェック
-  assert(SrvManager::GetInstance()->AllocatableTexture());
-
-  HRESULT hr;
+  assert(isStreaming || SrvManager::GetInstance()->AllocatableTexture());
 
-  // テクスチャを読み込んでプログラムで扱えるようにする
-  DirectX::ScratchImage image{};
-  std::wstring filePathW = ConvertString(finalPath);
-  if (filePathW.ends_with(L".dds")) { // DDSファイルはWICで読み込めないため、DirectXTexのDDSローダーを使用
-      hr = DirectX::LoadFromDDSFile(filePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
-  }
-  else {
-      hr = DirectX::LoadFromWICFile(filePathW.c_str(), DirectX::WIC_FLAGS_FORCE_SRGB, nullptr, image);
-  }
-  assert(SUCCEEDED(hr));
-
-  // ミップマップの作成
+  // テクスチャを読み込み、ミップマップを作成する
   DirectX::ScratchImage mipImages{};
-  if (DirectX::IsCompressed(image.GetMetadata().format)) {
-	  mipImages = std::move(image); // 圧縮テクスチャはミップマップを生成せず、そのまま使用
-  }
-  else {
-      hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(),
-          image.GetMetadata(), DirectX::TEX_FILTER_SRGB,
-          4, mipImages);
-  }
+  DecodeInfo info{};
+  HRESULT hr = DecodeTextureFile(finalPath, cookSettings_, mipImages, info);
   assert(SUCCEEDED(hr));
 
-  Log("INFO: Loaded texture at path: " + finalPath + "\n");
+  AddLoadStats(info.isCached, info.milliseconds);
+  Log(std::format("INFO: Loaded texture at path: {} in {:.3f} ms ({})\n", finalPath,
+                  info.milliseconds, info.isCached ? "cooked cache" : "decoded"));
 
   // テクスチャデータを追加
   TextureData &textureData = textureDatas_[finalPath];
@@ -155,20 +251,19 @@ void TextureManager::LoadTexture(const std::string &filePath) {
   textureData.metadata = mipImages.GetMetadata();
   textureData.resource = DX12Context::GetInstance()->CreateTextureResource(textureData.metadata);
 
-  // SRV確保
-  textureData.srvIndex = SrvManager::GetInstance()->Allocate();
-  textureData.srvHandleCPU =
-      SrvManager::GetInstance()->GetCPUDescriptorHandle(textureData.srvIndex);
-  textureData.srvHandleGPU =
-      SrvManager::GetInstance()->GetGPUDescriptorHandle(textureData.srvIndex);
-
-  SrvManager::GetInstance()->CreateSRVForTexture(
-      textureData.srvIndex, textureData.resource, textureData.metadata.format,
-	  UINT(textureData.metadata.mipLevels), textureData.metadata.IsCubemap()); // CubeMapかどうかもSRV作成時に渡す
+  if (isStreaming) {
+    // 確保済みのSRVへ書き込む (後で届く非同期読み込みの結果は Activate で捨てる)
+    textureData.isStreaming = false;
+    SrvManager::GetInstance()->CreateSRVForTexture(
+        textureData.srvIndex, textureData.resource, textureData.metadata.format,
+        UINT(textureData.metadata.mipLevels), textureData.metadata.IsCubemap());
+  } else {
+    // SRV確保
+    AllocateSrv(textureData);
+  }
 
   // テクスチャリソースをアップロードし、コマンドリストに積む
-  textureData.intermediateResource =
-      DX12Context::GetInstance()->UploadTextureData(textureData.resource, mipImages);
+  DX12Context::GetInstance()->UploadTextureData(textureData.resource, mipImages);
 
   // 一時的にコマンドリストを開いた場合は、即座に実行・同期して閉じる
   if (needSync) {
@@ -176,14 +271,50 @@ void TextureManager::LoadTexture(const std::string &filePath) {
   }
 }
 
-// 中間リソースをまとめて解放する
-void TextureManager::ReleaseIntermediateResources() {
-  for (auto &pair : textureDatas_) {
-    // intermediateResourceを解放
-    pair.second.intermediateResource.Reset();
+// テクスチャの非同期読み込み
+uint32_t TextureManager::RequestTexture(const std::string &filePath) {
+  std::string finalPath;
+  if (!ResolveFilePath(filePath, finalPath)) {
+    assert(false);
+    return 0;
   }
 
-  Logger::Log("INFO: All intermediate texture resources have been released.\n");
+  // 読み込み済み・読み込み中ならそのSRVを返す
+  auto it = textureDatas_.find(finalPath);
+  if (it != textureDatas_.end()) {
+    return it->second.srvIndex;
+  }
+
+  // テクスチャ枚数上限チェック
+  assert(SrvManager::GetInstance()->AllocatableTexture());
+
+  // 差し替えまでは仮のテクスチャを指す
+  TextureData &textureData = textureDatas_[finalPath];
+  textureData.metadata = placeholderMetadata_;
+  textureData.resource = placeholderResource_;
+  textureData.isStreaming = true;
+  AllocateSrv(textureData);
+
+  streamer_.Request(finalPath);
+  return textureData.srvIndex;
+}
+
+bool TextureManager::IsTextureReady(const std::string &filePath) {
+  const TextureData* data = FindTextureData(filePath);
+  return data && !data->isStreaming;
+}
+
+void TextureManager::SetCookSettings(const TextureCooker::Settings &settings) {
+  cookSettings_ = settings;
+  // ワーカースレッドは自分の写しを読むので、そちらも差し替える
+  if (streamDecoder_) {
+    static_cast<TextureFileDecoder *>(streamDecoder_.get())->SetCookSettings(settings);
+  }
+}
+
+// 非同期読み込みの更新
+void TextureManager::Update() {
+  streamer_.Update(kMaxStreamUploadBytesPerFrame);
 }
 
 const TextureManager::TextureData* TextureManager::FindTextureData(const std::string& filePath) {
@@ -207,3 +338,109 @@ const TextureManager::TextureData* TextureManager::FindTextureData(const std::st
 
     return nullptr; // 見つからない
 }
+
+void TextureManager::LogLoadStats() const {
+    Log(std::format("INFO: Textures loaded: {} from cooked cache ({:.3f} ms), {} decoded ({:.3f} ms)\n",
+                    loadStats_.cachedCount, loadStats_.cachedMilliseconds,
+                    loadStats_.decodedCount, loadStats_.decodedMilliseconds));
+}
+
+void TextureManager::AddLoadStats(bool isCached, double milliseconds) {
+    if (isCached) {
+        ++loadStats_.cachedCount;
+        loadStats_.cachedMilliseconds += milliseconds;
+    } else {
+        ++loadStats_.decodedCount;
+        loadStats_.decodedMilliseconds += milliseconds;
+    }
+}
+
+bool TextureManager::ResolveFilePath(const std::string& filePath, std::string& finalPath) {
+    // A. まず、渡されたパスそのまま（モデルフォルダ付きパスなど）で存在するか確認
+    if (std::filesystem::exists(filePath)) {
+        finalPath = filePath;
+        return true;
+    }
+
+    // B. 見つからない場合、汎用テクスチャフォルダ内を探す
+    finalPath = "Resources/Textures/" + filePath;
+    if (!std::filesystem::exists(finalPath)) {
+        Logger::Log("ERROR: Texture not found. Tried:\n 1. " + filePath + "\n 2. " + finalPath);
+        return false;
+    }
+    return true;
+}
+
+void TextureManager::AllocateSrv(TextureData& textureData) {
+    textureData.srvIndex = SrvManager::GetInstance()->Allocate();
+    textureData.srvHandleCPU =
+        SrvManager::GetInstance()->GetCPUDescriptorHandle(textureData.srvIndex);
+    textureData.srvHandleGPU =
+        SrvManager::GetInstance()->GetGPUDescriptorHandle(textureData.srvIndex);
+
+    SrvManager::GetInstance()->CreateSRVForTexture(
+        textureData.srvIndex, textureData.resource, textureData.metadata.format,
+        UINT(textureData.metadata.mipLevels), textureData.metadata.IsCubemap()); // CubeMapかどうかもSRV作成時に渡す
+}
+
+void TextureManager::CreatePlaceholderTexture() {
+    assert(DX12Context::GetInstance()->IsCommandListOpen());
+
+    // 1x1 の白 (マテリアルの色がそのまま出る)
+    DirectX::ScratchImage image{};
+    HRESULT hr = image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB, 1, 1, 1, 1);
+    assert(SUCCEEDED(hr));
+    std::memset(image.GetPixels(), 0xFF, image.GetPixelsSize());
+
+    placeholderMetadata_ = image.GetMetadata();
+    placeholderResource_ = DX12Context::GetInstance()->CreateTextureResource(placeholderMetadata_);
+    DX12Context::GetInstance()->UploadTextureData(placeholderResource_, image);
+}
+
+bool TextureManager::Upload(const std::string& filePath, DecodedTexture& texture, uint64_t& fenceValue) {
+    // 描画フレームの外 (コマンドリストが閉じている) では積まない
+    if (!DX12Context::GetInstance()->IsCommandListOpen()) {
+        return false;
+    }
+
+    TextureData& textureData = textureDatas_.at(filePath);
+    // 待っている間に LoadTexture で読み込まれた場合は転送しない
+    if (!textureData.isStreaming) {
+        fenceValue = 0;
+        return true;
+    }
+    const DirectX::ScratchImage& mipImages = static_cast<DecodedImage&>(texture).mipImages;
+
+    // 転送コマンドを積む
+    textureData.streamedMetadata = mipImages.GetMetadata();
+    textureData.streamedResource = DX12Context::GetInstance()->CreateTextureResource(textureData.streamedMetadata);
+    DX12Context::GetInstance()->UploadTextureData(textureData.streamedResource, mipImages);
+    fenceValue = DX12Context::GetInstance()->GetNextFenceValue();
+
+    const DecodeInfo& info = static_cast<DecodedImage&>(texture).info;
+    AddLoadStats(info.isCached, info.milliseconds);
+    Log(std::format("INFO: Streamed texture at path: {} (decoded in {:.3f} ms, {})\n", filePath,
+                    info.milliseconds, info.isCached ? "cooked cache" : "decoded"));
+    return true;
+}
+
+uint64_t TextureManager::GetCompletedFenceValue() const {
+    return DX12Context::GetInstance()->GetCompletedFenceValue();
+}
+
+void TextureManager::Activate(const std::string& filePath) {
+    TextureData& textureData = textureDatas_.at(filePath);
+    if (!textureData.isStreaming) {
+        textureData.streamedResource.Reset();
+        return;
+    }
+
+    // 同じSRVに書き込むので、取得済みのハンドルはそのまま使える
+    // (前のフレームは PostDraw で完了を待っているので、書き換えても参照中のものはない)
+    textureData.metadata = textureData.streamedMetadata;
+    textureData.resource = std::move(textureData.streamedResource);
+    textureData.isStreaming = false;
+    SrvManager::GetInstance()->CreateSRVForTexture(
+        textureData.srvIndex, textureData.resource, textureData.metadata.format,
+        UINT(textureData.metadata.mipLevels), textureData.metadata.IsCubemap());
+}
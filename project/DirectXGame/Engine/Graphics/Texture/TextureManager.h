@@ -6,9 +6,12 @@
 #include <wrl/client.h>
 
 #include "externals/DirectXTex/DirectXTex.h"
+#include "TextureCooker.h"
+#include "TextureStreamer.h"
 
 // テクスチャマネージャー(シングルトン)
-class TextureManager {
+// 非同期読み込みの転送・差し替えは ITextureUploader として TextureStreamer から呼ばれる
+class TextureManager : private ITextureUploader {
 public:
   // 【Passkey Idiom】
   struct Token {
@@ -17,6 +20,14 @@ public:
     Token() {}
   };
 
+  // 読み込みの集計 (キャッシュの効果の確認用。初回起動と2回目以降で比べる)
+  struct LoadStats {
+    uint32_t cachedCount = 0;         // キャッシュから読んだ枚数
+    uint32_t decodedCount = 0;        // デコードした (キャッシュを作った) 枚数
+    double cachedMilliseconds = 0.0;  // キャッシュからの読み込みにかかった時間の合計
+    double decodedMilliseconds = 0.0; // デコード・ミップマップ生成・圧縮・書き出しにかかった時間の合計
+  };
+
 private: // namespace省略のためのusing宣言
 #pragma region using宣言
 
@@ -33,15 +44,34 @@ private: // メンバ変数
     uint32_t srvIndex;
     D3D12_CPU_DESCRIPTOR_HANDLE srvHandleCPU;
     D3D12_GPU_DESCRIPTOR_HANDLE srvHandleGPU;
-    ComPtr<ID3D12Resource> intermediateResource;
+    // 非同期読み込み中 (仮のテクスチャを指している) なら true
+    bool isStreaming = false;
+    // 転送済みで差し替え待ちのリソースとメタデータ
+    ComPtr<ID3D12Resource> streamedResource;
+    DirectX::TexMetadata streamedMetadata;
   };
 
+  // 1フレームに転送する量の目安 (非同期読み込み)
+  static const size_t kMaxStreamUploadBytesPerFrame = 32 * 1024 * 1024;
+
   static std::unique_ptr<TextureManager> instance_;
 
   // テクスチャデータ
   std::unordered_map<std::string, TextureData>
       textureDatas_; // キーの順番を保つならunordered_mapの方が高速
 
+  // 非同期読み込み中に使う 1x1 の仮のテクスチャ
+  ComPtr<ID3D12Resource> placeholderResource_;
+  DirectX::TexMetadata placeholderMetadata_{};
+
+  // キャッシュの設定と、読み込みの集計
+  TextureCooker::Settings cookSettings_;
+  LoadStats loadStats_;
+
+  // 非同期読み込み (デコーダーはストリーマーより先に作り、後に破棄する)
+  std::unique_ptr<ITextureDecoder> streamDecoder_;
+  TextureStreamer streamer_;
+
 public: // メンバ関数
   // コンストラクタ(隠蔽)
   explicit TextureManager(Token);
@@ -66,18 +96,60 @@ public: // メンバ関数
   const DirectX::TexMetadata &GetMetaData(const std::string &filePath);
 
   /// <summary>
-  /// テクスチャファイルの読み込み
+  /// テクスチャファイルの読み込み (読み終わるまで待つ。フレームの外ではGPUの完了も待つ)
+  /// メタデータ (大きさ) を使うスプライトや、起動時の読み込みに使う
+  /// 非同期読み込み中のファイルなら、ここで読み込みを済ませる
   /// </summary>
   /// <param name="filePath">テクスチャファイルのパス</param>
   void LoadTexture(const std::string &filePath);
 
   /// <summary>
-  /// 中間リソースをまとめて解放する
+  /// テクスチャファイルの非同期読み込み (すぐに返り、GPUの同期も行わない)
+  /// デコードとミップマップ生成はワーカースレッドで行い、転送が終わるまでは 1x1 の白い仮のテクスチャが使われる
+  /// 差し替えは同じSRVへ書き込むので、返したSRVインデックスやファイルパスでの取得はそのまま使える
+  /// (メタデータは差し替えまで仮のテクスチャのもの)
+  /// SRVだけを使うモデル・地形・パーティクルなど、ゲーム中に読み込まれうるものはこちらを使う
+  /// </summary>
+  /// <param name="filePath">テクスチャファイルのパス</param>
+  /// <returns>SRVインデックス</returns>
+  uint32_t RequestTexture(const std::string &filePath);
+
+  // 非同期読み込みの差し替えが終わっていれば true (LoadTexture で読んだものも true)
+  bool IsTextureReady(const std::string &filePath);
+
+  /// <summary>
+  /// 非同期読み込みの更新 (コマンドリストを開いた後、描画コマンドより前に毎フレーム呼ぶ)
+  /// 前のフレームまでに転送が終わったものを差し替え、デコードが終わったものの転送コマンドを積む
+  /// </summary>
+  void Update();
+
+  /// <summary>
+  /// キャッシュ (ミップマップ済み・ブロック圧縮済みの DDS) の設定
+  /// 非同期読み込みのデコーダーには写しを渡すので、いつ呼んでもよい (以降に始まるデコードから使われる)
   /// </summary>
-  void ReleaseIntermediateResources();
+  void SetCookSettings(const TextureCooker::Settings &settings);
+  const TextureCooker::Settings &GetCookSettings() const { return cookSettings_; }
+
+  // 読み込みの集計
+  const LoadStats &GetLoadStats() const { return loadStats_; }
+  void LogLoadStats() const;
+
 
 private:
     const TextureManager::TextureData* FindTextureData(const std::string& filePath);
+    // 渡されたパス・汎用テクスチャフォルダの順に探す (見つからなければ false)
+    bool ResolveFilePath(const std::string& filePath, std::string& finalPath);
+    // SRVを確保してテクスチャデータに設定する
+    void AllocateSrv(TextureData& textureData);
+    // 仮のテクスチャを作る
+    void CreatePlaceholderTexture();
+    // 読み込みの集計に加える
+    void AddLoadStats(bool isCached, double milliseconds);
+
+    // ITextureUploader (TextureStreamer から呼ばれる)
+    bool Upload(const std::string& filePath, DecodedTexture& texture, uint64_t& fenceValue) override;
+    uint64_t GetCompletedFenceValue() const override;
+    void Activate(const std::string& filePath) override;
 
 private: // メンバ関数
   // デストラクタ(隠蔽)
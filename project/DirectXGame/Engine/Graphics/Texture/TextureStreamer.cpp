@@ -0,0 +1,152 @@
+#include "TextureStreamer.h"
+#include "Logger.h"
+#include "Thread/ThreadUtility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <format>
+
+TextureStreamer::~TextureStreamer() { Finalize(); }
+
+void TextureStreamer::Initialize(ITextureDecoder* decoder, ITextureUploader* uploader, uint32_t workerCount) {
+    assert(decoder && uploader);
+    Finalize();
+    decoder_ = decoder;
+    uploader_ = uploader;
+
+    // 描画スレッドの分を1つ残す (取得できない環境では0が返る)
+    if (workerCount == 0) {
+        const unsigned int hardwareCount = std::thread::hardware_concurrency();
+        workerCount = hardwareCount > 1 ? hardwareCount - 1 : 1;
+    }
+    isStopping_ = false;
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&TextureStreamer::WorkerMain, this);
+    }
+}
+
+void TextureStreamer::Finalize() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isStopping_ = true;
+        // 未着手の依頼は破棄する
+        jobs_.clear();
+    }
+    jobCondition_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    decodedResults_.clear();
+    uploadQueue_.clear();
+    uploadingHandles_.clear();
+    requests_.clear();
+    pendingCount_ = 0;
+}
+
+uint32_t TextureStreamer::Request(const std::string& filePath) {
+    assert(!workers_.empty() && "TextureStreamer is not initialized");
+    const uint32_t handle = static_cast<uint32_t>(requests_.size());
+    requests_.push_back({filePath, State::Decoding, 0});
+    ++pendingCount_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back({handle, filePath});
+    }
+    jobCondition_.notify_one();
+    return handle;
+}
+
+void TextureStreamer::Update(size_t maxUploadBytes) {
+    if (pendingCount_ == 0) {
+        return;
+    }
+
+    // 1. 転送のフェンスが完了したものを差し替える (今回積んだものは早くても次の Update)
+    const uint64_t completedFenceValue = uploader_->GetCompletedFenceValue();
+    std::erase_if(uploadingHandles_, [&](uint32_t handle) {
+        RequestState& request = requests_[handle];
+        if (request.fenceValue > completedFenceValue) {
+            return false;
+        }
+        uploader_->Activate(request.filePath);
+        request.state = State::Ready;
+        --pendingCount_;
+        return true;
+    });
+
+    // 2. デコードが終わったものを受け取る
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (DecodeResult& result : decodedResults_) {
+            if (result.texture) {
+                requests_[result.handle].state = State::Uploading;
+            }
+            uploadQueue_.push_back(std::move(result));
+        }
+        decodedResults_.clear();
+    }
+
+    // 3. 転送量の目安に達するまで、受け取った順に転送コマンドを積む
+    size_t uploadedBytes = 0;
+    bool isFirst = true;
+    while (!uploadQueue_.empty()) {
+        DecodeResult& result = uploadQueue_.front();
+        RequestState& request = requests_[result.handle];
+        if (!result.texture) {
+            Logger::Log(std::format("ERROR: Failed to decode streamed texture: {}\n", request.filePath));
+            request.state = State::Failed;
+            --pendingCount_;
+            uploadQueue_.pop_front();
+            continue;
+        }
+        if (!isFirst && uploadedBytes + result.texture->sizeInBytes > maxUploadBytes) {
+            break;
+        }
+        if (!uploader_->Upload(request.filePath, *result.texture, request.fenceValue)) {
+            break; // 今は積めないので次の Update で続きから
+        }
+        uploadedBytes += result.texture->sizeInBytes;
+        isFirst = false;
+        uploadingHandles_.push_back(result.handle);
+        uploadQueue_.pop_front(); // デコード結果は転送用のバッファへ写したので手放す
+    }
+}
+
+void TextureStreamer::WorkerMain() {
+    // デコーダーの中 (圧縮など) でさらにスレッドを立てないよう、ワーカーの印を付ける
+    ThreadUtility::MarkWorkerThread();
+    decoder_->BeginWorkerThread();
+    while (true) {
+        DecodeJob job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCondition_.wait(lock, [this] { return isStopping_ || !jobs_.empty(); });
+            if (isStopping_) {
+                break;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        // 例外はデコードの失敗として扱う
+        std::unique_ptr<DecodedTexture> texture;
+        try {
+            texture = decoder_->Decode(job.filePath);
+        } catch (const std::exception& exception) {
+            Logger::Log(std::format("ERROR: Exception while decoding {}: {}\n", job.filePath, exception.what()));
+        } catch (...) {
+            // std::exception 以外が投げられても、ワーカーを止めずに失敗として返す
+            Logger::Log(std::format("ERROR: Unknown exception while decoding {}\n", job.filePath));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        decodedResults_.push_back({job.handle, std::move(texture)});
+    }
+    decoder_->EndWorkerThread();
+}
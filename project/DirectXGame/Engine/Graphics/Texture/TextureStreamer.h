@@ -0,0 +1,131 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// デコード済みのテクスチャ (中身はデコーダーとアップローダーの間で決める)
+struct DecodedTexture {
+    virtual ~DecodedTexture() = default;
+    size_t sizeInBytes = 0; // 転送するデータの大きさ (1フレームの転送量の制限に使う)
+};
+
+// テクスチャファイルのデコード (ワーカースレッドから呼ばれる)
+class ITextureDecoder {
+public:
+    virtual ~ITextureDecoder() = default;
+    // ワーカースレッドの開始・終了時に、そのスレッド上で呼ばれる (COM の初期化など)
+    virtual void BeginWorkerThread() {}
+    virtual void EndWorkerThread() {}
+    // デコードしてミップマップまで作る (失敗したら nullptr)
+    virtual std::unique_ptr<DecodedTexture> Decode(const std::string& filePath) = 0;
+};
+
+// GPU への転送と差し替え (メインスレッドから呼ばれる)
+class ITextureUploader {
+public:
+    virtual ~ITextureUploader() = default;
+    // 転送コマンドを積み、転送が終わるフェンス値を返す (今は積めない場合は false。次の Update で再試行する)
+    virtual bool Upload(const std::string& filePath, DecodedTexture& texture, uint64_t& fenceValue) = 0;
+    // GPU が完了したフェンス値
+    virtual uint64_t GetCompletedFenceValue() const = 0;
+    // 転送が終わったテクスチャを使えるようにする (仮のテクスチャからの差し替え)
+    virtual void Activate(const std::string& filePath) = 0;
+};
+
+// ============================================================
+// TextureStreamer — テクスチャの非同期読み込み
+//   ・デコードとミップマップ生成はワーカースレッドで行う
+//   ・デコードが終わったものはメインスレッドの Update で転送コマンドを積む (1回の転送量は制限できる)
+//   ・転送のフェンスが完了したものを、次の Update で差し替える
+// D3D12 や DirectXTex には依存しないので、偽のデコーダー・アップローダーで確かめられる
+// ============================================================
+class TextureStreamer {
+public:
+    // 読み込みの状態
+    enum class State {
+        Decoding,  // デコード待ち・デコード中
+        Uploading, // 転送待ち・転送中
+        Ready,     // 差し替え済み
+        Failed,    // デコードに失敗した
+    };
+
+public:
+    ~TextureStreamer();
+
+    /// <summary>
+    /// ワーカースレッドを起動する
+    /// </summary>
+    /// <param name="decoder">デコーダー (Finalize まで有効であること)</param>
+    /// <param name="uploader">アップローダー (Finalize まで有効であること)</param>
+    /// <param name="workerCount">ワーカースレッド数 (0 = 描画スレッドの分を残した全コア)</param>
+    void Initialize(ITextureDecoder* decoder, ITextureUploader* uploader, uint32_t workerCount = 0);
+
+    // ワーカースレッドを止める (未着手のデコードは破棄する)
+    void Finalize();
+
+    /// <summary>
+    /// 読み込みを依頼する (すぐに返る。同じファイルの重複は呼び出し側で除くこと)
+    /// </summary>
+    /// <returns>状態の問い合わせに使うハンドル</returns>
+    uint32_t Request(const std::string& filePath);
+
+    /// <summary>
+    /// 毎フレームの更新 (転送が終わったものの差し替えと、デコードが終わったものの転送)
+    /// </summary>
+    /// <param name="maxUploadBytes">1回に転送する量の目安 (大きいテクスチャでも最低1枚は転送する)</param>
+    void Update(size_t maxUploadBytes = SIZE_MAX);
+
+    // 状態の取得
+    State GetState(uint32_t handle) const { return requests_[handle].state; }
+    const std::string& GetFilePath(uint32_t handle) const { return requests_[handle].filePath; }
+
+    // 差し替えが終わっていない (デコード・転送中の) 件数
+    uint32_t GetPendingCount() const { return pendingCount_; }
+
+private:
+    // 依頼1件の状態
+    struct RequestState {
+        std::string filePath;
+        State state = State::Decoding;
+        uint64_t fenceValue = 0; // 転送が終わるフェンス値
+    };
+
+    // デコードが終わったもの
+    struct DecodeResult {
+        uint32_t handle;
+        std::unique_ptr<DecodedTexture> texture;
+    };
+
+    // デコードの依頼
+    struct DecodeJob {
+        uint32_t handle;
+        std::string filePath;
+    };
+
+    void WorkerMain();
+
+private:
+    ITextureDecoder* decoder_ = nullptr;
+    ITextureUploader* uploader_ = nullptr;
+
+    // 依頼の状態 (メインスレッドのみが触る)
+    std::vector<RequestState> requests_;
+    uint32_t pendingCount_ = 0;
+    // 転送待ち (デコード済み) と、転送の完了待ち
+    std::deque<DecodeResult> uploadQueue_;
+    std::vector<uint32_t> uploadingHandles_;
+
+    // ワーカースレッド
+    std::vector<std::thread> workers_;
+    std::deque<DecodeJob> jobs_;
+    std::vector<DecodeResult> decodedResults_;
+    std::mutex mutex_;
+    std::condition_variable jobCondition_;
+    bool isStopping_ = false;
+};
@@ -14,6 +14,28 @@ struct VertexData {
   Vector3 normal;   // 法線ベクトル
 }; // 16+8+12=36バイト。float*4+float*2+float*3
 
+// 頂点バッファのレイアウト
+enum VertexFormat {
+  kVertexFormatFull,        // VertexData (36バイト)
+  kVertexFormatCompact,     // CompactVertexData (20バイト)
+  kVertexFormatCompactHalf, // CompactHalfVertexData (16バイト)
+  kCountOfVertexFormat,     // 利用してはいけない (要素数)
+};
+
+// 圧縮頂点 (位置はfloat3、法線は八面体エンコードしたsnorm16x2、UVはhalf2)
+struct CompactVertexData {
+  Vector3 position;     // R32G32B32_FLOAT (wはシェーダーで1になる)
+  int16_t normal[2];    // R16G16_SNORM
+  uint16_t texcoord[2]; // R16G16_FLOAT
+}; // 12+4+4=20バイト
+
+// 圧縮頂点 (位置もhalf4にしたもの。原点から離れた頂点ほど誤差が大きい)
+struct CompactHalfVertexData {
+  uint16_t position[4]; // R16G16B16A16_FLOAT (w=1)
+  int16_t normal[2];    // R16G16_SNORM
+  uint16_t texcoord[2]; // R16G16_FLOAT
+}; // 8+4+4=16バイト
+
 // Skybox用頂点（位置のみ。CubeMapのサンプリングベクトルとして使うのでUV/法線不要）
 struct SkyboxVertex {
     Vector4 position; // float4
@@ -45,7 +67,7 @@ struct Material {
   int32_t isRing;
   int32_t isCylinder;
   float alphaReference;
-  float padding2[1];
+  int32_t isTrail;
 
   // Dissolve用
   int32_t enableDissolve;    // 1:有効, 0:無効
@@ -8,11 +8,76 @@
 #ifndef MODEL_TYPES_H
 #define MODEL_TYPES_H
 
-// ノードの構造体
-struct Node {
-	Matrix4x4 localMatrix;         // NodeのLocalMatrix(Transform)
-	std::string name;              // Nodeの名前
-	std::vector<Node> children;    // 子供のNode
+// 境界ボリューム (AABB と、それを包む球。どちらも同じ座標系)
+struct Bounds {
+	AABB aabb = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}};
+	Sphere sphere = {{0.0f, 0.0f, 0.0f}, 0.0f};
+};
+
+// ノード階層 (インポート時に平坦化したもの。親は必ず子より前に並ぶので、先頭から1回なめればワールド行列が求まる)
+// 0 番がルート。ノードごとの値は同じ番号の要素に入る
+struct NodeHierarchy {
+	std::vector<Matrix4x4> localMatrices; // NodeのLocalMatrix(Transform)
+	std::vector<int32_t> parents;         // 親のノード番号 (-1 = 親なし)
+	std::vector<uint32_t> nameIds;        // names 内の番号
+	std::vector<std::string> names;       // Nodeの名前 (同じ名前は1つにまとめる)
+
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(parents.size()); }
+};
+
+// スキニングで1頂点に影響するジョイント (最大4つ。重みの合計は1、使わない枠は重み0)
+struct VertexInfluence {
+  uint32_t jointIndices[4] = {0, 0, 0, 0}; // ModelData::joints 内の番号
+  float weights[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+};
+
+// スキンのジョイント (骨)
+struct Joint {
+  uint32_t nodeIndex = 0;       // NodeHierarchy 内の番号
+  Matrix4x4 inverseBindMatrix;  // バインドポーズのモデル空間からジョイント空間への変換
+  AABB bounds = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}}; // 影響する頂点のバインドポーズでの範囲 (読み込み後の座標系)
+};
+
+// キーフレーム
+template <class T> struct Keyframe {
+  float time; // 秒
+  T value;
+};
+
+// 1ノード分のアニメーション (どの要素も最低1つキーを持つ。ファイルにキーが無い要素は読み込み時にノードのローカル行列から作る)
+struct NodeAnimation {
+  uint32_t nodeIndex = 0; // NodeHierarchy 内の番号
+  std::vector<Keyframe<Vector3>> translate;
+  std::vector<Keyframe<Quaternion>> rotate;
+  std::vector<Keyframe<Vector3>> scale;
+};
+
+// アニメーションクリップ
+struct AnimationClip {
+  std::string name;
+  float duration = 0.0f; // 秒
+  std::vector<NodeAnimation> tracks;
+};
+
+// 圧縮した1ノード分のアニメーション (AnimationCompressor で作る)
+// 要素は translate, rotate, scale の順に 0, 1, 2 番で、それぞれ CompressedAnimationClip のキー配列の範囲を持つ
+struct CompressedNodeAnimation {
+  uint32_t nodeIndex = 0;                 // NodeHierarchy 内の番号
+  uint32_t keyOffsets[3] = {0, 0, 0};     // keyTimes 内の開始位置
+  uint32_t keyCounts[3] = {0, 0, 0};      // キー数 (最低1つ)
+  Vector3 translateMin = {0.0f, 0.0f, 0.0f};   // 16bit の平行移動が表す範囲
+  Vector3 translateExtent = {0.0f, 0.0f, 0.0f};
+  Vector3 scaleMin = {0.0f, 0.0f, 0.0f};       // 16bit のスケールが表す範囲
+  Vector3 scaleExtent = {0.0f, 0.0f, 0.0f};
+};
+
+// 圧縮したアニメーションクリップ (1キー = 時刻16bit + 値48bit の8バイト)
+struct CompressedAnimationClip {
+  std::string name;
+  float duration = 0.0f; // 秒
+  std::vector<CompressedNodeAnimation> tracks;
+  std::vector<uint16_t> keyTimes;  // 時刻 (0 ～ duration を 65535 等分したもの)
+  std::vector<uint16_t> keyValues; // キーごとに3つ (平行移動・スケールは範囲内の16bit、回転は smallest-three の48bit)
 };
 
 // マテリアルデータの構造体
@@ -21,12 +86,38 @@ struct MaterialData {
   uint32_t textureIndex = 0;   // テクスチャ番号
 };
 
+// サブメッシュ: 同じマテリアルで描く三角形の範囲
+// サブメッシュ同士は頂点を共有しない (簡略化や並べ替えで三角形がマテリアルをまたがないようにするため)
+struct SubMesh {
+  uint32_t materialIndex = 0; // ModelData::materials 内の番号
+  uint32_t indexOffset = 0;   // indices 内の開始位置
+  uint32_t indexCount = 0;    // インデックス数
+  Bounds bounds;              // 参照する頂点の範囲 (モデル空間)
+};
+
+// LOD (詳細度) ごとの描画範囲。どのLODも同じ頂点配列を参照する
+struct MeshLod {
+  uint32_t indexOffset = 0;   // indices 内の開始位置
+  uint32_t indexCount = 0;    // インデックス数
+  float error = 0.0f;         // 元の形状からの誤差 (モデル空間の距離)
+  uint32_t subMeshOffset = 0; // ModelData::subMeshes 内の開始位置
+  uint32_t subMeshCount = 0;  // このLODのサブメッシュ数 (0 の場合は LOD 全体を material で描く)
+};
+
 // モデルデータの構造体
 struct ModelData {
   std::vector<VertexData> vertices; // 頂点データ配列
-  std::vector<uint32_t> indices;    // インデックスデータ
-  MaterialData material;            // マテリアルデータ
-  Node rootNode;                    // 階層
+  std::vector<uint32_t> indices;    // インデックスデータ (全LODを連結したもの)
+  std::vector<MeshLod> lods;        // LOD (空の場合は indices 全体が LOD0)
+  std::vector<SubMesh> subMeshes;   // サブメッシュ (全LOD分。空の場合は indices 全体を material で描く)
+  std::vector<MaterialData> materials; // サブメッシュが参照するマテリアル (テクスチャが同じものは1つにまとめる)
+  MaterialData material;            // 代表のマテリアル (最初にテクスチャを持つもの)
+  NodeHierarchy nodes;              // 階層
+  Bounds bounds;                    // 全頂点の範囲 (モデル空間。スキンを持つモデルはバインドポーズのもの)
+  std::vector<VertexInfluence> influences; // 頂点ごとのジョイントの影響 (vertices と同じ並び。空ならスキンなし)
+  std::vector<Joint> joints;               // スキンのジョイント
+  std::vector<AnimationClip> animations;   // 読み込んだままのアニメーション (圧縮した後は空)
+  std::vector<CompressedAnimationClip> compressedAnimations; // 圧縮したアニメーション (実行時はこちらを使う)
 };
 
 #endif // MODEL_TYPES_H
\ No newline at end of file
@@ -2,9 +2,33 @@
 
 #include "Types/GraphicsTypes.h"
 
+#include <string>
+
 #ifndef PARTICLE_TYPES_H
 #define PARTICLE_TYPES_H
 
+// トレイル履歴の最大点数 (1パーティクルあたり)
+static const uint32_t kMaxTrailPoints = 32;
+
+// トレイル履歴を持たないパーティクルの trailIndex
+static const uint32_t kInvalidTrailIndex = 0xFFFFFFFFu;
+
+// トレイル用の位置履歴 (固定長リングバッファ)
+// 約400バイトあるので Particle には持たせず、グループの TrailHistoryPool に置く
+struct TrailHistory {
+  Vector3 positions[kMaxTrailPoints]; // 位置の履歴
+  uint32_t head = 0;                  // 次に書き込むインデックス
+  uint32_t count = 0;                 // 有効な点の数
+};
+
+// トレイルの帯メッシュの頂点
+// 頂点はワールド座標で書き込み、色は持ち主のパーティクルの色 (寿命のフェードや colorOverLife を反映済み)
+struct TrailVertexData {
+  Vector4 position; // ワールド座標系での位置
+  Vector2 texcoord; // UV座標 (u: 0 = 先頭, 1 = 末尾)
+  Vector4 color;    // パーティクルの色
+}; // 16+8+16=40バイト
+
 // パーティクルの構造体
 struct Particle {
   Transform transform; // 変換行列
@@ -17,6 +41,9 @@ struct Particle {
   Vector2 uvTranslate = { 0.0f, 0.0f };
   float uvRotate = 0.0f;
   Vector2 uvScale = { 1.0f, 1.0f };
+
+  // トレイル形状用の位置履歴の番号 (TrailHistoryPool 内。kInvalidTrailIndex = 履歴なし)
+  uint32_t trailIndex = kInvalidTrailIndex;
 };
 
 // パーティクルインスタンスデータの構造体
@@ -97,4 +124,39 @@ struct PlaneSettings {
     Vector4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
 };
 
+// トレイル(リボン)用の詳細設定構造体
+struct TrailSettings {
+    uint32_t maxPoints = 16;         // 履歴点の数 (2 - kMaxTrailPoints)
+    float minVertexDistance = 0.05f; // この距離以上移動したら新しい履歴点を追加
+    float headWidth = 0.2f;          // 先頭の幅
+    float tailWidth = 0.0f;          // 末尾の幅
+
+    // カラー設定 (先頭から末尾へ線形補間)
+    Vector4 headColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+    Vector4 tailColor = { 1.0f, 1.0f, 1.0f, 0.0f };
+};
+
+// サブエミッターを起動するタイミング
+enum class SubEmitterTrigger : uint32_t {
+    Birth = 0, // 親パーティクルの発生時
+    Death = 1, // 親パーティクルの消滅時
+};
+
+// サブエミッターの設定 (親パーティクルの発生/消滅位置から別グループのパーティクルを発生させる)
+struct SubEmitterSettings {
+    std::string groupName;                               // 発生させるパーティクルグループ名
+    SubEmitterTrigger trigger = SubEmitterTrigger::Death; // 起動タイミング
+    uint32_t count = 1;                                  // 1イベントあたりの発生数
+};
+
+// サブエミッターの起動イベント
+// 更新中に積まれ、次の更新の先頭でまとめて処理される
+struct ParticleEvent {
+    Vector3 position;          // 発生位置 (親パーティクルの位置)
+    uint32_t sourceGroupId;    // 発生元グループのID
+    SubEmitterTrigger trigger; // 起動タイミング
+    uint32_t sequence;         // 発生元グループ内での通し番号 (バッファごとに一意。並び替えを決定的にするため)
+    uint32_t subEmitterIndex;  // 発生元エミッターのサブエミッター番号
+};
+
 #endif // PARTICLE_TYPES_H
\ No newline at end of file
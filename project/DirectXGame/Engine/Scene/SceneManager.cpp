@@ -1,7 +1,6 @@
 #include "SceneManager.h"
 #include "DX12Context.h"
 #include "TextureManager.h"
-#include "ParticleManager.h"
 #include "Logger.h" // ログ用
 
 std::unique_ptr<SceneManager> SceneManager::instance_ = nullptr;
@@ -55,12 +54,11 @@ void SceneManager::Update() {
             // (B) シーンの初期化（ロード命令の書き込み）
             currentScene_->Initialize();
 
-            // (C) コマンド実行と待機
+            // (C) コマンド実行と待機 (転送用の領域は完了したフェンスで再利用される)
             DX12Context::GetInstance()->ExecuteInitialCommandAndSync();
 
-            // (D) 中間リソースの解放
-            TextureManager::GetInstance()->ReleaseIntermediateResources();
-            ParticleManager::GetInstance()->ReleaseIntermediateResources();
+            // (D) ここまでのテクスチャ読み込みの集計 (キャッシュの有無で起動時間を比べる)
+            TextureManager::GetInstance()->LogLoadStats();
         }
     }
 
@@ -19,7 +19,7 @@ struct Material {
     int isRing;
     int isCylinder;
     float alphaReference;
-    float padding2_1;
+    int isTrail;
 
     int enableDissolve;
     float dissolveThreshold;
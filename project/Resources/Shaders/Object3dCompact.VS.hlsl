@@ -0,0 +1,34 @@
+#include "Object3dCommon.hlsli"
+
+// 圧縮頂点 (CompactVertexData / CompactHalfVertexData) 用の頂点シェーダー
+// 法線は八面体エンコードした R16G16_SNORM、UV は R16G16_FLOAT
+// 位置は float3 (w は入力アセンブラーが 1 で埋める) か、w = 1 の half4
+
+ConstantBuffer<TransformationMatrix> gTransformationMatrix : register(b0);
+
+struct CompactVertexShaderInput
+{
+    float4 position : POSITION0;
+    float2 normal : NORMAL0;
+    float2 texcoord : TEXCOORD0;
+};
+
+// CPU 側の VertexQuantization::DecodeOctahedral と同じ計算にすること
+float3 DecodeOctahedral(float2 encoded)
+{
+    float3 n = float3(encoded.xy, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float t = saturate(-n.z);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return normalize(n);
+}
+
+VertexShaderOutput main(CompactVertexShaderInput input) {
+    VertexShaderOutput output;
+    float3 normal = DecodeOctahedral(input.normal);
+    output.position = mul(input.position, gTransformationMatrix.WVP);
+    output.texcoord = input.texcoord;
+    output.normal = normalize(mul(normal, (float3x3) gTransformationMatrix.WorldInverseTranspose));
+    output.worldPosition = mul(input.position, gTransformationMatrix.World).xyz;
+    return output;
+}
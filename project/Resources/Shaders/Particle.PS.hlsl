@@ -39,6 +39,9 @@ PixelShaderOutput main(VertexShaderOutput input) {
             }
             vertexColor.a *= fadeFactor;
         }
+    } else if (gMaterial.isTrail != 0) {
+        // u: 0 = head, 1 = tail
+        vertexColor = lerp(gMaterial.innerColor, gMaterial.outerColor, saturate(uv.x));
     }
     
     output.color = gMaterial.color * textureColor * input.color * vertexColor;
@@ -0,0 +1,28 @@
+#include "Particle.hlsli"
+
+// Vertex shader for trail ribbons (TrailVertexData).
+// Vertices are written in world space and carry the owning particle's color,
+// so the single instance only supplies the view-projection matrix.
+
+StructuredBuffer<ParticleInstanceData> gParticleData : register(t0);
+
+struct TrailVertexShaderInput
+{
+    float4 position : POSITION0;
+    float2 texcoord : TEXCOORD0;
+    float4 color : COLOR0;
+};
+
+VertexShaderOutput main(TrailVertexShaderInput input, uint instanceID : SV_InstanceID) {
+    VertexShaderOutput output;
+    output.position = mul(input.position, gParticleData[instanceID].WVP);
+
+    float4 transformedUV = mul(float4(input.texcoord, 0.0f, 1.0f), gParticleData[instanceID].uvTransform);
+    output.texcoord = transformedUV.xy;
+
+    output.color = input.color * gParticleData[instanceID].color;
+    output.normal = float3(0.0f, 0.0f, -1.0f);
+    output.worldPosition = input.position.xyz;
+
+    return output;
+}
@@ -0,0 +1,107 @@
+// ============================================================
+// BlockCompressorBenchmark — ブロック圧縮 (BlockCompressor) の速さの計測
+//   ・形式ごとに、1スレッドと全コアで1秒あたりに圧縮できるブロック数
+//   ・画像を指定しなければ、グラデーションとノイズの画像 (アルファ付き) を使う
+// 使い方: BlockCompressorBenchmark [--image PNG] [--size N] [--seconds S] [--quick]
+// ============================================================
+#include "BlockCompressor.h"
+#include "PngImage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace BlockCompressor;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+TextureCooker::RgbaImage MakeImage(uint32_t size) {
+    std::mt19937 randomEngine(1u);
+    std::uniform_int_distribution<int> noise(-12, 12);
+    TextureCooker::RgbaImage image;
+    image.width = size;
+    image.height = size;
+    image.pixels.resize(static_cast<size_t>(size) * size * 4);
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            uint8_t* pixel = &image.pixels[(static_cast<size_t>(y) * size + x) * 4];
+            const int base[4] = {static_cast<int>(x * 255 / size), static_cast<int>(y * 255 / size),
+                                 static_cast<int>((x + y) * 127 / size), ((x / 16 + y / 16) % 2) ? 255 : 96};
+            for (int c = 0; c < 4; ++c) {
+                pixel[c] = static_cast<uint8_t>(std::clamp(base[c] + noise(randomEngine), 0, 255));
+            }
+        }
+    }
+    return image;
+}
+
+// 1秒あたりのブロック数 (少なくとも1回、指定した時間まで繰り返す)
+double MeasureBlocksPerSecond(const TextureCooker::RgbaImage& image, Format format, uint32_t threadCount,
+                              double seconds, std::vector<uint8_t>& output) {
+    const double blocksPerImage = static_cast<double>((image.width + 3) / 4) * ((image.height + 3) / 4);
+    const Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    uint32_t repeatCount = 0;
+    do {
+        Compress({image.pixels.data(), image.width, image.height, image.width * 4u}, format, output.data(), 0,
+                 threadCount);
+        ++repeatCount;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < seconds);
+    return blocksPerImage * repeatCount / elapsed;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string imagePath;
+    uint32_t size = 2048;
+    double seconds = 1.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--image") == 0 && i + 1 < argc) {
+            imagePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = std::max(4ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            size = 256;
+            seconds = 0.0;
+        } else {
+            std::fprintf(stderr, "usage: %s [--image PNG] [--size N] [--seconds S] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    TextureCooker::RgbaImage image;
+    if (imagePath.empty()) {
+        image = MakeImage(size);
+    } else if (!PngImage::Load(imagePath, image)) {
+        return 1;
+    }
+
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("image %u x %u (%u blocks), %u hardware threads\n", image.width, image.height,
+                ((image.width + 3) / 4) * ((image.height + 3) / 4), hardwareThreads);
+
+    const Format formats[] = {Format::BC1, Format::BC3, Format::BC4, Format::BC5, Format::BC7};
+    const char* const formatNames[] = {"BC1", "BC3", "BC4", "BC5", "BC7"};
+    for (size_t f = 0; f < std::size(formats); ++f) {
+        std::vector<uint8_t> output(GetSizeInBytes(formats[f], image.width, image.height));
+        const double single = MeasureBlocksPerSecond(image, formats[f], 1, seconds, output);
+        const double parallel = MeasureBlocksPerSecond(image, formats[f], 0, seconds, output);
+        std::printf("%s: 1 thread %7.2f Mblocks/s, all threads %7.2f Mblocks/s (x%.1f)\n", formatNames[f],
+                    single / 1e6, parallel / 1e6, parallel / single);
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+// ============================================================
+// ClusterCullBenchmark — メッシュレットの分割 (MeshletBuilder) と CPU カリング (ClusterCuller) の計測
+//   ・モデルを Model と同じく最適化してから分割する時間
+//   ・モデルを見下ろすランダムなカメラごとのカリングの時間と、残る三角形の割合 (視錐台のみ / 裏面も)
+//   ・比較として、三角形ごとに視錐台の判定をして詰める総当たりの時間
+// 使い方: ClusterCullBenchmark <OBJ ファイル> [--cameras N] [--quick]
+// ============================================================
+#include "ClusterCuller.h"
+#include "MeshOptimizer.h"
+#include "MeshletBuilder.h"
+#include "ObjLoader.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace MathGenerators;
+using namespace MathUtils;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 左手系で target を向くカメラのビュー行列 (行ベクトル規約)
+Matrix4x4 MakeLookAt(const Vector3& eye, const Vector3& target) {
+    const Vector3 zAxis = Normalize(Subtract(target, eye));
+    const Vector3 xAxis = Normalize(Cross({0.0f, 1.0f, 0.0f}, zAxis));
+    const Vector3 yAxis = Cross(zAxis, xAxis);
+    Matrix4x4 view = MakeIdentity4x4();
+    const Vector3 axes[3] = {xAxis, yAxis, zAxis};
+    for (int j = 0; j < 3; ++j) {
+        view.m[0][j] = axes[j].x;
+        view.m[1][j] = axes[j].y;
+        view.m[2][j] = axes[j].z;
+        view.m[3][j] = -Dot(axes[j], eye);
+    }
+    return view;
+}
+
+// 三角形ごとに視錐台の判定をして、残ったものを詰める (3頂点が同じ平面の外なら捨てる)
+void CullTriangles(const std::vector<uint32_t>& indices, const std::vector<VertexData>& vertices,
+                   const ClusterCuller::Frustum& frustum, std::vector<uint32_t>& output) {
+    output.clear();
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        bool isOutside = false;
+        for (const Vector4& plane : frustum.planes) {
+            uint32_t outsideCount = 0;
+            for (size_t k = 0; k < 3; ++k) {
+                const Vector4& p = vertices[indices[i + k]].position;
+                outsideCount += plane.x * p.x + plane.y * p.y + plane.z * p.z + plane.w < 0.0f ? 1 : 0;
+            }
+            if (outsideCount == 3) {
+                isOutside = true;
+                break;
+            }
+        }
+        if (!isOutside) {
+            output.insert(output.end(), {indices[i], indices[i + 1], indices[i + 2]});
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path path;
+    uint32_t cameraCount = 2000;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--cameras") == 0 && i + 1 < argc) {
+            cameraCount = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            cameraCount = 20;
+        } else if (path.empty() && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s <obj file> [--cameras N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty() || !std::filesystem::exists(path)) {
+        std::fprintf(stderr, "usage: %s <obj file> [--cameras N] [--quick]\n", argv[0]);
+        return 1;
+    }
+
+    ModelData modelData;
+    if (!ObjLoader::Load(path.parent_path().generic_string(), path.filename().string(), modelData) ||
+        modelData.indices.empty()) {
+        std::fprintf(stderr, "failed to load %s\n", path.generic_string().c_str());
+        return 1;
+    }
+    MeshOptimizer::Optimize(modelData, path.filename().string());
+
+    const Clock::time_point buildStart = Clock::now();
+    const MeshletData meshletData = MeshletBuilder::Build(modelData.indices, modelData.vertices);
+    const double buildMs = ElapsedMs(buildStart);
+    const size_t triangleCount = modelData.indices.size() / 3;
+    std::printf("%s: %zu triangles -> %zu meshlets (%.1f triangles each), build %.3f ms\n",
+                path.filename().string().c_str(), triangleCount, meshletData.meshlets.size(),
+                static_cast<double>(triangleCount) / meshletData.meshlets.size(), buildMs);
+
+    // モデルを包む球の外から見下ろすカメラ
+    Vector3 minimum = {modelData.vertices[0].position.x, modelData.vertices[0].position.y, modelData.vertices[0].position.z};
+    Vector3 maximum = minimum;
+    for (const VertexData& vertex : modelData.vertices) {
+        minimum = {std::min(minimum.x, vertex.position.x), std::min(minimum.y, vertex.position.y),
+                   std::min(minimum.z, vertex.position.z)};
+        maximum = {std::max(maximum.x, vertex.position.x), std::max(maximum.y, vertex.position.y),
+                   std::max(maximum.z, vertex.position.z)};
+    }
+    const Vector3 center = {(minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f};
+    const Vector3 extent = Subtract(maximum, center);
+    const float radius = std::sqrt(Dot(extent, extent));
+    const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 1280.0f / 720.0f, 0.1f, radius * 10.0f);
+
+    std::mt19937 randomEngine(1u);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<ClusterCuller::Frustum> frustums;
+    std::vector<Vector3> eyes;
+    for (uint32_t c = 0; c < cameraCount; ++c) {
+        const Vector3 eye = {center.x + unit(randomEngine) * radius * 1.5f, center.y + (unit(randomEngine) + 1.2f) * radius,
+                             center.z + unit(randomEngine) * radius * 1.5f};
+        const Vector3 target = {center.x + unit(randomEngine) * radius, center.y, center.z + unit(randomEngine) * radius};
+        frustums.push_back(ClusterCuller::ExtractFrustum(Multiply(MakeLookAt(eye, target), projection)));
+        eyes.push_back(eye);
+    }
+
+    std::vector<uint32_t> culled;
+    std::vector<uint32_t> groupOffsets;
+    uint64_t checksum = 0;
+    for (bool cullBackfaces : {false, true}) {
+        uint64_t keptTriangles = 0;
+        uint64_t keptMeshlets = 0;
+        const Clock::time_point start = Clock::now();
+        for (uint32_t c = 0; c < cameraCount; ++c) {
+            const ClusterCuller::CullStats stats =
+                ClusterCuller::Cull(meshletData, frustums[c], eyes[c], cullBackfaces, culled, groupOffsets);
+            keptTriangles += stats.visibleTriangles;
+            keptMeshlets += stats.visibleMeshlets;
+        }
+        const double microseconds = ElapsedMs(start) * 1000.0 / cameraCount;
+        std::printf("%-28s %8.2f us/camera, meshlets kept %5.1f%%, triangles kept %5.1f%%\n",
+                    cullBackfaces ? "meshlets (frustum+backface)" : "meshlets (frustum)", microseconds,
+                    100.0 * keptMeshlets / (static_cast<double>(meshletData.meshlets.size()) * cameraCount),
+                    100.0 * keptTriangles / (static_cast<double>(triangleCount) * cameraCount));
+        checksum += keptTriangles;
+    }
+
+    uint64_t bruteForceTriangles = 0;
+    const Clock::time_point start = Clock::now();
+    for (uint32_t c = 0; c < cameraCount; ++c) {
+        CullTriangles(modelData.indices, modelData.vertices, frustums[c], culled);
+        bruteForceTriangles += culled.size() / 3;
+    }
+    const double microseconds = ElapsedMs(start) * 1000.0 / cameraCount;
+    std::printf("%-28s %8.2f us/camera, triangles kept %5.1f%%\n", "triangles (frustum)", microseconds,
+                100.0 * bruteForceTriangles / (static_cast<double>(triangleCount) * cameraCount));
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum + bruteForceTriangles));
+    return 0;
+}
@@ -0,0 +1,151 @@
+// ============================================================
+// EnemySpawnBenchmark — 敵の生成コストの計測 (ShootingScene::CreateEnemies のモデル共有と、以前の敵ごとの個別モデルの比較)
+//   ・個別モデル: 敵ごとにメッシュを読み込み (以前はキャッシュが無かったので毎回ファイルから変換)、
+//     頂点・インデックス・マテリアルのバッファを作る
+//   ・モデル共有: メッシュの読み込みとバッファは1回だけで、敵ごとにマテリアルの定数バッファだけを作る
+//   ・どちらも時間と、敵がそろった時点のバッファの合計バイト数
+// GPU バッファは Model と同じ大きさのメモリで代用する (定数バッファは DX12Context と同じく256バイト単位)
+// 使い方: EnemySpawnBenchmark <モデルファイル> [--count N] [--quick]
+// ============================================================
+#include "GraphicsTypes.h"
+#include "MeshImporter.h"
+#include "VertexQuantization.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// DX12Context::CreateBufferResource と同じく256バイトの倍数に切り上げる
+size_t AlignBufferSize(size_t sizeInBytes) {
+    return (sizeInBytes + 255) & ~static_cast<size_t>(255);
+}
+
+// Model が作るバッファの代わり
+struct ModelBuffers {
+    std::vector<uint8_t> vertices;
+    std::vector<uint8_t> indices;
+    std::vector<uint8_t> material;
+
+    size_t GetBytes() const { return vertices.size() + indices.size() + material.size(); }
+};
+
+// Object3d::GetInstanceMaterial が作る定数バッファの代わり
+std::vector<uint8_t> CreateMaterialBuffer() {
+    std::vector<uint8_t> buffer(AlignBufferSize(sizeof(Material)));
+    Material material{};
+    material.enableDissolve = 1;
+    material.dissolveThreshold = 1.0f;
+    material.dissolveEdgeRange = 0.05f;
+    std::memcpy(buffer.data(), &material, sizeof(Material));
+    return buffer;
+}
+
+// Model::CreateVertexResource / CreateIndexResource / CreateMaterialResource と同じ大きさのバッファを作る
+ModelBuffers CreateModelBuffers(const ModelData& modelData) {
+    ModelBuffers buffers;
+    const VertexFormat format = VertexQuantization::ChooseVertexFormat(modelData.vertices, kVertexFormatFull);
+    buffers.vertices.resize(AlignBufferSize(VertexQuantization::GetVertexStride(format) * modelData.vertices.size()));
+    VertexQuantization::EncodeVertices(modelData.vertices, format, buffers.vertices.data());
+
+    // 頂点数 65536 以下なら16bit
+    if (modelData.vertices.size() <= 0x10000) {
+        buffers.indices.resize(AlignBufferSize(sizeof(uint16_t) * modelData.indices.size()));
+        uint16_t* indices16 = reinterpret_cast<uint16_t*>(buffers.indices.data());
+        for (size_t i = 0; i < modelData.indices.size(); ++i) {
+            indices16[i] = static_cast<uint16_t>(modelData.indices[i]);
+        }
+    } else {
+        buffers.indices.resize(AlignBufferSize(sizeof(uint32_t) * modelData.indices.size()));
+        std::memcpy(buffers.indices.data(), modelData.indices.data(), sizeof(uint32_t) * modelData.indices.size());
+    }
+    buffers.material = CreateMaterialBuffer();
+    return buffers;
+}
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path path;
+    uint32_t count = 100;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            count = 4;
+        } else if (path.empty() && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s <model file> [--count N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty() || !std::filesystem::exists(path)) {
+        std::fprintf(stderr, "usage: %s <model file> [--count N] [--quick]\n", argv[0]);
+        return 1;
+    }
+    const std::string directoryPath = path.parent_path().generic_string();
+    const std::string filename = path.filename().string();
+
+    // キャッシュを読み書きしない (以前の方式に合わせ、ベンチマークの実行場所にも書き出さない)
+    MeshImporter::Settings settings;
+    settings.useCache = false;
+
+    uint64_t checksum = 0;
+
+    // 個別モデル: 敵ごとに読み込んでバッファを作る (以前の方式)
+    Clock::time_point start = Clock::now();
+    size_t uniqueBytes = 0;
+    {
+        std::vector<ModelBuffers> models;
+        for (uint32_t i = 0; i < count; ++i) {
+            const MeshImporter::MeshSource source = MeshImporter::Load(directoryPath, filename, settings);
+            models.push_back(CreateModelBuffers(source.modelData));
+        }
+        for (const ModelBuffers& model : models) {
+            uniqueBytes += model.GetBytes();
+            checksum += model.vertices[0] + model.indices.size();
+        }
+    }
+    const double uniqueMilliseconds = ElapsedMs(start);
+
+    // モデル共有: 読み込みとバッファは1回だけで、敵ごとにマテリアルの定数バッファを作る
+    start = Clock::now();
+    size_t sharedBytes = 0;
+    {
+        const MeshImporter::MeshSource source = MeshImporter::Load(directoryPath, filename, settings);
+        const ModelBuffers model = CreateModelBuffers(source.modelData);
+        std::vector<std::vector<uint8_t>> materials;
+        for (uint32_t i = 0; i < count; ++i) {
+            materials.push_back(CreateMaterialBuffer());
+        }
+        sharedBytes = model.GetBytes();
+        for (const std::vector<uint8_t>& material : materials) {
+            sharedBytes += material.size();
+            checksum += material[0];
+        }
+    }
+    const double sharedMilliseconds = ElapsedMs(start);
+
+    std::printf("%s: %u enemies\n", filename.c_str(), count);
+    std::printf("%-18s %10.2f ms %10.1f KB\n", "model per enemy", uniqueMilliseconds, uniqueBytes / 1024.0);
+    std::printf("%-18s %10.2f ms %10.1f KB\n", "shared model", sharedMilliseconds, sharedBytes / 1024.0);
+    std::printf("speedup %.1fx, memory %.1f%%\n", uniqueMilliseconds / sharedMilliseconds,
+                100.0 * sharedBytes / uniqueBytes);
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
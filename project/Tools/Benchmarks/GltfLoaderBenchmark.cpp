@@ -0,0 +1,185 @@
+// ============================================================
+// GltfLoaderBenchmark — glTF 専用リーダー (GltfLoader) の読み込み時間の計測
+//   ・指定した glTF / GLB ファイル (省略時は Resources の plane.gltf) の1回の読み込み時間
+//   ・N x N の格子を、同じ頂点・三角形の glTF (.gltf + .bin) と OBJ として一時ディレクトリに書き、
+//     GltfLoader と ObjLoader の読み込み時間を比べる (バイナリのバッファを直接読む分の差)
+// 使い方: GltfLoaderBenchmark [glTF ファイル] [--grid N] [--repeat N] [--quick]
+// ============================================================
+#include "GltfLoader.h"
+#include "ObjLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 1回の読み込みにかかった時間 (ms) の中央値
+template <class Load> double Measure(uint32_t repeat, Load load) {
+    std::vector<double> samples;
+    for (uint32_t i = 0; i < repeat; ++i) {
+        ModelData modelData;
+        const Clock::time_point start = Clock::now();
+        if (!load(modelData)) {
+            std::fprintf(stderr, "failed to load\n");
+            std::exit(1);
+        }
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// (grid + 1)^2 頂点、grid^2 * 2 三角形の XZ 平面の格子を glTF と OBJ で書く
+void WriteGrid(const std::filesystem::path& directory, uint32_t grid) {
+    const uint32_t side = grid + 1;
+    const uint32_t vertexCount = side * side;
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texcoords;
+    std::vector<uint32_t> indices;
+    for (uint32_t z = 0; z < side; ++z) {
+        for (uint32_t x = 0; x < side; ++x) {
+            const float u = static_cast<float>(x) / grid;
+            const float v = static_cast<float>(z) / grid;
+            positions.insert(positions.end(), {u * 2.0f - 1.0f, 0.0f, v * 2.0f - 1.0f});
+            normals.insert(normals.end(), {0.0f, 1.0f, 0.0f});
+            texcoords.insert(texcoords.end(), {u, v});
+        }
+    }
+    for (uint32_t z = 0; z < grid; ++z) {
+        for (uint32_t x = 0; x < grid; ++x) {
+            const uint32_t i = z * side + x;
+            indices.insert(indices.end(), {i, i + side, i + 1, i + 1, i + side, i + side + 1});
+        }
+    }
+
+    // glTF: 位置・法線・UV・インデックスの順に1つのバッファへ
+    const size_t positionBytes = positions.size() * sizeof(float);
+    const size_t texcoordBytes = texcoords.size() * sizeof(float);
+    const size_t indexBytes = indices.size() * sizeof(uint32_t);
+    std::ofstream bin(directory / "grid.bin", std::ios::binary);
+    bin.write(reinterpret_cast<const char*>(positions.data()), positionBytes);
+    bin.write(reinterpret_cast<const char*>(normals.data()), positionBytes);
+    bin.write(reinterpret_cast<const char*>(texcoords.data()), texcoordBytes);
+    bin.write(reinterpret_cast<const char*>(indices.data()), indexBytes);
+    bin.close();
+
+    std::ofstream gltf(directory / "grid.gltf");
+    gltf << R"({"asset": {"version": "2.0"}, "scene": 0, "scenes": [{"nodes": [0]}], "nodes": [{"name": "Grid", "mesh": 0}],)"
+         << R"("meshes": [{"primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2}, "indices": 3}]}],)"
+         << R"("accessors": [)"
+         << R"({"bufferView": 0, "componentType": 5126, "count": )" << vertexCount << R"(, "type": "VEC3"},)"
+         << R"({"bufferView": 1, "componentType": 5126, "count": )" << vertexCount << R"(, "type": "VEC3"},)"
+         << R"({"bufferView": 2, "componentType": 5126, "count": )" << vertexCount << R"(, "type": "VEC2"},)"
+         << R"({"bufferView": 3, "componentType": 5125, "count": )" << indices.size() << R"(, "type": "SCALAR"}],)"
+         << R"("bufferViews": [)"
+         << R"({"buffer": 0, "byteOffset": 0, "byteLength": )" << positionBytes << "},"
+         << R"({"buffer": 0, "byteOffset": )" << positionBytes << R"(, "byteLength": )" << positionBytes << "},"
+         << R"({"buffer": 0, "byteOffset": )" << positionBytes * 2 << R"(, "byteLength": )" << texcoordBytes << "},"
+         << R"({"buffer": 0, "byteOffset": )" << positionBytes * 2 + texcoordBytes << R"(, "byteLength": )" << indexBytes
+         << "}],"
+         << R"("buffers": [{"uri": "grid.bin", "byteLength": )" << positionBytes * 2 + texcoordBytes + indexBytes << "}]}";
+    gltf.close();
+
+    // OBJ: 同じ頂点を v / vt / vn に書き、三角形は位置・UV・法線に同じ番号を使う
+    std::ofstream obj(directory / "grid.obj");
+    char line[96];
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        obj.write(line, std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", positions[i * 3], positions[i * 3 + 1],
+                                      positions[i * 3 + 2]));
+    }
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        obj.write(line, std::snprintf(line, sizeof(line), "vt %.6f %.6f\n", texcoords[i * 2], texcoords[i * 2 + 1]));
+    }
+    obj << "vn 0 1 0\n";
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        obj.write(line, std::snprintf(line, sizeof(line), "f %u/%u/1 %u/%u/1 %u/%u/1\n", indices[i] + 1, indices[i] + 1,
+                                      indices[i + 1] + 1, indices[i + 1] + 1, indices[i + 2] + 1, indices[i + 2] + 1));
+    }
+}
+
+uint64_t GetDirectorySize(const std::filesystem::path& directory, const char* gltfName, const char* binName) {
+    uint64_t size = std::filesystem::file_size(directory / gltfName);
+    if (binName != nullptr) {
+        size += std::filesystem::file_size(directory / binName);
+    }
+    return size;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path path;
+    uint32_t grid = 256;
+    uint32_t repeat = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc) {
+            grid = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            grid = 32;
+            repeat = 3;
+        } else if (path.empty() && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s [gltf file] [--grid N] [--repeat N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (!path.empty()) {
+        const std::string directory = path.parent_path().generic_string();
+        const std::string fileName = path.filename().string();
+        ModelData modelData;
+        if (!GltfLoader::Load(directory, fileName, modelData)) {
+            std::fprintf(stderr, "failed to load %s\n", path.generic_string().c_str());
+            return 1;
+        }
+        const double ms = Measure(repeat, [&](ModelData& output) { return GltfLoader::Load(directory, fileName, output); });
+        std::printf("%s: %zu vertices, %zu triangles, %u nodes, %.3f ms/load\n", fileName.c_str(),
+                    modelData.vertices.size(), modelData.indices.size() / 3, modelData.nodes.GetNodeCount(), ms);
+    }
+
+    const std::filesystem::path workDirectory = std::filesystem::temp_directory_path() / "GltfLoaderBenchmark";
+    std::filesystem::create_directories(workDirectory);
+    WriteGrid(workDirectory, grid);
+    const std::string directory = workDirectory.generic_string();
+
+    ModelData gltfData;
+    ModelData objData;
+    if (!GltfLoader::Load(directory, "grid.gltf", gltfData) || !ObjLoader::Load(directory, "grid.obj", objData)) {
+        std::fprintf(stderr, "failed to load the generated grid\n");
+        return 1;
+    }
+    // 同じ格子を読めていること (ObjLoader は頂点をまとめるので、数は三角形で比べる)
+    if (gltfData.indices.size() != objData.indices.size()) {
+        std::fprintf(stderr, "triangle counts differ: %zu vs %zu\n", gltfData.indices.size(), objData.indices.size());
+        return 1;
+    }
+
+    const double gltfMs = Measure(repeat, [&](ModelData& output) { return GltfLoader::Load(directory, "grid.gltf", output); });
+    const double objMs = Measure(repeat, [&](ModelData& output) { return ObjLoader::Load(directory, "grid.obj", output); });
+    const double gltfMegabytes = GetDirectorySize(workDirectory, "grid.gltf", "grid.bin") / (1024.0 * 1024.0);
+    const double objMegabytes = GetDirectorySize(workDirectory, "grid.obj", nullptr) / (1024.0 * 1024.0);
+    std::filesystem::remove_all(workDirectory);
+
+    std::printf("grid %ux%u: %zu vertices, %zu triangles, median of %u loads\n", grid, grid, gltfData.vertices.size(),
+                gltfData.indices.size() / 3, repeat);
+    std::printf("%-10s %8.2f MB %10.3f ms/load %10.1f MB/s\n", "gltf", gltfMegabytes, gltfMs,
+                gltfMegabytes / (gltfMs / 1000.0));
+    std::printf("%-10s %8.2f MB %10.3f ms/load %10.1f MB/s (%.1fx)\n", "obj", objMegabytes, objMs,
+                objMegabytes / (objMs / 1000.0), objMs / gltfMs);
+    return 0;
+}
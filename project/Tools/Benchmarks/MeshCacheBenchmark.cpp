@@ -0,0 +1,115 @@
+// ============================================================
+// MeshCacheBenchmark — 変換済みキャッシュ (CookedMesh) の効果の計測
+//   ・初回の読み込み: 専用のリーダーで読み、並べ替え・LOD・範囲を求めてキャッシュを書き出す
+//   ・2回目以降の読み込み: キャッシュをマップして使う
+// どちらも Model::LoadMeshSource と同じ MeshImporter::Load で読む
+// キャッシュは一時フォルダの Resources/Cache/Models に書き出し、終わったら消す
+// 使い方: MeshCacheBenchmark <モデルファイル> [--repeat N] [--quick]
+// ============================================================
+#include "MeshImporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Sample {
+    double milliseconds = 0.0;
+    bool isCached = false;
+    size_t indexCount = 0;
+};
+
+Sample LoadOnce(const std::filesystem::path& path) {
+    const MeshImporter::MeshSource source =
+        MeshImporter::Load(path.parent_path().generic_string(), path.filename().string(), MeshImporter::Settings{});
+    Sample sample;
+    sample.milliseconds = source.loadMilliseconds;
+    sample.isCached = source.isCached;
+    sample.indexCount = source.isCached ? source.cooked.indices.size() : source.modelData.indices.size();
+    return sample;
+}
+
+double Median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path path;
+    uint32_t repeat = 20;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            repeat = 2;
+        } else if (path.empty() && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s <model file> [--repeat N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty() || !std::filesystem::exists(path)) {
+        std::fprintf(stderr, "usage: %s <model file> [--repeat N] [--quick]\n", argv[0]);
+        return 1;
+    }
+
+    // キャッシュはカレントディレクトリからの相対パスに書かれるので、一時フォルダに移る
+    path = std::filesystem::absolute(path);
+    const std::filesystem::path workDirectory = std::filesystem::temp_directory_path() / "MeshCacheBenchmark";
+    const std::filesystem::path cacheDirectory = workDirectory / "Resources/Cache/Models";
+    std::filesystem::create_directories(workDirectory);
+    std::filesystem::current_path(workDirectory);
+
+    std::vector<double> coldSamples;
+    std::vector<double> warmSamples;
+    size_t coldIndexCount = 0;
+    size_t warmIndexCount = 0;
+    bool isValid = true;
+    for (uint32_t i = 0; i < repeat; ++i) {
+        // 毎回キャッシュを消して初回の読み込みにする
+        std::error_code ec;
+        std::filesystem::remove_all(cacheDirectory, ec);
+        const Sample cold = LoadOnce(path);
+        const Sample warm = LoadOnce(path);
+        isValid = isValid && !cold.isCached && warm.isCached;
+        coldSamples.push_back(cold.milliseconds);
+        warmSamples.push_back(warm.milliseconds);
+        coldIndexCount = cold.indexCount;
+        warmIndexCount = warm.indexCount;
+    }
+
+    uintmax_t cacheSize = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory, ec)) {
+        cacheSize += entry.file_size();
+    }
+
+    const double coldMs = Median(coldSamples);
+    const double warmMs = Median(warmSamples);
+    std::printf("%s: %.1f KB source, %.1f KB cache, %zu indices (all LODs)\n", path.filename().string().c_str(),
+                std::filesystem::file_size(path) / 1024.0, cacheSize / 1024.0, warmIndexCount);
+    std::printf("%-36s %10.3f ms/load\n", "first load (read + process + save)", coldMs);
+    std::printf("%-36s %10.3f ms/load\n", "cached load (mapped)", warmMs);
+    std::printf("%-36s %10.1fx\n", "speedup", coldMs / warmMs);
+
+    std::filesystem::current_path(workDirectory.parent_path());
+    std::filesystem::remove_all(workDirectory, ec);
+
+    // キャッシュが使われなかった・内容が変わった場合は失敗にする
+    if (!isValid || coldIndexCount != warmIndexCount) {
+        std::fprintf(stderr, "cache was not used or does not match the source\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,154 @@
+// ============================================================
+// ModelLoadBenchmark — ModelManager::LoadModelsAsync のワーカー数による読み込み時間の変化の計測
+//   ・フォルダ内の全モデル (.obj / .gltf / .glb) を --copies 回ずつ並べ、ワーカーで読む
+//   ・ModelManager と同じく、各ワーカーは印を付けて (中でスレッドを立てない) キューから1件ずつ取る
+//   ・キャッシュなし (毎回変換) とキャッシュあり (マップするだけ) のそれぞれで、1本のときとの比を出す
+// 使い方: ModelLoadBenchmark <モデルのフォルダ> [--copies N] [--max-workers N] [--quick]
+// ============================================================
+#include "MeshImporter.h"
+#include "Thread/ThreadUtility.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Request {
+    std::string directory;
+    std::string fileName;
+};
+
+// workerCount 本のワーカーで全件を読み終えるまでの時間 (ms)
+double MeasureBatch(const std::vector<Request>& requests, uint32_t workerCount, bool useCache, size_t& indexCount) {
+    MeshImporter::Settings settings;
+    settings.useCache = useCache;
+    std::atomic<size_t> next = 0;
+    std::atomic<size_t> totalIndices = 0;
+
+    const Clock::time_point start = Clock::now();
+    std::vector<std::thread> workers;
+    for (uint32_t w = 0; w < workerCount; ++w) {
+        workers.emplace_back([&] {
+            ThreadUtility::MarkWorkerThread();
+            for (size_t i = next++; i < requests.size(); i = next++) {
+                const MeshImporter::MeshSource source = MeshImporter::Load(requests[i].directory, requests[i].fileName, settings);
+                totalIndices += source.isCached ? source.cooked.indices.size() : source.modelData.indices.size();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    indexCount = totalIndices;
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path directory;
+    uint32_t copies = 8;
+    uint32_t maxWorkers = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--copies") == 0 && i + 1 < argc) {
+            copies = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--max-workers") == 0 && i + 1 < argc) {
+            maxWorkers = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            copies = 1;
+            maxWorkers = 2;
+        } else if (directory.empty() && argv[i][0] != '-') {
+            directory = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s <model directory> [--copies N] [--max-workers N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (directory.empty() || !std::filesystem::is_directory(directory)) {
+        std::fprintf(stderr, "usage: %s <model directory> [--copies N] [--max-workers N] [--quick]\n", argv[0]);
+        return 1;
+    }
+
+    // キャッシュはカレントディレクトリからの相対パスに書かれるので、一時フォルダに移る
+    directory = std::filesystem::absolute(directory);
+    const std::filesystem::path workDirectory = std::filesystem::temp_directory_path() / "ModelLoadBenchmark";
+    std::filesystem::create_directories(workDirectory);
+    std::filesystem::current_path(workDirectory);
+
+    std::vector<Request> models;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+        const std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".obj" || extension == ".gltf" || extension == ".glb")) {
+            models.push_back({entry.path().parent_path().generic_string(), entry.path().filename().string()});
+        }
+    }
+    std::sort(models.begin(), models.end(), [](const Request& a, const Request& b) { return a.fileName < b.fileName; });
+
+    // 1回ずつ読んで、どのリーダーで読めたかとキャッシュを用意する
+    // (同じファイルを並行して初めて読むと、キャッシュの書き出しが重なるので先に済ませる)
+    bool isValid = !models.empty();
+    for (const Request& model : models) {
+        const MeshImporter::MeshSource source = MeshImporter::Load(model.directory, model.fileName, {});
+        std::printf("%-24s %-6s %8zu indices\n", model.fileName.c_str(), MeshImporter::GetReaderName(source.reader),
+                    source.modelData.indices.size());
+        isValid = isValid && source.reader != MeshImporter::Reader::None;
+    }
+
+    std::vector<Request> requests;
+    for (uint32_t c = 0; c < copies; ++c) {
+        requests.insert(requests.end(), models.begin(), models.end());
+    }
+
+    // 1, 2, 4, ... 本と、ModelManager::StartWorkers と同じ (コア数 - 1) 本
+    std::vector<uint32_t> workerCounts;
+    for (uint32_t count = 1; count <= maxWorkers; count *= 2) {
+        workerCounts.push_back(count);
+    }
+    const unsigned int hardwareCount = std::thread::hardware_concurrency();
+    const uint32_t managerWorkers = hardwareCount > 1 ? hardwareCount - 1 : 1;
+    if (managerWorkers <= maxWorkers && std::find(workerCounts.begin(), workerCounts.end(), managerWorkers) == workerCounts.end()) {
+        workerCounts.push_back(managerWorkers);
+        std::sort(workerCounts.begin(), workerCounts.end());
+    }
+
+    std::printf("%zu models x %u copies, %u hardware threads (ModelManager uses %u workers)\n", models.size(), copies,
+                hardwareCount, managerWorkers);
+    std::printf("%8s %14s %8s %14s %8s\n", "workers", "convert ms", "scale", "cached ms", "scale");
+    double convertBase = 0.0;
+    double cachedBase = 0.0;
+    size_t convertIndices = 0;
+    size_t cachedIndices = 0;
+    for (uint32_t workerCount : workerCounts) {
+        const double convertMs = MeasureBatch(requests, workerCount, false, convertIndices);
+        const double cachedMs = MeasureBatch(requests, workerCount, true, cachedIndices);
+        if (workerCount == 1) {
+            convertBase = convertMs;
+            cachedBase = cachedMs;
+        }
+        std::printf("%8u %14.2f %7.2fx %14.2f %7.2fx%s\n", workerCount, convertMs, convertBase / convertMs, cachedMs,
+                    cachedBase / cachedMs, workerCount == managerWorkers ? "  <- ModelManager" : "");
+        isValid = isValid && convertIndices == cachedIndices;
+    }
+
+    std::error_code ec;
+    std::filesystem::current_path(workDirectory.parent_path());
+    std::filesystem::remove_all(workDirectory, ec);
+
+    if (!isValid) {
+        std::fprintf(stderr, "a model failed to load or the cache does not match the source\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+// ============================================================
+// ObjLoaderBenchmark — OBJ 専用リーダー (ObjLoader) の読み込み時間の計測
+//   ・1ファイルを描画スレッドから読む場合 (チャンクに分けて並列に解析)
+//   ・1ファイルをワーカーから読む場合 (1スレッドで解析)
+//   ・ModelManager と同じく (コア数 - 1) 本のワーカーで同じファイルを一斉に読む場合
+//     ワーカーの印を付けた場合と付けない場合 (ワーカーの中でさらにスレッドを立てる) を比べる
+// 使い方: ObjLoaderBenchmark <OBJ ファイル> [--repeat N] [--quick]
+// ============================================================
+#include "ObjLoader.h"
+#include "Thread/ThreadUtility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Target {
+    std::string directory;
+    std::string fileName;
+    uint64_t fileSize = 0;
+};
+
+// 1回の読み込みにかかった時間 (ms) の中央値
+double MeasureSingle(const Target& target, uint32_t repeat, bool isWorker) {
+    std::vector<double> samples;
+    std::thread thread([&] {
+        if (isWorker) {
+            ThreadUtility::MarkWorkerThread();
+        }
+        for (uint32_t i = 0; i < repeat; ++i) {
+            ModelData modelData;
+            const Clock::time_point start = Clock::now();
+            if (!ObjLoader::Load(target.directory, target.fileName, modelData)) {
+                std::fprintf(stderr, "failed to load %s\n", target.fileName.c_str());
+                std::exit(1);
+            }
+            samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+    });
+    thread.join();
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// workerCount 本のスレッドで、それぞれ repeat 回読み込んだ全体の時間 (ms)
+double MeasurePool(const Target& target, uint32_t repeat, uint32_t workerCount, bool markWorkers) {
+    const Clock::time_point start = Clock::now();
+    std::vector<std::thread> workers;
+    for (uint32_t w = 0; w < workerCount; ++w) {
+        workers.emplace_back([&] {
+            if (markWorkers) {
+                ThreadUtility::MarkWorkerThread();
+            }
+            for (uint32_t i = 0; i < repeat; ++i) {
+                ModelData modelData;
+                ObjLoader::Load(target.directory, target.fileName, modelData);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path path;
+    uint32_t repeat = 50;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            repeat = 3;
+        } else if (path.empty() && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s <obj file> [--repeat N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (path.empty() || !std::filesystem::exists(path)) {
+        std::fprintf(stderr, "usage: %s <obj file> [--repeat N] [--quick]\n", argv[0]);
+        return 1;
+    }
+
+    Target target;
+    target.directory = path.parent_path().generic_string();
+    target.fileName = path.filename().string();
+    target.fileSize = std::filesystem::file_size(path);
+
+    ModelData modelData;
+    if (!ObjLoader::Load(target.directory, target.fileName, modelData)) {
+        std::fprintf(stderr, "failed to load %s\n", path.generic_string().c_str());
+        return 1;
+    }
+    const double megabytes = static_cast<double>(target.fileSize) / (1024.0 * 1024.0);
+    std::printf("%s: %.1f KB, %zu vertices, %zu triangles\n", target.fileName.c_str(), target.fileSize / 1024.0,
+                modelData.vertices.size(), modelData.indices.size() / 3);
+
+    const double mainMs = MeasureSingle(target, repeat, false);
+    const double workerMs = MeasureSingle(target, repeat, true);
+    std::printf("%-28s %10.3f ms/load %10.1f MB/s\n", "render thread (parallel)", mainMs, megabytes / (mainMs / 1000.0));
+    std::printf("%-28s %10.3f ms/load %10.1f MB/s\n", "worker (single thread)", workerMs, megabytes / (workerMs / 1000.0));
+
+    // ModelManager::StartWorkers と同じ本数
+    const unsigned int hardwareCount = std::thread::hardware_concurrency();
+    const uint32_t workerCount = hardwareCount > 1 ? hardwareCount - 1 : 1;
+    const double loads = static_cast<double>(workerCount) * repeat;
+    const double markedMs = MeasurePool(target, repeat, workerCount, true);
+    const double unmarkedMs = MeasurePool(target, repeat, workerCount, false);
+    std::printf("%u workers x %u loads:\n", workerCount, repeat);
+    std::printf("%-28s %10.3f ms/load %10.1f MB/s\n", "  marked workers", markedMs / loads,
+                megabytes * loads / (markedMs / 1000.0));
+    std::printf("%-28s %10.3f ms/load %10.1f MB/s\n", "  unmarked (nested threads)", unmarkedMs / loads,
+                megabytes * loads / (unmarkedMs / 1000.0));
+    return 0;
+}
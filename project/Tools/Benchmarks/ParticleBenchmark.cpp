@@ -0,0 +1,450 @@
+// ============================================================
+// ParticleBenchmark — D3D12 なしでのパーティクルシミュレーションの計測
+//   ・グループ数 × 1グループあたりのパーティクル数 × 有効な機能 の組み合わせを総当たりで計測する
+//   ・1フレームの処理は ParticleManager::Update から GPU への受け渡しを除いたもの
+//     (エミッター → グループ共通UV → 更新と寿命切れの削除 → インスタンスデータ/トレイルの書き込み)
+//   ・寿命切れで消えた数だけ毎フレーム発生させ、パーティクル数を一定に保つ
+//   ・1パーティクルあたりの時間と、読み書きしたメモリ量から求めた帯域を表示し、--json で JSON に書き出す
+//   ・寿命に応じて変化する値を、焼き込んだ LUT で引く場合とキーの折れ線を毎回評価する場合で比べる (キーの数ごと)
+// 使い方: ParticleBenchmark [--groups 1,4,16] [--particles 256,1024,4096] [--features base,fields,...]
+//                           [--frames F] [--json path] [--quick]
+// ============================================================
+#include "MatrixGenerators.h"
+#include "ParticleEmitter.h"
+#include "ParticleSimulation.h"
+#include "ParticleTrail.h"
+
+#include <externals/nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// ParticleManager と同じ上限 (1グループあたり)
+const uint32_t kNumMaxParticle = 4096;
+const uint32_t kNumMaxTrailParticle = 2048;
+const uint32_t kNumMaxTrailVertex = kNumMaxTrailParticle * kMaxTrailPoints * 2;
+const uint32_t kNumMaxTrailIndex = kNumMaxTrailParticle * (kMaxTrailPoints - 1) * 6;
+
+const float kDeltaTime = 1.0f / 60.0f;
+
+// 有効にする機能 (ビットの組み合わせ)
+enum Feature : uint32_t {
+    kFeatureNone = 0,
+    kFeatureFields = 1 << 0, // 加速フィールドと重力
+    kFeatureCurves = 1 << 1, // colorOverLife / sizeOverLife / dampingOverLife
+    kFeatureUV = 1 << 2,     // 個別UVアニメーション
+    kFeatureTrail = 1 << 3,  // トレイル (インスタンスの代わりに帯メッシュを書き込む)
+};
+
+struct FeatureSet {
+    const char* name;
+    uint32_t flags;
+};
+
+const FeatureSet kFeatureSets[] = {
+    {"base", kFeatureNone},
+    {"fields", kFeatureFields},
+    {"curves", kFeatureCurves},
+    {"uv", kFeatureUV},
+    {"trail", kFeatureTrail},
+    {"all", kFeatureFields | kFeatureCurves | kFeatureUV},
+};
+
+// 1グループ分の状態 (ParticleManager::ParticleGroup の CPU 側)
+struct Group {
+    ParticleEmitter emitter;
+    std::list<Particle> particles;
+    TrailHistoryPool trailPool;
+    Matrix4x4 uvTransform{};
+    uint32_t eventSequence = 0;
+};
+
+struct Result {
+    std::string feature;
+    uint32_t groupCount = 0;
+    uint32_t particlesPerGroup = 0;
+    uint32_t frameCount = 0;
+    double nsPerParticle = 0.0;       // 1フレームの全処理
+    double updateNsPerParticle = 0.0; // エミッター・更新・削除・発生
+    double packNsPerParticle = 0.0;   // インスタンスデータ/トレイルの書き込み
+    double bytesPerParticle = 0.0;    // 1フレームで読み書きしたバイト数 (見積もり)
+    double bandwidthGBps = 0.0;
+};
+
+ParticleEmitter MakeEmitter(uint32_t flags) {
+    ParticleEmitter emitter;
+    emitter.isEmit = false; // 発生は寿命切れの補充だけで行う
+
+    ParticleGenerateSettings& gs = emitter.generateSettings;
+    gs.isRandomVelocity = true;
+    gs.isRandomLifeTime = true;
+    gs.lifeTimeMin = 1.0f;
+    gs.lifeTimeMax = 3.0f;
+
+    if (flags & kFeatureFields) {
+        emitter.fieldSettings.isAccelerationFieldActive = true;
+        emitter.fieldSettings.isGravityFieldActive = true;
+    }
+    if (flags & kFeatureCurves) {
+        gs.colorOverLife = ParticleGradient({{0.0f, {1.0f, 0.8f, 0.2f, 1.0f}}, {0.5f, {1.0f, 0.2f, 0.1f, 0.8f}}, {1.0f, {0.2f, 0.2f, 0.2f, 0.0f}}});
+        gs.colorOverLife.isActive = true;
+        gs.sizeOverLife = ParticleCurve({{0.0f, 0.5f}, {0.3f, 1.5f}, {1.0f, 0.0f}});
+        gs.sizeOverLife.isActive = true;
+        gs.dampingOverLife = ParticleCurve({{0.0f, 0.0f}, {1.0f, 2.0f}});
+        gs.dampingOverLife.isActive = true;
+    }
+    if (flags & kFeatureUV) {
+        ParticleUVAnimationSettings& uvas = emitter.uvAnimationSettings;
+        uvas.isActive = true;
+        uvas.isIndividual = true;
+        uvas.scrollSpeed = {0.5f, 0.0f};
+        uvas.rotateSpeed = 0.2f;
+    }
+    if (flags & kFeatureTrail) {
+        emitter.SetShapeType(ParticleShapeType::Trail);
+    }
+    return emitter;
+}
+
+// ParticleManager::EmitToGroup と同じ (サブエミッターのイベントはバッファに積むだけ)
+void EmitToGroup(Group& group, uint32_t count, std::mt19937& randomEngine, ParticleEventBuffer& events) {
+    const TrailShape* trailShape = group.emitter.GetTrailShape();
+    for (uint32_t i = 0; i < count; ++i) {
+        ParticleSimulation::PushSubEmitterEvents(group.emitter, 0, SubEmitterTrigger::Birth, group.emitter.transform.translate,
+                                                 group.eventSequence, events);
+        Particle particle = ParticleSimulation::MakeParticle(group.emitter.transform.translate, group.emitter.generateSettings, randomEngine);
+        if (trailShape && group.trailPool.GetActiveCount() < kNumMaxTrailParticle) {
+            particle.trailIndex = group.trailPool.Allocate();
+            ParticleTrail::PushPoint(group.trailPool.Get(particle.trailIndex), particle.transform.translate, trailShape->settings);
+        }
+        group.particles.push_back(particle);
+    }
+}
+
+// 出力先 (Upload Heap の代わり)
+struct Output {
+    std::vector<ParticleInstanceData> instances = std::vector<ParticleInstanceData>(kNumMaxParticle);
+    std::vector<TrailVertexData> trailVertices = std::vector<TrailVertexData>(kNumMaxTrailVertex);
+    std::vector<uint32_t> trailIndices = std::vector<uint32_t>(kNumMaxTrailIndex);
+};
+
+Result Run(const FeatureSet& feature, uint32_t groupCount, uint32_t particlesPerGroup, uint32_t frameCount, Output& output) {
+    std::mt19937 randomEngine(2024u);
+    ParticleEventBuffer events;
+
+    std::vector<Group> groups(groupCount);
+    for (Group& group : groups) {
+        group.emitter = MakeEmitter(feature.flags);
+        EmitToGroup(group, particlesPerGroup, randomEngine, events);
+    }
+
+    ParticleSimulation::InstancePackContext context;
+    context.viewProjection = MathGenerators::MakeIdentity4x4();
+    context.billboard = MathGenerators::MakeIdentity4x4();
+    const Vector3 cameraPosition = {0.0f, 0.0f, -20.0f};
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration updateTime{};
+    Clock::duration packTime{};
+    uint64_t trailBytes = 0;
+
+    // 寿命がばらけるまで進めてから計測する
+    const uint32_t warmupFrames = 60;
+    for (uint32_t frame = 0; frame < warmupFrames + frameCount; ++frame) {
+        const bool isMeasured = frame >= warmupFrames;
+        events.Clear();
+
+        const Clock::time_point updateStart = Clock::now();
+        for (Group& group : groups) {
+            group.eventSequence = 0;
+            if (ParticleSimulation::UpdateEmitter(group.emitter, !group.particles.empty(), kDeltaTime)) {
+                EmitToGroup(group, group.emitter.count, randomEngine, events);
+            }
+            group.uvTransform = ParticleSimulation::UpdateGlobalUVAnimation(group.emitter.uvAnimationSettings, kDeltaTime);
+
+            uint32_t deadCount = 0;
+            for (auto it = group.particles.begin(); it != group.particles.end();) {
+                if (!ParticleSimulation::UpdateParticle(*it, group.emitter, kDeltaTime, true, &group.trailPool)) {
+                    ParticleSimulation::PushSubEmitterEvents(group.emitter, 0, SubEmitterTrigger::Death, it->transform.translate,
+                                                             group.eventSequence, events);
+                    if (it->trailIndex != kInvalidTrailIndex) {
+                        group.trailPool.Free(it->trailIndex);
+                    }
+                    it = group.particles.erase(it);
+                    ++deadCount;
+                    continue;
+                }
+                ++it;
+            }
+            // 消えた分を補充してパーティクル数を一定に保つ
+            EmitToGroup(group, deadCount, randomEngine, events);
+        }
+
+        const Clock::time_point packStart = Clock::now();
+        for (Group& group : groups) {
+            if (feature.flags & kFeatureTrail) {
+                const uint32_t indexCount = ParticleSimulation::PackTrails(
+                    group.particles, group.trailPool, group.emitter, cameraPosition,
+                    output.trailVertices.data(), kNumMaxTrailVertex, output.trailIndices.data(), kNumMaxTrailIndex);
+                if (isMeasured) {
+                    // 帯1本の頂点数 = (インデックス数 / 6 + 1) * 2
+                    trailBytes += indexCount * sizeof(uint32_t) + (indexCount / 3) * sizeof(TrailVertexData);
+                }
+            } else {
+                context.globalUvTransform = group.uvTransform;
+                ParticleSimulation::PackInstances(group.particles, group.emitter, context, output.instances.data(), kNumMaxParticle);
+            }
+        }
+        const Clock::time_point packEnd = Clock::now();
+
+        if (isMeasured) {
+            updateTime += packStart - updateStart;
+            packTime += packEnd - packStart;
+        }
+    }
+
+    const double samples = static_cast<double>(groupCount) * particlesPerGroup * frameCount;
+    const double updateNs = std::chrono::duration<double, std::nano>(updateTime).count();
+    const double packNs = std::chrono::duration<double, std::nano>(packTime).count();
+
+    // 帯域の見積もり: 更新で Particle を読み書きし、書き込みで Particle を読んで出力を書く
+    // (トレイルは履歴の読み書きと帯メッシュの出力を加える)
+    double bytes = samples * (sizeof(Particle) * 3.0);
+    if (feature.flags & kFeatureTrail) {
+        bytes += samples * sizeof(TrailHistory) * 2.0 + static_cast<double>(trailBytes);
+    } else {
+        bytes += samples * sizeof(ParticleInstanceData);
+    }
+
+    Result result;
+    result.feature = feature.name;
+    result.groupCount = groupCount;
+    result.particlesPerGroup = particlesPerGroup;
+    result.frameCount = frameCount;
+    result.updateNsPerParticle = updateNs / samples;
+    result.packNsPerParticle = packNs / samples;
+    result.nsPerParticle = (updateNs + packNs) / samples;
+    result.bytesPerParticle = bytes / samples;
+    result.bandwidthGBps = bytes / (updateNs + packNs); // バイト/ナノ秒 = GB/s
+    return result;
+}
+
+// LUT と折れ線の評価の比較の結果
+struct CurveResult {
+    uint32_t keyCount = 0;
+    double lutNsPerSample = 0.0;
+    double directNsPerSample = 0.0;
+    float maxError = 0.0f;
+    float checksum = 0.0f; // 最適化で計算を消されないように表示する
+};
+
+// 時間順のキーの折れ線を毎回評価する (LUT を使わない場合)
+float EvaluateCurveDirect(const std::vector<CurveKey>& sortedKeys, float t) {
+    t = std::clamp(t, 0.0f, 1.0f);
+    if (t <= sortedKeys.front().time) {
+        return sortedKeys.front().value;
+    }
+    for (size_t i = 1; i < sortedKeys.size(); ++i) {
+        if (t <= sortedKeys[i].time) {
+            const CurveKey& a = sortedKeys[i - 1];
+            const CurveKey& b = sortedKeys[i];
+            const float span = b.time - a.time;
+            const float s = span > 0.0f ? (t - a.time) / span : 1.0f;
+            return a.value + (b.value - a.value) * s;
+        }
+    }
+    return sortedKeys.back().value;
+}
+
+CurveResult RunCurveComparison(uint32_t keyCount, uint32_t sampleCount) {
+    std::mt19937 randomEngine(keyCount);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<CurveKey> keys = {{0.0f, unit(randomEngine)}, {1.0f, unit(randomEngine)}};
+    while (keys.size() < keyCount) {
+        keys.push_back({unit(randomEngine), unit(randomEngine)});
+    }
+    std::sort(keys.begin(), keys.end(), [](const CurveKey& a, const CurveKey& b) { return a.time < b.time; });
+    const ParticleCurve curve(keys);
+
+    // パーティクルごとの寿命の割合 (ばらばらの順に引く)
+    std::vector<float> times(sampleCount);
+    for (float& t : times) {
+        t = unit(randomEngine);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    float lutSum = 0.0f;
+    const Clock::time_point lutStart = Clock::now();
+    for (float t : times) {
+        lutSum += curve.Sample(t);
+    }
+    const Clock::time_point directStart = Clock::now();
+    float directSum = 0.0f;
+    for (float t : times) {
+        directSum += EvaluateCurveDirect(keys, t);
+    }
+    const Clock::time_point directEnd = Clock::now();
+
+    CurveResult result;
+    result.keyCount = keyCount;
+    result.lutNsPerSample = std::chrono::duration<double, std::nano>(directStart - lutStart).count() / sampleCount;
+    result.directNsPerSample = std::chrono::duration<double, std::nano>(directEnd - directStart).count() / sampleCount;
+    for (float t : times) {
+        result.maxError = std::max(result.maxError, std::abs(curve.Sample(t) - EvaluateCurveDirect(keys, t)));
+    }
+    result.checksum = lutSum + directSum;
+    return result;
+}
+
+std::vector<uint32_t> ParseList(const char* text) {
+    std::vector<uint32_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        values.push_back(static_cast<uint32_t>(std::strtoul(item.c_str(), nullptr, 10)));
+    }
+    return values;
+}
+
+std::vector<FeatureSet> ParseFeatures(const char* text) {
+    std::vector<FeatureSet> features;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        for (const FeatureSet& feature : kFeatureSets) {
+            if (item == feature.name) {
+                features.push_back(feature);
+            }
+        }
+    }
+    return features;
+}
+
+void PrintUsage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--groups 1,4,16] [--particles 256,1024,4096] [--features base,fields,curves,uv,trail,all]\n"
+                 "          [--frames F] [--json path] [--quick]\n",
+                 program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<uint32_t> groupCounts = {1, 4, 16};
+    std::vector<uint32_t> particleCounts = {256, 1024, 4096};
+    std::vector<FeatureSet> features(std::begin(kFeatureSets), std::end(kFeatureSets));
+    uint32_t frameCount = 120;
+    uint32_t curveSampleCount = 1u << 22;
+    std::string jsonPath;
+
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--groups") == 0 && hasValue) {
+            groupCounts = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--particles") == 0 && hasValue) {
+            particleCounts = ParseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--features") == 0 && hasValue) {
+            features = ParseFeatures(argv[++i]);
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            groupCounts = {2};
+            particleCounts = {128};
+            frameCount = 5;
+            curveSampleCount = 1u << 12;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (groupCounts.empty() || particleCounts.empty() || features.empty() || frameCount == 0) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    for (uint32_t particleCount : particleCounts) {
+        if (particleCount == 0 || particleCount > kNumMaxParticle) {
+            std::fprintf(stderr, "particles per group must be 1..%u\n", kNumMaxParticle);
+            return 1;
+        }
+    }
+
+    Output output;
+    std::vector<Result> results;
+    std::printf("%-8s %7s %10s %12s %12s %12s %10s %10s\n", "feature", "groups", "particles", "ns/particle", "update ns", "pack ns",
+                "bytes/p", "GB/s");
+    for (const FeatureSet& feature : features) {
+        for (uint32_t groupCount : groupCounts) {
+            for (uint32_t particleCount : particleCounts) {
+                const Result result = Run(feature, groupCount, particleCount, frameCount, output);
+                std::printf("%-8s %7u %10u %12.1f %12.1f %12.1f %10.0f %10.2f\n", result.feature.c_str(), result.groupCount,
+                            result.particlesPerGroup, result.nsPerParticle, result.updateNsPerParticle, result.packNsPerParticle,
+                            result.bytesPerParticle, result.bandwidthGBps);
+                results.push_back(result);
+            }
+        }
+    }
+
+    // LUT と折れ線の評価の比較
+    std::vector<CurveResult> curveResults;
+    std::printf("\n%-8s %12s %12s %12s %12s\n", "keys", "LUT ns", "direct ns", "max error", "checksum");
+    for (uint32_t keyCount : {2u, 4u, 8u, 16u, 32u}) {
+        const CurveResult result = RunCurveComparison(keyCount, curveSampleCount);
+        std::printf("%-8u %12.2f %12.2f %12.6f %12.1f\n", result.keyCount, result.lutNsPerSample,
+                    result.directNsPerSample, result.maxError, result.checksum);
+        curveResults.push_back(result);
+    }
+
+    if (!jsonPath.empty()) {
+        nlohmann::json root;
+        root["benchmark"] = "ParticleBenchmark";
+        root["frames"] = frameCount;
+        root["sizeofParticle"] = sizeof(Particle);
+        root["sizeofInstanceData"] = sizeof(ParticleInstanceData);
+        nlohmann::json& entries = root["results"];
+        entries = nlohmann::json::array();
+        for (const Result& result : results) {
+            entries.push_back({
+                {"feature", result.feature},
+                {"groups", result.groupCount},
+                {"particlesPerGroup", result.particlesPerGroup},
+                {"nsPerParticle", result.nsPerParticle},
+                {"updateNsPerParticle", result.updateNsPerParticle},
+                {"packNsPerParticle", result.packNsPerParticle},
+                {"bytesPerParticle", result.bytesPerParticle},
+                {"bandwidthGBps", result.bandwidthGBps},
+            });
+        }
+        nlohmann::json& curveEntries = root["curves"];
+        curveEntries = nlohmann::json::array();
+        for (const CurveResult& result : curveResults) {
+            curveEntries.push_back({
+                {"keys", result.keyCount},
+                {"lutNsPerSample", result.lutNsPerSample},
+                {"directNsPerSample", result.directNsPerSample},
+                {"maxError", result.maxError},
+            });
+        }
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::fprintf(stderr, "failed to open %s\n", jsonPath.c_str());
+            return 1;
+        }
+        file << root.dump(2) << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+// ============================================================
+// ParticleTrailBenchmark — トレイルパーティクルの更新と帯メッシュ書き込みの計測
+//   ・トレイル形状のパーティクルを N 個発生させ、履歴が埋まってから F フレーム分を計測する
+//   ・更新 (UpdateParticle + 履歴への追加) と書き込み (PackTrails) を別々に計り、
+//     1パーティクルあたりの時間と書き込みの帯域を表示する
+//   ・書き込み先は ParticleManager と同じ上限 (2048 本 × 32 点) の配列
+// 使い方: ParticleTrailBenchmark [--particles N] [--frames F] [--quick]
+// ============================================================
+#include "ParticleEmitter.h"
+#include "ParticleSimulation.h"
+#include "ParticleTrail.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <list>
+#include <random>
+#include <vector>
+
+namespace {
+
+// ParticleManager::kNumMaxTrailParticle と同じ
+const uint32_t kMaxTrailParticle = 2048;
+const uint32_t kMaxVertex = kMaxTrailParticle * kMaxTrailPoints * 2;
+const uint32_t kMaxIndex = kMaxTrailParticle * (kMaxTrailPoints - 1) * 6;
+
+const float kDeltaTime = 1.0f / 60.0f;
+const uint32_t kTrailPoints = 16; // 1本あたりの履歴点の数
+
+struct Result {
+    uint32_t particleCount = 0;
+    double updateNsPerParticle = 0.0;
+    double packNsPerParticle = 0.0;
+    double packBytesPerSecond = 0.0;
+    uint32_t indexCount = 0;
+};
+
+ParticleEmitter MakeTrailEmitter() {
+    ParticleEmitter emitter;
+    emitter.SetShapeType(ParticleShapeType::Trail);
+    TrailSettings& settings = emitter.GetTrailShape()->settings;
+    settings.maxPoints = kTrailPoints;
+    settings.minVertexDistance = 0.01f;
+
+    ParticleGenerateSettings& gs = emitter.generateSettings;
+    gs.isRandomVelocity = true;
+    gs.velocityMin = {-3.0f, -3.0f, -3.0f};
+    gs.velocityMax = {3.0f, 3.0f, 3.0f};
+    // 計測中に消滅しないよう寿命を長くする (色のフェードは計算される)
+    gs.isRandomLifeTime = false;
+    gs.fixedLifeTime = 1000.0f;
+    emitter.fieldSettings.isGravityFieldActive = true;
+    return emitter;
+}
+
+Result Run(uint32_t particleCount, uint32_t frameCount, std::vector<TrailVertexData>& vertices, std::vector<uint32_t>& indices) {
+    ParticleEmitter emitter = MakeTrailEmitter();
+    const TrailSettings& settings = emitter.GetTrailShape()->settings;
+    std::mt19937 randomEngine(12345u);
+
+    // ParticleManager::EmitToGroup と同じく、発生時に履歴を借りて始点を記録する
+    std::list<Particle> particles;
+    TrailHistoryPool trailPool;
+    for (uint32_t i = 0; i < particleCount; ++i) {
+        Particle particle = ParticleSimulation::MakeParticle({0.0f, 0.0f, 0.0f}, emitter.generateSettings, randomEngine);
+        particle.trailIndex = trailPool.Allocate();
+        ParticleTrail::PushPoint(trailPool.Get(particle.trailIndex), particle.transform.translate, settings);
+        particles.push_back(particle);
+    }
+
+    // 履歴が最大点数まで埋まるまで進めておく
+    for (uint32_t frame = 0; frame < settings.maxPoints * 2; ++frame) {
+        for (Particle& particle : particles) {
+            ParticleSimulation::UpdateParticle(particle, emitter, kDeltaTime, true, &trailPool);
+        }
+    }
+
+    const Vector3 cameraPosition = {0.0f, 5.0f, -20.0f};
+    using Clock = std::chrono::steady_clock;
+    Clock::duration updateTime{};
+    Clock::duration packTime{};
+    uint32_t indexCount = 0;
+
+    for (uint32_t frame = 0; frame < frameCount; ++frame) {
+        const Clock::time_point updateStart = Clock::now();
+        for (Particle& particle : particles) {
+            ParticleSimulation::UpdateParticle(particle, emitter, kDeltaTime, true, &trailPool);
+        }
+        const Clock::time_point packStart = Clock::now();
+        indexCount = ParticleSimulation::PackTrails(particles, trailPool, emitter, cameraPosition,
+                                                    vertices.data(), kMaxVertex, indices.data(), kMaxIndex);
+        const Clock::time_point packEnd = Clock::now();
+        updateTime += packStart - updateStart;
+        packTime += packEnd - packStart;
+    }
+
+    const double samples = static_cast<double>(particleCount) * frameCount;
+    const double packSeconds = std::chrono::duration<double>(packTime).count();
+    // 帯1本の頂点数 = 点数 * 2、インデックス数 = (点数 - 1) * 6
+    const double vertexBytes = static_cast<double>(indexCount / 6 + particleCount) * 2 * sizeof(TrailVertexData);
+    const double indexBytes = static_cast<double>(indexCount) * sizeof(uint32_t);
+
+    Result result;
+    result.particleCount = particleCount;
+    result.updateNsPerParticle = std::chrono::duration<double, std::nano>(updateTime).count() / samples;
+    result.packNsPerParticle = std::chrono::duration<double, std::nano>(packTime).count() / samples;
+    result.packBytesPerSecond = packSeconds > 0.0 ? (vertexBytes + indexBytes) * frameCount / packSeconds : 0.0;
+    result.indexCount = indexCount;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<uint32_t> particleCounts = {256, 1024, 2048};
+    uint32_t frameCount = 240;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--particles") == 0 && i + 1 < argc) {
+            particleCounts = {static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10))};
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            particleCounts = {256};
+            frameCount = 10;
+        } else {
+            std::fprintf(stderr, "usage: %s [--particles N] [--frames F] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<TrailVertexData> vertices(kMaxVertex);
+    std::vector<uint32_t> indices(kMaxIndex);
+
+    std::printf("sizeof(Particle) = %zu bytes, sizeof(TrailHistory) = %zu bytes (trail particles only)\n",
+                sizeof(Particle), sizeof(TrailHistory));
+    std::printf("%10s %14s %14s %12s %10s\n", "particles", "update ns/p", "pack ns/p", "pack MB/s", "indices");
+    for (uint32_t particleCount : particleCounts) {
+        if (particleCount == 0 || particleCount > kMaxTrailParticle) {
+            std::fprintf(stderr, "particles must be 1..%u\n", kMaxTrailParticle);
+            return 1;
+        }
+        const Result result = Run(particleCount, frameCount, vertices, indices);
+        std::printf("%10u %14.1f %14.1f %12.1f %10u\n", result.particleCount, result.updateNsPerParticle,
+                    result.packNsPerParticle, result.packBytesPerSecond / (1024.0 * 1024.0), result.indexCount);
+
+        // 全員の帯が書き込まれているか (履歴が埋まっていれば 1 本あたり (点数 - 1) * 6)
+        if (result.indexCount != particleCount * (kTrailPoints - 1) * 6) {
+            std::fprintf(stderr, "unexpected index count %u\n", result.indexCount);
+            return 1;
+        }
+    }
+    return 0;
+}
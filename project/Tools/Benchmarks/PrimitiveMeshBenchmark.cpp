@@ -0,0 +1,111 @@
+// ============================================================
+// PrimitiveMeshBenchmark — プリミティブの生成 (PrimitiveMesh) の速さ
+//   ・分割数 256 (上限) のリング・シリンダー (256 x 256)・平面 (256 x 256) を1つ作る時間
+//   ・以前の生成 (PrimitiveMeshReference。頂点ごとに sin/cos、push_back)、Build* (vector に作る)、
+//     Write* (確保済みの書き込み先に書く。ShapeMeshCache がアップロードバッファへ書くのと同じ) の比較
+// 使い方: PrimitiveMeshBenchmark [--division N] [--repeat N] [--quick]
+// ============================================================
+#include "PrimitiveMesh.h"
+#include "PrimitiveMeshReference.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 1回あたりの時間 (ミリ秒) の中央値
+template <class Generate> double MeasureMs(uint32_t repeat, Generate generate) {
+    std::vector<double> samples;
+    for (uint32_t i = 0; i < repeat; ++i) {
+        const Clock::time_point start = Clock::now();
+        generate();
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+// 形状ごとに3通りの生成を計る
+template <class Settings, class GetSize, class Build, class Write, class BuildReference>
+uint64_t Run(const char* name, const Settings& settings, uint32_t repeat, GetSize getSize, Build build, Write write,
+             BuildReference buildReference) {
+    const PrimitiveMeshSize size = getSize(settings);
+    std::vector<VertexData> vertices;
+    std::vector<uint32_t> indices;
+    uint64_t checksum = 0;
+
+    // 毎回新しい vector に作る (以前の Model::CreateRing などと同じ)
+    const double referenceMs = MeasureMs(repeat, [&] {
+        std::vector<VertexData> referenceVertices;
+        std::vector<uint32_t> referenceIndices;
+        buildReference(settings, referenceVertices, referenceIndices);
+        checksum += referenceIndices.back();
+    });
+    const double buildMs = MeasureMs(repeat, [&] {
+        std::vector<VertexData> builtVertices;
+        std::vector<uint32_t> builtIndices;
+        build(settings, builtVertices, builtIndices);
+        checksum += builtIndices.back();
+    });
+    vertices.resize(size.vertexCount);
+    indices.resize(size.indexCount);
+    const double writeMs = MeasureMs(repeat, [&] {
+        write(settings, vertices, indices);
+        checksum += indices.back();
+    });
+
+    std::printf("%-10s %7u %8u %12.3f %10.3f %10.3f %8.1fx\n", name, size.vertexCount, size.indexCount, referenceMs,
+                buildMs, writeMs, referenceMs / writeMs);
+    return checksum;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t division = 256;
+    uint32_t repeat = 50;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--division") == 0 && i + 1 < argc) {
+            division = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            repeat = 2;
+        } else {
+            std::fprintf(stderr, "usage: %s [--division N] [--repeat N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    RingSettings ring;
+    ring.division = division;
+    ring.midOuterRadius = 1.5f;
+    CylinderSettings cylinder;
+    cylinder.division = division;
+    cylinder.verticalDivision = division;
+    cylinder.bottomRadius = {2.0f, 1.5f};
+    PlaneSettings plane;
+    plane.divisionX = division;
+    plane.divisionY = division;
+
+    std::printf("division %u, median of %u runs\n", division, repeat);
+    std::printf("%-10s %7s %8s %12s %10s %10s %9s\n", "shape", "verts", "indices", "previous ms", "build ms",
+                "write ms", "speedup");
+    uint64_t checksum = 0;
+    checksum += Run("ring", ring, repeat, PrimitiveMesh::GetRingSize, PrimitiveMesh::BuildRing, PrimitiveMesh::WriteRing,
+                    PrimitiveMeshReference::BuildRing);
+    checksum += Run("cylinder", cylinder, repeat, PrimitiveMesh::GetCylinderSize, PrimitiveMesh::BuildCylinder,
+                    PrimitiveMesh::WriteCylinder, PrimitiveMeshReference::BuildCylinder);
+    checksum += Run("plane", plane, repeat, PrimitiveMesh::GetPlaneSize, PrimitiveMesh::BuildPlane,
+                    PrimitiveMesh::WritePlane, PrimitiveMeshReference::BuildPlane);
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,209 @@
+// ============================================================
+// SkinningBenchmark — CPU スキニングの1フレーム分の処理の計測 (Object3d::UpdateAnimation と同じ順)
+//   ・姿勢 (AnimationSampler::Sample) → ワールド行列 (NodeTransform) → パレット (Skinning::ComputePalette)
+//     → 頂点 (Skinning::SkinVertices) のそれぞれの時間
+//   ・比較として、頂点を4つの行列でそれぞれ変換してから重みで混ぜる素朴なスキニングの時間
+//   ・モデルは一直線につながった骨と、それを囲む円筒の頂点 (頂点ごとに近い4つの骨に重みを付ける)
+// 使い方: SkinningBenchmark [--vertices N] [--joints N] [--frames N] [--quick]
+// ============================================================
+#include "AnimationSampler.h"
+#include "NodeTransform.h"
+#include "Skinning.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numbers>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const float kBoneLength = 0.5f;
+
+struct Character {
+    NodeHierarchy nodes;
+    std::vector<Joint> joints;
+    std::vector<VertexData> vertices;
+    std::vector<VertexInfluence> influences;
+    AnimationClip clip;
+};
+
+// 骨を Y 方向に一直線に並べ、円筒の頂点を近い骨に割り当てる
+Character MakeCharacter(uint32_t vertexCount, uint32_t jointCount) {
+    Character character;
+    for (uint32_t j = 0; j < jointCount; ++j) {
+        const Vector3 offset = {0.0f, j == 0 ? 0.0f : kBoneLength, 0.0f};
+        NodeTransform::AddNode(character.nodes, "Bone" + std::to_string(j), MathGenerators::MakeTranslationMatrix(offset),
+                               static_cast<int32_t>(j) - 1);
+    }
+    std::vector<Matrix4x4> bindMatrices(jointCount);
+    NodeTransform::ComputeWorldMatrices(character.nodes, MathGenerators::MakeIdentity4x4(), bindMatrices);
+    for (uint32_t j = 0; j < jointCount; ++j) {
+        character.joints.push_back({j, MathUtils::Inverse(bindMatrices[j])});
+    }
+
+    const float height = kBoneLength * jointCount;
+    const uint32_t ringSize = 32;
+    character.vertices.resize(vertexCount);
+    character.influences.resize(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        const float angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(v % ringSize) / ringSize;
+        const float y = height * static_cast<float>(v / ringSize) / std::max(1u, vertexCount / ringSize);
+        VertexData& vertex = character.vertices[v];
+        vertex.position = {std::cos(angle) * 0.3f, y, std::sin(angle) * 0.3f, 1.0f};
+        vertex.texcoord = {static_cast<float>(v % ringSize) / ringSize, y / height};
+        vertex.normal = {std::cos(angle), 0.0f, std::sin(angle)};
+
+        // 近い4つの骨に、距離に応じた重みを付ける
+        VertexInfluence& influence = character.influences[v];
+        const float bone = y / kBoneLength;
+        for (int k = -1; k <= 2; ++k) {
+            const int32_t joint = static_cast<int32_t>(bone) + k;
+            if (joint >= 0 && joint < static_cast<int32_t>(jointCount)) {
+                Skinning::AddInfluence(influence, static_cast<uint32_t>(joint),
+                                       1.0f / (1.0f + std::abs(bone - 0.5f - static_cast<float>(joint))));
+            }
+        }
+    }
+    Skinning::NormalizeInfluences(character.influences, character.joints);
+
+    // 骨ごとに位相をずらして Z 軸まわりに揺らす (1秒、キー 30 個)
+    character.clip.duration = 1.0f;
+    const uint32_t keyCount = 30;
+    for (uint32_t j = 0; j < jointCount; ++j) {
+        NodeAnimation& track = character.clip.tracks.emplace_back();
+        track.nodeIndex = j;
+        for (uint32_t k = 0; k < keyCount; ++k) {
+            const float time = static_cast<float>(k) / (keyCount - 1);
+            const float angle = 0.3f * std::sin(2.0f * std::numbers::pi_v<float> * time + j * 0.4f);
+            track.rotate.push_back({time, {0.0f, 0.0f, std::sin(angle * 0.5f), std::cos(angle * 0.5f)}});
+        }
+        Animation::FillMissingKeys(track, character.nodes.localMatrices[j]);
+    }
+    return character;
+}
+
+// 比較用: 頂点を各行列で変換してから重みで混ぜる
+void SkinVerticesNaive(const std::vector<VertexData>& vertices, const std::vector<VertexInfluence>& influences,
+                       const std::vector<Matrix4x4>& palette, std::vector<VertexData>& output) {
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        const VertexData& source = vertices[v];
+        float position[3] = {};
+        float normal[3] = {};
+        for (int k = 0; k < 4; ++k) {
+            const float weight = influences[v].weights[k];
+            if (weight == 0.0f) {
+                continue;
+            }
+            const Matrix4x4& m = palette[influences[v].jointIndices[k]];
+            for (int c = 0; c < 3; ++c) {
+                position[c] += weight * (source.position.x * m.m[0][c] + source.position.y * m.m[1][c] +
+                                         source.position.z * m.m[2][c] + m.m[3][c]);
+                normal[c] += weight * (source.normal.x * m.m[0][c] + source.normal.y * m.m[1][c] + source.normal.z * m.m[2][c]);
+            }
+        }
+        const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        output[v].position = {position[0], position[1], position[2], 1.0f};
+        output[v].texcoord = source.texcoord;
+        output[v].normal = {normal[0] / length, normal[1] / length, normal[2] / length};
+    }
+}
+
+double ElapsedUs(Clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t vertexCount = 20000;
+    uint32_t jointCount = 64;
+    uint32_t frameCount = 300;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--vertices") == 0 && i + 1 < argc) {
+            vertexCount = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--joints") == 0 && i + 1 < argc) {
+            jointCount = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frameCount = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            vertexCount = 2000;
+            frameCount = 5;
+        } else {
+            std::fprintf(stderr, "usage: %s [--vertices N] [--joints N] [--frames N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    const Character character = MakeCharacter(vertexCount, jointCount);
+    AnimationSampler sampler;
+    sampler.Initialize(&character.clip);
+
+    std::vector<Matrix4x4> localMatrices(character.nodes.GetNodeCount());
+    std::vector<Matrix4x4> worldMatrices(character.nodes.GetNodeCount());
+    std::vector<Matrix4x4> palette(character.joints.size());
+    std::vector<VertexData> skinned(character.vertices.size());
+    std::vector<VertexData> naive(character.vertices.size());
+
+    double sampleUs = 0.0;
+    double worldUs = 0.0;
+    double paletteUs = 0.0;
+    double skinUs = 0.0;
+    double naiveUs = 0.0;
+    float maxDifference = 0.0f;
+    double checksum = 0.0;
+    for (uint32_t frame = 0; frame < frameCount; ++frame) {
+        const float time = std::fmod(frame / 60.0f, character.clip.duration);
+
+        Clock::time_point start = Clock::now();
+        localMatrices.assign(character.nodes.localMatrices.begin(), character.nodes.localMatrices.end());
+        sampler.Sample(time, localMatrices);
+        sampleUs += ElapsedUs(start);
+
+        start = Clock::now();
+        NodeTransform::ComputeWorldMatrices(character.nodes.parents, localMatrices, MathGenerators::MakeIdentity4x4(),
+                                            worldMatrices);
+        worldUs += ElapsedUs(start);
+
+        start = Clock::now();
+        Skinning::ComputePalette(character.joints, worldMatrices, palette);
+        paletteUs += ElapsedUs(start);
+
+        start = Clock::now();
+        Skinning::SkinVertices(character.vertices, character.influences, palette, skinned);
+        skinUs += ElapsedUs(start);
+
+        start = Clock::now();
+        SkinVerticesNaive(character.vertices, character.influences, palette, naive);
+        naiveUs += ElapsedUs(start);
+
+        for (size_t v = 0; v < skinned.size(); v += 97) {
+            maxDifference = std::max({maxDifference, std::abs(skinned[v].position.x - naive[v].position.x),
+                                      std::abs(skinned[v].position.y - naive[v].position.y),
+                                      std::abs(skinned[v].position.z - naive[v].position.z)});
+        }
+        checksum += skinned[frame % skinned.size()].position.x;
+    }
+
+    std::printf("%u vertices, %u joints, %u frames\n", vertexCount, jointCount, frameCount);
+    std::printf("%-16s %10.2f us/frame\n", "sample", sampleUs / frameCount);
+    std::printf("%-16s %10.2f us/frame\n", "world matrices", worldUs / frameCount);
+    std::printf("%-16s %10.2f us/frame\n", "palette", paletteUs / frameCount);
+    std::printf("%-16s %10.2f us/frame %8.1f Mvertices/s\n", "skin (blend)", skinUs / frameCount,
+                static_cast<double>(vertexCount) * frameCount / skinUs);
+    std::printf("%-16s %10.2f us/frame %8.1f Mvertices/s (%.2fx)\n", "skin (naive)", naiveUs / frameCount,
+                static_cast<double>(vertexCount) * frameCount / naiveUs, naiveUs / skinUs);
+    std::printf("max position difference %.2e\n", maxDifference);
+    std::printf("checksum %.4f\n", checksum);
+    return maxDifference < 1e-3f ? 0 : 1;
+}
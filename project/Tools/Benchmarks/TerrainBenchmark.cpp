@@ -0,0 +1,139 @@
+// ============================================================
+// TerrainBenchmark — 地形の四分木 (TerrainQuadtree) の計測
+//   ・四分木の作成 (ノードごとの誤差の計算) にかかる時間
+//   ・ランダムなカメラでの描くチャンクの選択 (Select) 1回あたりの時間と、選ばれたチャンク・三角形の数
+//     (全部を最も細かいチャンクで描いた場合の三角形数と比べる)
+//   ・接地用の高さの問い合わせ (GetHeight) 1回あたりの時間
+// 使い方: TerrainBenchmark [--resolution N] [--chunk-cells N] [--cameras N] [--quick]
+// ============================================================
+#include "TerrainQuadtree.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace MathGenerators;
+using namespace MathUtils;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+TerrainHeightfield MakeHeightfield(uint32_t resolution, std::mt19937& randomEngine) {
+    std::uniform_real_distribution<float> noise(0.0f, 0.3f);
+    TerrainHeightfield heightfield;
+    heightfield.resolution = resolution;
+    heightfield.origin = {-0.5f * resolution, -0.5f * resolution};
+    heightfield.cellSize = {1.0f, 1.0f};
+    heightfield.heights.reserve(static_cast<size_t>(resolution + 1) * (resolution + 1));
+    for (uint32_t z = 0; z <= resolution; ++z) {
+        for (uint32_t x = 0; x <= resolution; ++x) {
+            heightfield.heights.push_back(20.0f * std::sin(x * 0.02f) * std::cos(z * 0.03f) +
+                                          3.0f * std::sin(x * 0.2f + z * 0.13f) + noise(randomEngine));
+        }
+    }
+    return heightfield;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint32_t resolution = 1024;
+    uint32_t chunkCells = 32;
+    uint32_t cameraCount = 2000;
+    uint32_t queryCount = 1u << 20;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--resolution") == 0 && i + 1 < argc) {
+            resolution = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--chunk-cells") == 0 && i + 1 < argc) {
+            chunkCells = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--cameras") == 0 && i + 1 < argc) {
+            cameraCount = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            resolution = 256;
+            cameraCount = 50;
+            queryCount = 1u << 14;
+        } else {
+            std::fprintf(stderr, "usage: %s [--resolution N] [--chunk-cells N] [--cameras N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::mt19937 randomEngine(1u);
+    TerrainQuadtree quadtree;
+    TerrainQuadtree::Settings settings;
+    settings.chunkCells = chunkCells;
+    const Clock::time_point buildStart = Clock::now();
+    if (!quadtree.Build(MakeHeightfield(resolution, randomEngine), settings)) {
+        std::fprintf(stderr, "resolution %u must be chunk cells (%u) x 2^n\n", resolution, chunkCells);
+        return 1;
+    }
+    const double buildMs = ElapsedMs(buildStart);
+    const std::vector<TerrainQuadtree::Node>& nodes = quadtree.GetNodes();
+    const uint32_t leafCount = (resolution / chunkCells) * (resolution / chunkCells);
+    const uint32_t chunkTriangles = quadtree.GetChunkIndexCount() / 3;
+    std::printf("heightfield %u x %u, chunk %u cells: %zu nodes, depth %u, build %.2f ms\n", resolution, resolution,
+                chunkCells, nodes.size(), quadtree.GetDepth(), buildMs);
+
+    // 地形の上を見下ろすランダムなカメラ
+    const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 1280.0f / 720.0f, 0.1f, 1000.0f);
+    const float half = 0.5f * resolution;
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<uint32_t> selected;
+    double selectMs = 0.0;
+    uint64_t selectedTotal = 0;
+    uint64_t triangleTotal = 0;
+    uint64_t visitedTotal = 0;
+    for (uint32_t r = 0; r < cameraCount; ++r) {
+        const Vector3 cameraPosition = {(unit(randomEngine) - 0.5f) * half * 2.0f, 5.0f + unit(randomEngine) * 80.0f,
+                                        (unit(randomEngine) - 0.5f) * half * 2.0f};
+        const Vector3 cameraRotate = {0.1f + unit(randomEngine) * 0.6f, unit(randomEngine) * 6.28f, 0.0f};
+        const Matrix4x4 cameraMatrix = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, cameraRotate, cameraPosition);
+
+        TerrainQuadtree::SelectionParams params;
+        params.frustum = ClusterCuller::ExtractFrustum(Multiply(Inverse(cameraMatrix), projection));
+        params.cameraPosition = cameraPosition;
+        params.pixelScale = projection.m[1][1] * 720.0f * 0.5f;
+        params.maxPixelError = 2.0f;
+
+        const Clock::time_point start = Clock::now();
+        const TerrainQuadtree::SelectionStats stats = quadtree.Select(params, selected);
+        selectMs += ElapsedMs(start);
+        selectedTotal += stats.selectedNodes;
+        triangleTotal += stats.triangles;
+        visitedTotal += stats.visitedNodes;
+    }
+    std::printf("Select: %8.2f us/call, %.1f nodes visited, %.1f chunks, %.0f triangles (all leaves: %u)\n",
+                selectMs * 1000.0 / cameraCount, static_cast<double>(visitedTotal) / cameraCount,
+                static_cast<double>(selectedTotal) / cameraCount, static_cast<double>(triangleTotal) / cameraCount,
+                leafCount * chunkTriangles);
+
+    // 接地用の高さの問い合わせ
+    std::vector<float> xs(queryCount);
+    std::vector<float> zs(queryCount);
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        xs[i] = (unit(randomEngine) - 0.5f) * resolution;
+        zs[i] = (unit(randomEngine) - 0.5f) * resolution;
+    }
+    const Clock::time_point queryStart = Clock::now();
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < queryCount; ++i) {
+        sum += quadtree.GetHeight(xs[i], zs[i]);
+    }
+    const double queryMs = ElapsedMs(queryStart);
+    std::printf("GetHeight: %6.2f ns/query (checksum %.1f)\n", queryMs * 1e6 / queryCount, sum);
+    return 0;
+}
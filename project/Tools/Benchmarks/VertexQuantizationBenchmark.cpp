@@ -0,0 +1,124 @@
+// ============================================================
+// VertexQuantizationBenchmark — 頂点の圧縮 (VertexQuantization) によるメモリ量と変換の速さ
+//   ・フォルダ内の全モデルを Model と同じ手順 (MeshImporter) で読み、頂点の形式ごとの頂点+インデックスのバイト数
+//     (インデックスは Model::CreateIndexResource と同じく頂点数 65536 以下なら16bit)
+//   ・CompactHalf を希望したときに ChooseVertexFormat が選ぶ形式と、その誤差
+//   ・形式ごとの EncodeVertices の速さ (1秒あたりの頂点数)
+// 使い方: VertexQuantizationBenchmark <モデルのフォルダ> [--repeat N] [--quick]
+// ============================================================
+#include "MeshImporter.h"
+#include "VertexQuantization.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* const kFormatNames[kCountOfVertexFormat] = {"full", "compact", "compact-half"};
+
+// 頂点とインデックスのバイト数
+size_t GetBufferBytes(size_t vertexCount, size_t indexCount, VertexFormat format) {
+    const size_t indexSize = vertexCount <= 0x10000 ? sizeof(uint16_t) : sizeof(uint32_t);
+    return VertexQuantization::GetVertexStride(format) * vertexCount + indexSize * indexCount;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::filesystem::path directory;
+    uint32_t repeat = 200;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--quick") == 0) {
+            // ctest から動作確認として実行する
+            repeat = 2;
+        } else if (directory.empty() && argv[i][0] != '-') {
+            directory = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s <model directory> [--repeat N] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (directory.empty() || !std::filesystem::is_directory(directory)) {
+        std::fprintf(stderr, "usage: %s <model directory> [--repeat N] [--quick]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> paths;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory)) {
+        const std::string extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".obj" || extension == ".gltf" || extension == ".glb")) {
+            paths.push_back(entry.path());
+        }
+    }
+    std::sort(paths.begin(), paths.end(), [](const auto& a, const auto& b) { return a.filename() < b.filename(); });
+
+    // キャッシュを読み書きしない (ベンチマークの実行場所に書き出さないため)
+    MeshImporter::Settings settings;
+    settings.useCache = false;
+
+    std::vector<VertexData> allVertices;
+    size_t totalBytes[kCountOfVertexFormat] = {};
+    size_t chosenBytes = 0;
+    std::printf("%-20s %8s %8s %10s %10s %10s  %-12s %9s %9s %9s\n", "model", "vertices", "indices", "full KB",
+                "compact KB", "half KB", "chosen", "pos err", "uv err", "nrm rad");
+    for (const std::filesystem::path& path : paths) {
+        const MeshImporter::MeshSource source =
+            MeshImporter::Load(path.parent_path().generic_string(), path.filename().string(), settings);
+        const ModelData& modelData = source.modelData;
+        const size_t vertexCount = modelData.vertices.size();
+        const size_t indexCount = modelData.indices.size();
+
+        size_t bytes[kCountOfVertexFormat] = {};
+        for (int format = 0; format < kCountOfVertexFormat; ++format) {
+            bytes[format] = GetBufferBytes(vertexCount, indexCount, static_cast<VertexFormat>(format));
+            totalBytes[format] += bytes[format];
+        }
+        const VertexFormat chosen = VertexQuantization::ChooseVertexFormat(modelData.vertices, kVertexFormatCompactHalf);
+        const VertexQuantization::QuantizationError error = VertexQuantization::MeasureError(modelData.vertices, chosen);
+        chosenBytes += bytes[chosen];
+        std::printf("%-20s %8zu %8zu %10.1f %10.1f %10.1f  %-12s %9.2e %9.2e %9.2e\n", path.filename().string().c_str(),
+                    vertexCount, indexCount, bytes[kVertexFormatFull] / 1024.0, bytes[kVertexFormatCompact] / 1024.0,
+                    bytes[kVertexFormatCompactHalf] / 1024.0, kFormatNames[chosen], error.position, error.texcoord,
+                    error.normalAngle);
+        allVertices.insert(allVertices.end(), modelData.vertices.begin(), modelData.vertices.end());
+    }
+    // 非圧縮の頂点 (36バイト) の場合との比
+    const double fullKilobytes = totalBytes[kVertexFormatFull] / 1024.0;
+    std::printf("total: full %.1f KB, compact %.1f KB (%.0f%%), compact-half %.1f KB (%.0f%%), chosen %.1f KB (%.0f%%)\n",
+                fullKilobytes, totalBytes[kVertexFormatCompact] / 1024.0,
+                100.0 * totalBytes[kVertexFormatCompact] / totalBytes[kVertexFormatFull],
+                totalBytes[kVertexFormatCompactHalf] / 1024.0,
+                100.0 * totalBytes[kVertexFormatCompactHalf] / totalBytes[kVertexFormatFull], chosenBytes / 1024.0,
+                100.0 * chosenBytes / totalBytes[kVertexFormatFull]);
+    if (allVertices.empty()) {
+        std::fprintf(stderr, "no models in %s\n", directory.generic_string().c_str());
+        return 1;
+    }
+
+    // 形式ごとの変換の速さ (アップロードバッファへ書き込む処理と同じ)
+    std::vector<uint8_t> destination(sizeof(VertexData) * allVertices.size());
+    uint32_t checksum = 0;
+    for (int format = 0; format < kCountOfVertexFormat; ++format) {
+        const Clock::time_point start = Clock::now();
+        for (uint32_t i = 0; i < repeat; ++i) {
+            VertexQuantization::EncodeVertices(allVertices, static_cast<VertexFormat>(format), destination.data());
+            checksum += destination[i % destination.size()];
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::printf("encode %-12s %8.1f Mvertices/s\n", kFormatNames[format],
+                    static_cast<double>(allVertices.size()) * repeat / seconds / 1e6);
+    }
+    std::printf("checksum %u\n", checksum);
+    return 0;
+}
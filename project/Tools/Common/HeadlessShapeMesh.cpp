@@ -0,0 +1,9 @@
+#include "ParticleShape.h"
+
+// GPU なしのビルド用の ParticleShape::AcquireMesh
+// 本体 (ShapeMeshCache.cpp) は D3D12 のバッファを作るので、ツールでは形状メッシュを作らず
+// Billboard と同じ矩形扱い (nullptr) にする。シミュレーションの結果には影響しない
+const ShapeMesh* ParticleShape::AcquireMesh(ShapeMeshBuilder /*builder*/) {
+    currentMeshKey_ = meshKey_;
+    return nullptr;
+}
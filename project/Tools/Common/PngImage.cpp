@@ -0,0 +1,30 @@
+#include "PngImage.h"
+
+#include <png.h>
+
+#include <cstdio>
+
+namespace PngImage {
+
+bool Load(const std::string& path, TextureCooker::RgbaImage& image) {
+    png_image png{};
+    png.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&png, path.c_str())) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), png.message);
+        return false;
+    }
+
+    // 8bit の RGBA は sRGB の値で返る (ゲームも WIC_FLAGS_FORCE_SRGB で sRGB として読む)
+    png.format = PNG_FORMAT_RGBA;
+    image.width = png.width;
+    image.height = png.height;
+    image.pixels.resize(PNG_IMAGE_SIZE(png));
+    if (!png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr)) {
+        std::fprintf(stderr, "%s: %s\n", path.c_str(), png.message);
+        png_image_free(&png);
+        return false;
+    }
+    return true;
+}
+
+} // namespace PngImage
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "TextureCooker.h"
+
+#include <string>
+
+// ============================================================
+// PngImage — ツール用の PNG の読み込み (libpng)
+// ゲームは WIC で読むので、GPU なしのビルド (テクスチャのクックやテスト) でだけ使う
+// ============================================================
+namespace PngImage {
+
+/// <summary>
+/// PNG ファイルを RGBA8 で読み込む (グレースケール・パレット・16bit も RGBA8 に変換する)
+/// </summary>
+/// <param name="path">PNG ファイルのパス</param>
+/// <param name="image">読み込んだ画像</param>
+/// <returns>true = 成功 (失敗した理由は標準エラーに出す)</returns>
+bool Load(const std::string& path, TextureCooker::RgbaImage& image);
+
+} // namespace PngImage
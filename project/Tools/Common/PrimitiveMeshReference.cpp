@@ -0,0 +1,228 @@
+#include "PrimitiveMeshReference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+// 以前の PrimitiveMesh (頂点ごとに sin/cos を求め、push_back で積む) をそのまま残したもの
+namespace PrimitiveMeshReference {
+
+void BuildRing(const RingSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices) {
+    vertices.clear();
+    indices.clear();
+
+    // ============================================================
+    // 【ガード処理】不正な値をシャットアウト
+    // ============================================================
+    uint32_t safeDivision = std::max(3u, settings.division);
+    if (safeDivision > 256) safeDivision = 256; // 念のため上限もガード
+
+    float safeInnerRadius = std::max(0.0f, settings.innerRadius);
+    // ============================================================
+
+    float startRad = settings.startAngle * std::numbers::pi_v<float> / 180.0f;
+    float endRad = settings.endAngle * std::numbers::pi_v<float> / 180.0f;
+    float angleRange = endRad - startRad;
+
+    float rStart = settings.startOuterRadius;
+    float rMid = settings.midOuterRadius;
+    float rEnd = settings.endOuterRadius;
+
+    // 二次スプライン（放物線補間）係数の算出
+    float aCoeff = 2.0f * rStart - 4.0f * rMid + 2.0f * rEnd;
+    float bCoeff = -3.0f * rStart + 4.0f * rMid - rEnd;
+    float cCoeff = rStart;
+
+    // 頂点データの生成
+    for (uint32_t i = 0; i <= safeDivision; ++i) {
+        float t = float(i) / float(safeDivision);
+        float angle = startRad + t * angleRange;
+        float s = std::sin(angle);
+        float c = std::cos(angle);
+
+        // スプライン曲線による外径の計算
+        float outerRadius = aCoeff * t * t + bCoeff * t + cCoeff;
+
+        // 外側の頂点
+        VertexData outerVertex;
+        outerVertex.position = { -s * outerRadius, c * outerRadius, 0.0f, 1.0f };
+        outerVertex.normal = { 0.0f, 0.0f, -1.0f };
+        if (settings.isUvSwap) {
+            outerVertex.texcoord = { 0.0f, t };
+        } else {
+            outerVertex.texcoord = { t, 0.0f };
+        }
+        vertices.push_back(outerVertex);
+
+        // 内側の頂点
+        VertexData innerVertex;
+        innerVertex.position = { -s * safeInnerRadius, c * safeInnerRadius, 0.0f, 1.0f };
+        innerVertex.normal = { 0.0f, 0.0f, -1.0f };
+        if (settings.isUvSwap) {
+            innerVertex.texcoord = { 1.0f, t };
+        } else {
+            innerVertex.texcoord = { t, 1.0f };
+        }
+        vertices.push_back(innerVertex);
+    }
+
+    // インデックスデータの生成
+    for (uint32_t i = 0; i < safeDivision; ++i) {
+        uint32_t base = i * 2;
+        // 三角形1
+        indices.push_back(base);     // Outer i
+        indices.push_back(base + 2); // Outer i+1
+        indices.push_back(base + 1); // Inner i
+        // 三角形2
+        indices.push_back(base + 1); // Inner i
+        indices.push_back(base + 2); // Outer i+1
+        indices.push_back(base + 3); // Inner i+1
+    }
+}
+
+void BuildCylinder(const CylinderSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices) {
+    vertices.clear();
+    indices.clear();
+
+    // ============================================================
+    // 【安全ガード処理】関数の先頭で不正な値をシャットアウト
+    // ============================================================
+    uint32_t safeDivision = std::max(3u, settings.division);
+    if (safeDivision > 256) safeDivision = 256;
+
+    uint32_t safeVerticalDivision = std::max(1u, settings.verticalDivision);
+    if (safeVerticalDivision > 256) safeVerticalDivision = 256;
+    // ============================================================
+
+    float startRad = settings.startAngle * std::numbers::pi_v<float> / 180.0f;
+    float endRad = settings.endAngle * std::numbers::pi_v<float> / 180.0f;
+    float angleRange = endRad - startRad;
+
+    // 頂点の生成 (縦方向 yIndex: 0 から verticalDivision)
+    for (uint32_t yIndex = 0; yIndex <= safeVerticalDivision; ++yIndex) {
+        float vNorm = float(yIndex) / float(safeVerticalDivision);
+        float h = (1.0f - vNorm) * settings.height; // yIndex=0 が上(高さ height), yIndex=verticalDivision が下(高さ 0)
+
+        // 上底から下底にかけての半径を線形補間 (楕円対応)
+        Vector2 radius = {
+            settings.topRadius.x * (1.0f - vNorm) + settings.bottomRadius.x * vNorm,
+            settings.topRadius.y * (1.0f - vNorm) + settings.bottomRadius.y * vNorm
+        };
+
+        // 円周方向の頂点生成 (xIndex: 0 から division)
+        for (uint32_t xIndex = 0; xIndex <= safeDivision; ++xIndex) {
+            float uNorm = float(xIndex) / float(safeDivision);
+            float angle = startRad + uNorm * angleRange;
+            float s = std::sin(angle);
+            float c = std::cos(angle);
+
+            // 頂点の位置 (X, Y, Z)
+            VertexData vertex;
+            vertex.position = { -s * radius.x, h, c * radius.y, 1.0f };
+
+            // 法線：Y軸の高さは無視し、X, Z方向の外側を向く法線
+            vertex.normal = { -s, 0.0f, c };
+            float normalLen = std::sqrt(vertex.normal.x * vertex.normal.x + vertex.normal.z * vertex.normal.z);
+            if (normalLen > 0.0f) {
+                vertex.normal.x /= normalLen;
+                vertex.normal.z /= normalLen;
+            }
+
+            // UV座標
+            float u = uNorm;
+            float v = vNorm;
+            if (settings.flipV) {
+                v = 1.0f - v;
+            }
+            if (settings.isUvSwap) {
+                std::swap(u, v);
+            }
+            vertex.texcoord = { u, v };
+
+            vertices.push_back(vertex);
+        }
+    }
+
+    // インデックスデータの生成
+    for (uint32_t y = 0; y < safeVerticalDivision; ++y) {
+        for (uint32_t x = 0; x < safeDivision; ++x) {
+            uint32_t topLeft = y * (safeDivision + 1) + x;
+            uint32_t topRight = topLeft + 1;
+            uint32_t bottomLeft = (y + 1) * (safeDivision + 1) + x;
+            uint32_t bottomRight = bottomLeft + 1;
+
+            // 三角形1
+            indices.push_back(topLeft);
+            indices.push_back(topRight);
+            indices.push_back(bottomLeft);
+
+            // 三角形2
+            indices.push_back(bottomLeft);
+            indices.push_back(topRight);
+            indices.push_back(bottomRight);
+        }
+    }
+}
+
+void BuildPlane(const PlaneSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices) {
+    vertices.clear();
+    indices.clear();
+
+    uint32_t divX = settings.divisionX > 0 ? settings.divisionX : 1;
+    uint32_t divY = settings.divisionY > 0 ? settings.divisionY : 1;
+
+    float stepX = settings.size.x / static_cast<float>(divX);
+    float stepY = settings.size.y / static_cast<float>(divY);
+
+    float startX = -settings.size.x * 0.5f;
+    float startY = -settings.size.y * 0.5f;
+
+    // 頂点生成
+    for (uint32_t y = 0; y <= divY; ++y) {
+        float posY = startY + static_cast<float>(y) * stepY;
+        float v = static_cast<float>(y) / static_cast<float>(divY);
+        if (settings.flipV) {
+            v = 1.0f - v;
+        }
+
+        for (uint32_t x = 0; x <= divX; ++x) {
+            float posX = startX + static_cast<float>(x) * stepX;
+            float u = static_cast<float>(x) / static_cast<float>(divX);
+
+            VertexData vertex;
+            vertex.position = { posX, posY, 0.0f, 1.0f };
+            vertex.normal = { 0.0f, 0.0f, -1.0f };
+
+            float finalU = u;
+            float finalV = v;
+            if (settings.isUvSwap) {
+                std::swap(finalU, finalV);
+            }
+            vertex.texcoord = { finalU, finalV };
+
+            vertices.push_back(vertex);
+        }
+    }
+
+    // インデックス生成
+    for (uint32_t y = 0; y < divY; ++y) {
+        for (uint32_t x = 0; x < divX; ++x) {
+            uint32_t topLeft = y * (divX + 1) + x;
+            uint32_t topRight = topLeft + 1;
+            uint32_t bottomLeft = (y + 1) * (divX + 1) + x;
+            uint32_t bottomRight = bottomLeft + 1;
+
+            // 三角形1
+            indices.push_back(topLeft);
+            indices.push_back(topRight);
+            indices.push_back(bottomLeft);
+
+            // 三角形2
+            indices.push_back(bottomLeft);
+            indices.push_back(topRight);
+            indices.push_back(bottomRight);
+        }
+    }
+}
+
+} // namespace PrimitiveMeshReference
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Types/GraphicsTypes.h"
+#include "Types/ParticleTypes.h"
+
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+// PrimitiveMeshReference — 書き込み先を先に確保する前の PrimitiveMesh の生成 (テストとベンチマークの比較用)
+// 頂点ごとに sin/cos を求めて push_back する。分割数のガードも当時のまま
+// ============================================================
+namespace PrimitiveMeshReference {
+
+void BuildRing(const RingSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices);
+void BuildCylinder(const CylinderSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices);
+void BuildPlane(const PlaneSettings& settings, std::vector<VertexData>& vertices, std::vector<uint32_t>& indices);
+
+} // namespace PrimitiveMeshReference
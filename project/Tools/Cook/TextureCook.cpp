@@ -0,0 +1,123 @@
+// ============================================================
+// TextureCook — テクスチャのキャッシュ (ミップマップ済み・ブロック圧縮済みの DDS) を前もって作る
+// PNG をデコードし、ミップマップを作り、BlockCompressor で圧縮して DDS に書き出す (Windows・DirectXTex なし)
+// キャッシュのキーには読み込むときのパスが含まれるので、ゲームと同じく project フォルダで実行し、
+// "Resources/..." からの相対パスで渡す (書き出し先は Resources/Cache/Textures)
+// 使い方: TextureCook [--compression none|bc1|bc3|bc4|bc5|bc7] [--force] <PNG ファイルかフォルダ>...
+// ============================================================
+#include "PngImage.h"
+#include "TextureCooker.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool ParseCompression(const char* name, TextureCooker::Compression& compression) {
+    static const struct {
+        const char* name;
+        TextureCooker::Compression compression;
+    } kCompressions[] = {
+        {"none", TextureCooker::Compression::None}, {"bc1", TextureCooker::Compression::BC1},
+        {"bc3", TextureCooker::Compression::BC3},   {"bc4", TextureCooker::Compression::BC4},
+        {"bc5", TextureCooker::Compression::BC5},   {"bc7", TextureCooker::Compression::BC7},
+    };
+    for (const auto& entry : kCompressions) {
+        if (std::strcmp(name, entry.name) == 0) {
+            compression = entry.compression;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ゲームが読み込むときと同じ形のパス ("Resources/Textures/a.png" のようなカレントディレクトリからの相対パス)
+std::string ToLoadPath(const std::filesystem::path& path) {
+    return std::filesystem::relative(path).lexically_normal().generic_string();
+}
+
+// 渡されたファイル、フォルダの中の PNG を集める
+bool CollectFiles(const char* argument, std::vector<std::string>& files) {
+    std::error_code ec;
+    const std::filesystem::path path(argument);
+    if (std::filesystem::is_directory(path, ec)) {
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".png") {
+                files.push_back(ToLoadPath(entry.path()));
+            }
+        }
+        return !ec;
+    }
+    if (std::filesystem::is_regular_file(path, ec)) {
+        files.push_back(ToLoadPath(path));
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    TextureCooker::Settings settings;
+    bool isForced = false;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--compression") == 0 && i + 1 < argc) {
+            if (!ParseCompression(argv[++i], settings.compression)) {
+                std::fprintf(stderr, "unknown compression: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--force") == 0) {
+            isForced = true;
+        } else if (argv[i][0] == '-') {
+            files.clear();
+            break;
+        } else if (!CollectFiles(argv[i], files)) {
+            std::fprintf(stderr, "not found: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (files.empty()) {
+        std::fprintf(stderr, "usage: %s [--compression none|bc1|bc3|bc4|bc5|bc7] [--force] <png files or directories>...\n",
+                     argv[0]);
+        return 1;
+    }
+
+    int cookedCount = 0;
+    int skippedCount = 0;
+    int failedCount = 0;
+    for (const std::string& file : files) {
+        if (file.starts_with("..")) {
+            std::printf("WARNING: %s is outside the current directory (the game will not find this cache)\n",
+                        file.c_str());
+        }
+        const std::string cachePath = TextureCooker::GetCachePath(TextureCooker::ComputeKey(file, settings));
+        std::error_code ec;
+        if (!isForced && std::filesystem::exists(cachePath, ec)) {
+            ++skippedCount;
+            continue;
+        }
+
+        const Clock::time_point start = Clock::now();
+        TextureCooker::RgbaImage image;
+        if (!PngImage::Load(file, image) || !TextureCooker::CookImage(image, settings, cachePath)) {
+            std::printf("FAILED %s\n", file.c_str());
+            ++failedCount;
+            continue;
+        }
+        const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::printf("%-48s %4u x %-4u -> %s (%.1f ms)\n", file.c_str(), image.width, image.height, cachePath.c_str(),
+                    milliseconds);
+        ++cookedCount;
+    }
+
+    std::printf("cooked %d, up to date %d, failed %d\n", cookedCount, skippedCount, failedCount);
+    return failedCount > 0 ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+// ============================================================
+// AnimationCompressorTest — アニメーションの圧縮 (AnimationCompressor) のテスト
+//   ・60fps でサンプリングした合成クリップ (等速の移動・等速の回転・揺れ・変化しないスケール) を圧縮する
+//   ・キー数が減る (変化しない要素は1キー、等速の要素は2キー、揺れはそれより多いが元より少ない)
+//   ・元のクリップと圧縮したクリップを AnimationSampler で細かい刻みで再生し、
+//     平行移動・回転・スケールの差が許容誤差 + 量子化の誤差に収まる
+//   ・Stats の誤差も許容誤差に収まり、圧縮後のバイト数が元より小さい
+// ============================================================
+#include "AnimationCompressor.h"
+#include "AnimationSampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+const float kDuration = 2.0f;
+const uint32_t kSourceKeyCount = 121; // 60fps で2秒
+const uint32_t kNodeCount = 3;
+
+Quaternion MakeRotation(const Vector3& axis, float angle) {
+    const float s = std::sin(angle * 0.5f);
+    return {axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f)};
+}
+
+// 2つの回転の間の角度 (q と -q は同じ回転。小さい角度でも精度が落ちないよう弦の長さから求める)
+float Angle(const Quaternion& a, const Quaternion& b) {
+    const float sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.0f ? -1.0f : 1.0f;
+    const float x = a.x - b.x * sign, y = a.y - b.y * sign, z = a.z - b.z * sign, w = a.w - b.w * sign;
+    return 4.0f * std::asin(std::min(std::sqrt(x * x + y * y + z * z + w * w) * 0.5f, 1.0f));
+}
+
+float Distance(const Vector3& a, const Vector3& b) {
+    const float x = a.x - b.x, y = a.y - b.y, z = a.z - b.z;
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+// ノード0: 等速で移動・等速で回転・スケール一定
+// ノード1: 上下に揺れる・軸の向きが変わる回転・脈打つスケール
+// ノード2: 何も変化しない
+AnimationClip MakeClip() {
+    AnimationClip clip;
+    clip.name = "synthetic";
+    clip.duration = kDuration;
+    for (uint32_t n = 0; n < kNodeCount; ++n) {
+        clip.tracks.emplace_back().nodeIndex = n;
+    }
+    const Vector3 axis = {0.0f, 0.6f, 0.8f};
+    for (uint32_t k = 0; k < kSourceKeyCount; ++k) {
+        const float time = kDuration * static_cast<float>(k) / (kSourceKeyCount - 1);
+        const float phase = 2.0f * std::numbers::pi_v<float> * time / kDuration;
+
+        clip.tracks[0].translate.push_back({time, {time * 3.0f, 1.0f, -time}});
+        clip.tracks[0].rotate.push_back({time, MakeRotation(axis, time * 1.2f)});
+        clip.tracks[0].scale.push_back({time, {1.0f, 1.0f, 1.0f}});
+
+        clip.tracks[1].translate.push_back({time, {0.0f, 0.5f * std::sin(phase * 2.0f), 0.2f * std::cos(phase)}});
+        const Vector3 wobbleAxis = {std::sin(phase) * 0.6f, 0.8f, std::cos(phase) * 0.6f};
+        clip.tracks[1].rotate.push_back({time, MakeRotation(wobbleAxis, 0.5f * std::sin(phase))});
+        const float pulse = 1.0f + 0.1f * std::sin(phase * 3.0f);
+        clip.tracks[1].scale.push_back({time, {pulse, pulse, pulse}});
+
+        clip.tracks[2].translate.push_back({time, {0.0f, 2.0f, 0.0f}});
+        clip.tracks[2].rotate.push_back({time, MakeRotation(axis, 0.3f)});
+        clip.tracks[2].scale.push_back({time, {2.0f, 2.0f, 2.0f}});
+    }
+    return clip;
+}
+
+void TestKeyReduction(const AnimationClip& clip, const CompressedAnimationClip& compressed,
+                      const AnimationCompressor::Stats& stats) {
+    CHECK(compressed.name == clip.name);
+    CHECK(compressed.duration == clip.duration);
+    CHECK(compressed.tracks.size() == kNodeCount);
+    CHECK(stats.sourceKeyCount == kNodeCount * 3 * kSourceKeyCount);
+    CHECK(stats.keyCount == compressed.keyTimes.size());
+    CHECK(compressed.keyValues.size() == compressed.keyTimes.size() * 3);
+    std::printf("keys %zu -> %zu, bytes %zu -> %zu\n", stats.sourceKeyCount, stats.keyCount, stats.sourceBytes,
+                stats.compressedBytes);
+    CHECK(stats.keyCount * 4 < stats.sourceKeyCount);
+    CHECK(stats.compressedBytes * 4 < stats.sourceBytes);
+
+    // 等速の移動と回転は両端の2キー、一定のスケールは1キー
+    CHECK(compressed.tracks[0].keyCounts[0] == 2);
+    CHECK(compressed.tracks[0].keyCounts[1] == 2);
+    CHECK(compressed.tracks[0].keyCounts[2] == 1);
+    // 揺れはキーが残るが元より少ない
+    for (uint32_t component = 0; component < 3; ++component) {
+        CHECK(compressed.tracks[1].keyCounts[component] > 2);
+        CHECK(compressed.tracks[1].keyCounts[component] < kSourceKeyCount);
+    }
+    // 何も変化しない要素は1キー
+    for (uint32_t component = 0; component < 3; ++component) {
+        CHECK(compressed.tracks[2].keyCounts[component] == 1);
+    }
+    // キーの時刻は増えていく
+    for (const CompressedNodeAnimation& track : compressed.tracks) {
+        for (uint32_t component = 0; component < 3; ++component) {
+            for (uint32_t k = 1; k < track.keyCounts[component]; ++k) {
+                CHECK(compressed.keyTimes[track.keyOffsets[component] + k - 1] <
+                      compressed.keyTimes[track.keyOffsets[component] + k]);
+            }
+        }
+    }
+}
+
+void TestSampledError(const AnimationClip& clip, const CompressedAnimationClip& compressed,
+                      const AnimationCompressor::Settings& settings, const AnimationCompressor::Stats& stats) {
+    AnimationSampler sourceSampler;
+    sourceSampler.Initialize(&clip);
+    AnimationSampler compressedSampler;
+    compressedSampler.Initialize(&compressed);
+    CHECK(compressedSampler.GetDuration() == kDuration);
+
+    // キーの時刻とキーの間を含む細かい刻みで比べる (再生と同じく時刻は進む向き)
+    float maxTranslate = 0.0f;
+    float maxRotate = 0.0f;
+    float maxScale = 0.0f;
+    const uint32_t sampleCount = 1000;
+    for (uint32_t i = 0; i <= sampleCount; ++i) {
+        const float time = kDuration * static_cast<float>(i) / sampleCount;
+        Matrix4x4 expected[kNodeCount];
+        Matrix4x4 actual[kNodeCount];
+        sourceSampler.Sample(time, expected);
+        compressedSampler.Sample(time, actual);
+        for (uint32_t n = 0; n < kNodeCount; ++n) {
+            Vector3 expectedScale, actualScale, expectedTranslate, actualTranslate;
+            Quaternion expectedRotate, actualRotate;
+            Animation::DecomposeTransformMatrix(expected[n], expectedScale, expectedRotate, expectedTranslate);
+            Animation::DecomposeTransformMatrix(actual[n], actualScale, actualRotate, actualTranslate);
+            maxTranslate = std::max(maxTranslate, Distance(actualTranslate, expectedTranslate));
+            maxRotate = std::max(maxRotate, Angle(actualRotate, expectedRotate));
+            maxScale = std::max({maxScale, std::abs(actualScale.x - expectedScale.x),
+                                 std::abs(actualScale.y - expectedScale.y), std::abs(actualScale.z - expectedScale.z)});
+        }
+    }
+    std::printf("sampled max error: translate %.3e, rotate %.3e rad, scale %.3e\n", maxTranslate, maxRotate, maxScale);
+    std::printf("stats max error:   translate %.3e, rotate %.3e rad, scale %.3e\n", stats.maxTranslateError,
+                stats.maxRotateError, stats.maxScaleError);
+
+    // 間引きの誤差は許容誤差以内。量子化 (値は範囲の 1/65535、回転の成分は 1/32767、時刻は長さの 1/65535) の分を
+    // 許容誤差の半分まで見込む
+    CHECK(maxTranslate <= settings.translateTolerance * 1.5f);
+    CHECK(maxRotate <= settings.rotateTolerance * 1.5f);
+    CHECK(maxScale <= settings.scaleTolerance * 1.5f);
+    CHECK(stats.maxTranslateError <= settings.translateTolerance * 1.5f);
+    CHECK(stats.maxRotateError <= settings.rotateTolerance * 1.5f);
+    CHECK(stats.maxScaleError <= settings.scaleTolerance * 1.5f);
+}
+
+void TestLooseTolerance(const AnimationClip& clip, size_t defaultKeyCount) {
+    // 許容誤差を大きくするとキーはさらに減る
+    AnimationCompressor::Settings loose;
+    loose.translateTolerance = 0.05f;
+    loose.rotateTolerance = 0.05f;
+    loose.scaleTolerance = 0.05f;
+    AnimationCompressor::Stats stats;
+    AnimationCompressor::Compress(clip, loose, &stats);
+    CHECK(stats.keyCount < defaultKeyCount);
+    CHECK(stats.maxTranslateError <= loose.translateTolerance * 1.5f);
+    CHECK(stats.maxRotateError <= loose.rotateTolerance * 1.5f);
+}
+
+} // namespace
+
+int main() {
+    const AnimationClip clip = MakeClip();
+    const AnimationCompressor::Settings settings;
+    AnimationCompressor::Stats stats;
+    const CompressedAnimationClip compressed = AnimationCompressor::Compress(clip, settings, &stats);
+
+    TestKeyReduction(clip, compressed, stats);
+    TestSampledError(clip, compressed, settings, stats);
+    TestLooseTolerance(clip, stats.keyCount);
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("AnimationCompressorTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,201 @@
+// ============================================================
+// AnimationSamplerTest — アニメーションの姿勢の計算 (AnimationSampler) のテスト
+//   ・キーちょうどの時刻はそのキーの値、キーの間は線形補間 / 球面線形補間、範囲外は端のキーの値
+//   ・ループ再生 (Object3d::UpdateAnimation と同じく fmod で折り返す) で時刻が先頭に戻っても、
+//     前回のキー番号を覚えていないサンプラーと同じ姿勢になる
+//   ・時間を戻したり飛ばしたりしたときも同じ (覚えているキー番号を使わず探し直す)
+//   ・トラックの無いノードの行列は書き換えない
+//   ・MakeTransformMatrix と DecomposeTransformMatrix は元に戻る
+// ============================================================
+#include "AnimationSampler.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+const uint32_t kNodeCount = 3;
+
+bool NearlyEqual(const Matrix4x4& a, const Matrix4x4& b, float tolerance = 1e-5f) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            if (std::abs(a.m[i][j] - b.m[i][j]) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool NearlyEqual(const Vector3& a, const Vector3& b, float tolerance = 1e-5f) {
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance;
+}
+
+Vector3 GetTranslate(const Matrix4x4& matrix) {
+    return {matrix.m[3][0], matrix.m[3][1], matrix.m[3][2]};
+}
+
+// Y 軸まわりの回転
+Quaternion MakeRotationY(float angle) {
+    return {0.0f, std::sin(angle * 0.5f), 0.0f, std::cos(angle * 0.5f)};
+}
+
+// ノード0: 平行移動3キー (0, 0.5, 1.0 秒)・回転2キー (0 → 90度)・スケール1キー
+// ノード2: キーの間隔がそろっていない平行移動5キー
+// ノード1: トラックなし
+AnimationClip MakeClip() {
+    AnimationClip clip;
+    clip.name = "test";
+    clip.duration = 1.0f;
+
+    NodeAnimation& first = clip.tracks.emplace_back();
+    first.nodeIndex = 0;
+    first.translate = {{0.0f, {0.0f, 0.0f, 0.0f}}, {0.5f, {2.0f, 0.0f, 0.0f}}, {1.0f, {2.0f, 4.0f, 0.0f}}};
+    first.rotate = {{0.0f, MakeRotationY(0.0f)}, {1.0f, MakeRotationY(std::numbers::pi_v<float> * 0.5f)}};
+    first.scale = {{0.0f, {1.0f, 1.0f, 1.0f}}};
+
+    NodeAnimation& second = clip.tracks.emplace_back();
+    second.nodeIndex = 2;
+    second.translate = {{0.1f, {0.0f, 0.0f, 0.0f}},
+                        {0.2f, {0.0f, 1.0f, 0.0f}},
+                        {0.25f, {0.0f, 1.0f, 3.0f}},
+                        {0.7f, {-1.0f, 0.0f, 3.0f}},
+                        {0.9f, {-1.0f, 0.0f, 0.0f}}};
+    second.rotate = {{0.0f, MakeRotationY(0.0f)}};
+    second.scale = {{0.0f, {2.0f, 2.0f, 2.0f}}};
+    return clip;
+}
+
+std::vector<Matrix4x4> Sample(AnimationSampler& sampler, float time) {
+    std::vector<Matrix4x4> localMatrices(kNodeCount, MathGenerators::MakeIdentity4x4());
+    sampler.Sample(time, localMatrices);
+    return localMatrices;
+}
+
+// キー番号を覚えていない新しいサンプラーで求めた姿勢
+std::vector<Matrix4x4> SampleFresh(const AnimationClip& clip, float time) {
+    AnimationSampler sampler;
+    sampler.Initialize(&clip);
+    return Sample(sampler, time);
+}
+
+void TestInterpolation() {
+    const AnimationClip clip = MakeClip();
+    AnimationSampler sampler;
+    sampler.Initialize(&clip);
+    CHECK(sampler.HasClip());
+    CHECK(sampler.GetDuration() == 1.0f);
+
+    // キーちょうど
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 0.0f)[0]), {0.0f, 0.0f, 0.0f}));
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 0.5f)[0]), {2.0f, 0.0f, 0.0f}));
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 1.0f)[0]), {2.0f, 4.0f, 0.0f}));
+    // キーの間
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 0.25f)[0]), {1.0f, 0.0f, 0.0f}));
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 0.75f)[0]), {2.0f, 2.0f, 0.0f}));
+    // 次のキーの直前は次のキーの値に近い
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 0.4999f)[0]), {2.0f, 0.0f, 0.0f}, 1e-3f));
+
+    // 回転は球面線形補間 (中間は45度)
+    const Matrix4x4 half = Sample(sampler, 0.5f)[0];
+    const Matrix4x4 expected = Animation::MakeTransformMatrix(
+        {1.0f, 1.0f, 1.0f}, MakeRotationY(std::numbers::pi_v<float> * 0.25f), {2.0f, 0.0f, 0.0f});
+    CHECK(NearlyEqual(half, expected));
+
+    // 最初のキーより前・最後のキーより後は端のキーの値
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 0.05f)[2]), {0.0f, 0.0f, 0.0f}));
+    CHECK(NearlyEqual(GetTranslate(Sample(sampler, 0.95f)[2]), {-1.0f, 0.0f, 0.0f}));
+    // スケールのキーが1つなら常にその値
+    CHECK(std::abs(Sample(sampler, 0.3f)[2].m[1][1] - 2.0f) < 1e-5f);
+
+    // トラックの無いノードは書き換えない
+    CHECK(NearlyEqual(Sample(sampler, 0.3f)[1], MathGenerators::MakeIdentity4x4()));
+}
+
+void TestLoopAndSeek() {
+    const AnimationClip clip = MakeClip();
+
+    // ループ再生: 60fps より粗い刻みで何周かする (折り返しのたびに時刻が先頭に戻る)
+    AnimationSampler looping;
+    looping.Initialize(&clip);
+    float time = 0.0f;
+    bool isSame = true;
+    for (int frame = 0; frame < 200; ++frame) {
+        time = std::fmod(time + 0.037f, clip.duration);
+        const std::vector<Matrix4x4> pose = Sample(looping, time);
+        const std::vector<Matrix4x4> fresh = SampleFresh(clip, time);
+        for (uint32_t n = 0; n < kNodeCount; ++n) {
+            isSame = isSame && NearlyEqual(pose[n], fresh[n]);
+        }
+    }
+    CHECK(isSame);
+
+    // 終わり近くから先頭近くへ戻る (区間を探し直さないと最後の区間の値になる)
+    AnimationSampler seeking;
+    seeking.Initialize(&clip);
+    Sample(seeking, 0.8f);
+    CHECK(NearlyEqual(GetTranslate(Sample(seeking, 0.15f)[2]), {0.0f, 0.5f, 0.0f}));
+    CHECK(NearlyEqual(GetTranslate(Sample(seeking, 0.15f)[0]), {0.6f, 0.0f, 0.0f}));
+
+    // 1つ前の区間へ戻る・区間を飛ばして進む
+    const float seekTimes[] = {0.72f, 0.22f, 0.21f, 0.95f, 0.0f, 0.6f, 0.3f, 0.26f, 1.0f, 0.1f};
+    isSame = true;
+    for (float seekTime : seekTimes) {
+        const std::vector<Matrix4x4> pose = Sample(seeking, seekTime);
+        const std::vector<Matrix4x4> fresh = SampleFresh(clip, seekTime);
+        for (uint32_t n = 0; n < kNodeCount; ++n) {
+            isSame = isSame && NearlyEqual(pose[n], fresh[n]);
+        }
+    }
+    CHECK(isSame);
+
+    // Initialize しなおすとキー番号は先頭に戻る
+    seeking.Initialize(&clip);
+    CHECK(NearlyEqual(GetTranslate(Sample(seeking, 0.0f)[0]), {0.0f, 0.0f, 0.0f}));
+    seeking.Clear();
+    CHECK(!seeking.HasClip());
+}
+
+void TestDecompose() {
+    const Vector3 scale = {1.5f, 0.5f, 2.0f};
+    const float length = std::sqrt(0.1f * 0.1f + 0.7f * 0.7f + 0.2f * 0.2f + 0.6f * 0.6f);
+    const Quaternion rotate = {0.1f / length, -0.7f / length, 0.2f / length, 0.6f / length};
+    const Vector3 translate = {3.0f, -2.0f, 0.5f};
+    const Matrix4x4 matrix = Animation::MakeTransformMatrix(scale, rotate, translate);
+
+    Vector3 decomposedScale;
+    Quaternion decomposedRotate;
+    Vector3 decomposedTranslate;
+    Animation::DecomposeTransformMatrix(matrix, decomposedScale, decomposedRotate, decomposedTranslate);
+    CHECK(NearlyEqual(decomposedScale, scale));
+    CHECK(NearlyEqual(decomposedTranslate, translate));
+    CHECK(NearlyEqual(Animation::MakeTransformMatrix(decomposedScale, decomposedRotate, decomposedTranslate), matrix));
+}
+
+} // namespace
+
+int main() {
+    TestInterpolation();
+    TestLoopAndSeek();
+    TestDecompose();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("AnimationSamplerTest: all checks passed\n");
+    return 0;
+}
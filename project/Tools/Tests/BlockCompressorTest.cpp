@@ -0,0 +1,419 @@
+// ============================================================
+// BlockCompressorTest — ブロック圧縮 (BlockCompressor) の画質のテスト
+// テクスチャフォルダの PNG をすべて各形式で圧縮し、テスト側のデコーダーで戻して PSNR を確かめる
+//   ・BC1 は不透明なピクセルの RGB、BC3 / BC7 は RGBA、BC4 は R、BC5 は RG を比べる
+//   ・既知のテクスチャは形式ごとの下限 (現在の値より少し下) を、追加されたものは共通の下限を下回らない
+//   ・BC1 のアルファ (128 未満は透明) が正しい
+//   ・スレッド数を変えても同じ結果になる
+// 使い方: BlockCompressorTest <テクスチャフォルダ>
+// ============================================================
+#include "BlockCompressor.h"
+#include "PngImage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace BlockCompressor;
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+const Format kFormats[] = {Format::BC1, Format::BC3, Format::BC4, Format::BC5, Format::BC7};
+const char* const kFormatNames[] = {"BC1", "BC3", "BC4", "BC5", "BC7"};
+
+// ------------------------------------------------------------
+// デコーダー (テスト用。BC7 はエンコーダーが使うモード5 / 6 のみ)
+// ------------------------------------------------------------
+
+// 4x4 ブロック1つ分の RGBA
+struct DecodedBlock {
+    uint8_t rgba[16][4];
+};
+
+void ExpandRgb565(uint16_t packed, int color[3]) {
+    const int r = (packed >> 11) & 0x1F;
+    const int g = (packed >> 5) & 0x3F;
+    const int b = packed & 0x1F;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// BC1 の色のブロック (BC3 の色は常に4色)
+void DecodeColorBlock(const uint8_t* block, bool isBC1, DecodedBlock& decoded) {
+    const uint16_t packed0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t packed1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+    int palette[4][4] = {};
+    ExpandRgb565(packed0, palette[0]);
+    ExpandRgb565(packed1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+    const bool isFourColor = !isBC1 || packed0 > packed1;
+    for (int c = 0; c < 3; ++c) {
+        if (isFourColor) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    if (!isFourColor) {
+        palette[3][3] = 0;
+    }
+
+    const uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+    for (int i = 0; i < 16; ++i) {
+        const int* color = palette[(indices >> (i * 2)) & 3];
+        for (int c = 0; c < 3; ++c) {
+            decoded.rgba[i][c] = static_cast<uint8_t>(color[c]);
+        }
+        if (isBC1) {
+            decoded.rgba[i][3] = static_cast<uint8_t>(color[3]);
+        }
+    }
+}
+
+// BC4 と同じ1チャンネルのブロック
+void DecodeSingleChannelBlock(const uint8_t* block, int channel, DecodedBlock& decoded) {
+    const int endpoint0 = block[0];
+    const int endpoint1 = block[1];
+    int palette[8] = {endpoint0, endpoint1};
+    if (endpoint0 > endpoint1) {
+        for (int i = 1; i < 7; ++i) {
+            palette[i + 1] = ((7 - i) * endpoint0 + i * endpoint1) / 7;
+        }
+    } else {
+        for (int i = 1; i < 5; ++i) {
+            palette[i + 1] = ((5 - i) * endpoint0 + i * endpoint1) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    uint64_t indices = 0;
+    for (int i = 0; i < 6; ++i) {
+        indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+    }
+    for (int i = 0; i < 16; ++i) {
+        decoded.rgba[i][channel] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+    }
+}
+
+// 下位ビットから読む
+class BitReader {
+public:
+    explicit BitReader(const uint8_t* block) : block_(block) {}
+    uint32_t Read(int bitCount) {
+        uint32_t value = 0;
+        for (int i = 0; i < bitCount; ++i, ++position_) {
+            value |= static_cast<uint32_t>((block_[position_ / 8] >> (position_ % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* block_;
+    int position_ = 0;
+};
+
+int InterpolateBC7(int endpoint0, int endpoint1, int weight) {
+    return ((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6;
+}
+
+const int kBC7Weights2[4] = {0, 21, 43, 64};
+const int kBC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+// BC7 のモード5 / 6 (それ以外のモードは false)
+bool DecodeBC7Block(const uint8_t* block, DecodedBlock& decoded) {
+    BitReader reader(block);
+    int mode = 0;
+    while (mode < 8 && reader.Read(1) == 0) {
+        ++mode;
+    }
+
+    if (mode == 6) {
+        int endpoints[2][4];
+        for (int c = 0; c < 4; ++c) {
+            endpoints[0][c] = static_cast<int>(reader.Read(7));
+            endpoints[1][c] = static_cast<int>(reader.Read(7));
+        }
+        const int pBits[2] = {static_cast<int>(reader.Read(1)), static_cast<int>(reader.Read(1))};
+        for (int e = 0; e < 2; ++e) {
+            for (int c = 0; c < 4; ++c) {
+                endpoints[e][c] = (endpoints[e][c] << 1) | pBits[e];
+            }
+        }
+        for (int i = 0; i < 16; ++i) {
+            const int weight = kBC7Weights4[reader.Read(i == 0 ? 3 : 4)];
+            for (int c = 0; c < 4; ++c) {
+                decoded.rgba[i][c] = static_cast<uint8_t>(InterpolateBC7(endpoints[0][c], endpoints[1][c], weight));
+            }
+        }
+        return true;
+    }
+
+    if (mode == 5) {
+        const uint32_t rotation = reader.Read(2);
+        int endpoints[2][4];
+        for (int c = 0; c < 3; ++c) {
+            for (int e = 0; e < 2; ++e) {
+                const int value = static_cast<int>(reader.Read(7));
+                endpoints[e][c] = (value << 1) | (value >> 6);
+            }
+        }
+        endpoints[0][3] = static_cast<int>(reader.Read(8));
+        endpoints[1][3] = static_cast<int>(reader.Read(8));
+        int colorWeights[16];
+        int alphaWeights[16];
+        for (int i = 0; i < 16; ++i) {
+            colorWeights[i] = kBC7Weights2[reader.Read(i == 0 ? 1 : 2)];
+        }
+        for (int i = 0; i < 16; ++i) {
+            alphaWeights[i] = kBC7Weights2[reader.Read(i == 0 ? 1 : 2)];
+        }
+        for (int i = 0; i < 16; ++i) {
+            for (int c = 0; c < 4; ++c) {
+                const int weight = c == 3 ? alphaWeights[i] : colorWeights[i];
+                decoded.rgba[i][c] = static_cast<uint8_t>(InterpolateBC7(endpoints[0][c], endpoints[1][c], weight));
+            }
+            if (rotation != 0) {
+                std::swap(decoded.rgba[i][rotation - 1], decoded.rgba[i][3]);
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool DecodeBlock(Format format, const uint8_t* block, DecodedBlock& decoded) {
+    // 形式にないチャンネルは 0 (アルファは 255)
+    for (auto& pixel : decoded.rgba) {
+        pixel[0] = pixel[1] = pixel[2] = 0;
+        pixel[3] = 255;
+    }
+    switch (format) {
+    case Format::BC1:
+        DecodeColorBlock(block, true, decoded);
+        return true;
+    case Format::BC3:
+        DecodeSingleChannelBlock(block, 3, decoded);
+        DecodeColorBlock(block + 8, false, decoded);
+        return true;
+    case Format::BC4:
+        DecodeSingleChannelBlock(block, 0, decoded);
+        return true;
+    case Format::BC5:
+        DecodeSingleChannelBlock(block, 0, decoded);
+        DecodeSingleChannelBlock(block + 8, 1, decoded);
+        return true;
+    case Format::BC7:
+        return DecodeBC7Block(block, decoded);
+    }
+    return false;
+}
+
+// 圧縮データを RGBA8 に戻す (画像の外のピクセルは捨てる)
+bool Decode(Format format, const std::vector<uint8_t>& compressed, uint32_t width, uint32_t height,
+            std::vector<uint8_t>& pixels) {
+    pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+    const uint32_t blocksX = (width + 3) / 4;
+    const uint32_t blocksY = (height + 3) / 4;
+    for (uint32_t blockY = 0; blockY < blocksY; ++blockY) {
+        for (uint32_t blockX = 0; blockX < blocksX; ++blockX) {
+            DecodedBlock decoded;
+            const size_t offset = blockY * GetRowPitch(format, width) + blockX * GetBlockSize(format);
+            if (!DecodeBlock(format, compressed.data() + offset, decoded)) {
+                return false;
+            }
+            for (uint32_t y = 0; y < 4 && blockY * 4 + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && blockX * 4 + x < width; ++x) {
+                    std::memcpy(&pixels[((blockY * 4 + y) * static_cast<size_t>(width) + blockX * 4 + x) * 4],
+                                decoded.rgba[y * 4 + x], 4);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+// PSNR
+// ------------------------------------------------------------
+
+// 形式ごとに比べるチャンネル
+struct ChannelMask {
+    int first;
+    int count;
+};
+
+ChannelMask GetChannelMask(Format format) {
+    switch (format) {
+    case Format::BC1:
+        return {0, 3};
+    case Format::BC4:
+        return {0, 1};
+    case Format::BC5:
+        return {0, 2};
+    default:
+        return {0, 4};
+    }
+}
+
+// PSNR (dB。誤差がなければ無限大)。BC1 は元のアルファが 128 以上のピクセルだけを比べる
+double ComputePSNR(Format format, const std::vector<uint8_t>& source, const std::vector<uint8_t>& decoded) {
+    const ChannelMask mask = GetChannelMask(format);
+    double squaredError = 0.0;
+    size_t sampleCount = 0;
+    for (size_t i = 0; i < source.size(); i += 4) {
+        if (format == Format::BC1 && source[i + 3] < 128) {
+            continue;
+        }
+        for (int c = mask.first; c < mask.first + mask.count; ++c) {
+            const double difference = static_cast<double>(source[i + c]) - decoded[i + c];
+            squaredError += difference * difference;
+            ++sampleCount;
+        }
+    }
+    if (squaredError == 0.0 || sampleCount == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return 10.0 * std::log10(255.0 * 255.0 / (squaredError / sampleCount));
+}
+
+// 既知のテクスチャの下限 (BC1, BC3, BC4, BC5, BC7。現在の値より 0.3dB ほど下。誤差なしは 60)
+struct Threshold {
+    const char* name;
+    double minPSNR[5];
+};
+
+const Threshold kThresholds[] = {
+    {"uvChecker.png", {35.1, 36.4, 41.1, 41.2, 41.0}},
+    {"monsterBall.png", {43.2, 44.5, 54.4, 55.6, 58.4}},
+    {"grass.png", {28.3, 29.6, 35.7, 35.2, 34.1}},
+    {"fence.png", {39.3, 40.4, 52.0, 52.0, 40.8}},
+    {"checkerBoard.png", {50.6, 51.9, 66.8, 66.8, 51.5}},
+    {"crosshair.png", {60.0, 46.9, 60.0, 60.0, 36.9}},
+    {"masks/noise0.png", {43.6, 44.8, 51.4, 51.4, 54.4}},
+    {"masks/noise1.png", {42.9, 44.1, 53.5, 53.5, 55.3}},
+    {"Particles/circle.png", {45.5, 46.7, 59.6, 59.6, 56.4}},
+    {"Particles/circle2.png", {47.6, 47.3, 56.0, 56.0, 58.0}},
+    {"Particles/gradationLine.png", {37.5, 35.2, 42.3, 42.3, 45.7}},
+    {"white.png", {60.0, 60.0, 60.0, 60.0, 60.0}},
+};
+
+// 表にないテクスチャの下限
+const double kDefaultMinPSNR = 28.0;
+
+const double* FindThreshold(const std::string& name) {
+    for (const Threshold& threshold : kThresholds) {
+        if (name == threshold.name) {
+            return threshold.minPSNR;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<uint8_t> CompressImage(const TextureCooker::RgbaImage& image, Format format, uint32_t threadCount) {
+    std::vector<uint8_t> compressed(GetSizeInBytes(format, image.width, image.height));
+    Compress({image.pixels.data(), image.width, image.height, image.width * 4u}, format, compressed.data(), 0,
+             threadCount);
+    return compressed;
+}
+
+void TestTexture(const std::string& name, const TextureCooker::RgbaImage& image) {
+    const double* thresholds = FindThreshold(name);
+    std::printf("%-28s %4u x %-4u", name.c_str(), image.width, image.height);
+    for (size_t f = 0; f < std::size(kFormats); ++f) {
+        const Format format = kFormats[f];
+        const std::vector<uint8_t> compressed = CompressImage(image, format, 1);
+        std::vector<uint8_t> decoded;
+        const bool isDecoded = Decode(format, compressed, image.width, image.height, decoded);
+        CHECK(isDecoded);
+        if (!isDecoded) {
+            continue;
+        }
+
+        const double psnr = ComputePSNR(format, image.pixels, decoded);
+        std::printf("  %s %5.1f", kFormatNames[f], psnr);
+        const double minPSNR = thresholds ? thresholds[f] : kDefaultMinPSNR;
+        if (!(psnr >= minPSNR)) {
+            std::printf("\n");
+            std::printf("FAIL %s %s: PSNR %.2f < %.2f\n", name.c_str(), kFormatNames[f], psnr, minPSNR);
+            ++failCount;
+        }
+
+        // BC1 は元のアルファが 128 未満のピクセルだけが透明になる
+        if (format == Format::BC1) {
+            size_t alphaMismatchCount = 0;
+            for (size_t i = 3; i < decoded.size(); i += 4) {
+                alphaMismatchCount += (image.pixels[i] >= 128) != (decoded[i] == 255);
+            }
+            CHECK(alphaMismatchCount == 0);
+        }
+    }
+    std::printf("\n");
+}
+
+void TestThreadCount(const TextureCooker::RgbaImage& image) {
+    for (Format format : kFormats) {
+        const std::vector<uint8_t> singleThreaded = CompressImage(image, format, 1);
+        CHECK(CompressImage(image, format, 4) == singleThreaded);
+        CHECK(CompressImage(image, format, 0) == singleThreaded);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <textures directory>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path root(argv[1]);
+
+    std::vector<std::string> names;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (entry.path().extension() == ".png") {
+            names.push_back(std::filesystem::relative(entry.path(), root).generic_string());
+        }
+    }
+    std::sort(names.begin(), names.end());
+    CHECK(names.size() >= std::size(kThresholds));
+
+    TextureCooker::RgbaImage largest;
+    for (const std::string& name : names) {
+        TextureCooker::RgbaImage image;
+        const bool isLoaded = PngImage::Load((root / name).string(), image);
+        CHECK(isLoaded);
+        if (!isLoaded) {
+            continue;
+        }
+        TestTexture(name, image);
+        if (image.width * image.height > largest.width * largest.height) {
+            largest = std::move(image);
+        }
+    }
+    TestThreadCount(largest);
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("BlockCompressorTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,128 @@
+// ============================================================
+// BoundingVolumeTest — 行列で変換した境界ボリュームのテスト
+//   ・せん断を含む行列で変換した球が、変換後の球面上の点をすべて囲む
+//     (行の長さの最大値を拡大率にすると、せん断で伸びた向きの点がはみ出していた)
+//   ・回転と均一な拡大だけなら、半径はちょうど拡大率倍になる (必要以上に大きくしない)
+//   ・変換した AABB が、変換後の8頂点を囲む
+// ============================================================
+#include "BoundingVolume.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+Matrix4x4 MakeMatrix(const float (&rows)[4][3]) {
+    Matrix4x4 matrix{};
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            matrix.m[i][j] = rows[i][j];
+        }
+    }
+    matrix.m[3][3] = 1.0f;
+    return matrix;
+}
+
+Vector3 TransformPoint(const Vector3& p, const Matrix4x4& m) {
+    return {p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+            p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+            p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2]};
+}
+
+float Distance(const Vector3& a, const Vector3& b) {
+    const float x = a.x - b.x, y = a.y - b.y, z = a.z - b.z;
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+// 球面上の点を変換したときに、変換した球からはみ出す量の最大値 (負ならすべて内側)
+float MaxOutside(const Sphere& sphere, const Matrix4x4& matrix, std::mt19937& randomEngine) {
+    const Sphere transformed = BoundingVolume::TransformSphere(sphere, matrix);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+    float maxOutside = -sphere.radius;
+    for (int i = 0; i < 20000; ++i) {
+        Vector3 direction = {normal(randomEngine), normal(randomEngine), normal(randomEngine)};
+        const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+        if (length == 0.0f) {
+            continue;
+        }
+        const Vector3 point = {sphere.center.x + direction.x / length * sphere.radius,
+                               sphere.center.y + direction.y / length * sphere.radius,
+                               sphere.center.z + direction.z / length * sphere.radius};
+        const float outside = Distance(TransformPoint(point, matrix), transformed.center) - transformed.radius;
+        maxOutside = std::max(maxOutside, outside);
+    }
+    return maxOutside;
+}
+
+void TestShearedSphere() {
+    std::mt19937 randomEngine(3u);
+    const Sphere sphere = {{0.5f, -1.0f, 2.0f}, 1.5f};
+
+    // X を Y 方向へ大きくせん断する (行の長さはどれも 1 ～ 2 だが、対角方向には約 2.9 倍に伸びる)
+    const Matrix4x4 shear = MakeMatrix({{1.0f, 2.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {3.0f, 4.0f, 5.0f}});
+    CHECK(MaxOutside(sphere, shear, randomEngine) <= 1e-4f);
+    CHECK(std::abs(BoundingVolume::ComputeMaxScale(shear) - (1.0f + std::sqrt(2.0f))) < 1e-4f);
+
+    // ランダムな行列でもはみ出さない
+    std::uniform_real_distribution<float> value(-2.0f, 2.0f);
+    for (int trial = 0; trial < 50; ++trial) {
+        float rows[4][3];
+        for (auto& row : rows) {
+            for (float& element : row) {
+                element = value(randomEngine);
+            }
+        }
+        CHECK(MaxOutside(sphere, MakeMatrix(rows), randomEngine) <= 1e-4f);
+    }
+}
+
+void TestUniformScale() {
+    // Z 軸回りに 30 度回転して 2 倍する
+    const float c = std::cos(0.5235988f) * 2.0f;
+    const float s = std::sin(0.5235988f) * 2.0f;
+    const Matrix4x4 matrix = MakeMatrix({{c, s, 0.0f}, {-s, c, 0.0f}, {0.0f, 0.0f, 2.0f}, {1.0f, 0.0f, 0.0f}});
+    const Sphere transformed = BoundingVolume::TransformSphere({{0.0f, 0.0f, 0.0f}, 1.0f}, matrix);
+    CHECK(std::abs(transformed.radius - 2.0f) < 1e-4f);
+    CHECK(Distance(transformed.center, {1.0f, 0.0f, 0.0f}) < 1e-6f);
+}
+
+void TestTransformAABB() {
+    const AABB aabb = {{-1.0f, 0.0f, 2.0f}, {3.0f, 1.0f, 4.0f}};
+    const Matrix4x4 matrix = MakeMatrix({{0.5f, 1.0f, -0.3f}, {0.2f, -1.5f, 0.8f}, {1.0f, 0.0f, 2.0f}, {-2.0f, 1.0f, 0.5f}});
+    const AABB transformed = BoundingVolume::TransformAABB(aabb, matrix);
+    for (int corner = 0; corner < 8; ++corner) {
+        const Vector3 p = {(corner & 1) ? aabb.max.x : aabb.min.x, (corner & 2) ? aabb.max.y : aabb.min.y,
+                           (corner & 4) ? aabb.max.z : aabb.min.z};
+        const Vector3 q = TransformPoint(p, matrix);
+        CHECK(q.x >= transformed.min.x - 1e-5f && q.x <= transformed.max.x + 1e-5f);
+        CHECK(q.y >= transformed.min.y - 1e-5f && q.y <= transformed.max.y + 1e-5f);
+        CHECK(q.z >= transformed.min.z - 1e-5f && q.z <= transformed.max.z + 1e-5f);
+    }
+}
+
+} // namespace
+
+int main() {
+    TestShearedSphere();
+    TestUniformScale();
+    TestTransformAABB();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("BoundingVolumeTest: all checks passed\n");
+    return 0;
+}
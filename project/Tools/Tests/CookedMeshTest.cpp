@@ -0,0 +1,151 @@
+// ============================================================
+// CookedMeshTest — モデルのバイナリキャッシュ (CookedMesh) のテスト
+//   ・書き出したものをそのまま読み戻せる
+//   ・OBJ が参照する MTL を書き換えるとキーが変わる
+//   ・範囲外の頂点を指すインデックスを含むファイルは読み込みに失敗する (呼び出し側で作り直す)
+//   ・複数スレッドから同じキャッシュを書き出しても壊れない
+// ============================================================
+#include "CookedMesh.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+void WriteText(const std::filesystem::path& path, const char* text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+// 四角形1枚 (2三角形) のモデル
+ModelData MakeQuad() {
+    ModelData modelData;
+    modelData.vertices = {
+        {{-1.0f, -1.0f, 0.0f, 1.0f}, {0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}},
+        {{-1.0f, 1.0f, 0.0f, 1.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}},
+        {{1.0f, 1.0f, 0.0f, 1.0f}, {1.0f, 0.0f}, {0.0f, 0.0f, -1.0f}},
+        {{1.0f, -1.0f, 0.0f, 1.0f}, {1.0f, 1.0f}, {0.0f, 0.0f, -1.0f}},
+    };
+    modelData.indices = {0, 1, 2, 0, 2, 3};
+    modelData.material.textureFilePath = "Resources/quad.png";
+    modelData.bounds = {{{-1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}}, {{0.0f, 0.0f, 0.0f}, 1.5f}};
+    modelData.nodes.localMatrices.push_back({});
+    modelData.nodes.parents.push_back(-1);
+    modelData.nodes.nameIds.push_back(0);
+    modelData.nodes.names.push_back("Root");
+    return modelData;
+}
+
+void TestRoundTrip(const std::filesystem::path& directory) {
+    const ModelData modelData = MakeQuad();
+    const std::string cachePath = (directory / "quad.mesh").string();
+    CHECK(CookedMesh::Save(cachePath, 42, modelData));
+
+    CookedMesh::CookedModel cooked;
+    CHECK(CookedMesh::Load(cachePath, 42, cooked));
+    CHECK(cooked.vertices.size() == modelData.vertices.size());
+    CHECK(std::equal(cooked.indices.begin(), cooked.indices.end(), modelData.indices.begin(), modelData.indices.end()));
+    CHECK(cooked.material.textureFilePath == modelData.material.textureFilePath);
+    CHECK(cooked.nodes.names == modelData.nodes.names);
+
+    // キーが違えば読まない
+    CookedMesh::CookedModel other;
+    CHECK(!CookedMesh::Load(cachePath, 43, other));
+}
+
+void TestMaterialLibraryKey(const std::filesystem::path& directory) {
+    const std::filesystem::path objPath = directory / "box.obj";
+    WriteText(objPath, "mtllib box.mtl\nv 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nvn 0 0 1\nusemtl Box\nf 1/1/1 2/1/1 3/1/1\n");
+    WriteText(directory / "box.mtl", "newmtl Box\nmap_Kd box.png\n");
+    const uint64_t key = CookedMesh::ComputeKey(objPath.string(), 0);
+    CHECK(key != 0);
+    CHECK(CookedMesh::ComputeKey(objPath.string(), 0) == key);
+
+    // MTL だけを書き換えてもキーが変わる
+    WriteText(directory / "box.mtl", "newmtl Box\nmap_Kd box_red.png\n");
+    const uint64_t changedKey = CookedMesh::ComputeKey(objPath.string(), 0);
+    CHECK(changedKey != 0);
+    CHECK(changedKey != key);
+
+    // インポート設定が違ってもキーが変わる
+    CHECK(CookedMesh::ComputeKey(objPath.string(), 1) != changedKey);
+
+    // 元ファイルが無ければキーなし
+    CHECK(CookedMesh::ComputeKey((directory / "missing.obj").string(), 0) == 0);
+}
+
+void TestOutOfRangeIndex(const std::filesystem::path& directory) {
+    ModelData modelData = MakeQuad();
+    modelData.indices[4] = static_cast<uint32_t>(modelData.vertices.size()); // 1つ先の頂点を指す
+    const std::string cachePath = (directory / "broken.mesh").string();
+    CHECK(CookedMesh::Save(cachePath, 7, modelData));
+
+    CookedMesh::CookedModel cooked;
+    CHECK(!CookedMesh::Load(cachePath, 7, cooked));
+}
+
+void TestConcurrentSave(const std::filesystem::path& directory) {
+    const ModelData modelData = MakeQuad();
+    const std::string cachePath = (directory / "shared.mesh").string();
+
+    std::vector<std::thread> threads;
+    std::vector<char> results(8, 0);
+    for (size_t i = 0; i < results.size(); ++i) {
+        threads.emplace_back([&, i] {
+            for (int repeat = 0; repeat < 20; ++repeat) {
+                results[i] = CookedMesh::Save(cachePath, 99, modelData) ? 1 : 0;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (char result : results) {
+        CHECK(result == 1);
+    }
+
+    CookedMesh::CookedModel cooked;
+    CHECK(CookedMesh::Load(cachePath, 99, cooked));
+    CHECK(cooked.indices.size() == modelData.indices.size());
+
+    // 一時ファイルが残っていない
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        CHECK(entry.path().extension() != ".tmp");
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "CookedMeshTest";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    TestRoundTrip(directory);
+    TestMaterialLibraryKey(directory);
+    TestOutOfRangeIndex(directory);
+    TestConcurrentSave(directory);
+
+    std::filesystem::remove_all(directory);
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("CookedMeshTest: all checks passed\n");
+    return 0;
+}
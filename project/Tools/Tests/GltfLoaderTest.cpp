@@ -0,0 +1,214 @@
+// ============================================================
+// GltfLoaderTest — glTF 専用リーダー (GltfLoader) のテスト
+//   ・Resources の plane.gltf + plane.bin (Blender で書き出した 2x2 の板) を読み、既知の値と比べる
+//     位置・法線は X を反転、UV はそのまま、インデックスは三角形ごとに巻き順を反転
+//     マテリアルは uvChecker.png と既定のマテリアル、ノードは回転だけを持つ "Plane" 1つ
+//   ・同じ plane.bin を参照する、ルートが2つでノードが入れ子になった glTF を一時ディレクトリに書いて読み、
+//     ノードの並び (親が子より前・最初の子から)・名前 ("ROOT" と "nodes_<番号>")・ローカル行列・ワールド行列を比べる
+//   ・存在しないファイルと壊れた JSON は失敗する
+// 使い方: GltfLoaderTest <Resources/Assets/Models のパス>
+// ============================================================
+#include "GltfLoader.h"
+#include "NodeTransform.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+bool NearlyEqual(const Matrix4x4& a, const Matrix4x4& b, float tolerance = 1e-6f) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            if (std::abs(a.m[i][j] - b.m[i][j]) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool IsVertex(const VertexData& vertex, const Vector3& position, const Vector2& texcoord, const Vector3& normal) {
+    return vertex.position.x == position.x && vertex.position.y == position.y && vertex.position.z == position.z &&
+           vertex.position.w == 1.0f && vertex.texcoord.x == texcoord.x && vertex.texcoord.y == texcoord.y &&
+           vertex.normal.x == normal.x && vertex.normal.y == normal.y && vertex.normal.z == normal.z;
+}
+
+const std::string& GetNodeName(const NodeHierarchy& nodes, uint32_t index) {
+    return nodes.names[nodes.nameIds[index]];
+}
+
+void TestPlane(const std::string& directory) {
+    ModelData modelData;
+    CHECK(GltfLoader::Load(directory, "plane.gltf", modelData));
+
+    // plane.bin の POSITION は (-1,0,1) (1,0,1) (-1,0,-1) (1,0,-1)、NORMAL は全て (0,1,0)、
+    // TEXCOORD_0 は (0,1) (1,1) (0,0) (1,0)
+    CHECK(modelData.vertices.size() == 4);
+    if (modelData.vertices.size() == 4) {
+        const Vector3 up = {0.0f, 1.0f, 0.0f};
+        CHECK(IsVertex(modelData.vertices[0], {1.0f, 0.0f, 1.0f}, {0.0f, 1.0f}, up));
+        CHECK(IsVertex(modelData.vertices[1], {-1.0f, 0.0f, 1.0f}, {1.0f, 1.0f}, up));
+        CHECK(IsVertex(modelData.vertices[2], {1.0f, 0.0f, -1.0f}, {0.0f, 0.0f}, up));
+        CHECK(IsVertex(modelData.vertices[3], {-1.0f, 0.0f, -1.0f}, {1.0f, 0.0f}, up));
+    }
+    // インデックスは (1,2,0) (1,3,2) を三角形ごとに反転したもの
+    CHECK((modelData.indices == std::vector<uint32_t>{0, 2, 1, 2, 3, 1}));
+
+    // テクスチャ付きのマテリアルと、その後ろの既定のマテリアル
+    CHECK(modelData.materials.size() == 2);
+    if (modelData.materials.size() == 2) {
+        CHECK(modelData.materials[0].textureFilePath == directory + "/uvChecker.png");
+        CHECK(modelData.materials[1].textureFilePath.empty());
+    }
+    CHECK(modelData.material.textureFilePath == directory + "/uvChecker.png");
+    CHECK(modelData.subMeshes.size() == 1);
+    if (modelData.subMeshes.size() == 1) {
+        CHECK(modelData.subMeshes[0].materialIndex == 0);
+        CHECK(modelData.subMeshes[0].indexOffset == 0 && modelData.subMeshes[0].indexCount == 6);
+    }
+    CHECK(modelData.influences.empty() && modelData.joints.empty() && modelData.animations.empty());
+
+    // ノードは "Plane" 1つ。回転 (0, 0.7071, -0.7071, 0) は軸 (0, 1, -1) まわりの 180 度
+    const NodeHierarchy& nodes = modelData.nodes;
+    CHECK(nodes.GetNodeCount() == 1);
+    if (nodes.GetNodeCount() == 1) {
+        CHECK(GetNodeName(nodes, 0) == "Plane");
+        CHECK(nodes.parents[0] == -1);
+        Matrix4x4 expected = MathGenerators::MakeIdentity4x4();
+        expected.m[0][0] = -1.0f;
+        expected.m[1][1] = 0.0f;
+        expected.m[1][2] = -1.0f;
+        expected.m[2][1] = -1.0f;
+        expected.m[2][2] = 0.0f;
+        CHECK(NearlyEqual(nodes.localMatrices[0], expected));
+    }
+}
+
+// plane.bin を使う、ルートが2つのシーン
+//   scene: [0, 3]
+//   0 "Arm"  (平行移動 (1, 2, 3)) ─┬─ 1 名前なし (matrix: 平行移動 (0, 1, 0)) ── 2 "Hand" (スケール 2、メッシュ)
+//                                   └─ 4 "Elbow" (回転 Z 90度)
+//   3 "Light" (平行移動 (0, 5, 0))
+const char* kHierarchyGltf = R"({
+    "asset": {"version": "2.0"},
+    "scene": 0,
+    "scenes": [{"nodes": [0, 3]}],
+    "nodes": [
+        {"name": "Arm", "translation": [1, 2, 3], "children": [1, 4]},
+        {"matrix": [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 1], "children": [2]},
+        {"name": "Hand", "scale": [2, 2, 2], "mesh": 0},
+        {"name": "Light", "translation": [0, 5, 0]},
+        {"name": "Elbow", "rotation": [0, 0, 0.70710678, 0.70710678]}
+    ],
+    "meshes": [{"primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1, "TEXCOORD_0": 2}, "indices": 3}]}],
+    "accessors": [
+        {"bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3"},
+        {"bufferView": 1, "componentType": 5126, "count": 4, "type": "VEC3"},
+        {"bufferView": 2, "componentType": 5126, "count": 4, "type": "VEC2"},
+        {"bufferView": 3, "componentType": 5123, "count": 6, "type": "SCALAR"}
+    ],
+    "bufferViews": [
+        {"buffer": 0, "byteLength": 48, "byteOffset": 0},
+        {"buffer": 0, "byteLength": 48, "byteOffset": 48},
+        {"buffer": 0, "byteLength": 32, "byteOffset": 96},
+        {"buffer": 0, "byteLength": 12, "byteOffset": 128}
+    ],
+    "buffers": [{"byteLength": 140, "uri": "plane.bin"}]
+})";
+
+void TestHierarchy(const std::filesystem::path& planeDirectory, const std::filesystem::path& workDirectory) {
+    std::filesystem::copy_file(planeDirectory / "plane.bin", workDirectory / "plane.bin",
+                               std::filesystem::copy_options::overwrite_existing);
+    std::ofstream(workDirectory / "hierarchy.gltf") << kHierarchyGltf;
+
+    ModelData modelData;
+    CHECK(GltfLoader::Load(workDirectory.generic_string(), "hierarchy.gltf", modelData));
+    CHECK(modelData.vertices.size() == 4 && modelData.indices.size() == 6);
+    // マテリアルの無いプリミティブは既定のマテリアルだけ
+    CHECK(modelData.materials.size() == 1 && modelData.materials[0].textureFilePath.empty());
+
+    // 親が子より前、兄弟は最初の子から
+    const NodeHierarchy& nodes = modelData.nodes;
+    const char* expectedNames[] = {"ROOT", "Arm", "nodes_1", "Hand", "Elbow", "Light"};
+    const int32_t expectedParents[] = {-1, 0, 1, 2, 1, 0};
+    CHECK(nodes.GetNodeCount() == 6);
+    if (nodes.GetNodeCount() != 6) {
+        return;
+    }
+    for (uint32_t i = 0; i < 6; ++i) {
+        CHECK(GetNodeName(nodes, i) == expectedNames[i]);
+        CHECK(nodes.parents[i] == expectedParents[i]);
+    }
+    CHECK(NodeTransform::FindNode(nodes, "Hand") == 3);
+
+    // ローカル行列 (行ベクトル規約なので平行移動は4行目)
+    using namespace MathGenerators;
+    CHECK(NearlyEqual(nodes.localMatrices[0], MakeIdentity4x4()));
+    CHECK(NearlyEqual(nodes.localMatrices[1], MakeTranslationMatrix({1.0f, 2.0f, 3.0f})));
+    CHECK(NearlyEqual(nodes.localMatrices[2], MakeTranslationMatrix({0.0f, 1.0f, 0.0f})));
+    CHECK(NearlyEqual(nodes.localMatrices[3], MakeScaleMatrix({2.0f, 2.0f, 2.0f})));
+    CHECK(NearlyEqual(nodes.localMatrices[4], MakeRotateZMatrix(1.5707963f)));
+    CHECK(NearlyEqual(nodes.localMatrices[5], MakeTranslationMatrix({0.0f, 5.0f, 0.0f})));
+
+    // ワールド行列: Hand はスケール 2 のまま (1, 3, 3) に、Elbow は Arm の位置で回転、Light はルート直下
+    std::vector<Matrix4x4> worldMatrices(nodes.GetNodeCount());
+    NodeTransform::ComputeWorldMatrices(nodes, MakeIdentity4x4(), worldMatrices);
+    Matrix4x4 hand = MakeScaleMatrix({2.0f, 2.0f, 2.0f});
+    hand.m[3][0] = 1.0f;
+    hand.m[3][1] = 3.0f;
+    hand.m[3][2] = 3.0f;
+    CHECK(NearlyEqual(worldMatrices[3], hand));
+    CHECK(NearlyEqual(worldMatrices[4], MathUtils::Multiply(MakeRotateZMatrix(1.5707963f),
+                                                            MakeTranslationMatrix({1.0f, 2.0f, 3.0f}))));
+    CHECK(NearlyEqual(worldMatrices[5], MakeTranslationMatrix({0.0f, 5.0f, 0.0f})));
+}
+
+void TestFailures(const std::string& directory, const std::filesystem::path& workDirectory) {
+    ModelData modelData;
+    CHECK(!GltfLoader::Load(directory, "missing.gltf", modelData));
+    std::ofstream(workDirectory / "broken.gltf") << R"({"asset": {"version": "2.0"}, "scenes": [)";
+    CHECK(!GltfLoader::Load(workDirectory.generic_string(), "broken.gltf", modelData));
+    // シーンのノードが範囲外
+    std::ofstream(workDirectory / "badnode.gltf") << R"({"asset": {"version": "2.0"}, "scenes": [{"nodes": [3]}]})";
+    CHECK(!GltfLoader::Load(workDirectory.generic_string(), "badnode.gltf", modelData));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <Resources/Assets/Models>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path planeDirectory = std::filesystem::path(argv[1]) / "plane";
+    const std::filesystem::path workDirectory = std::filesystem::temp_directory_path() / "GltfLoaderTest";
+    std::filesystem::create_directories(workDirectory);
+
+    TestPlane(planeDirectory.generic_string());
+    TestHierarchy(planeDirectory, workDirectory);
+    TestFailures(planeDirectory.generic_string(), workDirectory);
+    std::filesystem::remove_all(workDirectory);
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("GltfLoaderTest: all checks passed\n");
+    return 0;
+}
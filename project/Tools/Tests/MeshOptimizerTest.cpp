@@ -0,0 +1,142 @@
+// ============================================================
+// MeshOptimizerTest — インポート時のメッシュ最適化 (MeshOptimizer::Optimize) のテスト
+//   ・格子のメッシュ (行の順・三角形を混ぜた順) と terrain.obj で、最適化の後の ACMR が悪くならない (どれも1割以上良くなる)
+//   ・三角形の集合 (頂点の値と巻き順) は変わらない
+//   ・参照されない頂点は消え、インデックスはすべて頂点の範囲内
+// 使い方: MeshOptimizerTest <Resources/Assets/Models のパス>
+// ============================================================
+#include "MeshOptimizer.h"
+#include "ObjLoader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+// 三角形を頂点の値で表したもの (巻き順を保ったまま、最小の頂点が先頭に来るよう回す)
+using VertexBytes = std::array<unsigned char, sizeof(VertexData)>;
+using Triangle = std::array<VertexBytes, 3>;
+
+VertexBytes ToBytes(const VertexData& vertex) {
+    VertexBytes bytes;
+    std::memcpy(bytes.data(), &vertex, sizeof(VertexData));
+    return bytes;
+}
+
+std::vector<Triangle> CollectTriangles(const ModelData& modelData) {
+    std::vector<Triangle> triangles;
+    for (size_t i = 0; i + 2 < modelData.indices.size(); i += 3) {
+        Triangle triangle = {ToBytes(modelData.vertices[modelData.indices[i]]),
+                             ToBytes(modelData.vertices[modelData.indices[i + 1]]),
+                             ToBytes(modelData.vertices[modelData.indices[i + 2]])};
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// 最適化して、ACMR・三角形の集合・インデックスを確かめる
+void CheckOptimize(ModelData modelData, const char* name) {
+    const std::vector<Triangle> sourceTriangles = CollectTriangles(modelData);
+    const MeshOptimizer::CacheStats before = MeshOptimizer::AnalyzeVertexCache(modelData.indices, modelData.vertices.size());
+
+    MeshOptimizer::Optimize(modelData, name);
+    const MeshOptimizer::CacheStats after = MeshOptimizer::AnalyzeVertexCache(modelData.indices, modelData.vertices.size());
+    std::printf("%s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", name, before.acmr, after.acmr, before.atvr, after.atvr);
+
+    CHECK(after.acmr <= before.acmr);
+    CHECK(after.acmr < before.acmr * 0.9f);
+    CHECK(CollectTriangles(modelData) == sourceTriangles);
+
+    std::vector<bool> isReferenced(modelData.vertices.size(), false);
+    bool isInRange = true;
+    for (uint32_t index : modelData.indices) {
+        isInRange = isInRange && index < modelData.vertices.size();
+        if (index < modelData.vertices.size()) {
+            isReferenced[index] = true;
+        }
+    }
+    CHECK(isInRange);
+    CHECK(std::find(isReferenced.begin(), isReferenced.end(), false) == isReferenced.end());
+}
+
+// size x size 個の四角形の格子 (頂点は共有、三角形は行の順)
+ModelData MakeGrid(uint32_t size) {
+    ModelData modelData;
+    for (uint32_t z = 0; z <= size; ++z) {
+        for (uint32_t x = 0; x <= size; ++x) {
+            const float u = static_cast<float>(x) / size;
+            const float v = static_cast<float>(z) / size;
+            modelData.vertices.push_back({{u * 10.0f, 0.0f, v * 10.0f, 1.0f}, {u, v}, {0.0f, 1.0f, 0.0f}});
+        }
+    }
+    for (uint32_t z = 0; z < size; ++z) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const uint32_t v00 = z * (size + 1) + x;
+            const uint32_t v10 = v00 + 1;
+            const uint32_t v01 = v00 + size + 1;
+            const uint32_t v11 = v01 + 1;
+            modelData.indices.insert(modelData.indices.end(), {v00, v01, v10, v10, v01, v11});
+        }
+    }
+    return modelData;
+}
+
+// 三角形の順を混ぜる (頂点キャッシュにとって最悪に近い並び)
+ModelData ShuffleTriangles(ModelData modelData) {
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i < modelData.indices.size(); i += 3) {
+        triangles.push_back({modelData.indices[i], modelData.indices[i + 1], modelData.indices[i + 2]});
+    }
+    std::mt19937 randomEngine(3u);
+    std::shuffle(triangles.begin(), triangles.end(), randomEngine);
+    modelData.indices.clear();
+    for (const auto& triangle : triangles) {
+        modelData.indices.insert(modelData.indices.end(), triangle.begin(), triangle.end());
+    }
+    return modelData;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <Resources/Assets/Models path>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path modelDirectory = argv[1];
+
+    const ModelData grid = MakeGrid(64);
+    CheckOptimize(grid, "grid (row order)");
+    CheckOptimize(ShuffleTriangles(grid), "grid (shuffled)");
+
+    // フラットシェーディングのメッシュ (面ごとに法線が違うので、共有できる頂点が少ない)
+    ModelData terrain;
+    CHECK(ObjLoader::Load((modelDirectory / "terrain").generic_string(), "terrain.obj", terrain));
+    CHECK(!terrain.indices.empty());
+    CheckOptimize(terrain, "terrain.obj");
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("MeshOptimizerTest: all checks passed\n");
+    return 0;
+}
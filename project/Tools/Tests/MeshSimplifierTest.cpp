@@ -0,0 +1,138 @@
+// ============================================================
+// MeshSimplifierTest — LOD の生成 (MeshSimplifier::BuildLodChain) のテスト
+//   ・フラットシェーディングのメッシュ (terrain.obj) でも LOD が作られる
+//     (法線だけが違う頂点をシームとして扱うと、全頂点が固定されて1つも縮約できなかった)
+//   ・簡略化した三角形の法線は面の向きに近い (面ごとの法線が保たれる)
+//   ・スムーズシェーディングのメッシュ (sphere.obj) の LOD も今まで通り作られる
+// 使い方: MeshSimplifierTest <Resources/Assets/Models のパス>
+// ============================================================
+#include "MeshSimplifier.h"
+#include "ObjLoader.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+bool LoadObj(const std::filesystem::path& path, ModelData& modelData) {
+    return ObjLoader::Load(path.parent_path().generic_string(), path.filename().string(), modelData);
+}
+
+Vector3 GetPosition(const VertexData& vertex) { return {vertex.position.x, vertex.position.y, vertex.position.z}; }
+
+// 三角形の頂点の法線と面の向きの一致度
+struct NormalAgreement {
+    double meanDot = 0.0;      // なす角の cos の平均
+    double mismatchRate = 0.0; // cos が 0.9 未満の頂点の割合
+};
+
+NormalAgreement MeasureNormalAgreement(const ModelData& modelData, const MeshLod& lod) {
+    double sum = 0.0;
+    uint32_t count = 0;
+    uint32_t mismatchCount = 0;
+    for (uint32_t i = 0; i < lod.indexCount; i += 3) {
+        const uint32_t* triangle = &modelData.indices[lod.indexOffset + i];
+        const Vector3 p0 = GetPosition(modelData.vertices[triangle[0]]);
+        const Vector3 p1 = GetPosition(modelData.vertices[triangle[1]]);
+        const Vector3 p2 = GetPosition(modelData.vertices[triangle[2]]);
+        const Vector3 e1 = {p1.x - p0.x, p1.y - p0.y, p1.z - p0.z};
+        const Vector3 e2 = {p2.x - p0.x, p2.y - p0.y, p2.z - p0.z};
+        const Vector3 n = {e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x};
+        const float length = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+        if (length == 0.0f) {
+            continue;
+        }
+        for (int k = 0; k < 3; ++k) {
+            const Vector3& normal = modelData.vertices[triangle[k]].normal;
+            const float dot = (normal.x * n.x + normal.y * n.y + normal.z * n.z) / length;
+            sum += dot;
+            ++count;
+            mismatchCount += dot < 0.9f ? 1 : 0;
+        }
+    }
+    NormalAgreement result;
+    if (count > 0) {
+        result.meanDot = sum / count;
+        result.mismatchRate = static_cast<double>(mismatchCount) / count;
+    }
+    return result;
+}
+
+void CheckLods(const ModelData& modelData) {
+    const uint32_t vertexCount = static_cast<uint32_t>(modelData.vertices.size());
+    for (size_t l = 1; l < modelData.lods.size(); ++l) {
+        const MeshLod& lod = modelData.lods[l];
+        CHECK(lod.indexCount % 3 == 0);
+        CHECK(lod.indexCount < modelData.lods[l - 1].indexCount);
+        for (uint32_t i = 0; i < lod.indexCount; ++i) {
+            CHECK(modelData.indices[lod.indexOffset + i] < vertexCount);
+        }
+    }
+}
+
+void TestFlatShaded(const std::filesystem::path& modelsDirectory) {
+    ModelData modelData;
+    CHECK(LoadObj(modelsDirectory / "terrain/terrain.obj", modelData));
+    MeshSimplifier::BuildLodChain(modelData, "terrain.obj");
+
+    // 同一平面の面を縮約し終えた後も、誤差の範囲で LOD2 以降が作られる
+    CHECK(modelData.lods.size() >= 3);
+    if (modelData.lods.size() < 3) {
+        return;
+    }
+    CheckLods(modelData);
+    CHECK(modelData.lods[2].indexCount <= modelData.lods[0].indexCount / 3);
+
+    // LOD0 は面ごとの法線そのもの
+    // 簡略化したLODも、同じ位置の頂点のうち面の向きに近い法線のものを使う
+    // (新しい頂点は作らないので、元の面に無い向きの三角形だけは法線がずれる)
+    const NormalAgreement lod0 = MeasureNormalAgreement(modelData, modelData.lods[0]);
+    CHECK(lod0.meanDot > 0.999);
+    for (size_t l = 1; l < modelData.lods.size(); ++l) {
+        const NormalAgreement agreement = MeasureNormalAgreement(modelData, modelData.lods[l]);
+        std::printf("terrain LOD%zu: %u triangles, error %.4f, normal dot mean %.3f, mismatch %.1f%%\n", l,
+                    modelData.lods[l].indexCount / 3, modelData.lods[l].error, agreement.meanDot,
+                    agreement.mismatchRate * 100.0);
+        CHECK(agreement.meanDot > 0.95);
+        CHECK(agreement.mismatchRate < 0.1);
+    }
+}
+
+void TestSmoothShaded(const std::filesystem::path& modelsDirectory) {
+    ModelData modelData;
+    CHECK(LoadObj(modelsDirectory / "sphere/sphere.obj", modelData));
+    MeshSimplifier::BuildLodChain(modelData, "sphere.obj");
+    CHECK(modelData.lods.size() >= 2);
+    CheckLods(modelData);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <models directory>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path modelsDirectory = argv[1];
+    TestFlatShaded(modelsDirectory);
+    TestSmoothShaded(modelsDirectory);
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("MeshSimplifierTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,265 @@
+// ============================================================
+// MeshletBuilderTest — メッシュレットの分割 (MeshletBuilder) とカリング (ClusterCuller) のテスト
+//   ・すべての三角形がちょうど1つのメッシュレットに入る (巻き順もそのまま)
+//   ・頂点数・三角形数の上限を守り、メッシュレット内の頂点番号は範囲内、包む球はすべての頂点を含む
+//   ・サブメッシュごとに分けた場合、メッシュレットはサブメッシュの範囲をまたがない
+//   ・視錐台カリング: 三角形ごとの総当たりで視錐台にかかる三角形はすべて残る
+//   ・裏面カリング: 表を向いていて視錐台にかかる三角形は捨てない
+// 使い方: MeshletBuilderTest <Resources/Assets/Models のパス>
+// ============================================================
+#include "ClusterCuller.h"
+#include "MeshOptimizer.h"
+#include "MeshletBuilder.h"
+#include "ObjLoader.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace MathGenerators;
+using namespace MathUtils;
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+using Triangle = std::array<uint32_t, 3>;
+
+Vector3 GetPosition(const VertexData& vertex) { return {vertex.position.x, vertex.position.y, vertex.position.z}; }
+
+// 巻き順を保ったまま、最小の番号が先頭に来るよう回す
+Triangle MakeTriangle(uint32_t a, uint32_t b, uint32_t c) {
+    Triangle triangle = {a, b, c};
+    std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+    return triangle;
+}
+
+std::vector<Triangle> CollectTriangles(std::span<const uint32_t> indices) {
+    std::vector<Triangle> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        triangles.push_back(MakeTriangle(indices[i], indices[i + 1], indices[i + 2]));
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+std::vector<Triangle> CollectMeshletTriangles(const MeshletData& meshletData, const Meshlet& meshlet) {
+    std::vector<Triangle> triangles;
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+        const uint8_t* local = &meshletData.triangles[meshlet.triangleOffset + t * 3];
+        const uint32_t* vertices = &meshletData.vertices[meshlet.vertexOffset];
+        triangles.push_back(MakeTriangle(vertices[local[0]], vertices[local[1]], vertices[local[2]]));
+    }
+    return triangles;
+}
+
+// 分割の結果を確かめる (三角形の集合・上限・包む球)
+void CheckMeshlets(const MeshletData& meshletData, std::span<const uint32_t> indices,
+                   std::span<const VertexData> vertices, uint32_t maxVertices, uint32_t maxTriangles) {
+    std::vector<Triangle> triangles;
+    bool isWithinLimits = true;
+    bool isLocalInRange = true;
+    bool isEnclosed = true;
+    for (const Meshlet& meshlet : meshletData.meshlets) {
+        isWithinLimits = isWithinLimits && meshlet.vertexCount > 0 && meshlet.vertexCount <= maxVertices &&
+                         meshlet.triangleCount > 0 && meshlet.triangleCount <= maxTriangles;
+        for (uint32_t i = 0; i < meshlet.triangleCount * 3; ++i) {
+            isLocalInRange = isLocalInRange && meshletData.triangles[meshlet.triangleOffset + i] < meshlet.vertexCount;
+        }
+        for (uint32_t v = 0; v < meshlet.vertexCount; ++v) {
+            const Vector3 offset = Subtract(GetPosition(vertices[meshletData.vertices[meshlet.vertexOffset + v]]), meshlet.center);
+            isEnclosed = isEnclosed && std::sqrt(Dot(offset, offset)) <= meshlet.radius * 1.0001f + 1e-5f;
+        }
+        const std::vector<Triangle> meshletTriangles = CollectMeshletTriangles(meshletData, meshlet);
+        triangles.insert(triangles.end(), meshletTriangles.begin(), meshletTriangles.end());
+    }
+    std::sort(triangles.begin(), triangles.end());
+    CHECK(isWithinLimits);
+    CHECK(isLocalInRange);
+    CHECK(isEnclosed);
+    CHECK(triangles == CollectTriangles(indices));
+    CHECK(meshletData.groupOffsets.size() == 2 && meshletData.groupOffsets.back() == meshletData.meshlets.size());
+}
+
+// 左手系で target を向くカメラのビュー行列 (行ベクトル規約)
+Matrix4x4 MakeLookAt(const Vector3& eye, const Vector3& target) {
+    const Vector3 zAxis = Normalize(Subtract(target, eye));
+    const Vector3 xAxis = Normalize(Cross({0.0f, 1.0f, 0.0f}, zAxis));
+    const Vector3 yAxis = Cross(zAxis, xAxis);
+    Matrix4x4 view = MakeIdentity4x4();
+    const Vector3 axes[3] = {xAxis, yAxis, zAxis};
+    for (int j = 0; j < 3; ++j) {
+        view.m[0][j] = axes[j].x;
+        view.m[1][j] = axes[j].y;
+        view.m[2][j] = axes[j].z;
+        view.m[3][j] = -Dot(axes[j], eye);
+    }
+    return view;
+}
+
+// 三角形の3頂点がすべて同じ平面の外にあるか (総当たりの視錐台判定)
+bool IsTriangleOutside(const ClusterCuller::Frustum& frustum, const Vector3 (&p)[3]) {
+    for (const Vector4& plane : frustum.planes) {
+        bool isAllOutside = true;
+        for (const Vector3& point : p) {
+            isAllOutside = isAllOutside && plane.x * point.x + plane.y * point.y + plane.z * point.z + plane.w < -1e-4f;
+        }
+        if (isAllOutside) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ランダムなカメラでカリングし、総当たりの結果と比べる
+void CheckCulling(const MeshletData& meshletData, std::span<const uint32_t> indices,
+                  std::span<const VertexData> vertices, const char* name) {
+    Vector3 minimum = GetPosition(vertices[0]);
+    Vector3 maximum = minimum;
+    for (const VertexData& vertex : vertices) {
+        minimum = {std::min(minimum.x, vertex.position.x), std::min(minimum.y, vertex.position.y),
+                   std::min(minimum.z, vertex.position.z)};
+        maximum = {std::max(maximum.x, vertex.position.x), std::max(maximum.y, vertex.position.y),
+                   std::max(maximum.z, vertex.position.z)};
+    }
+    const Vector3 center = {(minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f};
+    const Vector3 extent = Subtract(maximum, center);
+    const float radius = std::sqrt(Dot(extent, extent));
+
+    const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 16.0f / 9.0f, 0.1f, radius * 10.0f);
+    std::mt19937 randomEngine(17u);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<uint32_t> culled;
+    std::vector<uint32_t> groupOffsets;
+    uint64_t bruteForceTotal = 0;
+    uint64_t keptTotal = 0;
+    uint32_t missedFrustum = 0;
+    uint32_t missedBackface = 0;
+    for (int camera = 0; camera < 100; ++camera) {
+        const Vector3 eye = {center.x + unit(randomEngine) * radius * 1.5f, center.y + (unit(randomEngine) + 1.2f) * radius,
+                             center.z + unit(randomEngine) * radius * 1.5f};
+        const Vector3 target = {center.x + unit(randomEngine) * radius, center.y, center.z + unit(randomEngine) * radius};
+        const ClusterCuller::Frustum frustum = ClusterCuller::ExtractFrustum(Multiply(MakeLookAt(eye, target), projection));
+
+        for (bool cullBackfaces : {false, true}) {
+            const ClusterCuller::CullStats stats = ClusterCuller::Cull(meshletData, frustum, eye, cullBackfaces, culled, groupOffsets);
+            CHECK(stats.visibleMeshlets + stats.frustumCulledMeshlets + stats.backfaceCulledMeshlets ==
+                  meshletData.meshlets.size());
+            CHECK(stats.visibleTriangles * 3 == culled.size());
+            CHECK(cullBackfaces || stats.backfaceCulledMeshlets == 0);
+
+            const std::vector<Triangle> kept = CollectTriangles(culled);
+            for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+                const Vector3 p[3] = {GetPosition(vertices[indices[i]]), GetPosition(vertices[indices[i + 1]]),
+                                      GetPosition(vertices[indices[i + 2]])};
+                if (IsTriangleOutside(frustum, p)) {
+                    continue;
+                }
+                // 表向き = カメラが cross(b - a, c - a) の側にある (表面は時計回り)
+                const Vector3 normal = Cross(Subtract(p[1], p[0]), Subtract(p[2], p[0]));
+                if (cullBackfaces && Dot(normal, Subtract(eye, p[0])) <= 1e-6f) {
+                    continue;
+                }
+                ++bruteForceTotal;
+                const Triangle triangle = MakeTriangle(indices[i], indices[i + 1], indices[i + 2]);
+                if (!std::binary_search(kept.begin(), kept.end(), triangle)) {
+                    ++(cullBackfaces ? missedBackface : missedFrustum);
+                }
+            }
+            keptTotal += kept.size();
+        }
+    }
+    std::printf("%s: %zu meshlets, kept %llu triangles for %llu visible by brute force (%.2fx)\n", name,
+                meshletData.meshlets.size(), static_cast<unsigned long long>(keptTotal),
+                static_cast<unsigned long long>(bruteForceTotal),
+                bruteForceTotal > 0 ? static_cast<double>(keptTotal) / bruteForceTotal : 0.0);
+    CHECK(missedFrustum == 0);
+    CHECK(missedBackface == 0);
+    CHECK(bruteForceTotal > 0);
+}
+
+// 1つのモデルの分割とカリングを確かめる
+void CheckModel(const std::filesystem::path& path) {
+    ModelData modelData;
+    CHECK(ObjLoader::Load(path.parent_path().generic_string(), path.filename().string(), modelData));
+    if (modelData.indices.empty()) {
+        return;
+    }
+    MeshOptimizer::Optimize(modelData, path.filename().string());
+
+    const MeshletData meshletData = MeshletBuilder::Build(modelData.indices, modelData.vertices);
+    CheckMeshlets(meshletData, modelData.indices, modelData.vertices, MeshletBuilder::kMaxVertices,
+                  MeshletBuilder::kMaxTriangles);
+    // 小さい上限でも守る
+    const MeshletData small = MeshletBuilder::Build(modelData.indices, modelData.vertices, 16, 8);
+    CheckMeshlets(small, modelData.indices, modelData.vertices, 16, 8);
+    CHECK(small.meshlets.size() > meshletData.meshlets.size());
+
+    CheckCulling(meshletData, modelData.indices, modelData.vertices, path.filename().string().c_str());
+}
+
+void TestSubMeshes(const std::filesystem::path& path) {
+    ModelData modelData;
+    CHECK(ObjLoader::Load(path.parent_path().generic_string(), path.filename().string(), modelData));
+    // 三角形を3つのサブメッシュに分ける (境目は三角形の途中にならないようにする)
+    const uint32_t triangleCount = static_cast<uint32_t>(modelData.indices.size() / 3);
+    const uint32_t first = triangleCount / 3 * 3;
+    const uint32_t second = triangleCount * 2 / 3 * 3;
+    std::vector<SubMesh> subMeshes = {{0, 0, first, {}},
+                                      {1, first, second - first, {}},
+                                      {2, second, static_cast<uint32_t>(modelData.indices.size()) - second, {}}};
+
+    const MeshletData meshletData = MeshletBuilder::Build(modelData.indices, modelData.vertices, subMeshes);
+    CHECK(meshletData.groupOffsets.size() == subMeshes.size() + 1);
+    CHECK(meshletData.groupOffsets.back() == meshletData.meshlets.size());
+    for (size_t group = 0; group < subMeshes.size() && group + 1 < meshletData.groupOffsets.size(); ++group) {
+        const std::span<const uint32_t> range(modelData.indices.data() + subMeshes[group].indexOffset,
+                                              subMeshes[group].indexCount);
+        const std::vector<Triangle> expected = CollectTriangles(range);
+        std::vector<Triangle> triangles;
+        for (uint32_t m = meshletData.groupOffsets[group]; m < meshletData.groupOffsets[group + 1]; ++m) {
+            const std::vector<Triangle> meshletTriangles = CollectMeshletTriangles(meshletData, meshletData.meshlets[m]);
+            triangles.insert(triangles.end(), meshletTriangles.begin(), meshletTriangles.end());
+        }
+        std::sort(triangles.begin(), triangles.end());
+        CHECK(triangles == expected);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <Resources/Assets/Models path>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path modelDirectory = argv[1];
+
+    // フラットシェーディングの地形と、スムーズシェーディングの球
+    CheckModel(modelDirectory / "terrain" / "terrain.obj");
+    CheckModel(modelDirectory / "sphere" / "sphere.obj");
+    TestSubMeshes(modelDirectory / "terrain" / "terrain.obj");
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("MeshletBuilderTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,168 @@
+// ============================================================
+// NodeTransformTest — 平坦化したノード階層 (NodeTransform) のテスト
+//   ・3階層 (根・子・孫) で枝分かれのある階層のワールド行列が、木構造を再帰でたどる計算と一致する
+//     (根のローカル行列とオブジェクトの行列はどちらも単位行列ではない)
+//   ・親の無いノードが複数あってもそれぞれ baseMatrix から計算する
+//   ・SSE の行列の積が MathUtils::Multiply と一致する
+//   ・AddNode は同じ名前を共有し、FindNode は最初のノードを返す
+// ============================================================
+#include "NodeTransform.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace MathGenerators;
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+// 平坦化する前の木構造のノード (比較用)
+struct TreeNode {
+    std::string name;
+    Matrix4x4 localMatrix;
+    std::vector<TreeNode> children;
+};
+
+// 木を再帰でたどってワールド行列を求める (行ベクトル規約: world = local * parentWorld)
+void ComputeReference(const TreeNode& node, const Matrix4x4& parentMatrix, std::vector<Matrix4x4>& worldMatrices) {
+    const Matrix4x4 worldMatrix = MathUtils::Multiply(node.localMatrix, parentMatrix);
+    worldMatrices.push_back(worldMatrix);
+    for (const TreeNode& child : node.children) {
+        ComputeReference(child, worldMatrix, worldMatrices);
+    }
+}
+
+// 親が子より前に並ぶ順 (深さ優先) で平坦化する
+void Flatten(const TreeNode& node, int32_t parent, NodeHierarchy& nodes) {
+    const int32_t index = static_cast<int32_t>(NodeTransform::AddNode(nodes, node.name, node.localMatrix, parent));
+    for (const TreeNode& child : node.children) {
+        Flatten(child, index, nodes);
+    }
+}
+
+bool NearlyEqual(const Matrix4x4& a, const Matrix4x4& b) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            if (std::abs(a.m[i][j] - b.m[i][j]) > 1e-4f * (1.0f + std::abs(b.m[i][j]))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// 拡縮・回転 (オイラー角)・平行移動の行列
+Matrix4x4 MakeTransform(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+    return MakeAffineMatrix(scale, rotate, translate);
+}
+
+TreeNode MakeNode(const std::string& name, const Vector3& scale, const Vector3& rotate, const Vector3& translate,
+                  std::vector<TreeNode> children = {}) {
+    return {name, MakeTransform(scale, rotate, translate), std::move(children)};
+}
+
+void TestHierarchy() {
+    // 根 ─┬ 腕 ─┬ 手
+    //     │      └ 指
+    //     └ 脚 ── 足
+    // 親の無いもう1つの根 (小物)
+    const std::vector<TreeNode> roots = {
+        MakeNode("Root", {2.0f, 2.0f, 2.0f}, {0.3f, 1.1f, -0.4f}, {5.0f, -1.0f, 3.0f},
+                 {MakeNode("Arm", {1.0f, 0.5f, 1.0f}, {0.0f, 0.0f, 0.8f}, {1.5f, 0.0f, 0.0f},
+                           {MakeNode("Hand", {1.0f, 1.0f, 1.0f}, {0.7f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f}),
+                            MakeNode("Finger", {0.5f, 0.5f, 0.5f}, {0.0f, -0.6f, 0.2f}, {0.0f, 0.0f, 1.0f})}),
+                  MakeNode("Leg", {1.0f, 1.0f, 1.0f}, {-0.5f, 0.2f, 0.0f}, {0.0f, -2.0f, 0.0f},
+                           {MakeNode("Foot", {1.2f, 1.0f, 0.8f}, {0.0f, 0.9f, 0.0f}, {0.0f, -1.0f, 0.5f})})}),
+        MakeNode("Prop", {1.0f, 1.0f, 1.0f}, {0.0f, 0.5f, 0.0f}, {-3.0f, 0.0f, 0.0f}),
+    };
+    const Matrix4x4 baseMatrix = MakeTransform({0.5f, 0.5f, 0.5f}, {0.0f, 3.0f, 0.0f}, {10.0f, 0.0f, -4.0f});
+
+    NodeHierarchy nodes;
+    std::vector<Matrix4x4> expected;
+    for (const TreeNode& root : roots) {
+        Flatten(root, -1, nodes);
+        ComputeReference(root, baseMatrix, expected);
+    }
+    CHECK(nodes.GetNodeCount() == 7);
+    CHECK(nodes.parents == std::vector<int32_t>({-1, 0, 1, 1, 0, 4, -1}));
+
+    std::vector<Matrix4x4> worldMatrices(nodes.GetNodeCount());
+    NodeTransform::ComputeWorldMatrices(nodes, baseMatrix, worldMatrices);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (!NearlyEqual(worldMatrices[i], expected[i])) {
+            std::printf("node %zu (%s) differs from the recursive reference\n", i,
+                        nodes.names[nodes.nameIds[i]].c_str());
+        }
+        CHECK(NearlyEqual(worldMatrices[i], expected[i]));
+    }
+
+    // 孫 (手) のワールド行列は 手 * 腕 * 根 * base
+    const Matrix4x4 hand = MathUtils::Multiply(
+        MathUtils::Multiply(MathUtils::Multiply(roots[0].children[0].children[0].localMatrix, roots[0].children[0].localMatrix),
+                            roots[0].localMatrix),
+        baseMatrix);
+    CHECK(NearlyEqual(worldMatrices[2], hand));
+
+    // アニメーションで書き換えたローカル行列を渡す版
+    std::vector<Matrix4x4> localMatrices = nodes.localMatrices;
+    localMatrices[1] = MakeTransform({1.0f, 1.0f, 1.0f}, {0.0f, 0.0f, -0.3f}, {1.5f, 0.2f, 0.0f});
+    NodeTransform::ComputeWorldMatrices(nodes.parents, localMatrices, baseMatrix, worldMatrices);
+    TreeNode animatedRoot = roots[0];
+    animatedRoot.children[0].localMatrix = localMatrices[1];
+    expected.clear();
+    ComputeReference(animatedRoot, baseMatrix, expected);
+    for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK(NearlyEqual(worldMatrices[i], expected[i]));
+    }
+}
+
+void TestMultiply() {
+    const Matrix4x4 a = MakeTransform({1.5f, 0.7f, 2.0f}, {0.4f, -1.2f, 2.5f}, {3.0f, -7.0f, 0.25f});
+    Matrix4x4 b = MakeTransform({0.3f, 1.0f, 4.0f}, {-0.9f, 0.1f, 0.6f}, {-2.0f, 8.0f, 1.0f});
+    // 最後の列も 0,0,0,1 以外にする (射影行列との積でも正しいこと)
+    b.m[0][3] = 0.5f;
+    b.m[2][3] = -1.0f;
+    CHECK(NearlyEqual(NodeTransform::Multiply(a, b), MathUtils::Multiply(a, b)));
+    CHECK(NearlyEqual(NodeTransform::Multiply(b, a), MathUtils::Multiply(b, a)));
+}
+
+void TestNames() {
+    NodeHierarchy nodes;
+    const Matrix4x4 identity = MakeIdentity4x4();
+    CHECK(NodeTransform::AddNode(nodes, "Root", identity, -1) == 0);
+    CHECK(NodeTransform::AddNode(nodes, "Mesh", identity, 0) == 1);
+    CHECK(NodeTransform::AddNode(nodes, "Mesh", identity, 1) == 2);
+    CHECK(nodes.names.size() == 2);
+    CHECK(nodes.nameIds[1] == nodes.nameIds[2]);
+    CHECK(NodeTransform::FindNode(nodes, "Root") == 0);
+    CHECK(NodeTransform::FindNode(nodes, "Mesh") == 1);
+    CHECK(NodeTransform::FindNode(nodes, "Missing") == -1);
+}
+
+} // namespace
+
+int main() {
+    TestHierarchy();
+    TestMultiply();
+    TestNames();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("NodeTransformTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,222 @@
+// ============================================================
+// ObjLoaderTest — OBJ 専用リーダー (ObjLoader) のテスト
+//   ・Resources 内の全 OBJ について、assimp 経由 (Model::LoadModelFile) と同じ三角形になる
+//     (assimp は Windows のビルドにしか無いので、ObjLoader.h に書いた assimp の後処理
+//      [X反転・V反転・巻き順反転・扇形の三角形化] を1行ずつ素直に行う参照実装と比べる)
+//   ・三角形ごとのテクスチャ (usemtl → map_Kd) が一致する
+//   ・ワーカースレッド上の1スレッドの解析と、チャンクに分けた並列の解析の結果が一致する
+// 使い方: ObjLoaderTest <Resources/Assets/Models のパス>
+// ============================================================
+#include "ObjLoader.h"
+#include "Thread/ThreadUtility.h"
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+// 三角形 (3頂点 × 位置/UV/法線) とテクスチャ
+// 頂点の巻き順は保ったまま、最小の頂点が先頭に来るよう回して比べる
+using TriangleKey = std::pair<std::string, std::array<float, 27>>;
+
+TriangleKey MakeTriangleKey(const std::string& texture, const std::array<VertexData, 3>& corners) {
+    std::array<std::array<float, 9>, 3> values;
+    for (int i = 0; i < 3; ++i) {
+        const VertexData& v = corners[i];
+        values[i] = {v.position.x, v.position.y, v.position.z, v.texcoord.x, v.texcoord.y,
+                     v.normal.x,   v.normal.y,   v.normal.z,   0.0f};
+    }
+    int first = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (values[i] < values[first]) {
+            first = i;
+        }
+    }
+    TriangleKey key;
+    key.first = texture;
+    for (int i = 0; i < 3; ++i) {
+        std::memcpy(&key.second[i * 9], values[(first + i) % 3].data(), sizeof(float) * 9);
+    }
+    return key;
+}
+
+std::multiset<TriangleKey> CollectTriangles(const ModelData& modelData) {
+    std::multiset<TriangleKey> triangles;
+    for (const SubMesh& subMesh : modelData.subMeshes) {
+        const std::string& texture = modelData.materials[subMesh.materialIndex].textureFilePath;
+        for (uint32_t i = 0; i < subMesh.indexCount; i += 3) {
+            const uint32_t* index = &modelData.indices[subMesh.indexOffset + i];
+            triangles.insert(MakeTriangleKey(
+                texture, {modelData.vertices[index[0]], modelData.vertices[index[1]], modelData.vertices[index[2]]}));
+        }
+    }
+    return triangles;
+}
+
+// assimp の後処理を1行ずつ行う参照実装 (対応していない面があれば false)
+bool LoadReference(const std::filesystem::path& objPath, std::multiset<TriangleKey>& triangles) {
+    const std::string directory = objPath.parent_path().generic_string();
+    std::vector<Vector3> positions;
+    std::vector<Vector2> texcoords;
+    std::vector<Vector3> normals;
+    std::map<std::string, std::string> textures; // マテリアル名 -> テクスチャ
+    std::string texture;
+
+    std::ifstream file(objPath);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string keyword;
+        stream >> keyword;
+        if (keyword == "v") {
+            Vector3& p = positions.emplace_back();
+            stream >> p.x >> p.y >> p.z;
+        } else if (keyword == "vt") {
+            Vector2& t = texcoords.emplace_back();
+            stream >> t.x >> t.y;
+        } else if (keyword == "vn") {
+            Vector3& n = normals.emplace_back();
+            stream >> n.x >> n.y >> n.z;
+        } else if (keyword == "mtllib") {
+            std::string name;
+            stream >> name;
+            std::ifstream mtl(directory + "/" + name);
+            std::string mtlLine;
+            std::string material;
+            while (std::getline(mtl, mtlLine)) {
+                std::istringstream mtlStream(mtlLine);
+                std::string mtlKeyword;
+                mtlStream >> mtlKeyword;
+                if (mtlKeyword == "newmtl") {
+                    mtlStream >> material;
+                    textures[material];
+                } else if (mtlKeyword == "map_Kd") {
+                    std::string textureName;
+                    while (mtlStream >> textureName) {
+                    }
+                    textures[material] = directory + "/" + textureName;
+                }
+            }
+        } else if (keyword == "usemtl") {
+            std::string material;
+            stream >> material;
+            texture = textures[material];
+        } else if (keyword == "f") {
+            std::vector<VertexData> polygon;
+            std::string token;
+            while (stream >> token) {
+                int p = 0;
+                int t = 0;
+                int n = 0;
+                if (std::sscanf(token.c_str(), "%d/%d/%d", &p, &t, &n) != 3) {
+                    return false;
+                }
+                p = p > 0 ? p - 1 : static_cast<int>(positions.size()) + p;
+                t = t > 0 ? t - 1 : static_cast<int>(texcoords.size()) + t;
+                n = n > 0 ? n - 1 : static_cast<int>(normals.size()) + n;
+                VertexData vertex;
+                vertex.position = {-positions[p].x, positions[p].y, positions[p].z, 1.0f};
+                vertex.texcoord = {texcoords[t].x, 1.0f - texcoords[t].y};
+                vertex.normal = {-normals[n].x, normals[n].y, normals[n].z};
+                polygon.push_back(vertex);
+            }
+            for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+                triangles.insert(MakeTriangleKey(texture, {polygon[i + 1], polygon[i], polygon[0]}));
+            }
+        }
+    }
+    return true;
+}
+
+void TestMatchesReference(const std::filesystem::path& objPath) {
+    std::multiset<TriangleKey> expected;
+    const bool isSupported = LoadReference(objPath, expected);
+
+    ModelData modelData;
+    const bool isLoaded = ObjLoader::Load(objPath.parent_path().generic_string(), objPath.filename().string(), modelData);
+    CHECK(isLoaded == isSupported);
+    if (!isLoaded) {
+        return;
+    }
+
+    const std::multiset<TriangleKey> actual = CollectTriangles(modelData);
+    CHECK(modelData.indices.size() == expected.size() * 3);
+    CHECK(actual == expected);
+    // 頂点は重複なくまとめられている (サブメッシュ内)
+    CHECK(modelData.vertices.size() <= modelData.indices.size());
+    if (actual != expected) {
+        std::printf("  mismatch in %s\n", objPath.generic_string().c_str());
+    }
+}
+
+void TestWorkerMatchesParallel(const std::filesystem::path& objPath) {
+    const std::string directory = objPath.parent_path().generic_string();
+    const std::string fileName = objPath.filename().string();
+
+    ModelData parallel;
+    CHECK(ObjLoader::Load(directory, fileName, parallel));
+
+    // ワーカー上では1スレッドで解析する。結果は頂点の並びまで同じになる
+    ModelData single;
+    bool isLoaded = false;
+    std::thread worker([&] {
+        ThreadUtility::MarkWorkerThread();
+        isLoaded = ObjLoader::Load(directory, fileName, single);
+    });
+    worker.join();
+    CHECK(isLoaded);
+    CHECK(single.indices == parallel.indices);
+    CHECK(single.vertices.size() == parallel.vertices.size());
+    CHECK(single.vertices.size() == 0 ||
+          std::memcmp(single.vertices.data(), parallel.vertices.data(), sizeof(VertexData) * single.vertices.size()) == 0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <models directory>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path modelsDirectory = argv[1];
+
+    uint32_t fileCount = 0;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(modelsDirectory)) {
+        if (entry.path().extension() == ".obj") {
+            TestMatchesReference(entry.path());
+            ++fileCount;
+        }
+    }
+    CHECK(fileCount > 0);
+
+    // 並列に分割される大きさのファイル (16KB 以上)
+    TestWorkerMatchesParallel(modelsDirectory / "terrain/terrain.obj");
+    TestWorkerMatchesParallel(modelsDirectory / "Teapot/teapot.obj");
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("ObjLoaderTest: all checks passed (%u files)\n", fileCount);
+    return 0;
+}
@@ -0,0 +1,163 @@
+// ============================================================
+// ParticleCurveTest — 寿命に応じて変化する値 (ParticleCurve / ParticleGradient) の LUT のテスト
+//   ・LUT の区間の境目ではキーの折れ線と一致する
+//   ・LUT の誤差は (最大の傾き × 区間の幅 / 2) 以内 (キーが区間の途中にある場合)
+//   ・キーが区間の境目だけにあれば誤差はない
+//   ・キーが順不同・範囲外でも、並べ替えて 0～1 に収めた折れ線になる
+//   ・t が 0～1 の外なら端の値、キーがなければ 1 (白)
+// ============================================================
+#include "ParticleCurve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+const float kStep = 1.0f / static_cast<float>(kParticleCurveLutSize);
+const float kEpsilon = 1e-5f;
+
+// キーの折れ線をそのまま評価する (並べ替えと 0～1 への収め込みは ParticleCurve::Bake と同じ)
+float EvaluateReference(std::vector<CurveKey> keys, float t) {
+    for (CurveKey& key : keys) {
+        key.time = std::clamp(key.time, 0.0f, 1.0f);
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](const CurveKey& a, const CurveKey& b) { return a.time < b.time; });
+    t = std::clamp(t, 0.0f, 1.0f);
+    if (t <= keys.front().time) {
+        return keys.front().value;
+    }
+    for (size_t i = 1; i < keys.size(); ++i) {
+        if (t <= keys[i].time) {
+            const float span = keys[i].time - keys[i - 1].time;
+            const float s = span > 0.0f ? (t - keys[i - 1].time) / span : 1.0f;
+            return keys[i - 1].value + (keys[i].value - keys[i - 1].value) * s;
+        }
+    }
+    return keys.back().value;
+}
+
+// 折れ線の最大の傾き
+float ComputeMaxSlope(std::vector<CurveKey> keys) {
+    std::sort(keys.begin(), keys.end(), [](const CurveKey& a, const CurveKey& b) { return a.time < b.time; });
+    float maxSlope = 0.0f;
+    for (size_t i = 1; i < keys.size(); ++i) {
+        const float span = keys[i].time - keys[i - 1].time;
+        if (span > 0.0f) {
+            maxSlope = std::max(maxSlope, std::abs(keys[i].value - keys[i - 1].value) / span);
+        }
+    }
+    return maxSlope;
+}
+
+// 細かく引いたときの LUT と折れ線の最大誤差
+float ComputeMaxError(const ParticleCurve& curve) {
+    float maxError = 0.0f;
+    for (int i = 0; i <= 4096; ++i) {
+        const float t = static_cast<float>(i) / 4096.0f;
+        maxError = std::max(maxError, std::abs(curve.Sample(t) - EvaluateReference(curve.keys, t)));
+    }
+    return maxError;
+}
+
+void TestRandomCurves() {
+    std::mt19937 randomEngine(7u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (int trial = 0; trial < 200; ++trial) {
+        std::vector<CurveKey> keys = {{0.0f, unit(randomEngine)}, {1.0f, unit(randomEngine)}};
+        const int innerKeyCount = 1 + trial % 8;
+        for (int k = 0; k < innerKeyCount; ++k) {
+            keys.push_back({unit(randomEngine), unit(randomEngine) * 4.0f - 2.0f});
+        }
+        const ParticleCurve curve(keys);
+
+        // 区間の境目では一致する
+        for (uint32_t i = 0; i <= kParticleCurveLutSize; ++i) {
+            const float t = static_cast<float>(i) * kStep;
+            CHECK(std::abs(curve.Sample(t) - EvaluateReference(keys, t)) < kEpsilon);
+        }
+        // 区間の途中の誤差は傾きと区間の幅で抑えられる
+        const float bound = ComputeMaxSlope(keys) * kStep * 0.5f + kEpsilon;
+        const float maxError = ComputeMaxError(curve);
+        if (maxError > bound) {
+            std::printf("FAIL trial %d: LUT error %.6f > bound %.6f\n", trial, maxError, bound);
+            ++failCount;
+        }
+    }
+}
+
+void TestExactCurves() {
+    // キーが区間の境目だけなら誤差はない
+    const ParticleCurve aligned({{0.0f, 0.5f}, {8.0f * kStep, 1.5f}, {1.0f, 0.0f}});
+    CHECK(ComputeMaxError(aligned) < kEpsilon);
+
+    // 順不同・範囲外のキー
+    const ParticleCurve unsorted({{1.5f, 0.0f}, {-1.0f, 2.0f}, {0.5f, 1.0f}});
+    CHECK(std::abs(unsorted.Sample(0.0f) - 2.0f) < kEpsilon);
+    CHECK(std::abs(unsorted.Sample(0.25f) - 1.5f) < kEpsilon);
+    CHECK(std::abs(unsorted.Sample(1.0f) - 0.0f) < kEpsilon);
+
+    // 範囲外の t は端の値
+    CHECK(std::abs(unsorted.Sample(-3.0f) - 2.0f) < kEpsilon);
+    CHECK(std::abs(unsorted.Sample(7.0f) - 0.0f) < kEpsilon);
+
+    // キーがない・既定の曲線は 1
+    ParticleCurve empty;
+    empty.keys.clear();
+    empty.Bake();
+    CHECK(std::abs(empty.Sample(0.3f) - 1.0f) < kEpsilon);
+    CHECK(std::abs(ParticleCurve().Sample(0.7f) - 1.0f) < kEpsilon);
+}
+
+void TestGradient() {
+    // 既定は白から透明へ (アルファは 1 - t)
+    const ParticleGradient fade;
+    for (float t : {0.0f, 0.1f, 0.5f, 0.77f, 1.0f}) {
+        const Vector4 color = fade.Sample(t);
+        CHECK(std::abs(color.x - 1.0f) < kEpsilon && std::abs(color.y - 1.0f) < kEpsilon);
+        CHECK(std::abs(color.w - (1.0f - t)) < kEpsilon);
+    }
+
+    // 区間の途中のキーは各チャンネルとも傾き × 区間の幅 / 2 以内
+    const ParticleGradient gradient({{0.0f, {1.0f, 0.0f, 0.0f, 1.0f}}, {0.51f, {0.0f, 1.0f, 0.0f, 0.5f}}, {1.0f, {0.0f, 0.0f, 1.0f, 0.0f}}});
+    const float bound = (1.0f / 0.49f) * kStep * 0.5f + kEpsilon;
+    float maxError = 0.0f;
+    for (int i = 0; i <= 4096; ++i) {
+        const float t = static_cast<float>(i) / 4096.0f;
+        const Vector4 color = gradient.Sample(t);
+        const float s0 = std::min(t / 0.51f, 1.0f);
+        const float s1 = std::max((t - 0.51f) / 0.49f, 0.0f);
+        const Vector4 expected = {1.0f - s0, s0 - s1, s1, 1.0f - 0.5f * s0 - 0.5f * s1};
+        maxError = std::max({maxError, std::abs(color.x - expected.x), std::abs(color.y - expected.y),
+                             std::abs(color.z - expected.z), std::abs(color.w - expected.w)});
+    }
+    CHECK(maxError > 0.0f);
+    CHECK(maxError <= bound);
+}
+
+} // namespace
+
+int main() {
+    TestRandomCurves();
+    TestExactCurves();
+    TestGradient();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("ParticleCurveTest: all checks passed\n");
+    return 0;
+}
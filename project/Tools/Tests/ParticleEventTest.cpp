@@ -0,0 +1,196 @@
+// ============================================================
+// ParticleEventTest — サブエミッターのイベントの数と並び順のテスト
+//   ・容量内/容量オーバーのイベント数と破棄数
+//   ・複数スレッドから積んでも、Sort 後の並びが1スレッドで積んだ場合と一致する
+//   ・同じフレームに発生と消滅が混ざっても、グループ内の通し番号が重ならない
+// ============================================================
+#include "ParticleEmitter.h"
+#include "ParticleEventBuffer.h"
+#include "ParticleSimulation.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+auto MakeKey(const ParticleEvent& event) {
+    return std::make_tuple(event.sourceGroupId, event.trigger, event.sequence, event.subEmitterIndex);
+}
+
+// 発生時に1つ、消滅時に2つのサブエミッターを持つエミッター
+ParticleEmitter MakeEmitter() {
+    ParticleEmitter emitter;
+    emitter.subEmitters.push_back({"Spark", SubEmitterTrigger::Birth, 1});
+    emitter.subEmitters.push_back({"Smoke", SubEmitterTrigger::Death, 2});
+    emitter.subEmitters.push_back({"Flash", SubEmitterTrigger::Death, 1});
+    return emitter;
+}
+
+void TestCount() {
+    ParticleEventBuffer events;
+    ParticleEvent event{};
+    for (uint32_t i = 0; i < 10; ++i) {
+        event.sequence = i;
+        CHECK(events.Push(event));
+    }
+    CHECK(events.GetEvents().size() == 10);
+    CHECK(events.GetDroppedCount() == 0);
+
+    // 容量を超えた分は破棄され、数だけ数えられる
+    for (uint32_t i = 10; i < ParticleEventBuffer::kCapacity + 5; ++i) {
+        event.sequence = i;
+        events.Push(event);
+    }
+    CHECK(events.GetEvents().size() == ParticleEventBuffer::kCapacity);
+    CHECK(events.GetDroppedCount() == 5);
+
+    events.Clear();
+    CHECK(events.GetEvents().empty());
+    CHECK(events.GetDroppedCount() == 0);
+}
+
+void TestSubEmitterCount() {
+    const ParticleEmitter emitter = MakeEmitter();
+    ParticleEventBuffer events;
+    uint32_t sequence = 0;
+
+    // 発生1回 = 1イベント、消滅1回 = 2イベント (該当するサブエミッターの数)
+    for (uint32_t i = 0; i < 4; ++i) {
+        ParticleSimulation::PushSubEmitterEvents(emitter, 0, SubEmitterTrigger::Birth, {}, sequence, events);
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        ParticleSimulation::PushSubEmitterEvents(emitter, 0, SubEmitterTrigger::Death, {}, sequence, events);
+    }
+    CHECK(events.GetEvents().size() == 4 + 3 * 2);
+
+    // サブエミッターのないエミッターは何も積まない
+    const ParticleEmitter plain;
+    ParticleSimulation::PushSubEmitterEvents(plain, 1, SubEmitterTrigger::Death, {}, sequence, events);
+    CHECK(events.GetEvents().size() == 4 + 3 * 2);
+}
+
+void TestSequenceUnique() {
+    // 1フレーム内で発生 → 消滅 → 発生と積んでも、(グループ, 通し番号) が重ならない
+    // (以前はリストの長さを番号にしていたので、消滅の後の発生で番号が重なっていた)
+    const ParticleEmitter emitter = MakeEmitter();
+    ParticleEventBuffer events;
+    uint32_t sequence = 0;
+    std::vector<ParticleEvent> pushed;
+
+    auto push = [&](SubEmitterTrigger trigger, float x) {
+        const uint32_t before = static_cast<uint32_t>(events.GetEvents().size());
+        ParticleSimulation::PushSubEmitterEvents(emitter, 0, trigger, {x, 0.0f, 0.0f}, sequence, events);
+        for (uint32_t i = before; i < events.GetEvents().size(); ++i) {
+            pushed.push_back(events.GetEvents()[i]);
+        }
+    };
+    for (int i = 0; i < 3; ++i) push(SubEmitterTrigger::Birth, static_cast<float>(i));
+    for (int i = 0; i < 2; ++i) push(SubEmitterTrigger::Death, static_cast<float>(10 + i));
+    for (int i = 0; i < 3; ++i) push(SubEmitterTrigger::Birth, static_cast<float>(20 + i));
+
+    std::set<std::tuple<uint32_t, SubEmitterTrigger, uint32_t, uint32_t>> keys;
+    for (const ParticleEvent& event : pushed) {
+        keys.insert(MakeKey(event));
+    }
+    CHECK(keys.size() == pushed.size());
+
+    // 並び替えた後も、同じタイミングのイベントは積んだ順に並ぶ
+    events.Sort();
+    std::vector<float> birthOrder;
+    for (const ParticleEvent& event : events.GetEvents()) {
+        if (event.trigger == SubEmitterTrigger::Birth) {
+            birthOrder.push_back(event.position.x);
+        }
+    }
+    CHECK((birthOrder == std::vector<float>{0.0f, 1.0f, 2.0f, 20.0f, 21.0f, 22.0f}));
+}
+
+// 3グループ × 発生/消滅のイベントを作る (グループごとの通し番号は1スレッドで振る)
+std::vector<ParticleEvent> MakeFrameEvents() {
+    const ParticleEmitter emitter = MakeEmitter();
+    ParticleEventBuffer events;
+    for (uint32_t groupId = 0; groupId < 3; ++groupId) {
+        uint32_t sequence = 0;
+        for (uint32_t i = 0; i < 40; ++i) {
+            const SubEmitterTrigger trigger = (i % 3 == 0) ? SubEmitterTrigger::Death : SubEmitterTrigger::Birth;
+            const Vector3 position = {static_cast<float>(groupId), static_cast<float>(i), 0.0f};
+            ParticleSimulation::PushSubEmitterEvents(emitter, groupId, trigger, position, sequence, events);
+        }
+    }
+    return {events.GetEvents().begin(), events.GetEvents().end()};
+}
+
+void TestOrderDeterministic() {
+    const std::vector<ParticleEvent> source = MakeFrameEvents();
+
+    // 1スレッドで積んだ場合の並び
+    ParticleEventBuffer reference;
+    for (const ParticleEvent& event : source) {
+        reference.Push(event);
+    }
+    reference.Sort();
+    const std::span<const ParticleEvent> expected = reference.GetEvents();
+
+    // 順番をばらばらにして複数スレッドから積んでも、並び替えると同じになる
+    std::mt19937 randomEngine(7u);
+    const uint32_t kThreadCount = 4;
+    for (uint32_t trial = 0; trial < 20; ++trial) {
+        std::vector<ParticleEvent> shuffled = source;
+        std::shuffle(shuffled.begin(), shuffled.end(), randomEngine);
+
+        ParticleEventBuffer events;
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < kThreadCount; ++t) {
+            threads.emplace_back([&, t] {
+                for (size_t i = t; i < shuffled.size(); i += kThreadCount) {
+                    events.Push(shuffled[i]);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        CHECK(events.GetEvents().size() == source.size());
+        CHECK(events.GetDroppedCount() == 0);
+        events.Sort();
+        const std::span<const ParticleEvent> actual = events.GetEvents();
+        bool isSame = actual.size() == expected.size();
+        for (size_t i = 0; isSame && i < actual.size(); ++i) {
+            isSame = MakeKey(actual[i]) == MakeKey(expected[i]) && actual[i].position.x == expected[i].position.x &&
+                     actual[i].position.y == expected[i].position.y;
+        }
+        CHECK(isSame);
+    }
+}
+
+} // namespace
+
+int main() {
+    TestCount();
+    TestSubEmitterCount();
+    TestSequenceUnique();
+    TestOrderDeterministic();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("ParticleEventTest: all checks passed\n");
+    return 0;
+}
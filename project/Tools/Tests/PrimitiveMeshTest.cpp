@@ -0,0 +1,283 @@
+// ============================================================
+// PrimitiveMeshTest — プリミティブの生成 (PrimitiveMesh) のテスト
+//   ・リング・シリンダー・平面を、以前の生成 (PrimitiveMeshReference。頂点ごとに sin/cos) と比べる
+//     頂点数・インデックス数とインデックスは一致し、位置・法線・UV の差は float の丸め誤差程度
+//   ・分割数のガード (0 や 256 を超える値)、部分的な円弧、楕円、UV の入れ替え・反転を含む固定の設定と、ランダムな設定
+//   ・Get*Size は Build* の大きさと一致し、Write* で書き込み先へ直接書いても Build* と同じ
+//   ・ハッシュは形状の設定だけで決まる (色が違っても同じ、分割数が違えば別)
+// ============================================================
+#include "PrimitiveMesh.h"
+#include "PrimitiveMeshReference.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+// 位置の誤差は形状の大きさに対する比で測る
+const float kMaxPositionError = 4e-6f;
+const float kMaxNormalError = 2e-6f;
+const float kMaxTexcoordError = 1e-6f;
+
+struct MeshError {
+    float position = 0.0f;
+    float normal = 0.0f;
+    float texcoord = 0.0f;
+};
+
+struct Mesh {
+    std::vector<VertexData> vertices;
+    std::vector<uint32_t> indices;
+};
+
+// 以前の生成と比べる (大きさとインデックスは一致すること)
+bool Compare(const Mesh& actual, const Mesh& expected, float scale, MeshError& error) {
+    if (actual.vertices.size() != expected.vertices.size() || actual.indices != expected.indices) {
+        return false;
+    }
+    const float inverseScale = 1.0f / std::max(1.0f, scale);
+    for (size_t v = 0; v < actual.vertices.size(); ++v) {
+        const VertexData& a = actual.vertices[v];
+        const VertexData& b = expected.vertices[v];
+        error.position = std::max({error.position, std::abs(a.position.x - b.position.x) * inverseScale,
+                                   std::abs(a.position.y - b.position.y) * inverseScale,
+                                   std::abs(a.position.z - b.position.z) * inverseScale,
+                                   std::abs(a.position.w - b.position.w)});
+        error.normal = std::max({error.normal, std::abs(a.normal.x - b.normal.x), std::abs(a.normal.y - b.normal.y),
+                                 std::abs(a.normal.z - b.normal.z)});
+        error.texcoord = std::max({error.texcoord, std::abs(a.texcoord.x - b.texcoord.x),
+                                   std::abs(a.texcoord.y - b.texcoord.y)});
+    }
+    return true;
+}
+
+// Write* で書き込んだものが Build* と同じバイトか
+bool IsSameBytes(const Mesh& written, const Mesh& built) {
+    return written.vertices.size() == built.vertices.size() && written.indices == built.indices &&
+           std::memcmp(written.vertices.data(), built.vertices.data(), sizeof(VertexData) * built.vertices.size()) == 0;
+}
+
+void CheckError(const char* name, const MeshError& error, size_t meshCount) {
+    std::printf("%-8s %4zu meshes: max error position %.2e, normal %.2e, uv %.2e\n", name, meshCount, error.position,
+                error.normal, error.texcoord);
+    CHECK(error.position <= kMaxPositionError);
+    CHECK(error.normal <= kMaxNormalError);
+    CHECK(error.texcoord <= kMaxTexcoordError);
+}
+
+std::vector<RingSettings> MakeRingCases(std::mt19937& randomEngine) {
+    std::vector<RingSettings> cases(6);
+    cases[1].division = 0;    // 3 にガード
+    cases[2].division = 1000; // 256 にガード
+    cases[3].innerRadius = -1.0f;
+    cases[3].startAngle = -90.0f;
+    cases[3].endAngle = 200.0f;
+    cases[4].startOuterRadius = 0.2f;
+    cases[4].midOuterRadius = 2.5f;
+    cases[4].endOuterRadius = 1.0f;
+    cases[4].isUvSwap = true;
+    cases[5].division = 256;
+
+    std::uniform_real_distribution<float> radius(0.0f, 5.0f);
+    std::uniform_real_distribution<float> angle(-360.0f, 360.0f);
+    std::uniform_int_distribution<uint32_t> division(0, 300);
+    for (int i = 0; i < 500; ++i) {
+        RingSettings& settings = cases.emplace_back();
+        settings.innerRadius = radius(randomEngine) - 1.0f;
+        settings.startOuterRadius = radius(randomEngine);
+        settings.midOuterRadius = radius(randomEngine);
+        settings.endOuterRadius = radius(randomEngine);
+        settings.startAngle = angle(randomEngine);
+        settings.endAngle = angle(randomEngine);
+        settings.division = division(randomEngine);
+        settings.isUvSwap = (i & 1) != 0;
+    }
+    return cases;
+}
+
+std::vector<CylinderSettings> MakeCylinderCases(std::mt19937& randomEngine) {
+    std::vector<CylinderSettings> cases(5);
+    cases[1].division = 2;
+    cases[1].verticalDivision = 0;
+    cases[2].division = 256;
+    cases[2].verticalDivision = 256;
+    cases[3].topRadius = {0.5f, 2.0f};
+    cases[3].bottomRadius = {3.0f, 0.25f};
+    cases[3].startAngle = 30.0f;
+    cases[3].endAngle = 120.0f;
+    cases[4].flipV = true;
+    cases[4].isUvSwap = true;
+    cases[4].verticalDivision = 7;
+
+    std::uniform_real_distribution<float> length(0.0f, 5.0f);
+    std::uniform_real_distribution<float> angle(-360.0f, 360.0f);
+    std::uniform_int_distribution<uint32_t> division(0, 300);
+    std::uniform_int_distribution<uint32_t> verticalDivision(0, 20);
+    for (int i = 0; i < 300; ++i) {
+        CylinderSettings& settings = cases.emplace_back();
+        settings.height = length(randomEngine);
+        settings.topRadius = {length(randomEngine), length(randomEngine)};
+        settings.bottomRadius = {length(randomEngine), length(randomEngine)};
+        settings.startAngle = angle(randomEngine);
+        settings.endAngle = angle(randomEngine);
+        settings.division = division(randomEngine);
+        settings.verticalDivision = verticalDivision(randomEngine);
+        settings.flipV = (i & 1) != 0;
+        settings.isUvSwap = (i & 2) != 0;
+    }
+    return cases;
+}
+
+std::vector<PlaneSettings> MakePlaneCases(std::mt19937& randomEngine) {
+    std::vector<PlaneSettings> cases(4);
+    cases[1].divisionX = 0;
+    cases[1].divisionY = 0;
+    cases[2].size = {16.0f, 4.0f};
+    cases[2].divisionX = 256;
+    cases[2].divisionY = 256;
+    cases[3].flipV = true;
+    cases[3].isUvSwap = true;
+    cases[3].divisionX = 3;
+    cases[3].divisionY = 5;
+
+    std::uniform_real_distribution<float> size(0.1f, 20.0f);
+    std::uniform_int_distribution<uint32_t> division(0, 64);
+    for (int i = 0; i < 300; ++i) {
+        PlaneSettings& settings = cases.emplace_back();
+        settings.size = {size(randomEngine), size(randomEngine)};
+        settings.divisionX = division(randomEngine);
+        settings.divisionY = division(randomEngine);
+        settings.flipV = (i & 1) != 0;
+        settings.isUvSwap = (i & 2) != 0;
+    }
+    return cases;
+}
+
+// 形状ごとに、以前の生成との比較・大きさ・Write* を確かめる
+template <class Settings, class GetSize, class Build, class Write, class BuildReference, class GetScale>
+void TestShape(const char* name, const std::vector<Settings>& cases, GetSize getSize, Build build, Write write,
+               BuildReference buildReference, GetScale getScale) {
+    MeshError error;
+    bool isSameTopology = true;
+    bool isSameSize = true;
+    bool isSameWrite = true;
+    for (const Settings& settings : cases) {
+        Mesh actual;
+        Mesh expected;
+        build(settings, actual.vertices, actual.indices);
+        buildReference(settings, expected.vertices, expected.indices);
+        isSameTopology = isSameTopology && Compare(actual, expected, getScale(settings), error);
+
+        const PrimitiveMeshSize size = getSize(settings);
+        isSameSize = isSameSize && size.vertexCount == actual.vertices.size() && size.indexCount == actual.indices.size();
+
+        Mesh written;
+        written.vertices.resize(size.vertexCount);
+        written.indices.resize(size.indexCount);
+        write(settings, written.vertices, written.indices);
+        isSameWrite = isSameWrite && IsSameBytes(written, actual);
+    }
+    CHECK(isSameTopology);
+    CHECK(isSameSize);
+    CHECK(isSameWrite);
+    CheckError(name, error, cases.size());
+}
+
+void TestKnownValues() {
+    // 既定のリング (32分割): 外側の最初の頂点は (0, 1, 0)、内側は (0, 0.5, 0)、法線は -Z
+    std::vector<VertexData> vertices;
+    std::vector<uint32_t> indices;
+    PrimitiveMesh::BuildRing(RingSettings{}, vertices, indices);
+    CHECK(vertices.size() == 66 && indices.size() == 192);
+    CHECK(std::abs(vertices[0].position.x) < 1e-6f && std::abs(vertices[0].position.y - 1.0f) < 1e-6f);
+    CHECK(std::abs(vertices[1].position.y - 0.5f) < 1e-6f);
+    CHECK(vertices[0].normal.z == -1.0f);
+    // 90度進んだ頂点 (8番目) は (-1, 0, 0)
+    CHECK(std::abs(vertices[16].position.x + 1.0f) < 1e-6f && std::abs(vertices[16].position.y) < 1e-6f);
+
+    // 既定のシリンダー (32分割・縦1分割): 上の段は高さ3、下の段は高さ0、法線は外向き
+    PrimitiveMesh::BuildCylinder(CylinderSettings{}, vertices, indices);
+    CHECK(vertices.size() == 66 && indices.size() == 192);
+    CHECK(vertices[0].position.y == 3.0f && vertices[33].position.y == 0.0f);
+    CHECK(std::abs(vertices[0].normal.z - 1.0f) < 1e-6f);
+
+    // 2x2 分割の平面: 9頂点、左下は (-0.5, -0.5)、UV は (0, 0)
+    PlaneSettings plane;
+    plane.divisionX = 2;
+    plane.divisionY = 2;
+    PrimitiveMesh::BuildPlane(plane, vertices, indices);
+    CHECK(vertices.size() == 9 && indices.size() == 24);
+    CHECK(vertices[0].position.x == -0.5f && vertices[0].position.y == -0.5f);
+    CHECK(vertices[8].texcoord.x == 1.0f && vertices[8].texcoord.y == 1.0f);
+}
+
+void TestHash() {
+    RingSettings ring;
+    RingSettings recolored = ring;
+    recolored.innerColor = {1.0f, 0.0f, 0.0f, 1.0f};
+    recolored.fadeRange = 0.3f;
+    CHECK(PrimitiveMesh::HashRing(ring) == PrimitiveMesh::HashRing(recolored));
+    RingSettings divided = ring;
+    divided.division = 33;
+    CHECK(PrimitiveMesh::HashRing(ring) != PrimitiveMesh::HashRing(divided));
+
+    CylinderSettings cylinder;
+    CylinderSettings faded = cylinder;
+    faded.topColor = {0.0f, 1.0f, 0.0f, 0.5f};
+    CHECK(PrimitiveMesh::HashCylinder(cylinder) == PrimitiveMesh::HashCylinder(faded));
+    CylinderSettings flipped = cylinder;
+    flipped.flipV = true;
+    CHECK(PrimitiveMesh::HashCylinder(cylinder) != PrimitiveMesh::HashCylinder(flipped));
+
+    PlaneSettings plane;
+    PlaneSettings tinted = plane;
+    tinted.color = {0.2f, 0.2f, 0.2f, 1.0f};
+    CHECK(PrimitiveMesh::HashPlane(plane) == PrimitiveMesh::HashPlane(tinted));
+    PlaneSettings wide = plane;
+    wide.size.x = 2.0f;
+    CHECK(PrimitiveMesh::HashPlane(plane) != PrimitiveMesh::HashPlane(wide));
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 randomEngine(21u);
+
+    TestShape("ring", MakeRingCases(randomEngine), PrimitiveMesh::GetRingSize, PrimitiveMesh::BuildRing,
+              PrimitiveMesh::WriteRing, PrimitiveMeshReference::BuildRing, [](const RingSettings& settings) {
+                  return std::max({settings.innerRadius, settings.startOuterRadius, settings.midOuterRadius,
+                                   settings.endOuterRadius});
+              });
+    TestShape("cylinder", MakeCylinderCases(randomEngine), PrimitiveMesh::GetCylinderSize,
+              PrimitiveMesh::BuildCylinder, PrimitiveMesh::WriteCylinder, PrimitiveMeshReference::BuildCylinder,
+              [](const CylinderSettings& settings) {
+                  return std::max({settings.height, settings.topRadius.x, settings.topRadius.y,
+                                   settings.bottomRadius.x, settings.bottomRadius.y});
+              });
+    TestShape("plane", MakePlaneCases(randomEngine), PrimitiveMesh::GetPlaneSize, PrimitiveMesh::BuildPlane,
+              PrimitiveMesh::WritePlane, PrimitiveMeshReference::BuildPlane,
+              [](const PlaneSettings& settings) { return std::max(settings.size.x, settings.size.y); });
+    TestKnownValues();
+    TestHash();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("PrimitiveMeshTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,187 @@
+// ============================================================
+// SkinningTest — CPU スキニング (Skinning) のテスト
+//   ・単位行列のパレットでは頂点の位置・法線・UV が変わらない
+//   ・バインドポーズのままの骨 (ノードの行列 = 逆バインド行列の逆) のパレットは単位行列
+//   ・平行移動した骨の重みに応じて頂点が動く (頂点は読み込み時に X 反転しているので、移動も X が反転する)
+//   ・回転した骨では法線も回り、長さ1のまま
+//   ・AddInfluence は5つ目以降で重みの小さいものを捨て、NormalizeInfluences は合計を1にする
+// ============================================================
+#include "Skinning.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace MathGenerators;
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+bool NearlyEqual(const Vector3& a, const Vector3& b, float tolerance = 1e-5f) {
+    return std::abs(a.x - b.x) <= tolerance && std::abs(a.y - b.y) <= tolerance && std::abs(a.z - b.z) <= tolerance;
+}
+
+bool NearlyEqual(const Matrix4x4& a, const Matrix4x4& b, float tolerance = 1e-5f) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            if (std::abs(a.m[i][j] - b.m[i][j]) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+Vector3 GetPosition(const VertexData& vertex) {
+    return {vertex.position.x, vertex.position.y, vertex.position.z};
+}
+
+std::vector<VertexData> MakeVertices(uint32_t count) {
+    std::mt19937 randomEngine(3u);
+    std::uniform_real_distribution<float> range(-2.0f, 2.0f);
+    std::vector<VertexData> vertices(count);
+    for (VertexData& vertex : vertices) {
+        vertex.position = {range(randomEngine), range(randomEngine), range(randomEngine), 1.0f};
+        vertex.texcoord = {range(randomEngine), range(randomEngine)};
+        const Vector3 normal = {range(randomEngine), range(randomEngine), range(randomEngine) + 3.0f};
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        vertex.normal = {normal.x / length, normal.y / length, normal.z / length};
+    }
+    return vertices;
+}
+
+// 2つのジョイントに重み weight0 : 1 - weight0 で割り当てる
+std::vector<VertexInfluence> MakeInfluences(uint32_t count, float weight0) {
+    std::vector<VertexInfluence> influences(count);
+    for (VertexInfluence& influence : influences) {
+        influence.jointIndices[0] = 0;
+        influence.jointIndices[1] = 1;
+        influence.weights[0] = weight0;
+        influence.weights[1] = 1.0f - weight0;
+    }
+    return influences;
+}
+
+void TestIdentityPalette() {
+    const std::vector<VertexData> vertices = MakeVertices(257);
+    const std::vector<VertexInfluence> influences = MakeInfluences(257, 0.3f);
+    const std::vector<Matrix4x4> palette(2, MakeIdentity4x4());
+
+    std::vector<VertexData> output(vertices.size());
+    Skinning::SkinVertices(vertices, influences, palette, output);
+    bool isUnchanged = true;
+    for (size_t v = 0; v < vertices.size(); ++v) {
+        isUnchanged = isUnchanged && NearlyEqual(GetPosition(output[v]), GetPosition(vertices[v])) &&
+                      output[v].position.w == 1.0f && NearlyEqual(output[v].normal, vertices[v].normal) &&
+                      output[v].texcoord.x == vertices[v].texcoord.x && output[v].texcoord.y == vertices[v].texcoord.y;
+    }
+    CHECK(isUnchanged);
+}
+
+void TestBindPose() {
+    // ノードのモデル空間の行列がバインドポーズのままなら、逆バインド行列と打ち消し合う
+    const Matrix4x4 bindMatrices[2] = {MakeAffineMatrix(Vector3{1.0f, 1.0f, 1.0f}, Vector3{0.2f, 0.4f, -0.1f},
+                                                        Vector3{0.0f, 1.0f, 0.0f}),
+                                       MakeAffineMatrix(Vector3{1.0f, 1.0f, 1.0f}, Vector3{0.0f, -0.7f, 0.3f},
+                                                        Vector3{0.5f, 2.0f, -1.0f})};
+    const std::vector<Joint> joints = {{0, MathUtils::Inverse(bindMatrices[0])}, {1, MathUtils::Inverse(bindMatrices[1])}};
+    std::vector<Matrix4x4> palette(joints.size());
+    Skinning::ComputePalette(joints, bindMatrices, palette);
+    CHECK(NearlyEqual(palette[0], MakeIdentity4x4(), 1e-4f));
+    CHECK(NearlyEqual(palette[1], MakeIdentity4x4(), 1e-4f));
+}
+
+void TestMovedJoint() {
+    // ジョイント1だけ (1, 2, 3) 動かす
+    const std::vector<Joint> joints = {{0, MakeIdentity4x4()}, {1, MakeIdentity4x4()}};
+    const std::vector<Matrix4x4> nodeMatrices = {MakeIdentity4x4(), MakeTranslationMatrix({1.0f, 2.0f, 3.0f})};
+    std::vector<Matrix4x4> palette(joints.size());
+    Skinning::ComputePalette(joints, nodeMatrices, palette);
+
+    const std::vector<VertexData> vertices = MakeVertices(64);
+    std::vector<VertexData> output(vertices.size());
+    for (float weight0 : {1.0f, 0.75f, 0.5f, 0.0f}) {
+        Skinning::SkinVertices(vertices, MakeInfluences(64, weight0), palette, output);
+        const float moved = 1.0f - weight0;
+        bool isMoved = true;
+        for (size_t v = 0; v < vertices.size(); ++v) {
+            const Vector3 expected = {vertices[v].position.x - moved, vertices[v].position.y + moved * 2.0f,
+                                      vertices[v].position.z + moved * 3.0f};
+            isMoved = isMoved && NearlyEqual(GetPosition(output[v]), expected) &&
+                      NearlyEqual(output[v].normal, vertices[v].normal);
+        }
+        CHECK(isMoved);
+    }
+
+    // ジョイント1を Z 軸まわりに90度回すと、全て1に割り当てた頂点の法線も回る
+    // (X 反転で挟むので、反転前の座標系での回転の向きは逆になる)
+    const std::vector<Matrix4x4> rotated = {MakeIdentity4x4(), MakeRotateZMatrix(1.5707963f)};
+    Skinning::ComputePalette(joints, rotated, palette);
+    VertexData vertex = {};
+    vertex.position = {1.0f, 0.0f, 0.0f, 1.0f};
+    vertex.normal = {1.0f, 0.0f, 0.0f};
+    VertexInfluence influence = {};
+    influence.jointIndices[0] = 1;
+    influence.weights[0] = 1.0f;
+    VertexData result;
+    Skinning::SkinVertices({&vertex, 1}, {&influence, 1}, palette, {&result, 1});
+    const Matrix4x4 mirroredRotation = MakeRotateZMatrix(-1.5707963f);
+    const Vector3 expected = {mirroredRotation.m[0][0], mirroredRotation.m[0][1], mirroredRotation.m[0][2]};
+    CHECK(NearlyEqual(GetPosition(result), expected, 1e-5f));
+    CHECK(NearlyEqual(result.normal, expected, 1e-5f));
+}
+
+void TestInfluences() {
+    VertexInfluence influence = {};
+    const float weights[5] = {0.1f, 0.4f, 0.05f, 0.3f, 0.15f};
+    for (uint32_t i = 0; i < 5; ++i) {
+        Skinning::AddInfluence(influence, i, weights[i]);
+    }
+    // 一番小さい 0.05 (ジョイント2) が捨てられる
+    float total = 0.0f;
+    bool hasDropped = false;
+    for (int k = 0; k < 4; ++k) {
+        total += influence.weights[k];
+        hasDropped = hasDropped || influence.jointIndices[k] == 2;
+    }
+    CHECK(!hasDropped);
+    CHECK(std::abs(total - 0.95f) < 1e-5f);
+
+    std::vector<VertexInfluence> influences = {influence, VertexInfluence{}};
+    std::vector<Joint> joints(5);
+    Skinning::NormalizeInfluences(influences, joints);
+    total = influences[0].weights[0] + influences[0].weights[1] + influences[0].weights[2] + influences[0].weights[3];
+    CHECK(std::abs(total - 1.0f) < 1e-5f);
+    // 影響の無い頂点はルートに固定するジョイントを追加して割り当てる
+    CHECK(joints.size() == 6);
+    CHECK(influences[1].jointIndices[0] == 5 && influences[1].weights[0] == 1.0f);
+    CHECK(joints[5].nodeIndex == 0);
+}
+
+} // namespace
+
+int main() {
+    TestIdentityPalette();
+    TestBindPose();
+    TestMovedJoint();
+    TestInfluences();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("SkinningTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,175 @@
+// ============================================================
+// SubMeshTest — 複数マテリアルのモデルの、読み込み後の処理 (並べ替え・LOD) を通したサブメッシュのテスト
+//   ・LOD は indices を先頭から隙間なく覆い、各LODのサブメッシュはそのLODの範囲を隙間なく覆う
+//   ・サブメッシュのマテリアル番号は materials の範囲内で、LOD0 のマテリアルごとの三角形数は元のまま
+//   ・サブメッシュ同士は頂点を共有しない
+//   ・使うモデルは Resources の multiMaterial.obj と、LOD が作られる大きさの3マテリアルの格子 (一時フォルダに書き出す)
+// 使い方: SubMeshTest <Resources/Assets/Models のパス>
+// ============================================================
+#include "MeshImporter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+const uint32_t kGridSize = 48;
+const uint32_t kGridMaterials = 3;
+
+// テクスチャのファイル名 → 三角形数
+using TriangleCounts = std::map<std::string, uint32_t>;
+
+// 起伏のある格子を、x 方向に3つの帯に分けてマテリアルを割り当てた OBJ を書き出す
+// 戻り値はマテリアルごとの三角形数
+TriangleCounts WriteGridObj(const std::filesystem::path& directory) {
+    {
+        std::ofstream mtl(directory / "grid.mtl");
+        for (uint32_t m = 0; m < kGridMaterials; ++m) {
+            mtl << "newmtl band" << m << "\nmap_Kd band" << m << ".png\n";
+        }
+    }
+    std::ofstream obj(directory / "grid.obj");
+    obj << "mtllib grid.mtl\n";
+    for (uint32_t z = 0; z <= kGridSize; ++z) {
+        for (uint32_t x = 0; x <= kGridSize; ++x) {
+            const float u = static_cast<float>(x) / kGridSize;
+            const float v = static_cast<float>(z) / kGridSize;
+            const float height = 0.3f * std::sin(u * 6.0f) * std::cos(v * 5.0f);
+            obj << "v " << u * 10.0f << " " << height << " " << v * 10.0f << "\n";
+            obj << "vt " << u << " " << v << "\n";
+            obj << "vn 0 1 0\n";
+        }
+    }
+    TriangleCounts triangleCounts;
+    for (uint32_t m = 0; m < kGridMaterials; ++m) {
+        obj << "usemtl band" << m << "\n";
+        for (uint32_t z = 0; z < kGridSize; ++z) {
+            for (uint32_t x = m * kGridSize / kGridMaterials; x < (m + 1) * kGridSize / kGridMaterials; ++x) {
+                const uint32_t v00 = z * (kGridSize + 1) + x + 1;
+                const uint32_t v10 = v00 + 1;
+                const uint32_t v01 = v00 + kGridSize + 1;
+                const uint32_t v11 = v01 + 1;
+                obj << "f " << v00 << "/" << v00 << "/" << v00 << " " << v01 << "/" << v01 << "/" << v01 << " " << v11
+                    << "/" << v11 << "/" << v11 << " " << v10 << "/" << v10 << "/" << v10 << "\n";
+                triangleCounts["band" + std::to_string(m) + ".png"] += 2;
+            }
+        }
+    }
+    return triangleCounts;
+}
+
+// 並べ替えと LOD を作った後のサブメッシュを確かめる
+void CheckSubMeshes(const std::filesystem::path& path, const TriangleCounts& expectedTriangles,
+                    bool expectLods) {
+    MeshImporter::Settings settings;
+    settings.useCache = false;
+    const MeshImporter::MeshSource source =
+        MeshImporter::Load(path.parent_path().generic_string(), path.filename().string(), settings);
+    const ModelData& modelData = source.modelData;
+    const std::string name = path.filename().string();
+    std::printf("%s: %zu materials, %zu LODs, %zu submeshes, %zu indices\n", name.c_str(), modelData.materials.size(),
+                modelData.lods.size(), modelData.subMeshes.size(), modelData.indices.size());
+
+    CHECK(source.reader == MeshImporter::Reader::Obj);
+    CHECK(modelData.materials.size() == expectedTriangles.size());
+    CHECK(!modelData.lods.empty());
+    CHECK(!expectLods || modelData.lods.size() > 1);
+
+    // LOD は indices を、各LODのサブメッシュは subMeshes を先頭から順に隙間なく覆う
+    uint32_t indexOffset = 0;
+    uint32_t subMeshOffset = 0;
+    for (size_t l = 0; l < modelData.lods.size(); ++l) {
+        const MeshLod& lod = modelData.lods[l];
+        CHECK(lod.indexOffset == indexOffset);
+        CHECK(lod.subMeshOffset == subMeshOffset);
+        CHECK(lod.subMeshCount > 0);
+        if (lod.subMeshOffset + lod.subMeshCount > modelData.subMeshes.size()) {
+            CHECK(lod.subMeshOffset + lod.subMeshCount <= modelData.subMeshes.size());
+            return;
+        }
+
+        uint32_t rangeOffset = lod.indexOffset;
+        std::set<uint32_t> lodMaterials;
+        for (uint32_t s = lod.subMeshOffset; s < lod.subMeshOffset + lod.subMeshCount; ++s) {
+            const SubMesh& subMesh = modelData.subMeshes[s];
+            CHECK(subMesh.indexOffset == rangeOffset);
+            CHECK(subMesh.indexCount > 0 && subMesh.indexCount % 3 == 0);
+            CHECK(subMesh.materialIndex < modelData.materials.size());
+            CHECK(lodMaterials.insert(subMesh.materialIndex).second);
+            if (l == 0 && subMesh.materialIndex < modelData.materials.size()) {
+                const std::string texture =
+                    std::filesystem::path(modelData.materials[subMesh.materialIndex].textureFilePath).filename().string();
+                const auto expected = expectedTriangles.find(texture);
+                CHECK(expected != expectedTriangles.end() && subMesh.indexCount == expected->second * 3);
+            }
+            rangeOffset += subMesh.indexCount;
+        }
+        CHECK(rangeOffset == lod.indexOffset + lod.indexCount);
+        indexOffset += lod.indexCount;
+        subMeshOffset += lod.subMeshCount;
+    }
+    CHECK(indexOffset == modelData.indices.size());
+    CHECK(subMeshOffset == modelData.subMeshes.size());
+
+    // どの頂点も1つのマテリアルからしか参照されない (全LODを通して)
+    std::vector<int64_t> vertexMaterials(modelData.vertices.size(), -1);
+    bool isShared = false;
+    bool isInRange = true;
+    for (const SubMesh& subMesh : modelData.subMeshes) {
+        for (uint32_t i = subMesh.indexOffset; i < subMesh.indexOffset + subMesh.indexCount && i < modelData.indices.size(); ++i) {
+            const uint32_t vertex = modelData.indices[i];
+            if (vertex >= modelData.vertices.size()) {
+                isInRange = false;
+                continue;
+            }
+            isShared = isShared || (vertexMaterials[vertex] >= 0 && vertexMaterials[vertex] != subMesh.materialIndex);
+            vertexMaterials[vertex] = subMesh.materialIndex;
+        }
+    }
+    CHECK(isInRange);
+    CHECK(!isShared);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <Resources/Assets/Models path>\n", argv[0]);
+        return 1;
+    }
+    const std::filesystem::path modelDirectory = argv[1];
+
+    // multiMaterial.obj: monsterBall.png が 12 三角形、uvChecker.png が 2 三角形
+    CheckSubMeshes(modelDirectory / "MultiMaterial" / "multiMaterial.obj", {{"monsterBall.png", 12}, {"uvChecker.png", 2}},
+                   false);
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "SubMeshTest";
+    std::filesystem::create_directories(directory);
+    const TriangleCounts gridTriangles = WriteGridObj(directory);
+    CheckSubMeshes(directory / "grid.obj", gridTriangles, true);
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("SubMeshTest: all checks passed\n");
+    return 0;
+}
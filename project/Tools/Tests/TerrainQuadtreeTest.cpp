@@ -0,0 +1,356 @@
+// ============================================================
+// TerrainQuadtreeTest — 地形の四分木 (TerrainQuadtree) のテスト
+//   ・チャンクの設定とハイトフィールドの大きさが合わなければ作らない
+//   ・子ノードは親の範囲に含まれ、誤差は親以下になる (葉は誤差0)
+//   ・チャンクの三角形は上を向き、スカートは外を向いて垂直に垂れる
+//   ・チャンクの三角形と元の高さの差がノードの誤差以下になる
+//   ・GetHeight が最も細かいチャンクの三角形の上の高さになる
+//   ・選んだチャンクは重ならず、視錐台の中の葉をすべて覆い、画面上の誤差が閾値以下になる
+//   ・terrain.obj から作ったハイトフィールドが元の形状に近い
+// 使い方: TerrainQuadtreeTest <Resources/Assets/Models のパス>
+// ============================================================
+#include "ObjLoader.h"
+#include "TerrainQuadtree.h"
+#include "Math/Functions/MathUtils.h"
+#include "Math/Matrix/MatrixGenerators.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+using namespace MathGenerators;
+using namespace MathUtils;
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+Vector3 GetPosition(const VertexData& vertex) { return {vertex.position.x, vertex.position.y, vertex.position.z}; }
+
+Vector3 Subtract3(const Vector3& a, const Vector3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+
+Vector3 Cross3(const Vector3& a, const Vector3& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+// 上から見て (x, z) が三角形の中にあれば、その点の三角形の高さを返す
+bool GetTriangleHeight(const Vector3& a, const Vector3& b, const Vector3& c, float x, float z, float& height) {
+    const float d = (b.x - a.x) * (c.z - a.z) - (c.x - a.x) * (b.z - a.z);
+    if (std::abs(d) < 1e-12f) {
+        return false;
+    }
+    const float l1 = ((x - a.x) * (c.z - a.z) - (c.x - a.x) * (z - a.z)) / d;
+    const float l2 = ((b.x - a.x) * (z - a.z) - (x - a.x) * (b.z - a.z)) / d;
+    if (l1 < -1e-4f || l2 < -1e-4f || l1 + l2 > 1.0f + 1e-4f) {
+        return false;
+    }
+    height = a.y + (b.y - a.y) * l1 + (c.y - a.y) * l2;
+    return true;
+}
+
+// チャンクの格子の三角形 (スカートを除く) の上で (x, z) の高さを探す
+bool FindChunkHeight(std::span<const VertexData> vertices, std::span<const uint16_t> indices, uint32_t gridTriangleCount,
+                     float x, float z, float& height) {
+    for (uint32_t t = 0; t < gridTriangleCount; ++t) {
+        if (GetTriangleHeight(GetPosition(vertices[indices[t * 3]]), GetPosition(vertices[indices[t * 3 + 1]]),
+                              GetPosition(vertices[indices[t * 3 + 2]]), x, z, height)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 起伏のある 256 × 256 セルのハイトフィールド
+TerrainHeightfield MakeHeightfield(std::mt19937& randomEngine) {
+    std::uniform_real_distribution<float> noise(0.0f, 0.3f);
+    TerrainHeightfield heightfield;
+    heightfield.resolution = 256;
+    heightfield.origin = {-128.0f, -128.0f};
+    heightfield.cellSize = {1.0f, 1.0f};
+    for (uint32_t z = 0; z <= heightfield.resolution; ++z) {
+        for (uint32_t x = 0; x <= heightfield.resolution; ++x) {
+            heightfield.heights.push_back(20.0f * std::sin(x * 0.02f) * std::cos(z * 0.03f) +
+                                          3.0f * std::sin(x * 0.2f + z * 0.13f) + noise(randomEngine));
+        }
+    }
+    return heightfield;
+}
+
+void TestInvalidSettings(const TerrainHeightfield& heightfield) {
+    TerrainQuadtree quadtree;
+    TerrainQuadtree::Settings settings;
+    settings.chunkCells = 32;
+
+    TerrainHeightfield wrongResolution = heightfield;
+    wrongResolution.resolution = 250;
+    CHECK(!quadtree.Build(wrongResolution, settings));
+
+    TerrainQuadtree::Settings notPowerOfTwo;
+    notPowerOfTwo.chunkCells = 24;
+    CHECK(!quadtree.Build(heightfield, notPowerOfTwo));
+    CHECK(quadtree.GetNodes().empty());
+}
+
+void TestHierarchy(const TerrainQuadtree& quadtree) {
+    const std::vector<TerrainQuadtree::Node>& nodes = quadtree.GetNodes();
+    for (const TerrainQuadtree::Node& node : nodes) {
+        if (node.firstChild == 0) {
+            CHECK(node.level == quadtree.GetDepth());
+            CHECK(node.error == 0.0f);
+            continue;
+        }
+        for (uint32_t c = 0; c < 4; ++c) {
+            const TerrainQuadtree::Node& child = nodes[node.firstChild + c];
+            CHECK(child.level == node.level + 1);
+            CHECK(child.error <= node.error);
+            CHECK(child.bounds.min.x >= node.bounds.min.x && child.bounds.max.x <= node.bounds.max.x);
+            CHECK(child.bounds.min.y >= node.bounds.min.y && child.bounds.max.y <= node.bounds.max.y);
+            CHECK(child.bounds.min.z >= node.bounds.min.z && child.bounds.max.z <= node.bounds.max.z);
+        }
+    }
+}
+
+void TestChunks(const TerrainQuadtree& quadtree, std::mt19937& randomEngine) {
+    const std::vector<TerrainQuadtree::Node>& nodes = quadtree.GetNodes();
+    const TerrainHeightfield& heightfield = quadtree.GetHeightfield();
+    const uint32_t chunkCells = quadtree.GetSettings().chunkCells;
+    const uint32_t vertexCount = quadtree.GetChunkVertexCount();
+    const uint32_t indexCount = quadtree.GetChunkIndexCount();
+    // 格子の三角形の後にスカートの三角形 (4辺 × chunkCells × 2) が並ぶ
+    const uint32_t gridTriangleCount = indexCount / 3 - 8 * chunkCells;
+
+    std::vector<uint16_t> indices(indexCount);
+    quadtree.WriteChunkIndices(indices);
+    for (uint16_t index : indices) {
+        CHECK(index < vertexCount);
+    }
+
+    std::vector<VertexData> vertices(vertexCount);
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        const TerrainQuadtree::Node& node = nodes[n];
+        quadtree.WriteChunkVertices(n, vertices);
+        for (const VertexData& vertex : vertices) {
+            CHECK(vertex.position.x >= node.bounds.min.x - 1e-3f && vertex.position.x <= node.bounds.max.x + 1e-3f);
+            CHECK(vertex.position.y >= node.bounds.min.y - 1e-3f && vertex.position.y <= node.bounds.max.y + 1e-3f);
+        }
+
+        // 格子は上向き、スカートは垂直で外向き
+        const Vector3 center = {(node.bounds.min.x + node.bounds.max.x) * 0.5f, 0.0f,
+                                (node.bounds.min.z + node.bounds.max.z) * 0.5f};
+        for (uint32_t t = 0; t < indexCount / 3; ++t) {
+            const Vector3 a = GetPosition(vertices[indices[t * 3]]);
+            const Vector3 b = GetPosition(vertices[indices[t * 3 + 1]]);
+            const Vector3 c = GetPosition(vertices[indices[t * 3 + 2]]);
+            const Vector3 normal = Cross3(Subtract3(b, a), Subtract3(c, a));
+            if (t < gridTriangleCount) {
+                CHECK(normal.y > 0.0f);
+            } else {
+                const Vector3 outward = {(a.x + b.x + c.x) / 3.0f - center.x, 0.0f, (a.z + b.z + c.z) / 3.0f - center.z};
+                CHECK(std::abs(normal.y) <= 1e-3f * std::sqrt(normal.x * normal.x + normal.z * normal.z));
+                CHECK(normal.x * outward.x + normal.z * outward.z > 0.0f);
+            }
+        }
+
+        // 格子点での元の高さとの差はノードの誤差以下
+        const uint32_t cells = chunkCells * node.step;
+        float maxError = 0.0f;
+        for (uint32_t s = 0; s < 200; ++s) {
+            const uint32_t x = node.cellX + randomEngine() % (cells + 1);
+            const uint32_t z = node.cellZ + randomEngine() % (cells + 1);
+            float height = 0.0f;
+            const bool isFound = FindChunkHeight(vertices, indices, gridTriangleCount,
+                                                 heightfield.origin.x + x * heightfield.cellSize.x,
+                                                 heightfield.origin.y + z * heightfield.cellSize.y, height);
+            CHECK(isFound);
+            if (isFound) {
+                maxError = std::max(maxError, std::abs(height - heightfield.GetSample(x, z)));
+            }
+        }
+        CHECK(maxError <= node.error + 1e-4f);
+    }
+}
+
+void TestGetHeight(const TerrainQuadtree& quadtree, std::mt19937& randomEngine) {
+    const std::vector<TerrainQuadtree::Node>& nodes = quadtree.GetNodes();
+    const TerrainHeightfield& heightfield = quadtree.GetHeightfield();
+    const uint32_t gridTriangleCount = quadtree.GetChunkIndexCount() / 3 - 8 * quadtree.GetSettings().chunkCells;
+    std::vector<uint16_t> indices(quadtree.GetChunkIndexCount());
+    quadtree.WriteChunkIndices(indices);
+    std::vector<VertexData> vertices(quadtree.GetChunkVertexCount());
+
+    std::uniform_real_distribution<float> position(0.0f, static_cast<float>(heightfield.resolution));
+    float maxDifference = 0.0f;
+    for (uint32_t s = 0; s < 2000; ++s) {
+        const float x = heightfield.origin.x + position(randomEngine) * heightfield.cellSize.x;
+        const float z = heightfield.origin.y + position(randomEngine) * heightfield.cellSize.y;
+
+        // (x, z) を含む葉
+        uint32_t leaf = 0;
+        while (nodes[leaf].firstChild != 0) {
+            const AABB& bounds = nodes[leaf].bounds;
+            const float midX = (bounds.min.x + bounds.max.x) * 0.5f;
+            const float midZ = (bounds.min.z + bounds.max.z) * 0.5f;
+            leaf = nodes[leaf].firstChild + (x >= midX ? 1 : 0) + (z >= midZ ? 2 : 0);
+        }
+        quadtree.WriteChunkVertices(leaf, vertices);
+        float height = 0.0f;
+        const bool isFound = FindChunkHeight(vertices, indices, gridTriangleCount, x, z, height);
+        CHECK(isFound);
+        if (isFound) {
+            maxDifference = std::max(maxDifference, std::abs(height - quadtree.GetHeight(x, z)));
+        }
+    }
+    CHECK(maxDifference < 1e-3f);
+}
+
+void TestSelection(const TerrainQuadtree& quadtree, std::mt19937& randomEngine) {
+    const std::vector<TerrainQuadtree::Node>& nodes = quadtree.GetNodes();
+    std::vector<int32_t> parents(nodes.size(), -1);
+    for (uint32_t n = 0; n < nodes.size(); ++n) {
+        if (nodes[n].firstChild != 0) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                parents[nodes[n].firstChild + c] = static_cast<int32_t>(n);
+            }
+        }
+    }
+
+    const Matrix4x4 projection = MakePerspectiveFovMatrix(0.45f, 1280.0f / 720.0f, 0.1f, 1000.0f);
+    const float pixelScale = projection.m[1][1] * 720.0f * 0.5f;
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<uint32_t> selected;
+    for (uint32_t r = 0; r < 300; ++r) {
+        const Vector3 cameraPosition = {unit(randomEngine) * 300.0f - 150.0f, 5.0f + unit(randomEngine) * 60.0f,
+                                        unit(randomEngine) * 300.0f - 150.0f};
+        const Vector3 cameraRotate = {0.1f + unit(randomEngine) * 0.6f, unit(randomEngine) * 6.28f, 0.0f};
+        const Matrix4x4 cameraMatrix = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, cameraRotate, cameraPosition);
+
+        TerrainQuadtree::SelectionParams params;
+        params.frustum = ClusterCuller::ExtractFrustum(Multiply(Inverse(cameraMatrix), projection));
+        params.cameraPosition = cameraPosition;
+        params.pixelScale = pixelScale;
+        params.maxPixelError = 2.0f;
+        const TerrainQuadtree::SelectionStats stats = quadtree.Select(params, selected);
+        CHECK(stats.selectedNodes == selected.size());
+
+        std::vector<char> isSelected(nodes.size(), 0);
+        for (uint32_t n : selected) {
+            isSelected[n] = 1;
+        }
+        for (uint32_t n = 0; n < nodes.size(); ++n) {
+            if (nodes[n].firstChild != 0) {
+                continue;
+            }
+            // 葉とその祖先のうち選ばれたものは高々1つ。視錐台の中の葉ならちょうど1つ
+            uint32_t coverCount = 0;
+            for (int32_t a = static_cast<int32_t>(n); a >= 0; a = parents[a]) {
+                coverCount += isSelected[a];
+            }
+            const AABB& bounds = nodes[n].bounds;
+            bool isOutside = false;
+            for (const Vector4& plane : params.frustum.planes) {
+                const float distance = plane.x * (plane.x >= 0.0f ? bounds.max.x : bounds.min.x) +
+                                       plane.y * (plane.y >= 0.0f ? bounds.max.y : bounds.min.y) +
+                                       plane.z * (plane.z >= 0.0f ? bounds.max.z : bounds.min.z) + plane.w;
+                isOutside = isOutside || distance < 0.0f;
+            }
+            CHECK(coverCount <= 1);
+            CHECK(isOutside || coverCount == 1);
+        }
+
+        // 葉より粗いノードは、最も近い点での画面上の誤差が閾値以下
+        for (uint32_t n : selected) {
+            if (nodes[n].firstChild == 0) {
+                continue;
+            }
+            const AABB& bounds = nodes[n].bounds;
+            const float dx = std::max({bounds.min.x - cameraPosition.x, 0.0f, cameraPosition.x - bounds.max.x});
+            const float dy = std::max({bounds.min.y - cameraPosition.y, 0.0f, cameraPosition.y - bounds.max.y});
+            const float dz = std::max({bounds.min.z - cameraPosition.z, 0.0f, cameraPosition.z - bounds.max.z});
+            CHECK(nodes[n].error * pixelScale <= params.maxPixelError * std::sqrt(dx * dx + dy * dy + dz * dz) * 1.0001f);
+        }
+    }
+}
+
+void TestFromMesh(const std::filesystem::path& modelsDirectory, std::mt19937& randomEngine) {
+    ModelData modelData;
+    CHECK(ObjLoader::Load((modelsDirectory / "terrain").generic_string(), "terrain.obj", modelData));
+    if (modelData.indices.empty()) {
+        return;
+    }
+    const uint32_t resolution = 64;
+    TerrainHeightfield heightfield = TerrainHeightfield::CreateFromMesh(modelData.vertices, modelData.indices, resolution);
+    const TerrainHeightfield copy = heightfield;
+    TerrainQuadtree quadtree;
+    TerrainQuadtree::Settings settings;
+    settings.chunkCells = 16;
+    CHECK(quadtree.Build(std::move(heightfield), settings));
+
+    // 元の三角形の最も高い面との差
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float maxDifference = 0.0f;
+    for (uint32_t s = 0; s < 2000; ++s) {
+        const float x = copy.origin.x + unit(randomEngine) * copy.cellSize.x * resolution;
+        const float z = copy.origin.y + unit(randomEngine) * copy.cellSize.y * resolution;
+        float meshHeight = -1e9f;
+        bool isFound = false;
+        for (size_t i = 0; i < modelData.indices.size(); i += 3) {
+            float height = 0.0f;
+            if (GetTriangleHeight(GetPosition(modelData.vertices[modelData.indices[i]]),
+                                  GetPosition(modelData.vertices[modelData.indices[i + 1]]),
+                                  GetPosition(modelData.vertices[modelData.indices[i + 2]]), x, z, height)) {
+                meshHeight = std::max(meshHeight, height);
+                isFound = true;
+            }
+        }
+        if (isFound) {
+            maxDifference = std::max(maxDifference, std::abs(meshHeight - quadtree.GetHeight(x, z)));
+        }
+    }
+    std::printf("terrain.obj -> heightfield(%u): max height difference %.4f\n", resolution, maxDifference);
+    CHECK(maxDifference < 0.25f);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <models directory>\n", argv[0]);
+        return 1;
+    }
+    std::mt19937 randomEngine(1u);
+    const TerrainHeightfield heightfield = MakeHeightfield(randomEngine);
+    TestInvalidSettings(heightfield);
+
+    TerrainQuadtree quadtree;
+    TerrainQuadtree::Settings settings;
+    settings.chunkCells = 32;
+    CHECK(quadtree.Build(heightfield, settings));
+    // 256 / 32 = 8 → 深さ3 (1 + 4 + 16 + 64 ノード)
+    CHECK(quadtree.GetDepth() == 3);
+    CHECK(quadtree.GetNodes().size() == 85);
+    if (quadtree.GetNodes().size() == 85) {
+        TestHierarchy(quadtree);
+        TestChunks(quadtree, randomEngine);
+        TestGetHeight(quadtree, randomEngine);
+        TestSelection(quadtree, randomEngine);
+    }
+    TestFromMesh(argv[1], randomEngine);
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("TerrainQuadtreeTest: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,174 @@
+// ============================================================
+// TextureCookerTest — DirectXTex を使わないテクスチャのキャッシュ作成 (TextureCooker::CookImage) のテスト
+//   ・ミップマップの段数と大きさ (kMipLevels まで、小さい画像は 1x1 まで)
+//   ・ミップマップの色は線形で平均し、アルファはそのまま平均する
+//   ・書き出した DDS のヘッダー (大きさ・段数・DXGI_FORMAT) とファイルの大きさ
+//   ・4の倍数でない大きさや圧縮しない設定は R8G8B8A8 のまま、BC7 の全モードの探索は失敗にする
+//   ・キャッシュのキーは設定と元ファイルの内容で変わる
+// ============================================================
+#include "BlockCompressor.h"
+#include "TextureCooker.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+// DDS (DX10 ヘッダー付き) のうち確かめる値
+struct DdsInfo {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipMapCount = 0;
+    uint32_t dxgiFormat = 0;
+    size_t fileSize = 0;
+};
+
+bool ReadDdsInfo(const std::string& path, DdsInfo& info) {
+    std::ifstream file(path, std::ios::binary);
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    // "DDS " + DDS_HEADER (124) + DDS_HEADER_DXT10 (20)
+    if (bytes.size() < 148 || std::memcmp(bytes.data(), "DDS ", 4) != 0 || std::memcmp(&bytes[84], "DX10", 4) != 0) {
+        return false;
+    }
+    std::memcpy(&info.height, &bytes[12], 4);
+    std::memcpy(&info.width, &bytes[16], 4);
+    std::memcpy(&info.mipMapCount, &bytes[28], 4);
+    std::memcpy(&info.dxgiFormat, &bytes[128], 4);
+    info.fileSize = bytes.size();
+    return true;
+}
+
+TextureCooker::RgbaImage MakeImage(uint32_t width, uint32_t height) {
+    TextureCooker::RgbaImage image;
+    image.width = width;
+    image.height = height;
+    image.pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < image.pixels.size(); ++i) {
+        image.pixels[i] = static_cast<uint8_t>(i * 37);
+    }
+    return image;
+}
+
+void TestMipMaps() {
+    // 段数は kMipLevels まで、1x1 より小さくはしない
+    CHECK(TextureCooker::GenerateMipMaps(MakeImage(64, 32)).size() == TextureCooker::kMipLevels);
+    const std::vector<TextureCooker::RgbaImage> small = TextureCooker::GenerateMipMaps(MakeImage(5, 3));
+    CHECK(small.size() == 3);
+    CHECK(small[1].width == 2 && small[1].height == 1);
+    CHECK(small[2].width == 1 && small[2].height == 1);
+    CHECK(TextureCooker::GenerateMipMaps(MakeImage(1, 1)).size() == 1);
+
+    // 黒と白の市松模様は線形で半分 (sRGB で 188)、アルファ 0 と 255 は 128 になる
+    TextureCooker::RgbaImage checker;
+    checker.width = 2;
+    checker.height = 2;
+    checker.pixels = {0, 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 0};
+    const std::vector<TextureCooker::RgbaImage> mipImages = TextureCooker::GenerateMipMaps(checker);
+    CHECK(mipImages.size() == 2);
+    CHECK(mipImages[1].pixels == std::vector<uint8_t>({188, 188, 188, 128}));
+}
+
+void TestCook(const std::filesystem::path& directory) {
+    const std::string path = (directory / "cooked.dds").string();
+    TextureCooker::Settings settings;
+    DdsInfo info;
+
+    // 圧縮しない: 6x6, 3x3, 1x1 の R8G8B8A8_UNORM_SRGB
+    CHECK(TextureCooker::CookImage(MakeImage(6, 6), settings, path));
+    CHECK(ReadDdsInfo(path, info));
+    CHECK(info.width == 6 && info.height == 6 && info.mipMapCount == 3);
+    CHECK(info.dxgiFormat == 29);
+    CHECK(info.fileSize == 148 + (36 + 9 + 1) * 4);
+
+    // BC1: 16x8 から4段 (ブロックは 8 + 2 + 1 + 1 個)
+    settings.compression = TextureCooker::Compression::BC1;
+    CHECK(TextureCooker::CookImage(MakeImage(16, 8), settings, path));
+    CHECK(ReadDdsInfo(path, info));
+    CHECK(info.width == 16 && info.height == 8 && info.mipMapCount == TextureCooker::kMipLevels);
+    CHECK(info.dxgiFormat == BlockCompressor::GetDxgiFormat(BlockCompressor::Format::BC1, true));
+    CHECK(info.fileSize == 148 + (8 + 2 + 1 + 1) * 8);
+
+    // BC5 は sRGB なし
+    settings.compression = TextureCooker::Compression::BC5;
+    CHECK(TextureCooker::CookImage(MakeImage(8, 8), settings, path));
+    CHECK(ReadDdsInfo(path, info));
+    CHECK(info.dxgiFormat == 83);
+
+    // 4の倍数でない大きさは圧縮しない
+    settings.compression = TextureCooker::Compression::BC3;
+    CHECK(TextureCooker::CookImage(MakeImage(10, 6), settings, path));
+    CHECK(ReadDdsInfo(path, info));
+    CHECK(info.dxgiFormat == 29);
+
+    // BC7 は速い圧縮だけ
+    settings.compression = TextureCooker::Compression::BC7;
+    CHECK(TextureCooker::CookImage(MakeImage(8, 8), settings, path));
+    CHECK(ReadDdsInfo(path, info));
+    CHECK(info.dxgiFormat == 99);
+    settings.isQuickBC7 = false;
+    CHECK(!TextureCooker::CookImage(MakeImage(8, 8), settings, path));
+
+    // 大きさとピクセル数が合わない画像
+    TextureCooker::RgbaImage broken = MakeImage(4, 4);
+    broken.pixels.pop_back();
+    CHECK(!TextureCooker::CookImage(broken, TextureCooker::Settings{}, path));
+}
+
+void TestKey(const std::filesystem::path& directory) {
+    const std::string sourcePath = (directory / "source.png").string();
+    {
+        std::ofstream file(sourcePath, std::ios::binary);
+        file << "source";
+    }
+    TextureCooker::Settings settings;
+    const uint64_t key = TextureCooker::ComputeKey(sourcePath, settings);
+    CHECK(key != 0);
+    CHECK(TextureCooker::ComputeKey(sourcePath, settings) == key);
+    settings.compression = TextureCooker::Compression::BC1;
+    CHECK(TextureCooker::ComputeKey(sourcePath, settings) != key);
+
+    settings = {};
+    {
+        std::ofstream file(sourcePath, std::ios::binary);
+        file << "changed";
+    }
+    CHECK(TextureCooker::ComputeKey(sourcePath, settings) != key);
+    CHECK(TextureCooker::ComputeKey((directory / "missing.png").string(), settings) == 0);
+    CHECK(TextureCooker::GetCachePath(key).starts_with("Resources/Cache/Textures/"));
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "TextureCookerTest";
+    std::filesystem::create_directories(directory);
+
+    TestMipMaps();
+    TestCook(directory);
+    TestKey(directory);
+
+    std::error_code ec;
+    std::filesystem::remove_all(directory, ec);
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("TextureCookerTest: all checks passed\n");
+    return 0;
+}
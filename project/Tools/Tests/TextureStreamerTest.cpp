@@ -0,0 +1,231 @@
+// ============================================================
+// TextureStreamerTest — テクスチャの非同期読み込み (TextureStreamer) のテスト
+// 偽のデコーダー (待つだけ) とアップローダー (フェンス値を数えるだけ) で確かめる
+//   ・転送のフェンスが完了してから差し替える (転送したフレームには差し替えない)
+//   ・1回の転送量の目安を守る (目安より大きいものも1枚は転送する)
+//   ・デコードの失敗・例外 (std::exception 以外も) は Failed になり、ワーカーは止まらない
+//   ・アップローダーが積めないときは次の Update で再試行する
+//   ・未着手の依頼が残っていても Finalize で止まり、ワーカーの開始・終了処理が対になる
+//   ・ワーカーを増やすとデコードが並列に進む
+// ============================================================
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+using Clock = std::chrono::steady_clock;
+
+// ファイル名で結果を決めるデコーダー
+//   "bad" → nullptr、"throw" → std::runtime_error、"raw" → int を投げる、"big" → 10 バイト、それ以外 → 4 バイト
+class FakeDecoder : public ITextureDecoder {
+public:
+    void BeginWorkerThread() override { ++beginCount; }
+    void EndWorkerThread() override { ++endCount; }
+
+    std::unique_ptr<DecodedTexture> Decode(const std::string& filePath) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(sleepMilliseconds));
+        if (filePath.find("bad") != std::string::npos) {
+            return nullptr;
+        }
+        if (filePath.find("throw") != std::string::npos) {
+            throw std::runtime_error("decode error");
+        }
+        if (filePath.find("raw") != std::string::npos) {
+            throw 42;
+        }
+        auto texture = std::make_unique<DecodedTexture>();
+        texture->sizeInBytes = filePath.find("big") != std::string::npos ? 10 : 4;
+        return texture;
+    }
+
+    int sleepMilliseconds = 20;
+    std::atomic<int> beginCount = 0;
+    std::atomic<int> endCount = 0;
+};
+
+// フレームの終わりに GPU がすべて完了するものとするアップローダー
+class FakeUploader : public ITextureUploader {
+public:
+    bool Upload(const std::string& filePath, DecodedTexture&, uint64_t& fenceValue) override {
+        if (!isOpen) {
+            return false;
+        }
+        fenceValue = fence + 1;
+        uploadedFences[filePath] = fenceValue;
+        uploadedFrames[filePath] = frame;
+        ++uploadsThisFrame;
+        return true;
+    }
+    uint64_t GetCompletedFenceValue() const override { return completedFence; }
+    void Activate(const std::string& filePath) override {
+        // 転送していないもの、転送が終わっていないものを差し替えない
+        auto it = uploadedFences.find(filePath);
+        isActivatedEarly = isActivatedEarly || it == uploadedFences.end() || it->second > completedFence;
+        activatedFrames[filePath] = frame;
+    }
+
+    void EndFrame() {
+        maxUploadsPerFrame = std::max(maxUploadsPerFrame, uploadsThisFrame);
+        uploadsThisFrame = 0;
+        ++fence;
+        completedFence = fence;
+        ++frame;
+    }
+
+    bool isOpen = true;
+    uint64_t fence = 0;
+    uint64_t completedFence = 0;
+    int frame = 0;
+    int uploadsThisFrame = 0;
+    int maxUploadsPerFrame = 0;
+    bool isActivatedEarly = false;
+    std::map<std::string, uint64_t> uploadedFences;
+    std::map<std::string, int> uploadedFrames;
+    std::map<std::string, int> activatedFrames;
+};
+
+// 全件の差し替えが終わるまでフレームを回す
+void RunUntilDone(TextureStreamer& streamer, FakeUploader& uploader, size_t maxUploadBytes) {
+    for (int frame = 0; frame < 400 && streamer.GetPendingCount() > 0; ++frame) {
+        streamer.Update(maxUploadBytes);
+        uploader.EndFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+void TestBasic() {
+    FakeDecoder decoder;
+    FakeUploader uploader;
+    TextureStreamer streamer;
+    streamer.Initialize(&decoder, &uploader, 4);
+
+    std::vector<uint32_t> handles;
+    for (int i = 0; i < 6; ++i) {
+        handles.push_back(streamer.Request("tex" + std::to_string(i) + ".png"));
+    }
+    const uint32_t bad = streamer.Request("bad.png");
+    const uint32_t thrown = streamer.Request("throw.png");
+    const uint32_t raw = streamer.Request("raw.png");
+    const uint32_t big = streamer.Request("big.png");
+    RunUntilDone(streamer, uploader, 8);
+
+    CHECK(streamer.GetPendingCount() == 0);
+    CHECK(!uploader.isActivatedEarly);
+    for (uint32_t handle : handles) {
+        const std::string& filePath = streamer.GetFilePath(handle);
+        CHECK(streamer.GetState(handle) == TextureStreamer::State::Ready);
+        // 転送した次のフレームの Update で差し替わる
+        CHECK(uploader.activatedFrames[filePath] == uploader.uploadedFrames[filePath] + 1);
+    }
+    CHECK(streamer.GetState(bad) == TextureStreamer::State::Failed);
+    CHECK(streamer.GetState(thrown) == TextureStreamer::State::Failed);
+    CHECK(streamer.GetState(raw) == TextureStreamer::State::Failed);
+    // 目安 (8 バイト) より大きくても1枚は転送する
+    CHECK(streamer.GetState(big) == TextureStreamer::State::Ready);
+    // 4 バイトのものは1フレームに2枚まで
+    CHECK(uploader.maxUploadsPerFrame <= 2);
+
+    // 例外の後もワーカーは動き続ける
+    const uint32_t after = streamer.Request("after.png");
+    RunUntilDone(streamer, uploader, 8);
+    CHECK(streamer.GetState(after) == TextureStreamer::State::Ready);
+}
+
+void TestRetryUpload() {
+    FakeDecoder decoder;
+    FakeUploader uploader;
+    TextureStreamer streamer;
+    streamer.Initialize(&decoder, &uploader, 2);
+
+    const uint32_t handle = streamer.Request("a.png");
+    uploader.isOpen = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    streamer.Update();
+    CHECK(streamer.GetState(handle) == TextureStreamer::State::Uploading);
+    CHECK(uploader.uploadedFences.empty());
+
+    // 積めるようになったら転送し、フェンスが完了するまでは差し替えない
+    uploader.isOpen = true;
+    streamer.Update();
+    CHECK(uploader.uploadedFences.count("a.png") == 1);
+    streamer.Update();
+    CHECK(streamer.GetState(handle) == TextureStreamer::State::Uploading);
+    uploader.EndFrame();
+    streamer.Update();
+    CHECK(streamer.GetState(handle) == TextureStreamer::State::Ready);
+}
+
+void TestFinalizeWithPendingWork() {
+    FakeDecoder decoder;
+    decoder.sleepMilliseconds = 50;
+    FakeUploader uploader;
+    TextureStreamer streamer;
+    streamer.Initialize(&decoder, &uploader, 3);
+    for (int i = 0; i < 50; ++i) {
+        streamer.Request("pending" + std::to_string(i) + ".png");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    // 未着手の40件以上は待たずに破棄する
+    const Clock::time_point start = Clock::now();
+    streamer.Finalize();
+    const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    CHECK(milliseconds < 500.0);
+    CHECK(decoder.beginCount == 3);
+    CHECK(decoder.endCount == 3);
+    CHECK(streamer.GetPendingCount() == 0);
+}
+
+void TestParallelDecode() {
+    auto measure = [](uint32_t workerCount) {
+        FakeDecoder decoder;
+        FakeUploader uploader;
+        TextureStreamer streamer;
+        streamer.Initialize(&decoder, &uploader, workerCount);
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < 32; ++i) {
+            streamer.Request("parallel" + std::to_string(i) + ".png");
+        }
+        RunUntilDone(streamer, uploader, SIZE_MAX);
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+    const double oneWorker = measure(1);
+    const double eightWorkers = measure(8);
+    std::printf("32 decodes x 20 ms: 1 worker %.0f ms, 8 workers %.0f ms\n", oneWorker, eightWorkers);
+    CHECK(eightWorkers * 2.0 < oneWorker);
+}
+
+} // namespace
+
+int main() {
+    TestBasic();
+    TestRetryUpload();
+    TestFinalizeWithPendingWork();
+    TestParallelDecode();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("TextureStreamerTest: all checks passed\n");
+    return 0;
+}
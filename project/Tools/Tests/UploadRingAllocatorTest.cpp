@@ -0,0 +1,209 @@
+// ============================================================
+// UploadRingAllocatorTest — 転送用リング (UploadRingAllocator) のテスト
+//   ・オフセットは指定したアラインメントに合い、大きさ0とリングより大きいものは切り出せない
+//   ・末尾に入らない範囲は先頭へ折り返し、飛ばした末尾も解放まで使用中として数える
+//   ・GPU が使用中の範囲で埋まると false を返し (DX12Context は専用のバッファに切り替える)、状態は変わらない
+//   ・Retire は完了したフェンス値までの範囲だけを古い順に解放し、何も切り出していない Close はフェンスを記録しない
+//   ・数フレーム遅れて完了する GPU をまねてランダムに切り出し、使用中の範囲が重ならないこと
+// ============================================================
+#include "UploadRingAllocator.h"
+
+#include <cstdio>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+void TestAlignment() {
+    UploadRingAllocator ring;
+    ring.Initialize(4096);
+    uint64_t offset = 1;
+    CHECK(ring.Allocate(10, 1, offset) && offset == 0);
+    CHECK(ring.Allocate(16, 256, offset) && offset == 256);
+    CHECK(ring.Allocate(1, 512, offset) && offset == 512);
+    CHECK(ring.Allocate(3, 4, offset) && offset == 516);
+    // 飛ばした隙間も使用中に数える
+    CHECK(ring.GetUsedSize() == 519);
+
+    CHECK(!ring.Allocate(0, 16, offset));
+    CHECK(!ring.Allocate(4097, 1, offset));
+    CHECK(ring.GetUsedSize() == 519);
+
+    // 色々なアラインメントで切り出しても、オフセットは常に合っている
+    bool isAligned = true;
+    ring.Initialize(1 << 20);
+    for (uint64_t fence = 1; fence <= 200; ++fence) {
+        for (uint64_t alignment : {1ull, 4ull, 16ull, 256ull, 512ull, 65536ull}) {
+            const uint64_t size = 1 + (fence * 37 + alignment) % 3000;
+            isAligned = ring.Allocate(size, alignment, offset) && offset % alignment == 0 &&
+                        offset + size <= ring.GetCapacity() && isAligned;
+        }
+        ring.Close(fence);
+        ring.Retire(fence);
+    }
+    CHECK(isAligned);
+}
+
+void TestWrapAround() {
+    UploadRingAllocator ring;
+    ring.Initialize(1024);
+    uint64_t offset = 1;
+    CHECK(ring.Allocate(600, 256, offset) && offset == 0);
+    ring.Close(1);
+
+    // GPU が先頭の 600 バイトを使っている間は、折り返すと追いつくので切り出せない
+    CHECK(!ring.Allocate(600, 256, offset));
+    CHECK(ring.GetUsedSize() == 600);
+
+    // 完了すると先頭へ折り返して切り出せる (末尾の 424 バイトは飛ばす)
+    ring.Retire(1);
+    CHECK(ring.GetUsedSize() == 0);
+    CHECK(ring.Allocate(600, 256, offset) && offset == 0);
+    CHECK(ring.GetUsedSize() == 1024);
+    CHECK(!ring.Allocate(1, 1, offset));
+    ring.Close(2);
+    ring.Retire(2);
+
+    // 末尾にちょうど入る大きさは折り返さない
+    CHECK(ring.Allocate(424, 8, offset) && offset == 600);
+    CHECK(ring.Allocate(8, 8, offset) && offset == 0);
+}
+
+void TestFullRing() {
+    UploadRingAllocator ring;
+    ring.Initialize(1024);
+    uint64_t offset = 0;
+    for (uint64_t i = 0; i < 4; ++i) {
+        CHECK(ring.Allocate(256, 256, offset) && offset == i * 256);
+    }
+    CHECK(ring.GetUsedSize() == 1024);
+
+    // 埋まっている間は false を返し、何も変えない
+    offset = 12345;
+    CHECK(!ring.Allocate(1, 1, offset));
+    CHECK(offset == 12345);
+    CHECK(ring.GetUsedSize() == 1024);
+
+    // Close しても、完了するまでは埋まったまま
+    ring.Close(7);
+    ring.Retire(6);
+    CHECK(!ring.Allocate(1, 1, offset));
+    ring.Retire(7);
+    CHECK(ring.GetUsedSize() == 0);
+    CHECK(ring.Allocate(1024, 256, offset) && offset == 0);
+}
+
+void TestRetire() {
+    UploadRingAllocator ring;
+    ring.Initialize(1024);
+    uint64_t offset = 0;
+    CHECK(ring.Allocate(100, 1, offset));
+    CHECK(ring.Allocate(100, 1, offset));
+    ring.Close(1);
+    CHECK(ring.Allocate(300, 1, offset) && offset == 200);
+    ring.Close(2);
+    // 何も切り出していない Close は記録しない
+    ring.Close(3);
+    CHECK(ring.GetPendingFenceCount() == 2);
+    CHECK(ring.Allocate(50, 1, offset) && offset == 500);
+    ring.Close(4);
+    CHECK(ring.GetPendingFenceCount() == 3);
+
+    // 完了していないフェンスの範囲は解放しない
+    ring.Retire(0);
+    CHECK(ring.GetUsedSize() == 550 && ring.GetPendingFenceCount() == 3);
+    ring.Retire(1);
+    CHECK(ring.GetUsedSize() == 350 && ring.GetPendingFenceCount() == 2);
+    // 間のフェンス値 (3) まで完了していれば、2 までの範囲を解放する
+    ring.Retire(3);
+    CHECK(ring.GetUsedSize() == 50 && ring.GetPendingFenceCount() == 1);
+    ring.Retire(10);
+    CHECK(ring.GetUsedSize() == 0 && ring.GetPendingFenceCount() == 0);
+
+    // Initialize は解放待ちも破棄する
+    CHECK(ring.Allocate(10, 1, offset));
+    ring.Close(11);
+    ring.Initialize(2048);
+    CHECK(ring.GetCapacity() == 2048 && ring.GetUsedSize() == 0 && ring.GetPendingFenceCount() == 0);
+}
+
+// フレームごとに切り出し、GPU は latency フレーム遅れて完了する
+// 使用中の範囲 (まだ完了していないフェンスの範囲) が互いに重ならず、リングの中に収まること
+void TestSimulation() {
+    struct Range {
+        uint64_t begin;
+        uint64_t end;
+        uint64_t fenceValue;
+    };
+    const uint64_t capacity = 64 * 1024;
+    const uint64_t latency = 2;
+    UploadRingAllocator ring;
+    ring.Initialize(capacity);
+    std::mt19937 randomEngine(5u);
+    std::uniform_int_distribution<uint64_t> size(1, 4000);
+    std::uniform_int_distribution<int> countPerFrame(0, 12);
+    const uint64_t alignments[] = {4, 16, 256, 512};
+
+    std::deque<Range> live;
+    bool isDisjoint = true;
+    uint32_t failedCount = 0;
+    uint32_t allocatedCount = 0;
+    for (uint64_t frame = 1; frame <= 5000; ++frame) {
+        const int count = countPerFrame(randomEngine);
+        for (int i = 0; i < count; ++i) {
+            const uint64_t sizeInBytes = size(randomEngine);
+            uint64_t offset = 0;
+            if (!ring.Allocate(sizeInBytes, alignments[i % 4], offset)) {
+                ++failedCount;
+                continue;
+            }
+            ++allocatedCount;
+            const Range range = {offset, offset + sizeInBytes, frame};
+            isDisjoint = isDisjoint && range.end <= capacity;
+            for (const Range& other : live) {
+                isDisjoint = isDisjoint && (range.end <= other.begin || other.end <= range.begin);
+            }
+            live.push_back(range);
+        }
+        ring.Close(frame);
+
+        // GPU は latency フレーム前のフェンスまで完了している
+        const uint64_t completed = frame > latency ? frame - latency : 0;
+        ring.Retire(completed);
+        while (!live.empty() && live.front().fenceValue <= completed) {
+            live.pop_front();
+        }
+        isDisjoint = isDisjoint && ring.GetUsedSize() <= capacity;
+    }
+    std::printf("simulation: %u allocations, %u fell back\n", allocatedCount, failedCount);
+    CHECK(isDisjoint);
+    CHECK(allocatedCount > 0);
+}
+
+} // namespace
+
+int main() {
+    TestAlignment();
+    TestWrapAround();
+    TestFullRing();
+    TestRetire();
+    TestSimulation();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("UploadRingAllocatorTest: all checks passed\n");
+    return 0;
+}
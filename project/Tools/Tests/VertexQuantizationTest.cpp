@@ -0,0 +1,194 @@
+// ============================================================
+// VertexQuantizationTest — 頂点の圧縮と復元 (VertexQuantization) のテスト
+//   ・half: 全 65536 通りが float を経由して元に戻る、丸めは最近接偶数、範囲外は無限大
+//   ・UV (half): 0～2 の値の誤差が kMaxTexcoordError 以内
+//   ・法線 (八面体 snorm16x2): 球全体・軸・折り返しの境目で角度誤差が kMaxNormalAngleError 以内
+//   ・頂点の形式ごとの大きさ、Compact の位置は誤差なし、CompactHalf の位置は相対誤差 2^-11 以内
+//   ・誤差が許容を超える場合の形式の選び直し (ChooseVertexFormat)
+// ============================================================
+#include "VertexQuantization.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace VertexQuantization;
+
+namespace {
+
+int failCount = 0;
+
+#define CHECK(condition)                                                                   \
+    do {                                                                                   \
+        if (!(condition)) {                                                                \
+            ++failCount;                                                                   \
+            std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition);               \
+        }                                                                                  \
+    } while (0)
+
+Vector3 Normalize(const Vector3& v) {
+    const float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    return {v.x / length, v.y / length, v.z / length};
+}
+
+// 2つの単位ベクトルのなす角 (小さい角度でも精度が落ちないよう double で atan2 を使う)
+double AngleBetween(const Vector3& a, const Vector3& b) {
+    const double cx = static_cast<double>(a.y) * b.z - static_cast<double>(a.z) * b.y;
+    const double cy = static_cast<double>(a.z) * b.x - static_cast<double>(a.x) * b.z;
+    const double cz = static_cast<double>(a.x) * b.y - static_cast<double>(a.y) * b.x;
+    const double dot = static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z;
+    return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot);
+}
+
+VertexData MakeVertex(const Vector3& position, const Vector2& texcoord, const Vector3& normal) {
+    return {{position.x, position.y, position.z, 1.0f}, texcoord, normal};
+}
+
+void TestHalf() {
+    // NaN 以外の全ての half は float を経由して同じビットに戻る
+    bool isRoundTrip = true;
+    for (uint32_t bits = 0; bits <= 0xFFFFu; ++bits) {
+        const uint16_t half = static_cast<uint16_t>(bits);
+        if ((half & 0x7C00u) == 0x7C00u && (half & 0x03FFu) != 0) {
+            CHECK(std::isnan(HalfToFloat(half)));
+            continue;
+        }
+        isRoundTrip = isRoundTrip && FloatToHalf(HalfToFloat(half)) == half;
+    }
+    CHECK(isRoundTrip);
+
+    CHECK(FloatToHalf(1.0f) == 0x3C00u);
+    CHECK(FloatToHalf(-2.0f) == 0xC000u);
+    CHECK(FloatToHalf(65504.0f) == 0x7BFFu);
+    CHECK(FloatToHalf(70000.0f) == 0x7C00u);
+    CHECK(FloatToHalf(-INFINITY) == 0xFC00u);
+    CHECK(std::isnan(HalfToFloat(FloatToHalf(NAN))));
+    // 2つの half のちょうど中間は偶数側に丸める (1 + 2^-11 は 1、1 + 3 * 2^-11 は 1 + 2^-9)
+    CHECK(FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00u);
+    CHECK(FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3C02u);
+    // 非正規化数
+    CHECK(FloatToHalf(std::ldexp(1.0f, -24)) == 0x0001u);
+    CHECK(HalfToFloat(0x0001u) == std::ldexp(1.0f, -24));
+}
+
+void TestTexcoord() {
+    std::mt19937 randomEngine(11u);
+    std::uniform_real_distribution<float> range(0.0f, 2.0f);
+    float maxError = 0.0f;
+    for (int i = 0; i < 100000; ++i) {
+        const float value = range(randomEngine);
+        maxError = std::max(maxError, std::abs(HalfToFloat(FloatToHalf(value)) - value));
+    }
+    std::printf("uv (half) max error %.3e (limit %.3e)\n", maxError, kMaxTexcoordError);
+    CHECK(maxError <= kMaxTexcoordError);
+}
+
+void TestNormal() {
+    std::vector<Vector3> normals = {{1, 0, 0},  {-1, 0, 0}, {0, 1, 0},       {0, -1, 0},      {0, 0, 1},
+                                    {0, 0, -1}, {1, 1, 0},  {1, -1, 0},      {-1, 0, 1},      {0, 1, -1},
+                                    {1, 1, 1},  {-1, -1, -1}, {0.001f, 0, -1}, {0, -0.001f, -1}, {1, 1, -1e-4f}};
+    std::mt19937 randomEngine(5u);
+    std::normal_distribution<float> gaussian;
+    for (int i = 0; i < 200000; ++i) {
+        normals.push_back({gaussian(randomEngine), gaussian(randomEngine), gaussian(randomEngine)});
+    }
+
+    double maxAngle = 0.0;
+    for (Vector3 normal : normals) {
+        normal = Normalize(normal);
+        int16_t encoded[2];
+        EncodeOctahedral(normal, encoded);
+        maxAngle = std::max(maxAngle, AngleBetween(normal, DecodeOctahedral(encoded)));
+    }
+    std::printf("normal (octahedral) max angle error %.3e rad (limit %.3e)\n", maxAngle, kMaxNormalAngleError);
+    CHECK(maxAngle <= kMaxNormalAngleError);
+}
+
+void TestVertices() {
+    CHECK(GetVertexStride(kVertexFormatFull) == 36);
+    CHECK(GetVertexStride(kVertexFormatCompact) == 20);
+    CHECK(GetVertexStride(kVertexFormatCompactHalf) == 16);
+
+    std::mt19937 randomEngine(9u);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> gaussian;
+    std::vector<VertexData> vertices;
+    for (int i = 0; i < 4096; ++i) {
+        vertices.push_back(MakeVertex({position(randomEngine), position(randomEngine), position(randomEngine)},
+                                      {unit(randomEngine), unit(randomEngine)},
+                                      Normalize({gaussian(randomEngine), gaussian(randomEngine), gaussian(randomEngine)})));
+    }
+
+    bool isExact = true;
+    bool isWithinHalf = true;
+    for (const VertexData& vertex : vertices) {
+        const VertexData compact = DecodeCompact(EncodeCompact(vertex));
+        isExact = isExact && compact.position.x == vertex.position.x && compact.position.y == vertex.position.y &&
+                  compact.position.z == vertex.position.z && compact.position.w == 1.0f;
+        const VertexData half = DecodeCompactHalf(EncodeCompactHalf(vertex));
+        const float limit = std::ldexp(1.0f, -11);
+        isWithinHalf = isWithinHalf && std::abs(half.position.x - vertex.position.x) <= std::abs(vertex.position.x) * limit &&
+                       std::abs(half.position.y - vertex.position.y) <= std::abs(vertex.position.y) * limit &&
+                       std::abs(half.position.z - vertex.position.z) <= std::abs(vertex.position.z) * limit;
+    }
+    CHECK(isExact);
+    CHECK(isWithinHalf);
+
+    // EncodeVertices は1頂点ずつの変換と同じバイトを書く
+    std::vector<CompactHalfVertexData> encoded(vertices.size());
+    EncodeVertices(vertices, kVertexFormatCompactHalf, encoded.data());
+    const CompactHalfVertexData single = EncodeCompactHalf(vertices[100]);
+    CHECK(std::equal(single.position, single.position + 4, encoded[100].position));
+    CHECK(single.normal[0] == encoded[100].normal[0] && single.normal[1] == encoded[100].normal[1]);
+
+    // 形式ごとの誤差 (Full は誤差なし)
+    const QuantizationError full = MeasureError(vertices, kVertexFormatFull);
+    CHECK(full.position == 0.0f && full.texcoord == 0.0f);
+    const QuantizationError compact = MeasureError(vertices, kVertexFormatCompact);
+    CHECK(compact.position == 0.0f);
+    CHECK(compact.texcoord <= kMaxTexcoordError);
+    CHECK(compact.normalAngle <= kMaxNormalAngleError);
+    // ±50 の位置は half では 1/1024 を超える
+    CHECK(MeasureError(vertices, kVertexFormatCompactHalf).position > kMaxPositionError);
+}
+
+void TestChooseFormat() {
+    // 原点付近の小さなモデルは希望通り
+    std::vector<VertexData> small = {MakeVertex({0.25f, -0.5f, 0.75f}, {0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}),
+                                     MakeVertex({0.125f, 0.5f, -0.375f}, {0.5f, 0.25f}, {1.0f, 0.0f, 0.0f})};
+    CHECK(ChooseVertexFormat(small, kVertexFormatCompactHalf) == kVertexFormatCompactHalf);
+    CHECK(ChooseVertexFormat(small, kVertexFormatCompact) == kVertexFormatCompact);
+    CHECK(ChooseVertexFormat(small, kVertexFormatFull) == kVertexFormatFull);
+
+    // 原点から離れた位置は half に収まらないので Compact
+    std::vector<VertexData> large = small;
+    large[0].position.x = 1000.3f;
+    CHECK(ChooseVertexFormat(large, kVertexFormatCompactHalf) == kVertexFormatCompact);
+
+    // 繰り返しの大きな UV は half に収まらないので Full
+    std::vector<VertexData> tiled = small;
+    tiled[1].texcoord.x = 100.3f;
+    CHECK(ChooseVertexFormat(tiled, kVertexFormatCompactHalf) == kVertexFormatFull);
+    CHECK(ChooseVertexFormat(tiled, kVertexFormatCompact) == kVertexFormatFull);
+}
+
+} // namespace
+
+int main() {
+    TestHalf();
+    TestTexcoord();
+    TestNormal();
+    TestVertices();
+    TestChooseFormat();
+
+    if (failCount > 0) {
+        std::printf("%d check(s) failed\n", failCount);
+        return 1;
+    }
+    std::printf("VertexQuantizationTest: all checks passed\n");
+    return 0;
+}